@@ -30,17 +30,26 @@ namespace qmcplusplus
  *
  *  This has not been tested for nested threading with openmp
  *  It is not intended for use below the top level of openmp threading.
+ *  Construct with nested_threads > 1 to give each task a team of threads
+ *  for the parallel regions inside it. The number of tasks run concurrently
+ *  is then reduced so that the total number of threads stays within maxCapacity.
  */
 template<Executor TT = Executor::OPENMP>
 class ParallelExecutor
 {
 public:
+  ParallelExecutor(int nested_threads = 1) : nested_threads_(nested_threads) {}
+
   /** Concurrently execute an arbitrary function/kernel with task id and arbitrary args
    *
    *  ie each task will run f(int task_id, Args... args)
    */
   template<typename F, typename... Args>
   void operator()(int num_tasks, F&& f, Args&&... args);
+
+private:
+  /// number of threads of the parallel regions within a task
+  const int nested_threads_;
 };
 
 } // namespace qmcplusplus
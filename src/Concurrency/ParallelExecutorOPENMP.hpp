@@ -17,6 +17,7 @@
 #ifndef QMCPLUSPLUS_PARALLELEXECUTOR_OPENMP_HPP
 #define QMCPLUSPLUS_PARALLELEXECUTOR_OPENMP_HPP
 
+#include <algorithm>
 #include <stdexcept>
 #include <string>
 
@@ -31,6 +32,8 @@ namespace qmcplusplus
  *  This specialization throws below the top openmp theading level
  *  exception must be caught at thread level or terminate is called.
  *
+ *  With nested_threads_ > 1, the top level team has omp_get_max_threads() / nested_threads_ threads
+ *  and the parallel regions inside a task get nested_threads_ threads.
  */
 template<>
 template<typename F, typename... Args>
@@ -39,11 +42,19 @@ void ParallelExecutor<Executor::OPENMP>::operator()(int num_tasks, F&& f, Args&&
   const std::string nesting_error{"ParallelExecutor should not be used for nested openmp threading\n"};
   if (omp_get_level() > 0)
     throw std::runtime_error(nesting_error);
+  const bool nested      = nested_threads_ > 1;
+  const int num_threads  = nested ? std::max(1, omp_get_max_threads() / nested_threads_) : omp_get_max_threads();
+  const int saved_levels = omp_get_max_active_levels();
+  if (nested)
+    omp_set_max_active_levels(std::max(2, saved_levels));
   int nested_throw_count = 0;
   int throw_count        = 0;
-#pragma omp parallel for reduction(+ : nested_throw_count, throw_count)
+#pragma omp parallel for num_threads(num_threads) reduction(+ : nested_throw_count, throw_count)
   for (int task_id = 0; task_id < num_tasks; ++task_id)
   {
+    // only affects the regions nested in this task
+    if (nested)
+      omp_set_num_threads(nested_threads_);
     try
     {
       f(task_id, std::forward<Args>(args)...);
@@ -63,6 +74,8 @@ void ParallelExecutor<Executor::OPENMP>::operator()(int num_tasks, F&& f, Args&&
       ++throw_count;
     }
   }
+  if (nested)
+    omp_set_max_active_levels(saved_levels);
   if (throw_count > 0)
     throw std::runtime_error("Unexpected exception thrown in threaded section");
   else if (nested_throw_count > 0)
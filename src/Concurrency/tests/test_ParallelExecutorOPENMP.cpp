@@ -11,6 +11,7 @@
 
 #include "catch.hpp"
 
+#include <vector>
 #include "Concurrency/ParallelExecutor.hpp"
 
 namespace qmcplusplus
@@ -48,6 +49,24 @@ TEST_CASE("ParallelExecutor<OPENMP> lambda case", "[concurrency]")
   REQUIRE(count == num_threads);
 }
 
+TEST_CASE("ParallelExecutor<OPENMP> nested thread team", "[concurrency]")
+{
+  const int num_tasks      = 3;
+  const int nested_threads = 2;
+  const int max_levels     = omp_get_max_active_levels();
+  ParallelExecutor<Executor::OPENMP> test_block(nested_threads);
+  std::vector<int> team_sizes(num_tasks, 0);
+  test_block(
+      num_tasks, [](int task_id, std::vector<int>& sizes) { sizes[task_id] = getNextLevelNumThreads(); },
+      std::ref(team_sizes));
+#ifdef _OPENMP
+  for (int team_size : team_sizes)
+    CHECK(team_size == nested_threads);
+#endif
+  // the OpenMP settings are restored after the tasks
+  CHECK(omp_get_max_active_levels() == max_levels);
+}
+
 TEST_CASE("ParallelExecutor<OPENMP> nested case", "[concurrency]")
 {
   int num_threads = 1;
@@ -0,0 +1,41 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+#include "CrowdPropertyBlock.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace qmcplusplus
+{
+void CrowdPropertyBlock::load(const RefVector<MCPWalker>& walkers)
+{
+  walkers_        = walkers;
+  const size_t nw = walkers.size();
+  num_properties_ = nw > 0 ? walkers[0].get().Properties.cols() : 0;
+  total_weight_   = 0.0;
+  if (columns_.rows() < num_properties_ || columns_.cols() < nw)
+    columns_.resize(std::max(columns_.rows(), num_properties_), std::max(columns_.cols(), nw));
+  if (weights_.size() < nw)
+    weights_.resize(nw);
+
+  for (size_t iw = 0; iw < nw; ++iw)
+  {
+    const MCPWalker& walker = walkers[iw];
+    assert(walker.Properties.cols() == num_properties_);
+    const RealType* restrict props = walker.getPropertyBase();
+    for (size_t iprop = 0; iprop < num_properties_; ++iprop)
+      columns_(iprop, iw) = props[iprop];
+    weights_[iw] = walker.Weight;
+    total_weight_ += walker.Weight;
+  }
+}
+} // namespace qmcplusplus
@@ -0,0 +1,62 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef QMCPLUSPLUS_CROWDPROPERTYBLOCK_H
+#define QMCPLUSPLUS_CROWDPROPERTYBLOCK_H
+
+#include "Configuration.h"
+#include "OhmmsPETE/OhmmsMatrix.h"
+#include "Particle/Walker.h"
+#include "type_traits/template_types.hpp"
+
+namespace qmcplusplus
+{
+/** SoA copy of the walker properties of a crowd.
+ *
+ *  Each walker keeps its properties as a row of its own Properties container. The block gathers them once per
+ *  accumulate into a (property x walker) matrix so that every property is a contiguous column over the crowd
+ *  and the scalar estimators reduce it with a single weighted sum instead of revisiting each walker.
+ *  Only the first property row (the one filled by QMCHamiltonian::saveProperty) is gathered.
+ */
+class CrowdPropertyBlock
+{
+public:
+  using MCPWalker = Walker<QMCTraits, PtclOnLatticeTraits>;
+  using RealType  = QMCTraits::FullPrecRealType;
+
+  /** gather the properties and weights of walkers
+   *  storage only grows so that the steady state does not allocate.
+   */
+  void load(const RefVector<MCPWalker>& walkers);
+
+  /// number of walkers in the block
+  size_t size() const { return walkers_.size(); }
+  /// number of properties per walker
+  size_t numProperties() const { return num_properties_; }
+  /// values of the iprop-th property of all the walkers
+  const RealType* getColumn(size_t iprop) const { return columns_[iprop]; }
+  /// walker weights
+  const RealType* getWeights() const { return weights_.data(); }
+  /// sum of the walker weights
+  RealType getTotalWeight() const { return total_weight_; }
+  /// the walkers the block was loaded from, for estimators which need more than the first property row
+  const RefVector<MCPWalker>& getWalkers() const { return walkers_; }
+
+private:
+  RefVector<MCPWalker> walkers_;
+  size_t num_properties_ = 0;
+  RealType total_weight_ = 0.0;
+  /// [property][walker] with the walker index padded to the capacity
+  Matrix<RealType> columns_;
+  std::vector<RealType> weights_;
+};
+} // namespace qmcplusplus
+#endif
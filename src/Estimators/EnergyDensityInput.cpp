@@ -0,0 +1,51 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//
+// Some code refactored from: QMCHamiltonians/EnergyDensityEstimator.cpp
+//////////////////////////////////////////////////////////////////////////////////////
+
+#include "EnergyDensityInput.h"
+
+#include "OhmmsData/AttributeSet.h"
+#include "Message/UniformCommunicateError.h"
+
+namespace qmcplusplus
+{
+
+EnergyDensityInput::EnergyDensityInput(xmlNodePtr cur) { readXML(cur); }
+
+void EnergyDensityInput::readXML(xmlNodePtr cur)
+{
+  std::string ion_points("no");
+  OhmmsAttributeSet attrib;
+  attrib.add(name_, "name");
+  attrib.add(dynamic_, "dynamic");
+  attrib.add(static_, "static");
+  attrib.add(ion_points, "ion_points");
+  attrib.put(cur);
+
+  if (ion_points == "yes" || ion_points == "true")
+    throw UniformCommunicateError("EnergyDensity ion_points is not supported by the batched drivers");
+
+  xmlNodePtr element = cur->xmlChildrenNode;
+  while (element != NULL)
+  {
+    std::string ename((const char*)element->name);
+    if (ename == "spacegrid")
+      space_grid_inputs_.emplace_back(element);
+    else if (ename == "reference_points")
+      throw UniformCommunicateError("EnergyDensity reference_points are not supported by the batched drivers");
+    element = element->next;
+  }
+  if (space_grid_inputs_.empty())
+    throw UniformCommunicateError("EnergyDensity input must contain at least one spacegrid");
+}
+
+} // namespace qmcplusplus
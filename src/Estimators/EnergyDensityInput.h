@@ -0,0 +1,62 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//
+// Some code refactored from: QMCHamiltonians/EnergyDensityEstimator.cpp
+//////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef QMCPLUSPLUS_ENERGYDENSITYINPUT_H
+#define QMCPLUSPLUS_ENERGYDENSITYINPUT_H
+
+#include <string>
+#include <vector>
+#include "Configuration.h"
+#include "SpaceGridInput.h"
+
+namespace qmcplusplus
+{
+class EnergyDensityNew;
+
+/** Native representation of the EnergyDensity estimator input
+ *
+ *  <estimator type="EnergyDensity" name="EDcell" dynamic="e" static="ion0">
+ *    <spacegrid coord="cartesian"> ... </spacegrid>
+ *  </estimator>
+ *
+ *  The static particle set is optional, when given its particles are binned with
+ *  their share of the local potential. The legacy reference_points element and
+ *  ion_points attribute are not supported.
+ */
+class EnergyDensityInput
+{
+public:
+  using Consumer = EnergyDensityNew;
+
+  EnergyDensityInput(xmlNodePtr cur);
+  /** default copy constructor
+   *  This is required due to EDI being part of a variant used as a vector element.
+   */
+  EnergyDensityInput(const EnergyDensityInput&) = default;
+
+  const std::string& get_name() const { return name_; }
+  const std::string& get_dynamic() const { return dynamic_; }
+  const std::string& get_static() const { return static_; }
+  const std::vector<SpaceGridInput>& get_space_grid_inputs() const { return space_grid_inputs_; }
+
+private:
+  void readXML(xmlNodePtr cur);
+
+  std::string name_ = "EnergyDensity";
+  std::string dynamic_;
+  std::string static_;
+  std::vector<SpaceGridInput> space_grid_inputs_;
+};
+
+} // namespace qmcplusplus
+#endif
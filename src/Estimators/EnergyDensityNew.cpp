@@ -0,0 +1,192 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//
+// Some code refactored from: QMCHamiltonians/EnergyDensityEstimator.cpp
+//////////////////////////////////////////////////////////////////////////////////////
+
+#include "EnergyDensityNew.h"
+
+#include <algorithm>
+#include "Particle/DistanceTable.h"
+#include "Message/UniformCommunicateError.h"
+
+namespace qmcplusplus
+{
+
+EnergyDensityNew::EnergyDensityNew(EnergyDensityInput&& input, const ParticleSet& pset_dynamic)
+    : OperatorEstBase(DataLocality::crowd), input_(std::move(input))
+{
+  requires_listener_ = true;
+  my_name_           = input_.get_name();
+  periodic_          = pset_dynamic.getLattice().SuperCellEnum != SUPERCELL_OPEN;
+  n_dynamic_         = pset_dynamic.getTotalNum();
+
+  const ParticleSet* pset_static = nullptr;
+  if (!input_.get_static().empty())
+  {
+    for (int i = 0; i < pset_dynamic.getNumDistTables(); ++i)
+      if (pset_dynamic.getDistTable(i).get_origin().getName() == input_.get_static())
+        pset_static = &pset_dynamic.getDistTable(i).get_origin();
+    if (pset_static == nullptr || pset_static == &pset_dynamic)
+      throw UniformCommunicateError("EnergyDensityNew static particleset " + input_.get_static() +
+                                    " is not a source of the distance tables of " + pset_dynamic.getName());
+    n_static_         = pset_static->getTotalNum();
+    static_positions_ = pset_static->R;
+  }
+
+  const Points points = makeReferencePoints(pset_dynamic.getLattice(), pset_static);
+  size_t offset       = 0;
+  for (const SpaceGridInput& space_grid_input : input_.get_space_grid_inputs())
+  {
+    space_grids_.emplace_back(space_grid_input, points, nEDValues);
+    grid_offsets_.push_back(offset);
+    offset += space_grids_.back().size();
+  }
+  outside_offset_ = offset;
+  data_.resize(outside_offset_ + nEDValues, 0.0);
+}
+
+EnergyDensityNew::EnergyDensityNew(const EnergyDensityNew& ed, DataLocality dl) : EnergyDensityNew(ed)
+{
+  data_locality_ = dl;
+}
+
+std::unique_ptr<OperatorEstBase> EnergyDensityNew::spawnCrowdClone() const
+{
+  auto spawn = std::make_unique<EnergyDensityNew>(*this, data_locality_);
+  spawn->get_data().resize(data_.size(), 0.0);
+  return spawn;
+}
+
+EnergyDensityNew::Points EnergyDensityNew::makeReferencePoints(const Lattice& lattice, const ParticleSet* pset_static)
+{
+  using Point = SpaceGridNew::Point;
+  Points points;
+  points["zero"] = 0 * lattice.a(0);
+  points["a1"]   = lattice.a(0);
+  points["a2"]   = lattice.a(1);
+  points["a3"]   = lattice.a(2);
+  const std::string axis_names[OHMMS_DIM] = {"1", "2", "3"};
+  for (int d = 0; d < OHMMS_DIM; ++d)
+  {
+    points["f" + axis_names[d] + "p"] = .5 * lattice.a(d);
+    points["f" + axis_names[d] + "m"] = -.5 * lattice.a(d);
+  }
+  // corners, e.g. cpmm = .5 * (a1 - a2 - a3)
+  for (int corner = 0; corner < 8; ++corner)
+  {
+    std::string name("c");
+    Point r = 0.0;
+    for (int d = 0; d < OHMMS_DIM; ++d)
+    {
+      const bool plus = corner & (4 >> d);
+      name += plus ? "p" : "m";
+      r += (plus ? .5 : -.5) * lattice.a(d);
+    }
+    points[name] = r;
+  }
+  if (pset_static)
+    for (int p = 0; p < pset_static->getTotalNum(); ++p)
+      points[pset_static->getName() + std::to_string(p + 1)] = pset_static->R[p];
+  return points;
+}
+
+ListenerVector<QMCTraits::RealType>::ReportingFunction EnergyDensityNew::getListener(OperatorValues& local_values)
+{
+  return [&local_values](const int walker_index, const std::string& name, const Vector<Real>& inputV) {
+    auto& operator_values = local_values[name];
+    if (walker_index >= operator_values.size())
+      operator_values.resize(walker_index + 1);
+    operator_values[walker_index] = inputV;
+  };
+}
+
+EnergyDensityNew::Real EnergyDensityNew::sumOperatorValues(const OperatorValues& values, int iw, int i)
+{
+  Real sum = 0.0;
+  for (const auto& [name, operator_values] : values)
+    if (iw < operator_values.size() && i < operator_values[iw].size())
+      sum += operator_values[iw][i];
+  return sum;
+}
+
+void EnergyDensityNew::registerListeners(QMCHamiltonian& ham_leader)
+{
+  QMCHamiltonian::mw_registerKineticListener(ham_leader, ListenerVector<Real>(my_name_, getListener(kinetic_values_)));
+  QMCHamiltonian::mw_registerLocalPotentialListener(ham_leader,
+                                                    ListenerVector<Real>(my_name_, getListener(potential_values_)));
+  if (n_static_ > 0)
+    QMCHamiltonian::mw_registerLocalIonPotentialListener(ham_leader,
+                                                         ListenerVector<Real>(my_name_,
+                                                                              getListener(ion_potential_values_)));
+}
+
+void EnergyDensityNew::accumulate(const RefVector<MCPWalker>& walkers,
+                                  const RefVector<ParticleSet>& psets,
+                                  const RefVector<TrialWaveFunction>& wfns,
+                                  RandomGenerator& rng)
+{
+  const int nw = walkers.size();
+  const int np = n_dynamic_ + n_static_;
+  crowd_positions_.resize(nw * np);
+  crowd_values_.resize(nw * np, nEDValues);
+  particles_outside_.assign(nw * np, true);
+  walker_positions_.resize(np);
+
+  for (int iw = 0; iw < nw; ++iw)
+  {
+    ParticleSet& pset = psets[iw];
+    const Real w      = walkers[iw].get().Weight;
+    walkers_weight_ += w;
+
+    std::copy_n(pset.R.begin(), n_dynamic_, walker_positions_.begin());
+    std::copy_n(static_positions_.begin(), n_static_, walker_positions_.begin() + n_dynamic_);
+    if (periodic_)
+      pset.applyMinimumImage(walker_positions_);
+
+    for (int ip = 0; ip < np; ++ip)
+      crowd_positions_(iw * np + ip) = walker_positions_[ip];
+    for (int ip = 0; ip < n_dynamic_; ++ip)
+    {
+      Real* values = crowd_values_[iw * np + ip];
+      values[W]    = w;
+      values[T]    = w * sumOperatorValues(kinetic_values_, iw, ip);
+      values[V]    = w * sumOperatorValues(potential_values_, iw, ip);
+    }
+    for (int ip = 0; ip < n_static_; ++ip)
+    {
+      Real* values = crowd_values_[iw * np + n_dynamic_ + ip];
+      values[W]    = w;
+      values[T]    = 0.0;
+      values[V]    = w * sumOperatorValues(ion_potential_values_, iw, ip);
+    }
+  }
+
+  for (int ig = 0; ig < space_grids_.size(); ++ig)
+    space_grids_[ig].accumulate(crowd_positions_, crowd_values_, data_.data() + grid_offsets_[ig], particles_outside_);
+
+  for (int i = 0; i < nw * np; ++i)
+    if (particles_outside_[i])
+      for (int iv = 0; iv < nEDValues; ++iv)
+        data_[outside_offset_ + iv] += crowd_values_(i, iv);
+}
+
+void EnergyDensityNew::registerOperatorEstimator(hdf_archive& file)
+{
+  hdf_path hdf_name{my_name_};
+  for (int ig = 0; ig < space_grids_.size(); ++ig)
+    space_grids_[ig].registerGrid(h5desc_, file, hdf_name / ("spacegrid" + std::to_string(ig + 1)),
+                                  grid_offsets_[ig]);
+  h5desc_.emplace_back(hdf_name / "outside");
+  std::vector<int> ng(1, nEDValues);
+  h5desc_.back().set_dimensions(ng, outside_offset_);
+}
+
+} // namespace qmcplusplus
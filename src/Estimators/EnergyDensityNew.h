@@ -0,0 +1,135 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//
+// Some code refactored from: QMCHamiltonians/EnergyDensityEstimator.cpp
+//////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef QMCPLUSPLUS_ENERGYDENSITYNEW_H
+#define QMCPLUSPLUS_ENERGYDENSITYNEW_H
+
+#include <vector>
+#include <unordered_map>
+#include "OperatorEstBase.h"
+#include "EnergyDensityInput.h"
+#include "SpaceGridNew.h"
+#include "QMCHamiltonians/Listener.hpp"
+
+namespace qmcplusplus
+{
+namespace testing
+{
+class EnergyDensityNewTests;
+}
+
+/** Energy density estimator for the batched drivers.
+ *
+ *  Batched port of the legacy EnergyDensityEstimator. The per particle kinetic and local
+ *  potential energies are not read from traces but reported by the Hamiltonian operators
+ *  to the listeners this estimator registers. Each step the weight, kinetic and potential
+ *  energies of the particles of all the walkers of the crowd are binned at once into every
+ *  space grid, values of particles outside all the grids are summed separately.
+ *
+ *  data_ layout: the ndomains x nEDValues block of each space grid followed by
+ *  the nEDValues of the particles outside all the grids.
+ */
+class EnergyDensityNew : public OperatorEstBase
+{
+public:
+  using Real    = QMCTraits::RealType;
+  using Points  = SpaceGridNew::Points;
+  using Lattice = PtclOnLatticeTraits::ParticleLayout;
+  /// per walker values reported by each operator, keyed by the operator name
+  using OperatorValues = std::unordered_map<std::string, std::vector<Vector<Real>>>;
+
+  enum
+  {
+    W = 0,
+    T,
+    V,
+    nEDValues
+  };
+
+  /** Standard constructor
+   *  @param input          energy density input
+   *  @param pset_dynamic   the target particle set, the static particle set named in the input
+   *                        must be the source of one of its distance tables
+   */
+  EnergyDensityNew(EnergyDensityInput&& input, const ParticleSet& pset_dynamic);
+
+  /** Constructor used when spawning crowd clones
+   *  needs to be public so std::make_unique can call it.
+   */
+  EnergyDensityNew(const EnergyDensityNew& ed, DataLocality dl);
+
+  void accumulate(const RefVector<MCPWalker>& walkers,
+                  const RefVector<ParticleSet>& psets,
+                  const RefVector<TrialWaveFunction>& wfns,
+                  RandomGenerator& rng) override;
+
+  std::unique_ptr<OperatorEstBase> spawnCrowdClone() const override;
+
+  void startBlock(int steps) override {}
+
+  void registerListeners(QMCHamiltonian& ham_leader) override;
+
+  void registerOperatorEstimator(hdf_archive& file) override;
+
+  /** return lambda function to register as listener
+   *  each operator overwrites its own per walker values on every Hamiltonian evaluation,
+   *  so evaluations that are not accumulated, e.g. warmup steps, do not leak into the next sample.
+   *  \param[out] values    per operator, per walker values
+   */
+  static ListenerVector<Real>::ReportingFunction getListener(OperatorValues& values);
+
+  /** the named points the space grid inputs can refer to
+   *  zero, the cell axes a1 a2 a3, the face centers f1p f1m ... and corners cmmm cpmm ...
+   *  of the cell and the particles of the static particle set, e.g. ion01.
+   */
+  static Points makeReferencePoints(const Lattice& lattice, const ParticleSet* pset_static);
+
+  const std::vector<SpaceGridNew>& get_space_grids() const { return space_grids_; }
+  size_t get_outside_offset() const { return outside_offset_; }
+
+private:
+  EnergyDensityNew(const EnergyDensityNew& ed) = default;
+
+  /// sum of the values of particle i of walker iw over the operators
+  static Real sumOperatorValues(const OperatorValues& values, int iw, int i);
+
+  EnergyDensityInput input_;
+  bool periodic_;
+  int n_dynamic_;
+  int n_static_ = 0;
+  /// positions of the static particles
+  ParticleSet::ParticlePos static_positions_;
+  std::vector<SpaceGridNew> space_grids_;
+  std::vector<size_t> grid_offsets_;
+  size_t outside_offset_;
+
+  /** @ingroup Per operator, per walker listener values of the crowd from the last Hamiltonian evaluation
+   *  @{ */
+  OperatorValues kinetic_values_;
+  OperatorValues potential_values_;
+  OperatorValues ion_potential_values_;
+  /** @} */
+
+  /** @ingroup Crowd workspaces, row: walker * particle
+   *  @{ */
+  SpaceGridNew::Positions crowd_positions_;
+  Matrix<Real> crowd_values_;
+  std::vector<bool> particles_outside_;
+  ParticleSet::ParticlePos walker_positions_;
+  /** @} */
+
+  friend class testing::EnergyDensityNewTests;
+};
+
+} // namespace qmcplusplus
+#endif
@@ -20,5 +20,10 @@
 #include "OneBodyDensityMatricesInput.h"
 #include "SpinDensityInput.h"
 #include "PerParticleHamiltonianLoggerInput.h"
+#include "EnergyDensityInput.h"
+#include "StructureFactorInput.h"
+#include "PairCorrelationInput.h"
+#include "TraceStreamInput.h"
+#include "ForwardWalkingInput.h"
 
 #endif
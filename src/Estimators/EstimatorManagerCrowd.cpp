@@ -27,17 +27,25 @@ void EstimatorManagerCrowd::accumulate(const RefVector<MCPWalker>& walkers,
                                        const RefVector<TrialWaveFunction>& wfns,
                                        RandomGenerator& rng)
 {
-  block_num_samples_ += walkers.size();
-  for (MCPWalker& awalker : walkers)
-    block_weight_ += awalker.Weight;
-  main_estimator_->accumulate(walkers);
+  // walker properties are gathered once and shared by all the scalar estimators
+  property_block_.load(walkers);
+  block_num_samples_ += property_block_.size();
+  block_weight_ += property_block_.getTotalWeight();
+  main_estimator_->accumulateProperties(property_block_);
   int num_scalar_estimators = scalar_estimators_.size();
   for (int i = 0; i < num_scalar_estimators; ++i)
-    scalar_estimators_[i]->accumulate(walkers);
+    scalar_estimators_[i]->accumulateProperties(property_block_);
   for (int i = 0; i < operator_ests_.size(); ++i)
     operator_ests_[i]->accumulate(walkers, psets, wfns, rng);
 }
 
+void EstimatorManagerCrowd::accumulateBeads(const RealType* head, const RealType* tail, const RealType* center)
+{
+  main_estimator_->accumulateBeads(head, tail, center);
+  for (auto& estimator : scalar_estimators_)
+    estimator->accumulateBeads(head, tail, center);
+}
+
 void EstimatorManagerCrowd::registerListeners(const RefVectorWithLeader<QMCHamiltonian>& ham_list)
 {
   for (auto& estimator : operator_ests_)
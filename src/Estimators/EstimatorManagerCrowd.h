@@ -19,6 +19,7 @@
 #include "Pools/PooledData.h"
 #include "Message/Communicate.h"
 #include "Estimators/ScalarEstimatorBase.h"
+#include "Estimators/CrowdPropertyBlock.h"
 #include "Estimators/EstimatorManagerNew.h"
 #include "Particle/Walker.h"
 #include "OhmmsPETE/OhmmsVector.h"
@@ -79,6 +80,11 @@ public:
                   const RefVector<TrialWaveFunction>& wfns,
                   RandomGenerator& rng);
 
+  /** Accumulate the head, tail and center bead properties of a reptile of the batched RMC driver
+   *  into the scalar estimators, the walkers of accumulate are only the heads.
+   */
+  void accumulateBeads(const RealType* head, const RealType* tail, const RealType* center);
+
   ScalarEstimatorBase& get_main_estimator() { return *main_estimator_; }
   RefVector<ScalarEstimatorBase> get_scalar_estimators() { return convertUPtrToRefVector(scalar_estimators_); }
   RefVector<qmcplusplus::OperatorEstBase> get_operator_estimators() { return convertUPtrToRefVector(operator_ests_); }
@@ -102,6 +108,9 @@ private:
   std::vector<std::unique_ptr<ScalarEstimatorBase>> scalar_estimators_;
 
   std::vector<std::unique_ptr<OperatorEstBase>> operator_ests_;
+
+  ///walker properties of the crowd in columns, reloaded at every accumulate
+  CrowdPropertyBlock property_block_;
 };
 
 } // namespace qmcplusplus
@@ -16,6 +16,11 @@
 #include "OneBodyDensityMatricesInput.h"
 #include "SpinDensityInput.h"
 #include "PerParticleHamiltonianLoggerInput.h"
+#include "EnergyDensityInput.h"
+#include "StructureFactorInput.h"
+#include "PairCorrelationInput.h"
+#include "TraceStreamInput.h"
+#include "ForwardWalkingInput.h"
 #include "ModernStringUtils.hpp"
 
 namespace qmcplusplus
@@ -88,6 +93,16 @@ void EstimatorManagerInput::readXML(xmlNodePtr cur)
         appendEstimatorInput<MomentumDistributionInput>(child);
       else if (atype == "perparticlehamiltonianlogger")
         appendEstimatorInput<PerParticleHamiltonianLoggerInput>(child);
+      else if (atype == "energydensity")
+        appendEstimatorInput<EnergyDensityInput>(child);
+      else if (atype == "sk")
+        appendEstimatorInput<StructureFactorInput>(child);
+      else if (atype == "gofr")
+        appendEstimatorInput<PairCorrelationInput>(child);
+      else if (atype == "tracestream")
+        appendEstimatorInput<TraceStreamInput>(child);
+      else if (atype == "forwardwalking")
+        appendEstimatorInput<ForwardWalkingInput>(child);
       else
         throw UniformCommunicateError(error_tag + "unparsable <estimator> node, name: " + aname + " type: " + atype +
                                       " in Estimators input.");
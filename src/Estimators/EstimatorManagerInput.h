@@ -41,11 +41,21 @@ class SpinDensityInput;
 class MomentumDistributionInput;
 class OneBodyDensityMatricesInput;
 class PerParticleHamiltonianLoggerInput;
+class EnergyDensityInput;
+class StructureFactorInput;
+class PairCorrelationInput;
+class TraceStreamInput;
+class ForwardWalkingInput;
 using EstimatorInput  = std::variant<std::monostate,
                                     MomentumDistributionInput,
                                     SpinDensityInput,
                                     OneBodyDensityMatricesInput,
-                                    PerParticleHamiltonianLoggerInput>;
+                                    PerParticleHamiltonianLoggerInput,
+                                    EnergyDensityInput,
+                                    StructureFactorInput,
+                                    PairCorrelationInput,
+                                    TraceStreamInput,
+                                    ForwardWalkingInput>;
 using EstimatorInputs = std::vector<EstimatorInput>;
 
 /** The scalar esimtator inputs
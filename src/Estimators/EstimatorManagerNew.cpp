@@ -19,6 +19,11 @@
 #include "MomentumDistribution.h"
 #include "OneBodyDensityMatrices.h"
 #include "PerParticleHamiltonianLogger.h"
+#include "EnergyDensityNew.h"
+#include "StructureFactorEstimator.h"
+#include "PairCorrelationEstimator.h"
+#include "TraceStreamEstimator.h"
+#include "ForwardWalkingEstimator.h"
 #include "QMCHamiltonians/QMCHamiltonian.h"
 #include "Message/Communicate.h"
 #include "Message/CommOperators.h"
@@ -55,6 +60,18 @@ bool EstimatorManagerNew::areThereListeners() const
   return std::any_of(operator_ests_.begin(), operator_ests_.end(),
                      [](auto& oper_est) { return oper_est->isListenerRequired(); });
 }
+
+bool EstimatorManagerNew::registerAncestry(WalkerAncestry& ancestry)
+{
+  bool required = false;
+  for (auto& op_est : operator_ests_)
+    if (op_est->isAncestryRequired())
+    {
+      op_est->registerAncestry(ancestry);
+      required = true;
+    }
+  return required;
+}
   
 template<class EstInputType, typename... Args>
 bool EstimatorManagerNew::createEstimator(EstimatorInput& input, Args&&... args)
@@ -90,7 +107,7 @@ bool EstimatorManagerNew::createScalarEstimator(ScalarEstimatorInput& input, Arg
 EstimatorManagerNew::EstimatorManagerNew(Communicate* c,
                                          EstimatorManagerInput&& emi,
                                          const QMCHamiltonian& H,
-                                         const ParticleSet& pset,
+                                         ParticleSet& pset,
                                          const TrialWaveFunction& twf)
     : RecordCount(0), my_comm_(c), max4ascii(8), FieldWidth(20)
 {
@@ -100,7 +117,12 @@ EstimatorManagerNew::EstimatorManagerNew(Communicate* c,
                                                      pset.getLattice()) ||
           createEstimator<OneBodyDensityMatricesInput>(est_input, pset.getLattice(), pset.getSpeciesSet(),
                                                        twf.getSPOMap(), pset) ||
-          createEstimator<PerParticleHamiltonianLoggerInput>(est_input, my_comm_->rank())))
+          createEstimator<PerParticleHamiltonianLoggerInput>(est_input, my_comm_->rank()) ||
+          createEstimator<EnergyDensityInput>(est_input, pset) ||
+          createEstimator<StructureFactorInput>(est_input, pset) ||
+          createEstimator<PairCorrelationInput>(est_input, pset) ||
+          createEstimator<TraceStreamInput>(est_input, my_comm_->rank()) ||
+          createEstimator<ForwardWalkingInput>(est_input, H)))
       throw UniformCommunicateError(std::string(error_tag_) +
                                     "cannot construct an estimator from estimator input object.");
 
@@ -195,6 +217,19 @@ void EstimatorManagerNew::startDriverRun()
   RecordCount = 0;
   energyAccumulator.clear();
   varAccumulator.clear();
+  if (reblocking_)
+  {
+    reblocked_indices_.clear();
+    for (const std::string& name : reblocked_names_)
+    {
+      auto it = std::find(BlockAverages.Names.begin(), BlockAverages.Names.end(), name);
+      if (it == BlockAverages.Names.end())
+        throw UniformCommunicateError(std::string(error_tag_) + "cannot reblock " + name +
+                                      ", it is not a scalar estimator value");
+      reblocked_indices_.push_back(std::distance(BlockAverages.Names.begin(), it));
+    }
+    reblockers_.assign(reblocked_names_.size(), ReblockingAccumulator());
+  }
   BlockAverages.setValues(0.0);
   AverageCache.resize(BlockAverages.size());
   PropertyCache.resize(BlockProperties.size());
@@ -261,18 +296,12 @@ void EstimatorManagerNew::collectMainEstimators(const RefVector<ScalarEstimatorB
 
 void EstimatorManagerNew::collectScalarEstimators(const std::vector<RefVector<ScalarEstimatorBase>>& crowd_scalar_ests)
 {
-  assert(crowd_scalar_ests[0].size() == scalar_ests_.size());
-  for (int iop = 0; iop < scalar_ests_.size(); ++iop)
-  {
-    RefVector<ScalarEstimatorBase> this_scalar_est_for_all_crowds;
-    for (int icrowd = 0; icrowd < crowd_scalar_ests.size(); ++icrowd)
-      this_scalar_est_for_all_crowds.emplace_back(crowd_scalar_ests[icrowd][iop]);
-    // There is actually state in each Scalar estimator that tells it what it's "first" index in the AverageCache
-    // is, It's quite unclear to me if that would really work so I'm doing this in anticipation of having to rework that
-    // if we don't drop multiple scalar estimators per crowd all together.
-    for (ScalarEstimatorBase& est : this_scalar_est_for_all_crowds)
+  assert(crowd_scalar_ests.empty() || crowd_scalar_ests[0].size() == scalar_ests_.size());
+  // Each scalar estimator owns the [FirstIndex, LastIndex) slice of AverageCache, so the crowd sums of all
+  // of them are reduced in a single pass into that buffer which is then reduced over ranks with PropertyCache.
+  for (const RefVector<ScalarEstimatorBase>& crowd_ests : crowd_scalar_ests)
+    for (ScalarEstimatorBase& est : crowd_ests)
       est.addAccumulated(AverageCache.begin());
-  }
 }
 
 void EstimatorManagerNew::collectOperatorEstimators(const std::vector<RefVector<OperatorEstBase>>& crowd_op_ests)
@@ -338,6 +367,26 @@ void EstimatorManagerNew::makeBlockAverages(unsigned long accepts, unsigned long
   //add the block average to summarize
   energyAccumulator(AverageCache[0]);
   varAccumulator(AverageCache[1]);
+
+  // only rank 0 has the reduced block averages
+  if (my_comm_->rank() == 0)
+    for (int i = 0; i < reblockers_.size(); ++i)
+      reblockers_[i](AverageCache[reblocked_indices_[i]]);
+}
+
+void EstimatorManagerNew::restartReblocking()
+{
+  for (ReblockingAccumulator& reblocker : reblockers_)
+    reblocker.clear();
+}
+
+void EstimatorManagerNew::setReblockedScalars(const std::vector<std::string>& names)
+{
+  reblocking_      = true;
+  reblocked_names_ = {"LocalEnergy"};
+  for (const std::string& name : names)
+    if (std::find(reblocked_names_.begin(), reblocked_names_.end(), name) == reblocked_names_.end())
+      reblocked_names_.push_back(name);
 }
 
 void EstimatorManagerNew::writeScalarH5()
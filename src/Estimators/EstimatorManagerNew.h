@@ -20,6 +20,7 @@
 #include "Message/Communicate.h"
 #include "Estimators/ScalarEstimatorBase.h"
 #include "OperatorEstBase.h"
+#include "ReblockingAccumulator.h"
 #include "Particle/Walker.h"
 #include "OhmmsPETE/OhmmsVector.h"
 #include "type_traits/template_types.hpp"
@@ -30,6 +31,7 @@ namespace qmcplusplus
 {
 class QMCHamiltonian;
 class hdf_archive;
+class WalkerAncestry;
 
 namespace testing
 {
@@ -61,13 +63,13 @@ public:
    *
    *  \param[in]  emi    EstimatorManagerInput consisting of merged global and local estimator definitions. Moved from!
    *  \param[in]  H      Fully Constructed Golden Hamiltonian.
-   *  \param[in]  pset   The electron or equiv. pset
+   *  \param[in]  pset   The electron or equiv. pset, estimators may add the distance tables they need to it.
    *  \param[in]  twf    The fully constructed TrialWaveFunction.
    */
   EstimatorManagerNew(Communicate* comm,
                       EstimatorManagerInput&& emi,
                       const QMCHamiltonian& H,
-                      const ParticleSet& pset,
+                      ParticleSet& pset,
                       const TrialWaveFunction& twf);
   ///destructor
   ~EstimatorManagerNew();
@@ -141,6 +143,20 @@ public:
    */
   void getApproximateEnergyVariance(RealType& e, RealType& var);
 
+  /** Reblock the local energy and the named scalars online
+   *
+   *  \param[in] names   BlockAverages names of the scalars besides LocalEnergy, resolved in startDriverRun.
+   */
+  void setReblockedScalars(const std::vector<std::string>& names);
+
+  /** online reblocking of the block averages, LocalEnergy first.
+   *  Only valid on rank 0 and empty unless setReblockedScalars was called.
+   */
+  const std::vector<ReblockingAccumulator>& get_reblockers() const { return reblockers_; }
+  /// drop the block averages reblocked so far, e.g. those of the DMC equilibration
+  void restartReblocking();
+  const std::vector<std::string>& get_reblocked_names() const { return reblocked_names_; }
+
   auto& get_AverageCache() { return AverageCache; }
 
   std::size_t getNumEstimators() { return operator_ests_.size(); }
@@ -151,6 +167,11 @@ public:
    */
   bool areThereListeners() const;
 
+  /** Hand the branching record of the population to the estimators that need it
+   *  \return true if any estimator does, the caller should then enable recording the ancestry.
+   */
+  bool registerAncestry(WalkerAncestry& ancestry);
+
 private:
   /** Construct estimator of type matching the underlying EstimatorInput type Consumer
    *  and push its its unique_ptr onto operator_ests_
@@ -235,6 +256,12 @@ private:
   ScalarEstimatorBase::accumulator_type energyAccumulator;
   /** accumulator for the variance **/
   ScalarEstimatorBase::accumulator_type varAccumulator;
+  ///if true the block averages are reblocked online
+  bool reblocking_ = false;
+  ///names and AverageCache indices of the reblocked scalars
+  std::vector<std::string> reblocked_names_;
+  std::vector<int> reblocked_indices_;
+  std::vector<ReblockingAccumulator> reblockers_;
   ///cached block averages of the values
 
   Vector<RealType> AverageCache;
@@ -0,0 +1,183 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+#include "ForwardWalkingEstimator.h"
+
+#include <algorithm>
+#include "Particle/WalkerAncestry.h"
+#include "QMCDrivers/WalkerProperties.h"
+#include "Message/UniformCommunicateError.h"
+
+namespace qmcplusplus
+{
+ForwardWalkingEstimator::ForwardWalkingEstimator(ForwardWalkingInput&& input, const QMCHamiltonian& ham)
+    : OperatorEstBase(DataLocality::crowd),
+      input_(std::move(input)),
+      num_observables_(input_.get_observables().size()),
+      num_steps_(input_.get_steps().size()),
+      rank_estimator_(nullptr)
+{
+  using WP           = WalkerProperties::Indexes;
+  requires_ancestry_ = true;
+  my_name_           = input_.get_name();
+  for (const std::string& name : input_.get_observables())
+    if (name == "LocalEnergy")
+      property_indices_.push_back(WP::LOCALENERGY);
+    else if (name == "LocalPotential")
+      property_indices_.push_back(WP::LOCALPOTENTIAL);
+    else
+    {
+      const int iobs = ham.getObservable(name);
+      if (iobs < 0)
+        throw UniformCommunicateError("ForwardWalking: " + name + " is not an observable of the Hamiltonian");
+      property_indices_.push_back(ham.startIndex() + iobs);
+    }
+  data_.resize(num_steps_ * (num_observables_ + 1), 0.0);
+  next_generation_.resize(num_steps_, 0);
+}
+
+ForwardWalkingEstimator::ForwardWalkingEstimator(const ForwardWalkingEstimator& fwe, DataLocality dl)
+    : OperatorEstBase(dl),
+      input_(fwe.input_),
+      property_indices_(fwe.property_indices_),
+      num_observables_(fwe.num_observables_),
+      num_steps_(fwe.num_steps_),
+      rank_estimator_(const_cast<ForwardWalkingEstimator*>(&fwe))
+{
+  requires_ancestry_ = true;
+  my_name_           = fwe.my_name_;
+  data_.resize(fwe.data_.size(), 0.0);
+}
+
+void ForwardWalkingEstimator::registerAncestry(WalkerAncestry& ancestry) { ancestry_ = &ancestry; }
+
+void ForwardWalkingEstimator::accumulate(const RefVector<MCPWalker>& walkers,
+                                         const RefVector<ParticleSet>& psets,
+                                         const RefVector<TrialWaveFunction>& wfns,
+                                         RandomGenerator& rng)
+{
+  // without a branching population e.g. in VMC there is nothing to walk forward on
+  const WalkerAncestry* ancestry = rank_estimator_->ancestry_;
+  if (ancestry == nullptr)
+    return;
+  // the walkers are between the branching of the previous step and the next one
+  const int generation = ancestry->get_num_generations();
+  for (MCPWalker& walker : walkers)
+  {
+    crowd_generations_.push_back(generation);
+    crowd_snapshot_.ids.push_back(walker.ID);
+    for (int index : property_indices_)
+      crowd_snapshot_.values.push_back(walker.Properties(index));
+  }
+}
+
+std::unique_ptr<OperatorEstBase> ForwardWalkingEstimator::spawnCrowdClone() const
+{
+  return std::make_unique<ForwardWalkingEstimator>(*this, data_locality_);
+}
+
+void ForwardWalkingEstimator::startBlock(int steps) {}
+
+void ForwardWalkingEstimator::collect(const RefVector<OperatorEstBase>& type_erased_operator_estimators)
+{
+  if (ancestry_ == nullptr)
+    return;
+
+  for (OperatorEstBase& crowd_oeb : type_erased_operator_estimators)
+  {
+    auto& crowd_fwe = dynamic_cast<ForwardWalkingEstimator&>(crowd_oeb);
+    auto& crowd_gen = crowd_fwe.crowd_generations_;
+    if (crowd_gen.empty())
+      continue;
+    if (snapshots_.empty())
+    {
+      first_generation_ = std::max(first_generation_, *std::min_element(crowd_gen.begin(), crowd_gen.end()));
+      for (int& next : next_generation_)
+        next = std::max(next, first_generation_);
+    }
+    for (int ir = 0; ir < crowd_gen.size(); ++ir)
+    {
+      const int index = crowd_gen[ir] - first_generation_;
+      if (index < 0)
+        continue;
+      if (index >= snapshots_.size())
+        snapshots_.resize(index + 1);
+      Snapshot& snapshot = snapshots_[index];
+      snapshot.ids.push_back(crowd_fwe.crowd_snapshot_.ids[ir]);
+      auto values = crowd_fwe.crowd_snapshot_.values.begin() + ir * num_observables_;
+      snapshot.values.insert(snapshot.values.end(), values, values + num_observables_);
+    }
+    crowd_gen.clear();
+    crowd_fwe.crowd_snapshot_.ids.clear();
+    crowd_fwe.crowd_snapshot_.values.clear();
+  }
+
+  const auto& steps          = input_.get_steps();
+  const int num_synchronized = ancestry_->get_num_synchronized();
+  const int end_generation   = first_generation_ + snapshots_.size();
+  for (int itau = 0; itau < num_steps_; ++itau)
+    for (int& generation = next_generation_[itau];
+         generation < end_generation && generation + steps[itau] < num_synchronized; ++generation)
+      evaluate(snapshots_[generation - first_generation_], generation, itau);
+
+  // the snapshots and branching events every distance is done with are not needed anymore
+  const int oldest = *std::min_element(next_generation_.begin(), next_generation_.end());
+  while (first_generation_ < oldest && !snapshots_.empty())
+  {
+    snapshots_.pop_front();
+    ++first_generation_;
+  }
+  ancestry_->discardBefore(oldest);
+}
+
+void ForwardWalkingEstimator::evaluate(const Snapshot& snapshot, int generation, int itau)
+{
+  const std::vector<int> descendants =
+      ancestry_->countDescendants(generation, generation + input_.get_steps()[itau], snapshot.ids);
+  for (int iw = 0; iw < snapshot.ids.size(); ++iw)
+  {
+    const Real weight = descendants[iw];
+    if (weight == 0)
+      continue;
+    data_[itau] += weight;
+    for (int iobs = 0; iobs < num_observables_; ++iobs)
+      data_[(iobs + 1) * num_steps_ + itau] += weight * snapshot.values[iw * num_observables_ + iobs];
+    if (itau == 0)
+      walkers_weight_ += weight;
+  }
+}
+
+void ForwardWalkingEstimator::normalize(Real invToWgt)
+{
+  for (int itau = 0; itau < num_steps_; ++itau)
+    if (const Real weight = data_[itau]; weight > 0)
+      for (int iobs = 0; iobs < num_observables_; ++iobs)
+        data_[(iobs + 1) * num_steps_ + itau] /= weight;
+}
+
+void ForwardWalkingEstimator::registerOperatorEstimator(hdf_archive& file)
+{
+  hdf_path hdf_name{my_name_};
+  std::vector<int> ng(1, num_steps_);
+  h5desc_.emplace_back(hdf_name / "weight");
+  auto& oh = h5desc_.back();
+  oh.set_dimensions(ng, 0);
+  std::vector<int> steps(input_.get_steps());
+  oh.addProperty(steps, "steps", file);
+  const auto& observables = input_.get_observables();
+  for (int iobs = 0; iobs < num_observables_; ++iobs)
+  {
+    h5desc_.emplace_back(hdf_name / observables[iobs]);
+    h5desc_.back().set_dimensions(ng, (iobs + 1) * num_steps_);
+  }
+}
+
+} // namespace qmcplusplus
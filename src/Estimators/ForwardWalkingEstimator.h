@@ -0,0 +1,99 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//
+// Some code refactored from: ForwardWalking.h
+//////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef QMCPLUSPLUS_FORWARDWALKINGESTIMATOR_H
+#define QMCPLUSPLUS_FORWARDWALKINGESTIMATOR_H
+
+#include <deque>
+#include "OperatorEstBase.h"
+#include "ForwardWalkingInput.h"
+
+namespace qmcplusplus
+{
+class WalkerAncestry;
+
+/** Pure estimates of walker properties by forward walking with the batched DMC driver.
+ *
+ *  Instead of carrying the history of the properties in every walker as the legacy ForwardWalking
+ *  Hamiltonian element does, the crowds store one snapshot of the properties per walker and generation
+ *  and the population records its branching events in a WalkerAncestry. Once the ancestry of generation
+ *  g + tau is known, the snapshot of generation g is weighted with the number of descendants each walker
+ *  has after tau more branchings:
+ *    <O>_tau = sum_i D_i(g, g + tau) O_i(g) / sum_i D_i(g, g + tau)
+ *  tau = 0 gives the mixed estimate. The weights are evaluated lazily when the block ends and the snapshots
+ *  are dropped once their largest tau has been evaluated.
+ *
+ *  data_ holds the total descendant weight for each tau followed by the weighted sum of each observable for each tau.
+ */
+class ForwardWalkingEstimator : public OperatorEstBase
+{
+public:
+  using Real = QMCTraits::RealType;
+
+  ForwardWalkingEstimator(ForwardWalkingInput&& input, const QMCHamiltonian& ham);
+  ForwardWalkingEstimator(const ForwardWalkingEstimator& other, DataLocality data_locality);
+
+  void accumulate(const RefVector<MCPWalker>& walkers,
+                  const RefVector<ParticleSet>& psets,
+                  const RefVector<TrialWaveFunction>& wfns,
+                  RandomGenerator& rng) override;
+
+  UPtr<OperatorEstBase> spawnCrowdClone() const override;
+  void startBlock(int steps) override;
+
+  void registerAncestry(WalkerAncestry& ancestry) override;
+
+  /// gather the snapshots of the crowds and evaluate the forward walking distances whose ancestry is known
+  void collect(const RefVector<OperatorEstBase>& type_erased_operator_estimators) override;
+
+  /// divide the weighted sums by the descendant weight of their distance, the weights are kept as is
+  void normalize(Real invToWgt) override;
+
+  void registerOperatorEstimator(hdf_archive& file) override;
+
+  int get_num_pending_generations() const { return snapshots_.size(); }
+
+private:
+  struct Snapshot
+  {
+    std::vector<long> ids;
+    /// observables of the walkers, walker major
+    std::vector<Real> values;
+  };
+
+  /// weight the snapshot of generation with the descendants tau generations later
+  void evaluate(const Snapshot& snapshot, int generation, int itau);
+
+  ForwardWalkingInput input_;
+  /// Properties index of each observable
+  std::vector<int> property_indices_;
+  const int num_observables_;
+  const int num_steps_;
+
+  /// only set on the rank estimator
+  WalkerAncestry* ancestry_ = nullptr;
+  ForwardWalkingEstimator* const rank_estimator_;
+
+  /// snapshots recorded by a crowd in this block
+  std::vector<int> crowd_generations_;
+  Snapshot crowd_snapshot_;
+
+  /// snapshots waiting for the ancestry of their forward walking distances, starting at first_generation_
+  std::deque<Snapshot> snapshots_;
+  int first_generation_ = 0;
+  /// next generation to evaluate for each forward walking distance
+  std::vector<int> next_generation_;
+};
+
+} // namespace qmcplusplus
+#endif
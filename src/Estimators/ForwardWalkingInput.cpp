@@ -0,0 +1,59 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+#include "EstimatorInput.h"
+#include "ForwardWalkingInput.h"
+
+#include <algorithm>
+
+namespace qmcplusplus
+{
+
+ForwardWalkingInput::ForwardWalkingInput(xmlNodePtr cur)
+{
+  // This results in checkParticularValidity being called on ForwardWalkingInputSection
+  input_section_.readXML(cur);
+  auto setIfInInput = LAMBDA_setIfInInput;
+  setIfInInput(name_, "name");
+  setIfInInput(type_, "type");
+  setIfInInput(observables_, "observables");
+  std::vector<std::string> steps;
+  setIfInInput(steps, "steps");
+  for (const std::string& step : steps)
+    steps_.push_back(std::stoi(step));
+  std::sort(steps_.begin(), steps_.end());
+  steps_.erase(std::unique(steps_.begin(), steps_.end()), steps_.end());
+}
+
+void ForwardWalkingInput::ForwardWalkingInputSection::checkParticularValidity()
+{
+  const std::string error_tag{"ForwardWalking input: "};
+  if (get<std::vector<std::string>>("observables").empty())
+    throw UniformCommunicateError(error_tag + "observables must name at least one observable");
+  auto steps = get<std::vector<std::string>>("steps");
+  if (steps.empty())
+    throw UniformCommunicateError(error_tag + "steps must list at least one forward walking distance");
+  for (const std::string& step : steps)
+  {
+    std::size_t end = 0;
+    int value       = -1;
+    try
+    {
+      value = std::stoi(step, &end);
+    }
+    catch (const std::exception&)
+    {}
+    if (end != step.size() || value < 0)
+      throw UniformCommunicateError(error_tag + "steps must be non negative integers, found " + step);
+  }
+}
+
+} // namespace qmcplusplus
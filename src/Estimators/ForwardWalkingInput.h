@@ -0,0 +1,71 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//
+// Some code refactored from: ForwardWalking.h
+//////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef QMCPLUSPLUS_FORWARDWALKINGINPUT_H
+#define QMCPLUSPLUS_FORWARDWALKINGINPUT_H
+
+#include "InputSection.h"
+
+namespace qmcplusplus
+{
+
+class ForwardWalkingEstimator;
+
+/** Native representation for the forward walking estimator input
+ */
+class ForwardWalkingInput
+{
+public:
+  using Consumer = ForwardWalkingEstimator;
+
+  class ForwardWalkingInputSection : public InputSection
+  {
+  public:
+    // clang-format: off
+    ForwardWalkingInputSection()
+    {
+      section_name  = "ForwardWalking";
+      attributes    = {"type", "name", "observables", "steps"};
+      strings       = {"type", "name"};
+      multi_strings = {"observables", "steps"};
+      required      = {"observables", "steps"};
+    }
+    // clang-format: on
+    void checkParticularValidity() override;
+  };
+
+  ForwardWalkingInput(xmlNodePtr cur);
+  /** default copy constructor
+   *  This is required due to FWI being part of a variant used as a vector element.
+   */
+  ForwardWalkingInput(const ForwardWalkingInput&) = default;
+
+private:
+  ForwardWalkingInputSection input_section_;
+
+  std::string name_{"forward_walking"};
+  std::string type_;
+  /// names of the walker properties, LocalEnergy, LocalPotential or the Hamiltonian observables
+  std::vector<std::string> observables_;
+  /// forward walking distances in DMC steps
+  std::vector<int> steps_;
+
+public:
+  const std::string& get_name() const { return name_; }
+  const std::string& get_type() const { return type_; }
+  const std::vector<std::string>& get_observables() const { return observables_; }
+  const std::vector<int>& get_steps() const { return steps_; }
+};
+
+} // namespace qmcplusplus
+#endif
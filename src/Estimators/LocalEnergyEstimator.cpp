@@ -34,6 +34,21 @@ LocalEnergyEstimator::LocalEnergyEstimator(LocalEnergyInput&& input, const QMCHa
   scalars_saved.resize(SizeOfHamiltonians + LE_MAX);
 }
 
+void LocalEnergyEstimator::accumulateProperties(const CrowdPropertyBlock& block)
+{
+  const size_t nw          = block.size();
+  const RealType* energies = block.getColumn(WP::LOCALENERGY);
+  const RealType* weights  = block.getWeights();
+  energy_sq_.resize(nw);
+  for (size_t iw = 0; iw < nw; ++iw)
+    energy_sq_[iw] = energies[iw] * energies[iw];
+  scalars[0](energies, weights, nw);
+  scalars[1](energy_sq_.data(), weights, nw);
+  scalars[2](block.getColumn(WP::LOCALPOTENTIAL), weights, nw);
+  for (int target = 3, source = FirstHamiltonian; target < scalars.size(); ++target, ++source)
+    scalars[target](block.getColumn(source), weights, nw);
+}
+
 LocalEnergyEstimator* LocalEnergyEstimator::clone() { return new LocalEnergyEstimator(*this); }
 
 void LocalEnergyEstimator::registerObservables(std::vector<ObservableHelper>& h5desc, hdf_archive& file)
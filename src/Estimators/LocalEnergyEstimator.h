@@ -43,6 +43,8 @@ class LocalEnergyEstimator : public ScalarEstimatorBase
   bool UseHDF5;
   const QMCHamiltonian& refH;
   const LocalEnergyInput input_;
+  /// scratch for the squared local energies of a crowd
+  std::vector<RealType> energy_sq_;
 
 public:
   /** constructor
@@ -98,6 +100,11 @@ public:
       accumulate(walker, 1.0);
   }
 
+  /** Accumulate the hamiltonian operator values of a crowd from the property columns
+   *  Same weighting as the walker based version, one reduction per column.
+   */
+  void accumulateProperties(const CrowdPropertyBlock& block) override;
+
   /// LocalEnergyEstimator is the main estimator for VMC and DMC
   bool isMainEstimator() const override { return true; }
   const std::string& getSubTypeStr() const override { return input_.get_type(); }
@@ -168,6 +168,8 @@ MomentumDistribution::MomentumDistribution(MomentumDistributionInput&& mdi,
   // allocate data storage
   size_t data_size = nofK.size();
   data_.resize(data_size, 0.0);
+  if (data_locality_ == DataLocality::rank)
+    makeSharedGrid();
 }
 
 MomentumDistribution::MomentumDistribution(const MomentumDistribution& md, DataLocality dl) : MomentumDistribution(md)
@@ -182,10 +184,9 @@ std::unique_ptr<OperatorEstBase> MomentumDistribution::spawnCrowdClone() const
 
   if (data_locality_ == DataLocality::rank)
   {
-    // This is just a stub until a memory saving optimization is deemed necessary
+    // the crowd clones add into the shared n(k) of the rank estimator
     spawn_data_locality = DataLocality::queue;
     data_size           = 0;
-    throw std::runtime_error("There is no memory savings implementation for MomentumDistribution");
   }
 
   auto spawn = std::make_unique<MomentumDistribution>(*this, spawn_data_locality);
@@ -294,15 +295,18 @@ void MomentumDistribution::accumulate(const RefVector<MCPWalker>& walkers,
     }
 
     // accumulate data
-    for (int ik = 0; ik < nofK.size(); ++ik)
-      data_[ik] += weight * nofK[ik] * norm_nofK;
+    if (shared_grid_)
+      shared_grid_->addDense(nofK.data(), weight * norm_nofK);
+    else
+      for (int ik = 0; ik < nofK.size(); ++ik)
+        data_[ik] += weight * nofK[ik] * norm_nofK;
   }
 }
 
 
 void MomentumDistribution::collect(const RefVector<OperatorEstBase>& type_erased_operator_estimators)
 {
-  if (data_locality_ == DataLocality::crowd)
+  if (data_locality_ == DataLocality::crowd || data_locality_ == DataLocality::rank)
   {
     OperatorEstBase::collect(type_erased_operator_estimators);
   }
@@ -126,7 +126,7 @@ OneBodyDensityMatrices::OneBodyDensityMatrices(OneBodyDensityMatricesInput&& obd
   samples_weights_.resize(samples_);
   psi_ratios_.resize(nparticles);
 
-  if (input_.get_evaluator() == Evaluator::MATRIX)
+  if (input_.get_evaluator() == Evaluator::MATRIX || input_.get_evaluator() == Evaluator::BATCHED)
   {
     Phi_MB_.resize(samples_, basis_size_);
     Phi_NB_.reserve(nspecies);
@@ -398,7 +398,10 @@ void OneBodyDensityMatrices::accumulate(const RefVector<MCPWalker>& walkers,
                                         const RefVector<TrialWaveFunction>& wfns,
                                         RandomGenerator& rng)
 {
-  implAccumulate(walkers, psets, wfns, rng);
+  if (input_.get_evaluator() == Evaluator::BATCHED)
+    implAccumulateBatched(walkers, psets, wfns, rng);
+  else
+    implAccumulate(walkers, psets, wfns, rng);
 }
 
 template<class RNG_GEN>
@@ -447,24 +450,66 @@ void OneBodyDensityMatrices::evaluateMatrix(ParticleSet& pset_target,
     }
   }
   // accumulate data for this walker
+  accumulateNumberMatrices();
+}
+
+template<class RNG_GEN>
+void OneBodyDensityMatrices::implAccumulateBatched(const RefVector<MCPWalker>& walkers,
+                                                   const RefVector<ParticleSet>& psets,
+                                                   const RefVector<TrialWaveFunction>& wfns,
+                                                   RNG_GEN& rng)
+{
+  if (walkers.empty())
+    return;
+  ScopedTimer local_timer(timers_.eval_timer);
+  for (int iw = 0; iw < walkers.size(); ++iw)
+    walkers_weight_ += walkers[iw].get().Weight;
+
+  ParticleSet& pset_leader = psets[0];
+  //perform warmup sampling the first time
+  warmupSampling(pset_leader, rng);
+  // one set of samples for the crowd, the walker weights are applied to the ratios
+  generateSamples(metric_, pset_leader, rng);
+  generateSampleBasis(Phi_MB_, pset_leader, wfns[0]);    // basis           : samples   x basis_size
+  mw_generateSampleRatios(walkers, psets, wfns, Psi_NM_); // conj(Psi ratio) : walkers*particles x samples
+  mw_generateParticleBasis(psets, Phi_NB_);               // conj(basis)     : walkers*particles x basis_size
+
+  // perform integration via matrix products, the products over the stacked rows sum the walkers
   {
-    ScopedTimer local_timer(timers_.accumulate_timer);
-    const int basis_size_sq = basis_size_ * basis_size_;
-    int ij                  = 0;
+    ScopedTimer local_timer(timers_.matrix_products_timer);
     for (int s = 0; s < species_.size(); ++s)
     {
-      //int ij=nindex; // for testing
-      const Matrix<Value>& NDM = N_BB_[s];
-      for (int n = 0; n < basis_size_sq; ++n)
-      {
-        Value val = NDM(n);
-        data_[ij] += real(val);
-        ij++;
+      Matrix<Value>& Psi_nm     = Psi_NM_[s];
+      Matrix<Value>& Phi_Psi_nb = Phi_Psi_NB_[s];
+      Matrix<Value>& Phi_nb     = Phi_NB_[s];
+      Phi_Psi_nb.resize(Psi_nm.rows(), basis_size_);
+      diag_product(Psi_nm, samples_weights_, Psi_nm);
+      product(Psi_nm, Phi_MB_, Phi_Psi_nb);      // ratio*basis : walkers*particles x basis_size
+      product_AtB(Phi_nb, Phi_Psi_nb, N_BB_[s]); // conj(basis)^T*ratio*basis : basis_size^2
+    }
+  }
+  // accumulate data for the crowd
+  accumulateNumberMatrices();
+}
+
+void OneBodyDensityMatrices::accumulateNumberMatrices()
+{
+  ScopedTimer local_timer(timers_.accumulate_timer);
+  const int basis_size_sq = basis_size_ * basis_size_;
+  int ij                  = 0;
+  for (int s = 0; s < species_.size(); ++s)
+  {
+    //int ij=nindex; // for testing
+    const Matrix<Value>& NDM = N_BB_[s];
+    for (int n = 0; n < basis_size_sq; ++n)
+    {
+      Value val = NDM(n);
+      data_[ij] += real(val);
+      ij++;
 #if defined(QMC_COMPLEX)
-        data_[ij] += imag(val);
-        ij++;
+      data_[ij] += imag(val);
+      ij++;
 #endif
-      }
     }
   }
 }
@@ -486,6 +531,31 @@ void OneBodyDensityMatrices::generateParticleBasis(ParticleSet& pset_target, std
   }
 }
 
+void OneBodyDensityMatrices::mw_generateParticleBasis(const RefVector<ParticleSet>& psets,
+                                                      std::vector<Matrix<Value>>& phi_nb)
+{
+  ScopedTimer local_timer(timers_.gen_particle_basis_timer);
+  const int nw = psets.size();
+  for (int s = 0; s < species_.size(); ++s)
+    phi_nb[s].resize(nw * species_sizes_[s], basis_size_);
+  for (int iw = 0; iw < nw; ++iw)
+  {
+    ParticleSet& pset_target = psets[iw];
+    int p                    = 0;
+    for (int s = 0; s < species_.size(); ++s)
+    {
+      Matrix<Value>& P_nb = phi_nb[s];
+      for (int n = 0; n < species_sizes_[s]; ++n, ++p)
+      {
+        updateBasis(pset_target.R[p], pset_target);
+        Value* P_row = P_nb[iw * species_sizes_[s] + n];
+        for (int b = 0; b < basis_size_; ++b)
+          P_row[b] = qmcplusplus::conj(basis_values_[b]);
+      }
+    }
+  }
+}
+
 void OneBodyDensityMatrices::generateSampleBasis(Matrix<Value>& Phi_mb,
                                                  ParticleSet& pset_target,
                                                  TrialWaveFunction& psi_target)
@@ -524,6 +594,48 @@ void OneBodyDensityMatrices::generateSampleRatios(ParticleSet& pset_target,
   }
 }
 
+void OneBodyDensityMatrices::mw_generateSampleRatios(const RefVector<MCPWalker>& walkers,
+                                                     const RefVector<ParticleSet>& psets,
+                                                     const RefVector<TrialWaveFunction>& wfns,
+                                                     std::vector<Matrix<Value>>& psi_nm)
+{
+  ScopedTimer local_timer(timers_.gen_sample_ratios_timer);
+  const int nw = walkers.size();
+  for (int s = 0; s < species_.size(); ++s)
+    psi_nm[s].resize(nw * species_sizes_[s], samples_);
+  mw_psi_ratios_.resize(nw);
+  RefVector<std::vector<Value>> ratios_list;
+  ratios_list.reserve(nw);
+  for (auto& ratios : mw_psi_ratios_)
+  {
+    ratios.resize(psi_ratios_.size());
+    ratios_list.push_back(ratios);
+  }
+  const RefVectorWithLeader<ParticleSet> p_list(psets[0], psets);
+  const RefVectorWithLeader<TrialWaveFunction> wf_list(wfns[0], wfns);
+
+  for (int m = 0; m < samples_; ++m)
+  {
+    // get N ratios for the current sample point for every walker
+    for (ParticleSet& pset_target : psets)
+      pset_target.makeVirtualMoves(rsamples_[m]);
+    TrialWaveFunction::mw_evaluateRatiosAlltoOne(wf_list, p_list, ratios_list);
+
+    // collect weighted ratios into per-species matrices
+    for (int iw = 0; iw < nw; ++iw)
+    {
+      const Real weight = walkers[iw].get().Weight;
+      int p             = 0;
+      for (int s = 0; s < species_.size(); ++s)
+      {
+        Matrix<Value>& P_nm = psi_nm[s];
+        for (int n = 0; n < species_sizes_[s]; ++n, ++p)
+          P_nm(iw * species_sizes_[s] + n, m) = weight * qmcplusplus::conj(mw_psi_ratios_[iw][p]);
+      }
+    }
+  }
+}
+
 inline void OneBodyDensityMatrices::updateBasis(const Position& r, ParticleSet& pset_target)
 {
   // This is ridiculous in the case of splines, still necessary for hybrid/LCAO
@@ -630,6 +742,10 @@ template void OneBodyDensityMatrices::implAccumulate<RandomGenerator>(const RefV
                                                                       const RefVector<ParticleSet>& psets,
                                                                       const RefVector<TrialWaveFunction>& wfns,
                                                                       RandomGenerator& rng);
+template void OneBodyDensityMatrices::implAccumulateBatched<RandomGenerator>(const RefVector<MCPWalker>& walkers,
+                                                                             const RefVector<ParticleSet>& psets,
+                                                                             const RefVector<TrialWaveFunction>& wfns,
+                                                                             RandomGenerator& rng);
 #if defined(USE_FAKE_RNG) || defined(QMC_RNG_BOOST)
 template void OneBodyDensityMatrices::generateSamples<StdRandom<double>>(Real weight,
                                                                          ParticleSet& pset_target,
@@ -643,6 +759,10 @@ template void OneBodyDensityMatrices::implAccumulate<StdRandom<double>>(const Re
                                                                         const RefVector<ParticleSet>& psets,
                                                                         const RefVector<TrialWaveFunction>& wfns,
                                                                         StdRandom<double>& rng);
+template void OneBodyDensityMatrices::implAccumulateBatched<StdRandom<double>>(const RefVector<MCPWalker>& walkers,
+                                                                               const RefVector<ParticleSet>& psets,
+                                                                               const RefVector<TrialWaveFunction>& wfns,
+                                                                               StdRandom<double>& rng);
 #endif
 
 } // namespace qmcplusplus
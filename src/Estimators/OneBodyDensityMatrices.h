@@ -101,6 +101,10 @@ private:
    *  size: particles
    */
   std::vector<Value> psi_ratios_;
+  /** per walker per particle ratios for the batched evaluator
+   *  size: walkers * particles
+   */
+  std::vector<std::vector<Value>> mw_psi_ratios_;
 
   /// row major per sample workspaces
   /** conj(basis_values) for each particle 
@@ -113,6 +117,9 @@ private:
    *  size: particles * samples
    *  vector is over species
    *  each matrix row: particle col: sample
+   *
+   *  For the batched evaluator Phi_NB_, Psi_NM_ and Phi_Psi_NB_ stack the
+   *  particles of all the walkers of the crowd, row: walker * particle.
    */
   std::vector<Matrix<Value>> Psi_NM_;
   std::vector<Matrix<Value>> Phi_Psi_NB_, N_BB_;
@@ -202,6 +209,19 @@ private:
   void report(const std::string& pad = "");
   template<class RNG_GEN>
   void evaluateMatrix(ParticleSet& pset_target, TrialWaveFunction& psi_target, const MCPWalker& walker, RNG_GEN& rng);
+  /** crowd level evaluation of the matrix implementation, Evaluator::BATCHED
+   *  The samples and their basis values are generated once and shared by all the walkers.
+   *  The ratios are evaluated with multi-walker calls and the walkers of each species are
+   *  stacked so a single pair of matrix products accumulates the whole crowd.
+   *  Given the same samples the result is the sum of evaluateMatrix over the walkers.
+   */
+  template<class RNG_GEN>
+  void implAccumulateBatched(const RefVector<MCPWalker>& walkers,
+                             const RefVector<ParticleSet>& psets,
+                             const RefVector<TrialWaveFunction>& wfns,
+                             RNG_GEN& rng);
+  /// add the N_BB_ number matrices to data_
+  void accumulateNumberMatrices();
   //  sample generation
   /** Dispatch method to difference methods of generating samples.
    *  dispatch determined by Integrator.
@@ -238,6 +258,13 @@ private:
   void generateSampleRatios(ParticleSet& pset_target,
                             TrialWaveFunction& psi_target,
                             std::vector<Matrix<Value>>& Psi_nm);
+  /** batched generateSampleRatios, psi_nm rows are walker * particle
+   *  the ratios of each walker are scaled by its weight times the sample weight.
+   */
+  void mw_generateSampleRatios(const RefVector<MCPWalker>& walkers,
+                               const RefVector<ParticleSet>& psets,
+                               const RefVector<TrialWaveFunction>& wfns,
+                               std::vector<Matrix<Value>>& psi_nm);
   /// produce a position difference vector from timestep
   template<class RNG_GEN>
   Position diffuse(const Real sqt, RNG_GEN& rng);
@@ -275,6 +302,8 @@ private:
    *    * updates basis_values_ to last rsample
    */
   void generateParticleBasis(ParticleSet& pset_target, std::vector<Matrix<Value>>& phi_nb);
+  /// batched generateParticleBasis, phi_nb rows are walker * particle
+  void mw_generateParticleBasis(const RefVector<ParticleSet>& psets, std::vector<Matrix<Value>>& phi_nb);
 
   //  basis set updates
   void updateBasis(const Position& r, ParticleSet& pset_target);
@@ -332,6 +361,10 @@ extern template void OneBodyDensityMatrices::implAccumulate<RandomGenerator>(con
                                                                              const RefVector<ParticleSet>& psets,
                                                                              const RefVector<TrialWaveFunction>& wfns,
                                                                              RandomGenerator& rng);
+extern template void OneBodyDensityMatrices::implAccumulateBatched<RandomGenerator>(const RefVector<MCPWalker>& walkers,
+                                                                                    const RefVector<ParticleSet>& psets,
+                                                                                    const RefVector<TrialWaveFunction>& wfns,
+                                                                                    RandomGenerator& rng);
 #if defined(USE_FAKE_RNG) || defined(QMC_RNG_BOOST)
 extern template void OneBodyDensityMatrices::generateSamples<StdRandom<double>>(Real weight,
                                                                                 ParticleSet& pset_target,
@@ -345,6 +378,10 @@ extern template void OneBodyDensityMatrices::implAccumulate<StdRandom<double>>(c
                                                                                const RefVector<ParticleSet>& psets,
                                                                                const RefVector<TrialWaveFunction>& wfns,
                                                                                StdRandom<double>& rng);
+extern template void OneBodyDensityMatrices::implAccumulateBatched<StdRandom<double>>(const RefVector<MCPWalker>& walkers,
+                                                                                      const RefVector<ParticleSet>& psets,
+                                                                                      const RefVector<TrialWaveFunction>& wfns,
+                                                                                      StdRandom<double>& rng);
 #endif
 
 } // namespace qmcplusplus
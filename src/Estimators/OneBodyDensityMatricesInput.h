@@ -42,7 +42,8 @@ public:
   enum class Evaluator
   {
     LOOP,
-    MATRIX
+    MATRIX,
+    BATCHED
   };
 
   /** mapping for enumerated options of OneBodyDensityMatrices
@@ -61,7 +62,8 @@ public:
                               {"integrator-uniform", Integrator::UNIFORM},
                               {"integrator-density", Integrator::DENSITY},
                               {"evaluator-loop", Evaluator::LOOP},
-                              {"evaluator-matrix", Evaluator::MATRIX}};
+                              {"evaluator-matrix", Evaluator::MATRIX},
+                              {"evaluator-batched", Evaluator::BATCHED}};
 
   class OneBodyDensityMatricesInputSection : public InputSection
   {
@@ -20,11 +20,28 @@ namespace qmcplusplus
 OperatorEstBase::OperatorEstBase(DataLocality dl) : data_locality_(dl), walkers_weight_(0) {}
 
 OperatorEstBase::OperatorEstBase(const OperatorEstBase& oth)
-    : data_locality_(oth.data_locality_), my_name_(oth.my_name_), walkers_weight_(0)
-{}
+    : data_locality_(oth.data_locality_), my_name_(oth.my_name_), walkers_weight_(0), shared_grid_(oth.shared_grid_)
+{
+  if (shared_grid_)
+    grid_deposits_ = std::make_unique<GridDepositBuffer>(shared_grid_);
+}
+
+void OperatorEstBase::makeSharedGrid() { shared_grid_ = std::make_shared<SharedGridAccumulator>(data_); }
 
 void OperatorEstBase::collect(const RefVector<OperatorEstBase>& type_erased_operator_estimators)
 {
+  if (shared_grid_)
+  {
+    for (OperatorEstBase& crowd_oeb : type_erased_operator_estimators)
+    {
+      if (crowd_oeb.grid_deposits_)
+        crowd_oeb.grid_deposits_->flush();
+      walkers_weight_ += crowd_oeb.walkers_weight_;
+      crowd_oeb.zero();
+    }
+    return;
+  }
+
   for (OperatorEstBase& crowd_oeb : type_erased_operator_estimators)
   {
     std::transform(data_.begin(), data_.end(), crowd_oeb.get_data().begin(), data_.begin(), std::plus<>{});
@@ -23,11 +23,13 @@
 #include "QMCWaveFunctions/OrbitalSetTraits.h"
 #include "type_traits/DataLocality.h"
 #include "hdf/hdf_archive.h"
+#include "SharedGridAccumulator.h"
 #include <bitset>
 
 namespace qmcplusplus
 {
 class TrialWaveFunction;
+class WalkerAncestry;
 namespace testing
 {
 class OEBAccessor;
@@ -53,6 +55,7 @@ public:
    *  Data is likely to be quite large and since the OperatorEstBase design is that the children 
    *  reduce to the parent it is infact undesirable for them to copy the data the parent has.
    *  Initialization of Data (i.e. call to resize) if any is the responsibility of the derived class.
+   *  If oth has a shared grid the copy deposits into it instead of having data of its own.
    */
   OperatorEstBase(const OperatorEstBase& oth);
   ///virtual destructor
@@ -83,6 +86,7 @@ public:
    *  that the crowd operator estimators accumulation data is not being written to.
    *
    *  There could be concurrent operations inside the scope of the collect call.
+   *  With a shared grid only the pending deposits of the crowds are flushed.
    */
   virtual void collect(const RefVector<OperatorEstBase>& oebs);
 
@@ -130,6 +134,13 @@ public:
 
   bool isListenerRequired() { return requires_listener_; }
 
+  /** Register the branching record of the population with the rank scope estimator.
+   *  Only forward walking estimators need it so the default implementation is no op.
+   */
+  virtual void registerAncestry(WalkerAncestry& ancestry) {}
+
+  bool isAncestryRequired() const { return requires_ancestry_; }
+
   DataLocality get_data_locality() const { return data_locality_; }
 
 protected:
@@ -158,6 +169,22 @@ protected:
 
   bool requires_listener_ = false;
 
+  bool requires_ancestry_ = false;
+
+  /** make data_ a grid shared with the crowd clones spawned afterwards.
+   *  Call once data_ has its final size, the crowd clones then deposit
+   *  into data_ through their GridDepositBuffer and keep no grid of their own.
+   */
+  void makeSharedGrid();
+
+  /// add weight at index of the shared grid, only for the crowd clones of an estimator with a shared grid
+  void depositToSharedGrid(size_t index, QMCT::RealType weight) { grid_deposits_->deposit(index, weight); }
+
+  /// the grid shared by a DataLocality::rank estimator and its crowd clones
+  std::shared_ptr<SharedGridAccumulator> shared_grid_;
+  /// pending deposits to shared_grid_ of a crowd clone
+  std::unique_ptr<GridDepositBuffer> grid_deposits_;
+
   friend testing::OEBAccessor;
 };
 } // namespace qmcplusplus
@@ -0,0 +1,210 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//
+// Some code refactored from: PairCorrEstimator.cpp
+//////////////////////////////////////////////////////////////////////////////////////
+
+#include "PairCorrelationEstimator.h"
+
+#include <algorithm>
+#include <cmath>
+#include "Particle/DistanceTable.h"
+#include "Message/UniformCommunicateError.h"
+
+namespace qmcplusplus
+{
+
+PairCorrelationEstimator::PairCorrelationEstimator(PairCorrelationInput&& input, ParticleSet& pset, DataLocality dl)
+    : OperatorEstBase(dl),
+      input_(std::move(input)),
+      d_aa_id_(pset.addTable(pset, DTModes::NEED_FULL_TABLE_ON_HOST_AFTER_DONEPBYP))
+{
+  my_name_     = input_.get_name();
+  num_species_ = pset.groups();
+
+  // use the simulation cell radius if any direction is periodic
+  rmax_ = input_.get_rmax();
+  if (!input_.get_rmax_defined() && pset.getLattice().SuperCellEnum)
+    rmax_ = pset.getLattice().WignerSeitzRadius;
+  num_bins_  = input_.get_num_bin() > 0 ? input_.get_num_bin() : static_cast<int>(std::ceil(rmax_ / input_.get_dr()));
+  delta_     = rmax_ / static_cast<Real>(num_bins_);
+  delta_inv_ = 1.0 / delta_;
+
+  for (int i = 0; i < num_species_; ++i)
+    for (int j = i; j < num_species_; ++j)
+      channel_names_.push_back(pset.getName() + "_" + std::to_string(i) + "_" + std::to_string(j));
+
+  // source-target tables
+  for (const std::string& source : input_.get_sources())
+  {
+    int table_id = -1;
+    for (int k = 0; k < pset.getNumDistTables(); ++k)
+      if (source != pset.getName() && pset.getDistTable(k).get_origin().getName() == source)
+        table_id = k;
+    if (table_id < 0)
+      throw UniformCommunicateError("PairCorrelationEstimator source " + source +
+                                    " is not a source of the distance tables of " + pset.getName());
+    const ParticleSet& source_pset = pset.getDistTable(table_id).get_origin();
+    // request the full table on the host after the p-by-p moves
+    d_ab_ids_.push_back(pset.addTable(source_pset, DTModes::NEED_FULL_TABLE_ON_HOST_AFTER_DONEPBYP));
+    d_ab_offsets_.push_back(channel_names_.size());
+    const SpeciesSet& species = source_pset.getSpeciesSet();
+    for (int i = 0; i < species.size(); ++i)
+      channel_names_.push_back(pset.getDistTable(table_id).getName() + "_" + species.speciesName[i]);
+  }
+
+  setNormFactor(pset);
+  data_.resize(channel_names_.size() * num_bins_, 0.0);
+}
+
+PairCorrelationEstimator::PairCorrelationEstimator(const PairCorrelationEstimator& pce, DataLocality dl)
+    : PairCorrelationEstimator(pce)
+{
+  data_locality_ = dl;
+}
+
+std::unique_ptr<OperatorEstBase> PairCorrelationEstimator::spawnCrowdClone() const
+{
+  auto spawn = std::make_unique<PairCorrelationEstimator>(*this, data_locality_);
+  spawn->get_data().resize(data_.size(), 0.0);
+  return spawn;
+}
+
+int PairCorrelationEstimator::genPairId(const int ig, const int jg, const int ns)
+{
+  if (jg < ig)
+    return ns * (ns - 1) / 2 - (ns - jg) * (ns - jg - 1) / 2 + ig;
+  else
+    return ns * (ns - 1) / 2 - (ns - ig) * (ns - ig - 1) / 2 + jg;
+}
+
+void PairCorrelationEstimator::setNormFactor(const ParticleSet& pset)
+{
+  // V / (npairs * shell volume), the number of pairs expected in the shell for uniformly distributed particles
+  const Real volume = pset.getLattice().SuperCellEnum ? pset.getLattice().Volume : 1.0;
+  std::vector<Real> npairs(channel_names_.size(), 0.0);
+  for (int m = 0; m < num_species_; ++m)
+    for (int n = m; n < num_species_; ++n)
+    {
+      const Real nm = pset.last(m) - pset.first(m);
+      const Real nn = pset.last(n) - pset.first(n);
+      npairs[genPairId(m, n, num_species_)] = m == n ? nn * (nn - 1) / 2 : nn * nm;
+    }
+  for (int k = 0; k < d_ab_ids_.size(); ++k)
+  {
+    const ParticleSet& source_pset = pset.getDistTable(d_ab_ids_[k]).get_origin();
+    for (int s = 0; s < source_pset.getSpeciesSet().size(); ++s)
+      npairs[d_ab_offsets_[k] + s] = static_cast<Real>(pset.getTotalNum()) *
+          std::count(source_pset.GroupID.begin(), source_pset.GroupID.end(), s);
+  }
+
+  const Real ftpi = 4. / 3 * M_PI;
+  norm_factor_.resize(channel_names_.size(), num_bins_);
+  for (int i = 0; i < num_bins_; ++i)
+  {
+    const Real r          = static_cast<Real>(i) * delta_;
+    const Real bin_volume = ftpi * (std::pow(r + delta_, 3) - std::pow(r, 3));
+    for (int c = 0; c < channel_names_.size(); ++c)
+      norm_factor_(c, i) = npairs[c] > 0 ? volume / (npairs[c] * bin_volume) : 0.0;
+  }
+}
+
+void PairCorrelationEstimator::binRow(const Real* dist, const int n, const int* channels, const int channel)
+{
+  bin_index_.resize(n);
+  int* restrict bins      = bin_index_.data();
+  const Real* restrict rs = dist;
+  const Real rmax         = rmax_;
+  const Real delta_inv    = delta_inv_;
+  const int nb            = num_bins_;
+  if (channels)
+  {
+    const int* restrict cs = channels;
+#pragma omp simd
+    for (int j = 0; j < n; ++j)
+      bins[j] = rs[j] < rmax ? cs[j] * nb + std::min(static_cast<int>(rs[j] * delta_inv), nb - 1) : -1;
+  }
+  else
+  {
+#pragma omp simd
+    for (int j = 0; j < n; ++j)
+      bins[j] = rs[j] < rmax ? channel * nb + std::min(static_cast<int>(rs[j] * delta_inv), nb - 1) : -1;
+  }
+  Real* counts = counts_.data();
+  for (int j = 0; j < n; ++j)
+    if (bins[j] >= 0)
+      counts[bins[j]] += 1;
+}
+
+void PairCorrelationEstimator::accumulate(const RefVector<MCPWalker>& walkers,
+                                          const RefVector<ParticleSet>& psets,
+                                          const RefVector<TrialWaveFunction>& wfns,
+                                          RandomGenerator& rng)
+{
+  counts_.resize(channel_names_.size(), num_bins_);
+  for (int iw = 0; iw < walkers.size(); ++iw)
+  {
+    const ParticleSet& pset = psets[iw];
+    const Real w            = walkers[iw].get().Weight;
+    walkers_weight_ += w;
+    std::fill(counts_.begin(), counts_.end(), 0.0);
+
+    // the lower triangle of the AA table, the rows are split by the species of the columns
+    const auto& dii = pset.getDistTableAA(d_aa_id_);
+    for (int iat = 1; iat < dii.centers(); ++iat)
+    {
+      const Real* dist = dii.getDistRow(iat).data();
+      const int ig     = pset.GroupID[iat];
+      for (int jg = 0; jg < num_species_; ++jg)
+      {
+        const int first = pset.first(jg);
+        const int last  = std::min(pset.last(jg), iat);
+        if (last > first)
+          binRow(dist + first, last - first, nullptr, genPairId(ig, jg, num_species_));
+      }
+    }
+
+    for (int k = 0; k < d_ab_ids_.size(); ++k)
+    {
+      const auto& dab = pset.getDistTableAB(d_ab_ids_[k]);
+      const int nc    = dab.centers();
+      const auto& gid = dab.get_origin().GroupID;
+      center_channels_.resize(nc);
+      for (int j = 0; j < nc; ++j)
+        center_channels_[j] = d_ab_offsets_[k] + gid[j];
+      for (int iat = 0; iat < dab.targets(); ++iat)
+        binRow(dab.getDistRow(iat).data(), nc, center_channels_.data(), 0);
+    }
+
+    const int n                 = counts_.size();
+    const Real* restrict counts = counts_.data();
+    const Real* restrict norm   = norm_factor_.data();
+    Real* restrict gofr         = data_.data();
+#pragma omp simd
+    for (int i = 0; i < n; ++i)
+      gofr[i] += w * counts[i] * norm[i];
+  }
+}
+
+void PairCorrelationEstimator::registerOperatorEstimator(hdf_archive& file)
+{
+  hdf_path hdf_name{my_name_};
+  std::vector<int> ng(1, num_bins_);
+  for (int c = 0; c < channel_names_.size(); ++c)
+  {
+    h5desc_.emplace_back(hdf_name / channel_names_[c]);
+    auto& oh = h5desc_.back();
+    oh.set_dimensions(ng, c * num_bins_);
+    oh.addProperty(delta_, "delta", file);
+    oh.addProperty(rmax_, "cutoff", file);
+  }
+}
+
+} // namespace qmcplusplus
@@ -0,0 +1,108 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//
+// Some code refactored from: PairCorrEstimator.cpp
+//////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef QMCPLUSPLUS_PAIRCORRELATIONESTIMATOR_H
+#define QMCPLUSPLUS_PAIRCORRELATIONESTIMATOR_H
+
+#include "OperatorEstBase.h"
+#include "PairCorrelationInput.h"
+
+namespace qmcplusplus
+{
+/** Pair correlation function g(r) estimator for the batched drivers.
+ *
+ *  Replaces the legacy PairCorrEstimator. The distances are read from the distance tables of the
+ *  walker particle sets, which already hold them after the p-by-p moves. For each table row
+ *  the histogram bins are computed in a SIMD loop and only the increments of the per walker counts
+ *  are scalar, the weighted and normalized counts are then added to the crowd data in one dense pass.
+ *
+ *  data_ layout, num_bins values for each channel: the target species pairs (0,0), (0,1) ... (1,1) ...
+ *  then every species of each source particle set.
+ */
+class PairCorrelationEstimator : public OperatorEstBase
+{
+public:
+  using Real = QMCTraits::RealType;
+
+  /** @param input   pair correlation input
+   *  @param pset    target particle set, the distance tables needed are requested from it
+   *                 so this must be called before the walker particle sets are cloned from it.
+   */
+  PairCorrelationEstimator(PairCorrelationInput&& input, ParticleSet& pset, DataLocality dl = DataLocality::crowd);
+
+  /** Constructor used when spawning crowd clones
+   *  needs to be public so std::make_unique can call it.
+   */
+  PairCorrelationEstimator(const PairCorrelationEstimator& pce, DataLocality dl);
+
+  void accumulate(const RefVector<MCPWalker>& walkers,
+                  const RefVector<ParticleSet>& psets,
+                  const RefVector<TrialWaveFunction>& wfns,
+                  RandomGenerator& rng) override;
+
+  std::unique_ptr<OperatorEstBase> spawnCrowdClone() const override;
+
+  void startBlock(int steps) override {}
+
+  void registerOperatorEstimator(hdf_archive& file) override;
+
+  int get_num_bins() const { return num_bins_; }
+  Real get_delta() const { return delta_; }
+  Real get_rmax() const { return rmax_; }
+  const std::vector<std::string>& get_channel_names() const { return channel_names_; }
+
+  /// channel of the species pair (ig, jg) of the target, symmetric in ig and jg
+  static int genPairId(int ig, int jg, int num_species);
+
+private:
+  PairCorrelationEstimator(const PairCorrelationEstimator& pce) = default;
+
+  /// V / (number of pairs * shell volume) normalization of the bins of each channel
+  void setNormFactor(const ParticleSet& pset);
+
+  /** bin the distances of one table row into counts
+   *  @param dist       distances of the row
+   *  @param n          number of distances
+   *  @param channels   channel of each distance, nullptr if they all fall in channel
+   *  @param channel    channel of all the distances if channels is nullptr
+   */
+  void binRow(const Real* dist, int n, const int* channels, int channel);
+
+  PairCorrelationInput input_;
+  Real rmax_;
+  Real delta_;
+  Real delta_inv_;
+  int num_bins_;
+  int num_species_;
+  /// distance table of the target with itself
+  int d_aa_id_;
+  /// distance tables of the sources and the channel of their first species
+  std::vector<int> d_ab_ids_;
+  std::vector<int> d_ab_offsets_;
+  std::vector<std::string> channel_names_;
+  /// normalization of the bins of each channel, row: channel
+  Matrix<Real> norm_factor_;
+
+  /** @ingroup per walker workspaces
+   *  @{ */
+  /// histogram of the current walker, row: channel
+  Matrix<Real> counts_;
+  /// data_ index of each distance of a row, -1 outside rmax
+  aligned_vector<int> bin_index_;
+  /// channel of each center of an AB table
+  aligned_vector<int> center_channels_;
+  /** @} */
+};
+
+} // namespace qmcplusplus
+#endif
@@ -0,0 +1,44 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+#include "EstimatorInput.h"
+#include "PairCorrelationInput.h"
+
+namespace qmcplusplus
+{
+
+PairCorrelationInput::PairCorrelationInput(xmlNodePtr cur)
+{
+  // This results in checkParticularValidity being called on PairCorrelationInputSection
+  input_section_.readXML(cur);
+  auto setIfInInput = LAMBDA_setIfInInput;
+  setIfInInput(name_, "name");
+  setIfInInput(type_, "type");
+  rmax_defined_ = setIfInInput(rmax_, "rmax");
+  setIfInInput(dr_, "dr");
+  setIfInInput(num_bin_, "num_bin");
+  // source and sources are synonyms as in the legacy input
+  setIfInInput(sources_, "source");
+  setIfInInput(sources_, "sources");
+}
+
+void PairCorrelationInput::PairCorrelationInputSection::checkParticularValidity()
+{
+  const std::string error_tag{"PairCorrelation input: "};
+  if (has("rmax") && get<Real>("rmax") <= 0.0)
+    throw UniformCommunicateError(error_tag + "rmax must be positive");
+  if (has("dr") && get<Real>("dr") <= 0.0)
+    throw UniformCommunicateError(error_tag + "dr must be positive");
+  if (has("num_bin") && get<int>("num_bin") < 1)
+    throw UniformCommunicateError(error_tag + "num_bin must be at least one");
+}
+
+} // namespace qmcplusplus
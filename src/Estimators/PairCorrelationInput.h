@@ -0,0 +1,81 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//
+// Some code refactored from: PairCorrEstimator.h
+//////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef QMCPLUSPLUS_PAIRCORRELATIONINPUT_H
+#define QMCPLUSPLUS_PAIRCORRELATIONINPUT_H
+
+#include "InputSection.h"
+
+namespace qmcplusplus
+{
+
+class PairCorrelationEstimator;
+
+/** Native representation for the pair correlation function g(r) estimator input
+ */
+class PairCorrelationInput
+{
+public:
+  using Consumer = PairCorrelationEstimator;
+  using Real     = QMCTraits::RealType;
+
+  class PairCorrelationInputSection : public InputSection
+  {
+  public:
+    // clang-format: off
+    PairCorrelationInputSection()
+    {
+      section_name  = "PairCorrelation";
+      attributes    = {"type", "name", "rmax", "dr", "num_bin", "source", "sources"};
+      strings       = {"type", "name"};
+      multi_strings = {"source", "sources"};
+      integers      = {"num_bin"};
+      reals         = {"rmax", "dr"};
+    }
+    // clang-format: on
+    void checkParticularValidity() override;
+  };
+
+  PairCorrelationInput(xmlNodePtr cur);
+  /** default copy constructor
+   *  This is required due to PCI being part of a variant used as a vector element.
+   */
+  PairCorrelationInput(const PairCorrelationInput&) = default;
+
+private:
+  PairCorrelationInputSection input_section_;
+
+  std::string name_{"gofr"};
+  std::string type_;
+  /// cutoff of g(r), if not defined the Wigner-Seitz radius for periodic cells or 10 otherwise
+  Real rmax_ = 10.0;
+  bool rmax_defined_ = false;
+  /// bin width, ignored if num_bin is defined
+  Real dr_ = 0.5;
+  /// number of bins, 0 to derive it from rmax and dr
+  int num_bin_ = 0;
+  /// names of the particle sets g(r) between the target and them is also accumulated
+  std::vector<std::string> sources_;
+
+public:
+  const std::string& get_name() const { return name_; }
+  const std::string& get_type() const { return type_; }
+  Real get_rmax() const { return rmax_; }
+  bool get_rmax_defined() const { return rmax_defined_; }
+  Real get_dr() const { return dr_; }
+  int get_num_bin() const { return num_bin_; }
+  const std::vector<std::string>& get_sources() const { return sources_; }
+};
+
+} // namespace qmcplusplus
+#endif
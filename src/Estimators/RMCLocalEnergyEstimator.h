@@ -34,7 +34,7 @@ class RMCLocalEnergyEstimator : public ScalarEstimatorBase
   int NObs;
   int RMCSpecificTerms = 8;
 
-  // This is just to allow compilation batched version does not support RMC at this time.
+  // only set by the batched estimator manager, the legacy one constructs from the hamiltonian.
   const RMCLocalEnergyInput input_;
 public:
   /** constructor
@@ -55,9 +55,33 @@ public:
    */
   inline void accumulate(const Walker_t& awalker, RealType wgt) {}
 
-  inline void accumulate(const RefVector<MCPWalker>& walkers) override
+  /** the walkers of the batched RMC driver are only the heads of the reptiles,
+   *  the driver accumulates each reptile with accumulateBeads instead.
+   */
+  inline void accumulate(const RefVector<MCPWalker>& walkers) override {}
+
+  /** accumulation of one reptile of the batched RMC driver
+   *
+   * Every reptile has the weight of one walker. The mixed estimators average the head and the tail,
+   * the pure ones are taken at the center bead.
+   */
+  inline void accumulateBeads(const RealType* head, const RealType* tail, const RealType* center) override
   {
-    throw std::runtime_error("RMC not supported by Unified Driver interfaces");
+    const RealType e_head = head[WP::LOCALENERGY];
+    const RealType e_tail = tail[WP::LOCALENERGY];
+    scalars[0](0.5 * (e_head + e_tail));
+    scalars[1](0.5 * (e_head * e_head + e_tail * e_tail));
+    scalars[2](center[WP::LOCALENERGY]);
+    scalars[3](center[WP::LOCALENERGY] * center[WP::LOCALENERGY]);
+    scalars[4](e_head * e_tail);
+    scalars[5](0.5 * (head[WP::LOCALPOTENTIAL] + tail[WP::LOCALPOTENTIAL]));
+    scalars[6](center[WP::LOCALPOTENTIAL]);
+    for (int target = RMCSpecificTerms, source = FirstHamiltonian; source < FirstHamiltonian + SizeOfHamiltonians;
+         ++target, ++source)
+      scalars[target](0.5 * (head[source] + tail[source]));
+    for (int target = RMCSpecificTerms + SizeOfHamiltonians, source = FirstHamiltonian;
+         source < FirstHamiltonian + SizeOfHamiltonians; ++target, ++source)
+      scalars[target](center[source]);
   }
   inline void accumulate(const MCWalkerConfiguration& W,
                          WalkerIterator first,
@@ -0,0 +1,91 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+#include "ReblockingAccumulator.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace qmcplusplus
+{
+
+void ReblockingAccumulator::operator()(Real x)
+{
+  Real value = x;
+  for (int level = 0;; ++level)
+  {
+    if (level == levels_.size())
+    {
+      levels_.emplace_back();
+      pending_.emplace_back();
+    }
+    levels_[level](value);
+    if (!pending_[level])
+    {
+      pending_[level] = value;
+      return;
+    }
+    // a block of the next level is complete
+    value = 0.5 * (*pending_[level] + value);
+    pending_[level].reset();
+  }
+}
+
+ReblockingAccumulator::Real ReblockingAccumulator::getError(int level) const
+{
+  const Real n = levels_[level].count();
+  if (n < 2)
+    return 0.0;
+  // the variance of accumulator_set is the biased one
+  return std::sqrt(std::max(levels_[level].variance(), Real(0)) / (n - 1));
+}
+
+ReblockingAccumulator::Result ReblockingAccumulator::analyze() const
+{
+  Result result;
+  const Real num_samples = get_num_samples();
+  if (num_samples < 2)
+    return result;
+  result.mean              = levels_[0].mean();
+  result.effective_samples = num_samples;
+
+  // without variance there is nothing to reblock, no error bar can be trusted
+  const Real error_0 = getError(0);
+  if (error_0 == 0.0)
+    return result;
+
+  result.level = 0;
+  for (int level = 0; level < levels_.size() && levels_[level].count() >= min_plateau_blocks; ++level)
+  {
+    result.level      = level;
+    const Real ratio  = getError(level) / error_0;
+    const Real b_size = std::pow(2.0, level);
+    if (b_size * b_size * b_size > 2 * num_samples * ratio * ratio * ratio * ratio)
+    {
+      result.plateau = true;
+      break;
+    }
+  }
+
+  result.error                = getError(result.level);
+  const Real ratio            = result.error / error_0;
+  result.autocorrelation_time = ratio * ratio;
+  result.effective_samples    = num_samples / result.autocorrelation_time;
+  return result;
+}
+
+void ReblockingAccumulator::clear()
+{
+  levels_.clear();
+  pending_.clear();
+}
+
+} // namespace qmcplusplus
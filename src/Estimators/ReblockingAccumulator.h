@@ -0,0 +1,79 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef QMCPLUSPLUS_REBLOCKINGACCUMULATOR_H
+#define QMCPLUSPLUS_REBLOCKINGACCUMULATOR_H
+
+#include <optional>
+#include <vector>
+#include "Configuration.h"
+#include "Estimators/accumulators.h"
+
+namespace qmcplusplus
+{
+/** Online hierarchical reblocking of a serially correlated scalar, Flyvbjerg and Petersen J. Chem. Phys. 91, 461 (1989)
+ *
+ *  Level 0 accumulates the samples, level l the averages of consecutive pairs of level l-1 i.e. blocks of 2^l samples.
+ *  Only an accumulator_set and one unpaired value are kept per level so the memory is log2 of the number of samples
+ *  and nothing has to be stored to get the error bar at any time of the run.
+ *
+ *  The reblocking level is chosen with the criterion of Lee, Needs and Drummond, PRB 83, 115105 (2011):
+ *  the smallest block size B = 2^l with B^3 > 2 N (error_l / error_0)^4.
+ *  A level is only accepted with at least min_plateau_blocks blocks, the error of fewer blocks is too noisy to trust.
+ */
+class ReblockingAccumulator
+{
+public:
+  using Real = QMCTraits::FullPrecRealType;
+
+  /// fewest blocks at the chosen level for a plateau, so there is no plateau with fewer samples either
+  static constexpr int min_plateau_blocks = 16;
+
+  struct Result
+  {
+    Real mean = 0.0;
+    /// standard error of the mean at the chosen level
+    Real error = 0.0;
+    /// statistical inefficiency (error / naive error)^2, what qmca reports as the autocorrelation time
+    Real autocorrelation_time = 1.0;
+    /// number of samples over the autocorrelation time
+    Real effective_samples = 0.0;
+    /// reblocking level of the error, the highest one with min_plateau_blocks blocks if there is no plateau
+    int level = 0;
+    /** true if the reblocking criterion is met with enough blocks, i.e. the error can be trusted.
+     *  Samples without any variance never have a plateau.
+     */
+    bool plateau = false;
+  };
+
+  /// add a sample
+  void operator()(Real x);
+
+  /// analyze the samples so far
+  Result analyze() const;
+
+  /// standard error of the mean estimated from the blocks at level
+  Real getError(int level) const;
+
+  void clear();
+
+  std::size_t get_num_samples() const { return levels_.empty() ? 0 : static_cast<std::size_t>(levels_[0].count()); }
+  int get_num_levels() const { return levels_.size(); }
+  const accumulator_set<Real>& get_level(int level) const { return levels_[level]; }
+
+private:
+  std::vector<accumulator_set<Real>> levels_;
+  /// value waiting for its partner at each level
+  std::vector<std::optional<Real>> pending_;
+};
+
+} // namespace qmcplusplus
+#endif
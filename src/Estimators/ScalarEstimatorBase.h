@@ -19,6 +19,7 @@
 #include "Particle/MCWalkerConfiguration.h"
 #include "OhmmsData/RecordProperty.h"
 #include "Estimators/accumulators.h"
+#include "Estimators/CrowdPropertyBlock.h"
 #include "Particle/Walker.h"
 #if !defined(REMOVE_TRACEMANAGER)
 #include "Estimators/TraceManager.h"
@@ -150,6 +151,22 @@ struct ScalarEstimatorBase
    */
   virtual void accumulate(const RefVector<MCPWalker>&) = 0;
 
+  /** accumulate observables from the SoA property block of a crowd
+   * @param block walker properties of the crowd gathered in columns
+   *
+   * The default falls back to the walker based accumulate.
+   */
+  virtual void accumulateProperties(const CrowdPropertyBlock& block) { accumulate(block.getWalkers()); }
+
+  /** accumulate the beads of one reptile of the batched RMC driver
+   * @param head properties of the head bead, the walker
+   * @param tail properties of the tail bead
+   * @param center properties of the center bead
+   *
+   * Only the RMC estimators use the beads besides the head, the default ignores them.
+   */
+  virtual void accumulateBeads(const RealType* head, const RealType* tail, const RealType* center) {}
+
   /** add the content of the scalar estimator to the record
    * @param record scalar data list
    *
@@ -0,0 +1,66 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "SharedGridAccumulator.h"
+#include <algorithm>
+#include <cassert>
+
+namespace qmcplusplus
+{
+SharedGridAccumulator::SharedGridAccumulator(std::vector<Real>& grid, size_t shard_lines)
+    : grid_(grid),
+      shard_size_(std::max<size_t>(shard_lines, 1) * cache_line_reals),
+      shard_locks_((grid.size() + shard_size_ - 1) / shard_size_)
+{}
+
+void SharedGridAccumulator::addSorted(const std::vector<Deposit>& deposits)
+{
+  auto it = deposits.begin();
+  while (it != deposits.end())
+  {
+    assert(it->index < grid_.size());
+    const size_t shard     = it->index / shard_size_;
+    const size_t shard_end = (shard + 1) * shard_size_;
+    std::lock_guard<std::mutex> lock(shard_locks_[shard]);
+    for (; it != deposits.end() && it->index < shard_end; ++it)
+      grid_[it->index] += it->weight;
+  }
+}
+
+void SharedGridAccumulator::addDense(const Real* values, Real scale)
+{
+  for (size_t shard = 0; shard < shard_locks_.size(); ++shard)
+  {
+    const size_t first = shard * shard_size_;
+    const size_t last  = std::min(first + shard_size_, grid_.size());
+    std::lock_guard<std::mutex> lock(shard_locks_[shard]);
+    for (size_t i = first; i < last; ++i)
+      grid_[i] += scale * values[i];
+  }
+}
+
+GridDepositBuffer::GridDepositBuffer(const std::shared_ptr<SharedGridAccumulator>& grid, size_t capacity)
+    : grid_(grid), capacity_(capacity)
+{
+  deposits_.reserve(capacity_);
+}
+
+void GridDepositBuffer::flush()
+{
+  if (deposits_.empty())
+    return;
+  std::sort(deposits_.begin(), deposits_.end(), [](const auto& a, const auto& b) { return a.index < b.index; });
+  grid_->addSorted(deposits_);
+  deposits_.clear();
+}
+
+} // namespace qmcplusplus
@@ -0,0 +1,99 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef QMCPLUSPLUS_SHAREDGRIDACCUMULATOR_H
+#define QMCPLUSPLUS_SHAREDGRIDACCUMULATOR_H
+
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "Configuration.h"
+
+namespace qmcplusplus
+{
+/** Accumulation backend for the grid of a rank level OperatorEstBase shared by all its crowd clones.
+ *
+ *  Instead of every crowd keeping a full copy of the grid which is summed in collect,
+ *  the crowds add into the rank grid directly. The grid is split into shards of a whole number
+ *  of cache lines, each guarded by its own lock, so crowds only contend when they
+ *  touch the same shard and a shard is never written by two threads at once.
+ *  The grid storage is owned by the estimator, it must outlive the accumulator.
+ */
+class SharedGridAccumulator
+{
+public:
+  using Real = QMCTraits::RealType;
+
+  struct Deposit
+  {
+    size_t index;
+    Real weight;
+  };
+
+  /// number of Real in a cache line
+  static constexpr size_t cache_line_reals = 64 / sizeof(Real);
+
+  /** @param grid storage of the grid
+   *  @param shard_lines number of cache lines in a shard
+   */
+  SharedGridAccumulator(std::vector<Real>& grid, size_t shard_lines = 64);
+
+  /** add deposits sorted by index to the grid, each touched shard is locked once
+   */
+  void addSorted(const std::vector<Deposit>& deposits);
+
+  /** add scale * values to the whole grid, values must have the size of the grid
+   */
+  void addDense(const Real* values, Real scale);
+
+  size_t getShardSize() const { return shard_size_; }
+  size_t getNumShards() const { return shard_locks_.size(); }
+
+private:
+  std::vector<Real>& grid_;
+  const size_t shard_size_;
+  std::vector<std::mutex> shard_locks_;
+};
+
+/** Per crowd sparse buffer of deposits to a SharedGridAccumulator.
+ *
+ *  Deposits are queued until the buffer reaches its capacity or is flushed explicitly.
+ *  A flush sorts them by grid index so they land shard by shard in the shared grid.
+ */
+class GridDepositBuffer
+{
+public:
+  using Real = SharedGridAccumulator::Real;
+
+  GridDepositBuffer(const std::shared_ptr<SharedGridAccumulator>& grid, size_t capacity = 4096);
+
+  void deposit(size_t index, Real weight)
+  {
+    deposits_.push_back({index, weight});
+    if (deposits_.size() >= capacity_)
+      flush();
+  }
+
+  /// add all the queued deposits to the shared grid
+  void flush();
+
+  size_t size() const { return deposits_.size(); }
+
+private:
+  const std::shared_ptr<SharedGridAccumulator> grid_;
+  const size_t capacity_;
+  std::vector<SharedGridAccumulator::Deposit> deposits_;
+};
+
+} // namespace qmcplusplus
+
+#endif
@@ -0,0 +1,235 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//
+// Some code refactored from: QMCHamiltonians/SpaceGrid.cpp
+//////////////////////////////////////////////////////////////////////////////////////
+
+#include "SpaceGridInput.h"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+#include "OhmmsData/XMLParsingString.h"
+#include "Message/UniformCommunicateError.h"
+#include "Utilities/string_utils.h"
+
+namespace qmcplusplus
+{
+
+SpaceGridInput::SpaceGridInput(xmlNodePtr cur) { readXML(cur); }
+
+void SpaceGridInput::readXML(xmlNodePtr cur)
+{
+  const std::string coord(getXMLAttributeValue(cur, "coord"));
+  if (coord == "cartesian")
+  {
+    coord_       = Coord::CARTESIAN;
+    axis_labels_ = {"x", "y", "z"};
+  }
+  else if (coord == "cylindrical")
+  {
+    coord_       = Coord::CYLINDRICAL;
+    axis_labels_ = {"r", "phi", "z"};
+  }
+  else if (coord == "spherical")
+  {
+    coord_       = Coord::SPHERICAL;
+    axis_labels_ = {"r", "phi", "theta"};
+  }
+  else
+    throw UniformCommunicateError("SpaceGridInput coord must be cartesian, cylindrical or spherical, you provided \"" +
+                                  coord + "\"");
+
+  auto readOr = [](xmlNodePtr element, const std::string& name, const std::string& default_value) {
+    std::string value(getXMLAttributeValue(element, name));
+    return value.empty() ? default_value : value;
+  };
+
+  bool has_origin = false;
+  std::array<bool, DIM> has_axis{};
+  xmlNodePtr element = cur->xmlChildrenNode;
+  while (element != NULL)
+  {
+    std::string ename((const char*)element->name);
+    if (ename == "origin")
+    {
+      if (has_origin)
+        throw UniformCommunicateError("SpaceGridInput spacegrid must contain at most one origin element");
+      has_origin = true;
+      origin_p1_ = getXMLAttributeValue(element, "p1");
+      if (origin_p1_.empty())
+        throw UniformCommunicateError("SpaceGridInput p1 must be defined in spacegrid element origin");
+      origin_p2_       = readOr(element, "p2", "zero");
+      origin_fraction_ = string2real(readOr(element, "fraction", "0.0"));
+    }
+    else if (ename == "axis")
+    {
+      AxisInput axis;
+      axis.p1    = getXMLAttributeValue(element, "p1");
+      axis.p2    = readOr(element, "p2", "zero");
+      axis.scale = string2real(readOr(element, "scale", "1.0"));
+      axis.label = getXMLAttributeValue(element, "label");
+      axis.grid  = readOr(element, "grid", "0 1");
+      if (axis.p1.empty())
+        throw UniformCommunicateError("SpaceGridInput p1 must be defined in spacegrid element axis");
+      auto label_it = std::find(axis_labels_.begin(), axis_labels_.end(), axis.label);
+      if (label_it == axis_labels_.end())
+        throw UniformCommunicateError("SpaceGridInput grid label \"" + axis.label + "\" is invalid for " + coord +
+                                      " coordinates");
+      const int iaxis = label_it - axis_labels_.begin();
+      if (has_axis[iaxis])
+        throw UniformCommunicateError("SpaceGridInput axis " + axis.label + " is defined more than once");
+      has_axis[iaxis]    = true;
+      axis_grids_[iaxis] = parseGrid(axis.grid);
+      axes_[iaxis]       = std::move(axis);
+    }
+    element = element->next;
+  }
+  if (std::count(has_axis.begin(), has_axis.end(), true) != DIM)
+    throw UniformCommunicateError("SpaceGridInput spacegrid must contain " + std::to_string(DIM) + " axes");
+  checkAxisGrids();
+}
+
+SpaceGridInput::AxisGrid SpaceGridInput::parseGrid(const std::string& grid_in)
+{
+  const Real utol = 1e-5;
+  // remove spaces inside of parentheses and separate the parenthesized values
+  std::string grid;
+  bool inparen = false;
+  for (char gc : grid_in)
+  {
+    if (gc == '(')
+    {
+      inparen = true;
+      grid += ' ';
+    }
+    if (!(inparen && gc == ' '))
+      grid += gc;
+    if (gc == ')')
+    {
+      inparen = false;
+      grid += ' ';
+    }
+  }
+  std::vector<std::string> tokens = split(grid);
+  const int nintervals = std::count_if(tokens.begin(), tokens.end(), [](auto& t) { return t[0] != '('; }) - 1;
+  if (nintervals < 1 || tokens.front()[0] == '(')
+    throw UniformCommunicateError("SpaceGridInput grid \"" + grid_in + "\" does not contain an interval");
+
+  // determine number of domains in each interval and the width of each domain
+  std::vector<int> ndom_int(nintervals);
+  std::vector<Real> du_int(nintervals);
+  AxisGrid axis_grid;
+  Real u1        = string2real(tokens[0]);
+  axis_grid.umin = u1;
+  bool is_int    = false;
+  bool has_paren = false;
+  Real du_i      = 0.0;
+  int ndom_i     = 1;
+  int interval   = -1;
+  for (int i = 1; i < tokens.size(); i++)
+  {
+    if (tokens[i][0] != '(')
+    {
+      Real u2        = string2real(tokens[i]);
+      axis_grid.umax = u2;
+      if (!has_paren)
+      {
+        is_int = false;
+        du_i   = u2 - u1;
+      }
+      has_paren = false;
+      interval++;
+      if (u2 <= u1)
+        throw UniformCommunicateError("SpaceGridInput grid \"" + grid_in + "\" has an empty or negative interval");
+      if (std::abs(u1) > 1.0000001 || std::abs(u2) > 1.0000001)
+        throw UniformCommunicateError("SpaceGridInput grid \"" + grid_in + "\" interval ends cannot exceed 1");
+      if (is_int)
+      {
+        du_int[interval]   = (u2 - u1) / ndom_i;
+        ndom_int[interval] = ndom_i;
+      }
+      else
+      {
+        du_int[interval]   = du_i;
+        ndom_int[interval] = std::floor((u2 - u1) / du_i + .5);
+        if (std::abs(u2 - u1 - du_i * ndom_int[interval]) > utol)
+          throw UniformCommunicateError("SpaceGridInput grid \"" + grid_in + "\" interval not divisible by its width");
+      }
+      u1 = u2;
+    }
+    else
+    {
+      has_paren                   = true;
+      const std::string paren_val = tokens[i].substr(1, tokens[i].length() - 2);
+      is_int                      = paren_val.find(".") == std::string::npos;
+      if (is_int)
+        ndom_i = string2int(paren_val);
+      else
+        du_i = string2real(paren_val);
+      if ((is_int && ndom_i < 1) || (!is_int && du_i <= 0.0))
+        throw UniformCommunicateError("SpaceGridInput grid \"" + grid_in + "\" has an invalid domain width");
+    }
+  }
+
+  // the smallest domain width must divide all the others
+  const Real du_min = *std::min_element(du_int.begin(), du_int.end());
+  axis_grid.odu     = 1.0 / du_min;
+  std::vector<int> ndu_int(nintervals);
+  for (int i = 0; i < nintervals; i++)
+  {
+    ndu_int[i] = std::floor(du_int[i] / du_min + .5);
+    if (std::abs(du_int[i] - ndu_int[i] * du_min) > utol)
+      throw UniformCommunicateError("SpaceGridInput grid \"" + grid_in +
+                                    "\" has an interval not divisible by the smallest domain width");
+  }
+
+  // set up the interval map such that gmap[(u-umin)*odu] == domain index
+  axis_grid.gmap.resize(std::floor((axis_grid.umax - axis_grid.umin) * axis_grid.odu + .5));
+  int n  = 0;
+  int nd = -1;
+  for (int i = 0; i < nintervals; i++)
+    for (int j = 0; j < ndom_int[i]; j++)
+    {
+      nd++;
+      axis_grid.ndu_per_domain.push_back(ndu_int[i]);
+      for (int k = 0; k < ndu_int[i] && n < axis_grid.gmap.size(); k++, n++)
+        axis_grid.gmap[n] = nd;
+    }
+  axis_grid.dimension = nd + 1;
+  return axis_grid;
+}
+
+void SpaceGridInput::checkAxisGrids() const
+{
+  for (int d = 0; d < DIM; d++)
+  {
+    const AxisGrid& axis_grid = axis_grids_[d];
+    const std::string& label  = axis_labels_[d];
+    std::ostringstream error;
+    if (label == "x" || label == "y" || label == "z")
+    {
+      if (axis_grid.umin < -1.0 || axis_grid.umax > 1.0)
+        error << "SpaceGridInput grid values for " << label << " must fall in [-1,1]";
+    }
+    else if (label == "phi")
+    {
+      if (std::abs(axis_grid.umin) + std::abs(axis_grid.umax) > 1.0)
+        error << "SpaceGridInput phi interval cannot be longer than 1";
+    }
+    else if (axis_grid.umin < 0.0 || axis_grid.umax > 1.0)
+      error << "SpaceGridInput grid values for " << label << " must fall in [0,1]";
+    if (!error.str().empty())
+      throw UniformCommunicateError(error.str());
+  }
+}
+
+} // namespace qmcplusplus
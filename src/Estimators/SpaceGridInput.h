@@ -0,0 +1,111 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//
+// Some code refactored from: QMCHamiltonians/SpaceGrid.cpp
+//////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef QMCPLUSPLUS_SPACEGRIDINPUT_H
+#define QMCPLUSPLUS_SPACEGRIDINPUT_H
+
+#include <array>
+#include <string>
+#include <vector>
+#include "Configuration.h"
+#include "OhmmsData/libxmldefs.h"
+
+namespace qmcplusplus
+{
+/** Native representation of a spacegrid element of the EnergyDensity estimator input
+ *
+ *  <spacegrid coord="cartesian">
+ *    <origin p1="zero"/>
+ *    <axis p1="a1" scale=".5" label="x" grid="-1 (.1) 1"/>
+ *    <axis p1="a2" scale=".5" label="y" grid="-1 (.1) 1"/>
+ *    <axis p1="a3" scale=".5" label="z" grid="-1 (.1) 1"/>
+ *  </spacegrid>
+ *
+ *  Points are named reference points, see EnergyDensityNew::makeReferencePoints.
+ *  The grid of an axis is a sequence of interval ends, each interval optionally preceded by
+ *  its domain width "(.1)" or its number of domains "(10)". Voronoi grids and the
+ *  particle number resolved grids (min_part, max_part) of the legacy SpaceGrid are not supported.
+ */
+class SpaceGridInput
+{
+public:
+  using Real               = QMCTraits::RealType;
+  static constexpr int DIM = OHMMS_DIM;
+
+  enum class Coord
+  {
+    CARTESIAN,
+    CYLINDRICAL,
+    SPHERICAL
+  };
+
+  /** an axis as given in input
+   *  the axis vector is scale * (p1 - p2)
+   */
+  struct AxisInput
+  {
+    std::string p1;
+    std::string p2 = "zero";
+    Real scale     = 1.0;
+    std::string label;
+    std::string grid = "0 1";
+  };
+
+  /** derived grid of an axis in the reduced coordinate u
+   *  the domain of u is gmap[(u - umin) * odu] for umin < u < umax
+   */
+  struct AxisGrid
+  {
+    Real umin;
+    Real umax;
+    /// inverse of the smallest domain width
+    Real odu;
+    /// fine grid index to domain index
+    std::vector<int> gmap;
+    /// number of fine grid widths of each domain
+    std::vector<int> ndu_per_domain;
+    int dimension;
+  };
+
+  SpaceGridInput(xmlNodePtr cur);
+  SpaceGridInput(const SpaceGridInput&) = default;
+
+  Coord get_coord() const { return coord_; }
+  const std::string& get_origin_p1() const { return origin_p1_; }
+  const std::string& get_origin_p2() const { return origin_p2_; }
+  Real get_origin_fraction() const { return origin_fraction_; }
+  /// axes ordered by their coordinate label
+  const std::array<AxisInput, DIM>& get_axes() const { return axes_; }
+  const std::array<AxisGrid, DIM>& get_axis_grids() const { return axis_grids_; }
+  const std::array<std::string, DIM>& get_axis_labels() const { return axis_labels_; }
+
+  /** parse the grid string of an axis
+   *  throws UniformCommunicateError on malformed or inconsistent grids
+   */
+  static AxisGrid parseGrid(const std::string& grid);
+
+private:
+  void readXML(xmlNodePtr cur);
+  void checkAxisGrids() const;
+
+  Coord coord_;
+  std::string origin_p1_ = "zero";
+  std::string origin_p2_ = "zero";
+  Real origin_fraction_  = 0.0;
+  std::array<AxisInput, DIM> axes_;
+  std::array<AxisGrid, DIM> axis_grids_;
+  std::array<std::string, DIM> axis_labels_;
+};
+
+} // namespace qmcplusplus
+#endif
@@ -0,0 +1,262 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//
+// Some code refactored from: QMCHamiltonians/SpaceGrid.cpp
+//////////////////////////////////////////////////////////////////////////////////////
+
+#include "SpaceGridNew.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "OhmmsPETE/TensorOps.h"
+#include "Message/UniformCommunicateError.h"
+
+namespace qmcplusplus
+{
+static_assert(OHMMS_DIM == 3, "SpaceGridNew is only implemented for 3 dimensions");
+
+SpaceGridNew::SpaceGridNew(const SpaceGridInput& input, const Points& points, int nvalues)
+    : coord_(input.get_coord()), nvalues_(nvalues)
+{
+  auto getPoint = [&points](const std::string& name) {
+    auto point_it = points.find(name);
+    if (point_it == points.end())
+      throw UniformCommunicateError("SpaceGridNew reference point " + name + " does not exist");
+    return point_it->second;
+  };
+
+  const Point origin_p1 = getPoint(input.get_origin_p1());
+  origin_               = origin_p1 + input.get_origin_fraction() * (getPoint(input.get_origin_p2()) - origin_p1);
+  for (int iaxis = 0; iaxis < OHMMS_DIM; iaxis++)
+  {
+    const auto& axis   = input.get_axes()[iaxis];
+    const Point axis_v = axis.scale * (getPoint(axis.p1) - getPoint(axis.p2));
+    for (int d = 0; d < OHMMS_DIM; d++)
+      axes_(d, iaxis) = axis_v[d];
+  }
+  if (std::abs(det(axes_)) < std::numeric_limits<Real>::epsilon())
+    throw UniformCommunicateError("SpaceGridNew axes are linearly dependent");
+  axinv_ = inverse(axes_);
+
+  for (int d = 0; d < OHMMS_DIM; d++)
+  {
+    const auto& axis_grid = input.get_axis_grids()[d];
+    umin_[d]              = axis_grid.umin;
+    umax_[d]              = axis_grid.umax;
+    odu_[d]               = axis_grid.odu;
+    dimensions_[d]        = axis_grid.dimension;
+    gmap_[d]              = axis_grid.gmap;
+  }
+  // C/Python style indexing
+  dm_[0]    = dimensions_[1] * dimensions_[2];
+  dm_[1]    = dimensions_[2];
+  dm_[2]    = 1;
+  ndomains_ = dimensions_[0] * dimensions_[1] * dimensions_[2];
+
+  initializeDomains(input);
+}
+
+void SpaceGridNew::initializeDomains(const SpaceGridInput& input)
+{
+  domain_volumes_.resize(ndomains_, 1);
+  domain_centers_.resize(ndomains_, OHMMS_DIM);
+  domain_uwidths_.resize(ndomains_, OHMMS_DIM);
+
+  // volume and reduced center of a domain in the coordinates of the grid
+  auto domainVolume = [this](Point& uc, Point& du, Point& ubc) {
+    Real vol = 0.0;
+    switch (coord_)
+    {
+    case Coord::CARTESIAN:
+      vol = du[0] * du[1] * du[2];
+      ubc = uc;
+      break;
+    case Coord::CYLINDRICAL:
+      uc[1]  = 2.0 * M_PI * uc[1] - M_PI;
+      du[1]  = 2.0 * M_PI * du[1];
+      vol    = uc[0] * du[0] * du[1] * du[2];
+      ubc[0] = uc[0] * std::cos(uc[1]);
+      ubc[1] = uc[0] * std::sin(uc[1]);
+      ubc[2] = uc[2];
+      break;
+    case Coord::SPHERICAL:
+      uc[1] = 2.0 * M_PI * uc[1] - M_PI;
+      du[1] = 2.0 * M_PI * du[1];
+      uc[2] = M_PI * uc[2];
+      du[2] = M_PI * du[2];
+      vol   = (uc[0] * uc[0] + du[0] * du[0] / 12.0) * du[0] //r
+          * du[1]                                            //phi
+          * 2.0 * std::sin(uc[2]) * std::sin(.5 * du[2]);    //theta
+      ubc[0] = uc[0] * std::sin(uc[2]) * std::cos(uc[1]);
+      ubc[1] = uc[0] * std::sin(uc[2]) * std::sin(uc[1]);
+      ubc[2] = uc[0] * std::cos(uc[2]);
+      break;
+    }
+    return vol;
+  };
+
+  std::vector<Real> interval_centers[OHMMS_DIM];
+  std::vector<Real> interval_widths[OHMMS_DIM];
+  for (int d = 0; d < OHMMS_DIM; d++)
+  {
+    const auto& ndu_per_domain = input.get_axis_grids()[d].ndu_per_domain;
+    const int nintervals       = ndu_per_domain.size();
+    interval_centers[d].resize(nintervals);
+    interval_widths[d].resize(nintervals);
+    interval_widths[d][0]  = ndu_per_domain[0] / odu_[d];
+    interval_centers[d][0] = interval_widths[d][0] / 2.0 + umin_[d];
+    for (int i = 1; i < nintervals; i++)
+    {
+      interval_widths[d][i]  = ndu_per_domain[i] / odu_[d];
+      interval_centers[d][i] = interval_centers[d][i - 1] + .5 * (interval_widths[d][i] + interval_widths[d][i - 1]);
+    }
+  }
+
+  const Real vscale = std::abs(det(axes_));
+  Point du, uc, ubc;
+  for (int i = 0; i < dimensions_[0]; i++)
+    for (int j = 0; j < dimensions_[1]; j++)
+      for (int k = 0; k < dimensions_[2]; k++)
+      {
+        const int idomain = dm_[0] * i + dm_[1] * j + dm_[2] * k;
+        du                = {interval_widths[0][i], interval_widths[1][j], interval_widths[2][k]};
+        uc                = {interval_centers[0][i], interval_centers[1][j], interval_centers[2][k]};
+        for (int d = 0; d < OHMMS_DIM; d++)
+          domain_uwidths_(idomain, d) = du[d];
+        domain_volumes_(idomain, 0) = domainVolume(uc, du, ubc) * vscale;
+        const Point rc              = dot(axes_, ubc) + origin_;
+        for (int d = 0; d < OHMMS_DIM; d++)
+          domain_centers_(idomain, d) = rc[d];
+      }
+
+  // the actual volume spanned by the grid
+  for (int d = 0; d < OHMMS_DIM; d++)
+  {
+    du[d] = umax_[d] - umin_[d];
+    uc[d] = .5 * (umax_[d] + umin_[d]);
+  }
+  volume_ = domainVolume(uc, du, ubc) * det(axes_);
+}
+
+void SpaceGridNew::accumulate(const Positions& positions,
+                              const Matrix<Real>& values,
+                              Real* grid_data,
+                              std::vector<bool>& outside)
+{
+  const int np = positions.size();
+  assert(values.rows() == np && values.cols() == nvalues_ && outside.size() == np);
+  u_.resize(np);
+  domain_index_.resize(np);
+
+  const Real* restrict px = positions.data(0);
+  const Real* restrict py = positions.data(1);
+  const Real* restrict pz = positions.data(2);
+  Real* restrict u0       = u_.data(0);
+  Real* restrict u1       = u_.data(1);
+  Real* restrict u2       = u_.data(2);
+
+  // reduced coordinates u = axinv * (r - origin)
+  const Tensor<Real, OHMMS_DIM> ai(axinv_);
+  const Point o(origin_);
+#pragma omp simd
+  for (int i = 0; i < np; i++)
+  {
+    const Real dx = px[i] - o[0];
+    const Real dy = py[i] - o[1];
+    const Real dz = pz[i] - o[2];
+    u0[i]         = ai(0, 0) * dx + ai(0, 1) * dy + ai(0, 2) * dz;
+    u1[i]         = ai(1, 0) * dx + ai(1, 1) * dy + ai(1, 2) * dz;
+    u2[i]         = ai(2, 0) * dx + ai(2, 1) * dy + ai(2, 2) * dz;
+  }
+
+  const Real o2pi = 1.0 / (2.0 * M_PI);
+  switch (coord_)
+  {
+  case Coord::CARTESIAN:
+    break;
+  case Coord::CYLINDRICAL:
+#pragma omp simd
+    for (int i = 0; i < np; i++)
+    {
+      const Real r   = std::sqrt(u0[i] * u0[i] + u1[i] * u1[i]);
+      const Real phi = std::atan2(u1[i], u0[i]) * o2pi + .5;
+      u0[i]          = r;
+      u1[i]          = phi;
+    }
+    break;
+  case Coord::SPHERICAL:
+#pragma omp simd
+    for (int i = 0; i < np; i++)
+    {
+      const Real r     = std::sqrt(u0[i] * u0[i] + u1[i] * u1[i] + u2[i] * u2[i]);
+      const Real phi   = std::atan2(u1[i], u0[i]) * o2pi + .5;
+      const Real theta = std::acos(u2[i] / r) * o2pi * 2.0;
+      u0[i]            = r;
+      u1[i]            = phi;
+      u2[i]            = theta;
+    }
+    break;
+  }
+
+  // domain of each particle, the fine grid indexes are clamped so the gathers stay in bounds
+  const int* restrict gmap0 = gmap_[0].data();
+  const int* restrict gmap1 = gmap_[1].data();
+  const int* restrict gmap2 = gmap_[2].data();
+  const int nfine0          = gmap_[0].size() - 1;
+  const int nfine1          = gmap_[1].size() - 1;
+  const int nfine2          = gmap_[2].size() - 1;
+  int* restrict domains     = domain_index_.data();
+#pragma omp simd
+  for (int i = 0; i < np; i++)
+  {
+    const bool inside = u0[i] > umin_[0] && u0[i] < umax_[0] && u1[i] > umin_[1] && u1[i] < umax_[1] &&
+        u2[i] > umin_[2] && u2[i] < umax_[2];
+    const int i0 = inside ? std::min(static_cast<int>((u0[i] - umin_[0]) * odu_[0]), nfine0) : 0;
+    const int i1 = inside ? std::min(static_cast<int>((u1[i] - umin_[1]) * odu_[1]), nfine1) : 0;
+    const int i2 = inside ? std::min(static_cast<int>((u2[i] - umin_[2]) * odu_[2]), nfine2) : 0;
+    domains[i]   = inside ? dm_[0] * gmap0[i0] + dm_[1] * gmap1[i1] + dm_[2] * gmap2[i2] : -1;
+  }
+
+  // scatter the values to their domains
+  for (int i = 0; i < np; i++)
+    if (domains[i] >= 0)
+    {
+      outside[i]            = false;
+      const Real* restrict v = values[i];
+      Real* restrict bin     = grid_data + nvalues_ * domains[i];
+      for (int iv = 0; iv < nvalues_; iv++)
+        bin[iv] += v[iv];
+    }
+}
+
+void SpaceGridNew::registerGrid(std::vector<ObservableHelper>& h5desc,
+                                hdf_archive& file,
+                                hdf_path path,
+                                int offset) const
+{
+  h5desc.emplace_back(path);
+  auto& oh = h5desc.back();
+  std::vector<int> ng(1, size());
+  oh.set_dimensions(ng, offset);
+  int coord = static_cast<int>(coord_);
+  oh.addProperty(coord, "coordinate", file);
+  oh.addProperty(const_cast<int&>(ndomains_), "ndomains", file);
+  oh.addProperty(const_cast<int&>(nvalues_), "nvalues_per_domain", file);
+  oh.addProperty(const_cast<Real&>(volume_), "volume", file);
+  oh.addProperty(const_cast<Matrix<Real>&>(domain_volumes_), "domain_volumes", file);
+  oh.addProperty(const_cast<Matrix<Real>&>(domain_centers_), "domain_centers", file);
+  oh.addProperty(const_cast<Point&>(origin_), "origin", file);
+  oh.addProperty(const_cast<Tensor<Real, OHMMS_DIM>&>(axes_), "axes", file);
+  oh.addProperty(const_cast<Tensor<Real, OHMMS_DIM>&>(axinv_), "axinv", file);
+  oh.addProperty(const_cast<Matrix<Real>&>(domain_uwidths_), "domain_uwidths", file);
+}
+
+} // namespace qmcplusplus
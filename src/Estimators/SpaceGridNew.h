@@ -0,0 +1,102 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//
+// Some code refactored from: QMCHamiltonians/SpaceGrid.cpp
+//////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef QMCPLUSPLUS_SPACEGRIDNEW_H
+#define QMCPLUSPLUS_SPACEGRIDNEW_H
+
+#include <map>
+#include <string>
+#include <vector>
+#include "Configuration.h"
+#include "OhmmsPETE/Tensor.h"
+#include "OhmmsPETE/OhmmsMatrix.h"
+#include "OhmmsSoA/VectorSoaContainer.h"
+#include "QMCHamiltonians/ObservableHelper.h"
+#include "SpaceGridInput.h"
+
+namespace qmcplusplus
+{
+/** Rectilinear grid in cartesian, cylindrical or spherical coordinates binning per particle values.
+ *
+ *  Batched replacement of the rectilinear part of the legacy SpaceGrid.
+ *  The grid only holds its geometry, the binned values live in the data of the estimator
+ *  owning it. accumulate bins the particles of all the walkers of a crowd at once:
+ *  the coordinate transforms and the domain lookups are done as SIMD loops over
+ *  the particle positions in SoA layout, only the final scatter of the values into the
+ *  domains is a scalar loop.
+ */
+class SpaceGridNew
+{
+public:
+  using Real      = QMCTraits::RealType;
+  using Point     = TinyVector<Real, OHMMS_DIM>;
+  using Points    = std::map<std::string, Point>;
+  using Positions = VectorSoaContainer<Real, OHMMS_DIM>;
+  using Coord     = SpaceGridInput::Coord;
+
+  /** @param input     spacegrid input
+   *  @param points    reference points the input origin and axes refer to
+   *  @param nvalues   number of values per domain
+   */
+  SpaceGridNew(const SpaceGridInput& input, const Points& points, int nvalues);
+
+  /** bin values of a crowd of particles
+   *  @param positions     positions of the particles of all the walkers
+   *  @param values        values of the particles, row: particle col: value
+   *  @param grid_data     first element of this grid in the estimator data, size ndomains * nvalues
+   *  @param outside       per particle flag, set to false for the particles inside this grid
+   */
+  void accumulate(const Positions& positions, const Matrix<Real>& values, Real* grid_data, std::vector<bool>& outside);
+
+  /** add the hdf5 descriptor and grid properties
+   *  @param h5desc   descriptors of the owning estimator
+   *  @param path     hdf5 path of this grid
+   *  @param offset   index of the first value of this grid in the estimator data
+   */
+  void registerGrid(std::vector<ObservableHelper>& h5desc, hdf_archive& file, hdf_path path, int offset) const;
+
+  /// number of Real in the estimator data for this grid
+  size_t size() const { return ndomains_ * nvalues_; }
+  int getNumDomains() const { return ndomains_; }
+  Real getVolume() const { return volume_; }
+  const Matrix<Real>& getDomainVolumes() const { return domain_volumes_; }
+  const Matrix<Real>& getDomainCenters() const { return domain_centers_; }
+
+private:
+  void initializeDomains(const SpaceGridInput& input);
+
+  const Coord coord_;
+  const int nvalues_;
+  int ndomains_;
+  Point origin_;
+  Tensor<Real, OHMMS_DIM> axes_;
+  Tensor<Real, OHMMS_DIM> axinv_;
+  Real volume_;
+  Matrix<Real> domain_volumes_;
+  Matrix<Real> domain_centers_;
+  Matrix<Real> domain_uwidths_;
+  Real umin_[OHMMS_DIM];
+  Real umax_[OHMMS_DIM];
+  Real odu_[OHMMS_DIM];
+  int dimensions_[OHMMS_DIM];
+  int dm_[OHMMS_DIM];
+  std::vector<int> gmap_[OHMMS_DIM];
+
+  /// workspace: reduced coordinates of the crowd particles
+  Positions u_;
+  /// workspace: domain of each crowd particle, -1 if outside
+  std::vector<int> domain_index_;
+};
+
+} // namespace qmcplusplus
+#endif
@@ -15,7 +15,6 @@
 #include "hdf5.h"
 
 #include <iostream>
-#include <numeric>
 #include <SpeciesSet.h>
 
 namespace qmcplusplus
@@ -25,9 +24,9 @@ SpinDensityNew::SpinDensityNew(SpinDensityInput&& input, const SpeciesSet& speci
 {
   my_name_ = "SpinDensity";
 
-  data_locality_ = DataLocality::crowd;
   if (input_.get_save_memory())
     dl = DataLocality::rank;
+  data_locality_ = dl;
 
   if (input_.get_cell().explicitly_defined == true)
     lattice_ = input_.get_cell();
@@ -38,6 +37,8 @@ SpinDensityNew::SpinDensityNew(SpinDensityInput&& input, const SpeciesSet& speci
   derived_parameters_ = input_.calculateDerivedParameters(lattice_);
 
   data_.resize(getFullDataSize(), 0.0);
+  if (data_locality_ == DataLocality::rank)
+    makeSharedGrid();
 
   if (input_.get_write_report())
     report("  ");
@@ -59,6 +60,8 @@ SpinDensityNew::SpinDensityNew(SpinDensityInput&& input,
     lattice_ = input_.get_cell();
   derived_parameters_ = input_.calculateDerivedParameters(lattice_);
   data_.resize(getFullDataSize());
+  if (data_locality_ == DataLocality::rank)
+    makeSharedGrid();
   if (input_.get_write_report())
     report("  ");
 }
@@ -87,27 +90,16 @@ std::unique_ptr<OperatorEstBase> SpinDensityNew::spawnCrowdClone() const
   auto spawn_data_locality = data_locality_;
   if (data_locality_ == DataLocality::rank)
   {
+    // the crowd clones deposit into the shared grid of the rank estimator
     spawn_data_locality = DataLocality::queue;
-    // at construction we don't know what the data requirement is going to be
-    // since its steps per block  dependent. so start with 10 steps worth.
-    int num_particles = std::accumulate(species_size_.begin(), species_size_.end(), 0);
-    data_size         = num_particles * 20;
+    data_size           = 0;
   }
   UPtr<SpinDensityNew> spawn(std::make_unique<SpinDensityNew>(*this, spawn_data_locality));
   spawn->get_data().resize(data_size);
   return spawn;
 }
 
-void SpinDensityNew::startBlock(int steps)
-{
-  if (data_locality_ == DataLocality::rank)
-  {
-    int num_particles = std::accumulate(species_size_.begin(), species_size_.end(), 0);
-    size_t data_size  = num_particles * steps * 2;
-    data_.reserve(data_size);
-    data_.resize(0);
-  }
-}
+void SpinDensityNew::startBlock(int steps) {}
 
 /** Gets called every step and writes to thread local data.
  *
@@ -150,8 +142,7 @@ void SpinDensityNew::accumulateToData(size_t point, QMCT::RealType weight)
   }
   else if (data_locality_ == DataLocality::queue)
   {
-    data_.push_back(point);
-    data_.push_back(weight);
+    depositToSharedGrid(point, weight);
   }
   else
   {
@@ -161,31 +152,7 @@ void SpinDensityNew::accumulateToData(size_t point, QMCT::RealType weight)
 
 void SpinDensityNew::collect(const RefVector<OperatorEstBase>& type_erased_operator_estimators)
 {
-  if (data_locality_ == DataLocality::rank)
-  {
-    for (OperatorEstBase& crowd_oeb : type_erased_operator_estimators)
-    {
-      // This will throw a std::bad_cast in debug if the calling code hands the
-      // wrong type erased operator_estimator type into here.
-      // In release we don't want that overhead.
-#ifndef NDEBUG
-      auto& oeb = dynamic_cast<SpinDensityNew&>(crowd_oeb);
-#else
-      auto& oeb = static_cast<SpinDensityNew&>(crowd_oeb);
-#endif
-      auto& data = oeb.get_data();
-      for (int id = 0; id < data.size(); id += 2)
-      {
-        // This is a smell
-        size_t point{static_cast<size_t>(data[id])};
-        const QMCT::RealType weight{data[id + 1]};
-        data_[point] += weight;
-        walkers_weight_ += weight;
-      }
-      oeb.zero();
-    }
-  }
-  else if (data_locality_ == DataLocality::crowd)
+  if (data_locality_ == DataLocality::rank || data_locality_ == DataLocality::crowd)
   {
     OperatorEstBase::collect(type_erased_operator_estimators);
   }
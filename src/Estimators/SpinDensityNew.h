@@ -71,7 +71,7 @@ public:
    */
   SpinDensityNew(const SpinDensityNew& sdn, DataLocality dl);
 
-  /** This allows us to allocate the necessary data for the DataLocality::queue 
+  /** nothing to allocate, DataLocality::queue crowd clones deposit into the shared grid
    */
   void startBlock(int steps) override;
 
@@ -89,8 +89,8 @@ public:
   /** this allows the EstimatorManagerNew to reduce without needing to know the details
    *  of SpinDensityNew's data.
    *
-   *  can use base class default until crowd level SpinDensity
-   *  estimators don't have a copy of the density grid.
+   *  With DataLocality::rank (save_memory) the crowd clones have no copy of the density grid,
+   *  they deposit into the grid of the rank estimator shared through OperatorEstBase.
    */
   void collect(const RefVector<OperatorEstBase>& operator_estimators) override;
 
@@ -0,0 +1,127 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//
+// Some code refactored from: SkEstimator.cpp, StaticStructureFactor.cpp
+//////////////////////////////////////////////////////////////////////////////////////
+
+#include "StructureFactorEstimator.h"
+
+#include "LongRange/StructFact.h"
+#include "LongRange/KContainer.h"
+#include "Message/UniformCommunicateError.h"
+
+namespace qmcplusplus
+{
+
+StructureFactorEstimator::StructureFactorEstimator(StructureFactorInput&& input,
+                                                   const ParticleSet& pset,
+                                                   DataLocality dl)
+    : OperatorEstBase(dl), input_(std::move(input))
+{
+  my_name_ = input_.get_name();
+  if (!pset.hasSK())
+    throw UniformCommunicateError("StructureFactorEstimator requires a periodic particle set, " + pset.getName() +
+                                  " has no structure factor");
+
+  const KContainer& k_lists = pset.getSimulationCell().getKLists();
+  num_kpoints_              = k_lists.numk;
+  if (input_.get_kmax() > 0.0)
+  {
+    // k-points are sorted by shell
+    const Real k2max = input_.get_kmax() * input_.get_kmax();
+    num_kpoints_     = 0;
+    while (num_kpoints_ < k_lists.numk && k_lists.ksq[num_kpoints_] <= k2max)
+      ++num_kpoints_;
+  }
+  if (num_kpoints_ == 0)
+    throw UniformCommunicateError("StructureFactorEstimator could not find any k-points with |k| <= kmax");
+  kpoints_.assign(k_lists.kpts_cart.begin(), k_lists.kpts_cart.begin() + num_kpoints_);
+
+  const SpeciesSet& species = pset.getSpeciesSet();
+  num_species_              = species.size();
+  species_names_.assign(species.speciesName.begin(), species.speciesName.begin() + num_species_);
+  one_over_n_ = 1.0 / static_cast<Real>(pset.getTotalNum());
+
+  data_.resize(num_kpoints_ * (1 + 2 * num_species_), 0.0);
+}
+
+StructureFactorEstimator::StructureFactorEstimator(const StructureFactorEstimator& sfe, DataLocality dl)
+    : StructureFactorEstimator(sfe)
+{
+  data_locality_ = dl;
+}
+
+std::unique_ptr<OperatorEstBase> StructureFactorEstimator::spawnCrowdClone() const
+{
+  auto spawn = std::make_unique<StructureFactorEstimator>(*this, data_locality_);
+  spawn->get_data().resize(data_.size(), 0.0);
+  return spawn;
+}
+
+void StructureFactorEstimator::accumulate(const RefVector<MCPWalker>& walkers,
+                                          const RefVector<ParticleSet>& psets,
+                                          const RefVector<TrialWaveFunction>& wfns,
+                                          RandomGenerator& rng)
+{
+  const int nk = num_kpoints_;
+  rhok_tot_r_.resize(nk);
+  rhok_tot_i_.resize(nk);
+  Real* restrict rhok_tot_r = rhok_tot_r_.data();
+  Real* restrict rhok_tot_i = rhok_tot_i_.data();
+  Real* restrict sk         = data_.data();
+
+  for (int iw = 0; iw < walkers.size(); ++iw)
+  {
+    const Real w         = walkers[iw].get().Weight;
+    const StructFact& sf = psets[iw].get().getSK();
+    const Real w_over_n  = w * one_over_n_;
+    walkers_weight_ += w;
+
+    std::fill_n(rhok_tot_r, nk, 0.0);
+    std::fill_n(rhok_tot_i, nk, 0.0);
+    for (int is = 0; is < num_species_; ++is)
+    {
+      const Real* restrict rhok_r = sf.rhok_r[is];
+      const Real* restrict rhok_i = sf.rhok_i[is];
+      Real* restrict rhok_s_r     = sk + nk * (1 + 2 * is);
+      Real* restrict rhok_s_i     = rhok_s_r + nk;
+#pragma omp simd
+      for (int ik = 0; ik < nk; ++ik)
+      {
+        rhok_tot_r[ik] += rhok_r[ik];
+        rhok_tot_i[ik] += rhok_i[ik];
+        rhok_s_r[ik] += w * rhok_r[ik];
+        rhok_s_i[ik] += w * rhok_i[ik];
+      }
+    }
+#pragma omp simd
+    for (int ik = 0; ik < nk; ++ik)
+      sk[ik] += w_over_n * (rhok_tot_r[ik] * rhok_tot_r[ik] + rhok_tot_i[ik] * rhok_tot_i[ik]);
+  }
+}
+
+void StructureFactorEstimator::registerOperatorEstimator(hdf_archive& file)
+{
+  hdf_path hdf_name{my_name_};
+  h5desc_.emplace_back(hdf_name / "sk");
+  auto& oh = h5desc_.back();
+  std::vector<int> ng(1, num_kpoints_);
+  oh.set_dimensions(ng, 0);
+  oh.addProperty(kpoints_, "kpoints", file);
+
+  std::vector<int> ng_rhok{2, num_kpoints_};
+  for (int is = 0; is < num_species_; ++is)
+  {
+    h5desc_.emplace_back(hdf_name / ("rhok_" + species_names_[is]));
+    h5desc_.back().set_dimensions(ng_rhok, num_kpoints_ * (1 + 2 * is));
+  }
+}
+
+} // namespace qmcplusplus
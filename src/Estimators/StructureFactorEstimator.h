@@ -0,0 +1,76 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//
+// Some code refactored from: SkEstimator.cpp, StaticStructureFactor.cpp
+//////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef QMCPLUSPLUS_STRUCTUREFACTORESTIMATOR_H
+#define QMCPLUSPLUS_STRUCTUREFACTORESTIMATOR_H
+
+#include "OperatorEstBase.h"
+#include "StructureFactorInput.h"
+
+namespace qmcplusplus
+{
+/** Static structure factor estimator for the batched drivers.
+ *
+ *  Replaces the legacy SkEstimator and StaticStructureFactor. Nothing is computed per particle here,
+ *  the rho_k of every walker are the ones StructFact already updated for the whole crowd in
+ *  ParticleSet::mw_donePbyP, the estimator only does the weighted reductions over k.
+ *
+ *  data_ layout: S(k) = |rho_k|^2 / N summed over species, then for each species the
+ *  real and imaginary parts of its rho_k.
+ */
+class StructureFactorEstimator : public OperatorEstBase
+{
+public:
+  using Real    = QMCTraits::RealType;
+  using PosType = QMCTraits::PosType;
+
+  /** @param input   structure factor input
+   *  @param pset    target particle set, must have a structure factor i.e. be periodic
+   */
+  StructureFactorEstimator(StructureFactorInput&& input, const ParticleSet& pset, DataLocality dl = DataLocality::crowd);
+
+  /** Constructor used when spawning crowd clones
+   *  needs to be public so std::make_unique can call it.
+   */
+  StructureFactorEstimator(const StructureFactorEstimator& sfe, DataLocality dl);
+
+  void accumulate(const RefVector<MCPWalker>& walkers,
+                  const RefVector<ParticleSet>& psets,
+                  const RefVector<TrialWaveFunction>& wfns,
+                  RandomGenerator& rng) override;
+
+  std::unique_ptr<OperatorEstBase> spawnCrowdClone() const override;
+
+  void startBlock(int steps) override {}
+
+  void registerOperatorEstimator(hdf_archive& file) override;
+
+  int get_num_kpoints() const { return num_kpoints_; }
+
+private:
+  StructureFactorEstimator(const StructureFactorEstimator& sfe) = default;
+
+  StructureFactorInput input_;
+  /// number of k-points accumulated, the first ones of the simulation cell KContainer
+  int num_kpoints_;
+  int num_species_;
+  Real one_over_n_;
+  std::vector<PosType> kpoints_;
+  std::vector<std::string> species_names_;
+  /// workspace for rho_k summed over species
+  aligned_vector<Real> rhok_tot_r_;
+  aligned_vector<Real> rhok_tot_i_;
+};
+
+} // namespace qmcplusplus
+#endif
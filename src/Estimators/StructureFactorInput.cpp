@@ -0,0 +1,34 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+#include "EstimatorInput.h"
+#include "StructureFactorInput.h"
+
+namespace qmcplusplus
+{
+
+StructureFactorInput::StructureFactorInput(xmlNodePtr cur)
+{
+  // This results in checkParticularValidity being called on StructureFactorInputSection
+  input_section_.readXML(cur);
+  auto setIfInInput = LAMBDA_setIfInInput;
+  setIfInInput(name_, "name");
+  setIfInInput(type_, "type");
+  setIfInInput(kmax_, "kmax");
+}
+
+void StructureFactorInput::StructureFactorInputSection::checkParticularValidity()
+{
+  if (has("kmax") && get<Real>("kmax") < 0.0)
+    throw UniformCommunicateError("StructureFactor input: kmax must not be negative");
+}
+
+} // namespace qmcplusplus
@@ -0,0 +1,68 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//
+// Some code refactored from: SkEstimator.h, StaticStructureFactor.h
+//////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef QMCPLUSPLUS_STRUCTUREFACTORINPUT_H
+#define QMCPLUSPLUS_STRUCTUREFACTORINPUT_H
+
+#include "InputSection.h"
+
+namespace qmcplusplus
+{
+
+class StructureFactorEstimator;
+
+/** Native representation for the structure factor estimator input
+ */
+class StructureFactorInput
+{
+public:
+  using Consumer = StructureFactorEstimator;
+  using Real     = QMCTraits::RealType;
+
+  class StructureFactorInputSection : public InputSection
+  {
+  public:
+    // clang-format: off
+    StructureFactorInputSection()
+    {
+      section_name = "StructureFactor";
+      attributes   = {"type", "name", "kmax"};
+      strings      = {"type", "name"};
+      reals        = {"kmax"};
+    }
+    // clang-format: on
+    void checkParticularValidity() override;
+  };
+
+  StructureFactorInput(xmlNodePtr cur);
+  /** default copy constructor
+   *  This is required due to SFI being part of a variant used as a vector element.
+   */
+  StructureFactorInput(const StructureFactorInput&) = default;
+
+private:
+  StructureFactorInputSection input_section_;
+
+  std::string name_{"sk"};
+  std::string type_;
+  /// largest |k| accumulated, 0 for all the k-points of the simulation cell
+  Real kmax_ = 0.0;
+
+public:
+  const std::string& get_name() const { return name_; }
+  const std::string& get_type() const { return type_; }
+  Real get_kmax() const { return kmax_; }
+};
+
+} // namespace qmcplusplus
+#endif
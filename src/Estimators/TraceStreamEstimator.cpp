@@ -0,0 +1,109 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+#include "TraceStreamEstimator.h"
+#include "QMCHamiltonians/QMCHamiltonian.h"
+#include "Particle/Walker.h"
+
+namespace qmcplusplus
+{
+TraceStreamEstimator::TraceStreamEstimator(TraceStreamInput&& input, int rank)
+    : OperatorEstBase(DataLocality::crowd), input_(input)
+{
+  requires_listener_ = true;
+  my_name_           = name_;
+  const std::string filename(makeFilename(rank, input_.get_name()));
+  writer_ = std::make_shared<TraceStreamWriter>(filename, filename + ".idx");
+}
+
+TraceStreamEstimator::TraceStreamEstimator(const TraceStreamEstimator& tse, DataLocality dl)
+    : OperatorEstBase(dl), input_(tse.input_), writer_(tse.writer_), crowd_id_(tse.writer_->makeCrowdId())
+{
+  requires_listener_ = true;
+  my_name_           = tse.name_;
+}
+
+std::string TraceStreamEstimator::makeFilename(int rank, const std::string& name)
+{
+  return "rank_" + std::to_string(rank) + "_" + name + ".trace";
+}
+
+void TraceStreamEstimator::accumulate(const RefVector<MCPWalker>& walkers,
+                                      const RefVector<ParticleSet>& psets,
+                                      const RefVector<TrialWaveFunction>& wfns,
+                                      RandomGenerator& rng)
+{
+  using WP = WalkerProperties::Indexes;
+  // The listeners only know the index of the walker in the crowd, the records carry the walker ID.
+  for (int iw = 0; iw < walkers.size(); ++iw)
+  {
+    const MCPWalker& walker = walkers[iw];
+    for (auto& [component, values] : values_)
+    {
+      if (iw >= values.size())
+        continue;
+      buffer_.assign(values[iw].begin(), values[iw].end());
+      builder_.addRecord(walker.ID, step_, component, buffer_.data(), buffer_.size());
+    }
+    const double weight       = walker.Weight;
+    const double local_energy = walker.Properties(WP::LOCALENERGY);
+    builder_.addRecord(walker.ID, step_, "Weight", &weight, 1);
+    builder_.addRecord(walker.ID, step_, "LocalEnergy", &local_energy, 1);
+  }
+  for (auto& [component, values] : values_)
+    values.clear();
+  ++step_;
+
+  if (builder_.size() >= input_.get_chunk_size())
+  {
+    flushChunk();
+    writer_->tryDrain();
+  }
+}
+
+void TraceStreamEstimator::flushChunk()
+{
+  if (!builder_.empty())
+    writer_->push(builder_.finish(writer_->get_block(), crowd_id_, input_.get_compress()));
+}
+
+std::unique_ptr<OperatorEstBase> TraceStreamEstimator::spawnCrowdClone() const
+{
+  return std::make_unique<TraceStreamEstimator>(*this, data_locality_);
+}
+
+ListenerVector<QMCTraits::RealType>::ReportingFunction TraceStreamEstimator::getLogger()
+{
+  auto& local_values = values_;
+  return [&local_values](const int walker_index, const std::string& name, const Vector<Real>& inputV) {
+    if (walker_index >= local_values[name].size())
+      local_values[name].resize(walker_index + 1);
+    local_values[name][walker_index] = inputV;
+  };
+}
+
+void TraceStreamEstimator::collect(const RefVector<OperatorEstBase>& type_erased_operator_estimators)
+{
+  // called between blocks, none of the crowds is accumulating
+  for (OperatorEstBase& crowd_oeb : type_erased_operator_estimators)
+    dynamic_cast<TraceStreamEstimator&>(crowd_oeb).flushChunk();
+  writer_->endBlock();
+}
+
+void TraceStreamEstimator::registerListeners(QMCHamiltonian& ham_leader)
+{
+  ListenerVector<Real> listener(name_, getLogger());
+  QMCHamiltonian::mw_registerLocalEnergyListener(ham_leader, listener);
+}
+
+void TraceStreamEstimator::startBlock(int steps) { step_ = 0; }
+
+} // namespace qmcplusplus
@@ -0,0 +1,78 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef QMCPLUSPLUS_TRACESTREAMESTIMATOR_H
+#define QMCPLUSPLUS_TRACESTREAMESTIMATOR_H
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include "OperatorEstBase.h"
+#include "TraceStreamInput.h"
+#include "TraceStreamIO.h"
+#include "OhmmsPETE/OhmmsVector.h"
+#include "QMCHamiltonians/Listener.hpp"
+
+namespace qmcplusplus
+{
+/** Streams per walker traces of the batched drivers to a chunked binary file per rank.
+ *
+ *  Each step the crowd clones serialize the per particle Hamiltonian values they listen to,
+ *  the walker weight and local energy into a crowd local chunk. Full chunks are compressed
+ *  in the crowd and queued to the writer of the rank without taking a lock. At the end of a block
+ *  the rank estimator flushes the partial chunks and writes the index entry of the block.
+ *  The files are rank_<rank>_<name>.trace and rank_<rank>_<name>.trace.idx, see TraceStreamIO.h.
+ */
+class TraceStreamEstimator : public OperatorEstBase
+{
+public:
+  using Real      = QMCTraits::RealType;
+  using LogValues = std::unordered_map<std::string, std::vector<Vector<Real>>>;
+
+  TraceStreamEstimator(TraceStreamInput&& input, int rank);
+  TraceStreamEstimator(const TraceStreamEstimator& other, DataLocality data_locality);
+
+  void accumulate(const RefVector<MCPWalker>& walkers,
+                  const RefVector<ParticleSet>& psets,
+                  const RefVector<TrialWaveFunction>& wfns,
+                  RandomGenerator& rng) override;
+
+  UPtr<OperatorEstBase> spawnCrowdClone() const override;
+  void startBlock(int steps) override;
+
+  void registerListeners(QMCHamiltonian& ham_leader) override;
+  /** return lambda function to register as listener
+   *  factored out of registerListeners for unit testing
+   */
+  ListenerVector<Real>::ReportingFunction getLogger();
+
+  /// flush the partial chunks of the crowds and end the block in the trace file
+  void collect(const RefVector<OperatorEstBase>& type_erased_operator_estimators) override;
+
+  /// hand the records collected so far to the writer
+  void flushChunk();
+
+  static std::string makeFilename(int rank, const std::string& name);
+
+private:
+  TraceStreamInput input_;
+  /// shared by the rank estimator and its crowd clones
+  std::shared_ptr<TraceStreamWriter> writer_;
+  int crowd_id_ = 0;
+  int step_     = 0;
+  LogValues values_;
+  TraceChunkBuilder builder_;
+  std::vector<double> buffer_;
+  const std::string name_{"TraceStream"};
+};
+
+} // namespace qmcplusplus
+#endif
@@ -0,0 +1,277 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+#include "TraceStreamIO.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+namespace qmcplusplus
+{
+namespace
+{
+template<typename T>
+void append(std::vector<char>& bytes, const T& value)
+{
+  const char* begin = reinterpret_cast<const char*>(&value);
+  bytes.insert(bytes.end(), begin, begin + sizeof(T));
+}
+
+template<typename T>
+T extract(const std::vector<char>& bytes, std::size_t& pos)
+{
+  if (pos + sizeof(T) > bytes.size())
+    throw std::runtime_error("TraceStreamReader: truncated chunk");
+  T value;
+  std::memcpy(&value, bytes.data() + pos, sizeof(T));
+  pos += sizeof(T);
+  return value;
+}
+
+constexpr char chunk_magic[4] = {'T', 'R', 'C', 'K'};
+} // namespace
+
+void TraceChunkBuilder::addRecord(long walker_id,
+                                  int step,
+                                  const std::string& component,
+                                  const double* values,
+                                  int num_values)
+{
+  auto [it, inserted] = component_ids_.try_emplace(component, static_cast<int>(components_.size()));
+  if (inserted)
+    components_.push_back(component);
+  append<std::int64_t>(records_, walker_id);
+  append<std::int32_t>(records_, step);
+  append<std::int32_t>(records_, it->second);
+  append<std::int32_t>(records_, num_values);
+  const char* begin = reinterpret_cast<const char*>(values);
+  records_.insert(records_.end(), begin, begin + num_values * sizeof(double));
+  ++num_records_;
+}
+
+std::unique_ptr<TraceChunk> TraceChunkBuilder::finish(int block, int crowd, bool compress)
+{
+  std::vector<char> payload;
+  payload.reserve(records_.size() + 64 * components_.size());
+  append<std::uint32_t>(payload, components_.size());
+  for (const std::string& component : components_)
+  {
+    append<std::uint32_t>(payload, component.size());
+    payload.insert(payload.end(), component.begin(), component.end());
+  }
+  append<std::uint64_t>(payload, num_records_);
+  payload.insert(payload.end(), records_.begin(), records_.end());
+
+  auto chunk                = std::make_unique<TraceChunk>();
+  chunk->header.block       = block;
+  chunk->header.crowd       = crowd;
+  chunk->header.raw_size    = payload.size();
+  chunk->header.num_records = num_records_;
+#ifdef HAVE_ZLIB
+  if (compress)
+  {
+    uLongf stored_size = compressBound(payload.size());
+    chunk->bytes.resize(stored_size);
+    if (compress2(reinterpret_cast<Bytef*>(chunk->bytes.data()), &stored_size,
+                  reinterpret_cast<const Bytef*>(payload.data()), payload.size(), Z_BEST_SPEED) == Z_OK &&
+        stored_size < payload.size())
+    {
+      chunk->bytes.resize(stored_size);
+      chunk->header.compression = 1;
+    }
+  }
+#endif
+  if (chunk->header.compression == 0)
+    chunk->bytes = std::move(payload);
+  chunk->header.stored_size = chunk->bytes.size();
+
+  component_ids_.clear();
+  components_.clear();
+  records_.clear();
+  num_records_ = 0;
+  return chunk;
+}
+
+TraceChunkQueue::~TraceChunkQueue() { popAll(); }
+
+void TraceChunkQueue::push(std::unique_ptr<TraceChunk> chunk)
+{
+  TraceChunk* node = chunk.release();
+  node->next       = head_.load(std::memory_order_relaxed);
+  while (!head_.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed))
+    ;
+}
+
+std::vector<std::unique_ptr<TraceChunk>> TraceChunkQueue::popAll()
+{
+  std::vector<std::unique_ptr<TraceChunk>> chunks;
+  TraceChunk* node = head_.exchange(nullptr, std::memory_order_acquire);
+  while (node != nullptr)
+  {
+    TraceChunk* next = node->next;
+    node->next       = nullptr;
+    chunks.emplace_back(node);
+    node = next;
+  }
+  std::reverse(chunks.begin(), chunks.end());
+  return chunks;
+}
+
+TraceStreamWriter::TraceStreamWriter(const std::string& filename, const std::string& index_filename)
+    : file_(filename, std::ios::out | std::ios::binary | std::ios::trunc),
+      index_file_(index_filename, std::ios::out | std::ios::binary | std::ios::trunc)
+{
+  if (!file_ || !index_file_)
+    throw std::runtime_error("TraceStreamWriter: cannot open " + filename + " or " + index_filename);
+  TraceFileHeader header;
+  file_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  index_file_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  position_     = sizeof(header);
+  block_offset_ = position_;
+}
+
+TraceStreamWriter::~TraceStreamWriter()
+{
+  // a partial block is still readable by scanning the file, give it an index entry too
+  drain();
+  if (block_chunks_ > 0)
+    endBlock();
+}
+
+void TraceStreamWriter::push(std::unique_ptr<TraceChunk> chunk) { queue_.push(std::move(chunk)); }
+
+void TraceStreamWriter::tryDrain()
+{
+  if (writing_.test_and_set(std::memory_order_acquire))
+    return;
+  drain();
+  writing_.clear(std::memory_order_release);
+}
+
+void TraceStreamWriter::drain()
+{
+  for (auto& chunk : queue_.popAll())
+  {
+    file_.write(chunk_magic, sizeof(chunk_magic));
+    file_.write(reinterpret_cast<const char*>(&chunk->header), sizeof(TraceChunkHeader));
+    file_.write(chunk->bytes.data(), chunk->bytes.size());
+    position_ += sizeof(chunk_magic) + sizeof(TraceChunkHeader) + chunk->bytes.size();
+    ++block_chunks_;
+  }
+}
+
+void TraceStreamWriter::endBlock()
+{
+  // wait out a producer that is still writing
+  while (writing_.test_and_set(std::memory_order_acquire))
+    ;
+  drain();
+  file_.flush();
+  TraceIndexEntry entry{block_, block_offset_, position_ - block_offset_, block_chunks_};
+  index_file_.write(reinterpret_cast<const char*>(&entry), sizeof(entry));
+  index_file_.flush();
+  ++block_;
+  block_offset_ = position_;
+  block_chunks_ = 0;
+  writing_.clear(std::memory_order_release);
+}
+
+TraceStreamReader::TraceStreamReader(const std::string& filename, const std::string& index_filename)
+    : file_(filename, std::ios::in | std::ios::binary)
+{
+  std::ifstream index_file(index_filename, std::ios::in | std::ios::binary);
+  if (!file_ || !index_file)
+    throw std::runtime_error("TraceStreamReader: cannot open " + filename + " or " + index_filename);
+  TraceFileHeader header;
+  const TraceFileHeader expected;
+  file_.read(reinterpret_cast<char*>(&header), sizeof(header));
+  if (!file_ || std::memcmp(header.magic, expected.magic, sizeof(header.magic)) != 0 ||
+      header.version != expected.version || header.value_size != sizeof(double))
+    throw std::runtime_error("TraceStreamReader: " + filename + " is not a trace file of this version");
+  index_file.read(reinterpret_cast<char*>(&header), sizeof(header));
+  TraceIndexEntry entry;
+  while (index_file.read(reinterpret_cast<char*>(&entry), sizeof(entry)))
+    index_.push_back(entry);
+}
+
+std::vector<TraceStreamReader::Record> TraceStreamReader::readBlock(int block)
+{
+  auto entry = std::find_if(index_.begin(), index_.end(), [block](auto& e) { return e.block == block; });
+  if (entry == index_.end())
+    throw std::runtime_error("TraceStreamReader: block " + std::to_string(block) + " is not in the index");
+
+  std::vector<Record> records;
+  file_.clear();
+  file_.seekg(entry->offset);
+  for (int ichunk = 0; ichunk < entry->num_chunks; ++ichunk)
+  {
+    char magic[sizeof(chunk_magic)];
+    TraceChunkHeader header;
+    file_.read(magic, sizeof(magic));
+    file_.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!file_ || std::memcmp(magic, chunk_magic, sizeof(magic)) != 0)
+      throw std::runtime_error("TraceStreamReader: corrupt chunk header");
+    std::vector<char> stored(header.stored_size);
+    file_.read(stored.data(), stored.size());
+
+    std::vector<char> payload;
+    if (header.compression == 0)
+      payload = std::move(stored);
+    else
+    {
+#ifdef HAVE_ZLIB
+      payload.resize(header.raw_size);
+      uLongf raw_size = header.raw_size;
+      if (uncompress(reinterpret_cast<Bytef*>(payload.data()), &raw_size,
+                     reinterpret_cast<const Bytef*>(stored.data()), stored.size()) != Z_OK ||
+          raw_size != header.raw_size)
+        throw std::runtime_error("TraceStreamReader: failed to decompress a chunk");
+#else
+      throw std::runtime_error("TraceStreamReader: compressed chunk but QMCPACK was built without zlib");
+#endif
+    }
+
+    std::size_t pos = 0;
+    std::vector<std::string> components(extract<std::uint32_t>(payload, pos));
+    for (auto& component : components)
+    {
+      const auto length = extract<std::uint32_t>(payload, pos);
+      if (pos + length > payload.size())
+        throw std::runtime_error("TraceStreamReader: truncated chunk");
+      component.assign(payload.data() + pos, length);
+      pos += length;
+    }
+    const auto num_records = extract<std::uint64_t>(payload, pos);
+    for (std::uint64_t irec = 0; irec < num_records; ++irec)
+    {
+      Record record;
+      record.walker_id      = extract<std::int64_t>(payload, pos);
+      record.step           = extract<std::int32_t>(payload, pos);
+      const auto component  = extract<std::int32_t>(payload, pos);
+      const auto num_values = extract<std::int32_t>(payload, pos);
+      if (component < 0 || component >= components.size() || num_values < 0 ||
+          pos + num_values * sizeof(double) > payload.size())
+        throw std::runtime_error("TraceStreamReader: corrupt record");
+      record.component = components[component];
+      record.values.resize(num_values);
+      std::memcpy(record.values.data(), payload.data() + pos, num_values * sizeof(double));
+      pos += num_values * sizeof(double);
+      records.push_back(std::move(record));
+    }
+  }
+  return records;
+}
+
+} // namespace qmcplusplus
@@ -0,0 +1,174 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+/** @file
+ *  Chunked binary trace files written by TraceStreamEstimator.
+ *
+ *  A trace file starts with a TraceFileHeader followed by chunks. Each chunk is a TraceChunkHeader followed by its
+ *  payload, zlib compressed if the header says so. A payload is self contained:
+ *    uint32 number of component names, for each: uint32 length, the characters
+ *    uint64 number of records, for each:
+ *      int64 walker id, int32 step, int32 component, int32 number of values, the values as doubles
+ *  All the chunks of a block are contiguous in the file. The index file next to it has one TraceIndexEntry
+ *  per block so a reader can seek to any block without scanning the file.
+ */
+
+#ifndef QMCPLUSPLUS_TRACESTREAMIO_H
+#define QMCPLUSPLUS_TRACESTREAMIO_H
+
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace qmcplusplus
+{
+struct TraceFileHeader
+{
+  char magic[8]         = {'Q', 'M', 'C', 'T', 'R', 'A', 'C', 'E'};
+  std::uint32_t version = 1;
+  /// size of the stored values, always double
+  std::uint32_t value_size = sizeof(double);
+};
+
+struct TraceChunkHeader
+{
+  std::int32_t block = 0;
+  std::int32_t crowd = 0;
+  /// 0 raw, 1 zlib
+  std::uint32_t compression = 0;
+  std::uint32_t padding     = 0;
+  std::uint64_t raw_size    = 0;
+  std::uint64_t stored_size = 0;
+  std::uint64_t num_records = 0;
+};
+
+struct TraceIndexEntry
+{
+  std::int64_t block       = 0;
+  std::uint64_t offset     = 0;
+  std::uint64_t bytes      = 0;
+  std::uint64_t num_chunks = 0;
+};
+
+struct TraceChunk
+{
+  TraceChunkHeader header;
+  std::vector<char> bytes;
+  /// intrusive link of TraceChunkQueue
+  TraceChunk* next = nullptr;
+};
+
+/** Crowd local serialization of the records of one chunk
+ */
+class TraceChunkBuilder
+{
+public:
+  void addRecord(long walker_id, int step, const std::string& component, const double* values, int num_values);
+
+  /// size of the serialized records
+  std::size_t size() const { return records_.size(); }
+  bool empty() const { return num_records_ == 0; }
+
+  /** serialize the payload into a chunk, compressed if requested and smaller, and reset the builder
+   */
+  std::unique_ptr<TraceChunk> finish(int block, int crowd, bool compress);
+
+private:
+  std::unordered_map<std::string, int> component_ids_;
+  std::vector<std::string> components_;
+  std::vector<char> records_;
+  std::uint64_t num_records_ = 0;
+};
+
+/** Lock-free multiple producer single consumer queue of chunks.
+ *
+ *  push is a CAS on the head of an intrusive stack, the consumer takes the whole stack at once
+ *  and reverses it so chunks pushed by one producer keep their order.
+ */
+class TraceChunkQueue
+{
+public:
+  ~TraceChunkQueue();
+  void push(std::unique_ptr<TraceChunk> chunk);
+  std::vector<std::unique_ptr<TraceChunk>> popAll();
+
+private:
+  std::atomic<TraceChunk*> head_{nullptr};
+};
+
+/** Appends the chunks of all the crowds of a rank to one trace file.
+ *
+ *  Producers push complete chunks and then try to drain the queue. Only the thread that wins the
+ *  writing flag writes, the others return immediately, so no producer ever waits on the file.
+ *  endBlock is called from a single thread and writes the index entry of the block.
+ */
+class TraceStreamWriter
+{
+public:
+  TraceStreamWriter(const std::string& filename, const std::string& index_filename);
+  ~TraceStreamWriter();
+
+  /// thread safe
+  void push(std::unique_ptr<TraceChunk> chunk);
+  /// write the queued chunks unless another thread is already writing
+  void tryDrain();
+  /// drain the queue and write the index entry of the current block, not thread safe
+  void endBlock();
+
+  int get_block() const { return block_; }
+  int makeCrowdId() { return next_crowd_id_++; }
+
+private:
+  void drain();
+
+  std::ofstream file_;
+  std::ofstream index_file_;
+  TraceChunkQueue queue_;
+  std::atomic_flag writing_ = ATOMIC_FLAG_INIT;
+  std::atomic<int> next_crowd_id_{0};
+  int block_ = 0;
+  /// file position and chunk count of the current block
+  std::uint64_t block_offset_ = 0;
+  std::uint64_t position_     = 0;
+  std::uint64_t block_chunks_ = 0;
+};
+
+/** Reads trace files for post-processing and tests.
+ */
+class TraceStreamReader
+{
+public:
+  struct Record
+  {
+    long walker_id;
+    int step;
+    std::string component;
+    std::vector<double> values;
+  };
+
+  TraceStreamReader(const std::string& filename, const std::string& index_filename);
+
+  const std::vector<TraceIndexEntry>& get_index() const { return index_; }
+
+  /// read all the records of a block, seeking with the index
+  std::vector<Record> readBlock(int block);
+
+private:
+  std::ifstream file_;
+  std::vector<TraceIndexEntry> index_;
+};
+
+} // namespace qmcplusplus
+#endif
@@ -0,0 +1,35 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+#include "EstimatorInput.h"
+#include "TraceStreamInput.h"
+
+namespace qmcplusplus
+{
+
+TraceStreamInput::TraceStreamInput(xmlNodePtr cur)
+{
+  // This results in checkParticularValidity being called on TraceStreamInputSection
+  input_section_.readXML(cur);
+  auto setIfInInput = LAMBDA_setIfInInput;
+  setIfInInput(name_, "name");
+  setIfInInput(type_, "type");
+  setIfInInput(chunk_size_, "chunk_size");
+  setIfInInput(compress_, "compress");
+}
+
+void TraceStreamInput::TraceStreamInputSection::checkParticularValidity()
+{
+  if (has("chunk_size") && get<int>("chunk_size") <= 0)
+    throw UniformCommunicateError("TraceStream input: chunk_size must be positive");
+}
+
+} // namespace qmcplusplus
@@ -0,0 +1,69 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef QMCPLUSPLUS_TRACESTREAMINPUT_H
+#define QMCPLUSPLUS_TRACESTREAMINPUT_H
+
+#include "InputSection.h"
+
+namespace qmcplusplus
+{
+
+class TraceStreamEstimator;
+
+/** Native representation for the binary trace stream input
+ */
+class TraceStreamInput
+{
+public:
+  using Consumer = TraceStreamEstimator;
+
+  class TraceStreamInputSection : public InputSection
+  {
+  public:
+    // clang-format: off
+    TraceStreamInputSection()
+    {
+      section_name = "TraceStream";
+      attributes   = {"type", "name", "chunk_size", "compress"};
+      strings      = {"type", "name"};
+      integers     = {"chunk_size"};
+      bools        = {"compress"};
+    }
+    // clang-format: on
+    void checkParticularValidity() override;
+  };
+
+  TraceStreamInput(xmlNodePtr cur);
+  /** default copy constructor
+   *  This is required due to TSI being part of a variant used as a vector element.
+   */
+  TraceStreamInput(const TraceStreamInput&) = default;
+
+private:
+  TraceStreamInputSection input_section_;
+
+  std::string name_{"trace_stream"};
+  std::string type_;
+  /// bytes of records a crowd collects before it hands a chunk to the writer
+  int chunk_size_ = 1 << 20;
+  /// zlib compress the chunks, ignored without zlib
+  bool compress_ = true;
+
+public:
+  const std::string& get_name() const { return name_; }
+  const std::string& get_type() const { return type_; }
+  int get_chunk_size() const { return chunk_size_; }
+  bool get_compress() const { return compress_; }
+};
+
+} // namespace qmcplusplus
+#endif
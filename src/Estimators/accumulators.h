@@ -65,6 +65,28 @@ struct accumulator_set
     properties[WEIGHT] += w;
   }
 
+  /** add n weighted samples
+   * @param x values
+   * @param w weights
+   * @param n number of samples
+   *
+   * The sums are reduced locally first so that the loop is a plain vectorizable reduction.
+   */
+  inline void operator()(const value_type* x, const value_type* w, size_t n)
+  {
+    value_type v(0), vv(0), ww(0);
+    for (size_t i = 0; i < n; ++i)
+    {
+      const value_type wx = w[i] * x[i];
+      v += wx;
+      vv += wx * x[i];
+      ww += w[i];
+    }
+    properties[VALUE] += v;
+    properties[VALUESQ] += vv;
+    properties[WEIGHT] += ww;
+  }
+
   /** reset properties
    * @param v cummulative value
    * @param vv cummulative valuesq
@@ -26,11 +26,12 @@ namespace onebodydensitymatrices
   {
     valid_obdm_input = 0,
     valid_obdm_input_scale,
-    valid_obdm_input_grid
+    valid_obdm_input_grid,
+    valid_obdm_input_batched
   };
 
   // clang-format: off
-  constexpr std::array<std::string_view, 3> valid_one_body_density_matrices_input_sections{
+  constexpr std::array<std::string_view, 4> valid_one_body_density_matrices_input_sections{
       R"XML(
 <estimator type="OneBodyDensityMatrices" name="OneBodyDensityMatrices">
   <parameter name="basis"        >  spo_ud spo_dm </parameter>
@@ -63,6 +64,17 @@ namespace onebodydensitymatrices
   <parameter name="timestep"     >  0.5           </parameter>
   <parameter name="use_drift"    >  no            </parameter>
 </estimator>
+)XML",
+      R"XML(
+<estimator type="OneBodyDensityMatrices" name="OneBodyDensityMatrices">
+  <parameter name="basis"        >  spo_ud spo_dm </parameter>
+  <parameter name="evaluator"    >  batched       </parameter>
+  <parameter name="integrator"   >  uniform_grid  </parameter>
+  <parameter name="points"       >  22            </parameter>
+  <parameter name="scale"        >  0.8           </parameter>
+  <parameter name="timestep"     >  0.5           </parameter>
+  <parameter name="use_drift"    >  no            </parameter>
+</estimator>
 )XML"
   // clang-format: on
   };
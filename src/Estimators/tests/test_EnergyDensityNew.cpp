@@ -0,0 +1,222 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "EnergyDensityInput.h"
+#include "EnergyDensityNew.h"
+#include "SpaceGridInput.h"
+#include "SpaceGridNew.h"
+#include "ParticleSet.h"
+#include "TrialWaveFunction.h"
+#include "EstimatorTesting.h"
+#include "OhmmsData/Libxml2Doc.h"
+#include "Message/UniformCommunicateError.h"
+
+namespace qmcplusplus
+{
+namespace testing
+{
+// clang-format: off
+constexpr std::string_view valid_energy_density_input{R"XML(
+<estimator type="EnergyDensity" name="EDcell" dynamic="e">
+  <spacegrid coord="cartesian">
+    <origin p1="zero"/>
+    <axis p1="a1" scale=".5" label="x" grid="-0.8 (0.8) 0.8"/>
+    <axis p1="a2" scale=".5" label="y" grid="-0.8 (0.8) 0.8"/>
+    <axis p1="a3" scale=".5" label="z" grid="-0.8 (0.8) 0.8"/>
+  </spacegrid>
+  <spacegrid coord="spherical">
+    <origin p1="zero"/>
+    <axis p1="a1" scale=".5" label="r" grid="0 (0.5) 1"/>
+    <axis p1="a2" scale=".5" label="phi" grid="0 1"/>
+    <axis p1="a3" scale=".5" label="theta" grid="0 1"/>
+  </spacegrid>
+</estimator>
+)XML"};
+// clang-format: on
+
+class EnergyDensityNewTests
+{
+public:
+  using Real = EnergyDensityNew::Real;
+  static auto getKineticListener(EnergyDensityNew& ed) { return EnergyDensityNew::getListener(ed.kinetic_values_); }
+  static auto getPotentialListener(EnergyDensityNew& ed)
+  {
+    return EnergyDensityNew::getListener(ed.potential_values_);
+  }
+};
+} // namespace testing
+
+TEST_CASE("SpaceGridInput::parseGrid", "[estimators]")
+{
+  SpaceGridInput::AxisGrid uniform = SpaceGridInput::parseGrid("0 (0.1) 1");
+  CHECK(uniform.dimension == 10);
+  CHECK(uniform.odu == Approx(10.0));
+  CHECK(uniform.gmap.size() == 10);
+
+  SpaceGridInput::AxisGrid counted = SpaceGridInput::parseGrid("-1 (4) 1");
+  CHECK(counted.dimension == 4);
+  CHECK(counted.umin == Approx(-1.0));
+  CHECK(counted.odu == Approx(2.0));
+
+  SpaceGridInput::AxisGrid mixed = SpaceGridInput::parseGrid("0 (0.1) 0.4 (0.2) 1");
+  CHECK(mixed.dimension == 7);
+  CHECK(mixed.gmap == std::vector<int>{0, 1, 2, 3, 4, 4, 5, 5, 6, 6});
+  CHECK(mixed.ndu_per_domain == std::vector<int>{1, 1, 1, 1, 2, 2, 2});
+
+  CHECK_THROWS_AS(SpaceGridInput::parseGrid("1 0"), UniformCommunicateError);
+  CHECK_THROWS_AS(SpaceGridInput::parseGrid("0 (0.3) 1"), UniformCommunicateError);
+  CHECK_THROWS_AS(SpaceGridInput::parseGrid("0 (0.1) 0.5 (0.25) 1"), UniformCommunicateError);
+}
+
+TEST_CASE("EnergyDensityInput", "[estimators]")
+{
+  Libxml2Document doc;
+  bool okay = doc.parseFromString(testing::valid_energy_density_input);
+  REQUIRE(okay);
+  EnergyDensityInput edi(doc.getRoot());
+  CHECK(edi.get_name() == "EDcell");
+  CHECK(edi.get_dynamic() == "e");
+  CHECK(edi.get_static().empty());
+  REQUIRE(edi.get_space_grid_inputs().size() == 2);
+  CHECK(edi.get_space_grid_inputs()[1].get_coord() == SpaceGridInput::Coord::SPHERICAL);
+
+  std::string_view no_grid{R"XML(<estimator type="EnergyDensity" name="ED" dynamic="e"/>)XML"};
+  okay = doc.parseFromString(no_grid);
+  REQUIRE(okay);
+  CHECK_THROWS_AS(EnergyDensityInput(doc.getRoot()), UniformCommunicateError);
+}
+
+TEST_CASE("EnergyDensityNew::accumulate", "[estimators]")
+{
+  using MCPWalker = OperatorEstBase::MCPWalker;
+  using Real      = EnergyDensityNew::Real;
+
+  Libxml2Document doc;
+  bool okay = doc.parseFromString(testing::valid_energy_density_input);
+  REQUIRE(okay);
+  EnergyDensityInput edi(doc.getRoot());
+
+  const SimulationCell simulation_cell(testing::makeTestLattice());
+  const auto& lattice = simulation_cell.getLattice();
+  ParticleSet pset_golden(simulation_cell);
+  pset_golden.setName("e");
+  pset_golden.create({3});
+  EnergyDensityNew ed(std::move(edi), pset_golden);
+
+  const auto& grids = ed.get_space_grids();
+  REQUIRE(grids.size() == 2);
+  CHECK(grids[0].getNumDomains() == 8);
+  CHECK(grids[1].getNumDomains() == 2);
+  // the cartesian grid covers 0.8^3 of the cell
+  CHECK(grids[0].getVolume() == Approx(0.512 * lattice.Volume));
+  Real domain_volume_sum = 0.0;
+  for (int i = 0; i < grids[0].getNumDomains(); ++i)
+    domain_volume_sum += grids[0].getDomainVolumes()(i, 0);
+  CHECK(domain_volume_sum == Approx(grids[0].getVolume()));
+  CHECK(ed.get_outside_offset() == 30);
+  CHECK(ed.get_data().size() == 33);
+
+  std::vector<MCPWalker> walkers;
+  std::vector<ParticleSet> psets;
+  const int nwalkers = 2;
+  for (int iw = 0; iw < nwalkers; ++iw)
+  {
+    walkers.emplace_back(3);
+    walkers.back().Weight = 1.0 + iw;
+    psets.emplace_back(simulation_cell);
+    ParticleSet& pset = psets.back();
+    pset.create({3});
+    // cartesian domain 7 and spherical domain 1
+    pset.R[0] = lattice.toCart(ParticleSet::PosType(0.25, 0.25, 0.25));
+    // cartesian domain 2 and spherical domain 1, shifted by a lattice vector
+    pset.R[1] = lattice.toCart(ParticleSet::PosType(-0.25, 1.25, -0.25));
+    // outside of both grids
+    pset.R[2] = lattice.toCart(ParticleSet::PosType(0.45, 0.45, 0.45));
+  }
+  std::vector<TrialWaveFunction> wfns;
+  auto ref_walkers = makeRefVector<MCPWalker>(walkers);
+  auto ref_psets   = makeRefVector<ParticleSet>(psets);
+  auto ref_wfns    = makeRefVector<TrialWaveFunction>(wfns);
+  RandomGenerator rng;
+
+  // two Hamiltonian evaluations before the accumulate, only the last one is sampled
+  auto kinetic_listener   = testing::EnergyDensityNewTests::getKineticListener(ed);
+  auto potential_listener = testing::EnergyDensityNewTests::getPotentialListener(ed);
+  Vector<Real> stale(3, 100.0);
+  Vector<Real> kinetic(3);
+  Vector<Real> ee_potential(3, 0.5);
+  Vector<Real> ecp_potential(3, 1.0);
+  for (int ip = 0; ip < 3; ++ip)
+    kinetic[ip] = ip + 1;
+  for (int iw = 0; iw < nwalkers; ++iw)
+  {
+    kinetic_listener(iw, "Kinetic", stale);
+    potential_listener(iw, "ElecElec", stale);
+    potential_listener(iw, "LocalECP", stale);
+  }
+  for (int iw = 0; iw < nwalkers; ++iw)
+  {
+    kinetic_listener(iw, "Kinetic", kinetic);
+    potential_listener(iw, "ElecElec", ee_potential);
+    potential_listener(iw, "LocalECP", ecp_potential);
+  }
+
+  ed.accumulate(ref_walkers, ref_psets, ref_wfns, rng);
+
+  auto& data = ed.get_data();
+  using ED   = EnergyDensityNew;
+  CHECK(data[7 * ED::nEDValues + ED::W] == Approx(3.0));
+  CHECK(data[2 * ED::nEDValues + ED::W] == Approx(3.0));
+  CHECK(data[24 + 1 * ED::nEDValues + ED::W] == Approx(6.0));
+  CHECK(data[ed.get_outside_offset() + ED::W] == Approx(3.0));
+  Real total_weight = 0.0;
+  for (int i = 0; i < 8; ++i)
+    total_weight += data[i * ED::nEDValues + ED::W];
+  CHECK(total_weight == Approx(6.0));
+  CHECK(ed.get_walkers_weight() == Approx(3.0));
+
+  // weighted sums over the walkers of weight 1 and 2
+  CHECK(data[7 * ED::nEDValues + ED::T] == Approx(3.0));
+  CHECK(data[7 * ED::nEDValues + ED::V] == Approx(4.5));
+  CHECK(data[2 * ED::nEDValues + ED::T] == Approx(6.0));
+  CHECK(data[2 * ED::nEDValues + ED::V] == Approx(4.5));
+  CHECK(data[24 + 1 * ED::nEDValues + ED::T] == Approx(9.0));
+  CHECK(data[24 + 1 * ED::nEDValues + ED::V] == Approx(9.0));
+  CHECK(data[ed.get_outside_offset() + ED::T] == Approx(9.0));
+  CHECK(data[ed.get_outside_offset() + ED::V] == Approx(4.5));
+}
+
+TEST_CASE("EnergyDensityNew::getListener", "[estimators]")
+{
+  using Real = EnergyDensityNew::Real;
+  EnergyDensityNew::OperatorValues values;
+  auto listener = EnergyDensityNew::getListener(values);
+  Vector<Real> reported(3);
+  reported[0] = 1.0;
+  reported[1] = 2.0;
+  reported[2] = 3.0;
+  // two operators report for walker 1
+  listener(1, "Coulomb", reported);
+  listener(1, "LocalECP", reported);
+  REQUIRE(values.size() == 2);
+  REQUIRE(values["Coulomb"].size() == 2);
+  CHECK(values["Coulomb"][0].size() == 0);
+  CHECK(values["Coulomb"][1][2] == Approx(3.0));
+  // a second evaluation overwrites the values of the operator
+  reported[2] = 5.0;
+  listener(1, "Coulomb", reported);
+  CHECK(values["Coulomb"][1][2] == Approx(5.0));
+  CHECK(values["LocalECP"][1][2] == Approx(3.0));
+}
+
+} // namespace qmcplusplus
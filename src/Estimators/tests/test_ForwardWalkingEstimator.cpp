@@ -0,0 +1,137 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "ForwardWalkingInput.h"
+#include "ForwardWalkingEstimator.h"
+#include "Particle/WalkerAncestry.h"
+#include "QMCDrivers/WalkerProperties.h"
+#include "QMCHamiltonians/QMCHamiltonian.h"
+#include "OhmmsData/Libxml2Doc.h"
+#include "Message/Communicate.h"
+#include "Message/UniformCommunicateError.h"
+
+namespace qmcplusplus
+{
+
+TEST_CASE("ForwardWalkingInput", "[estimators]")
+{
+  Libxml2Document doc;
+  bool okay = doc.parseFromString(
+      R"XML(<estimator type="ForwardWalking" name="fw" observables="LocalEnergy LocalPotential" steps="100 0 50 50"/>)XML");
+  REQUIRE(okay);
+  ForwardWalkingInput fwi(doc.getRoot());
+  CHECK(fwi.get_name() == "fw");
+  CHECK(fwi.get_observables() == std::vector<std::string>{"LocalEnergy", "LocalPotential"});
+  CHECK(fwi.get_steps() == std::vector<int>{0, 50, 100});
+
+  okay = doc.parseFromString(R"XML(<estimator type="ForwardWalking" observables="LocalEnergy"/>)XML");
+  REQUIRE(okay);
+  CHECK_THROWS_AS(ForwardWalkingInput(doc.getRoot()), UniformCommunicateError);
+  okay = doc.parseFromString(R"XML(<estimator type="ForwardWalking" observables="LocalEnergy" steps="10 -1"/>)XML");
+  REQUIRE(okay);
+  CHECK_THROWS_AS(ForwardWalkingInput(doc.getRoot()), UniformCommunicateError);
+}
+
+TEST_CASE("ForwardWalkingEstimator::collect", "[estimators]")
+{
+  using MCPWalker = OperatorEstBase::MCPWalker;
+  using WP        = WalkerProperties::Indexes;
+
+  QMCHamiltonian ham;
+  Libxml2Document doc;
+  bool okay = doc.parseFromString(R"XML(<estimator type="ForwardWalking" observables="NotThere" steps="0"/>)XML");
+  REQUIRE(okay);
+  CHECK_THROWS_AS(ForwardWalkingEstimator(ForwardWalkingInput(doc.getRoot()), ham), UniformCommunicateError);
+
+  okay = doc.parseFromString(R"XML(<estimator type="ForwardWalking" observables="LocalEnergy" steps="0 1 2"/>)XML");
+  REQUIRE(okay);
+  ForwardWalkingEstimator rank_fwe(ForwardWalkingInput(doc.getRoot()), ham);
+  CHECK(rank_fwe.isAncestryRequired());
+  UPtrVector<OperatorEstBase> crowd_fwes;
+  crowd_fwes.emplace_back(rank_fwe.spawnCrowdClone());
+  WalkerAncestry ancestry;
+  ancestry.enable();
+  rank_fwe.registerAncestry(ancestry);
+
+  std::vector<MCPWalker> walkers;
+  for (int iw = 0; iw < 3; ++iw)
+    walkers.emplace_back(2);
+  std::vector<ParticleSet> psets;
+  std::vector<TrialWaveFunction> wfns;
+  auto ref_psets = makeRefVector<ParticleSet>(psets);
+  auto ref_wfns  = makeRefVector<TrialWaveFunction>(wfns);
+  RandomGenerator rng;
+
+  auto step = [&](const std::vector<long>& ids, const std::vector<double>& energies) {
+    for (int iw = 0; iw < ids.size(); ++iw)
+    {
+      walkers[iw].ID                          = ids[iw];
+      walkers[iw].Properties(WP::LOCALENERGY) = energies[iw];
+    }
+    auto ref_walkers = makeRefVector<MCPWalker>(walkers);
+    crowd_fwes[0]->accumulate(ref_walkers, ref_psets, ref_wfns, rng);
+  };
+
+  // generation 0, 1 is copied to 4 and 3 dies
+  step({1, 2, 3}, {1.0, 2.0, 3.0});
+  ancestry.recordCopy(4, 1);
+  ancestry.recordDeath(3);
+  ancestry.endGeneration();
+  // generation 1, 4 is copied to 5 and 2 dies
+  step({1, 2, 4}, {10.0, 20.0, 40.0});
+  ancestry.recordCopy(5, 4);
+  ancestry.recordDeath(2);
+  ancestry.endGeneration();
+  // generation 2, no branching event
+  step({1, 4, 5}, {100.0, 400.0, 500.0});
+  ancestry.endGeneration();
+  ancestry.synchronize(*OHMMS::Controller);
+
+  rank_fwe.collect(convertUPtrToRefVector(crowd_fwes));
+  auto& data = rank_fwe.get_data();
+  REQUIRE(data.size() == 6);
+  // tau = 0 is the mixed estimate over the three generations
+  CHECK(data[0] == Approx(9.0));
+  CHECK(data[3] == Approx(2 * 1.0 + 2.0 + 10.0 + 2 * 40.0 + 1000.0));
+  // tau = 1 for generations 0 and 1, all the descendants of generation 0 are 1's
+  CHECK(data[1] == Approx(6.0));
+  CHECK(data[4] == Approx(3 * 1.0 + 10.0 + 2 * 40.0));
+  // tau = 2 for generation 0 only
+  CHECK(data[2] == Approx(3.0));
+  CHECK(data[5] == Approx(3.0));
+  CHECK(rank_fwe.get_walkers_weight() == Approx(9.0));
+  // generations 1 and 2 wait for tau = 2
+  CHECK(rank_fwe.get_num_pending_generations() == 2);
+  CHECK(ancestry.get_first_generation() == 1);
+
+  rank_fwe.normalize(1.0);
+  CHECK(data[0] == Approx(9.0));
+  CHECK(data[3] == Approx(1094.0 / 9.0));
+  CHECK(data[4] == Approx(93.0 / 6.0));
+  CHECK(data[5] == Approx(1.0));
+
+  // one more generation completes tau = 1 of generation 2 and tau = 2 of generation 1
+  rank_fwe.zero();
+  step({1, 4, 5}, {0.0, 0.0, 0.0});
+  ancestry.endGeneration();
+  ancestry.synchronize(*OHMMS::Controller);
+  rank_fwe.collect(convertUPtrToRefVector(crowd_fwes));
+  CHECK(data[0] == Approx(3.0));
+  CHECK(data[1] == Approx(3.0));
+  CHECK(data[4] == Approx(1000.0));
+  CHECK(data[2] == Approx(3.0));
+  CHECK(data[5] == Approx(10.0 + 2 * 40.0));
+  CHECK(rank_fwe.get_num_pending_generations() == 2);
+}
+
+} // namespace qmcplusplus
@@ -190,6 +190,30 @@ public:
       checkData(returned_data.data(), data.data(), data.size());
   }
 
+  /** the batched evaluator must give the sum of evaluateMatrix over the walkers
+   *  when each walker is given the samples of the crowd.
+   */
+  void testAccumulateBatched(OneBodyDensityMatrices& obdm_batched,
+                             OneBodyDensityMatrices& obdm_matrix,
+                             RefVector<MCPWalker>& walkers,
+                             RefVector<ParticleSet>& psets,
+                             RefVector<TrialWaveFunction>& twfcs,
+                             StdRandom<T>& rng)
+  {
+    rng.init(101);
+    obdm_batched.implAccumulateBatched(walkers, psets, twfcs, rng);
+    Real walkers_weight = 0.0;
+    for (int iw = 0; iw < walkers.size(); ++iw)
+    {
+      rng.init(101);
+      obdm_matrix.evaluateMatrix(psets[iw], twfcs[iw], walkers[iw], rng);
+      walkers_weight += walkers[iw].get().Weight;
+    }
+    CHECK(obdm_batched.walkers_weight_ == Approx(walkers_weight));
+    REQUIRE(obdm_batched.data_.size() == obdm_matrix.data_.size());
+    checkData(obdm_matrix.data_.data(), obdm_batched.data_.data(), obdm_matrix.data_.size());
+  }
+
   void dumpData(OneBodyDensityMatrices& obdm)
   {
     std::cout << "Here is what is in your OneBodyDensityMatrices:\n" << NativePrint(obdm.data_) << '\n';
@@ -450,6 +474,75 @@ TEST_CASE("OneBodyDensityMatrices::evaluateMatrix", "[estimators]")
   }
 }
 
+TEST_CASE("OneBodyDensityMatrices::accumulate batched", "[estimators]")
+{
+  using namespace testing;
+  using namespace onebodydensitymatrices;
+  using MCPWalker = OperatorEstBase::MCPWalker;
+
+  Communicate* comm;
+  comm = OHMMS::Controller;
+
+  auto makeInput = [](Inputs input) {
+    Libxml2Document doc;
+    bool okay = doc.parseFromString(valid_one_body_density_matrices_input_sections[input]);
+    if (!okay)
+      throw std::runtime_error("cannot parse OneBodyDensitMatricesInput section");
+    return OneBodyDensityMatricesInput(doc.getRoot());
+  };
+  OneBodyDensityMatricesInput obdmi_batched = makeInput(valid_obdm_input_batched);
+  OneBodyDensityMatricesInput obdmi_matrix  = makeInput(valid_obdm_input_grid);
+  CHECK(obdmi_batched.get_evaluator() == OBDMI::Evaluator::BATCHED);
+
+  auto particle_pool     = MinimalParticlePool::make_diamondC_1x1x1(comm);
+  auto wavefunction_pool = MinimalWaveFunctionPool::make_diamondC_1x1x1(comm, particle_pool);
+  auto& spomap           = wavefunction_pool.getWaveFunction("wavefunction")->getSPOMap();
+  auto& pset_target      = *(particle_pool.getParticleSet("e"));
+  auto& species_set      = pset_target.getSpeciesSet();
+  OneBodyDensityMatrices obdm_batched(std::move(obdmi_batched), pset_target.getLattice(), species_set, spomap,
+                                      pset_target);
+  OneBodyDensityMatrices obdm_matrix(std::move(obdmi_matrix), pset_target.getLattice(), species_set, spomap,
+                                     pset_target);
+
+  // Known positions for the first walker, the others are displaced copies of it.
+  pset_target.R = ParticleSet::ParticlePos{
+      {4.120557308, 2.547962427, 2.11555481},   {2.545657158, 2.021627665, 3.17555666},
+      {1.251996636, 1.867651463, 0.7268046737}, {4.749059677, 5.845647812, 3.871560574},
+      {5.18129015, 4.168475151, 2.748870373},   {6.24560833, 4.087143421, 4.187825203},
+      {3.173382998, 3.651777267, 2.970916748},  {1.576967478, 2.874752045, 3.687536716},
+  };
+
+  const int nwalkers = 3;
+  std::vector<ParticleSet> psets(nwalkers, pset_target);
+  for (int iw = 0; iw < nwalkers; ++iw)
+    for (int ip = 0; ip < psets[iw].getTotalNum(); ++ip)
+      psets[iw].R[ip] += ParticleSet::SingleParticlePos(0.3 * iw, -0.2 * iw, 0.1 * iw * ip);
+
+  auto& trial_wavefunction = *(wavefunction_pool.getPrimary());
+  std::vector<UPtr<TrialWaveFunction>> twfcs(nwalkers);
+  for (int iw = 0; iw < nwalkers; ++iw)
+    twfcs[iw] = trial_wavefunction.makeClone(psets[iw]);
+
+  std::vector<MCPWalker> walkers;
+  for (int iw = 0; iw < nwalkers; ++iw)
+  {
+    walkers.emplace_back(8);
+    psets[iw].update(true);
+    psets[iw].donePbyP();
+    twfcs[iw]->evaluateLog(psets[iw]);
+    psets[iw].saveWalker(walkers[iw]);
+    walkers[iw].Weight = 1.0 - 0.25 * iw;
+  }
+
+  auto ref_walkers(makeRefVector<MCPWalker>(walkers));
+  auto ref_psets(makeRefVector<ParticleSet>(psets));
+  auto ref_twfcs(convertUPtrToRefVector(twfcs));
+
+  StdRandom<double> rng;
+  OneBodyDensityMatricesTests<double> obdmt;
+  obdmt.testAccumulateBatched(obdm_batched, obdm_matrix, ref_walkers, ref_psets, ref_twfcs, rng);
+}
+
 namespace testing
 {
 // The test result data is defined down here for readability of the test code.
@@ -0,0 +1,148 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "PairCorrelationInput.h"
+#include "PairCorrelationEstimator.h"
+#include "ParticleSet.h"
+#include "TrialWaveFunction.h"
+#include "OhmmsData/Libxml2Doc.h"
+#include "Message/UniformCommunicateError.h"
+
+namespace qmcplusplus
+{
+
+TEST_CASE("PairCorrelationInput", "[estimators]")
+{
+  Libxml2Document doc;
+  bool okay = doc.parseFromString(R"XML(<estimator type="gofr" name="gofr_e" rmax="3.0" dr="0.1" sources="ion0"/>)XML");
+  REQUIRE(okay);
+  PairCorrelationInput pci(doc.getRoot());
+  CHECK(pci.get_name() == "gofr_e");
+  CHECK(pci.get_rmax() == Approx(3.0));
+  CHECK(pci.get_rmax_defined());
+  CHECK(pci.get_dr() == Approx(0.1));
+  CHECK(pci.get_sources() == std::vector<std::string>{"ion0"});
+
+  okay = doc.parseFromString(R"XML(<estimator type="gofr" source="ion0"/>)XML");
+  REQUIRE(okay);
+  PairCorrelationInput pci_source(doc.getRoot());
+  CHECK(pci_source.get_sources() == std::vector<std::string>{"ion0"});
+  CHECK_FALSE(pci_source.get_rmax_defined());
+
+  okay = doc.parseFromString(R"XML(<estimator type="gofr" dr="0.0"/>)XML");
+  REQUIRE(okay);
+  CHECK_THROWS_AS(PairCorrelationInput(doc.getRoot()), UniformCommunicateError);
+}
+
+TEST_CASE("PairCorrelationEstimator::genPairId", "[estimators]")
+{
+  const int ns = 3;
+  int id       = 0;
+  for (int i = 0; i < ns; ++i)
+    for (int j = i; j < ns; ++j)
+    {
+      CHECK(PairCorrelationEstimator::genPairId(i, j, ns) == id);
+      CHECK(PairCorrelationEstimator::genPairId(j, i, ns) == id);
+      ++id;
+    }
+}
+
+TEST_CASE("PairCorrelationEstimator::accumulate", "[estimators]")
+{
+  using MCPWalker = OperatorEstBase::MCPWalker;
+  using Real      = PairCorrelationEstimator::Real;
+
+  Libxml2Document doc;
+  bool okay = doc.parseFromString(R"XML(<estimator type="gofr" name="gofr" rmax="3.0" dr="1.0" sources="ion0"/>)XML");
+  REQUIRE(okay);
+  PairCorrelationInput pci(doc.getRoot());
+
+  const SimulationCell simulation_cell;
+  ParticleSet ions(simulation_cell);
+  ions.setName("ion0");
+  ions.create({1});
+  ions.getSpeciesSet().addSpecies("H");
+  ions.R[0] = {0.0, 0.0, 0.5};
+
+  ParticleSet pset_golden(simulation_cell);
+  pset_golden.setName("e");
+  pset_golden.create({2, 1});
+  pset_golden.getSpeciesSet().addSpecies("u");
+  pset_golden.getSpeciesSet().addSpecies("d");
+  pset_golden.addTable(ions);
+
+  PairCorrelationEstimator pce(std::move(pci), pset_golden);
+  CHECK(pce.get_num_bins() == 3);
+  CHECK(pce.get_delta() == Approx(1.0));
+  CHECK(pce.get_channel_names() == std::vector<std::string>{"e_0_0", "e_0_1", "e_1_1", "ion0_e_H"});
+  CHECK(pce.get_data().size() == 12);
+
+  // the walker particle sets get the distance tables requested by the estimator from the golden one
+  std::vector<MCPWalker> walkers;
+  std::vector<ParticleSet> psets;
+  const int nwalkers = 2;
+  // the distance tables keep references to their particle sets
+  psets.reserve(nwalkers);
+  for (int iw = 0; iw < nwalkers; ++iw)
+  {
+    walkers.emplace_back(3);
+    walkers.back().Weight = 1.0 + iw;
+    psets.emplace_back(pset_golden);
+    ParticleSet& pset = psets.back();
+    pset.R[0]         = {0.0, 0.0, 0.0};
+    pset.R[1]         = {1.5, 0.0, 0.0};
+    pset.R[2]         = {0.0, 0.0, 2.5};
+    pset.update();
+  }
+  std::vector<TrialWaveFunction> wfns;
+  auto ref_walkers = makeRefVector<MCPWalker>(walkers);
+  auto ref_psets   = makeRefVector<ParticleSet>(psets);
+  auto ref_wfns    = makeRefVector<TrialWaveFunction>(wfns);
+  RandomGenerator rng;
+
+  pce.accumulate(ref_walkers, ref_psets, ref_wfns, rng);
+
+  // shell volumes of the three bins, the volume is one for open boundary conditions
+  const Real ftpi = 4.0 / 3.0 * M_PI;
+  const std::vector<Real> shell{ftpi, ftpi * 7, ftpi * 19};
+  const Real total_weight = 3.0;
+  auto& data              = pce.get_data();
+  // u-u: one pair at 1.5
+  CHECK(data[0] == Approx(0.0));
+  CHECK(data[1] == Approx(total_weight / shell[1]));
+  CHECK(data[2] == Approx(0.0));
+  // u-d: two pairs at 2.5 and 2.92
+  CHECK(data[3 + 2] == Approx(total_weight * 2 / (2 * shell[2])));
+  // d-d: no pairs
+  CHECK(data[6 + 0] + data[6 + 1] + data[6 + 2] == Approx(0.0));
+  // e-H: at 0.5, 1.58 and 2.0, 3 pairs
+  for (int i = 0; i < 3; ++i)
+    CHECK(data[9 + i] == Approx(total_weight / (3 * shell[i])));
+  CHECK(pce.get_walkers_weight() == Approx(total_weight));
+}
+
+TEST_CASE("PairCorrelationEstimator::missing source", "[estimators]")
+{
+  Libxml2Document doc;
+  bool okay = doc.parseFromString(R"XML(<estimator type="gofr" name="gofr" sources="ion0"/>)XML");
+  REQUIRE(okay);
+  PairCorrelationInput pci(doc.getRoot());
+
+  const SimulationCell simulation_cell;
+  ParticleSet pset(simulation_cell);
+  pset.setName("e");
+  pset.create({2});
+  CHECK_THROWS_AS(PairCorrelationEstimator(std::move(pci), pset), UniformCommunicateError);
+}
+
+} // namespace qmcplusplus
@@ -0,0 +1,151 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "catch.hpp"
+
+#include <cmath>
+#include <random>
+#include "ReblockingAccumulator.h"
+
+namespace qmcplusplus
+{
+using Real = ReblockingAccumulator::Real;
+
+/** standard normal numbers by Box-Muller on the raw mt19937 output.
+ *  Unlike std::normal_distribution the sequence is the same with every standard library.
+ */
+class BoxMullerNormal
+{
+public:
+  BoxMullerNormal(std::mt19937::result_type seed) : gen_(seed) {}
+
+  Real operator()()
+  {
+    if (has_spare_)
+    {
+      has_spare_ = false;
+      return spare_;
+    }
+    const Real radius = std::sqrt(-2 * std::log(uniform()));
+    const Real angle  = 2 * M_PI * uniform();
+    spare_            = radius * std::sin(angle);
+    has_spare_        = true;
+    return radius * std::cos(angle);
+  }
+
+private:
+  /// in (0,1), never 0 for the log
+  Real uniform() { return (static_cast<Real>(gen_()) + 0.5) / 4294967296.0; }
+
+  std::mt19937 gen_;
+  Real spare_     = 0.0;
+  bool has_spare_ = false;
+};
+
+TEST_CASE("ReblockingAccumulator::levels", "[estimators]")
+{
+  ReblockingAccumulator reblocker;
+  for (int i = 1; i <= 5; ++i)
+    reblocker(i);
+  CHECK(reblocker.get_num_samples() == 5);
+  REQUIRE(reblocker.get_num_levels() == 3);
+  CHECK(reblocker.get_level(0).mean() == Approx(3.0));
+  // (1+2)/2 and (3+4)/2, 5 waits for its partner
+  CHECK(reblocker.get_level(1).count() == Approx(2.0));
+  CHECK(reblocker.get_level(1).mean() == Approx(2.5));
+  CHECK(reblocker.get_level(2).count() == Approx(1.0));
+  CHECK(reblocker.get_level(2).mean() == Approx(2.5));
+  // variance 2 over 4 degrees of freedom
+  CHECK(reblocker.getError(0) == Approx(std::sqrt(0.5)));
+  CHECK(reblocker.getError(2) == Approx(0.0));
+
+  reblocker.clear();
+  CHECK(reblocker.get_num_samples() == 0);
+  CHECK_FALSE(reblocker.analyze().plateau);
+}
+
+TEST_CASE("ReblockingAccumulator::correlated samples", "[estimators]")
+{
+  // AR(1) process, the statistical inefficiency is (1 + phi) / (1 - phi)
+  const Real phi         = 0.5;
+  const int num_samples  = 1 << 16;
+  const Real kappa       = (1 + phi) / (1 - phi);
+  const Real variance    = 1 / (1 - phi * phi);
+  BoxMullerNormal normal(171);
+  ReblockingAccumulator reblocker;
+  Real x = 0.0;
+  for (int i = 0; i < num_samples; ++i)
+  {
+    x = phi * x + normal();
+    reblocker(x);
+  }
+
+  auto result = reblocker.analyze();
+  CHECK(result.plateau);
+  CHECK(result.level > 0);
+  CHECK(result.mean == Approx(0.0).margin(5 * result.error));
+  CHECK(result.autocorrelation_time == Approx(kappa).epsilon(0.2));
+  CHECK(result.error == Approx(std::sqrt(kappa * variance / num_samples)).epsilon(0.1));
+  CHECK(result.effective_samples == Approx(num_samples / result.autocorrelation_time));
+  // the naive error underestimates the correlated one
+  CHECK(reblocker.getError(0) < result.error);
+}
+
+TEST_CASE("ReblockingAccumulator::no plateau", "[estimators]")
+{
+  // a drift is correlated at all block sizes
+  ReblockingAccumulator reblocker;
+  for (int i = 0; i < 64; ++i)
+    reblocker(i);
+  auto result = reblocker.analyze();
+  CHECK_FALSE(result.plateau);
+  // the highest level with 16 blocks
+  CHECK(result.level == 2);
+  CHECK(result.autocorrelation_time > 1.0);
+}
+
+TEST_CASE("ReblockingAccumulator::too few blocks", "[estimators]")
+{
+  // the criterion alone would accept a level with a couple of blocks
+  BoxMullerNormal normal(42);
+  ReblockingAccumulator reblocker;
+  bool plateau = false;
+  for (int i = 0; i < 1024; ++i)
+  {
+    reblocker(normal());
+    const auto result = reblocker.analyze();
+    if (result.plateau)
+      CHECK(reblocker.get_level(result.level).count() >= ReblockingAccumulator::min_plateau_blocks);
+    plateau = result.plateau;
+  }
+  CHECK(plateau);
+
+  // a large first pair of samples makes level 1 look converged with only 2 blocks
+  reblocker.clear();
+  for (Real x : {100.0, 102.0, 0.0, 0.0})
+    reblocker(x);
+  REQUIRE(reblocker.get_level(1).count() == Approx(2.0));
+  CHECK_FALSE(reblocker.analyze().plateau);
+}
+
+TEST_CASE("ReblockingAccumulator::no variance", "[estimators]")
+{
+  ReblockingAccumulator reblocker;
+  for (int i = 0; i < 256; ++i)
+    reblocker(-1.5);
+  auto result = reblocker.analyze();
+  CHECK_FALSE(result.plateau);
+  CHECK(result.mean == Approx(-1.5));
+  CHECK(result.error == Approx(0.0));
+}
+
+} // namespace qmcplusplus
@@ -0,0 +1,76 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "catch.hpp"
+
+#include "SharedGridAccumulator.h"
+
+namespace qmcplusplus
+{
+using Real = SharedGridAccumulator::Real;
+
+TEST_CASE("SharedGridAccumulator::deposits", "[estimators]")
+{
+  // a grid that does not end on a shard boundary
+  std::vector<Real> grid(3 * SharedGridAccumulator::cache_line_reals + 1, 0.0);
+  auto shared_grid = std::make_shared<SharedGridAccumulator>(grid, 1);
+  CHECK(shared_grid->getShardSize() == SharedGridAccumulator::cache_line_reals);
+  CHECK(shared_grid->getNumShards() == 4);
+
+  GridDepositBuffer deposits(shared_grid, 4);
+  const size_t last = grid.size() - 1;
+  deposits.deposit(last, 1.0);
+  deposits.deposit(0, 2.0);
+  deposits.deposit(last, 0.5);
+  CHECK(deposits.size() == 3);
+  CHECK(grid[last] == Approx(0.0));
+  // reaching the capacity flushes to the grid
+  deposits.deposit(SharedGridAccumulator::cache_line_reals, 3.0);
+  CHECK(deposits.size() == 0);
+  CHECK(grid[0] == Approx(2.0));
+  CHECK(grid[SharedGridAccumulator::cache_line_reals] == Approx(3.0));
+  CHECK(grid[last] == Approx(1.5));
+
+  deposits.deposit(1, 1.0);
+  deposits.flush();
+  CHECK(grid[1] == Approx(1.0));
+
+  std::vector<Real> values(grid.size(), 1.0);
+  shared_grid->addDense(values.data(), 0.5);
+  CHECK(grid[1] == Approx(1.5));
+  CHECK(grid[last] == Approx(2.0));
+}
+
+TEST_CASE("SharedGridAccumulator::concurrent deposits", "[estimators]")
+{
+  const int num_buffers  = 8;
+  const int num_deposits = 1000;
+  std::vector<Real> grid(100, 0.0);
+  auto shared_grid = std::make_shared<SharedGridAccumulator>(grid, 1);
+
+#pragma omp parallel for
+  for (int ib = 0; ib < num_buffers; ib++)
+  {
+    GridDepositBuffer deposits(shared_grid, 64);
+    for (int id = 0; id < num_deposits; id++)
+      deposits.deposit((id * 7 + ib) % grid.size(), 1.0);
+    deposits.flush();
+  }
+
+  Real total = 0.0;
+  for (Real value : grid)
+    total += value;
+  CHECK(total == Approx(num_buffers * num_deposits));
+  CHECK(grid[0] == Approx(num_buffers * num_deposits / grid.size()));
+}
+
+} // namespace qmcplusplus
@@ -295,6 +295,9 @@ TEST_CASE("SpinDensityNew::collect(DataLocality::rank)", "[estimators]")
     int ncrowds = 2;
 
     accumulateFromPsets(ncrowds, sdn, crowd_sdns);
+    // the crowd clones deposit into the rank grid and have no copy of it
+    for (auto& crowd_sdn : crowd_sdns)
+      CHECK(crowd_sdn->get_data().empty());
 
     RefVector<OperatorEstBase> crowd_oeb_refs = convertUPtrToRefVector(crowd_sdns);
     sdn.collect(crowd_oeb_refs);
@@ -304,6 +307,7 @@ TEST_CASE("SpinDensityNew::collect(DataLocality::rank)", "[estimators]")
     // is correct.  This just checks it hasn't changed from how it was in SpinDensity which lacked testing.
     CHECK(data_ref[555] == 4 * ncrowds);
     CHECK(data_ref[1666] == 4 * ncrowds);
+    CHECK(sdn.get_walkers_weight() == Approx(4 * ncrowds));
   }
 }
 
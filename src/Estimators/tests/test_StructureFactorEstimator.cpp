@@ -0,0 +1,132 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "StructureFactorInput.h"
+#include "StructureFactorEstimator.h"
+#include "ParticleSet.h"
+#include "TrialWaveFunction.h"
+#include "EstimatorTesting.h"
+#include "LongRange/KContainer.h"
+#include "OhmmsData/Libxml2Doc.h"
+#include "Message/UniformCommunicateError.h"
+
+namespace qmcplusplus
+{
+
+TEST_CASE("StructureFactorInput", "[estimators]")
+{
+  Libxml2Document doc;
+  bool okay = doc.parseFromString(R"XML(<estimator type="sk" name="sk_e" kmax="2.5"/>)XML");
+  REQUIRE(okay);
+  StructureFactorInput sfi(doc.getRoot());
+  CHECK(sfi.get_name() == "sk_e");
+  CHECK(sfi.get_kmax() == Approx(2.5));
+
+  okay = doc.parseFromString(R"XML(<estimator type="sk" kmax="-1.0"/>)XML");
+  REQUIRE(okay);
+  CHECK_THROWS_AS(StructureFactorInput(doc.getRoot()), UniformCommunicateError);
+}
+
+TEST_CASE("StructureFactorEstimator::accumulate", "[estimators]")
+{
+  using MCPWalker = OperatorEstBase::MCPWalker;
+  using Real      = StructureFactorEstimator::Real;
+  using PosType   = StructureFactorEstimator::PosType;
+
+  Libxml2Document doc;
+  bool okay = doc.parseFromString(R"XML(<estimator type="sk" name="sk" kmax="2.0"/>)XML");
+  REQUIRE(okay);
+  StructureFactorInput sfi(doc.getRoot());
+
+  const SimulationCell simulation_cell(testing::makeTestLattice());
+  ParticleSet pset_golden(simulation_cell);
+  pset_golden.setName("e");
+  pset_golden.create({2, 1});
+  SpeciesSet& species = pset_golden.getSpeciesSet();
+  species.addSpecies("u");
+  species.addSpecies("d");
+  pset_golden.createSK();
+
+  StructureFactorEstimator sfe(std::move(sfi), pset_golden);
+  const KContainer& k_lists = simulation_cell.getKLists();
+  const int nk              = sfe.get_num_kpoints();
+  REQUIRE(nk > 0);
+  CHECK(nk < k_lists.numk);
+  CHECK(k_lists.ksq[nk - 1] <= 4.0);
+  CHECK(sfe.get_data().size() == nk * 5);
+
+  std::vector<MCPWalker> walkers;
+  std::vector<ParticleSet> psets;
+  const int nwalkers = 2;
+  for (int iw = 0; iw < nwalkers; ++iw)
+  {
+    walkers.emplace_back(3);
+    walkers.back().Weight = 1.0 + iw;
+    psets.emplace_back(pset_golden);
+    ParticleSet& pset = psets.back();
+    pset.R[0]         = {0.1 + iw, 0.2, 0.3};
+    pset.R[1]         = {1.4, 0.5 * iw, 2.6};
+    pset.R[2]         = {2.7, 1.8, 0.9 + iw};
+    pset.update();
+  }
+  std::vector<TrialWaveFunction> wfns;
+  auto ref_walkers = makeRefVector<MCPWalker>(walkers);
+  auto ref_psets   = makeRefVector<ParticleSet>(psets);
+  auto ref_wfns    = makeRefVector<TrialWaveFunction>(wfns);
+  RandomGenerator rng;
+
+  sfe.accumulate(ref_walkers, ref_psets, ref_wfns, rng);
+
+  // direct evaluation of the weighted sums of S(k) and of the up rho_k
+  auto& data = sfe.get_data();
+  for (int ik = 0; ik < nk; ++ik)
+  {
+    const PosType& k = k_lists.kpts_cart[ik];
+    Real sk_ref      = 0.0;
+    Real rhok_u_ref  = 0.0;
+    for (int iw = 0; iw < nwalkers; ++iw)
+    {
+      Real rhok_r = 0.0, rhok_i = 0.0;
+      for (int iat = 0; iat < 3; ++iat)
+      {
+        const Real phase = dot(k, psets[iw].R[iat]);
+        rhok_r += std::cos(phase);
+        rhok_i += std::sin(phase);
+        if (iat < 2)
+          rhok_u_ref += walkers[iw].Weight * std::cos(phase);
+      }
+      sk_ref += walkers[iw].Weight * (rhok_r * rhok_r + rhok_i * rhok_i) / 3.0;
+    }
+    CHECK(data[ik] == Approx(sk_ref));
+    CHECK(data[nk + ik] == Approx(rhok_u_ref));
+  }
+  CHECK(sfe.get_walkers_weight() == Approx(3.0));
+
+  auto spawn = sfe.spawnCrowdClone();
+  CHECK(spawn->get_data().size() == data.size());
+}
+
+TEST_CASE("StructureFactorEstimator::open boundary conditions", "[estimators]")
+{
+  Libxml2Document doc;
+  bool okay = doc.parseFromString(R"XML(<estimator type="sk" name="sk"/>)XML");
+  REQUIRE(okay);
+  StructureFactorInput sfi(doc.getRoot());
+
+  const SimulationCell simulation_cell;
+  ParticleSet pset(simulation_cell);
+  pset.create({2});
+  CHECK_THROWS_AS(StructureFactorEstimator(std::move(sfi), pset), UniformCommunicateError);
+}
+
+} // namespace qmcplusplus
@@ -0,0 +1,207 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "TraceStreamEstimator.h"
+
+#include <filesystem>
+#include <thread>
+
+#include "OhmmsData/Libxml2Doc.h"
+#include "Message/UniformCommunicateError.h"
+#include "QMCDrivers/WalkerProperties.h"
+#include "Utilities/StdRandom.h"
+
+namespace qmcplusplus
+{
+
+TEST_CASE("TraceStreamInput", "[estimators]")
+{
+  Libxml2Document doc;
+  bool okay = doc.parseFromString(R"XML(<estimator type="TraceStream" name="walker_trace" chunk_size="4096" compress="no"/>)XML");
+  REQUIRE(okay);
+  TraceStreamInput tsi(doc.getRoot());
+  CHECK(tsi.get_name() == "walker_trace");
+  CHECK(tsi.get_chunk_size() == 4096);
+  CHECK_FALSE(tsi.get_compress());
+
+  okay = doc.parseFromString(R"XML(<estimator type="TraceStream" chunk_size="0"/>)XML");
+  REQUIRE(okay);
+  CHECK_THROWS_AS(TraceStreamInput(doc.getRoot()), UniformCommunicateError);
+}
+
+TEST_CASE("TraceChunkQueue::concurrent push", "[estimators]")
+{
+  TraceChunkQueue queue;
+  const int nthreads = 4;
+  const int nchunks  = 250;
+  std::vector<std::thread> threads;
+  for (int it = 0; it < nthreads; ++it)
+    threads.emplace_back([&queue, it]() {
+      for (int ic = 0; ic < nchunks; ++ic)
+      {
+        auto chunk          = std::make_unique<TraceChunk>();
+        chunk->header.crowd = it;
+        chunk->header.block = ic;
+        queue.push(std::move(chunk));
+      }
+    });
+  for (auto& thread : threads)
+    thread.join();
+
+  auto chunks = queue.popAll();
+  REQUIRE(chunks.size() == nthreads * nchunks);
+  // the chunks of each producer come out in the order it pushed them
+  std::vector<int> next(nthreads, 0);
+  bool in_order = true;
+  for (auto& chunk : chunks)
+    in_order = in_order && (chunk->header.block == next[chunk->header.crowd]++);
+  CHECK(in_order);
+  CHECK(queue.popAll().empty());
+}
+
+TEST_CASE("TraceStreamWriter::round trip", "[estimators]")
+{
+  const std::string filename("test_trace_stream.trace");
+  const std::string index_filename(filename + ".idx");
+  for (bool compress : {true, false})
+  {
+    {
+      TraceStreamWriter writer(filename, index_filename);
+      const int crowd = writer.makeCrowdId();
+      CHECK(writer.makeCrowdId() == crowd + 1);
+      TraceChunkBuilder builder;
+      for (int block = 0; block < 3; ++block)
+      {
+        for (int ichunk = 0; ichunk < 2; ++ichunk)
+        {
+          for (int step = 0; step < 10; ++step)
+          {
+            const std::vector<double> values{1.0 * block, 0.5 * step, -1.0 * ichunk};
+            builder.addRecord(7, step, "Kinetic", values.data(), values.size());
+            builder.addRecord(7, step, "Weight", values.data(), 1);
+          }
+          writer.push(builder.finish(writer.get_block(), crowd, compress));
+          CHECK(builder.empty());
+          writer.tryDrain();
+        }
+        writer.endBlock();
+      }
+    }
+
+    TraceStreamReader reader(filename, index_filename);
+    REQUIRE(reader.get_index().size() == 3);
+    CHECK(reader.get_index()[2].num_chunks == 2);
+    auto records = reader.readBlock(1);
+    REQUIRE(records.size() == 40);
+    CHECK(records[0].walker_id == 7);
+    CHECK(records[0].component == "Kinetic");
+    CHECK(records[1].component == "Weight");
+    CHECK(records[1].values.size() == 1);
+    const auto& last = records.back();
+    CHECK(last.step == 9);
+    REQUIRE(last.values.size() == 1);
+    CHECK(last.values[0] == Approx(1.0));
+    const auto& record = records[22];
+    CHECK(record.step == 1);
+    REQUIRE(record.values.size() == 3);
+    CHECK(record.values[0] == Approx(1.0));
+    CHECK(record.values[1] == Approx(0.5));
+    CHECK(record.values[2] == Approx(-1.0));
+    CHECK_THROWS(reader.readBlock(3));
+  }
+  std::filesystem::remove(filename);
+  std::filesystem::remove(index_filename);
+}
+
+TEST_CASE("TraceStreamEstimator::accumulate", "[estimators]")
+{
+  using MCPWalker = OperatorEstBase::MCPWalker;
+  using Real      = TraceStreamEstimator::Real;
+  using WP        = WalkerProperties::Indexes;
+
+  Libxml2Document doc;
+  bool okay = doc.parseFromString(R"XML(<estimator type="TraceStream" name="test_trace" chunk_size="256"/>)XML");
+  REQUIRE(okay);
+  TraceStreamInput tsi(doc.getRoot());
+
+  const std::string filename = TraceStreamEstimator::makeFilename(0, "test_trace");
+  CHECK(filename == "rank_0_test_trace.trace");
+  const int ncrowds  = 2;
+  const int nwalkers = 3;
+  const int nsteps   = 4;
+  {
+    TraceStreamEstimator rank_estimator(std::move(tsi), 0);
+    UPtrVector<OperatorEstBase> crowd_estimators;
+    for (int ic = 0; ic < ncrowds; ++ic)
+      crowd_estimators.emplace_back(rank_estimator.spawnCrowdClone());
+
+    std::vector<MCPWalker> walkers;
+    for (int iw = 0; iw < nwalkers; ++iw)
+      walkers.emplace_back(2);
+    std::vector<ParticleSet> psets;
+    std::vector<TrialWaveFunction> wfns;
+    auto ref_walkers = makeRefVector<MCPWalker>(walkers);
+    auto ref_psets   = makeRefVector<ParticleSet>(psets);
+    auto ref_wfns    = makeRefVector<TrialWaveFunction>(wfns);
+    RandomGenerator rng;
+
+    for (int block = 0; block < 2; ++block)
+    {
+      for (auto& crowd_oeb : crowd_estimators)
+        crowd_oeb->startBlock(nsteps);
+      for (int step = 0; step < nsteps; ++step)
+        for (int ic = 0; ic < ncrowds; ++ic)
+        {
+          auto& crowd_estimator = dynamic_cast<TraceStreamEstimator&>(*crowd_estimators[ic]);
+          auto logger           = crowd_estimator.getLogger();
+          for (int iw = 0; iw < nwalkers; ++iw)
+          {
+            walkers[iw].ID                          = ic * nwalkers + iw;
+            walkers[iw].Weight                      = 1.0;
+            walkers[iw].Properties(WP::LOCALENERGY) = -1.0 * block;
+            Vector<Real> per_particle{Real(step), Real(iw)};
+            logger(iw, "Kinetic", per_particle);
+          }
+          crowd_estimator.accumulate(ref_walkers, ref_psets, ref_wfns, rng);
+        }
+      rank_estimator.collect(convertUPtrToRefVector(crowd_estimators));
+    }
+  }
+
+  TraceStreamReader reader(filename, filename + ".idx");
+  REQUIRE(reader.get_index().size() == 2);
+  // the chunk size is small enough for the crowds to hand over chunks during the block
+  CHECK(reader.get_index()[1].num_chunks > ncrowds);
+  auto records = reader.readBlock(1);
+  CHECK(records.size() == ncrowds * nsteps * nwalkers * 3);
+  int kinetic_count = 0;
+  bool values_ok    = true;
+  for (auto& record : records)
+  {
+    if (record.component == "Kinetic")
+    {
+      ++kinetic_count;
+      values_ok = values_ok && record.values.size() == 2 && record.values[0] == record.step &&
+          record.values[1] == record.walker_id % nwalkers;
+    }
+    else if (record.component == "LocalEnergy")
+      values_ok = values_ok && record.values[0] == -1.0;
+  }
+  CHECK(kinetic_count == ncrowds * nsteps * nwalkers);
+  CHECK(values_ok);
+
+  std::filesystem::remove(filename);
+  std::filesystem::remove(filename + ".idx");
+}
+
+} // namespace qmcplusplus
@@ -18,6 +18,7 @@
 #include "QMCHamiltonians/QMCHamiltonian.h"
 #include "Estimators/LocalEnergyEstimator.h"
 #include "Estimators/LocalEnergyOnlyEstimator.h"
+#include "Estimators/RMCLocalEnergyEstimator.h"
 #include "QMCDrivers/WalkerProperties.h"
 #include "io/hdf/hdf_archive.h"
 
@@ -77,6 +78,72 @@ TEST_CASE("LocalEnergy", "[estimators]")
   CHECK(le_est.scalars[2].mean() == Approx(1.2));
 }
 
+TEST_CASE("LocalEnergy crowd property block", "[estimators]")
+{
+  using MCPWalker = LocalEnergyEstimator::MCPWalker;
+  QMCHamiltonian H;
+  LocalEnergyEstimator le_walkers(H, false);
+  LocalEnergyEstimator le_block(H, false);
+
+  std::vector<MCPWalker> walkers(3, MCPWalker(1));
+  for (int iw = 0; iw < walkers.size(); ++iw)
+  {
+    walkers[iw].Properties(WP::LOCALENERGY)    = -1.1 - 0.3 * iw;
+    walkers[iw].Properties(WP::LOCALPOTENTIAL) = 1.2 + 0.1 * iw;
+    walkers[iw].Weight                         = 0.5 + iw;
+  }
+  auto walker_refs = makeRefVector<MCPWalker>(walkers);
+
+  CrowdPropertyBlock block;
+  block.load(walker_refs);
+  CHECK(block.size() == 3);
+  CHECK(block.getTotalWeight() == Approx(4.5));
+  CHECK(block.getColumn(WP::LOCALENERGY)[2] == Approx(-1.7));
+
+  le_walkers.accumulate(walker_refs);
+  le_block.accumulateProperties(block);
+  for (int i = 0; i < le_walkers.scalars.size(); ++i)
+  {
+    CHECK(le_block.scalars[i].result() == Approx(le_walkers.scalars[i].result()));
+    CHECK(le_block.scalars[i].result2() == Approx(le_walkers.scalars[i].result2()));
+    CHECK(le_block.scalars[i].count() == Approx(le_walkers.scalars[i].count()));
+  }
+}
+
+TEST_CASE("RMCLocalEnergy reptile beads", "[estimators]")
+{
+  using MCPWalker = RMCLocalEnergyEstimator::MCPWalker;
+  QMCHamiltonian H;
+  RMCLocalEnergyEstimator rmc_est(H);
+
+  // head, tail and center of two reptiles
+  std::vector<MCPWalker> beads(6, MCPWalker(1));
+  for (int ib = 0; ib < beads.size(); ++ib)
+  {
+    beads[ib].Properties(WP::LOCALENERGY)    = -1.0 - ib;
+    beads[ib].Properties(WP::LOCALPOTENTIAL) = 0.5 * ib;
+  }
+
+  // the heads alone are not used
+  rmc_est.accumulate(makeRefVector<MCPWalker>(beads));
+  CHECK(rmc_est.scalars[0].count() == Approx(0.0));
+
+  for (int ir = 0; ir < 2; ++ir)
+    rmc_est.accumulateBeads(beads[3 * ir].getPropertyBase(), beads[3 * ir + 1].getPropertyBase(),
+                            beads[3 * ir + 2].getPropertyBase());
+
+  CHECK(rmc_est.scalars[0].count() == Approx(2.0));
+  // mixed: average of the heads -1, -4 and the tails -2, -5
+  CHECK(rmc_est.scalars[0].mean() == Approx(-3.0));
+  CHECK(rmc_est.scalars[1].mean() == Approx((1.0 + 4.0 + 16.0 + 25.0) / 4));
+  // pure: centers -3, -6
+  CHECK(rmc_est.scalars[2].mean() == Approx(-4.5));
+  CHECK(rmc_est.scalars[3].mean() == Approx((9.0 + 36.0) / 2));
+  CHECK(rmc_est.scalars[4].mean() == Approx((2.0 + 20.0) / 2));
+  CHECK(rmc_est.scalars[5].mean() == Approx((0.0 + 0.5 + 1.5 + 2.0) / 4));
+  CHECK(rmc_est.scalars[6].mean() == Approx((1.0 + 2.5) / 2));
+}
+
 TEST_CASE("LocalEnergy with hdf5", "[estimators]")
 {
   QMCHamiltonian H;
@@ -103,6 +103,26 @@ struct NRCOptimization
    */
   virtual Return_t Func(Return_t dl) = 0;
 
+  /** evaluate Func at several points along the line
+   * @param dls the points
+   * @param values the function values at dls
+   * @param valid whether the value at each point is valid
+   *
+   * The default calls Func point by point. Implementations able to evaluate
+   * several points in one pass override it.
+   */
+  virtual void Funcs(const std::vector<Return_t>& dls, std::vector<Return_t>& values, std::vector<bool>& valid)
+  {
+    values.resize(dls.size());
+    valid.resize(dls.size());
+    for (int i = 0; i < dls.size(); i++)
+    {
+      validFuncVal = true;
+      values[i]    = Func(dls[i]);
+      valid[i]     = validFuncVal;
+    }
+  }
+
   Return_t Lambda;
   Return_t ZEPS, CGOLD, TOL, GLIMIT, TINY, GOLD;
 
@@ -230,20 +250,19 @@ struct NRCOptimization
     Return_t start_cost;
     std::vector<bool> cFailed(points, false);
     int nFailed(0);
-    validFuncVal = true;
-    y[0]         = Func(x[0]);
-    if (!validFuncVal)
-    {
-      cFailed[0] = true;
-      nFailed++;
-    }
+    std::vector<Return_t> values;
+    std::vector<bool> valid;
+    // the two points next to zero are evaluated together
+    Funcs({x[0], x[2]}, values, valid);
+    y[0] = values[0];
     y[1] = zeroCost;
-    y[2] = Func(x[2]);
-    if (!validFuncVal)
-    {
-      cFailed[2] = true;
-      nFailed++;
-    }
+    y[2] = values[1];
+    for (int i = 0; i < 2; i++)
+      if (!valid[i])
+      {
+        cFailed[2 * i] = true;
+        nFailed++;
+      }
     for (int j = 0; j < 5; j++)
     {
       S(2, j) = std::pow(x[2], j);
@@ -260,10 +279,12 @@ struct NRCOptimization
       for (int i = 1; i < points - 2; i++)
         x[i] = x[0] + 1.0 * i * stp;
     }
+    // the remaining points are known once the direction is fixed
+    Funcs(std::vector<Return_t>(x.begin() + 3, x.end()), values, valid);
     for (int i = 3; i < points; i++)
     {
-      y[i] = Func(x[i]);
-      if (!validFuncVal)
+      y[i] = values[i - 3];
+      if (!valid[i - 3])
       {
         cFailed[i] = true;
         nFailed++;
@@ -271,7 +292,8 @@ struct NRCOptimization
       for (int j = 0; j < 5; j++)
         S(i, j) = std::pow(x[i], j);
     }
-    start_cost = y[1];
+    start_cost   = y[1];
+    validFuncVal = true;
     //     for (int i=0; i<points; i++) std::cout <<x[i]<<": "<<y[i]<< std::endl;
     if (nFailed > 0)
     {
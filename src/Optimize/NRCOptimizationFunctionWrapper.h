@@ -31,6 +31,10 @@ public:
   T& object;
   NRCOptimizationFunctionWrapper(T& o) : object(o) {}
   Return_t Func(Return_t dl) override { return object.costFunc(dl); }
+  void Funcs(const std::vector<Return_t>& dls, std::vector<Return_t>& values, std::vector<bool>& valid) override
+  {
+    object.costFuncs(dls, values, valid);
+  }
 };
 } // namespace qmcplusplus
 #endif
@@ -174,6 +174,14 @@ bool HDFWalkerInput_0_4::read_hdf5(const std::filesystem::path& h5name)
       copy(it, it + nitems, get_first_address(wc_list_[iw]->R));
       it += nitems;
     }
+
+    // random streams of the walkers, absent in older files
+    constexpr size_t ns = WalkerConfigurations::random_stream_size;
+    std::vector<int> streams(dims[0] * ns);
+    std::array<size_t, 2> stream_dims{dims[0], ns};
+    hyperslab_proxy<std::vector<int>, 2> stream_slab(streams, stream_dims, stream_dims, {0, 0});
+    if (hin.readEntry(stream_slab, hdf::walker_streams))
+      wc_list_.getRandomStreams(streams.data() + woffsets[myComm->rank()] * ns, curWalker, nw_in);
   }
 
   return true;
@@ -338,6 +346,16 @@ bool HDFWalkerInput_0_4::read_phdf5(const std::filesystem::path& h5name)
       copy(it, it + nitems, get_first_address(wc_list_[iw]->R));
       it += nitems;
     }
+
+    // random streams of the walkers, absent in older files
+    constexpr size_t ns = WalkerConfigurations::random_stream_size;
+    std::vector<int> streams(nw_loc * ns);
+    std::array<size_t, 2> stream_dims{dims[0], ns};
+    std::array<size_t, 2> stream_counts{nw_loc, ns};
+    std::array<size_t, 2> stream_offsets{static_cast<size_t>(woffsets[myComm->rank()]), 0};
+    hyperslab_proxy<std::vector<int>, 2> stream_slab(streams, stream_dims, stream_counts, stream_offsets);
+    if (hin.readEntry(stream_slab, hdf::walker_streams))
+      wc_list_.getRandomStreams(streams.data(), curWalker, nw_in);
   }
   return true;
 }
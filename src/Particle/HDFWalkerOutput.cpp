@@ -176,6 +176,41 @@ void HDFWalkerOutput::write_configuration(const WalkerConfigurations& W, hdf_arc
     int buffer_id = (myComm->size() > 1) ? 1 : 0;
     hout.writeSlabReshaped(RemoteData[buffer_id], gcounts, hdf::walkers);
   }
+
+  write_random_streams(W, hout);
+}
+
+void HDFWalkerOutput::write_random_streams(const WalkerConfigurations& W, hdf_archive& hout)
+{
+  constexpr size_t ns = WalkerConfigurations::random_stream_size;
+  std::vector<int> streams(W.getActiveWalkers() * ns);
+  W.putRandomStreams(streams.data());
+
+  std::array<size_t, 2> gcounts{number_of_walkers_, ns};
+  if (hout.is_parallel())
+  {
+    std::array<size_t, 2> counts{W.getActiveWalkers(), ns};
+    std::array<size_t, 2> offsets{static_cast<size_t>(W.WalkerOffsets[myComm->rank()]), 0};
+    hyperslab_proxy<std::vector<int>, 2> slab(streams, gcounts, counts, offsets);
+    hout.write(slab, hdf::walker_streams);
+  }
+  else
+  {
+    std::vector<int> all_streams;
+    if (myComm->size() > 1)
+    {
+      std::vector<int> displ(myComm->size()), counts(myComm->size());
+      for (int i = 0; i < myComm->size(); ++i)
+      {
+        counts[i] = ns * (W.WalkerOffsets[i + 1] - W.WalkerOffsets[i]);
+        displ[i]  = ns * W.WalkerOffsets[i];
+      }
+      if (!myComm->rank())
+        all_streams.resize(ns * W.WalkerOffsets[myComm->size()]);
+      mpi::gatherv(*myComm, streams, all_streams, counts, displ);
+    }
+    hout.writeSlabReshaped(myComm->size() > 1 ? all_streams : streams, gcounts, hdf::walker_streams);
+  }
 }
 
 /*
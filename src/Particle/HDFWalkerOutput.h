@@ -64,6 +64,9 @@ private:
   std::vector<BufferType> RemoteData;
   int block;
 
+  ///write the random streams of the walkers along with the configurations
+  void write_random_streams(const WalkerConfigurations& W, hdf_archive& hout);
+
   //     //define some types for the FW collection
   //     using FWBufferType = std::vector<ForwardWalkingData>;
   //     std::vector<FWBufferType*> FWData;
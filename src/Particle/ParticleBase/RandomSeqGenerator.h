@@ -17,6 +17,7 @@
 #define QMCPLUSPLUS_RANDOMSEQUENCEGENERATOR_H
 #include <algorithm>
 #include <type_traits>
+#include <utility>
 #include "OhmmsPETE/OhmmsMatrix.h"
 #include "ParticleBase/ParticleAttrib.h"
 #include "Particle/MCCoords.hpp"
@@ -29,9 +30,35 @@
   */
 namespace qmcplusplus
 {
+/// true if RG provides the bulk fill generate_normal, such as PhiloxRandom
+template<class RG, class T, class = void>
+struct has_bulk_normal : std::false_type
+{};
+
+template<class RG, class T>
+struct has_bulk_normal<RG, T, std::void_t<decltype(std::declval<RG&>().generate_normal(std::declval<T*>(), size_t(0)))>>
+    : std::true_type
+{};
+
+/// true if RG provides the bulk fill generate_uniform, such as PhiloxRandom
+template<class RG, class T, class = void>
+struct has_bulk_uniform : std::false_type
+{};
+
+template<class RG, class T>
+struct has_bulk_uniform<RG, T, std::void_t<decltype(std::declval<RG&>().generate_uniform(std::declval<T*>(), size_t(0)))>>
+    : std::true_type
+{};
+
 template<class T, class RG>
 inline void assignGaussRand(T* restrict a, unsigned n, RG& rng)
 {
+  // counter-based engines fill the whole array at once with the same Box-Mueller pairing
+  if constexpr (has_bulk_normal<RG, T>::value)
+  {
+    rng.generate_normal(a, n);
+    return;
+  }
   OHMMS_PRECISION_FULL slightly_less_than_one = 1.0 - std::numeric_limits<OHMMS_PRECISION_FULL>::epsilon();
   int nm1                                     = n - 1;
   OHMMS_PRECISION_FULL temp1, temp2;
@@ -63,8 +90,11 @@ inline void assignGaussRand(T* restrict a, unsigned n, RG& rng)
 template<class T, class RG>
 inline void assignUniformRand(T* restrict a, unsigned n, RG& rng)
 {
-  for (int i = 0; i < n; i++)
-    a[i] = rng();
+  if constexpr (has_bulk_uniform<RG, T>::value)
+    rng.generate_uniform(a, n);
+  else
+    for (int i = 0; i < n; i++)
+      a[i] = rng();
 }
 
 template<typename T, unsigned D, class RG>
@@ -11,12 +11,12 @@
 
 
 #include "SampleStack.h"
+#include <cassert>
 #include "Particle/MCSample.h"
-#include "Utilities/IteratorUtility.h"
 
 namespace qmcplusplus
 {
-SampleStack::SampleStack() : total_num_(0), max_samples_(10), current_sample_count_(0) {}
+SampleStack::SampleStack() : total_num_(0), max_samples_(10), current_sample_count_(0), global_num_samples_(0) {}
 
 /** allocate the SampleStack
  * @param n number of samples per rank
@@ -29,62 +29,143 @@ void SampleStack::setMaxSamples(int n, int num_ranks)
   //do not add anything
   if (n == 0)
     return;
-  sample_vector_.reserve(n);
-  int nadd = n - sample_vector_.size();
-  while (nadd > 0)
+  if (scalars_.size() < n)
+    scalars_.resize(n);
+  if (total_num_ > 0)
+    allocate();
+}
+
+void SampleStack::allocate()
+{
+  const size_t num_samples = scalars_.size();
+  if (deltas_.size() < positionOffset(num_samples))
   {
-    sample_vector_.push_back(new MCSample(total_num_));
-    --nadd;
+    deltas_.resize(positionOffset(num_samples));
+    spins_.resize(num_samples * total_num_);
   }
 }
 
-MCSample& SampleStack::getSample(unsigned int i) const { return *sample_vector_[i]; }
+MCSample SampleStack::getSample(unsigned int i) const
+{
+  MCSample sample(total_num_);
+  const auto* restrict delta = deltas_.data() + positionOffset(i);
+  const auto* restrict spin  = spins_.data() + i * total_num_;
+  for (int iat = 0; iat < total_num_; ++iat)
+  {
+    for (int idim = 0; idim < OHMMS_DIM; ++idim)
+      sample.R[iat][idim] = reference_R_[iat][idim] + delta[iat * OHMMS_DIM + idim];
+    sample.spins[iat] = spin[iat];
+  }
+  sample.LogPsi = scalars_[i].LogPsi;
+  sample.Sign   = scalars_[i].Sign;
+  sample.PE     = scalars_[i].PE;
+  sample.KE     = scalars_[i].KE;
+  return sample;
+}
 
 void SampleStack::saveEnsemble(std::vector<MCSample>& walker_list)
 {
   //safety check
   if (max_samples_ == 0)
     return;
-  auto first = walker_list.begin();
-  auto last  = walker_list.end();
-  while ((first != last) && (current_sample_count_ < max_samples_))
+  for (auto& sample : walker_list)
   {
-    *sample_vector_[current_sample_count_] = *first;
-    ++first;
-    ++current_sample_count_;
+    if (current_sample_count_ >= max_samples_)
+      break;
+    appendSample(std::move(sample));
   }
 }
 
-void SampleStack::appendSample(MCSample&& sample)
+void SampleStack::setReference(const ParticleSet::ParticlePos& R)
 {
-  // Ignore samples in excess of the expected number of samples
-  if (current_sample_count_ < max_samples_)
+  total_num_   = R.size();
+  reference_R_ = R;
+  if (scalars_.size() < max_samples_)
+    scalars_.resize(max_samples_);
+  allocate();
+}
+
+void SampleStack::storeConfiguration(const ParticleSet::ParticlePos& R, const ParticleSet::ParticleScalar& spins)
+{
+  if (reference_R_.size() == 0)
+    setReference(R);
+  assert(R.size() == total_num_);
+
+  auto* restrict delta = deltas_.data() + positionOffset(current_sample_count_);
+  auto* restrict spin  = spins_.data() + current_sample_count_ * total_num_;
+  for (int iat = 0; iat < total_num_; ++iat)
   {
-    *sample_vector_[current_sample_count_] = std::move(sample);
-    current_sample_count_++;
+    for (int idim = 0; idim < OHMMS_DIM; ++idim)
+      delta[iat * OHMMS_DIM + idim] = R[iat][idim] - reference_R_[iat][idim];
+    spin[iat] = spins.size() ? spins[iat] : 0;
   }
 }
 
+void SampleStack::appendSample(MCSample&& sample)
+{
+  // Ignore samples in excess of the expected number of samples
+  if (current_sample_count_ >= max_samples_)
+    return;
+  storeConfiguration(sample.R, sample.spins);
+  scalars_[current_sample_count_] = {sample.LogPsi, sample.Sign, sample.PE, sample.KE};
+  current_sample_count_++;
+}
+
+void SampleStack::appendSample(const ParticleSet& pset)
+{
+  if (current_sample_count_ >= max_samples_)
+    return;
+  storeConfiguration(pset.R, pset.spins);
+  scalars_[current_sample_count_] = {0, 1, 0, 0};
+  current_sample_count_++;
+}
+
 
 /** load a single sample from SampleStack
  */
 void SampleStack::loadSample(ParticleSet& pset, size_t iw) const
 {
-  pset.R     = sample_vector_[iw]->R;
-  pset.spins = sample_vector_[iw]->spins;
+  assert(iw < current_sample_count_);
+  assert(pset.getTotalNum() == total_num_);
+  const auto* restrict delta = deltas_.data() + positionOffset(iw);
+  const auto* restrict spin  = spins_.data() + iw * total_num_;
+  for (int iat = 0; iat < total_num_; ++iat)
+  {
+    for (int idim = 0; idim < OHMMS_DIM; ++idim)
+      pset.R[iat][idim] = reference_R_[iat][idim] + delta[iat * OHMMS_DIM + idim];
+    pset.spins[iat] = spin[iat];
+  }
+}
+
+/** load a crowd sized batch of samples
+ *
+ * The samples of a batch are contiguous in the store so they are streamed in order.
+ */
+void SampleStack::loadSamples(const RefVectorWithLeader<ParticleSet>& p_list, size_t first) const
+{
+  for (int iw = 0; iw < p_list.size(); ++iw)
+    loadSample(p_list[iw], first + iw);
 }
 
 void SampleStack::clearEnsemble()
 {
-  //delete_iter(SampleStack.begin(),SampleStack.end());
-  for (int i = 0; i < sample_vector_.size(); ++i)
-    if (sample_vector_[i])
-      delete sample_vector_[i];
-  sample_vector_.clear();
+  reference_R_.resize(0);
+  deltas_.clear();
+  deltas_.shrink_to_fit();
+  spins_.clear();
+  spins_.shrink_to_fit();
+  scalars_.clear();
+  scalars_.shrink_to_fit();
   max_samples_          = 0;
   current_sample_count_ = 0;
 }
 
+size_t SampleStack::getStorageBytes() const
+{
+  return (deltas_.size() + spins_.size()) * sizeof(CompactRealType) + scalars_.size() * sizeof(SampleScalars) +
+      reference_R_.size() * sizeof(ParticleSet::SingleParticlePos);
+}
+
 SampleStack::~SampleStack() { clearEnsemble(); }
 
 void SampleStack::resetSampleCount() { current_sample_count_ = 0; }
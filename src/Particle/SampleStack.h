@@ -13,6 +13,10 @@
  * @brief Stores particle configurations for later use in DMC and wavefunction optimization
  *
  * Stores less temporary data than the buffer object.
+ * Only what is needed to reload a configuration is kept. The positions are stored in reduced
+ * precision as displacements from a full precision reference configuration, the first sample
+ * appended, in one contiguous [sample][particle][dim] array. Gradients and laplacians are not kept,
+ * every user of the samples reevaluates them.
  */
 
 #ifndef QMCPLUSPLUS_SAMPLE_STACK_H
@@ -22,6 +26,7 @@
 #include "Particle/ParticleSet.h"
 #include "Particle/Walker.h"
 #include "Particle/WalkerConfigurations.h"
+#include "type_traits/RefVectorWithLeader.h"
 
 namespace qmcplusplus
 {
@@ -31,16 +36,21 @@ class SampleStack
 {
 public:
   using PropertySetType = QMCTraits::PropertySetType;
+  using RealType        = QMCTraits::RealType;
+  /// storage type of the positions and spins of the samples
+  using CompactRealType = float;
 
   SampleStack();
 
+  /// set the number of particles. Otherwise it is taken from the first sample appended
   void setTotalNum(int total_num) { total_num_ = total_num; }
 
   int getMaxSamples() const { return max_samples_; }
 
-  bool empty() const { return sample_vector_.empty(); }
+  bool empty() const { return scalars_.empty(); }
 
-  MCSample& getSample(unsigned int i) const;
+  /// expand sample i into a full MCSample, G and L are zero
+  MCSample getSample(unsigned int i) const;
 
   //@{save/load/clear function for optimization
   inline int getNumSamples() const { return current_sample_count_; }
@@ -52,8 +62,12 @@ public:
   void saveEnsemble(std::vector<MCSample>& walker_list);
   /// load a single sample from SampleStack
   void loadSample(ParticleSet& pset, size_t iw) const;
+  /// load the consecutive samples [first, first + p_list.size()) into a crowd of particle sets
+  void loadSamples(const RefVectorWithLeader<ParticleSet>& p_list, size_t first) const;
 
   void appendSample(MCSample&& sample);
+  /// append the configuration of pset without going through a temporary MCSample
+  void appendSample(const ParticleSet& pset);
 
   ///clear the ensemble
   void clearEnsemble();
@@ -61,15 +75,39 @@ public:
   ///  Set the sample count to zero but preserve the storage
   void resetSampleCount();
 
+  /// bytes used by the stored samples
+  size_t getStorageBytes() const;
+
   ~SampleStack();
 
 private:
+  /// the scalars of MCSample
+  struct SampleScalars
+  {
+    RealType LogPsi, Sign, PE, KE;
+  };
+
+  /// offset of the first position component of sample iw in deltas_
+  size_t positionOffset(size_t iw) const { return iw * total_num_ * OHMMS_DIM; }
+  /// allocate the compact storage for max_samples_ samples of total_num_ particles
+  void allocate();
+  /// fix the layout and the reference configuration with the first sample
+  void setReference(const ParticleSet::ParticlePos& R);
+  /// store R and spins as sample current_sample_count_
+  void storeConfiguration(const ParticleSet::ParticlePos& R, const ParticleSet::ParticleScalar& spins);
+
   int total_num_;
   int max_samples_;
   int current_sample_count_;
   uint64_t global_num_samples_;
 
-  std::vector<MCSample*> sample_vector_;
+  /// full precision positions the sample positions are relative to
+  ParticleSet::ParticlePos reference_R_;
+  /// sample positions minus reference_R_, [sample][particle][dim]
+  std::vector<CompactRealType> deltas_;
+  /// sample spins, [sample][particle]
+  std::vector<CompactRealType> spins_;
+  std::vector<SampleScalars> scalars_;
 };
 
 
@@ -16,6 +16,8 @@
 #include "Lattice/ParticleBConds3DSoa.h"
 #include "DistanceTable.h"
 #include "CPU/SIMD/algorithm.hpp"
+#include "Utilities/FairDivide.h"
+#include "Concurrency/OpenMP.h"
 
 namespace qmcplusplus
 {
@@ -94,16 +96,20 @@ struct SoaDistanceTableAA : public DTD_BConds<T, D, SC>, public DistanceTableAA
 #if !defined(NDEBUG)
     old_prepared_elec_id_ = prepare_old ? iat : -1;
 #endif
-    DTD_BConds<T, D, SC>::computeDistances(rnew, P.getCoordinates().getAllParticlePos(), temp_r_.data(), temp_dr_, 0,
-                                           num_targets_, iat);
-    // set up old_r_ and old_dr_ for moves may get accepted.
-    if (prepare_old)
+    // split the rows among the nested threads of the walker, only worth it for large systems
+    if (num_targets_ >= nested_threading_min_size_)
     {
-      //recompute from scratch
-      DTD_BConds<T, D, SC>::computeDistances(P.R[iat], P.getCoordinates().getAllParticlePos(), old_r_.data(), old_dr_,
-                                             0, num_targets_, iat);
-      old_r_[iat] = std::numeric_limits<T>::max(); //assign a big number
+#pragma omp parallel
+      {
+        int first, last;
+        FairDivideAligned(num_targets_, getAlignment<T>(), omp_get_num_threads(), omp_get_thread_num(), first, last);
+        computeMoveDistances(P, rnew, iat, prepare_old, first, last);
+      }
     }
+    else
+      computeMoveDistances(P, rnew, iat, prepare_old, 0, num_targets_);
+    if (prepare_old)
+      old_r_[iat] = std::numeric_limits<T>::max(); //assign a big number
   }
 
   int get_first_neighbor(IndexType iat, RealType& r, PosType& dr, bool newpos) const override
@@ -192,7 +198,32 @@ struct SoaDistanceTableAA : public DTD_BConds<T, D, SC>, public DistanceTableAA
     }
   }
 
+  /// set the number of targets from which move() splits the row among the nested threads
+  void setNestedThreadingMinSize(int min_size) { nested_threading_min_size_ = min_size; }
+
 private:
+  /// number of targets from which move() uses the nested threads
+  int nested_threading_min_size_ = 1024;
+
+  /// distances of the targets in [first, last) to rnew, and to the old position if prepare_old
+  inline void computeMoveDistances(const ParticleSet& P,
+                                   const PosType& rnew,
+                                   const IndexType iat,
+                                   bool prepare_old,
+                                   int first,
+                                   int last)
+  {
+    DTD_BConds<T, D, SC>::computeDistances(rnew, P.getCoordinates().getAllParticlePos(), temp_r_.data(), temp_dr_,
+                                           first, last, iat);
+    // set up old_r_ and old_dr_ for moves may get accepted.
+    if (prepare_old)
+    {
+      //recompute from scratch
+      DTD_BConds<T, D, SC>::computeDistances(P.R[iat], P.getCoordinates().getAllParticlePos(), old_r_.data(), old_dr_,
+                                             first, last, iat);
+    }
+  }
+
   ///number of targets with padding
   const size_t num_targets_padded_;
 #if !defined(NDEBUG)
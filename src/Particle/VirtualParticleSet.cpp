@@ -194,4 +194,51 @@ void VirtualParticleSet::mw_makeMoves(const RefVectorWithLeader<VirtualParticleS
   ParticleSet::mw_update(p_list);
 }
 
+void VirtualParticleSet::mw_makeMovesWithSpin(const RefVectorWithLeader<VirtualParticleSet>& vp_list,
+                                              const RefVectorWithLeader<ParticleSet>& refp_list,
+                                              const RefVector<const std::vector<PosType>>& deltaV_list,
+                                              const RefVector<const std::vector<RealType>>& deltaS_list,
+                                              const RefVector<const NLPPJob<RealType>>& joblist,
+                                              bool sphere)
+{
+  auto& vp_leader = vp_list.getLeader();
+  assert(vp_leader.isSpinor());
+  vp_leader.onSphere = sphere;
+  vp_leader.refPS    = refp_list.getLeader();
+
+  const size_t nVPs = countVPs(vp_list);
+  auto& mw_refPctls = vp_leader.getMultiWalkerRefPctls();
+  mw_refPctls.resize(nVPs);
+
+  RefVectorWithLeader<ParticleSet> p_list(vp_leader);
+  p_list.reserve(vp_list.size());
+
+  size_t ivp = 0;
+  for (int iw = 0; iw < vp_list.size(); iw++)
+  {
+    VirtualParticleSet& vp(vp_list[iw]);
+    const std::vector<PosType>& deltaV(deltaV_list[iw]);
+    const std::vector<RealType>& deltaS(deltaS_list[iw]);
+    const NLPPJob<RealType>& job(joblist[iw]);
+
+    vp.onSphere      = sphere;
+    vp.refPS         = refp_list[iw];
+    vp.refPtcl       = job.electron_id;
+    vp.refSourcePtcl = job.ion_id;
+    assert(vp.R.size() == deltaV.size());
+    assert(vp.spins.size() == deltaS.size());
+    for (size_t k = 0; k < vp.R.size(); k++, ivp++)
+    {
+      vp.R[k]          = refp_list[iw].R[vp.refPtcl] + deltaV[k];
+      vp.spins[k]      = refp_list[iw].spins[vp.refPtcl] + deltaS[k];
+      mw_refPctls[ivp] = vp.refPtcl;
+    }
+    p_list.push_back(vp);
+  }
+  assert(ivp == nVPs);
+
+  mw_refPctls.updateTo();
+  ParticleSet::mw_update(p_list);
+}
+
 } // namespace qmcplusplus
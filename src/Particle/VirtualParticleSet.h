@@ -111,6 +111,16 @@ public:
                            const RefVector<const NLPPJob<RealType>>& joblist,
                            bool sphere);
 
+  /** move the virtual particles of all the walkers with both position and spin deltas
+   *  and update distance tables, the multi walker version of makeMovesWithSpin
+   */
+  static void mw_makeMovesWithSpin(const RefVectorWithLeader<VirtualParticleSet>& vp_list,
+                                   const RefVectorWithLeader<ParticleSet>& p_list,
+                                   const RefVector<const std::vector<PosType>>& deltaV_list,
+                                   const RefVector<const std::vector<RealType>>& deltaS_list,
+                                   const RefVector<const NLPPJob<RealType>>& joblist,
+                                   bool sphere);
+
   static RefVectorWithLeader<ParticleSet> RefVectorWithLeaderParticleSet(
       const RefVectorWithLeader<VirtualParticleSet>& vp_list)
   {
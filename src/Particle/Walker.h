@@ -26,6 +26,7 @@
 #include "Pools/PooledData.h"
 #include "Pools/PooledMemory.h"
 #include "QMCDrivers/WalkerProperties.h"
+#include "Utilities/PhiloxRandom.h"
 #ifdef QMC_CUDA
 #include "type_traits/CUDATypes.h"
 #include "Pools/PointerPool.h"
@@ -45,6 +46,7 @@ namespace qmcplusplus
  * - Age : generation after a move is accepted.
  * - Weight : weight to take the ensemble averages
  * - Multiplicity : multiplicity for branching. Probably can be removed.
+ * - RandomStream : random number stream owned by the walker, used by drivers with walker_random_streams
  * - Properties  : 2D container. RealType first index corresponds to the H/Psi index and second index >=WP::NUMPROPERTIES.
  * - DataSet : a contiguous buffer providing a state snapshot of most/all walker data. 
      Much complicated state management arises in keeping this up to date, 
@@ -92,6 +94,9 @@ public:
   using Buffer_t   = PooledData<RealType>;
   /** }@ */
 
+  ///counter-based engine of the per-walker random number stream, 16 bytes of state
+  using RandomStream_t = PhiloxRandom<FullPrecRealType>;
+
   ///id reserved for forward walking
   long ID;
   ///id reserved for forward walking
@@ -115,6 +120,12 @@ public:
   bool SendInProgress;
   /// if true, this walker is either copied or tranferred from another MPI rank.
   bool wasTouched = true;
+  /** random number stream of this walker
+   *
+   * Stream index 0 means unseeded. seedRandomStream selects the stream by the walker ID so that
+   * a walker draws the same numbers regardless of the crowd, thread or rank it lives on.
+   */
+  RandomStream_t RandomStream;
 
   /** The configuration vector (3N-dimensional vector to store
      the positions of all the particles for a single walker)*/
@@ -273,6 +284,18 @@ public:
   ///return the number of particles per walker
   inline int size() const { return R.size(); }
 
+  /** seed the random stream of this walker from a global seed and the walker ID
+   *
+   * IDs are positive, they are taken modulo 2^32 for the stream index.
+   */
+  inline void seedRandomStream(uint32_t global_seed)
+  {
+    RandomStream.seed(global_seed, static_cast<uint32_t>(ID));
+  }
+
+  ///return true if the random stream has been seeded by seedRandomStream
+  inline bool hasRandomStream() const { return RandomStream.stream() != 0; }
+
   ///resize for n particles
   inline void resize(int nptcl)
   {
@@ -299,6 +322,7 @@ public:
     Multiplicity       = a.Multiplicity;
     ReleasedNodeWeight = a.ReleasedNodeWeight;
     ReleasedNodeAge    = a.ReleasedNodeAge;
+    RandomStream       = a.RandomStream;
     if (R.size() != a.R.size())
       resize(a.R.size());
     R = a.R;
@@ -420,7 +444,7 @@ public:
 
   /** byte size for a packed message
    *
-   * ID, Age, Properties, R, Drift, DataSet is packed
+   * ID, Age, Properties, R, Drift, RandomStream, DataSet is packed
    */
   inline size_t byteSize()
   {
@@ -465,6 +489,8 @@ public:
     for (int iat = 0; iat < PropertyHistory.size(); iat++)
       DataSet.add(PropertyHistory[iat].data(), PropertyHistory[iat].data() + PropertyHistory[iat].size());
     DataSet.add(PHindex.data(), PHindex.data() + PHindex.size());
+    std::vector<typename RandomStream_t::uint_type> stream_state(RandomStream.state_size());
+    DataSet.add(stream_state.data(), stream_state.data() + stream_state.size());
 #ifdef QMC_CUDA
     size_t size = cuda_DataSet.size();
     size_t N    = R_GPU.size();
@@ -501,6 +527,9 @@ public:
     for (int iat = 0; iat < PropertyHistory.size(); iat++)
       DataSet.get(PropertyHistory[iat].data(), PropertyHistory[iat].data() + PropertyHistory[iat].size());
     DataSet.get(PHindex.data(), PHindex.data() + PHindex.size());
+    std::vector<typename RandomStream_t::uint_type> stream_state(RandomStream.state_size());
+    DataSet.get(stream_state.data(), stream_state.data() + stream_state.size());
+    RandomStream.load(stream_state);
 #ifdef QMC_CUDA
     // Unpack GPU data
     std::vector<CTS::ValueType> host_data;
@@ -551,6 +580,9 @@ public:
     for (int iat = 0; iat < PropertyHistory.size(); iat++)
       DataSet.put(PropertyHistory[iat].data(), PropertyHistory[iat].data() + PropertyHistory[iat].size());
     DataSet.put(PHindex.data(), PHindex.data() + PHindex.size());
+    std::vector<typename RandomStream_t::uint_type> stream_state;
+    RandomStream.save(stream_state);
+    DataSet.put(stream_state.data(), stream_state.data() + stream_state.size());
 #ifdef QMC_CUDA
     // Pack GPU data
     std::vector<CTS::ValueType> host_data;
@@ -0,0 +1,135 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+#include "WalkerAncestry.h"
+
+#include <numeric>
+#include <stdexcept>
+#include <unordered_map>
+#include "Message/Communicate.h"
+#include "mpi/collectives.h"
+
+namespace qmcplusplus
+{
+void WalkerAncestry::recordCopy(long child_id, long parent_id)
+{
+  if (enabled_)
+    current_.copies.emplace_back(child_id, parent_id);
+}
+
+void WalkerAncestry::recordDeath(long walker_id)
+{
+  if (enabled_)
+    current_.deaths.push_back(walker_id);
+}
+
+void WalkerAncestry::endGeneration()
+{
+  if (!enabled_)
+    return;
+  local_.push_back(std::move(current_));
+  current_ = Generation();
+  ++num_generations_;
+}
+
+void WalkerAncestry::synchronize(Communicate& comm)
+{
+  if (!enabled_)
+    return;
+  // per generation: number of copies, the (child, parent) pairs, number of deaths, the IDs
+  std::vector<long> send_buffer;
+  for (const Generation& generation : local_)
+  {
+    send_buffer.push_back(generation.copies.size());
+    for (auto& [child, parent] : generation.copies)
+    {
+      send_buffer.push_back(child);
+      send_buffer.push_back(parent);
+    }
+    send_buffer.push_back(generation.deaths.size());
+    send_buffer.insert(send_buffer.end(), generation.deaths.begin(), generation.deaths.end());
+  }
+
+  std::vector<int> send_size(1, send_buffer.size());
+  std::vector<int> counts(comm.size());
+  mpi::all_gather(comm, send_size, counts);
+  std::vector<int> displ(comm.size(), 0);
+  std::partial_sum(counts.begin(), counts.end() - 1, displ.begin() + 1);
+  std::vector<long> recv_buffer(displ.back() + counts.back());
+  mpi::all_gatherv(comm, send_buffer, recv_buffer, counts, displ);
+
+  // the events of a rank keep their order, a copy can be the parent of a later copy of the same generation
+  std::vector<int> cursor(displ);
+  for (int ig = 0; ig < local_.size(); ++ig)
+  {
+    Generation merged;
+    for (int rank = 0; rank < comm.size(); ++rank)
+    {
+      int& pos = cursor[rank];
+      if (pos >= displ[rank] + counts[rank])
+        throw std::runtime_error("WalkerAncestry::synchronize ranks ended different numbers of generations");
+      const long num_copies = recv_buffer[pos++];
+      for (long ic = 0; ic < num_copies; ++ic, pos += 2)
+        merged.copies.emplace_back(recv_buffer[pos], recv_buffer[pos + 1]);
+      const long num_deaths = recv_buffer[pos++];
+      merged.deaths.insert(merged.deaths.end(), recv_buffer.begin() + pos, recv_buffer.begin() + pos + num_deaths);
+      pos += num_deaths;
+    }
+    history_.push_back(std::move(merged));
+  }
+  local_.clear();
+}
+
+void WalkerAncestry::discardBefore(int generation)
+{
+  while (first_generation_ < generation && !history_.empty())
+  {
+    history_.pop_front();
+    ++first_generation_;
+  }
+}
+
+std::vector<int> WalkerAncestry::countDescendants(int first, int last, const std::vector<long>& ids) const
+{
+  if (first < first_generation_ || last >= get_num_synchronized())
+    throw std::runtime_error("WalkerAncestry::countDescendants generations outside of the history");
+
+  std::unordered_map<long, int> index;
+  for (int i = 0; i < ids.size(); ++i)
+    index[ids[i]] = i;
+  std::vector<int> counts(ids.size(), 1);
+  // the walkers copied since first, mapped to the position of their ancestor in ids
+  std::unordered_map<long, int> ancestor;
+  auto findAncestor = [&index, &ancestor](long id) {
+    auto born = ancestor.find(id);
+    if (born != ancestor.end())
+      return born->second;
+    auto original = index.find(id);
+    return original != index.end() ? original->second : -1;
+  };
+
+  for (int ig = first; ig <= last; ++ig)
+  {
+    const Generation& generation = getGeneration(ig);
+    for (auto& [child, parent] : generation.copies)
+      if (const int i = findAncestor(parent); i >= 0)
+      {
+        ++counts[i];
+        ancestor[child] = i;
+      }
+    for (long id : generation.deaths)
+      if (const int i = findAncestor(id); i >= 0)
+        --counts[i];
+  }
+  return counts;
+}
+
+} // namespace qmcplusplus
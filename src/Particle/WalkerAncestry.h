@@ -0,0 +1,89 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef QMCPLUSPLUS_WALKERANCESTRY_H
+#define QMCPLUSPLUS_WALKERANCESTRY_H
+
+#include <deque>
+#include <utility>
+#include <vector>
+
+class Communicate;
+
+namespace qmcplusplus
+{
+/** Record of the branching events of a DMC population, for forward walking.
+ *
+ *  Walker IDs are permanent and never reused. A walker surviving the branching keeps its ID,
+ *  so only the copies, with the ID of the walker they were copied from, and the killed walkers
+ *  are recorded. Generation g holds the events of the g-th branching on this population.
+ *
+ *  The events of the current generations are recorded rank locally, synchronize merges them over
+ *  the ranks into the history, which then holds the global ancestry regardless of where walkers
+ *  were sent during load balancing. Old generations are dropped with discardBefore so the history
+ *  is a window of generations moving with the run.
+ */
+class WalkerAncestry
+{
+public:
+  struct Generation
+  {
+    /// (ID of the copy, ID of the walker it was copied from)
+    std::vector<std::pair<long, long>> copies;
+    /// IDs of the walkers killed
+    std::vector<long> deaths;
+  };
+
+  /// nothing is recorded unless enabled
+  void enable() { enabled_ = true; }
+  bool isEnabled() const { return enabled_; }
+
+  void recordCopy(long child_id, long parent_id);
+  void recordDeath(long walker_id);
+  /// close the generation of the current branching
+  void endGeneration();
+
+  /** merge the generations recorded by all the ranks since the last call into the history
+   *  collective, all ranks must have ended the same number of generations
+   */
+  void synchronize(Communicate& comm);
+
+  /// number of generations ended on this rank
+  int get_num_generations() const { return num_generations_; }
+  /// generations up to this one are in the history
+  int get_num_synchronized() const { return first_generation_ + history_.size(); }
+  /// oldest generation in the history
+  int get_first_generation() const { return first_generation_; }
+  const Generation& getGeneration(int generation) const { return history_[generation - first_generation_]; }
+
+  /// drop the history before generation
+  void discardBefore(int generation);
+
+  /** number of walkers after the branching of generation last that descend from each walker of ids,
+   *  ids are walkers present before the branching of generation first.
+   *  The walker itself counts as its own descendant as long as it survives.
+   */
+  std::vector<int> countDescendants(int first, int last, const std::vector<long>& ids) const;
+
+private:
+  bool enabled_ = false;
+  int num_generations_ = 0;
+  int first_generation_ = 0;
+  /// generation being recorded
+  Generation current_;
+  /// ended generations not yet synchronized
+  std::vector<Generation> local_;
+  /// synchronized generations from first_generation_ on
+  std::deque<Generation> history_;
+};
+
+} // namespace qmcplusplus
+#endif
@@ -18,6 +18,9 @@
 
 
 #include "WalkerConfigurations.h"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
 #include <map>
 #include "Utilities/IteratorUtility.h"
 
@@ -147,4 +150,34 @@ void WalkerConfigurations::putConfigurations(Walker_t::RealType* target) const
   }
 }
 
+void WalkerConfigurations::putRandomStreams(int* target) const
+{
+  std::vector<Walker_t::RandomStream_t::uint_type> state;
+  for (const auto& walker : WalkerList)
+  {
+    if (walker->hasRandomStream())
+    {
+      walker->RandomStream.save(state);
+      assert(state.size() == random_stream_size);
+      std::memcpy(target, state.data(), random_stream_size * sizeof(int));
+    }
+    else
+      std::fill(target, target + random_stream_size, 0);
+    target += random_stream_size;
+  }
+}
+
+void WalkerConfigurations::getRandomStreams(const int* source, size_t first, size_t num_walkers)
+{
+  std::vector<Walker_t::RandomStream_t::uint_type> state(random_stream_size);
+  for (size_t iw = first; iw < first + num_walkers; iw++)
+  {
+    std::memcpy(state.data(), source, random_stream_size * sizeof(int));
+    // a row of zeros is an unseeded stream, keep the default one
+    if (std::any_of(state.begin(), state.end(), [](auto word) { return word != 0; }))
+      WalkerList[iw]->RandomStream.load(state);
+    source += random_stream_size;
+  }
+}
+
 } // namespace qmcplusplus
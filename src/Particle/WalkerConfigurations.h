@@ -189,6 +189,17 @@ public:
   ///save the particle positions of all the walkers into target
   void putConfigurations(Walker_t::RealType* target) const;
 
+  ///number of integers putRandomStreams saves per walker
+  static constexpr size_t random_stream_size = 4;
+  /** save the random stream states of all the walkers into target
+   *
+   * The 32 bit state words are stored as the bit pattern of int, an unseeded stream is stored as zeros.
+   */
+  void putRandomStreams(int* target) const;
+  /** restore the random stream states of the walkers starting at first from source written by putRandomStreams
+   */
+  void getRandomStreams(const int* source, size_t first, size_t num_walkers);
+
 protected:
   ///number of walkers on a node
   int LocalNumWalkers;
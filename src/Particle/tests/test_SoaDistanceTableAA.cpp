@@ -17,6 +17,7 @@
 #include "ParticleSet.h"
 #include "Lattice/ParticleBConds3DSoa.h"
 #include "SoaDistanceTableAA.h"
+#include "Concurrency/OpenMP.h"
 
 namespace qmcplusplus
 {
@@ -49,4 +50,44 @@ TEST_CASE("SoaDistanceTableAA compute_size", "[distance_table]")
       CHECK(dt_ee.compute_size(i) == ref_results[i]);
   }
 }
+
+TEST_CASE("SoaDistanceTableAA move with nested threads", "[distance_table]")
+{
+  const SimulationCell simulation_cell;
+  ParticleSet elec(simulation_cell);
+
+  elec.setName("e");
+  elec.create({20, 20});
+  for (int iat = 0; iat < elec.getTotalNum(); iat++)
+    elec.R[iat] = {std::sin(1.1 * iat), std::cos(0.7 * iat), 0.05 * iat};
+
+  using DTType = SoaDistanceTableAA<OHMMS_PRECISION, OHMMS_DIM, SUPERCELL_OPEN + SOA_OFFSET>;
+  DTType dt_serial(elec);
+  DTType dt_split(elec);
+  // split the row even for this small system
+  dt_split.setNestedThreadingMinSize(1);
+
+  dt_serial.evaluate(elec);
+  dt_split.evaluate(elec);
+
+  // a team of threads at the top level stands in for the nested team of a crowd
+  const int saved_num_threads = omp_get_max_threads();
+  omp_set_num_threads(3);
+  const int iat = 7;
+  const ParticleSet::PosType rnew(0.3, -0.2, 0.9);
+  dt_serial.move(elec, rnew, iat, true);
+  dt_split.move(elec, rnew, iat, true);
+  omp_set_num_threads(saved_num_threads);
+
+  for (int jat = 0; jat < elec.getTotalNum(); jat++)
+  {
+    CHECK(dt_split.getTempDists()[jat] == Approx(dt_serial.getTempDists()[jat]));
+    CHECK(dt_split.getOldDists()[jat] == Approx(dt_serial.getOldDists()[jat]));
+    for (int idim = 0; idim < OHMMS_DIM; idim++)
+    {
+      CHECK(dt_split.getTempDispls()[jat][idim] == Approx(dt_serial.getTempDispls()[jat][idim]));
+      CHECK(dt_split.getOldDispls()[jat][idim] == Approx(dt_serial.getOldDispls()[jat][idim]));
+    }
+  }
+}
 } // namespace qmcplusplus
@@ -0,0 +1,72 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "Particle/WalkerAncestry.h"
+#include "Message/Communicate.h"
+
+namespace qmcplusplus
+{
+TEST_CASE("WalkerAncestry::disabled", "[particle]")
+{
+  WalkerAncestry ancestry;
+  ancestry.recordCopy(2, 1);
+  ancestry.endGeneration();
+  ancestry.synchronize(*OHMMS::Controller);
+  CHECK_FALSE(ancestry.isEnabled());
+  CHECK(ancestry.get_num_generations() == 0);
+  CHECK(ancestry.get_num_synchronized() == 0);
+}
+
+TEST_CASE("WalkerAncestry::countDescendants", "[particle]")
+{
+  Communicate* comm = OHMMS::Controller;
+  WalkerAncestry ancestry;
+  ancestry.enable();
+
+  // generation 0: 1 -> 1, 4 and a copy of the copy 6, 3 dies
+  ancestry.recordDeath(3);
+  ancestry.recordCopy(4, 1);
+  ancestry.recordCopy(6, 4);
+  ancestry.endGeneration();
+  // generation 1: 4 -> 4, 5 and 2 dies
+  ancestry.recordDeath(2);
+  ancestry.recordCopy(5, 4);
+  ancestry.endGeneration();
+  CHECK(ancestry.get_num_generations() == 2);
+  CHECK(ancestry.get_num_synchronized() == 0);
+
+  ancestry.synchronize(*comm);
+  REQUIRE(ancestry.get_num_synchronized() == 2);
+  CHECK(ancestry.getGeneration(0).copies.size() == 2);
+  CHECK(ancestry.getGeneration(1).deaths.size() == 1);
+  // generation 2 is empty
+  ancestry.endGeneration();
+  ancestry.synchronize(*comm);
+  CHECK(ancestry.get_num_synchronized() == 3);
+
+  std::vector<long> ids{1, 2, 3};
+  auto counts = ancestry.countDescendants(0, 0, ids);
+  CHECK(counts == std::vector<int>{3, 1, 0});
+  counts = ancestry.countDescendants(0, 2, ids);
+  CHECK(counts == std::vector<int>{4, 0, 0});
+  std::vector<long> later_ids{1, 2, 4, 6};
+  counts = ancestry.countDescendants(1, 2, later_ids);
+  CHECK(counts == std::vector<int>{1, 0, 2, 1});
+
+  ancestry.discardBefore(1);
+  CHECK(ancestry.get_first_generation() == 1);
+  CHECK_THROWS(ancestry.countDescendants(0, 2, ids));
+  CHECK_THROWS(ancestry.countDescendants(1, 3, later_ids));
+}
+
+} // namespace qmcplusplus
@@ -70,5 +70,63 @@ TEST_CASE("SampleStack", "[particle]")
   REQUIRE(samples.getNumSamples() == 0);
 }
 
+TEST_CASE("SampleStack compact storage", "[particle]")
+{
+  const SimulationCell simulation_cell;
+  ParticleSet elec(simulation_cell);
+  elec.setName("e");
+  elec.create({2});
+  elec.R[0] = {1.0, 2.0, 3.0};
+  elec.R[1] = {-1.0, 0.5, 100.0};
+  elec.spins = {0.25, -0.5};
+
+  SampleStack samples;
+  samples.setMaxSamples(3);
+  REQUIRE(samples.getNumSamples() == 0);
+
+  // the first sample is the reference of the layout
+  samples.appendSample(elec);
+  elec.R[0][0] = 1.125;
+  elec.R[1][2] = 100.25;
+  elec.spins[1] = 0.75;
+  samples.appendSample(elec);
+  elec.R[0][1] = -2.0;
+  samples.appendSample(elec);
+  // ignored, the stack is full
+  samples.appendSample(elec);
+  REQUIRE(samples.getNumSamples() == 3);
+
+  // positions, spins and the scalars only
+  CHECK(samples.getStorageBytes() ==
+        3 * 2 * (OHMMS_DIM + 1) * sizeof(SampleStack::CompactRealType) + 3 * 4 * sizeof(SampleStack::RealType) +
+            2 * sizeof(ParticleSet::SingleParticlePos));
+
+  ParticleSet elec2(elec);
+  elec2.R = 0.0;
+  samples.loadSample(elec2, 1);
+  CHECK(elec2.R[0][0] == Approx(1.125));
+  CHECK(elec2.R[0][1] == Approx(2.0));
+  CHECK(elec2.R[1][2] == Approx(100.25));
+  CHECK(elec2.spins[0] == Approx(0.25));
+  CHECK(elec2.spins[1] == Approx(0.75));
+
+  // crowd sized batch
+  ParticleSet elec3(elec);
+  RefVectorWithLeader<ParticleSet> p_list(elec2, {elec2, elec3});
+  samples.loadSamples(p_list, 1);
+  CHECK(elec2.R[0][1] == Approx(2.0));
+  CHECK(elec3.R[0][1] == Approx(-2.0));
+  CHECK(elec3.R[1][0] == Approx(-1.0));
+
+  MCSample sample = samples.getSample(0);
+  CHECK(sample.R[1][2] == Approx(100.0));
+  CHECK(sample.spins[1] == Approx(-0.5));
+
+  // the reference is kept over a reset
+  samples.resetSampleCount();
+  samples.appendSample(elec);
+  samples.loadSample(elec2, 0);
+  CHECK(elec2.R[0][1] == Approx(-2.0));
+}
 
 } // namespace qmcplusplus
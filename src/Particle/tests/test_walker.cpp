@@ -128,4 +128,77 @@ TEST_CASE("walker buffer add, update, restore", "[particle]")
   CHECK(walkers[1]->Properties(WP::LOCALPOTENTIAL) == Approx(1.6));
 }
 
+TEST_CASE("walker random stream", "[particle]")
+{
+  const size_t num_ptcls = 1;
+  MCPWalker w1(num_ptcls);
+  MCPWalker w2(num_ptcls);
+  CHECK(!w1.hasRandomStream());
+
+  w1.ID = 3;
+  w2.ID = 4;
+  w1.seedRandomStream(5);
+  w2.seedRandomStream(5);
+  CHECK(w1.hasRandomStream());
+  CHECK(w1.RandomStream() != w2.RandomStream());
+
+  // the stream is carried in the buffer sent between ranks
+  w1.registerData();
+  w1.DataSet.allocate();
+  w1.RandomStream();
+  w1.updateBuffer();
+  const auto expected = w1.RandomStream();
+
+  MCPWalker w3(num_ptcls);
+  w3.registerData();
+  w3.DataSet.allocate();
+  std::memcpy(w3.DataSet.data(), w1.DataSet.data(), w1.DataSet.size());
+  w3.copyFromBuffer();
+  CHECK(w3.RandomStream() == expected);
+
+  MCPWalker w4(num_ptcls);
+  w4.makeCopy(w1);
+  CHECK(w4.RandomStream() == w1.RandomStream());
+}
+
+TEST_CASE("walker random stream HDF read and write", "[particle]")
+{
+  Communicate* c = OHMMS::Controller;
+
+  const size_t num_ptcls = 1;
+  WalkerConfigurations wc_list;
+  wc_list.createWalkers(2, num_ptcls);
+  // the second walker is left unseeded
+  wc_list[0]->ID = 7;
+  wc_list[0]->seedRandomStream(11);
+  wc_list[0]->RandomStream();
+
+  std::vector<int> walker_offset(c->size() + 1);
+  walker_offset[0] = 0;
+  int offset       = 2;
+  for (int i = 0; i < c->size(); i++)
+  {
+    walker_offset[i + 1] = offset;
+    offset += 2;
+  }
+  wc_list.setWalkerOffsets(walker_offset);
+
+  c->setName("walker_stream_test");
+  HDFWalkerOutput hout(num_ptcls, "", c);
+  hout.dump(wc_list, 0);
+
+  c->barrier();
+
+  WalkerConfigurations wc_list2;
+  HDFVersion version(0, 4);
+  HDFWalkerInput_0_4 hinp(wc_list2, num_ptcls, c, version);
+  REQUIRE(hinp.read_hdf5("walker_stream_test.config.h5"));
+
+  REQUIRE(wc_list2.getActiveWalkers() == 2);
+  CHECK(wc_list2[0]->RandomStream.stream() == 7);
+  CHECK(wc_list2[0]->RandomStream.position() == 1);
+  CHECK(wc_list2[0]->RandomStream() == wc_list[0]->RandomStream());
+  CHECK(!wc_list2[1]->hasRandomStream());
+}
+
 } // namespace qmcplusplus
@@ -19,6 +19,7 @@
 #include "Particle/Walker.h"
 #include "QMCDrivers/Crowd.h"
 #include "ParticleBase/RandomSeqGenerator.h"
+#include "QMCDrivers/CrowdStepBuffers.hpp"
 
 namespace qmcplusplus
 {
@@ -27,6 +28,8 @@ namespace qmcplusplus
  *  created once per driver per crowd
  *  It's two significant responsibilities are holding the thread local RandomGen_t
  *  And the particle group indexes.
+ *  It also keeps the per walker buffers of the particle-by-particle moves of the crowd
+ *  so they are not reallocated every step.
  *
  *  
  */
@@ -37,8 +40,19 @@ public:
 
   RandomGenerator& get_random_gen() { return random_gen_; }
 
+  template<CoordsType CT>
+  CrowdStepBuffers<CT>& get_step_buffers()
+  {
+    if constexpr (CT == CoordsType::POS_SPIN)
+      return step_buffers_pos_spin_;
+    else
+      return step_buffers_pos_;
+  }
+
 protected:
   RandomGenerator& random_gen_;
+  CrowdStepBuffers<CoordsType::POS> step_buffers_pos_;
+  CrowdStepBuffers<CoordsType::POS_SPIN> step_buffers_pos_spin_;
 };
 
 } // namespace qmcplusplus
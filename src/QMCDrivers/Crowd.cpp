@@ -8,6 +8,7 @@
 //////////////////////////////////////////////////////////////////////////////////////
 
 #include "Crowd.h"
+#include <type_traits>
 #include "QMCHamiltonians/QMCHamiltonian.h"
 
 namespace qmcplusplus
@@ -74,6 +75,24 @@ void Crowd::setRNGForHamiltonian(RandomGenerator& rng)
     ham.setRandomGenerator(&rng);
 }
 
+bool Crowd::setWalkerRNGForHamiltonian(RandomGenerator& rng)
+{
+  if (!std::is_same_v<RandomGenerator, MCPWalker::RandomStream_t>)
+  {
+    setRNGForHamiltonian(rng);
+    return false;
+  }
+
+  // generic so that the mismatching engine types are never instantiated
+  auto setWalkerRNG = [](QMCHamiltonian& ham, auto& stream) {
+    if constexpr (std::is_same_v<std::decay_t<decltype(stream)>, RandomGenerator>)
+      ham.setRandomGenerator(&stream);
+  };
+  for (int iw = 0; iw < walker_hamiltonians_.size(); ++iw)
+    setWalkerRNG(walker_hamiltonians_[iw], mcp_walkers_[iw].get().RandomStream);
+  return true;
+}
+
 void Crowd::startBlock(int num_steps)
 {
   n_accept_ = 0;
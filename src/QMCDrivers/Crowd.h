@@ -84,6 +84,12 @@ public:
   }
 
   void setRNGForHamiltonian(RandomGenerator& rng);
+  /** set the random stream of each walker as the random number generator of its Hamiltonian
+   *
+   *  Only possible if RandomGenerator is the walker stream engine, otherwise rng is set as in setRNGForHamiltonian.
+   *  \return true if the walker streams are used
+   */
+  bool setWalkerRNGForHamiltonian(RandomGenerator& rng);
 
   auto beginWalkers() { return mcp_walkers_.begin(); }
   auto endWalkers() { return mcp_walkers_.end(); }
@@ -0,0 +1,131 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "CrowdStepBuffers.hpp"
+#include <cassert>
+#include <cmath>
+
+namespace qmcplusplus
+{
+template<CoordsType CT>
+CrowdStepBuffers<CT>::CrowdStepBuffers()
+    : walker_deltas(0), deltas(0), drifts(0), drifts_reverse(0), grads_now(0), grads_new(0)
+{}
+
+template<CoordsType CT>
+void CrowdStepBuffers<CT>::prepareStep(int num_walkers, int num_particles)
+{
+  if (num_walkers != num_walkers_ || num_particles != num_particles_)
+  {
+    num_walkers_   = num_walkers;
+    num_particles_ = num_particles;
+    walker_deltas.positions.resize(num_walkers * num_particles);
+    for (auto* coords : {&deltas, &drifts, &drifts_reverse})
+      coords->positions.resize(num_walkers);
+    for (auto* grads : {&grads_now, &grads_new})
+      grads->grads_positions.resize(num_walkers);
+    if constexpr (CT == CoordsType::POS_SPIN)
+    {
+      walker_deltas.spins.resize(num_walkers * num_particles);
+      for (auto* coords : {&deltas, &drifts, &drifts_reverse})
+        coords->spins.resize(num_walkers);
+      for (auto* grads : {&grads_now, &grads_new})
+        grads->grads_spins.resize(num_walkers);
+    }
+    ratios.resize(num_walkers);
+    for (auto* values : {&log_gf, &log_gb, &prob, &rr, &rr_proposed, &rr_accepted})
+      values->resize(num_walkers);
+    isAccepted.resize(num_walkers);
+  }
+  std::fill(log_gf.begin(), log_gf.end(), 0.0);
+  std::fill(log_gb.begin(), log_gb.end(), 0.0);
+  std::fill(rr_proposed.begin(), rr_proposed.end(), 0.0);
+  std::fill(rr_accepted.begin(), rr_accepted.end(), 0.0);
+}
+
+template<CoordsType CT>
+void CrowdStepBuffers<CT>::loadDeltas(int iat, const TauParams<RealType, CT>& taus)
+{
+  const size_t offset = static_cast<size_t>(iat) * num_walkers_;
+  assert(offset + num_walkers_ <= walker_deltas.positions.size());
+  const auto* restrict delta_in = walker_deltas.positions.data() + offset;
+  auto* restrict delta_out      = deltas.positions.data();
+  auto* restrict rr_out         = rr.data();
+  for (int iw = 0; iw < num_walkers_; ++iw)
+  {
+    rr_out[iw]    = taus.tauovermass * dot(delta_in[iw], delta_in[iw]);
+    delta_out[iw] = delta_in[iw] * taus.sqrttau;
+  }
+  if constexpr (CT == CoordsType::POS_SPIN)
+  {
+    const auto* restrict spin_in = walker_deltas.spins.data() + offset;
+    auto* restrict spin_out      = deltas.spins.data();
+    for (int iw = 0; iw < num_walkers_; ++iw)
+      spin_out[iw] = spin_in[iw] * taus.spin_sqrttau;
+  }
+}
+
+template<CoordsType CT>
+void CrowdStepBuffers<CT>::accumulateRR()
+{
+  for (int iw = 0; iw < num_walkers_; ++iw)
+  {
+    rr_proposed[iw] += rr[iw];
+    if (isAccepted[iw])
+      rr_accepted[iw] += rr[iw];
+  }
+}
+
+template<CoordsType CT>
+void CrowdStepBuffers<CT>::computeAcceptance(const TauParams<RealType, CT>& taus, bool use_drift)
+{
+  const auto* restrict ratio = ratios.data();
+  auto* restrict prob_out    = prob.data();
+  if (!use_drift)
+  {
+    for (int iw = 0; iw < num_walkers_; ++iw)
+      prob_out[iw] = std::norm(ratio[iw]);
+    return;
+  }
+
+  const auto* restrict delta     = deltas.positions.data();
+  const auto* restrict drift     = drifts.positions.data();
+  const auto* restrict drift_new = drifts_reverse.positions.data();
+  auto* restrict gf              = log_gf.data();
+  auto* restrict gb              = log_gb.data();
+  const RealType halfovertau     = taus.oneover2tau;
+  for (int iw = 0; iw < num_walkers_; ++iw)
+  {
+    const auto reverse = drift_new[iw] + drift[iw];
+    gf[iw]             = -halfovertau * dot(delta[iw], delta[iw]);
+    gb[iw]             = -halfovertau * dot(reverse, reverse);
+  }
+  if constexpr (CT == CoordsType::POS_SPIN)
+  {
+    const auto* restrict spin_delta     = deltas.spins.data();
+    const auto* restrict spin_drift     = drifts.spins.data();
+    const auto* restrict spin_drift_new = drifts_reverse.spins.data();
+    const RealType spin_halfovertau     = taus.spin_oneover2tau;
+    for (int iw = 0; iw < num_walkers_; ++iw)
+    {
+      const auto spin_reverse = spin_drift_new[iw] + spin_drift[iw];
+      gf[iw] -= spin_halfovertau * spin_delta[iw] * spin_delta[iw];
+      gb[iw] -= spin_halfovertau * spin_reverse * spin_reverse;
+    }
+  }
+  for (int iw = 0; iw < num_walkers_; ++iw)
+    prob_out[iw] = std::norm(ratio[iw]) * std::exp(gb[iw] - gf[iw]);
+}
+
+template class CrowdStepBuffers<CoordsType::POS>;
+template class CrowdStepBuffers<CoordsType::POS_SPIN>;
+} // namespace qmcplusplus
@@ -0,0 +1,91 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef QMCPLUSPLUS_CROWDSTEPBUFFERS_HPP
+#define QMCPLUSPLUS_CROWDSTEPBUFFERS_HPP
+
+#include <vector>
+#include "Configuration.h"
+#include "Particle/MCCoords.hpp"
+#include "QMCWaveFunctions/TWFGrads.hpp"
+#include "QMCDrivers/TauParams.hpp"
+
+namespace qmcplusplus
+{
+/** Per crowd work space of the particle-by-particle drift-diffusion step.
+ *
+ *  The batched drivers move one electron of all the walkers of a crowd at a time.
+ *  All the per walker temporaries of such a move live here as walker indexed arrays so
+ *  they are allocated once per crowd and reused for every electron, sub step and step.
+ *  The arithmetic between the multi walker wavefunction and particle set calls
+ *  is done by the fused loops loadDeltas and computeAcceptance over the walkers.
+ */
+template<CoordsType CT>
+class CrowdStepBuffers
+{
+public:
+  using RealType     = QMCTraits::RealType;
+  using PsiValueType = QMCTraits::QTFull::ValueType;
+
+  CrowdStepBuffers();
+
+  /** size the buffers for a step of the crowd and zero the per step accumulators.
+   *  Nothing is allocated if the crowd and the particle set keep their sizes.
+   */
+  void prepareStep(int num_walkers, int num_particles);
+
+  int getNumWalkers() const { return num_walkers_; }
+
+  /** take the gaussian deltas of particle iat for all the walkers from walker_deltas,
+   *  record their squared length in rr and scale them by sqrt(tau)
+   */
+  void loadDeltas(int iat, const TauParams<RealType, CT>& taus);
+
+  /** add rr of the proposed move to rr_proposed and rr_accepted when accepted */
+  void accumulateRR();
+
+  /** compute log_gf, log_gb and the acceptance probability prob of the move from
+   *  ratios, deltas, drifts and drifts_reverse, which holds the drift of the new position.
+   *  Without drift only the ratios are used.
+   */
+  void computeAcceptance(const TauParams<RealType, CT>& taus, bool use_drift);
+
+  /// gaussian deltas of a whole step, particle major as filled by makeGaussRandomWithEngine
+  MCCoords<CT> walker_deltas;
+  /// deltas of the particle moved
+  MCCoords<CT> deltas;
+  /// drift plus diffusion of the move
+  MCCoords<CT> drifts;
+  /// drift at the proposed position
+  MCCoords<CT> drifts_reverse;
+  TWFGrads<CT> grads_now;
+  TWFGrads<CT> grads_new;
+  std::vector<PsiValueType> ratios;
+  std::vector<RealType> log_gf;
+  std::vector<RealType> log_gb;
+  std::vector<RealType> prob;
+  /// tau/mass scaled squared length of the move
+  std::vector<RealType> rr;
+  std::vector<RealType> rr_proposed;
+  std::vector<RealType> rr_accepted;
+  std::vector<bool> isAccepted;
+
+private:
+  int num_walkers_   = 0;
+  int num_particles_ = 0;
+};
+
+extern template class CrowdStepBuffers<CoordsType::POS>;
+extern template class CrowdStepBuffers<CoordsType::POS_SPIN>;
+} // namespace qmcplusplus
+
+#endif
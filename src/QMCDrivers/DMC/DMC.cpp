@@ -63,6 +63,7 @@ DMC::DMC(const ProjectData& project_data,
   m_param.add(NonLocalMove, "nonlocalmoves");
   m_param.add(mover_MaxAge, "MaxAge");
   m_param.add(L2, "L2_diffusion");
+  m_param.add(walker_buffer_, "walker_buffer", {"yes", "no", "auto"});
 }
 
 void DMC::resetUpdateEngines()
@@ -122,6 +123,9 @@ void DMC::resetUpdateEngines()
     for (int ip = 0; ip < NumThreads; ++ip)
       estimatorClones[ip] = new EstimatorManagerBase(*Estimators);
 
+    const bool keep_walker_buffer =
+        qmc_driver_mode[QMC_UPDATE_MODE] ? keepWalkerBuffer(*wClones[0], *psiClones[0]) : true;
+
 #pragma omp parallel for
     for (int ip = 0; ip < NumThreads; ++ip)
     {
@@ -144,6 +148,7 @@ void DMC::resetUpdateEngines()
           Movers[ip]->setSpinMass(SpinMass);
           Movers[ip]->put(qmcNode);
           Movers[ip]->resetRun(branchEngine.get(), estimatorClones[ip], traceClones[ip], DriftModifier);
+          Movers[ip]->setKeepWalkerBuffer(keep_walker_buffer);
           Movers[ip]->initWalkersForPbyP(W.begin() + wPerRank[ip], W.begin() + wPerRank[ip + 1]);
         }
         else
@@ -162,6 +167,7 @@ void DMC::resetUpdateEngines()
 
           Movers[ip]->put(qmcNode);
           Movers[ip]->resetRun(branchEngine.get(), estimatorClones[ip], traceClones[ip], DriftModifier);
+          Movers[ip]->setKeepWalkerBuffer(keep_walker_buffer);
           Movers[ip]->initWalkersForPbyP(W.begin() + wPerRank[ip], W.begin() + wPerRank[ip + 1]);
         }
         else
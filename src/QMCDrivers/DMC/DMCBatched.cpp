@@ -12,6 +12,8 @@
 #include <functional>
 #include <cassert>
 #include <cmath>
+#include <algorithm>
+#include <iomanip>
 
 #include "DMCBatched.h"
 #include "QMCDrivers/GreenFunctionModifiers/DriftModifierBase.h"
@@ -22,6 +24,7 @@
 #include "ParticleBase/RandomSeqGenerator.h"
 #include "Utilities/RunTimeManager.h"
 #include "Utilities/ProgressReportEngine.h"
+#include "Utilities/Timer.h"
 #include "QMCDrivers/DMC/WalkerControl.h"
 #include "QMCDrivers/SFNBranch.h"
 #include "EstimatorInputDelegates.h"
@@ -111,30 +114,24 @@ void DMCBatched::advanceWalkers(const StateForThread& sft,
   auto& pset_leader       = walker_elecs.getLeader();
   const int num_particles = pset_leader.getTotalNum();
 
-  MCCoords<CT> drifts(num_walkers), drifts_reverse(num_walkers);
-  MCCoords<CT> walker_deltas(num_walkers * num_particles), deltas(num_walkers);
-  TWFGrads<CT> grads_now(num_walkers), grads_new(num_walkers);
+  // preallocated per walker temporaries of the moves, reused by every electron
+  auto& buffers = step_context.get_step_buffers<CT>();
+  buffers.prepareStep(num_walkers, num_particles);
 
-  //This generates an entire steps worth of deltas.
-  makeGaussRandomWithEngine(walker_deltas, step_context.get_random_gen());
-
-  std::vector<TrialWaveFunction::PsiValueType> ratios(num_walkers, TrialWaveFunction::PsiValueType(0.0));
-  std::vector<RealType> log_gf(num_walkers, 0.0);
-  std::vector<RealType> log_gb(num_walkers, 0.0);
-  std::vector<RealType> prob(num_walkers, 0.0);
+  // draw from the random streams of the walkers instead of the one of the crowd
+  const bool walker_streams = sft.qmcdrv_input.get_walker_random_streams();
 
-  // local list to handle accept/reject
-  std::vector<bool> isAccepted;
-  isAccepted.reserve(num_walkers);
+  //This generates an entire steps worth of deltas.
+  if (walker_streams)
+    makeGaussRandomWithWalkerStreams(walkers, buffers.walker_deltas);
+  else
+    makeGaussRandomWithEngine(buffers.walker_deltas, step_context.get_random_gen());
 
   //save the old energies for branching needs.
   std::vector<FullPrecRealType> old_energies(num_walkers);
   for (int iw = 0; iw < num_walkers; ++iw)
     old_energies[iw] = walkers[iw].get().Properties(WP::LOCALENERGY);
 
-  std::vector<RealType> rr_proposed(num_walkers, 0.0);
-  std::vector<RealType> rr_accepted(num_walkers, 0.0);
-
   {
     ScopedTimer pbyp_local_timer(timers.movepbyp_timer);
     for (int ig = 0; ig < pset_leader.groups(); ++ig)
@@ -155,21 +152,14 @@ void DMCBatched::advanceWalkers(const StateForThread& sft,
                                                    : walkers_who_have_been_on_wire[iw] = 0;
         }
 #endif
-        //get deltas for this particle for all walkers
-        walker_deltas.getSubset(iat * num_walkers, num_walkers, deltas);
-
-        // only DMC does this
+        //get deltas for this particle for all walkers, scaled by sqrt(tau)
+        // only DMC uses buffers.rr
         // TODO: rr needs a real name
-        std::vector<RealType> rr(num_walkers, 0.0);
-        assert(rr.size() == deltas.positions.size());
-        std::transform(deltas.positions.begin(), deltas.positions.end(), rr.begin(),
-                       [t = taus.tauovermass](auto& delta_r) { return t * dot(delta_r, delta_r); });
+        buffers.loadDeltas(iat, taus);
 
-        twf_dispatcher.flex_evalGrad(walker_twfs, walker_elecs, iat, grads_now);
-        sft.drift_modifier.getDrifts(taus, grads_now, drifts);
-
-        scaleBySqrtTau(taus, deltas);
-        drifts += deltas;
+        twf_dispatcher.flex_evalGrad(walker_twfs, walker_elecs, iat, buffers.grads_now);
+        sft.drift_modifier.getDrifts(taus, buffers.grads_now, buffers.drifts);
+        buffers.drifts += buffers.deltas;
 
 // in DMC this was done here, changed to match VMCBatched pending factoring to common source
 // if (rr > m_r2max)
@@ -178,62 +168,40 @@ void DMCBatched::advanceWalkers(const StateForThread& sft,
 //   continue;
 // }
 #ifndef NDEBUG
-        for (int i = 0; i < rr.size(); ++i)
-          assert(std::isfinite(rr[i]));
+        for (int i = 0; i < buffers.rr.size(); ++i)
+          assert(std::isfinite(buffers.rr[i]));
 #endif
 
-        ps_dispatcher.flex_makeMove(walker_elecs, iat, drifts);
-
-        twf_dispatcher.flex_calcRatioGrad(walker_twfs, walker_elecs, iat, ratios, grads_new);
-
-        computeLogGreensFunction(deltas, taus, log_gf);
+        ps_dispatcher.flex_makeMove(walker_elecs, iat, buffers.drifts);
 
-        sft.drift_modifier.getDrifts(taus, grads_new, drifts_reverse);
+        twf_dispatcher.flex_calcRatioGrad(walker_twfs, walker_elecs, iat, buffers.ratios, buffers.grads_new);
 
-        drifts_reverse += drifts;
+        sft.drift_modifier.getDrifts(taus, buffers.grads_new, buffers.drifts_reverse);
 
-        computeLogGreensFunction(drifts_reverse, taus, log_gb);
-
-        auto checkPhaseChanged = [&sft](const TrialWaveFunction& twf, int& is_reject) {
-          if (sft.branch_engine.phaseChanged(twf.getPhaseDiff()))
-            is_reject = 1;
-          else
-            is_reject = 0;
-        };
+        buffers.computeAcceptance(taus, true);
 
         // Hopefully a phase change doesn't make any of these transformations fail.
-        std::vector<int> rejects(num_walkers); // instead of std::vector<bool>
         for (int iw = 0; iw < num_walkers; ++iw)
         {
-          checkPhaseChanged(walker_twfs[iw], rejects[iw]);
-          //This is just convenient to do here
-          rr_proposed[iw] += rr[iw];
-        }
-
-        for (int iw = 0; iw < num_walkers; ++iw)
-          prob[iw] = std::norm(ratios[iw]) * std::exp(log_gb[iw] - log_gf[iw]);
-
-        isAccepted.clear();
-
-        for (int iw = 0; iw < num_walkers; ++iw)
-        {
-          if ((!rejects[iw]) && prob[iw] >= std::numeric_limits<RealType>::epsilon() &&
-              step_context.get_random_gen()() < prob[iw])
+          if (!sft.branch_engine.phaseChanged(walker_twfs[iw].getPhaseDiff()) &&
+              buffers.prob[iw] >= std::numeric_limits<RealType>::epsilon() &&
+              (walker_streams ? walkers[iw].get().RandomStream() : step_context.get_random_gen()()) <
+                  buffers.prob[iw])
           {
             crowd.incAccept();
-            isAccepted.push_back(true);
-            rr_accepted[iw] += rr[iw];
+            buffers.isAccepted[iw] = true;
           }
           else
           {
             crowd.incReject();
-            isAccepted.push_back(false);
+            buffers.isAccepted[iw] = false;
           }
         }
+        buffers.accumulateRR();
 
-        twf_dispatcher.flex_accept_rejectMove(walker_twfs, walker_elecs, iat, isAccepted, true);
+        twf_dispatcher.flex_accept_rejectMove(walker_twfs, walker_elecs, iat, buffers.isAccepted, true);
 
-        ps_dispatcher.flex_accept_rejectMove<CT>(walker_elecs, iat, isAccepted);
+        ps_dispatcher.flex_accept_rejectMove<CT>(walker_elecs, iat, buffers.isAccepted);
       }
     }
 
@@ -262,10 +230,11 @@ void DMCBatched::advanceWalkers(const StateForThread& sft,
 
     for (int iw = 0; iw < walkers.size(); ++iw)
     {
-      resetSigNLocalEnergy(walkers[iw], walker_twfs[iw], new_energies[iw], rr_accepted[iw], rr_proposed[iw]);
+      resetSigNLocalEnergy(walkers[iw], walker_twfs[iw], new_energies[iw], buffers.rr_accepted[iw],
+                           buffers.rr_proposed[iw]);
       FullPrecRealType branch_weight = sft.branch_engine.branchWeight(new_energies[iw], old_energies[iw]);
       walkers[iw].get().Weight *= branch_weight;
-      if (rr_proposed[iw] > 0)
+      if (buffers.rr_proposed[iw] > 0)
         walkers[iw].get().Age = 0;
       else
         walkers[iw].get().Age++;
@@ -276,8 +245,7 @@ void DMCBatched::advanceWalkers(const StateForThread& sft,
     ScopedTimer collectable_local(timers.collectables_timer);
 
     // evaluate non-physical hamiltonian elements
-    for (int iw = 0; iw < walkers.size(); ++iw)
-      walker_hamiltonians[iw].auxHevaluate(walker_elecs[iw], walkers[iw]);
+    ham_dispatcher.flex_auxHevaluate(walker_hamiltonians, walker_twfs, walker_elecs, walkers);
 
     // save properties into walker
     for (int iw = 0; iw < walkers.size(); ++iw)
@@ -354,13 +322,16 @@ void DMCBatched::runDMCStep(int crowd_id,
     return;
 
   auto& rng = context_for_steps[crowd_id]->get_random_gen();
-  crowd.setRNGForHamiltonian(rng);
+  if (sft.qmcdrv_input.get_walker_random_streams())
+    crowd.setWalkerRNGForHamiltonian(rng);
+  else
+    crowd.setRNGForHamiltonian(rng);
 
   const int max_steps  = sft.qmcdrv_input.get_max_steps();
   const IndexType step = sft.step;
   // Are we entering the the last step of a block to recompute at?
   const bool recompute_this_step  = (sft.is_recomputing_block && (step + 1) == max_steps);
-  const bool accumulate_this_step = true;
+  const bool accumulate_this_step = !sft.is_autotuning;
   const bool spin_move            = sft.population.get_golden_electrons().isSpinor();
   if (spin_move)
     advanceWalkers<CoordsType::POS_SPIN>(sft, crowd, timers, dmc_timers, *context_for_steps[crowd_id],
@@ -378,7 +349,7 @@ void DMCBatched::process(xmlNodePtr node)
     QMCDriverNew::AdjustedWalkerCounts awc =
         adjustGlobalWalkerCount(myComm->size(), myComm->rank(), qmcdriver_input_.get_total_walkers(),
                                 qmcdriver_input_.get_walkers_per_rank(), dmcdriver_input_.get_reserve(),
-                                qmcdriver_input_.get_num_crowds());
+                                qmcdriver_input_.get_num_crowds(), qmcdriver_input_.get_threads_per_walker());
 
     Base::initializeQMC(awc);
   }
@@ -401,6 +372,9 @@ void DMCBatched::process(xmlNodePtr node)
     walker_controller_->setMinMax(population_.get_num_global_walkers(), 0);
     walker_controller_->start();
     walker_controller_->put(node);
+    // forward walking estimators need the branching events of the population
+    if (estimator_manager_->registerAncestry(population_.get_ancestry()))
+      population_.get_ancestry().enable();
 
     std::ostringstream o;
     if (dmcdriver_input_.get_reconfiguration())
@@ -418,6 +392,81 @@ void DMCBatched::process(xmlNodePtr node)
   }
 }
 
+std::vector<int> DMCBatched::getAutotuneCrowdCounts(int max_crowds)
+{
+  std::vector<int> crowd_counts;
+  for (int num_crowds = max_crowds; num_crowds > 0; num_crowds /= 2)
+    crowd_counts.push_back(num_crowds);
+  return crowd_counts;
+}
+
+void DMCBatched::autotuneCrowds(StateForThread& dmc_state)
+{
+  ScopedTimer local_timer(timers_.run_steps_timer);
+  const IndexType autotune_steps      = dmcdriver_input_.get_autotune_steps();
+  const std::vector<int> crowd_counts = getAutotuneCrowdCounts(crowds_.size());
+  std::vector<IndexType> walkers_per_crowd(crowd_counts.size());
+  std::vector<double> walker_steps_per_second(crowd_counts.size());
+
+  ParallelExecutor<> crowd_task(qmcdriver_input_.get_threads_per_walker());
+  dmc_state.recalculate_properties_period = (qmc_driver_mode_[QMC_UPDATE_MODE])
+      ? qmcdriver_input_.get_recalculate_properties_period()
+      : (qmcdriver_input_.get_max_blocks() + 1) * qmcdriver_input_.get_max_steps();
+  dmc_state.is_recomputing_block = false;
+  dmc_state.is_autotuning        = true;
+
+  // the autotuning steps move the walkers, keep them to start production from the same population
+  std::vector<MCPWalker> saved_walkers;
+  saved_walkers.reserve(population_.get_num_local_walkers());
+  for (const UPtr<MCPWalker>& walker : population_.get_walkers())
+    saved_walkers.push_back(*walker);
+
+  for (int ic = 0; ic < crowd_counts.size(); ++ic)
+  {
+    setNumCrowds(crowd_counts[ic]);
+    walkers_per_crowd[ic] = crowds_[0]->size();
+
+    // the first step of a layout warms up the new crowd resources and is not timed
+    dmc_state.step = 0;
+    crowd_task(crowds_.size(), runDMCStep, dmc_state, timers_, dmc_timers_, std::ref(step_contexts_),
+               std::ref(crowds_));
+
+    double walker_steps = 0;
+    Timer layout_timer;
+    for (int step = 0; step < autotune_steps; ++step)
+    {
+      dmc_state.step = step;
+      walker_steps += population_.get_num_local_walkers();
+      crowd_task(crowds_.size(), runDMCStep, dmc_state, timers_, dmc_timers_, std::ref(step_contexts_),
+                 std::ref(crowds_));
+    }
+    walker_steps_per_second[ic] = walker_steps / layout_timer.elapsed();
+  }
+  dmc_state.is_autotuning = false;
+
+  auto& walkers = population_.get_walkers();
+  for (int iw = 0; iw < walkers.size(); ++iw)
+  {
+    *walkers[iw]           = saved_walkers[iw];
+    walkers[iw]->wasTouched = true;
+  }
+
+  int best = std::max_element(walker_steps_per_second.begin(), walker_steps_per_second.end()) -
+      walker_steps_per_second.begin();
+  myComm->bcast(best);
+  setNumCrowds(crowd_counts[best]);
+
+  std::ostringstream o;
+  o << "  DMC autotuning of the crowd layout on rank 0, " << autotune_steps << " steps per layout\n"
+    << "    " << std::setw(8) << "crowds" << std::setw(20) << "walkers_per_crowd" << std::setw(24)
+    << "walker_steps_per_second\n";
+  for (int ic = 0; ic < crowd_counts.size(); ++ic)
+    o << "    " << std::setw(8) << crowd_counts[ic] << std::setw(20) << walkers_per_crowd[ic] << std::setw(23)
+      << walker_steps_per_second[ic] << "\n";
+  o << "  Continuing with crowds = " << crowds_.size() << ", walkers_per_crowd = " << crowds_[0]->size() << "\n";
+  app_summary() << o.str() << std::endl;
+}
+
 bool DMCBatched::run()
 {
   IndexType num_blocks = qmcdriver_input_.get_max_blocks();
@@ -431,8 +480,9 @@ bool DMCBatched::run()
 
   { // walker initialization
     ScopedTimer local_timer(timers_.init_walkers_timer);
-    ParallelExecutor<> section_start_task;
-    section_start_task(crowds_.size(), initialLogEvaluation, std::ref(crowds_), std::ref(step_contexts_));
+    ParallelExecutor<> section_start_task(qmcdriver_input_.get_threads_per_walker());
+    section_start_task(crowds_.size(), initialLogEvaluation, std::ref(crowds_), std::ref(step_contexts_),
+                       qmcdriver_input_.get_walker_random_streams());
 
     FullPrecRealType energy, variance;
     population_.measureGlobalEnergyVariance(*myComm, energy, variance);
@@ -445,15 +495,20 @@ bool DMCBatched::run()
       measureImbalance("InitialLogEvaluation");
   }
 
+  if (dmcdriver_input_.get_autotune_steps() > 0)
+    autotuneCrowds(dmc_state);
+
   // this barrier fences all previous load imbalance. Avoid block 0 timing pollution.
   myComm->barrier();
 
   ScopedTimer local_timer(timers_.production_timer);
-  ParallelExecutor<> crowd_task;
+  ParallelExecutor<> crowd_task(qmcdriver_input_.get_threads_per_walker());
 
   for (int block = 0; block < num_blocks; ++block)
   {
     dmc_loop.start();
+    // blocks with population control warmup steps are not in the reblocked series
+    const bool equilibration_block = branch_engine_->getWarmupToDoSteps() > 0;
     estimator_manager_->startBlock(qmcdriver_input_.get_max_steps());
 
     dmc_state.recalculate_properties_period = (qmc_driver_mode_[QMC_UPDATE_MODE])
@@ -486,6 +541,8 @@ bool DMCBatched::run()
     print_mem("DMCBatched after a block", app_debug_stream());
     if (qmcdriver_input_.get_measure_imbalance())
       measureImbalance("Block " + std::to_string(block));
+    // the forward walking estimators evaluate the ancestry of all the ranks when the block ends
+    population_.get_ancestry().synchronize(*myComm);
     endBlock();
     dmc_loop.stop();
 
@@ -502,6 +559,11 @@ bool DMCBatched::run()
       run_time_manager.markStop();
       break;
     }
+
+    if (equilibration_block)
+      estimator_manager_->restartReblocking();
+    else if (checkReblockingStop(block))
+      break;
   }
 
   branch_engine_->printStatus();
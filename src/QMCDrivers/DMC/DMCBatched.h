@@ -54,6 +54,8 @@ public:
     IndexType recalculate_properties_period;
     IndexType step            = -1;
     bool is_recomputing_block = false;
+    /// autotuning steps only move the walkers, the estimators do not accumulate them
+    bool is_autotuning = false;
     StateForThread(const QMCDriverInput& qmci,
                    const DMCDriverInput& dmci,
                    DriftModifierBase& drift_mod,
@@ -120,6 +122,11 @@ public:
 
   QMCRunType getRunType() override { return QMCRunType::DMC_BATCH; }
 
+  /** crowd counts tried by the autotuning, max_crowds and its successive halvings down to one crowd.
+   *  It only depends on max_crowds so all the ranks take the same number of autotuning steps.
+   */
+  static std::vector<int> getAutotuneCrowdCounts(int max_crowds);
+
   void setNonLocalMoveHandler(QMCHamiltonian& golden_hamiltonian);
 
 private:
@@ -135,6 +142,16 @@ private:
   ///walker controller for load-balance
   std::unique_ptr<WalkerControl> walker_controller_;
 
+  /** measure the DMC throughput of each crowd layout of getAutotuneCrowdCounts
+   *  and keep the fastest one for the rest of the run.
+   *
+   *  Each layout runs one untimed warm-up step and then times autotune_steps DMC steps.
+   *  The autotuning steps do not branch, accumulate the estimators or update the branch engine,
+   *  and the walkers are restored when it ends, so production starts from the same population
+   *  and trial energy as without autotuning. The choice of rank 0 is used by all the ranks.
+   */
+  void autotuneCrowds(StateForThread& dmc_state);
+
   template<CoordsType CT>
   static void advanceWalkers(const StateForThread& sft,
                              Crowd& crowd,
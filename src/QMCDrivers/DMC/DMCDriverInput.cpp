@@ -36,6 +36,7 @@ void DMCDriverInput::readXML(xmlNodePtr node)
   parameter_set_.add(gamma_, "gamma");
 
   parameter_set_.add(reserve_, "reserve");
+  parameter_set_.add(autotune_steps_, "autotune_steps");
 
   parameter_set_.put(node);
 
@@ -64,6 +65,9 @@ void DMCDriverInput::readXML(xmlNodePtr node)
 
   if (reserve_ < 1.0)
     throw std::runtime_error("You can only reserve walkers above the target walker count");
+
+  if (autotune_steps_ < 0)
+    throw std::runtime_error("Illegal input for autotune_steps in DMC input section");
 }
 
 std::ostream& operator<<(std::ostream& o_stream, const DMCDriverInput& dmci) { return o_stream; }
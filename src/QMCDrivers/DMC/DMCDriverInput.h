@@ -36,6 +36,7 @@ public:
   double get_alpha() const { return alpha_; }
   double get_gamma() const { return gamma_; }
   RealType get_reserve() const { return reserve_; }
+  IndexType get_autotune_steps() const { return autotune_steps_; }
 
 private:
   /** @ingroup Parameters for DMC Driver
@@ -62,6 +63,8 @@ private:
   RealType reserve_ = 1.0;
   double alpha_     = 0.0;
   double gamma_     = 0.0;
+  /// steps measured for each crowd layout tried before the first block, 0 disables the autotuning
+  IndexType autotune_steps_ = 0;
   /** @} */
 public:
   friend std::ostream& operator<<(std::ostream& o_stream, const DMCDriverInput& vmci);
@@ -53,11 +53,9 @@ DMCUpdatePbyPWithRejectionFast::~DMCUpdatePbyPWithRejectionFast() {}
 
 void DMCUpdatePbyPWithRejectionFast::advanceWalker(Walker_t& thisWalker, bool recompute)
 {
-  Walker_t::WFBuffer_t& w_buffer(thisWalker.DataSet);
   {
     ScopedTimer local_timer(myTimers[DMC_buffer]);
-    W.loadWalker(thisWalker, true);
-    Psi.copyFromBuffer(W, w_buffer);
+    loadWalkerAndPsi(thisWalker);
   }
   //create a 3N-Dimensional Gaussian with variance=1
   makeGaussRandomWithEngine(deltaR, RandomGen);
@@ -137,7 +135,7 @@ void DMCUpdatePbyPWithRejectionFast::advanceWalker(Walker_t& thisWalker, bool re
     {
       ScopedTimer local_timer(myTimers[DMC_buffer]);
       thisWalker.Age = 0;
-      logpsi         = Psi.updateBuffer(W, w_buffer, recompute);
+      logpsi         = updatePsiAndBuffer(thisWalker, recompute);
       if (debug_checks_ & DriverDebugChecks::CHECKGL_AFTER_MOVES)
         checkLogAndGL(W, Psi, "checkGL_after_moves");
       W.saveWalker(thisWalker);
@@ -177,7 +175,7 @@ void DMCUpdatePbyPWithRejectionFast::advanceWalker(Walker_t& thisWalker, bool re
     const int NonLocalMoveAcceptedTemp = H.makeNonLocalMoves(W);
     if (NonLocalMoveAcceptedTemp > 0)
     {
-      RealType logpsi = Psi.updateBuffer(W, w_buffer, false);
+      RealType logpsi = updatePsiAndBuffer(thisWalker, false);
       // debugging lines
       //W.update(true);
       //RealType logpsi2 = Psi.evaluateLog(W);
@@ -47,11 +47,9 @@ DMCUpdatePbyPL2::~DMCUpdatePbyPL2() {}
 
 void DMCUpdatePbyPL2::advanceWalker(Walker_t& thisWalker, bool recompute)
 {
-  Walker_t::WFBuffer_t& w_buffer(thisWalker.DataSet);
   {
     ScopedTimer local_timer(myTimers[DMC_buffer]);
-    W.loadWalker(thisWalker, true);
-    Psi.copyFromBuffer(W, w_buffer);
+    loadWalkerAndPsi(thisWalker);
   }
   //create a 3N-Dimensional Gaussian with variance=1
   makeGaussRandomWithEngine(deltaR, RandomGen);
@@ -208,7 +206,7 @@ void DMCUpdatePbyPL2::advanceWalker(Walker_t& thisWalker, bool recompute)
     {
       ScopedTimer local_timer(myTimers[DMC_buffer]);
       thisWalker.Age = 0;
-      logpsi         = Psi.updateBuffer(W, w_buffer, recompute);
+      logpsi         = updatePsiAndBuffer(thisWalker, recompute);
       W.saveWalker(thisWalker);
     }
     {
@@ -246,7 +244,7 @@ void DMCUpdatePbyPL2::advanceWalker(Walker_t& thisWalker, bool recompute)
     const int NonLocalMoveAcceptedTemp = H.makeNonLocalMoves(W);
     if (NonLocalMoveAcceptedTemp > 0)
     {
-      RealType logpsi = Psi.updateBuffer(W, w_buffer, false);
+      RealType logpsi = updatePsiAndBuffer(thisWalker, false);
       W.saveWalker(thisWalker);
       NonLocalMoveAccepted += NonLocalMoveAcceptedTemp;
     }
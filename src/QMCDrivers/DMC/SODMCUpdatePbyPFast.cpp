@@ -50,11 +50,9 @@ SODMCUpdatePbyPWithRejectionFast::~SODMCUpdatePbyPWithRejectionFast() {}
 
 void SODMCUpdatePbyPWithRejectionFast::advanceWalker(Walker_t& thisWalker, bool recompute)
 {
-  Walker_t::WFBuffer_t& w_buffer(thisWalker.DataSet);
   {
     ScopedTimer local_timer(myTimers[SODMC_buffer]);
-    W.loadWalker(thisWalker, true);
-    Psi.copyFromBuffer(W, w_buffer);
+    loadWalkerAndPsi(thisWalker);
   }
   //create a 3N-Dimensional Gaussian with variance=1
   makeGaussRandomWithEngine(deltaR, RandomGen);
@@ -145,7 +143,7 @@ void SODMCUpdatePbyPWithRejectionFast::advanceWalker(Walker_t& thisWalker, bool
     {
       ScopedTimer local_timer(myTimers[SODMC_buffer]);
       thisWalker.Age = 0;
-      logpsi         = Psi.updateBuffer(W, w_buffer, recompute);
+      logpsi         = updatePsiAndBuffer(thisWalker, recompute);
       if (debug_checks_ & DriverDebugChecks::CHECKGL_AFTER_MOVES)
         checkLogAndGL(W, Psi, "checkGL_after_moves");
       W.saveWalker(thisWalker);
@@ -185,7 +183,7 @@ void SODMCUpdatePbyPWithRejectionFast::advanceWalker(Walker_t& thisWalker, bool
     const int NonLocalMoveAcceptedTemp = H.makeNonLocalMoves(W);
     if (NonLocalMoveAcceptedTemp > 0)
     {
-      RealType logpsi = Psi.updateBuffer(W, w_buffer, false);
+      RealType logpsi = updatePsiAndBuffer(thisWalker, false);
       W.saveWalker(thisWalker);
       NonLocalMoveAccepted += NonLocalMoveAcceptedTemp;
     }
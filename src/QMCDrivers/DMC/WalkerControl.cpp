@@ -174,6 +174,9 @@ int WalkerControl::branch(int iter, MCPopulation& pop, bool do_not_branch)
       if (do_not_branch)
         for (auto& walker : walkers)
           walker->Multiplicity = 1.0;
+      else if (pop.get_walker_stream_seed() != 0)
+        for (auto& walker : walkers)
+          walker->Multiplicity = static_cast<int>(walker->Weight + walker->RandomStream());
       else
         for (auto& walker : walkers)
           walker->Multiplicity = static_cast<int>(walker->Weight + rng_());
@@ -187,6 +190,12 @@ int WalkerControl::branch(int iter, MCPopulation& pop, bool do_not_branch)
     pop.set_ensemble_property(ensemble_property_);
   }
 
+  // record the deaths before the load balancing, which also kills the walkers it moves to other ranks
+  WalkerAncestry& ancestry = pop.get_ancestry();
+  for (auto& walker : walkers)
+    if (static_cast<int>(walker->Multiplicity) == 0)
+      ancestry.recordDeath(walker->ID);
+
   auto untouched_walkers = walkers.size();
 #if defined(HAVE_MPI)
   {
@@ -223,11 +232,17 @@ int WalkerControl::branch(int iter, MCPopulation& pop, bool do_not_branch)
         walker_elements.walker = *walkers[iw];
 	walker_elements.walker.ParentID = walker_elements.walker.ID;
 	walker_elements.walker.ID = save_id;
+        ancestry.recordCopy(save_id, walker_elements.walker.ParentID);
+        // the copy must not replay the random stream of its parent
+        if (pop.get_walker_stream_seed() != 0)
+          walker_elements.walker.seedRandomStream(pop.get_walker_stream_seed());
         num_copies--;
       }
     }
   }
 
+  ancestry.endGeneration();
+
   const int current_num_global_walkers = std::accumulate(num_per_rank_.begin(), num_per_rank_.end(), 0);
   pop.set_num_global_walkers(current_num_global_walkers);
 #ifndef NDEBUG
@@ -367,10 +382,15 @@ void WalkerControl::swapWalkersSimple(MCPopulation& pop)
   std::vector<job> job_list;
   std::vector<WalkerElementsRef> newW;
   std::vector<int> ncopy_newW;
+  // received walkers whose original stays on the sending rank and their fresh IDs from spawnWalker
+  std::vector<bool> is_copy_newW;
+  std::vector<long> fresh_id_newW;
 
   for (int ic = 0; ic < nswap; ic++)
   {
     int nsentcopy = 0;
+    // the number of copies and whether the sender keeps the original
+    int send_header[2] = {0, 0};
     if (plus[ic] == rank_num_)
     {
       // always send the last good walker with most copies
@@ -387,7 +407,9 @@ void WalkerControl::swapWalkersSimple(MCPopulation& pop)
         }
 
       // send the number of copies to the target
-      myComm->comm.send_value(nsentcopy, minus[ic]);
+      send_header[0] = nsentcopy;
+      send_header[1] = ncopy_pairs.back().first > 1 ? 1 : 0;
+      myComm->comm.send_n(send_header, 2, minus[ic]);
       job_list.push_back(job(ncopy_pairs.back().second, minus[ic]));
 #ifdef MCWALKERSET_MPI_DEBUG
       fout << "rank " << plus[ic] << " sends a walker with " << nsentcopy << " copies to rank " << minus[ic]
@@ -413,9 +435,12 @@ void WalkerControl::swapWalkersSimple(MCPopulation& pop)
     if (minus[ic] == rank_num_)
     {
       newW.push_back(pop.spawnWalker());
+      fresh_id_newW.push_back(newW.back().walker.ID);
 
       // recv the number of copies from the target
-      myComm->comm.receive_n(&nsentcopy, 1, plus[ic]);
+      myComm->comm.receive_n(send_header, 2, plus[ic]);
+      nsentcopy = send_header[0];
+      is_copy_newW.push_back(send_header[1] != 0);
       job_list.push_back(job(newW.size() - 1, plus[ic]));
       if (plus[ic] != plus[ic + nsentcopy] || minus[ic] != minus[ic + nsentcopy])
         throw std::runtime_error("WalkerControl::swapWalkersSimple send/recv pair checking failed!");
@@ -511,6 +536,18 @@ void WalkerControl::swapWalkersSimple(MCPopulation& pop)
   //save the number of walkers sent
   saved_num_walkers_sent_ = nsend;
 
+  // a walker moved to this rank keeps its ID, a copy gets a new one and so its own random stream
+  for (int iw = 0; iw < newW.size(); iw++)
+    if (is_copy_newW[iw])
+    {
+      auto& awalker    = newW[iw].walker;
+      awalker.ParentID = awalker.ID;
+      awalker.ID       = fresh_id_newW[iw];
+      pop.get_ancestry().recordCopy(awalker.ID, awalker.ParentID);
+      if (pop.get_walker_stream_seed() != 0)
+        awalker.seedRandomStream(pop.get_walker_stream_seed());
+    }
+
   // rebuild Multiplicity
   for (int iw = 0; iw < ncopy_pairs.size(); iw++)
     good_walkers[ncopy_pairs[iw].second]->Multiplicity = ncopy_pairs[iw].first;
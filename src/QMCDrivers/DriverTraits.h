@@ -16,6 +16,7 @@ enum class QMCRunType
   WF_TEST,
   VMC_BATCH,
   DMC_BATCH,
+  RMC_BATCH,
   LINEAR_OPTIMIZE_BATCH
 };
 
@@ -9,6 +9,7 @@
 // File refactored from: MCWalkerConfiguration.cpp, QMCUpdate.cpp
 //////////////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
 #include <numeric>
 
 #include "MCPopulation.h"
@@ -86,14 +87,13 @@ void MCPopulation::createWalkers(IndexType num_walkers, const WalkerConfiguratio
 
   outputManager.resume();
 
-  int num_walkers_created = 0;
   for (auto& walker_ptr : walkers_)
   {
     if (walker_ptr->ID == 0)
     {
       // And so walker ID's start at one because 0 is magic.
       // \todo This is C++ all indexes start at 0, make uninitialized ID = -1
-      walker_ptr->ID       = (num_walkers_created++) * num_ranks_ + rank_ + 1;
+      walker_ptr->ID       = makeWalkerID();
       walker_ptr->ParentID = walker_ptr->ID;
     }
   }
@@ -153,6 +153,8 @@ WalkerElementsRef MCPopulation::spawnWalker()
     walkers_.back()->ReleasedNodeAge    = 0;
     walkers_.back()->Multiplicity       = 1.0;
     walkers_.back()->Weight             = 1.0;
+    // a recycled walker must not reuse the ID and so the random stream of a dead one
+    walkers_.back()->ID = makeWalkerID();
   }
   else
   {
@@ -171,8 +173,11 @@ WalkerElementsRef MCPopulation::spawnWalker()
         hamiltonian_->makeClone(*walker_elec_particle_sets_.back(), *walker_trial_wavefunctions_.back()));
     walkers_.back()->Multiplicity = 1.0;
     walkers_.back()->Weight       = 1.0;
-    walkers_.back()->ID           = (walkers_.size() + 1) * num_ranks_ + rank_ + 1;
+    walkers_.back()->ID           = makeWalkerID();
   }
+  walkers_.back()->ParentID = walkers_.back()->ID;
+  if (walker_stream_seed_ != 0)
+    walkers_.back()->seedRandomStream(walker_stream_seed_);
 
   outputManager.resume();
   return {*walkers_.back().get(), *walker_elec_particle_sets_.back().get(), *walker_trial_wavefunctions_.back().get()};
@@ -229,6 +234,40 @@ void MCPopulation::killWalker(MCPWalker& walker)
   throw std::runtime_error("Attempt to kill nonexistent walker in MCPopulation!");
 }
 
+void MCPopulation::seedWalkerRandomStreams(uint32_t seed, Communicate& comm)
+{
+  if (seed == 0)
+    throw std::runtime_error("MCPopulation::seedWalkerRandomStreams the seed of walker streams cannot be 0");
+  walker_stream_seed_ = seed;
+
+  long max_restored_id = 0;
+  for (auto& walker_ptr : walkers_)
+    if (walker_ptr->hasRandomStream())
+    {
+      walker_ptr->ID       = walker_ptr->RandomStream.stream();
+      walker_ptr->ParentID = walker_ptr->ID;
+      max_restored_id      = std::max(max_restored_id, walker_ptr->ID);
+    }
+
+  std::vector<long> max_restored_id_per_rank(comm.size(), 0);
+  max_restored_id_per_rank[comm.rank()] = max_restored_id;
+  comm.allreduce(max_restored_id_per_rank);
+  max_restored_id = *std::max_element(max_restored_id_per_rank.begin(), max_restored_id_per_rank.end());
+
+  if (max_restored_id > 0)
+    num_walkers_created_ = std::max(num_walkers_created_, max_restored_id / num_ranks_ + 1);
+  for (auto& walker_ptr : walkers_)
+    if (!walker_ptr->hasRandomStream())
+    {
+      if (max_restored_id > 0)
+      {
+        walker_ptr->ID       = makeWalkerID();
+        walker_ptr->ParentID = walker_ptr->ID;
+      }
+      walker_ptr->seedRandomStream(walker_stream_seed_);
+    }
+}
+
 void MCPopulation::syncWalkersPerRank(Communicate* comm)
 {
   std::vector<IndexType> num_local_walkers_per_rank(comm->size(), 0);
@@ -289,6 +328,9 @@ void MCPopulation::saveWalkerConfigurations(WalkerConfigurations& walker_configs
 {
   walker_configs.resize(walker_elec_particle_sets_.size(), elec_particle_set_->getTotalNum());
   for (int iw = 0; iw < walker_elec_particle_sets_.size(); iw++)
+  {
     walker_elec_particle_sets_[iw]->saveWalker(*walker_configs[iw]);
+    walker_configs[iw]->RandomStream = walkers_[iw]->RandomStream;
+  }
 }
 } // namespace qmcplusplus
@@ -20,6 +20,7 @@
 #include "Particle/ParticleSet.h"
 #include "ParticleBase/ParticleAttrib.h"
 #include "Particle/Walker.h"
+#include "Particle/WalkerAncestry.h"
 #include "QMCWaveFunctions/TrialWaveFunction.h"
 #include "QMCDrivers/WalkerElementsRef.h"
 #include "OhmmsPETE/OhmmsVector.h"
@@ -88,6 +89,16 @@ private:
   int num_ranks_;
   int rank_;
 
+  /// number of walker IDs handed out on this rank, IDs are unique over all the ranks
+  long num_walkers_created_ = 0;
+  /// seed of the walker random streams, 0 if walker streams are not in use
+  uint32_t walker_stream_seed_ = 0;
+  /// branching events for forward walking, recorded by WalkerControl once enabled
+  WalkerAncestry ancestry_;
+
+  /// next unique walker ID of this rank
+  long makeWalkerID() { return (num_walkers_created_++) * num_ranks_ + rank_ + 1; }
+
 public:
   /** Temporary constructor to deal with MCWalkerConfiguration be the only source of some information
    *  in QMCDriverFactory.
@@ -147,6 +158,16 @@ public:
     }
   }
 
+  /** seed the random streams of the walkers, enables per walker streams for walkers spawned later
+   *
+   *  Walkers restored with their streams from a configuration file keep the stream index as their ID.
+   *  All the other walkers are renumbered past the largest restored ID on any rank so that no two walkers share a stream.
+   *  \param[in] seed global seed, identical on all the ranks
+   */
+  void seedWalkerRandomStreams(uint32_t seed, Communicate& comm);
+  /// seed of the walker random streams, 0 if walker streams are not in use
+  uint32_t get_walker_stream_seed() const { return walker_stream_seed_; }
+
   void syncWalkersPerRank(Communicate* comm);
   void measureGlobalEnergyVariance(Communicate& comm, FullPrecRealType& ener, FullPrecRealType& variance) const;
 
@@ -191,6 +212,9 @@ public:
     ensemble_property_ = ensemble_property;
   }
 
+  WalkerAncestry& get_ancestry() { return ancestry_; }
+  const WalkerAncestry& get_ancestry() const { return ancestry_; }
+
   UPtrVector<MCPWalker>& get_walkers() { return walkers_; }
   const UPtrVector<MCPWalker>& get_walkers() const { return walkers_; }
   const UPtrVector<MCPWalker>& get_dead_walkers() const { return dead_walkers_; }
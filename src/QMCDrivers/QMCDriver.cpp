@@ -27,6 +27,7 @@
 #include "RandomNumberControl.h"
 #include "hdf/HDFVersion.h"
 #include "Utilities/qmc_common.h"
+#include "Utilities/Timer.h"
 #include <limits>
 #include <typeinfo>
 
@@ -543,6 +544,73 @@ bool QMCDriver::putQMCInfo(xmlNodePtr cur)
   return (W.getActiveWalkers() > 0);
 }
 
+/** Resolve walker_buffer into the choice of the movers
+ *
+ * "auto" times a pass over the walkers of this rank with each choice, doing what a mover does when it loads
+ * a walker and saves it after the moves. With buffers, every walker streams its own buffer in and out of memory,
+ * without them psi is recomputed from the positions and saved in a single buffer.
+ * The buffers of the timing are temporary, the walkers are registered by the movers afterwards.
+ * The choice of the first rank is used everywhere so that all the walkers carry the same data.
+ */
+bool QMCDriver::keepWalkerBuffer(ParticleSet& P, TrialWaveFunction& psi)
+{
+  if (walker_buffer_ == "yes")
+    return true;
+  if (walker_buffer_ == "no")
+  {
+    app_log() << "  Walkers do not keep a buffer, the trial wavefunction is recomputed when a walker is loaded"
+              << std::endl;
+    return false;
+  }
+
+  bool keep = true;
+  if (W.getActiveWalkers() > 0)
+  {
+    std::vector<Walker_t::WFBuffer_t> walker_buffers(W.getActiveWalkers());
+    for (int iw = 0; iw < walker_buffers.size(); iw++)
+    {
+      P.loadWalker(*W[iw], true);
+      P.update();
+      psi.registerData(P, walker_buffers[iw]);
+      walker_buffers[iw].allocate();
+      psi.copyFromBuffer(P, walker_buffers[iw]);
+      psi.evaluateLog(P);
+      psi.updateBuffer(P, walker_buffers[iw], false);
+    }
+    Walker_t::WFBuffer_t lean_buffer;
+    psi.registerData(P, lean_buffer);
+    lean_buffer.allocate();
+    psi.copyFromBuffer(P, lean_buffer);
+
+    Timer stream;
+    for (int iw = 0; iw < walker_buffers.size(); iw++)
+    {
+      P.loadWalker(*W[iw], true);
+      psi.copyFromBuffer(P, walker_buffers[iw]);
+      psi.updateBuffer(P, walker_buffers[iw], false);
+    }
+    const double stream_time = stream.elapsed();
+
+    Timer rebuild;
+    for (int iw = 0; iw < walker_buffers.size(); iw++)
+    {
+      P.loadWalker(*W[iw], false);
+      P.update();
+      psi.recompute(P);
+      psi.updateBuffer(P, lean_buffer, false);
+    }
+    const double rebuild_time = rebuild.elapsed();
+
+    keep = stream_time < rebuild_time;
+    app_log() << "  Buffer of the trial wavefunction per walker " << walker_buffers[0].byteSize()
+              << " Bytes. Loading and saving " << walker_buffers.size() << " walkers takes " << stream_time
+              << " secs with buffers, " << rebuild_time << " secs recomputing the trial wavefunction" << std::endl;
+  }
+  myComm->bcast(keep);
+  app_log() << "  Walkers " << (keep ? "keep the buffer" : "do not keep a buffer") << std::endl;
+  return keep;
+}
+
 xmlNodePtr QMCDriver::getQMCNode()
 {
   xmlNodePtr newqmc      = xmlCopyNode(qmcNode, 1);
@@ -338,6 +338,20 @@ protected:
   ///spin mass for spinor calcs
   RealType SpinMass;
 
+  /** if the walkers keep the state of the trial wavefunction for particle-by-particle moves
+   *
+   * "yes" keeps it in every walker, "no" recomputes it whenever a walker is loaded
+   * and "auto" selects the faster one, see keepWalkerBuffer.
+   */
+  std::string walker_buffer_{"yes"};
+
+  /** resolve walker_buffer_ for the movers
+   * @param P particle set of a mover
+   * @param psi trial wavefunction of the same mover
+   * @return true if the walkers keep the buffer of the trial wavefunction
+   */
+  bool keepWalkerBuffer(ParticleSet& P, TrialWaveFunction& psi);
+
   bool putQMCInfo(xmlNodePtr cur);
 
   void addWalkers(int nwalkers);
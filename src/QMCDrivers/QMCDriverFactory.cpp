@@ -35,6 +35,7 @@
 #include "QMCDrivers/DMC/DMCFactory.h"
 #include "QMCDrivers/DMC/DMCFactoryNew.h"
 #include "QMCDrivers/RMC/RMCFactory.h"
+#include "QMCDrivers/RMC/RMCFactoryNew.h"
 #include "QMCDrivers/WFOpt/QMCFixedSampleLinearOptimize.h"
 #include "QMCDrivers/WFOpt/QMCFixedSampleLinearOptimizeBatched.h"
 #include "QMCDrivers/WaveFunctionTester.h"
@@ -74,7 +75,8 @@ QMCDriverFactory::DriverAssemblyState QMCDriverFactory::readSection(xmlNodePtr c
 #endif
   OhmmsAttributeSet aAttrib;
   aAttrib.add(qmc_mode, "method",
-              {"", "vmc", "vmc_batch", "dmc", "dmc_batch", "csvmc", "rmc", "linear", "linear_batch", "wftest"});
+              {"", "vmc", "vmc_batch", "dmc", "dmc_batch", "csvmc", "rmc", "rmc_batch", "linear", "linear_batch",
+               "wftest"});
   aAttrib.add(update_mode, "move");
   aAttrib.add(multi_tag, "multiple");
   aAttrib.add(warp_tag, "warp");
@@ -113,10 +115,12 @@ QMCDriverFactory::DriverAssemblyState QMCDriverFactory::readSection(xmlNodePtr c
       das.new_run_type = QMCRunType::VMC_BATCH;
     else if (qmc_mode.find("dmc") < nchars) // order matters here
       das.new_run_type = QMCRunType::DMC_BATCH;
+    else if (qmc_mode.find("rmc") < nchars)
+      das.new_run_type = QMCRunType::RMC_BATCH;
     else if (qmc_mode.find("linear") < nchars)
       das.new_run_type = QMCRunType::LINEAR_OPTIMIZE_BATCH;
     else
-      throw UniformCommunicateError("QMC mode unknown. Valid modes for batched drivers are : vmc, dmc, linear.");
+      throw UniformCommunicateError("QMC mode unknown. Valid modes for batched drivers are : vmc, dmc, rmc, linear.");
     break;
   // Begin to separate driver version = batch input reading from the legacy input parsing
   case DV::LEGACY:
@@ -137,7 +141,9 @@ QMCDriverFactory::DriverAssemblyState QMCDriverFactory::readSection(xmlNodePtr c
         das.what_to_do[MULTIPLE_MODE] = 1;
       if (qmc_mode.find("warp") < nchars)
         das.what_to_do[SPACEWARP_MODE] = 1;
-      if (qmc_mode.find("rmc") < nchars)
+      if (qmc_mode.find("rmc_batch") < nchars) // order matters here
+        das.new_run_type = QMCRunType::RMC_BATCH;
+      else if (qmc_mode.find("rmc") < nchars)
         das.new_run_type = QMCRunType::RMC;
       else if (qmc_mode.find("vmc_batch") < nchars) // order matters here
         das.new_run_type = QMCRunType::VMC_BATCH;
@@ -260,6 +266,12 @@ std::unique_ptr<QMCDriverInterface> QMCDriverFactory::createQMCDriver(xmlNodePtr
     RMCFactory fac(das.what_to_do[UPDATE_MODE], cur);
     new_driver = fac.create(project_data_, qmc_system, *primaryPsi, *primaryH, comm);
   }
+  else if (das.new_run_type == QMCRunType::RMC_BATCH)
+  {
+    RMCFactoryNew fac(cur, das.what_to_do[UPDATE_MODE]);
+    new_driver = fac.create(project_data_, emi, qmc_system,
+                            MCPopulation(comm->size(), comm->rank(), &qmc_system, primaryPsi, primaryH), comm);
+  }
   else if (das.new_run_type == QMCRunType::LINEAR_OPTIMIZE)
   {
 #ifdef MIXED_PRECISION
@@ -18,6 +18,7 @@
 #include "EstimatorInputDelegates.h"
 #include "Concurrency/Info.hpp"
 #include "ModernStringUtils.hpp"
+#include "Utilities/string_utils.h"
 
 namespace qmcplusplus
 {
@@ -37,8 +38,11 @@ void QMCDriverInput::readXML(xmlNodePtr cur)
   // so its better it not live long
 
   std::string serialize_walkers;
+  std::string walker_random_streams;
   std::string debug_checks_str;
   std::string measure_imbalance_str;
+  std::string reblock_str;
+  astring reblock_scalars_str;
   int Period4CheckPoint{-1};
 
   ParameterSet parameter_set;
@@ -57,7 +61,9 @@ void QMCDriverInput::readXML(xmlNodePtr cur)
   parameter_set.add(warmup_steps_, "warmupsteps");
   parameter_set.add(warmup_steps_, "warmup_steps");
   parameter_set.add(num_crowds_, "crowds");
+  parameter_set.add(threads_per_walker_, "threads_per_walker");
   parameter_set.add(serialize_walkers, "crowd_serialize_walkers", {"no", "yes"});
+  parameter_set.add(walker_random_streams, "walker_random_streams", {"no", "yes"});
   parameter_set.add(walkers_per_rank_, "walkers_per_rank");
   parameter_set.add(walkers_per_rank_, "walkers", {}, TagStatus::UNSUPPORTED);
   parameter_set.add(total_walkers_, "total_walkers");
@@ -75,6 +81,10 @@ void QMCDriverInput::readXML(xmlNodePtr cur)
   parameter_set.add(debug_checks_str, "debug_checks",
                     {"no", "all", "checkGL_after_load", "checkGL_after_moves", "checkGL_after_tmove"});
   parameter_set.add(measure_imbalance_str, "measure_imbalance", {"no", "yes"});
+  parameter_set.add(reblock_str, "reblock", {"no", "yes"});
+  parameter_set.add(reblock_scalars_str, "reblock_scalars");
+  parameter_set.add(target_error_, "target_error");
+  parameter_set.add(target_effective_samples_, "target_samples");
 
   OhmmsAttributeSet aAttrib;
   // first stage in from QMCDriverFactory
@@ -141,6 +151,13 @@ void QMCDriverInput::readXML(xmlNodePtr cur)
   crowd_serialize_walkers_ = serialize_walkers == "yes";
   if (crowd_serialize_walkers_)
     app_summary() << "  Batched operations are serialized over walkers." << std::endl;
+  if (threads_per_walker_ < 1)
+    throw std::runtime_error("Illegal input for threads_per_walker, it must be at least 1");
+  if (threads_per_walker_ > 1)
+    app_summary() << "  Each walker is moved by a team of " << threads_per_walker_ << " threads." << std::endl;
+  walker_random_streams_ = walker_random_streams == "yes";
+  if (walker_random_streams_)
+    app_summary() << "  Random numbers are drawn from per walker streams." << std::endl;
   if (scoped_profiling_)
     app_summary() << "  Profiler data collection is enabled in this driver scope." << std::endl;
 
@@ -159,6 +176,16 @@ void QMCDriverInput::readXML(xmlNodePtr cur)
   if (measure_imbalance_str == "yes")
     measure_imbalance_ = true;
 
+  if (target_error_ < 0.0)
+    throw std::runtime_error("Illegal input for target_error, it must not be negative");
+  if (target_effective_samples_ < 0)
+    throw std::runtime_error("Illegal input for target_samples, it must not be negative");
+  reblock_scalars_ = convertStrToVec<std::string>(reblock_scalars_str.s);
+  // the early stopping criteria need the reblocked error
+  reblock_ = reblock_str == "yes" || !reblock_scalars_.empty() || target_error_ > 0.0 || target_effective_samples_ > 0;
+  if (reblock_)
+    app_summary() << "  Block averages are reblocked online." << std::endl;
+
   if (check_point_period_.period < 1)
     check_point_period_.period = max_blocks_;
 
@@ -58,6 +58,8 @@ protected:
 
   /// if true, batched operations are serialized over walkers
   bool crowd_serialize_walkers_ = false;
+  /// if true, walkers draw their moves and branching from their own random streams
+  bool walker_random_streams_ = false;
   /// period of dumping walker positions and IDs for Forward Walking (steps)
   int store_config_period_ = 0;
   /// period to recalculate the walker properties from scratch.
@@ -66,6 +68,8 @@ protected:
   input::PeriodStride config_dump_period_;
   IndexType starting_step_ = 0;
   IndexType num_crowds_    = 0;
+  /// number of threads working on the moves of one walker, the nested thread team of a crowd
+  IndexType threads_per_walker_ = 1;
   // This is the global walkers it is a hard limit for VMC and the target for DMC
   IndexType total_walkers_     = 0;
   IndexType walkers_per_rank_  = 0;
@@ -105,6 +109,15 @@ protected:
   std::string drift_modifier_{"UNR"};
   RealType drift_modifier_unr_a_ = 1.0;
 
+  // online reblocking of the block averages
+  bool reblock_ = false;
+  /// scalars reblocked besides LocalEnergy
+  std::vector<std::string> reblock_scalars_;
+  /// stop once the reblocked error of LocalEnergy is below, 0 to disable
+  FullPrecisionRealType target_error_ = 0.0;
+  /// stop once LocalEnergy has this many effective independent blocks, 0 to disable
+  IndexType target_effective_samples_ = 0;
+
   /** @}
    */
 
@@ -114,6 +127,7 @@ public:
   input::PeriodStride get_config_dump_period() const { return config_dump_period_; }
   IndexType get_starting_step() const { return starting_step_; }
   IndexType get_num_crowds() const { return num_crowds_; }
+  IndexType get_threads_per_walker() const { return threads_per_walker_; }
   IndexType get_walkers_per_rank() const { return walkers_per_rank_; }
   IndexType get_total_walkers() const { return total_walkers_; }
   IndexType get_requested_samples() const { return requested_samples_; }
@@ -139,11 +153,17 @@ public:
   DriverDebugChecks get_debug_checks() const { return debug_checks_; }
   bool get_scoped_profiling() const { return scoped_profiling_; }
   bool areWalkersSerialized() const { return crowd_serialize_walkers_; }
+  bool get_walker_random_streams() const { return walker_random_streams_; }
   bool get_measure_imbalance() const { return measure_imbalance_; }
 
   const std::string get_drift_modifier() const { return drift_modifier_; }
   RealType get_drift_modifier_unr_a() const { return drift_modifier_unr_a_; }
 
+  bool get_reblock() const { return reblock_; }
+  const std::vector<std::string>& get_reblock_scalars() const { return reblock_scalars_; }
+  FullPrecisionRealType get_target_error() const { return target_error_; }
+  IndexType get_target_effective_samples() const { return target_effective_samples_; }
+
   const std::optional<EstimatorManagerInput>& get_estimator_manager_input() const { return estimator_manager_input_; }
 };
 
@@ -13,7 +13,9 @@
 #include <typeinfo>
 #include <cmath>
 #include <sstream>
+#include <iomanip>
 #include <numeric>
+#include <algorithm>
 
 #include "QMCDriverNew.h"
 #include "Concurrency/ParallelExecutor.hpp"
@@ -83,6 +85,8 @@ QMCDriverNew::QMCDriverNew(const ProjectData& project_data,
                                                                       qmcdriver_input_.get_estimator_manager_input()),
                                             population_.get_golden_hamiltonian(), population.get_golden_electrons(),
                                             population.get_golden_twf());
+  if (qmcdriver_input_.get_reblock())
+    estimator_manager_->setReblockedScalars(qmcdriver_input_.get_reblock_scalars());
 
   drift_modifier_.reset(
       createDriftModifier(qmcdriver_input_.get_drift_modifier(), qmcdriver_input_.get_drift_modifier_unr_a()));
@@ -118,7 +122,7 @@ QMCDriverNew::~QMCDriverNew()
       RandomNumberControl::Children[i].reset(Rng[i].release());
 }
 
-void QMCDriverNew::checkNumCrowdsLTNumThreads(const int num_crowds)
+void QMCDriverNew::checkNumCrowdsLTNumThreads(const int num_crowds, const int threads_per_walker)
 {
   int num_threads(Concurrency::maxCapacity<>());
   if (num_crowds > num_threads)
@@ -127,6 +131,13 @@ void QMCDriverNew::checkNumCrowdsLTNumThreads(const int num_crowds)
     error_msg << "Bad Input: num_crowds (" << num_crowds << ") > num_threads (" << num_threads << ")\n";
     throw UniformCommunicateError(error_msg.str());
   }
+  if (num_crowds * threads_per_walker > num_threads)
+  {
+    std::stringstream error_msg;
+    error_msg << "Bad Input: num_crowds (" << num_crowds << ") x threads_per_walker (" << threads_per_walker
+              << ") > num_threads (" << num_threads << ")\n";
+    throw UniformCommunicateError(error_msg.str());
+  }
 }
 
 void QMCDriverNew::initializeQMC(const AdjustedWalkerCounts& awc)
@@ -188,6 +199,20 @@ void QMCDriverNew::initializeQMC(const AdjustedWalkerCounts& awc)
     measureImbalance("Startup");
 }
 
+void QMCDriverNew::setNumCrowds(int num_crowds)
+{
+  if (num_crowds < 1 || num_crowds > step_contexts_.size())
+    throw std::runtime_error("QMCDriverNew::setNumCrowds the number of crowds must be between 1 and " +
+                             std::to_string(step_contexts_.size()));
+  const int old_num_crowds = crowds_.size();
+  crowds_.resize(num_crowds);
+  for (int i = old_num_crowds; i < num_crowds; ++i)
+    crowds_[i] =
+        std::make_unique<Crowd>(*estimator_manager_, golden_resource_, population_.get_golden_electrons(),
+                                population_.get_golden_twf(), population_.get_golden_hamiltonian(), dispatchers_);
+  population_.redistributeWalkers(crowds_);
+}
+
 /** QMCDriverNew ignores h5name if you want to read and h5 config you have to explicitly
  *  do so.
  */
@@ -282,6 +307,14 @@ void QMCDriverNew::makeLocalWalkers(IndexType nwalkers, RealType reserve)
       population_.killLastWalker();
   }
 
+  if (qmcdriver_input_.get_walker_random_streams())
+  {
+    population_.seedWalkerRandomStreams(RandomNumberControl::getWalkerStreamSeed(), *myComm);
+    if (!std::is_same_v<RandomGenerator, MCPWalker::RandomStream_t>)
+      app_warning() << "walker_random_streams only covers the moves and branching in this build. "
+                    << "Build with QMC_RNG_PHILOX=ON to use the walker streams in the Hamiltonian too." << std::endl;
+  }
+
   // \todo: this could be what is breaking spawned walkers
   for (UPtr<QMCHamiltonian>& ham : population_.get_hamiltonians())
     setNonLocalMoveHandler_(*ham);
@@ -318,13 +351,17 @@ void QMCDriverNew::createRngsStepContexts(int num_crowds)
 
 void QMCDriverNew::initialLogEvaluation(int crowd_id,
                                         UPtrVector<Crowd>& crowds,
-                                        UPtrVector<ContextForSteps>& context_for_steps)
+                                        UPtrVector<ContextForSteps>& context_for_steps,
+                                        bool walker_random_streams)
 {
   Crowd& crowd = *(crowds[crowd_id]);
   if (crowd.size() == 0)
     return;
 
-  crowd.setRNGForHamiltonian(context_for_steps[crowd_id]->get_random_gen());
+  if (walker_random_streams)
+    crowd.setWalkerRNGForHamiltonian(context_for_steps[crowd_id]->get_random_gen());
+  else
+    crowd.setRNGForHamiltonian(context_for_steps[crowd_id]->get_random_gen());
   auto& ps_dispatcher  = crowd.dispatchers_.ps_dispatcher_;
   auto& twf_dispatcher = crowd.dispatchers_.twf_dispatcher_;
   auto& ham_dispatcher = crowd.dispatchers_.ham_dispatcher_;
@@ -360,11 +397,7 @@ void QMCDriverNew::initialLogEvaluation(int crowd_id,
   for (int iw = 0; iw < crowd.size(); ++iw)
     resetSigNLocalEnergy(walkers[iw], walker_twfs[iw], local_energies[iw]);
 
-  auto evaluateNonPhysicalHamiltonianElements = [](QMCHamiltonian& ham, ParticleSet& pset, MCPWalker& walker) {
-    ham.auxHevaluate(pset, walker);
-  };
-  for (int iw = 0; iw < crowd.size(); ++iw)
-    evaluateNonPhysicalHamiltonianElements(walker_hamiltonians[iw], walker_elecs[iw], walkers[iw]);
+  ham_dispatcher.flex_auxHevaluate(walker_hamiltonians, walker_twfs, walker_elecs, walkers);
 
   auto savePropertiesIntoWalker = [](QMCHamiltonian& ham, MCPWalker& walker) {
     ham.saveProperty(walker.getPropertyBase());
@@ -404,12 +437,13 @@ QMCDriverNew::AdjustedWalkerCounts QMCDriverNew::adjustGlobalWalkerCount(int num
                                                                          IndexType required_total,
                                                                          IndexType walkers_per_rank,
                                                                          RealType reserve_walkers,
-                                                                         int num_crowds)
+                                                                         int num_crowds,
+                                                                         int threads_per_walker)
 {
   // Step 1. set num_crowds by input and Concurrency::maxCapacity<>()
-  checkNumCrowdsLTNumThreads(num_crowds);
+  checkNumCrowdsLTNumThreads(num_crowds, threads_per_walker);
   if (num_crowds == 0)
-    num_crowds = Concurrency::maxCapacity<>();
+    num_crowds = std::max(1, static_cast<int>(Concurrency::maxCapacity<>()) / threads_per_walker);
 
   AdjustedWalkerCounts awc{0, {}, {}, reserve_walkers};
 
@@ -598,6 +632,51 @@ void QMCDriverNew::measureImbalance(const std::string& tag) const
   }
 }
 
+bool QMCDriverNew::checkReblockingStop(int block)
+{
+  if (!qmcdriver_input_.get_reblock())
+    return false;
+  bool stop_requested = false;
+  if (!myComm->rank())
+  {
+    const auto& reblockers = estimator_manager_->get_reblockers();
+    const auto& names      = estimator_manager_->get_reblocked_names();
+    std::ostringstream o;
+    o << "  Block " << block << " reblocking:";
+    for (int i = 0; i < reblockers.size(); ++i)
+    {
+      const auto result = reblockers[i].analyze();
+      o << "\n    " << std::setw(20) << std::left << names[i] << std::right << " = " << std::setw(16)
+        << std::setprecision(8) << result.mean << " +/- " << std::setw(12) << std::setprecision(4) << result.error
+        << "  autocorrelation = " << std::setw(8) << result.autocorrelation_time
+        << "  effective samples = " << std::setw(10) << result.effective_samples
+        << (result.plateau ? "" : "  (no plateau yet)");
+    }
+    app_log() << o.str() << std::endl;
+
+    // only the local energy with a converged reblocking ends the run
+    const auto energy = reblockers[0].analyze();
+    if (energy.plateau)
+    {
+      const auto target_error   = qmcdriver_input_.get_target_error();
+      const auto target_samples = qmcdriver_input_.get_target_effective_samples();
+      if (target_error > 0.0 && energy.error <= target_error)
+      {
+        app_log() << "  Target error " << target_error << " reached after block " << block << "." << std::endl;
+        stop_requested = true;
+      }
+      if (target_samples > 0 && energy.effective_samples >= target_samples)
+      {
+        app_log() << "  Target of " << target_samples << " effective samples reached after block " << block << "."
+                  << std::endl;
+        stop_requested = true;
+      }
+    }
+  }
+  myComm->bcast(stop_requested);
+  return stop_requested;
+}
+
 void QMCDriverNew::setWalkerOffsets(WalkerConfigurations& walker_configs, Communicate* comm)
 {
   std::vector<int> nw(comm->size(), 0);
@@ -119,10 +119,23 @@ protected:
    */
   void initializeQMC(const AdjustedWalkerCounts& awc);
 
+  /** redistribute the local walkers over num_crowds crowds.
+   *
+   *  Crowds are created or destroyed as needed. A crowd steps with the step context of the same index
+   *  so num_crowds cannot exceed the number of crowds made by initializeQMC.
+   */
+  void setNumCrowds(int num_crowds);
+
   /// inject additional barrier and measure load imbalance.
   void measureImbalance(const std::string& tag) const;
   /// end of a block operations. Aggregates statistics across all MPI ranks and write to disk.
   void endBlock();
+  /** report the online reblocking of the block averages and check the early stopping criteria.
+   *
+   *  Rank 0 decides, the result is the same on all ranks.
+   *  \return true if the target error or the target effective samples of LocalEnergy are reached
+   */
+  bool checkReblockingStop(int block);
 
 public:
   /// Constructor.
@@ -234,7 +247,10 @@ public:
    */
   void process(xmlNodePtr cur) override = 0;
 
-  static void initialLogEvaluation(int crowd_id, UPtrVector<Crowd>& crowds, UPtrVector<ContextForSteps>& step_context);
+  static void initialLogEvaluation(int crowd_id,
+                                   UPtrVector<Crowd>& crowds,
+                                   UPtrVector<ContextForSteps>& step_context,
+                                   bool walker_random_streams);
 
 
   /** should be set in input don't see a reason to set individually
@@ -277,6 +293,26 @@ public:
                      });
   }
 
+  /** fill the deltas of a step in the particle major layout used with getSubset(iat * num_walkers, num_walkers, ...)
+   *  but draw the deltas of each walker from its own random stream
+   */
+  template<CoordsType CT>
+  static void makeGaussRandomWithWalkerStreams(const RefVector<MCPWalker>& walkers, MCCoords<CT>& walker_deltas)
+  {
+    const size_t num_walkers   = walkers.size();
+    const size_t num_particles = walker_deltas.positions.size() / num_walkers;
+    MCCoords<CT> walker_one(num_particles);
+    for (size_t iw = 0; iw < num_walkers; ++iw)
+    {
+      makeGaussRandomWithEngine(walker_one, walkers[iw].get().RandomStream);
+      for (size_t iat = 0; iat < num_particles; ++iat)
+        walker_deltas.positions[iat * num_walkers + iw] = walker_one.positions[iat];
+      if constexpr (CT == CoordsType::POS_SPIN)
+        for (size_t iat = 0; iat < num_particles; ++iat)
+          walker_deltas.spins[iat * num_walkers + iw] = walker_one.spins[iat];
+    }
+  }
+
   /** }@ */
 
 protected:
@@ -288,6 +324,8 @@ protected:
    *  if they are both absent then the default is one walker per crowd,
    *  each rank has crowds walkers.
    *  if crowds aren't specified you get one per main level thread.
+   *  With threads_per_walker > 1 each crowd uses a team of that many threads
+   *  and the main level threads are counted in teams.
    *
    *  You can have crowds or ranks with no walkers.
    *  You cannot have more crowds than threads.
@@ -301,9 +339,10 @@ protected:
                                                                     IndexType desired_count,
                                                                     IndexType walkers_per_rank,
                                                                     RealType reserve_walkers,
-                                                                    int num_crowds);
+                                                                    int num_crowds,
+                                                                    int threads_per_walker = 1);
 
-  static void checkNumCrowdsLTNumThreads(const int num_crowds);
+  static void checkNumCrowdsLTNumThreads(const int num_crowds, const int threads_per_walker = 1);
 
   /// check logpsi and grad and lap against values computed from scratch
   static void checkLogAndGL(Crowd& crowd, const std::string_view location);
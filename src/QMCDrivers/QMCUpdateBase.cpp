@@ -226,7 +226,15 @@ void QMCUpdateBase::initWalkersForPbyP(WalkerIter_t it, WalkerIter_t it_end)
   UpdatePbyP = true;
   BadState   = false;
   InitWalkersTimer->start();
-  if (it == it_end)
+  if (!keep_walker_buffer_)
+  {
+    // lean walkers, the state of Psi lives in the buffer of this mover only
+    psi_buffer_.clear();
+    Psi.registerData(W, psi_buffer_);
+    psi_buffer_.allocate();
+    Psi.copyFromBuffer(W, psi_buffer_);
+  }
+  else if (it == it_end)
   {
     // a particular case, no walker enters in this call.
     // but need to free the memory of Psi.
@@ -245,12 +253,19 @@ void QMCUpdateBase::initWalkersForPbyP(WalkerIter_t it, WalkerIter_t it_end)
       awalker.DataSet.clear();
     awalker.DataSet.rewind();
     awalker.registerData();
-    Psi.registerData(W, awalker.DataSet);
+    if (keep_walker_buffer_)
+      Psi.registerData(W, awalker.DataSet);
     awalker.DataSet.allocate();
-    // This from here on should happen in the scope of the block
-    Psi.copyFromBuffer(W, awalker.DataSet);
-    Psi.evaluateLog(W);
-    RealType logpsi = Psi.updateBuffer(W, awalker.DataSet, false);
+    RealType logpsi;
+    if (keep_walker_buffer_)
+    {
+      // This from here on should happen in the scope of the block
+      Psi.copyFromBuffer(W, awalker.DataSet);
+      Psi.evaluateLog(W);
+      logpsi = Psi.updateBuffer(W, awalker.DataSet, false);
+    }
+    else
+      logpsi = Psi.evaluateLog(W);
     W.saveWalker(awalker);
     RealType eloc = H.evaluate(W);
     BadState |= std::isnan(eloc);
@@ -266,6 +281,26 @@ void QMCUpdateBase::initWalkersForPbyP(WalkerIter_t it, WalkerIter_t it_end)
   print_mem("Memory Usage after the buffer registration", app_log());
 }
 
+void QMCUpdateBase::loadWalkerAndPsi(Walker_t& awalker)
+{
+  if (keep_walker_buffer_)
+  {
+    W.loadWalker(awalker, true);
+    Psi.copyFromBuffer(W, awalker.DataSet);
+  }
+  else
+  {
+    W.loadWalker(awalker, false);
+    W.update();
+    Psi.recompute(W);
+  }
+}
+
+QMCUpdateBase::RealType QMCUpdateBase::updatePsiAndBuffer(Walker_t& awalker, bool recompute)
+{
+  return Psi.updateBuffer(W, keep_walker_buffer_ ? awalker.DataSet : psi_buffer_, recompute);
+}
+
 QMCUpdateBase::RealType QMCUpdateBase::getNodeCorrection(const ParticleSet::ParticleGradient& g,
                                                          ParticleSet::ParticlePos& gscaled)
 {
@@ -136,6 +136,13 @@ public:
 
   inline void set_step(int step) { W.current_step = step; }
 
+  /** select where the state of Psi lives between the steps of a walker, must be set before initWalkersForPbyP
+   * @param keep if true, every walker keeps the state of Psi in its DataSet. Otherwise the walkers only keep
+   *        their own fields and Psi is rebuilt from the positions whenever a walker is loaded.
+   */
+  inline void setKeepWalkerBuffer(bool keep) { keep_walker_buffer_ = keep; }
+  inline bool getKeepWalkerBuffer() const { return keep_walker_buffer_; }
+
 
   ///** start a run */
   void startRun(int blocks, bool record);
@@ -305,6 +312,17 @@ protected:
   /// check logpsi and grad and lap against values computed from scratch
   static void checkLogAndGL(ParticleSet& pset, TrialWaveFunction& twf, const std::string_view location);
 
+  /** load awalker into W and restore the state of Psi.
+   *  It is read from the walker buffer or, for lean walkers, recomputed from the positions.
+   */
+  void loadWalkerAndPsi(Walker_t& awalker);
+
+  /** complete the evaluation of Psi after the moves of awalker, it is saved in the walker buffer if kept
+   * @param recompute recompute the state of Psi from scratch
+   * @return log of Psi
+   */
+  RealType updatePsiAndBuffer(Walker_t& awalker, bool recompute);
+
 private:
   ///set default parameters
   void setDefaults();
@@ -312,6 +330,10 @@ private:
   QMCUpdateBase& operator=(const QMCUpdateBase&) { return *this; }
   ///
   NewTimer* InitWalkersTimer;
+  /// if false, the walkers do not carry the state of Psi, see setKeepWalkerBuffer
+  bool keep_walker_buffer_ = true;
+  /// the single buffer of Psi shared by the lean walkers
+  Walker_t::WFBuffer_t psi_buffer_;
 };
 } // namespace qmcplusplus
 
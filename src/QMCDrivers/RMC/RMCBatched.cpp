@@ -0,0 +1,449 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File refactored from: RMC.cpp, RMCUpdatePbyP.cpp
+//////////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+#include "RMCBatched.h"
+#include "QMCDrivers/GreenFunctionModifiers/DriftModifierBase.h"
+#include "Concurrency/ParallelExecutor.hpp"
+#include "Message/UniformCommunicateError.h"
+#include "Message/CommOperators.h"
+#include "ParticleBase/RandomSeqGenerator.h"
+#include "Utilities/RunTimeManager.h"
+#include "QMCDrivers/SFNBranch.h"
+#include "EstimatorInputDelegates.h"
+#include "MemoryUsage.h"
+#include "QMCWaveFunctions/TWFGrads.hpp"
+#include "TauParams.hpp"
+
+namespace qmcplusplus
+{
+using WP = WalkerProperties::Indexes;
+
+/** Constructor maintains proper ownership of input parameters
+ */
+RMCBatched::RMCBatched(const ProjectData& project_data,
+                       QMCDriverInput&& qmcdriver_input,
+                       const std::optional<EstimatorManagerInput>& global_emi,
+                       RMCDriverInput&& input,
+                       WalkerConfigurations& wc,
+                       MCPopulation&& pop,
+                       Communicate* comm)
+    : QMCDriverNew(project_data,
+                   std::move(qmcdriver_input),
+                   global_emi,
+                   wc,
+                   std::move(pop),
+                   "RMCBatched::",
+                   comm,
+                   "RMCBatched"),
+      rmcdriver_input_(input),
+      num_beads_(0)
+{}
+
+RMCBatched::~RMCBatched() = default;
+
+template<CoordsType CT>
+void RMCBatched::advanceReptiles(const StateForThread& sft,
+                                 Crowd& crowd,
+                                 std::vector<ReptileRing>& reptiles,
+                                 DriverTimers& timers,
+                                 ContextForSteps& step_context,
+                                 bool recompute)
+{
+  auto& ps_dispatcher  = crowd.dispatchers_.ps_dispatcher_;
+  auto& twf_dispatcher = crowd.dispatchers_.twf_dispatcher_;
+  auto& ham_dispatcher = crowd.dispatchers_.ham_dispatcher_;
+
+  auto& walkers = crowd.get_walkers();
+  const RefVectorWithLeader<ParticleSet> walker_elecs(crowd.get_walker_elecs()[0], crowd.get_walker_elecs());
+  const RefVectorWithLeader<TrialWaveFunction> walker_twfs(crowd.get_walker_twfs()[0], crowd.get_walker_twfs());
+  const RefVectorWithLeader<QMCHamiltonian> walker_hamiltonians(crowd.get_walker_hamiltonians()[0],
+                                                                crowd.get_walker_hamiltonians());
+  assert(reptiles.size() == walkers.size());
+
+  timers.resource_timer.start();
+  ResourceCollectionTeamLock<ParticleSet> pset_res_lock(crowd.getSharedResource().pset_res, walker_elecs);
+  ResourceCollectionTeamLock<TrialWaveFunction> twfs_res_lock(crowd.getSharedResource().twf_res, walker_twfs);
+  ResourceCollectionTeamLock<QMCHamiltonian> hams_res_lock(crowd.getSharedResource().ham_res, walker_hamiltonians);
+  timers.resource_timer.stop();
+
+  const int num_walkers   = crowd.size();
+  auto& pset_leader       = walker_elecs.getLeader();
+  const int num_particles = pset_leader.getTotalNum();
+
+  // preallocated per walker temporaries of the moves, reused by every electron
+  auto& buffers = step_context.get_step_buffers<CT>();
+  buffers.prepareStep(num_walkers, num_particles);
+
+  // draw from the random streams of the walkers instead of the one of the crowd
+  const bool walker_streams = sft.qmcdrv_input.get_walker_random_streams();
+  auto uniform              = [&](MCPWalker& walker) {
+    return walker_streams ? walker.RandomStream() : step_context.get_random_gen()();
+  };
+
+  //This generates an entire steps worth of deltas.
+  if (walker_streams)
+    makeGaussRandomWithWalkerStreams(walkers, buffers.walker_deltas);
+  else
+    makeGaussRandomWithEngine(buffers.walker_deltas, step_context.get_random_gen());
+
+  // the energy of the head before the move
+  std::vector<FullPrecRealType> old_energies(num_walkers);
+  for (int iw = 0; iw < num_walkers; ++iw)
+    old_energies[iw] = walkers[iw].get().Properties(WP::LOCALENERGY);
+
+  std::vector<int> num_accepted(num_walkers, 0);
+
+  {
+    ScopedTimer pbyp_local_timer(timers.movepbyp_timer);
+    for (int ig = 0; ig < pset_leader.groups(); ++ig)
+    {
+      TauParams<RealType, CT> taus(sft.qmcdrv_input.get_tau(), sft.population.get_ptclgrp_inv_mass()[ig],
+                                   sft.qmcdrv_input.get_spin_mass());
+
+      twf_dispatcher.flex_prepareGroup(walker_twfs, walker_elecs, ig);
+
+      for (int iat = pset_leader.first(ig); iat < pset_leader.last(ig); ++iat)
+      {
+        //get deltas for this particle for all walkers, scaled by sqrt(tau)
+        buffers.loadDeltas(iat, taus);
+
+        twf_dispatcher.flex_evalGrad(walker_twfs, walker_elecs, iat, buffers.grads_now);
+        sft.drift_modifier.getDrifts(taus, buffers.grads_now, buffers.drifts);
+        buffers.drifts += buffers.deltas;
+
+        ps_dispatcher.flex_makeMove(walker_elecs, iat, buffers.drifts);
+
+        twf_dispatcher.flex_calcRatioGrad(walker_twfs, walker_elecs, iat, buffers.ratios, buffers.grads_new);
+
+        sft.drift_modifier.getDrifts(taus, buffers.grads_new, buffers.drifts_reverse);
+
+        buffers.computeAcceptance(taus, true);
+
+        for (int iw = 0; iw < num_walkers; ++iw)
+        {
+          //node is crossed reject the move
+          if (!sft.branch_engine.phaseChanged(walker_twfs[iw].getPhaseDiff()) &&
+              buffers.prob[iw] >= std::numeric_limits<RealType>::epsilon() &&
+              uniform(walkers[iw]) < buffers.prob[iw])
+          {
+            crowd.incAccept();
+            buffers.isAccepted[iw] = true;
+            num_accepted[iw]++;
+          }
+          else
+          {
+            crowd.incReject();
+            buffers.isAccepted[iw] = false;
+          }
+        }
+        buffers.accumulateRR();
+
+        twf_dispatcher.flex_accept_rejectMove(walker_twfs, walker_elecs, iat, buffers.isAccepted, true);
+
+        ps_dispatcher.flex_accept_rejectMove<CT>(walker_elecs, iat, buffers.isAccepted);
+      }
+    }
+
+    twf_dispatcher.flex_completeUpdates(walker_twfs);
+    ps_dispatcher.flex_donePbyP(walker_elecs);
+  }
+
+  { // collect GL for KE.
+    ScopedTimer buffer_local(timers.buffer_timer);
+    twf_dispatcher.flex_evaluateGL(walker_twfs, walker_elecs, recompute);
+    if (sft.qmcdrv_input.get_debug_checks() & DriverDebugChecks::CHECKGL_AFTER_MOVES)
+      checkLogAndGL(crowd, "checkGL_after_moves");
+  }
+
+  std::vector<FullPrecRealType> new_energies;
+  {
+    ScopedTimer ham_local(timers.hamiltonian_timer);
+    new_energies = ham_dispatcher.flex_evaluate(walker_hamiltonians, walker_twfs, walker_elecs);
+  }
+
+  // Test the proposed heads against the change of the action. An accepted head is stored over the tail,
+  // a rejected one reverses the reptile and the walker is reloaded from the new head.
+  std::vector<bool> bounced(num_walkers, false);
+  {
+    ScopedTimer collectable_local(timers.collectables_timer);
+    const IndexType max_age = sft.rmcdrv_input.get_max_age();
+    for (int iw = 0; iw < num_walkers; ++iw)
+    {
+      MCPWalker& walker     = walkers[iw];
+      ReptileRing& reptile  = reptiles[iw];
+      bool is_head_accepted = num_accepted[iw] > 0;
+      if (is_head_accepted && !sft.is_growing)
+      {
+        const FullPrecRealType* tail = reptile.getTailProperties();
+        const FullPrecRealType* next = reptile.getNextProperties();
+        const RealType dS            = sft.branch_engine.DMCLinkAction(new_energies[iw], old_energies[iw]) -
+            sft.branch_engine.DMCLinkAction(tail[WP::LOCALENERGY], next[WP::LOCALENERGY]);
+        const RealType accept_prob = std::min(RealType(1), std::exp(-dS));
+        is_head_accepted = uniform(walker) <= accept_prob || reptile.getHeadAge() >= max_age ||
+            reptile.getTailAge() >= max_age;
+      }
+
+      if (is_head_accepted)
+      {
+        walker_elecs[iw].saveWalker(walker);
+        walker.resetProperty(walker_twfs[iw].getLogPsi(), walker_twfs[iw].getPhase(), new_energies[iw],
+                             buffers.rr_accepted[iw], buffers.rr_proposed[iw], 1.0);
+        walker.Age = 0;
+        walker_hamiltonians[iw].auxHevaluate(walker_elecs[iw], walker);
+        walker_hamiltonians[iw].saveProperty(walker.getPropertyBase());
+        reptile.growHead(walker);
+      }
+      else if (sft.is_growing)
+      {
+        // all the single particle moves were rejected, the particle set still holds the head
+        reptile.incrementHeadAge();
+        walker.Age++;
+      }
+      else
+      {
+        reptile.incrementHeadAge();
+        reptile.flip();
+        reptile.loadHead(walker);
+        bounced[iw] = true;
+      }
+    }
+  }
+
+  if (std::any_of(bounced.begin(), bounced.end(), [](bool b) { return b; }))
+  {
+    ScopedTimer buffer_local(timers.buffer_timer);
+    ps_dispatcher.flex_loadWalker(walker_elecs, walkers, bounced, true);
+    twf_dispatcher.flex_recompute(walker_twfs, walker_elecs, bounced);
+    // the properties of the new head are already in the walker
+    for (int iw = 0; iw < num_walkers; ++iw)
+      if (bounced[iw])
+        walker_elecs[iw].saveWalker(walkers[iw]);
+  }
+
+  if (sft.accumulate_this_step)
+  {
+    ScopedTimer est_timer(timers.estimators_timer);
+    crowd.accumulate(step_context.get_random_gen());
+    // the pure estimators need the tail and the center bead of every reptile
+    auto& crowd_estimators = crowd.get_estimator_manager_crowd();
+    for (const ReptileRing& reptile : reptiles)
+      crowd_estimators.accumulateBeads(reptile.getHeadProperties(), reptile.getTailProperties(),
+                                       reptile.getCenterProperties());
+  }
+}
+
+template void RMCBatched::advanceReptiles<CoordsType::POS>(const StateForThread& sft,
+                                                           Crowd& crowd,
+                                                           std::vector<ReptileRing>& reptiles,
+                                                           DriverTimers& timers,
+                                                           ContextForSteps& step_context,
+                                                           bool recompute);
+
+template void RMCBatched::advanceReptiles<CoordsType::POS_SPIN>(const StateForThread& sft,
+                                                                Crowd& crowd,
+                                                                std::vector<ReptileRing>& reptiles,
+                                                                DriverTimers& timers,
+                                                                ContextForSteps& step_context,
+                                                                bool recompute);
+
+void RMCBatched::runRMCStep(int crowd_id,
+                            const StateForThread& sft,
+                            DriverTimers& timers,
+                            UPtrVector<ContextForSteps>& context_for_steps,
+                            UPtrVector<Crowd>& crowds,
+                            std::vector<std::vector<ReptileRing>>& reptiles)
+{
+  Crowd& crowd = *(crowds[crowd_id]);
+
+  if (crowd.size() == 0)
+    return;
+
+  auto& rng = context_for_steps[crowd_id]->get_random_gen();
+  if (sft.qmcdrv_input.get_walker_random_streams())
+    crowd.setWalkerRNGForHamiltonian(rng);
+  else
+    crowd.setRNGForHamiltonian(rng);
+
+  const int max_steps  = sft.qmcdrv_input.get_max_steps();
+  const IndexType step = sft.step;
+  // Are we entering the the last step of a block to recompute at?
+  const bool recompute_this_step = (sft.is_recomputing_block && (step + 1) == max_steps);
+  const bool spin_move           = sft.population.get_golden_electrons().isSpinor();
+  if (spin_move)
+    advanceReptiles<CoordsType::POS_SPIN>(sft, crowd, reptiles[crowd_id], timers, *context_for_steps[crowd_id],
+                                          recompute_this_step);
+  else
+    advanceReptiles<CoordsType::POS>(sft, crowd, reptiles[crowd_id], timers, *context_for_steps[crowd_id],
+                                     recompute_this_step);
+}
+
+void RMCBatched::process(xmlNodePtr node)
+{
+  print_mem("RMCBatched before initialization", app_log());
+  try
+  {
+    QMCDriverNew::AdjustedWalkerCounts awc =
+        adjustGlobalWalkerCount(myComm->size(), myComm->rank(), qmcdriver_input_.get_total_walkers(),
+                                qmcdriver_input_.get_walkers_per_rank(), 1.0, qmcdriver_input_.get_num_crowds(),
+                                qmcdriver_input_.get_threads_per_walker());
+
+    Base::initializeQMC(awc);
+  }
+  catch (const UniformCommunicateError& ue)
+  {
+    myComm->barrier_and_abort(ue.what());
+  }
+
+  num_beads_ = rmcdriver_input_.get_num_beads(qmcdriver_input_.get_tau());
+  if (num_beads_ < 2)
+    myComm->barrier_and_abort("RMCBatched::process a reptile needs at least two beads, increase beta or beads.");
+
+  branch_engine_ = std::make_unique<SFNBranch>(qmcdriver_input_.get_tau(), population_.get_num_global_walkers());
+  branch_engine_->put(node);
+
+  std::ostringstream o;
+  o << "  Number of reptiles = " << population_.get_num_global_walkers() << "\n";
+  o << "  Number of beads = " << num_beads_ << "\n";
+  o << "  Projection time = " << num_beads_ * qmcdriver_input_.get_tau() << " Ha^-1\n";
+  o << "  Heads or tails are moved unconditionally after " << rmcdriver_input_.get_max_age() << " steps\n";
+  app_log() << o.str() << std::endl;
+}
+
+void RMCBatched::initReptiles()
+{
+  reptiles_.resize(crowds_.size());
+  for (int crowd_id = 0; crowd_id < crowds_.size(); ++crowd_id)
+  {
+    auto& walkers = crowds_[crowd_id]->get_walkers();
+    reptiles_[crowd_id].resize(walkers.size());
+    for (int iw = 0; iw < walkers.size(); ++iw)
+      reptiles_[crowd_id][iw].init(num_beads_, walkers[iw]);
+  }
+}
+
+/** Runs the actual RMC section
+ *
+ *  Reptiles are started from the current walkers with all the beads on top of each other.
+ *  They are first grown vmcpresteps times, the default being two more than the number of beads,
+ *  then moved warmupSteps times without accumulating estimators.
+ */
+bool RMCBatched::run()
+{
+  IndexType num_blocks = qmcdriver_input_.get_max_blocks();
+
+  estimator_manager_->startDriverRun();
+  StateForThread rmc_state(qmcdriver_input_, rmcdriver_input_, *drift_modifier_, *branch_engine_, population_);
+
+  LoopTimer<> rmc_loop;
+  RunTimeControl<> runtimeControl(run_time_manager, project_data_.getMaxCPUSeconds(), project_data_.getTitle(),
+                                  myComm->rank() == 0);
+
+  { // walker initialization
+    ScopedTimer local_timer(timers_.init_walkers_timer);
+    ParallelExecutor<> section_start_task(qmcdriver_input_.get_threads_per_walker());
+    section_start_task(crowds_.size(), initialLogEvaluation, std::ref(crowds_), std::ref(step_contexts_),
+                       qmcdriver_input_.get_walker_random_streams());
+
+    FullPrecRealType energy, variance;
+    population_.measureGlobalEnergyVariance(*myComm, energy, variance);
+    // the population is fixed and walkers are never killed at node crossings.
+    branch_engine_->initParam(population_, energy, variance, true, false);
+
+    initReptiles();
+    print_mem("RMCBatched after initialLogEvaluation", app_summary());
+    if (qmcdriver_input_.get_measure_imbalance())
+      measureImbalance("InitialLogEvaluation");
+  }
+
+  ScopedTimer local_timer(timers_.production_timer);
+  ParallelExecutor<> crowd_task(qmcdriver_input_.get_threads_per_walker());
+
+  {
+    const IndexType num_presteps =
+        rmcdriver_input_.get_vmc_presteps() < 0 ? num_beads_ + 2 : rmcdriver_input_.get_vmc_presteps();
+    rmc_state.is_growing = true;
+    for (int step = 0; step < num_presteps; ++step)
+    {
+      ScopedTimer local_timer(timers_.run_steps_timer);
+      crowd_task(crowds_.size(), runRMCStep, rmc_state, std::ref(timers_), std::ref(step_contexts_),
+                 std::ref(crowds_), std::ref(reptiles_));
+    }
+    rmc_state.is_growing = false;
+    app_log() << "Finished " << num_presteps << " VMC presteps" << std::endl;
+
+    for (int step = 0; step < qmcdriver_input_.get_warmup_steps(); ++step)
+    {
+      ScopedTimer local_timer(timers_.run_steps_timer);
+      crowd_task(crowds_.size(), runRMCStep, rmc_state, std::ref(timers_), std::ref(step_contexts_),
+                 std::ref(crowds_), std::ref(reptiles_));
+    }
+    app_log() << "Warm-up is completed!" << std::endl;
+    print_mem("RMCBatched after Warmup", app_log());
+    if (qmcdriver_input_.get_measure_imbalance())
+      measureImbalance("Warmup");
+  }
+
+  // this barrier fences all previous load imbalance. Avoid block 0 timing pollution.
+  myComm->barrier();
+
+  rmc_state.accumulate_this_step = true;
+  for (int block = 0; block < num_blocks; ++block)
+  {
+    rmc_loop.start();
+    estimator_manager_->startBlock(qmcdriver_input_.get_max_steps());
+
+    rmc_state.is_recomputing_block = qmcdriver_input_.get_blocks_between_recompute()
+        ? (1 + block) % qmcdriver_input_.get_blocks_between_recompute() == 0
+        : false;
+
+    for (UPtr<Crowd>& crowd : crowds_)
+      crowd->startBlock(qmcdriver_input_.get_max_steps());
+
+    for (int step = 0; step < qmcdriver_input_.get_max_steps(); ++step)
+    {
+      ScopedTimer local_timer(timers_.run_steps_timer);
+      rmc_state.step = step;
+      crowd_task(crowds_.size(), runRMCStep, rmc_state, timers_, std::ref(step_contexts_), std::ref(crowds_),
+                 std::ref(reptiles_));
+    }
+    print_mem("RMCBatched after a block", app_debug_stream());
+    if (qmcdriver_input_.get_measure_imbalance())
+      measureImbalance("Block " + std::to_string(block));
+    endBlock();
+    rmc_loop.stop();
+
+    bool stop_requested = false;
+    // Rank 0 decides whether the time limit was reached
+    if (!myComm->rank())
+      stop_requested = runtimeControl.checkStop(rmc_loop);
+    myComm->bcast(stop_requested);
+
+    if (stop_requested)
+    {
+      if (!myComm->rank())
+        app_log() << runtimeControl.generateStopMessage("RMCBatched", block);
+      run_time_manager.markStop();
+      break;
+    }
+  }
+
+  print_mem("RMCBatched ends", app_log());
+
+  estimator_manager_->stopDriverRun();
+
+  return finalize(num_blocks, true);
+}
+
+} // namespace qmcplusplus
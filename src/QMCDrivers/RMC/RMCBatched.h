@@ -0,0 +1,134 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File refactored from: RMC.h
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef QMCPLUSPLUS_RMCBATCHED_H
+#define QMCPLUSPLUS_RMCBATCHED_H
+
+#include "QMCDrivers/QMCDriverNew.h"
+#include "QMCDrivers/RMC/RMCDriverInput.h"
+#include "QMCDrivers/RMC/ReptileRing.h"
+#include "QMCDrivers/MCPopulation.h"
+#include "QMCDrivers/ContextForSteps.h"
+#include "Particle/MCCoords.hpp"
+
+namespace qmcplusplus
+{
+class SFNBranch;
+
+namespace testing
+{
+class RMCBatchedTest;
+}
+
+/** @ingroup QMCDrivers  ParticleByParticle
+ * @brief Implements a RMC using particle-by-particle threaded and batched moves.
+ *
+ * Every walker of the population is the head of a reptile. The heads of the reptiles of a crowd
+ * are moved together through the multi-walker dispatchers, the earlier beads are kept in a ReptileRing
+ * per walker. A bounce reloads the tail of the reptile into the walker and recomputes the wavefunction.
+ */
+class RMCBatched : public QMCDriverNew
+{
+public:
+  using Base              = QMCDriverNew;
+  using FullPrecRealType  = QMCTraits::FullPrecRealType;
+  using PosType           = QMCTraits::PosType;
+  using ParticlePositions = PtclOnLatticeTraits::ParticlePos;
+
+  /** To avoid 10's of arguments to runRMCStep
+   *
+   *  There should be a division between const input to runRMCStep
+   *  And step to step state
+   */
+  struct StateForThread
+  {
+    const QMCDriverInput& qmcdrv_input;
+    const RMCDriverInput& rmcdrv_input;
+    const DriftModifierBase& drift_modifier;
+    const MCPopulation& population;
+    SFNBranch& branch_engine;
+    IndexType step            = -1;
+    bool is_recomputing_block = false;
+    /// only grow the reptiles, moves are not tested against the action
+    bool is_growing           = false;
+    bool accumulate_this_step = false;
+
+    StateForThread(const QMCDriverInput& qmci,
+                   const RMCDriverInput& rmci,
+                   DriftModifierBase& drift_mod,
+                   SFNBranch& branch_eng,
+                   MCPopulation& pop)
+        : qmcdrv_input(qmci), rmcdrv_input(rmci), drift_modifier(drift_mod), population(pop), branch_engine(branch_eng)
+    {}
+  };
+
+  /// Constructor.
+  RMCBatched(const ProjectData& project_data,
+             QMCDriverInput&& qmcdriver_input,
+             const std::optional<EstimatorManagerInput>& global_emi,
+             RMCDriverInput&& input,
+             WalkerConfigurations& wc,
+             MCPopulation&& pop,
+             Communicate* comm);
+
+  /// Copy Constructor (disabled)
+  RMCBatched(const RMCBatched&) = delete;
+  /// Copy operator (disabled).
+  RMCBatched& operator=(const RMCBatched&) = delete;
+
+  ~RMCBatched() override;
+
+  void process(xmlNodePtr node) override;
+
+  bool run() override;
+
+  /** Refactor of RMCUpdatePbyPWithDrift::advanceWalkersRMC in crowd context
+   *
+   *  @param reptiles bead histories of the walkers of the crowd, in the order of crowd.get_walkers()
+   */
+  template<CoordsType CT>
+  static void advanceReptiles(const StateForThread& sft,
+                              Crowd& crowd,
+                              std::vector<ReptileRing>& reptiles,
+                              DriverTimers& timers,
+                              ContextForSteps& move_context,
+                              bool recompute);
+
+  // This is the task body executed at crowd scope
+  // it does not have access to object members by design
+  static void runRMCStep(int crowd_id,
+                         const StateForThread& sft,
+                         DriverTimers& timers,
+                         UPtrVector<ContextForSteps>& context_for_steps,
+                         UPtrVector<Crowd>& crowds,
+                         std::vector<std::vector<ReptileRing>>& reptiles);
+
+  QMCRunType getRunType() override { return QMCRunType::RMC_BATCH; }
+
+private:
+  const RMCDriverInput rmcdriver_input_;
+  /// number of beads of every reptile
+  IndexType num_beads_;
+  /// provides the link action and the node crossing check
+  std::unique_ptr<SFNBranch> branch_engine_;
+  /// bead histories, one vector per crowd
+  std::vector<std::vector<ReptileRing>> reptiles_;
+
+  /// set all the beads of the reptiles to the current walkers
+  void initReptiles();
+
+  friend class qmcplusplus::testing::RMCBatchedTest;
+};
+
+} // namespace qmcplusplus
+
+#endif
@@ -0,0 +1,36 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+#include "RMCDriverInput.h"
+
+namespace qmcplusplus
+{
+void RMCDriverInput::readXML(xmlNodePtr node)
+{
+  ParameterSet parameter_set_;
+  // names as in RMC.cpp
+  parameter_set_.add(beta_, "beta");
+  parameter_set_.add(beads_, "beads");
+  parameter_set_.add(vmc_presteps_, "vmcpresteps");
+  parameter_set_.add(max_age_, "MaxAge");
+  parameter_set_.put(node);
+
+  if (beads_ < 1 && beta_ <= 0)
+    throw std::runtime_error("RMC input section needs the number of beads or the projection time beta");
+  if (beads_ == 1)
+    throw std::runtime_error("Illegal input for beads in RMC input section, a reptile needs at least two beads");
+  if (max_age_ < 0)
+    throw std::runtime_error("Illegal input for MaxAge in RMC input section");
+}
+
+std::ostream& operator<<(std::ostream& o_stream, const RMCDriverInput& rmci) { return o_stream; }
+
+} // namespace qmcplusplus
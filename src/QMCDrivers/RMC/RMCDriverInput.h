@@ -0,0 +1,62 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef QMCPLUSPLUS_RMCDRIVERINPUT_H
+#define QMCPLUSPLUS_RMCDRIVERINPUT_H
+
+#include "Configuration.h"
+#include "OhmmsData/ParameterSet.h"
+
+namespace qmcplusplus
+{
+/** Input representation for RMC driver class runtime parameters
+ */
+class RMCDriverInput
+{
+public:
+  using IndexType             = QMCTraits::IndexType;
+  using RealType              = QMCTraits::RealType;
+  using FullPrecisionRealType = QMCTraits::FullPrecRealType;
+  RMCDriverInput(){};
+  void readXML(xmlNodePtr xml_input);
+
+  /** number of beads of each reptile
+   *  @param tau time step, used when the length of the reptile is given as beta
+   */
+  IndexType get_num_beads(RealType tau) const { return beads_ > 0 ? beads_ : static_cast<IndexType>(beta_ / tau); }
+  /// number of steps which only grow the reptiles, -1 means beads + 2
+  IndexType get_vmc_presteps() const { return vmc_presteps_; }
+  IndexType get_max_age() const { return max_age_; }
+
+private:
+  /** @ingroup Parameters for RMC Driver
+   *  @{
+   *  
+   *  Do not write out blocks of gets for variables like this
+   *  there is are code_generation tools in QMCPACK_ROOT/utils/code_tools
+   */
+  ///projection time of the reptiles
+  RealType beta_ = -1;
+  ///number of beads of the reptiles, takes precedence over beta
+  IndexType beads_ = -1;
+  ///steps growing the reptiles without the action test
+  IndexType vmc_presteps_ = -1;
+  ///a head or tail older than this is moved regardless of the action
+  IndexType max_age_ = 10;
+  /** @} */
+public:
+  friend std::ostream& operator<<(std::ostream& o_stream, const RMCDriverInput& rmci);
+};
+
+extern std::ostream& operator<<(std::ostream& o_stream, const RMCDriverInput& rmci);
+
+} // namespace qmcplusplus
+#endif
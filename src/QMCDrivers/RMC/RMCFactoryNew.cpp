@@ -0,0 +1,51 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+#include "RMCFactoryNew.h"
+#include "QMCDrivers/RMC/RMCBatched.h"
+#include "EstimatorInputDelegates.h"
+
+namespace qmcplusplus
+{
+std::unique_ptr<QMCDriverInterface> RMCFactoryNew::create(const ProjectData& project_data,
+                                                          const std::optional<EstimatorManagerInput>& global_emi,
+                                                          WalkerConfigurations& wc,
+                                                          MCPopulation&& pop,
+                                                          Communicate* comm)
+{
+#if defined(QMC_CUDA)
+  comm->barrier_and_abort("RMC batched driver is not supported by legacy CUDA builds.");
+#endif
+
+  app_summary() << "\n========================================"
+                   "\n  Reading RMC driver XML input section"
+                   "\n========================================"
+                << std::endl;
+
+  QMCDriverInput qmcdriver_input;
+  RMCDriverInput rmcdriver_input;
+  try
+  {
+    qmcdriver_input.readXML(input_node_);
+    rmcdriver_input.readXML(input_node_);
+  }
+  catch (const std::exception& e)
+  {
+    throw UniformCommunicateError(e.what());
+  }
+
+  auto qmc = std::make_unique<RMCBatched>(project_data, std::move(qmcdriver_input), global_emi,
+                                          std::move(rmcdriver_input), wc, std::move(pop), comm);
+  // only particle-by-particle moves are implemented
+  qmc->setUpdateMode(rmc_mode_ & 1);
+  return qmc;
+}
+} // namespace qmcplusplus
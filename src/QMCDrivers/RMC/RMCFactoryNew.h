@@ -0,0 +1,48 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// Refactored from: RMCFactory.h
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef QMCPLUSPLUS_RMCFACTORYNEW_H
+#define QMCPLUSPLUS_RMCFACTORYNEW_H
+#include "QMCDrivers/QMCDriverInterface.h"
+#include "QMCWaveFunctions/WaveFunctionPool.h"
+#include "Message/Communicate.h"
+
+namespace qmcplusplus
+{
+class ParticleSetPool;
+class HamiltonianPool;
+class MCPopulation;
+class ProjectData;
+
+class RMCFactoryNew
+{
+private:
+  const int rmc_mode_;
+  xmlNodePtr input_node_;
+
+public:
+  RMCFactoryNew(xmlNodePtr cur, const int rmc_mode) : rmc_mode_(rmc_mode), input_node_(cur) {}
+
+  /** create a RMCBatched driver.
+   *  \param[in]   project_data   containing so basic options including DriverVersion and max_cpu_seconds
+   *  \param[in]   global_emi     optional global estimator manager input passed by value to insure copy,
+   *                              a global input should not be consumed by driver.
+   */
+  std::unique_ptr<QMCDriverInterface> create(const ProjectData& project_data,
+                                             const std::optional<EstimatorManagerInput>& global_emi,
+                                             WalkerConfigurations& wc,
+                                             MCPopulation&& pop,
+                                             Communicate* comm);
+};
+} // namespace qmcplusplus
+
+#endif
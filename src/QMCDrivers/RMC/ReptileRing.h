@@ -0,0 +1,141 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+/** @file ReptileRing.h
+ * @brief Bead history of a reptile used by the batched RMC driver
+ */
+#ifndef QMCPLUSPLUS_REPTILERING_H
+#define QMCPLUSPLUS_REPTILERING_H
+
+#include <algorithm>
+#include <cassert>
+#include <vector>
+#include "Configuration.h"
+#include "Particle/Walker.h"
+#include "QMCDrivers/WalkerProperties.h"
+
+namespace qmcplusplus
+{
+/** Circular queue of the beads of one reptile.
+ *
+ * Unlike Reptile, which addresses a segment of full walkers in MCWalkerConfiguration, the beads
+ * only keep what RMC needs to move the reptile: positions, spins, the property row and the age.
+ * Each kind is stored contiguously for all the beads. The walker and its ParticleSet and TrialWaveFunction
+ * hold the head, so growing the reptile overwrites the storage of the tail and bouncing only flips
+ * the direction in which the beads are read.
+ * The bead i counted from the head uses the storage slot headindex+direction*i, as in Reptile.
+ */
+class ReptileRing
+{
+public:
+  using Walker_t         = Walker<QMCTraits, PtclOnLatticeTraits>;
+  using WP               = WalkerProperties::Indexes;
+  using PosType          = QMCTraits::PosType;
+  using FullPrecRealType = QMCTraits::FullPrecRealType;
+  using SpinType         = Walker_t::ParticleScalar::Type_t;
+
+  /** resize to nbeads and set all the beads to the state of walker
+   * @param nbeads number of beads, at least 2
+   * @param walker initial configuration and properties of every bead
+   */
+  inline void init(int nbeads, const Walker_t& walker)
+  {
+    assert(nbeads > 1);
+    nbeads_    = nbeads;
+    nptcl_     = walker.R.size();
+    nprops_    = walker.Properties.cols();
+    headindex_ = 0;
+    direction_ = 1;
+    positions_.resize(nbeads_ * nptcl_);
+    spins_.resize(nbeads_ * nptcl_);
+    properties_.resize(nbeads_ * nprops_);
+    ages_.resize(nbeads_);
+    for (int slot = 0; slot < nbeads_; slot++)
+      storeBead(slot, walker);
+  }
+
+  inline int size() const { return nbeads_; }
+  inline int getDirection() const { return direction_; }
+
+  /// storage slot of the bead i counted from the head
+  inline int getBeadIndex(int i) const { return wrapIndex(headindex_ + direction_ * i); }
+
+  inline const PosType* getBeadPositions(int i) const { return positions_.data() + getBeadIndex(i) * nptcl_; }
+  inline const FullPrecRealType* getBeadProperties(int i) const
+  {
+    return properties_.data() + getBeadIndex(i) * nprops_;
+  }
+  inline int getBeadAge(int i) const { return ages_[getBeadIndex(i)]; }
+
+  inline const FullPrecRealType* getHeadProperties() const { return getBeadProperties(0); }
+  inline const FullPrecRealType* getTailProperties() const { return getBeadProperties(nbeads_ - 1); }
+  /// the bead next to the tail, it becomes the tail when the reptile grows
+  inline const FullPrecRealType* getNextProperties() const { return getBeadProperties(nbeads_ - 2); }
+  inline const FullPrecRealType* getCenterProperties() const { return getBeadProperties((nbeads_ - 1) / 2); }
+  inline int getHeadAge() const { return getBeadAge(0); }
+  inline int getTailAge() const { return getBeadAge(nbeads_ - 1); }
+
+  /// move the reptile forward, the storage of the tail receives the state of walker as the new head
+  inline void growHead(const Walker_t& walker)
+  {
+    headindex_ = getBeadIndex(nbeads_ - 1);
+    storeBead(headindex_, walker);
+  }
+
+  /// reverse the reptile, the tail becomes the head
+  inline void flip()
+  {
+    headindex_ = wrapIndex(headindex_ - direction_);
+    direction_ *= -1;
+  }
+
+  inline void incrementHeadAge() { ages_[getBeadIndex(0)]++; }
+
+  /// copy positions, spins, properties and age of the head into walker
+  inline void loadHead(Walker_t& walker) const
+  {
+    const int slot = getBeadIndex(0);
+    std::copy_n(positions_.data() + slot * nptcl_, nptcl_, walker.R.begin());
+    std::copy_n(spins_.data() + slot * nptcl_, nptcl_, walker.spins.begin());
+    std::copy_n(properties_.data() + slot * nprops_, nprops_, walker.Properties[0]);
+    walker.Age = ages_[slot];
+  }
+
+private:
+  int nbeads_    = 0;
+  int nptcl_     = 0;
+  int nprops_    = 0;
+  int headindex_ = 0;
+  int direction_ = 1;
+
+  /// nbeads x nptcl positions
+  std::vector<PosType> positions_;
+  /// nbeads x nptcl spins
+  std::vector<SpinType> spins_;
+  /// nbeads x nprops walker properties, the first row of Walker::Properties
+  std::vector<FullPrecRealType> properties_;
+  /// age of the beads in steps without a move
+  std::vector<int> ages_;
+
+  inline int wrapIndex(int index) const { return (index % nbeads_ + nbeads_) % nbeads_; }
+
+  inline void storeBead(int slot, const Walker_t& walker)
+  {
+    std::copy_n(walker.R.begin(), nptcl_, positions_.data() + slot * nptcl_);
+    std::copy_n(walker.spins.begin(), nptcl_, spins_.data() + slot * nptcl_);
+    std::copy_n(walker.Properties[0], nprops_, properties_.data() + slot * nprops_);
+    ages_[slot] = walker.Age;
+  }
+};
+
+} // namespace qmcplusplus
+#endif
@@ -39,9 +39,7 @@ SOVMCUpdatePbyP::~SOVMCUpdatePbyP() {}
 void SOVMCUpdatePbyP::advanceWalker(Walker_t& thisWalker, bool recompute)
 {
   buffer_timer_.start();
-  W.loadWalker(thisWalker, true);
-  Walker_t::WFBuffer_t& w_buffer(thisWalker.DataSet);
-  Psi.copyFromBuffer(W, w_buffer);
+  loadWalkerAndPsi(thisWalker);
   buffer_timer_.stop();
 
   // start PbyP moves
@@ -128,7 +126,7 @@ void SOVMCUpdatePbyP::advanceWalker(Walker_t& thisWalker, bool recompute)
   W.donePbyP();
   movepbyp_timer_.stop();
   buffer_timer_.start();
-  RealType logpsi = Psi.updateBuffer(W, w_buffer, recompute);
+  RealType logpsi = updatePsiAndBuffer(thisWalker, recompute);
   if (debug_checks_ & DriverDebugChecks::CHECKGL_AFTER_MOVES)
     checkLogAndGL(W, Psi, "checkGL_after_moves");
   W.saveWalker(thisWalker);
@@ -51,6 +51,7 @@ VMC::VMC(const ProjectData& project_data,
   m_param.add(UseDrift, "useDrift");
   m_param.add(UseDrift, "usedrift");
   m_param.add(UseDrift, "use_drift");
+  m_param.add(walker_buffer_, "walker_buffer", {"yes", "no", "auto"});
 
   prevSteps               = nSteps;
   prevStepsBetweenSamples = nStepsBetweenSamples;
@@ -264,12 +265,15 @@ void VMC::resetRun()
   //for (int ip=0; ip<NumThreads; ++ip)
   //  app_log()  << "    Sample size for thread " <<ip<<" = " << samples_th[ip] << std::endl;
   app_log().flush();
+  const bool keep_walker_buffer =
+      qmc_driver_mode[QMC_UPDATE_MODE] ? keepWalkerBuffer(*wClones[0], *psiClones[0]) : true;
 #pragma omp parallel for
   for (int ip = 0; ip < NumThreads; ++ip)
   {
     //int ip=omp_get_thread_num();
     Movers[ip]->put(qmcNode);
     Movers[ip]->resetRun(branchEngine.get(), estimatorClones[ip], traceClones[ip], DriftModifier);
+    Movers[ip]->setKeepWalkerBuffer(keep_walker_buffer);
     if (qmc_driver_mode[QMC_UPDATE_MODE])
       Movers[ip]->initWalkersForPbyP(W.begin() + wPerRank[ip], W.begin() + wPerRank[ip + 1]);
     else
@@ -17,7 +17,6 @@
 #include "Message/CommOperators.h"
 #include "Utilities/RunTimeManager.h"
 #include "ParticleBase/RandomSeqGenerator.h"
-#include "Particle/MCSample.h"
 #include "MemoryUsage.h"
 #include "QMCWaveFunctions/TWFGrads.hpp"
 #include "TauParams.hpp"
@@ -78,29 +77,21 @@ void VMCBatched::advanceWalkers(const StateForThread& sft,
   const int num_walkers   = crowd.size();
   auto& walker_leader     = walker_elecs.getLeader();
   const int num_particles = walker_leader.getTotalNum();
-  // Note std::vector<bool> is not like the rest of stl.
-  std::vector<bool> moved(num_walkers, false);
-  constexpr RealType mhalf(-0.5);
   const bool use_drift = sft.vmcdrv_input.get_use_drift();
+  // draw from the random streams of the walkers instead of the one of the crowd
+  const bool walker_streams = sft.qmcdrv_input.get_walker_random_streams();
 
-  std::vector<TrialWaveFunction::PsiValueType> ratios(num_walkers);
-  std::vector<RealType> log_gf(num_walkers);
-  std::vector<RealType> log_gb(num_walkers);
-  std::vector<RealType> prob(num_walkers);
-
-  // local list to handle accept/reject
-  std::vector<bool> isAccepted;
-  std::vector<std::reference_wrapper<TrialWaveFunction>> twf_accept_list, twf_reject_list;
-  isAccepted.reserve(num_walkers);
-
-  MCCoords<CT> drifts(num_walkers), drifts_reverse(num_walkers);
-  MCCoords<CT> walker_deltas(num_walkers * num_particles), deltas(num_walkers);
-  TWFGrads<CT> grads_now(num_walkers), grads_new(num_walkers);
+  // preallocated per walker temporaries of the moves, reused by every electron
+  auto& buffers = step_context.get_step_buffers<CT>();
+  buffers.prepareStep(num_walkers, num_particles);
 
   for (int sub_step = 0; sub_step < sft.qmcdrv_input.get_sub_steps(); sub_step++)
   {
     //This generates an entire steps worth of deltas.
-    makeGaussRandomWithEngine(walker_deltas, step_context.get_random_gen());
+    if (walker_streams)
+      makeGaussRandomWithWalkerStreams(walkers, buffers.walker_deltas);
+    else
+      makeGaussRandomWithEngine(buffers.walker_deltas, step_context.get_random_gen());
 
     // up and down electrons are "species" within qmpack
     for (int ig = 0; ig < walker_leader.groups(); ++ig) //loop over species
@@ -112,57 +103,48 @@ void VMCBatched::advanceWalkers(const StateForThread& sft,
 
       for (int iat = walker_leader.first(ig); iat < walker_leader.last(ig); ++iat)
       {
-        //get deltas for this particle (iat) for all walkers
-        walker_deltas.getSubset(iat * num_walkers, num_walkers, deltas);
-        scaleBySqrtTau(taus, deltas);
+        //get deltas for this particle (iat) for all walkers, scaled by sqrt(tau)
+        buffers.loadDeltas(iat, taus);
 
         if (use_drift)
         {
-          twf_dispatcher.flex_evalGrad(walker_twfs, walker_elecs, iat, grads_now);
-          sft.drift_modifier.getDrifts(taus, grads_now, drifts);
-          drifts += deltas;
+          twf_dispatcher.flex_evalGrad(walker_twfs, walker_elecs, iat, buffers.grads_now);
+          sft.drift_modifier.getDrifts(taus, buffers.grads_now, buffers.drifts);
+          buffers.drifts += buffers.deltas;
         }
         else
-          drifts = deltas;
+          buffers.drifts = buffers.deltas;
 
-        ps_dispatcher.flex_makeMove(walker_elecs, iat, drifts);
+        ps_dispatcher.flex_makeMove(walker_elecs, iat, buffers.drifts);
 
         // This is inelegant
         if (use_drift)
         {
-          twf_dispatcher.flex_calcRatioGrad(walker_twfs, walker_elecs, iat, ratios, grads_new);
-
-          computeLogGreensFunction(deltas, taus, log_gf);
-
-          sft.drift_modifier.getDrifts(taus, grads_new, drifts_reverse);
-
-          drifts_reverse += drifts;
-
-          computeLogGreensFunction(drifts_reverse, taus, log_gb);
+          twf_dispatcher.flex_calcRatioGrad(walker_twfs, walker_elecs, iat, buffers.ratios, buffers.grads_new);
+          sft.drift_modifier.getDrifts(taus, buffers.grads_new, buffers.drifts_reverse);
         }
         else
-          twf_dispatcher.flex_calcRatio(walker_twfs, walker_elecs, iat, ratios);
-
-        std::transform(ratios.begin(), ratios.end(), prob.begin(), [](auto ratio) { return std::norm(ratio); });
+          twf_dispatcher.flex_calcRatio(walker_twfs, walker_elecs, iat, buffers.ratios);
 
-        isAccepted.clear();
+        buffers.computeAcceptance(taus, use_drift);
 
         for (int i_accept = 0; i_accept < num_walkers; ++i_accept)
-          if (prob[i_accept] >= std::numeric_limits<RealType>::epsilon() &&
-              step_context.get_random_gen()() < prob[i_accept] * std::exp(log_gb[i_accept] - log_gf[i_accept]))
+          if (std::norm(buffers.ratios[i_accept]) >= std::numeric_limits<RealType>::epsilon() &&
+              (walker_streams ? walkers[i_accept].get().RandomStream() : step_context.get_random_gen()()) <
+                  buffers.prob[i_accept])
           {
             crowd.incAccept();
-            isAccepted.push_back(true);
+            buffers.isAccepted[i_accept] = true;
           }
           else
           {
             crowd.incReject();
-            isAccepted.push_back(false);
+            buffers.isAccepted[i_accept] = false;
           }
 
-        twf_dispatcher.flex_accept_rejectMove(walker_twfs, walker_elecs, iat, isAccepted, true);
+        twf_dispatcher.flex_accept_rejectMove(walker_twfs, walker_elecs, iat, buffers.isAccepted, true);
 
-        ps_dispatcher.flex_accept_rejectMove<CT>(walker_elecs, iat, isAccepted);
+        ps_dispatcher.flex_accept_rejectMove<CT>(walker_elecs, iat, buffers.isAccepted);
       }
     }
     twf_dispatcher.flex_completeUpdates(walker_twfs);
@@ -193,11 +175,7 @@ void VMCBatched::advanceWalkers(const StateForThread& sft,
 
   // moved to be consistent with DMC
   timers.collectables_timer.start();
-  auto evaluateNonPhysicalHamiltonianElements = [](QMCHamiltonian& ham, ParticleSet& pset, MCPWalker& walker) {
-    ham.auxHevaluate(pset, walker);
-  };
-  for (int iw = 0; iw < crowd.size(); ++iw)
-    evaluateNonPhysicalHamiltonianElements(walker_hamiltonians[iw], walker_elecs[iw], walkers[iw]);
+  ham_dispatcher.flex_auxHevaluate(walker_hamiltonians, walker_twfs, walker_elecs, walkers);
 
   auto savePropertiesIntoWalker = [](QMCHamiltonian& ham, MCPWalker& walker) {
     ham.saveProperty(walker.getPropertyBase());
@@ -239,7 +217,10 @@ void VMCBatched::runVMCStep(int crowd_id,
                             std::vector<std::unique_ptr<Crowd>>& crowds)
 {
   Crowd& crowd = *(crowds[crowd_id]);
-  crowd.setRNGForHamiltonian(context_for_steps[crowd_id]->get_random_gen());
+  if (sft.qmcdrv_input.get_walker_random_streams())
+    crowd.setWalkerRNGForHamiltonian(context_for_steps[crowd_id]->get_random_gen());
+  else
+    crowd.setRNGForHamiltonian(context_for_steps[crowd_id]->get_random_gen());
   const int max_steps  = sft.qmcdrv_input.get_max_steps();
   const IndexType step = sft.step;
   // Are we entering the the last step of a block to recompute at?
@@ -263,7 +244,8 @@ void VMCBatched::process(xmlNodePtr node)
   {
     QMCDriverNew::AdjustedWalkerCounts awc =
         adjustGlobalWalkerCount(myComm->size(), myComm->rank(), qmcdriver_input_.get_total_walkers(),
-                                qmcdriver_input_.get_walkers_per_rank(), 1.0, qmcdriver_input_.get_num_crowds());
+                                qmcdriver_input_.get_walkers_per_rank(), 1.0, qmcdriver_input_.get_num_crowds(),
+                                qmcdriver_input_.get_threads_per_walker());
 
     Base::initializeQMC(awc);
   }
@@ -307,22 +289,27 @@ bool VMCBatched::run()
 
   { // walker initialization
     ScopedTimer local_timer(timers_.init_walkers_timer);
-    ParallelExecutor<> section_start_task;
-    section_start_task(crowds_.size(), initialLogEvaluation, std::ref(crowds_), std::ref(step_contexts_));
+    ParallelExecutor<> section_start_task(qmcdriver_input_.get_threads_per_walker());
+    section_start_task(crowds_.size(), initialLogEvaluation, std::ref(crowds_), std::ref(step_contexts_),
+                       qmcdriver_input_.get_walker_random_streams());
     print_mem("VMCBatched after initialLogEvaluation", app_summary());
     if (qmcdriver_input_.get_measure_imbalance())
       measureImbalance("InitialLogEvaluation");
   }
 
   ScopedTimer local_timer(timers_.production_timer);
-  ParallelExecutor<> crowd_task;
+  ParallelExecutor<> crowd_task(qmcdriver_input_.get_threads_per_walker());
 
   if (qmcdriver_input_.get_warmup_steps() > 0)
   {
     // Run warm-up steps
     auto runWarmupStep = [](int crowd_id, StateForThread& sft, DriverTimers& timers,
                             UPtrVector<ContextForSteps>& context_for_steps, UPtrVector<Crowd>& crowds) {
-      Crowd& crowd                    = *(crowds[crowd_id]);
+      Crowd& crowd = *(crowds[crowd_id]);
+      if (sft.qmcdrv_input.get_walker_random_streams())
+        crowd.setWalkerRNGForHamiltonian(context_for_steps[crowd_id]->get_random_gen());
+      else
+        crowd.setRNGForHamiltonian(context_for_steps[crowd_id]->get_random_gen());
       const bool recompute            = false;
       const bool accumulate_this_step = false;
       const bool spin_move            = sft.population.get_golden_electrons().isSpinor();
@@ -374,7 +361,7 @@ bool VMCBatched::run()
         const auto& elec_psets = population_.get_elec_particle_sets();
         for (const auto& walker : elec_psets)
         {
-          samples_.appendSample(MCSample(*walker));
+          samples_.appendSample(*walker);
         }
       }
     }
@@ -397,6 +384,9 @@ bool VMCBatched::run()
       run_time_manager.markStop();
       break;
     }
+
+    if (checkReblockingStop(block))
+      break;
   }
   // This is confusing logic from VMC.cpp want this functionality write documentation of this
   // and clean it up
@@ -0,0 +1,194 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "DerivRecordStore.h"
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+
+namespace qmcplusplus
+{
+DerivRecordStore::~DerivRecordStore() { closeSpillFile(); }
+
+void DerivRecordStore::setup(const Options& opts, const std::string& spill_name)
+{
+  opts_       = opts;
+  spill_name_ = spill_name;
+  if (opts_.block_size < 1)
+    throw std::runtime_error("DerivRecordStore::setup block_size must be positive");
+}
+
+void DerivRecordStore::closeSpillFile()
+{
+  if (spill_file_.is_open())
+    spill_file_.close();
+  if (!spill_path_.empty())
+    std::remove(spill_path_.c_str());
+  spill_path_.clear();
+}
+
+void DerivRecordStore::resize(size_t num_samples, size_t num_params)
+{
+  closeSpillFile();
+  num_samples_ = num_samples;
+  num_params_  = num_params;
+  block_size_  = opts_.block_size;
+  num_blocks_  = (num_samples_ + block_size_ - 1) / block_size_;
+
+  const size_t block_bytes = block_size_ * rowBytes();
+  num_resident_blocks_     = num_blocks_;
+  if (opts_.max_memory_mb > 0 && block_bytes > 0)
+    num_resident_blocks_ = std::min(num_blocks_, static_cast<size_t>(opts_.max_memory_mb * 1024 * 1024 / block_bytes));
+
+  blocks_.clear();
+  blocks_.resize(num_resident_blocks_);
+  for (auto& block : blocks_)
+    block.assign(block_bytes, 0);
+
+  if (num_resident_blocks_ < num_blocks_)
+  {
+    spill_path_ = opts_.spill_dir + "/" + spill_name_;
+    spill_file_.open(spill_path_, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!spill_file_.is_open())
+      throw std::runtime_error("DerivRecordStore::resize cannot open spill file " + spill_path_);
+    // reserve the whole file so that any row can be written in place
+    const std::vector<char> zeros(block_bytes, 0);
+    for (size_t ib = num_resident_blocks_; ib < num_blocks_; ib++)
+      spill_file_.write(zeros.data(), zeros.size());
+    spill_file_.flush();
+    if (!spill_file_)
+      throw std::runtime_error("DerivRecordStore::resize failed to reserve spill file " + spill_path_);
+  }
+}
+
+void DerivRecordStore::clear()
+{
+  closeSpillFile();
+  blocks_.clear();
+  num_samples_         = 0;
+  num_params_          = 0;
+  num_blocks_          = 0;
+  num_resident_blocks_ = 0;
+}
+
+void DerivRecordStore::packRow(const Real* dlogpsi, const Real* dhpsioverpsi, char* row) const
+{
+  if (opts_.reduced_precision)
+  {
+    float* out = reinterpret_cast<float*>(row);
+    for (size_t ip = 0; ip < num_params_; ip++)
+    {
+      out[ip]               = static_cast<float>(dlogpsi[ip]);
+      out[num_params_ + ip] = static_cast<float>(dhpsioverpsi[ip]);
+    }
+  }
+  else
+  {
+    double* out = reinterpret_cast<double*>(row);
+    for (size_t ip = 0; ip < num_params_; ip++)
+    {
+      out[ip]               = dlogpsi[ip];
+      out[num_params_ + ip] = dhpsioverpsi[ip];
+    }
+  }
+}
+
+void DerivRecordStore::unpackRow(const char* row, Real* dlogpsi, Real* dhpsioverpsi) const
+{
+  if (opts_.reduced_precision)
+  {
+    const float* in = reinterpret_cast<const float*>(row);
+    for (size_t ip = 0; ip < num_params_; ip++)
+    {
+      dlogpsi[ip]      = in[ip];
+      dhpsioverpsi[ip] = in[num_params_ + ip];
+    }
+  }
+  else
+  {
+    const double* in = reinterpret_cast<const double*>(row);
+    for (size_t ip = 0; ip < num_params_; ip++)
+    {
+      dlogpsi[ip]      = in[ip];
+      dhpsioverpsi[ip] = in[num_params_ + ip];
+    }
+  }
+}
+
+void DerivRecordStore::writeRow(size_t is, const Real* dlogpsi, const Real* dhpsioverpsi)
+{
+  assert(is < num_samples_);
+  const size_t ib       = is / block_size_;
+  const size_t row_byte = (is - ib * block_size_) * rowBytes();
+  if (ib < num_resident_blocks_)
+    packRow(dlogpsi, dhpsioverpsi, blocks_[ib].data() + row_byte);
+  else
+  {
+    std::vector<char> row(rowBytes());
+    packRow(dlogpsi, dhpsioverpsi, row.data());
+    std::lock_guard<std::mutex> lock(spill_mutex_);
+    spill_file_.seekp((ib - num_resident_blocks_) * block_size_ * rowBytes() + row_byte);
+    spill_file_.write(row.data(), row.size());
+    if (!spill_file_)
+      throw std::runtime_error("DerivRecordStore::writeRow failed to write " + spill_path_);
+  }
+}
+
+void DerivRecordStore::readRow(size_t is, Real* dlogpsi, Real* dhpsioverpsi) const
+{
+  assert(is < num_samples_);
+  const size_t ib       = is / block_size_;
+  const size_t row_byte = (is - ib * block_size_) * rowBytes();
+  if (ib < num_resident_blocks_)
+    unpackRow(blocks_[ib].data() + row_byte, dlogpsi, dhpsioverpsi);
+  else
+  {
+    std::vector<char> row(rowBytes());
+    {
+      std::lock_guard<std::mutex> lock(spill_mutex_);
+      spill_file_.seekg((ib - num_resident_blocks_) * block_size_ * rowBytes() + row_byte);
+      spill_file_.read(row.data(), row.size());
+      if (!spill_file_)
+        throw std::runtime_error("DerivRecordStore::readRow failed to read " + spill_path_);
+    }
+    unpackRow(row.data(), dlogpsi, dhpsioverpsi);
+  }
+}
+
+void DerivRecordStore::loadBlock(size_t ib, Matrix<Real>& dlogpsi, Matrix<Real>& dhpsioverpsi) const
+{
+  assert(ib < num_blocks_);
+  const size_t nrows = blockLast(ib) - blockFirst(ib);
+  dlogpsi.resize(nrows, num_params_);
+  dhpsioverpsi.resize(nrows, num_params_);
+
+  const char* rows = nullptr;
+  std::vector<char> spilled;
+  if (ib < num_resident_blocks_)
+    rows = blocks_[ib].data();
+  else
+  {
+    spilled.resize(nrows * rowBytes());
+    std::lock_guard<std::mutex> lock(spill_mutex_);
+    spill_file_.seekg((ib - num_resident_blocks_) * block_size_ * rowBytes());
+    spill_file_.read(spilled.data(), spilled.size());
+    if (!spill_file_)
+      throw std::runtime_error("DerivRecordStore::loadBlock failed to read " + spill_path_);
+    rows = spilled.data();
+  }
+
+  for (size_t ir = 0; ir < nrows; ir++)
+    unpackRow(rows + ir * rowBytes(), dlogpsi[ir], dhpsioverpsi[ir]);
+}
+
+} // namespace qmcplusplus
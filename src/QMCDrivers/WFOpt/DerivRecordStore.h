@@ -0,0 +1,117 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+/** @file DerivRecordStore.h
+ * @brief Blocked storage of the per-sample parameter derivatives used by the batched optimizer
+ */
+#ifndef QMCPLUSPLUS_DERIVRECORDSTORE_H
+#define QMCPLUSPLUS_DERIVRECORDSTORE_H
+
+#include <algorithm>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "Configuration.h"
+#include "OhmmsPETE/OhmmsMatrix.h"
+
+namespace qmcplusplus
+{
+/** Storage of the per-sample derivative records, d log(psi)/dp and (1/psi) dH psi/dp.
+ *
+ * Each rank only holds the records of its own samples. The samples are grouped in blocks
+ * of block_size rows and a row keeps both records of one sample. Blocks are kept in memory,
+ * optionally in single precision, until max_memory_mb is used and the remaining blocks are
+ * spilled to a node-local file. Reductions over the samples stream through the blocks with loadBlock
+ * so that only one block at a time needs to be in full precision.
+ */
+class DerivRecordStore
+{
+public:
+  using Real = QMCTraits::RealType;
+
+  struct Options
+  {
+    /// store the records in single precision
+    bool reduced_precision = false;
+    /// memory for in-memory blocks in MB, 0 means no limit
+    double max_memory_mb = 0.0;
+    /// directory of the spill file, preferably on node-local storage
+    std::string spill_dir = ".";
+    /// number of samples per block
+    int block_size = 256;
+  };
+
+  DerivRecordStore() = default;
+  ~DerivRecordStore();
+
+  /** set the storage options and the name of the spill file, takes effect at the next resize
+   * @param opts storage options
+   * @param spill_name file name of this store in opts.spill_dir, must be unique per rank
+   */
+  void setup(const Options& opts, const std::string& spill_name);
+
+  /// allocate the storage, previously stored records are lost
+  void resize(size_t num_samples, size_t num_params);
+  /// release the records and remove the spill file
+  void clear();
+
+  size_t numSamples() const { return num_samples_; }
+  size_t numParams() const { return num_params_; }
+  size_t numBlocks() const { return num_blocks_; }
+  /// first sample of block ib
+  size_t blockFirst(size_t ib) const { return ib * block_size_; }
+  /// one past the last sample of block ib
+  size_t blockLast(size_t ib) const { return std::min(num_samples_, (ib + 1) * block_size_); }
+  /// number of blocks kept in memory
+  size_t numResidentBlocks() const { return num_resident_blocks_; }
+  /// path of the spill file, empty if all the blocks are in memory
+  const std::string& spillPath() const { return spill_path_; }
+
+  /// store the records of sample is, thread-safe for distinct samples
+  void writeRow(size_t is, const Real* dlogpsi, const Real* dhpsioverpsi);
+  /// retrieve the records of sample is in full precision
+  void readRow(size_t is, Real* dlogpsi, Real* dhpsioverpsi) const;
+  /** retrieve the records of block ib in full precision
+   * @param dlogpsi resized to the samples of the block times numParams()
+   * @param dhpsioverpsi resized to the samples of the block times numParams()
+   */
+  void loadBlock(size_t ib, Matrix<Real>& dlogpsi, Matrix<Real>& dhpsioverpsi) const;
+
+private:
+  Options opts_;
+  std::string spill_name_;
+
+  size_t num_samples_         = 0;
+  size_t num_params_          = 0;
+  size_t block_size_          = 1;
+  size_t num_blocks_          = 0;
+  size_t num_resident_blocks_ = 0;
+
+  /// in-memory blocks, each holds block_size rows of 2*num_params values in the storage precision
+  std::vector<std::vector<char>> blocks_;
+  /// spill file for the blocks beyond num_resident_blocks_
+  mutable std::fstream spill_file_;
+  mutable std::mutex spill_mutex_;
+  std::string spill_path_;
+
+  /// bytes of one stored row
+  size_t rowBytes() const { return 2 * num_params_ * (opts_.reduced_precision ? sizeof(float) : sizeof(double)); }
+  /// convert one row to the storage precision
+  void packRow(const Real* dlogpsi, const Real* dhpsioverpsi, char* row) const;
+  /// convert one row from the storage precision
+  void unpackRow(const char* row, Real* dlogpsi, Real* dhpsioverpsi) const;
+  void closeSpillFile();
+};
+
+} // namespace qmcplusplus
+#endif
@@ -18,6 +18,8 @@
 
 #include "LinearMethod.h"
 #include <vector>
+#include <algorithm>
+#include <cmath>
 #include "QMCCostFunctionBase.h"
 #include <CPU/BLAS.hpp>
 
@@ -155,17 +157,214 @@ LinearMethod::Real LinearMethod::getNonLinearRescale(std::vector<Real>& dP,
   getNonLinearRange(first, last, optTarget);
   if (first == last)
     return 1.0;
-  Real rescale(1.0);
-  Real xi(0.5);
   Real D(0.0);
   for (int i = first; i < last; i++)
     for (int j = first; j < last; j++)
       D += S(i + 1, j + 1) * dP[i + 1] * dP[j + 1];
+  return getNonLinearRescale(D);
+}
+
+LinearMethod::Real LinearMethod::getNonLinearRescale(std::vector<Real>& dP,
+                                                     const std::vector<Real>& D_avg,
+                                                     const QMCCostFunctionBase& optTarget) const
+{
+  int first(0), last(0);
+  getNonLinearRange(first, last, optTarget);
+  if (first == last)
+    return 1.0;
+  Matrix<Real> y(1, dP.size()), Hy, Sy;
+  y = 0.0;
+  for (int i = first; i < last; i++)
+    y(0, i + 1) = dP[i + 1];
+  optTarget.applyOverlapHamiltonian(D_avg, y, Hy, Sy);
+  Real D(0.0);
+  for (int i = first; i < last; i++)
+    D += y(0, i + 1) * Sy(0, i + 1);
+  return getNonLinearRescale(D);
+}
+
+LinearMethod::Real LinearMethod::getNonLinearRescale(Real D) const
+{
+  Real rescale(1.0);
+  Real xi(0.5);
   rescale = (1 - xi) * D / ((1 - xi) + xi * std::sqrt(1 + D));
   rescale = 1.0 / (1.0 - rescale);
   //     app_log()<<"rescale: "<<rescale<< std::endl;
   return rescale;
 }
 
+LinearMethod::Real LinearMethod::getLowestEigenvectorDavidson(const QMCCostFunctionBase& optTarget,
+                                                              const std::vector<Real>& D_avg,
+                                                              Real shift_i,
+                                                              Real shift_s,
+                                                              std::vector<Real>& ev,
+                                                              int max_iterations,
+                                                              Real tolerance) const
+{
+  const int N = ev.size();
+  // largest subspace kept before restarting from the current Ritz vector
+  const int max_subspace = std::min(N, 32);
+
+  std::vector<Real> diagH, diagS;
+  optTarget.getOverlapHamiltonianDiagonals(D_avg, diagH, diagS);
+  // regularization of empty overlap rows, as done for the dense inverse
+  std::vector<Real> reg_s(N, 0.0);
+  for (int i = 1; i < N; i++)
+    if (diagS[i] == 0)
+      reg_s[i] = shift_i * shift_s;
+
+  // A = H + shift_i I + shift_s S and B = S on the parameter block, row and column 0 are not shifted.
+  // The overlap shift needs S restricted to the parameter block, S x - x_0 S e_0, so S e_0 is kept.
+  Matrix<Real> x(1, N), hx, sx;
+  x       = 0.0;
+  x(0, 0) = 1.0;
+  optTarget.applyOverlapHamiltonian(D_avg, x, hx, sx);
+  const std::vector<Real> s_col0(sx[0], sx[0] + N);
+
+  Matrix<Real> V(max_subspace, N), AV(max_subspace, N), BV(max_subspace, N);
+  auto applyShifted = [&](int k) {
+    for (int i = 0; i < N; i++)
+    {
+      AV(k, i) = hx(0, i);
+      BV(k, i) = sx(0, i) + reg_s[i] * x(0, i);
+    }
+    for (int i = 1; i < N; i++)
+      AV(k, i) += shift_i * x(0, i) + shift_s * (sx(0, i) - x(0, 0) * s_col0[i]);
+    std::copy(x[0], x[0] + N, V[k]);
+  };
+  applyShifted(0);
+
+  // preconditioner from the diagonals of the shifted matrices
+  std::vector<Real> diagA(diagH), diagB(diagS);
+  for (int i = 1; i < N; i++)
+  {
+    diagA[i] += shift_i + shift_s * diagS[i];
+    diagB[i] += reg_s[i];
+  }
+
+  const Real E0 = AV(0, 0) / BV(0, 0);
+  std::vector<Real> u(N), Au(N), Bu(N), r(N);
+  Real theta(E0);
+  Real rnorm(0);
+  int nvec(1);
+  int num_iterations(0);
+  for (int iter = 0; iter < std::max(max_iterations, 1); iter++)
+  {
+    num_iterations++;
+    // Rayleigh-Ritz in the current subspace, stored transposed for the column-major ggev
+    Matrix<Real> Ak(nvec, nvec), Bk(nvec, nvec);
+    for (int i = 0; i < nvec; i++)
+      for (int j = 0; j < nvec; j++)
+      {
+        Ak(j, i) = BLAS::dot(N, V[i], AV[j]);
+        Bk(j, i) = BLAS::dot(N, V[i], BV[j]);
+      }
+
+    int Nl(nvec);
+    char jl('N');
+    char jr('V');
+    std::vector<Real> alphar(Nl), alphai(Nl), beta(Nl);
+    Matrix<Real> eigenT(Nl, Nl);
+    int info;
+    int lwork(-1);
+    std::vector<Real> work(1);
+    Real tt(0);
+    int t(1);
+    LAPACK::ggev(&jl, &jr, &Nl, Ak.data(), &Nl, Bk.data(), &Nl, &alphar[0], &alphai[0], &beta[0], &tt, &t,
+                 eigenT.data(), &Nl, &work[0], &lwork, &info);
+    lwork = int(work[0]);
+    work.resize(lwork);
+    LAPACK::ggev(&jl, &jr, &Nl, Ak.data(), &Nl, Bk.data(), &Nl, &alphar[0], &alphai[0], &beta[0], &tt, &t,
+                 eigenT.data(), &Nl, &work[0], &lwork, &info);
+    if (info != 0)
+    {
+      APP_ABORT("Invalid Matrix Diagonalization Function!");
+    }
+
+    // same selection as the dense one-shift solver: the eigenvalue closest to E0-2 in (E0-100, E0),
+    // the lowest one when the window is still empty in a small subspace
+    int selected(-1), lowest(-1);
+    for (int i = 0; i < Nl; i++)
+    {
+      if (beta[i] == 0)
+        continue;
+      const Real evi(alphar[i] / beta[i]);
+      if (std::abs(evi) >= 1e10)
+        continue;
+      if (lowest < 0 || evi < alphar[lowest] / beta[lowest])
+        lowest = i;
+      if ((evi < E0) && (evi > (E0 - 1e2)) &&
+          (selected < 0 || std::abs(evi - E0 + 2.0) < std::abs(alphar[selected] / beta[selected] - E0 + 2.0)))
+        selected = i;
+    }
+    if (selected < 0)
+      selected = lowest;
+    if (selected < 0)
+    {
+      APP_ABORT("No finite eigenvalue in the Davidson subspace!");
+    }
+    theta = alphar[selected] / beta[selected];
+
+    // Ritz vector and residual
+    std::fill(u.begin(), u.end(), 0.0);
+    std::fill(Au.begin(), Au.end(), 0.0);
+    std::fill(Bu.begin(), Bu.end(), 0.0);
+    for (int k = 0; k < nvec; k++)
+    {
+      BLAS::axpy(N, eigenT(selected, k), V[k], u.data());
+      BLAS::axpy(N, eigenT(selected, k), AV[k], Au.data());
+      BLAS::axpy(N, eigenT(selected, k), BV[k], Bu.data());
+    }
+    const Real unorm = std::sqrt(BLAS::dot(N, u.data(), u.data()));
+    for (int i = 0; i < N; i++)
+      r[i] = Au[i] - theta * Bu[i];
+    rnorm = std::sqrt(BLAS::dot(N, r.data(), r.data())) / unorm;
+    if (rnorm < tolerance)
+      break;
+
+    // restart from the Ritz vector when the subspace is full
+    if (nvec == max_subspace)
+    {
+      const Real scale = 1.0 / unorm;
+      for (int i = 0; i < N; i++)
+      {
+        V(0, i)  = u[i] * scale;
+        AV(0, i) = Au[i] * scale;
+        BV(0, i) = Bu[i] * scale;
+      }
+      nvec = 1;
+    }
+
+    // diagonally preconditioned correction, orthogonalized twice against the subspace
+    for (int i = 0; i < N; i++)
+    {
+      Real denom = diagA[i] - theta * diagB[i];
+      if (std::abs(denom) < 1e-8)
+        denom = denom < 0 ? -1e-8 : 1e-8;
+      x(0, i) = -r[i] / denom;
+    }
+    for (int pass = 0; pass < 2; pass++)
+      for (int k = 0; k < nvec; k++)
+        BLAS::axpy(N, -BLAS::dot(N, V[k], x[0]), V[k], x[0]);
+    const Real xnorm = std::sqrt(BLAS::dot(N, x[0], x[0]));
+    if (xnorm < 1e-12)
+      break;
+    BLAS::scal(N, 1.0 / xnorm, x[0]);
+
+    optTarget.applyOverlapHamiltonian(D_avg, x, hx, sx);
+    applyShifted(nvec++);
+  }
+
+  app_log() << "  Davidson solver: " << num_iterations << " iterations, eigenvalue " << theta << " residual " << rnorm
+            << std::endl;
+  if (!(rnorm < tolerance))
+    app_warning() << "  The Davidson solver did not converge, the residual " << rnorm << " is above the tolerance "
+                  << tolerance << ". Consider increasing davidson_max_its." << std::endl;
+
+  for (int i = 0; i < N; i++)
+    ev[i] = u[i] / u[0];
+  return theta;
+}
+
 
 } // namespace qmcplusplus
@@ -34,6 +34,8 @@ class LinearMethod
 
   // obtain the range of non-linear parameters
   void getNonLinearRange(int& first, int& last, const QMCCostFunctionBase& optTarget) const;
+  // rescale factor from the overlap norm of the non-linear part of the update
+  Real getNonLinearRescale(Real D) const;
 
 public:
   //asymmetric generalized EV
@@ -42,6 +44,29 @@ public:
   Real getLowestEigenvector(Matrix<Real>& A, std::vector<Real>& ev) const;
   // compute a rescale factor. Ye: Where is the method from?
   Real getNonLinearRescale(std::vector<Real>& dP, Matrix<Real>& S, const QMCCostFunctionBase& optTarget) const;
+  // same as above with the overlap applied by optTarget instead of a dense S, D_avg as in getLowestEigenvectorDavidson
+  Real getNonLinearRescale(std::vector<Real>& dP,
+                           const std::vector<Real>& D_avg,
+                           const QMCCostFunctionBase& optTarget) const;
+  /** lowest eigenvector of the shifted linear method problem by a Davidson iteration.
+   * Only products of the Hamiltonian and overlap matrices with vectors are requested from optTarget,
+   * the dense matrices are never formed. The shifts are applied as in the dense one-shift solver.
+   * A warning is printed if the residual is still above tolerance when the iteration stops.
+   * @param D_avg averages of the log derivatives from optTarget.computeDerivativeAverages
+   * @param shift_i identity shift
+   * @param shift_s overlap shift
+   * @param ev eigenvector normalized to ev[0] = 1, size getNumParams()+1
+   * @param max_iterations maximal number of matrix-vector products
+   * @param tolerance convergence threshold on the residual norm
+   * @return the eigenvalue
+   */
+  Real getLowestEigenvectorDavidson(const QMCCostFunctionBase& optTarget,
+                                    const std::vector<Real>& D_avg,
+                                    Real shift_i,
+                                    Real shift_s,
+                                    std::vector<Real>& ev,
+                                    int max_iterations,
+                                    Real tolerance) const;
 };
 } // namespace qmcplusplus
 #endif
@@ -131,6 +131,30 @@ QMCCostFunctionBase::Return_rt QMCCostFunctionBase::Cost(bool needGrad)
   return computedCost();
 }
 
+std::vector<QMCCostFunctionBase::Return_rt> QMCCostFunctionBase::Costs(
+    const std::vector<std::vector<Return_t>>& param_sets,
+    std::vector<bool>& valid)
+{
+  std::vector<Return_t> saved_params(OptVariables.size());
+  for (int i = 0; i < OptVariables.size(); i++)
+    saved_params[i] = OptVariables[i];
+
+  std::vector<Return_rt> costs(param_sets.size());
+  valid.resize(param_sets.size());
+  for (int k = 0; k < param_sets.size(); k++)
+  {
+    for (int i = 0; i < OptVariables.size(); i++)
+      OptVariables[i] = param_sets[k][i];
+    costs[k] = Cost(false);
+    valid[k] = IsValid;
+  }
+
+  for (int i = 0; i < OptVariables.size(); i++)
+    OptVariables[i] = saved_params[i];
+  resetPsi();
+  return costs;
+}
+
 void QMCCostFunctionBase::printEstimates()
 {
   app_log() << "      Current ene:     " << curAvg_w << std::endl;
@@ -312,6 +336,7 @@ bool QMCCostFunctionBase::put(xmlNodePtr q)
   std::string writeXmlPerStep("no");
   std::string computeNLPPderiv;
   astring variational_subset_str;
+  std::string deriv_records_precision("double");
   ParameterSet m_param;
   m_param.add(writeXmlPerStep, "dumpXML");
   m_param.add(MinNumWalkers, "minwalkers");
@@ -324,8 +349,16 @@ bool QMCCostFunctionBase::put(xmlNodePtr q)
   m_param.add(omega_shift, "omega");
   m_param.add(do_override_output, "output_vp_override", {true});
   m_param.add(variational_subset_str, "variational_subset");
+  m_param.add(deriv_records_precision, "deriv_records_precision", {"double", "single"});
+  m_param.add(deriv_records_options_.max_memory_mb, "deriv_records_max_memory");
+  m_param.add(deriv_records_options_.spill_dir, "deriv_records_spill_dir");
+  m_param.add(deriv_records_options_.block_size, "deriv_records_block_size");
   m_param.put(q);
 
+  deriv_records_options_.reduced_precision = (deriv_records_precision == "single");
+  if (deriv_records_options_.block_size < 1)
+    myComm->barrier_and_abort("deriv_records_block_size must be positive");
+
   if (!includeNonlocalH.empty())
     app_warning() << "'nonlocalpp' no more affects any part of the execution. Please remove it from your input file."
                   << std::endl;
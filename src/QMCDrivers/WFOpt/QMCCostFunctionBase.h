@@ -24,6 +24,7 @@
 #include "QMCHamiltonians/QMCHamiltonian.h"
 #include "QMCWaveFunctions/TrialWaveFunction.h"
 #include "Message/MPIObjectBase.h"
+#include "QMCDrivers/WFOpt/DerivRecordStore.h"
 
 #ifdef HAVE_LMY_ENGINE
 //#include "Eigen/Dense"
@@ -92,6 +93,14 @@ public:
   ///return the cost value for CGMinimization
   Return_rt Cost(bool needGrad = true) override;
 
+  /** return the cost values of several sets of the optimizable parameters on the same samples
+   * @param param_sets values of all the optimizable parameters, one vector per set
+   * @param valid set to whether the effective weight of each set is acceptable
+   *
+   * The current parameters are restored afterwards. The default evaluates the sets one after another.
+   */
+  virtual std::vector<Return_rt> Costs(const std::vector<std::vector<Return_t>>& param_sets, std::vector<bool>& valid);
+
   ///return the cost value for CGMinimization
   Return_rt computedCost();
   void printEstimates();
@@ -138,6 +147,41 @@ public:
 
   virtual Return_rt fillOverlapHamiltonianMatrices(Matrix<Return_rt>& Left, Matrix<Return_rt>& Right) = 0;
 
+  /** weighted average of the log derivatives over all the samples.
+   * It only changes with the samples and their weights, a solver computes it once and passes it to
+   * applyOverlapHamiltonian and getOverlapHamiltonianDiagonals.
+   */
+  virtual void computeDerivativeAverages(std::vector<Return_rt>& D_avg) const
+  {
+    APP_ABORT("computeDerivativeAverages is not implemented by this cost function");
+  }
+
+  /** apply the linear method Hamiltonian and overlap matrices to a block of vectors
+   * without forming them, as sample-space products over the derivative records.
+   * @param D_avg averages of the log derivatives from computeDerivativeAverages
+   * @param X input vectors, one per row, each of size getNumParams()+1
+   * @param HX Left*X in the same layout as X
+   * @param SX Right*X in the same layout as X
+   */
+  virtual void applyOverlapHamiltonian(const std::vector<Return_rt>& D_avg,
+                                       const Matrix<Return_rt>& X,
+                                       Matrix<Return_rt>& HX,
+                                       Matrix<Return_rt>& SX) const
+  {
+    APP_ABORT("applyOverlapHamiltonian is not implemented by this cost function");
+  }
+
+  /// diagonals of the Left and Right matrices of fillOverlapHamiltonianMatrices, D_avg as in applyOverlapHamiltonian
+  virtual void getOverlapHamiltonianDiagonals(const std::vector<Return_rt>& D_avg,
+                                              std::vector<Return_rt>& diagH,
+                                              std::vector<Return_rt>& diagS) const
+  {
+    APP_ABORT("getOverlapHamiltonianDiagonals is not implemented by this cost function");
+  }
+
+  /// release the per-sample derivative records at the end of an optimization step
+  virtual void releaseDerivRecords() {}
+
 #ifdef HAVE_LMY_ENGINE
   Return_rt LMYEngineCost(const bool needDeriv, cqmc::engine::LMYEngine<Return_t>* EngineObj);
 #endif
@@ -230,6 +274,8 @@ protected:
   bool targetExcited;
   ///the shift to use when targeting an excited state
   double omega_shift;
+  ///storage options of the derivative records, used by the batched cost function
+  DerivRecordStore::Options deriv_records_options_;
 
   ///list of optimizables
   opt_variables_type OptVariables;
@@ -41,7 +41,9 @@ QMCCostFunctionBatched::QMCCostFunctionBatched(ParticleSet& w,
       corr_sampling_timer_(
           *timer_manager.createTimer("QMCCostFunctionBatched::correlatedSampling", timer_level_medium)),
       fill_timer_(
-          *timer_manager.createTimer("QMCCostFunctionBatched::fillOverlapHamiltonianMatrices", timer_level_medium))
+          *timer_manager.createTimer("QMCCostFunctionBatched::fillOverlapHamiltonianMatrices", timer_level_medium)),
+      apply_timer_(
+          *timer_manager.createTimer("QMCCostFunctionBatched::applyOverlapHamiltonian", timer_level_medium))
 
 {
   app_log() << " Using QMCCostFunctionBatched::QMCCostFunctionBatched" << std::endl;
@@ -87,14 +89,18 @@ void QMCCostFunctionBatched::GradCost(std::vector<Return_rt>& PGradient,
     std::vector<Return_rt> HD_avg(NumOptimizables, 0.0);
     Return_rt wgtinv   = 1.0 / SumValue[SUM_WGT];
     Return_rt delE_bar = 0;
+    Matrix<Return_rt> Dblock, HDblock;
+    for (int ib = 0; ib < deriv_records_.numBlocks(); ib++)
     {
-      for (int iw = 0; iw < rank_local_num_samples_; iw++)
+      deriv_records_.loadBlock(ib, Dblock, HDblock);
+      const int first = deriv_records_.blockFirst(ib);
+      for (int iw = first; iw < deriv_records_.blockLast(ib); iw++)
       {
         const Return_rt* restrict saved = RecordsOnNode_[iw];
         Return_rt weight                = saved[REWEIGHT] * wgtinv;
         Return_rt eloc_new              = saved[ENERGY_NEW];
         delE_bar += weight * std::pow(std::abs(eloc_new - EtargetEff), PowerE);
-        const Return_rt* HDsaved = HDerivRecords_[iw];
+        const Return_rt* HDsaved = HDblock[iw - first];
         for (int pm = 0; pm < NumOptimizables; pm++)
           HD_avg[pm] += HDsaved[pm];
       }
@@ -103,8 +109,11 @@ void QMCCostFunctionBatched::GradCost(std::vector<Return_rt>& PGradient,
     myComm->allreduce(delE_bar);
     for (int pm = 0; pm < NumOptimizables; pm++)
       HD_avg[pm] *= 1.0 / static_cast<Return_rt>(NumSamples);
+    for (int ib = 0; ib < deriv_records_.numBlocks(); ib++)
     {
-      for (int iw = 0; iw < rank_local_num_samples_; iw++)
+      deriv_records_.loadBlock(ib, Dblock, HDblock);
+      const int first = deriv_records_.blockFirst(ib);
+      for (int iw = first; iw < deriv_records_.blockLast(ib); iw++)
       {
         const Return_rt* restrict saved = RecordsOnNode_[iw];
         Return_rt weight                = saved[REWEIGHT] * wgtinv;
@@ -115,8 +124,8 @@ void QMCCostFunctionBatched::GradCost(std::vector<Return_rt>& PGradient,
           ltz = false;
         Return_rt delE           = std::pow(std::abs(eloc_new - EtargetEff), PowerE);
         Return_rt ddelE          = PowerE * std::pow(std::abs(eloc_new - EtargetEff), PowerE - 1);
-        const Return_rt* Dsaved  = DerivRecords_[iw];
-        const Return_rt* HDsaved = HDerivRecords_[iw];
+        const Return_rt* Dsaved  = Dblock[iw - first];
+        const Return_rt* HDsaved = HDblock[iw - first];
         for (int pm = 0; pm < NumOptimizables; pm++)
         {
           EDtotals_w[pm] += weight * (HDsaved[pm] + 2.0 * Dsaved[pm] * delta_l);
@@ -132,16 +141,19 @@ void QMCCostFunctionBatched::GradCost(std::vector<Return_rt>& PGradient,
     myComm->allreduce(EDtotals_w);
     myComm->allreduce(URV);
     Return_rt smpinv = 1.0 / static_cast<Return_rt>(NumSamples);
+    for (int ib = 0; ib < deriv_records_.numBlocks(); ib++)
     {
-      for (int iw = 0; iw < rank_local_num_samples_; iw++)
+      deriv_records_.loadBlock(ib, Dblock, HDblock);
+      const int first = deriv_records_.blockFirst(ib);
+      for (int iw = first; iw < deriv_records_.blockLast(ib); iw++)
       {
         const Return_rt* restrict saved = RecordsOnNode_[iw];
         Return_rt weight                = saved[REWEIGHT] * wgtinv;
         Return_rt eloc_new              = saved[ENERGY_NEW];
         Return_rt delta_l               = (eloc_new - curAvg_w);
         Return_rt sigma_l               = delta_l * delta_l;
-        const Return_rt* Dsaved         = DerivRecords_[iw];
-        const Return_rt* HDsaved        = HDerivRecords_[iw];
+        const Return_rt* Dsaved         = Dblock[iw - first];
+        const Return_rt* HDsaved        = HDblock[iw - first];
         for (int pm = 0; pm < NumOptimizables; pm++)
         {
           E2Dtotals_w[pm] +=
@@ -221,23 +233,20 @@ void QMCCostFunctionBatched::checkConfigurations(EngineHandle& handle)
   // Ensure number of samples did not change after getConfigurations
   assert(rank_local_num_samples_ == samples_.getNumSamples());
 
-  if (RecordsOnNode_.size1() == 0)
-  {
+  if (RecordsOnNode_.size1() != rank_local_num_samples_)
     RecordsOnNode_.resize(rank_local_num_samples_, SUM_INDEX_SIZE);
-    if (needGrads)
-    {
-      DerivRecords_.resize(rank_local_num_samples_, NumOptimizables);
-      HDerivRecords_.resize(rank_local_num_samples_, NumOptimizables);
-    }
-  }
-  else if (RecordsOnNode_.size1() != rank_local_num_samples_)
+  if (needGrads &&
+      (deriv_records_.numSamples() != rank_local_num_samples_ || deriv_records_.numParams() != NumOptimizables))
   {
-    RecordsOnNode_.resize(rank_local_num_samples_, SUM_INDEX_SIZE);
-    if (needGrads)
-    {
-      DerivRecords_.resize(rank_local_num_samples_, NumOptimizables);
-      HDerivRecords_.resize(rank_local_num_samples_, NumOptimizables);
-    }
+    // the spill directory may be shared by the ranks of all the groups and by other runs
+    const std::string project_name = RootName.substr(RootName.find_last_of('/') + 1);
+    deriv_records_.setup(deriv_records_options_,
+                         project_name + ".p" + std::to_string(OHMMS::Controller->rank()) + ".deriv_records.bin");
+    deriv_records_.resize(rank_local_num_samples_, NumOptimizables);
+    if (deriv_records_.numResidentBlocks() < deriv_records_.numBlocks())
+      app_log() << "  Derivative records: " << deriv_records_.numResidentBlocks() << " of "
+                << deriv_records_.numBlocks() << " blocks in memory, the rest in "
+                << deriv_records_options_.spill_dir << std::endl;
   }
   //    synchronize the random number generator with the node
   (*MoverRng[0]) = (*RngSaved[0]);
@@ -265,8 +274,8 @@ void QMCCostFunctionBatched::checkConfigurations(EngineHandle& handle)
   auto evalOptConfig = [](int crowd_id, UPtrVector<CostFunctionCrowdData>& opt_crowds,
                           const std::vector<int>& samples_per_crowd_offsets, const std::vector<int>& walkers_per_crowd,
                           std::vector<ParticleGradient*>& gradPsi, std::vector<ParticleLaplacian*>& lapPsi,
-                          Matrix<Return_rt>& RecordsOnNode, Matrix<Return_rt>& DerivRecords,
-                          Matrix<Return_rt>& HDerivRecords, const SampleStack& samples, opt_variables_type& optVars,
+                          Matrix<Return_rt>& RecordsOnNode, DerivRecordStore& deriv_records,
+                          const SampleStack& samples, opt_variables_type& optVars,
                           bool needGrads, EngineHandle& handle) {
     CostFunctionCrowdData& opt_data = *opt_crowds[crowd_id];
 
@@ -299,10 +308,9 @@ void QMCCostFunctionBatched::checkConfigurations(EngineHandle& handle)
       auto ref_d2LogPsi = convertPtrToRefVectorSubset(lapPsi, base_sample_index, current_batch_size);
 
       // Load samples into the crowd data
+      samples.loadSamples(p_list, base_sample_index);
       for (int ib = 0; ib < current_batch_size; ib++)
       {
-        samples.loadSample(p_list[ib], base_sample_index + ib);
-
         // Set the RNG used in QMCHamiltonian.  This is used to offset the grid
         // during spherical integration in the non-local pseudopotential.
         // The RNG state gets reset to the same starting point in correlatedSampling
@@ -339,14 +347,16 @@ void QMCCostFunctionBatched::checkConfigurations(EngineHandle& handle)
 
         handle.takeSample(energy_list, dlogpsi_array, dhpsioverpsi_array, base_sample_index);
 
+        std::vector<Return_rt> dlogpsi(nparams), dhpsioverpsi(nparams);
         for (int ib = 0; ib < current_batch_size; ib++)
         {
           const int is = base_sample_index + ib;
           for (int j = 0; j < nparams; j++)
           {
-            DerivRecords[is][j]  = std::real(dlogpsi_array[ib][j]);
-            HDerivRecords[is][j] = std::real(dhpsioverpsi_array[ib][j]);
+            dlogpsi[j]      = std::real(dlogpsi_array[ib][j]);
+            dhpsioverpsi[j] = std::real(dhpsioverpsi_array[ib][j]);
           }
+          deriv_records.writeRow(is, dlogpsi.data(), dhpsioverpsi.data());
           RecordsOnNode[is][LOGPSI_FIXED] = opt_data.get_log_psi_fixed()[ib];
           RecordsOnNode[is][LOGPSI_FREE]  = opt_data.get_log_psi_opt()[ib];
         }
@@ -376,7 +386,7 @@ void QMCCostFunctionBatched::checkConfigurations(EngineHandle& handle)
 
   ParallelExecutor<> crowd_tasks;
   crowd_tasks(opt_num_crowds, evalOptConfig, opt_eval_, samples_per_crowd_offsets, walkers_per_crowd_, dLogPsi,
-              d2LogPsi, RecordsOnNode_, DerivRecords_, HDerivRecords_, samples_, OptVariablesForPsi, needGrads, handle);
+              d2LogPsi, RecordsOnNode_, deriv_records_, samples_, OptVariablesForPsi, needGrads, handle);
   // Sum energy values over crowds
   for (int i = 0; i < opt_eval_.size(); i++)
   {
@@ -426,7 +436,7 @@ void QMCCostFunctionBatched::engine_checkConfigurations(cqmc::engine::LMYEngine<
 #endif
 
 
-void QMCCostFunctionBatched::resetPsi(bool final_reset)
+void QMCCostFunctionBatched::mapOptVariablesForPsi()
 {
   if (OptVariables.size() < OptVariablesForPsi.size())
     for (int i = 0; i < equalVarMap.size(); ++i)
@@ -434,6 +444,11 @@ void QMCCostFunctionBatched::resetPsi(bool final_reset)
   else
     for (int i = 0; i < OptVariables.size(); ++i)
       OptVariablesForPsi[i] = OptVariables[i];
+}
+
+void QMCCostFunctionBatched::resetPsi(bool final_reset)
+{
+  mapOptVariablesForPsi();
 
   //cout << "######### QMCCostFunctionBatched::resetPsi " << std::endl;
   //OptVariablesForPsi.print(std::cout);
@@ -461,8 +476,6 @@ QMCCostFunctionBatched::EffectiveWeight QMCCostFunctionBatched::correlatedSampli
   // Ensure number of samples did not change after getConfiguration
   assert(rank_local_num_samples_ == samples_.getNumSamples());
 
-  Return_rt inv_n_samples = 1.0 / samples_.getGlobalNumSamples();
-
   const size_t opt_num_crowds = walkers_per_crowd_.size();
   // Divide samples among crowds
   std::vector<int> samples_per_crowd_offsets(opt_num_crowds + 1);
@@ -472,8 +485,8 @@ QMCCostFunctionBatched::EffectiveWeight QMCCostFunctionBatched::correlatedSampli
   auto evalOptCorrelated =
       [](int crowd_id, UPtrVector<CostFunctionCrowdData>& opt_crowds, const std::vector<int>& samples_per_crowd_offsets,
          const std::vector<int>& walkers_per_crowd, std::vector<ParticleGradient*>& gradPsi,
-         std::vector<ParticleLaplacian*>& lapPsi, Matrix<Return_rt>& RecordsOnNode, Matrix<Return_rt>& DerivRecords,
-         Matrix<Return_rt>& HDerivRecords, const SampleStack& samples, const opt_variables_type& optVars,
+         std::vector<ParticleLaplacian*>& lapPsi, Matrix<Return_rt>& RecordsOnNode, DerivRecordStore& deriv_records,
+         const SampleStack& samples, const opt_variables_type& optVars,
          bool compute_all_from_scratch, Return_rt vmc_or_dmc, bool needGrad) {
         CostFunctionCrowdData& opt_data = *opt_crowds[crowd_id];
 
@@ -505,9 +518,9 @@ QMCCostFunctionBatched::EffectiveWeight QMCCostFunctionBatched::correlatedSampli
           ResourceCollectionTeamLock<QMCHamiltonian> hams_res_lock(opt_data.get_h0_res(), h0_list);
 
           // Load this batch of samples into the crowd data
+          samples.loadSamples(p_list, base_sample_index);
           for (int ib = 0; ib < current_batch_size; ib++)
           {
-            samples.loadSample(p_list[ib], base_sample_index + ib);
             // Copy the saved RNG state
             *opt_data.get_rng_ptr_list()[ib] = opt_data.get_rng_save();
             h0_list[ib].setRandomGenerator(opt_data.get_rng_ptr_list()[ib].get());
@@ -568,19 +581,22 @@ QMCCostFunctionBatched::EffectiveWeight QMCCostFunctionBatched::correlatedSampli
             auto energy_list = QMCHamiltonian::mw_evaluateValueAndDerivatives(h0_list, wf_list, p_list, optVars,
                                                                               dlogpsi_array, dhpsioverpsi_array);
 
+            std::vector<Return_rt> dlogpsi(nparams), dhpsioverpsi(nparams);
             for (int ib = 0; ib < current_batch_size; ib++)
             {
               const int is                  = base_sample_index + ib;
               auto etmp                     = energy_list[ib];
               RecordsOnNode[is][ENERGY_NEW] = etmp + RecordsOnNode[is][ENERGY_FIXED];
+              deriv_records.readRow(is, dlogpsi.data(), dhpsioverpsi.data());
               for (int j = 0; j < nparams; j++)
               {
                 if (optVars.recompute(j))
                 {
-                  DerivRecords[is][j]  = std::real(dlogpsi_array[ib][j]);
-                  HDerivRecords[is][j] = std::real(dhpsioverpsi_array[ib][j]);
+                  dlogpsi[j]      = std::real(dlogpsi_array[ib][j]);
+                  dhpsioverpsi[j] = std::real(dhpsioverpsi_array[ib][j]);
                 }
               }
+              deriv_records.writeRow(is, dlogpsi.data(), dhpsioverpsi.data());
             }
           }
           else
@@ -601,7 +617,7 @@ QMCCostFunctionBatched::EffectiveWeight QMCCostFunctionBatched::correlatedSampli
   const bool compute_all_from_scratch = H.getTWFDependentComponents().size() > 1;
   ParallelExecutor<> crowd_tasks;
   crowd_tasks(opt_num_crowds, evalOptCorrelated, opt_eval_, samples_per_crowd_offsets, walkers_per_crowd_, dLogPsi,
-              d2LogPsi, RecordsOnNode_, DerivRecords_, HDerivRecords_, samples_, OptVariablesForPsi,
+              d2LogPsi, RecordsOnNode_, deriv_records_, samples_, OptVariablesForPsi,
               compute_all_from_scratch, vmc_or_dmc, needGrad);
   // Sum weights over crowds
   for (int i = 0; i < opt_eval_.size(); i++)
@@ -612,6 +628,13 @@ QMCCostFunctionBatched::EffectiveWeight QMCCostFunctionBatched::correlatedSampli
 
   //this is MPI barrier
   OHMMS::Controller->barrier();
+  return reduceCorrelatedSums(wgt_tot, wgt_tot2);
+}
+
+QMCCostFunctionBatched::EffectiveWeight QMCCostFunctionBatched::reduceCorrelatedSums(Return_rt wgt_tot,
+                                                                                    Return_rt wgt_tot2)
+{
+  const Return_rt inv_n_samples = 1.0 / samples_.getGlobalNumSamples();
   //collect the total weight for normalization and apply maximum weight
   myComm->allreduce(wgt_tot);
   myComm->allreduce(wgt_tot2);
@@ -665,6 +688,190 @@ QMCCostFunctionBatched::EffectiveWeight QMCCostFunctionBatched::correlatedSampli
   return SumValue[SUM_WGT] * SumValue[SUM_WGT] / (SumValue[SUM_WGTSQ] * samples_.getGlobalNumSamples());
 }
 
+std::vector<QMCCostFunctionBatched::Return_rt> QMCCostFunctionBatched::Costs(
+    const std::vector<std::vector<Return_t>>& param_sets,
+    std::vector<bool>& valid)
+{
+  const size_t num_sets = param_sets.size();
+  std::vector<Return_rt> costs(num_sets);
+  valid.resize(num_sets);
+  if (num_sets == 0)
+    return costs;
+
+  std::vector<Return_t> saved_params(OptVariables.size());
+  for (int i = 0; i < OptVariables.size(); i++)
+    saved_params[i] = OptVariables[i];
+
+  std::vector<opt_variables_type> psi_sets;
+  psi_sets.reserve(num_sets);
+  for (int k = 0; k < num_sets; k++)
+  {
+    for (int i = 0; i < OptVariables.size(); i++)
+      OptVariables[i] = param_sets[k][i];
+    mapOptVariablesForPsi();
+    psi_sets.push_back(OptVariablesForPsi);
+  }
+
+  Matrix<Return_rt> log_weights(num_sets, rank_local_num_samples_);
+  Matrix<Return_rt> energies(num_sets, rank_local_num_samples_);
+  correlatedSamplingSets(psi_sets, log_weights, energies);
+
+  const Return_rt inv_n_samples = 1.0 / samples_.getGlobalNumSamples();
+  for (int k = 0; k < num_sets; k++)
+  {
+    NumCostCalls++;
+    Return_rt wgt_tot  = 0.0;
+    Return_rt wgt_tot2 = 0.0;
+    for (int is = 0; is < rank_local_num_samples_; is++)
+    {
+      const Return_rt weight         = log_weights(k, is);
+      RecordsOnNode_[is][REWEIGHT]   = weight;
+      RecordsOnNode_[is][ENERGY_NEW] = energies(k, is);
+      wgt_tot += inv_n_samples * weight;
+      wgt_tot2 += inv_n_samples * weight * weight;
+    }
+    valid[k] = isEffectiveWeightValid(reduceCorrelatedSums(wgt_tot, wgt_tot2));
+    costs[k] = computedCost();
+  }
+  IsValid = valid.back();
+
+  for (int i = 0; i < OptVariables.size(); i++)
+    OptVariables[i] = saved_params[i];
+  resetPsi();
+  return costs;
+}
+
+void QMCCostFunctionBatched::correlatedSamplingSets(const std::vector<opt_variables_type>& psi_sets,
+                                                    Matrix<Return_rt>& log_weights,
+                                                    Matrix<Return_rt>& energies)
+{
+  ScopedTimer tmp_timer(corr_sampling_timer_);
+
+  {
+    //    synchronize the random number generator with the node
+    (*MoverRng[0]) = (*RngSaved[0]);
+    H.setRandomGenerator(MoverRng[0]);
+  }
+
+  assert(rank_local_num_samples_ == samples_.getNumSamples());
+
+  const size_t opt_num_crowds = walkers_per_crowd_.size();
+  std::vector<int> samples_per_crowd_offsets(opt_num_crowds + 1);
+  FairDivide(rank_local_num_samples_, opt_num_crowds, samples_per_crowd_offsets);
+
+  // evaluate one batch of samples of a crowd for one parameter set.
+  // The samples are loaded and the parameter independent parts computed with the first set only.
+  auto evalOptCorrelatedSet =
+      [](int crowd_id, UPtrVector<CostFunctionCrowdData>& opt_crowds, const std::vector<int>& samples_per_crowd_offsets,
+         const std::vector<int>& walkers_per_crowd, std::vector<ParticleGradient*>& gradPsi,
+         std::vector<ParticleLaplacian*>& lapPsi, const Matrix<Return_rt>& RecordsOnNode, const SampleStack& samples,
+         int inb, bool first_set, bool compute_all_from_scratch, Return_rt vmc_or_dmc, Return_rt* log_weights,
+         Return_rt* energies) {
+        CostFunctionCrowdData& opt_data = *opt_crowds[crowd_id];
+
+        const int local_samples = samples_per_crowd_offsets[crowd_id + 1] - samples_per_crowd_offsets[crowd_id];
+
+        int num_batches;
+        int final_batch_size;
+        compute_batch_parameters(local_samples, walkers_per_crowd[crowd_id], num_batches, final_batch_size);
+        if (inb >= num_batches)
+          return;
+
+        const int current_batch_size = (inb == num_batches - 1) ? final_batch_size : walkers_per_crowd[crowd_id];
+        const int base_sample_index  = inb * walkers_per_crowd[crowd_id] + samples_per_crowd_offsets[crowd_id];
+
+        auto p_list_no_leader  = opt_data.get_p_list(current_batch_size);
+        auto wf_list_no_leader = opt_data.get_wf_list(current_batch_size);
+        auto h0_list_no_leader = opt_data.get_h0_list(current_batch_size);
+        const RefVectorWithLeader<ParticleSet> p_list(p_list_no_leader[0], p_list_no_leader);
+        const RefVectorWithLeader<TrialWaveFunction> wf_list(wf_list_no_leader[0], wf_list_no_leader);
+        const RefVectorWithLeader<QMCHamiltonian> h0_list(h0_list_no_leader[0], h0_list_no_leader);
+
+        ResourceCollectionTeamLock<ParticleSet> mw_pset_lock(opt_data.getSharedResource().pset_res, p_list);
+        ResourceCollectionTeamLock<TrialWaveFunction> twfs_res_lock(opt_data.getSharedResource().twf_res, wf_list);
+        ResourceCollectionTeamLock<QMCHamiltonian> hams_res_lock(opt_data.get_h0_res(), h0_list);
+
+        if (first_set)
+        {
+          samples.loadSamples(p_list, base_sample_index);
+          ParticleSet::mw_update(p_list, true);
+        }
+        // every set uses the same quadrature grids
+        for (int ib = 0; ib < current_batch_size; ib++)
+        {
+          *opt_data.get_rng_ptr_list()[ib] = opt_data.get_rng_save();
+          h0_list[ib].setRandomGenerator(opt_data.get_rng_ptr_list()[ib].get());
+        }
+
+        // the parameter independent components only need to be recomputed once per batch
+        const bool recompute = first_set && compute_all_from_scratch;
+        std::vector<std::unique_ptr<ParticleSet::ParticleGradient>> dummyG_ptr_list;
+        std::vector<std::unique_ptr<ParticleSet::ParticleLaplacian>> dummyL_ptr_list;
+        RefVector<ParticleSet::ParticleGradient> dummyG_list;
+        RefVector<ParticleSet::ParticleLaplacian> dummyL_list;
+        if (recompute)
+        {
+          int nptcl = gradPsi[0]->size();
+          dummyG_ptr_list.reserve(current_batch_size);
+          dummyL_ptr_list.reserve(current_batch_size);
+          for (int i = 0; i < current_batch_size; i++)
+          {
+            dummyG_ptr_list.emplace_back(std::make_unique<ParticleGradient>(nptcl));
+            dummyL_ptr_list.emplace_back(std::make_unique<ParticleLaplacian>(nptcl));
+          }
+          dummyG_list = convertUPtrToRefVector(dummyG_ptr_list);
+          dummyL_list = convertUPtrToRefVector(dummyL_ptr_list);
+        }
+        opt_data.zero_log_psi();
+
+        TrialWaveFunction::mw_evaluateDeltaLog(wf_list, p_list, opt_data.get_log_psi_opt(), dummyG_list, dummyL_list,
+                                               recompute);
+
+        for (int ib = 0; ib < current_batch_size; ib++)
+        {
+          const int is = base_sample_index + ib;
+          wf_list[ib].G += *gradPsi[is];
+          wf_list[ib].L += *lapPsi[is];
+          // This is needed to get the KE correct in QMCHamiltonian::mw_evaluate below
+          p_list[ib].G += *gradPsi[is];
+          p_list[ib].L += *lapPsi[is];
+          log_weights[is] = vmc_or_dmc * (opt_data.get_log_psi_opt()[ib] - RecordsOnNode[is][LOGPSI_FREE]);
+        }
+
+        auto energy_list = QMCHamiltonian::mw_evaluate(h0_list, wf_list, p_list);
+        for (int ib = 0; ib < current_batch_size; ib++)
+        {
+          const int is = base_sample_index + ib;
+          energies[is] = energy_list[ib] + RecordsOnNode[is][ENERGY_FIXED];
+        }
+      };
+
+  int max_num_batches = 0;
+  for (int crowd_id = 0; crowd_id < opt_num_crowds; crowd_id++)
+  {
+    int num_batches;
+    int final_batch_size;
+    compute_batch_parameters(samples_per_crowd_offsets[crowd_id + 1] - samples_per_crowd_offsets[crowd_id],
+                             walkers_per_crowd_[crowd_id], num_batches, final_batch_size);
+    max_num_batches = std::max(max_num_batches, num_batches);
+  }
+
+  //if we have more than KE depending on TWF, TWF must be fully recomputed.
+  const bool compute_all_from_scratch = H.getTWFDependentComponents().size() > 1;
+  ParallelExecutor<> crowd_tasks;
+  // The clones of a wavefunction may share parameters, e.g. CI coefficients, so all the crowds
+  // work on the same set at a time while the loaded samples stay in the crowds between sets.
+  for (int inb = 0; inb < max_num_batches; inb++)
+    for (int k = 0; k < psi_sets.size(); k++)
+    {
+      for (auto& opt_data : opt_eval_)
+        for (auto& wf : opt_data->get_wf_ptr_list())
+          resetOptimizableObjects(*wf, psi_sets[k]);
+      crowd_tasks(opt_num_crowds, evalOptCorrelatedSet, opt_eval_, samples_per_crowd_offsets, walkers_per_crowd_,
+                  dLogPsi, d2LogPsi, RecordsOnNode_, samples_, inb, k == 0, compute_all_from_scratch, vmc_or_dmc,
+                  log_weights[k], energies[k]);
+    }
+}
 
 // Construct the overlap and Hamiltonian matrices for the linear method
 // A sum over samples.  Inputs are
@@ -704,85 +911,285 @@ QMCCostFunctionBatched::Return_rt QMCCostFunctionBatched::fillOverlapHamiltonian
   RealType H2_avg = 1.0 / (curAvg_w * curAvg_w);
   //    RealType H2_avg = 1.0/std::sqrt(curAvg_w*curAvg_w*curAvg2_w);
   RealType V_avg = curAvg2_w - curAvg_w * curAvg_w;
-  std::vector<Return_rt> D_avg(getNumParams(), 0.0);
+  std::vector<Return_rt> D_avg;
+  computeDerivativeAverages(D_avg);
   Return_rt wgtinv = 1.0 / SumValue[SUM_WGT];
 
-  for (int iw = 0; iw < rank_local_num_samples_; iw++)
+  Matrix<Return_rt> Dblock, HDblock;
+  for (int ib = 0; ib < deriv_records_.numBlocks(); ib++)
   {
-    const Return_rt* restrict saved = RecordsOnNode_[iw];
-    Return_rt weight                = saved[REWEIGHT] * wgtinv;
-    const Return_rt* Dsaved         = DerivRecords_[iw];
-    for (int pm = 0; pm < getNumParams(); pm++)
+    deriv_records_.loadBlock(ib, Dblock, HDblock);
+    const int first = deriv_records_.blockFirst(ib);
+    for (int iw = first; iw < deriv_records_.blockLast(ib); iw++)
     {
-      D_avg[pm] += Dsaved[pm] * weight;
+      const Return_rt* restrict saved = RecordsOnNode_[iw];
+      Return_rt weight                = saved[REWEIGHT] * wgtinv;
+      Return_rt eloc_new              = saved[ENERGY_NEW];
+      const Return_rt* Dsaved         = Dblock[iw - first];
+      const Return_rt* HDsaved        = HDblock[iw - first];
+
+      size_t opt_num_crowds = walkers_per_crowd_.size();
+      std::vector<int> params_per_crowd(opt_num_crowds + 1);
+      FairDivide(getNumParams(), opt_num_crowds, params_per_crowd);
+
+
+      auto constructMatrices = [](int crowd_id, std::vector<int>& crowd_ranges, int numParams, const Return_rt* Dsaved,
+                                  const Return_rt* HDsaved, Return_rt weight, Return_rt eloc_new, RealType H2_avg,
+                                  RealType V_avg, std::vector<Return_rt>& D_avg, RealType b1, RealType b2,
+                                  RealType curAvg_w, Matrix<Return_rt>& Left, Matrix<Return_rt>& Right) {
+        int local_pm_start = crowd_ranges[crowd_id];
+        int local_pm_end   = crowd_ranges[crowd_id + 1];
+
+        for (int pm = local_pm_start; pm < local_pm_end; pm++)
+        {
+          Return_rt wfe = (HDsaved[pm] + (Dsaved[pm] - D_avg[pm]) * eloc_new) * weight;
+          Return_rt wfd = (Dsaved[pm] - D_avg[pm]) * weight;
+          Return_rt vterm =
+              HDsaved[pm] * (eloc_new - curAvg_w) + (Dsaved[pm] - D_avg[pm]) * eloc_new * (eloc_new - 2.0 * curAvg_w);
+          //                 H2
+          Right(0, pm + 1) += b1 * H2_avg * vterm * weight;
+          Right(pm + 1, 0) += b1 * H2_avg * vterm * weight;
+          //                 Variance
+          Left(0, pm + 1) += b2 * vterm * weight;
+          Left(pm + 1, 0) += b2 * vterm * weight;
+          //                 Hamiltonian
+          Left(0, pm + 1) += (1 - b2) * wfe;
+          Left(pm + 1, 0) += (1 - b2) * wfd * eloc_new;
+          for (int pm2 = 0; pm2 < numParams; pm2++)
+          {
+            //                Hamiltonian
+            Left(pm + 1, pm2 + 1) += (1 - b2) * wfd * (HDsaved[pm2] + (Dsaved[pm2] - D_avg[pm2]) * eloc_new);
+            //                Overlap
+            RealType ovlij = wfd * (Dsaved[pm2] - D_avg[pm2]);
+            Right(pm + 1, pm2 + 1) += ovlij;
+            //                Variance
+            RealType varij = weight * (HDsaved[pm] - 2.0 * (Dsaved[pm] - D_avg[pm]) * eloc_new) *
+                (HDsaved[pm2] - 2.0 * (Dsaved[pm2] - D_avg[pm2]) * eloc_new);
+            Left(pm + 1, pm2 + 1) += b2 * (varij + V_avg * ovlij);
+            //                H2
+            Right(pm + 1, pm2 + 1) += b1 * H2_avg * varij;
+          }
+        }
+      };
+
+      ParallelExecutor<> crowd_tasks;
+      crowd_tasks(opt_num_crowds, constructMatrices, params_per_crowd, getNumParams(), Dsaved, HDsaved, weight,
+                  eloc_new, H2_avg, V_avg, D_avg, b1, b2, curAvg_w, Left, Right);
     }
   }
+  myComm->allreduce(Right);
+  myComm->allreduce(Left);
+  Left(0, 0)  = (1 - b2) * curAvg_w + b2 * V_avg;
+  Right(0, 0) = 1.0 + b1 * H2_avg * V_avg;
+  if (GEVType == "H2")
+    return H2_avg;
 
-  myComm->allreduce(D_avg);
+  return 1.0;
+}
+
+void QMCCostFunctionBatched::computeDerivativeAverages(std::vector<Return_rt>& D_avg) const
+{
+  D_avg.assign(getNumParams(), 0.0);
+  Return_rt wgtinv = 1.0 / SumValue[SUM_WGT];
 
-  for (int iw = 0; iw < rank_local_num_samples_; iw++)
+  Matrix<Return_rt> Dblock, HDblock;
+  for (int ib = 0; ib < deriv_records_.numBlocks(); ib++)
   {
-    const Return_rt* restrict saved = RecordsOnNode_[iw];
-    Return_rt weight                = saved[REWEIGHT] * wgtinv;
-    Return_rt eloc_new              = saved[ENERGY_NEW];
-    const Return_rt* Dsaved         = DerivRecords_[iw];
-    const Return_rt* HDsaved        = HDerivRecords_[iw];
+    deriv_records_.loadBlock(ib, Dblock, HDblock);
+    const int first = deriv_records_.blockFirst(ib);
+    for (int iw = first; iw < deriv_records_.blockLast(ib); iw++)
+    {
+      const Return_rt* restrict saved = RecordsOnNode_[iw];
+      Return_rt weight                = saved[REWEIGHT] * wgtinv;
+      const Return_rt* Dsaved         = Dblock[iw - first];
+      for (int pm = 0; pm < getNumParams(); pm++)
+      {
+        D_avg[pm] += Dsaved[pm] * weight;
+      }
+    }
+  }
 
-    size_t opt_num_crowds = walkers_per_crowd_.size();
-    std::vector<int> params_per_crowd(opt_num_crowds + 1);
-    FairDivide(getNumParams(), opt_num_crowds, params_per_crowd);
+  myComm->allreduce(D_avg);
+}
 
+// Matrix-free counterpart of fillOverlapHamiltonianMatrices.
+// Every element of Left and Right in the parameter block is a sample sum of products of
+//   d_pm  = DerivRecords - D_avg
+//   hd_pm = HDerivRecords
+// so for each sample only the two projections  a = sum_pm d_pm x_pm  and  h = sum_pm hd_pm x_pm
+// are needed and the products come out as  sum_samples (alpha d + beta hd).
+// The cost is O(samples * params) per vector and the only communication is one allreduce
+// of the output block.
+void QMCCostFunctionBatched::applyOverlapHamiltonian(const std::vector<Return_rt>& D_avg,
+                                                     const Matrix<Return_rt>& X,
+                                                     Matrix<Return_rt>& HX,
+                                                     Matrix<Return_rt>& SX) const
+{
+  ScopedTimer tmp_timer(apply_timer_);
 
-    auto constructMatrices = [](int crowd_id, std::vector<int>& crowd_ranges, int numParams, const Return_rt* Dsaved,
-                                const Return_rt* HDsaved, Return_rt weight, Return_rt eloc_new, RealType H2_avg,
-                                RealType V_avg, std::vector<Return_rt>& D_avg, RealType b1, RealType b2,
-                                RealType curAvg_w, Matrix<Return_rt>& Left, Matrix<Return_rt>& Right) {
-      int local_pm_start = crowd_ranges[crowd_id];
-      int local_pm_end   = crowd_ranges[crowd_id + 1];
+  const int num_params = getNumParams();
+  const int num_vecs   = X.rows();
+  assert(X.cols() == num_params + 1);
+  assert(D_avg.size() == num_params);
 
-      for (int pm = local_pm_start; pm < local_pm_end; pm++)
+  RealType b1, b2;
+  if (GEVType == "H2")
+  {
+    b1 = w_beta;
+    b2 = 0;
+  }
+  else
+  {
+    b2 = w_beta;
+    b1 = 0;
+  }
+
+  const Return_rt avg_w  = SumValue[SUM_E_WGT] / SumValue[SUM_WGT];
+  const Return_rt avg2_w = SumValue[SUM_ESQ_WGT] / SumValue[SUM_WGT];
+  const RealType H2_avg  = 1.0 / (avg_w * avg_w);
+  const RealType V_avg   = avg2_w - avg_w * avg_w;
+  const Return_rt wgtinv = 1.0 / SumValue[SUM_WGT];
+
+  // the records are streamed block by block, the samples of a block are distributed over crowds
+  // and each crowd accumulates into its own output
+  const size_t opt_num_crowds = walkers_per_crowd_.size();
+  std::vector<int> samples_per_crowd(opt_num_crowds + 1);
+  std::vector<Matrix<Return_rt>> crowd_HX(opt_num_crowds, Matrix<Return_rt>(num_vecs, num_params + 1));
+  std::vector<Matrix<Return_rt>> crowd_SX(opt_num_crowds, Matrix<Return_rt>(num_vecs, num_params + 1));
+  for (int crowd_id = 0; crowd_id < opt_num_crowds; crowd_id++)
+  {
+    crowd_HX[crowd_id] = 0.0;
+    crowd_SX[crowd_id] = 0.0;
+  }
+  Matrix<Return_rt> Dblock, HDblock;
+  int first = 0;
+
+  auto applyMatrices = [&](int crowd_id) {
+    Matrix<Return_rt>& hx = crowd_HX[crowd_id];
+    Matrix<Return_rt>& sx = crowd_SX[crowd_id];
+    std::vector<Return_rt> dsaved(num_params);
+    for (int iw = first + samples_per_crowd[crowd_id]; iw < first + samples_per_crowd[crowd_id + 1]; iw++)
+    {
+      const Return_rt* restrict saved = RecordsOnNode_[iw];
+      const Return_rt weight          = saved[REWEIGHT] * wgtinv;
+      const Return_rt eloc_new        = saved[ENERGY_NEW];
+      const Return_rt* HDsaved        = HDblock[iw - first];
+      for (int pm = 0; pm < num_params; pm++)
+        dsaved[pm] = Dblock[iw - first][pm] - D_avg[pm];
+
+      for (int iv = 0; iv < num_vecs; iv++)
       {
-        Return_rt wfe = (HDsaved[pm] + (Dsaved[pm] - D_avg[pm]) * eloc_new) * weight;
-        Return_rt wfd = (Dsaved[pm] - D_avg[pm]) * weight;
-        Return_rt vterm =
-            HDsaved[pm] * (eloc_new - curAvg_w) + (Dsaved[pm] - D_avg[pm]) * eloc_new * (eloc_new - 2.0 * curAvg_w);
-        //                 H2
-        Right(0, pm + 1) += b1 * H2_avg * vterm * weight;
-        Right(pm + 1, 0) += b1 * H2_avg * vterm * weight;
-        //                 Variance
-        Left(0, pm + 1) += b2 * vterm * weight;
-        Left(pm + 1, 0) += b2 * vterm * weight;
-        //                 Hamiltonian
-        Left(0, pm + 1) += (1 - b2) * wfe;
-        Left(pm + 1, 0) += (1 - b2) * wfd * eloc_new;
-        for (int pm2 = 0; pm2 < numParams; pm2++)
+        const Return_rt* restrict x = X[iv];
+        Return_rt a = 0.0, h = 0.0;
+        for (int pm = 0; pm < num_params; pm++)
+        {
+          a += dsaved[pm] * x[pm + 1];
+          h += HDsaved[pm] * x[pm + 1];
+        }
+        const Return_rt g     = h - 2.0 * eloc_new * a;
+        const Return_rt vterm = h * (eloc_new - avg_w) + a * eloc_new * (eloc_new - 2.0 * avg_w);
+
+        hx(iv, 0) += weight * ((1 - b2) * (h + eloc_new * a) + b2 * vterm);
+        sx(iv, 0) += weight * b1 * H2_avg * vterm;
+
+        const Return_rt alpha_h = weight *
+            (((1 - b2) * eloc_new + b2 * eloc_new * (eloc_new - 2.0 * avg_w)) * x[0] +
+             (1 - b2) * (h + eloc_new * a) - 2.0 * eloc_new * b2 * g + b2 * V_avg * a);
+        const Return_rt beta_h  = weight * b2 * ((eloc_new - avg_w) * x[0] + g);
+        const Return_rt alpha_s = weight * (b1 * H2_avg * eloc_new * (eloc_new - 2.0 * avg_w) * x[0] + a -
+                                            2.0 * eloc_new * b1 * H2_avg * g);
+        const Return_rt beta_s  = weight * b1 * H2_avg * ((eloc_new - avg_w) * x[0] + g);
+        Return_rt* restrict hx_row = hx[iv] + 1;
+        Return_rt* restrict sx_row = sx[iv] + 1;
+        for (int pm = 0; pm < num_params; pm++)
         {
-          //                Hamiltonian
-          Left(pm + 1, pm2 + 1) += (1 - b2) * wfd * (HDsaved[pm2] + (Dsaved[pm2] - D_avg[pm2]) * eloc_new);
-          //                Overlap
-          RealType ovlij = wfd * (Dsaved[pm2] - D_avg[pm2]);
-          Right(pm + 1, pm2 + 1) += ovlij;
-          //                Variance
-          RealType varij = weight * (HDsaved[pm] - 2.0 * (Dsaved[pm] - D_avg[pm]) * eloc_new) *
-              (HDsaved[pm2] - 2.0 * (Dsaved[pm2] - D_avg[pm2]) * eloc_new);
-          Left(pm + 1, pm2 + 1) += b2 * (varij + V_avg * ovlij);
-          //                H2
-          Right(pm + 1, pm2 + 1) += b1 * H2_avg * varij;
+          hx_row[pm] += alpha_h * dsaved[pm] + beta_h * HDsaved[pm];
+          sx_row[pm] += alpha_s * dsaved[pm] + beta_s * HDsaved[pm];
         }
       }
-    };
+    }
+  };
 
-    ParallelExecutor<> crowd_tasks;
-    crowd_tasks(opt_num_crowds, constructMatrices, params_per_crowd, getNumParams(), Dsaved, HDsaved, weight, eloc_new,
-                H2_avg, V_avg, D_avg, b1, b2, curAvg_w, Left, Right);
+  ParallelExecutor<> crowd_tasks;
+  for (int ib = 0; ib < deriv_records_.numBlocks(); ib++)
+  {
+    deriv_records_.loadBlock(ib, Dblock, HDblock);
+    first = deriv_records_.blockFirst(ib);
+    FairDivide(deriv_records_.blockLast(ib) - first, opt_num_crowds, samples_per_crowd);
+    crowd_tasks(opt_num_crowds, applyMatrices);
   }
-  myComm->allreduce(Right);
-  myComm->allreduce(Left);
-  Left(0, 0)  = (1 - b2) * curAvg_w + b2 * V_avg;
-  Right(0, 0) = 1.0 + b1 * H2_avg * V_avg;
+
+  HX.resize(num_vecs, num_params + 1);
+  SX.resize(num_vecs, num_params + 1);
+  HX = 0.0;
+  SX = 0.0;
+  for (int crowd_id = 0; crowd_id < opt_num_crowds; crowd_id++)
+    for (int i = 0; i < HX.size(); i++)
+    {
+      HX.data()[i] += crowd_HX[crowd_id].data()[i];
+      SX.data()[i] += crowd_SX[crowd_id].data()[i];
+    }
+  myComm->allreduce(HX);
+  myComm->allreduce(SX);
+
+  for (int iv = 0; iv < num_vecs; iv++)
+  {
+    HX(iv, 0) += ((1 - b2) * avg_w + b2 * V_avg) * X(iv, 0);
+    SX(iv, 0) += (1.0 + b1 * H2_avg * V_avg) * X(iv, 0);
+  }
+}
+
+void QMCCostFunctionBatched::getOverlapHamiltonianDiagonals(const std::vector<Return_rt>& D_avg,
+                                                            std::vector<Return_rt>& diagH,
+                                                            std::vector<Return_rt>& diagS) const
+{
+  const int num_params = getNumParams();
+  assert(D_avg.size() == num_params);
+
+  RealType b1, b2;
   if (GEVType == "H2")
-    return H2_avg;
+  {
+    b1 = w_beta;
+    b2 = 0;
+  }
+  else
+  {
+    b2 = w_beta;
+    b1 = 0;
+  }
 
-  return 1.0;
+  const Return_rt avg_w  = SumValue[SUM_E_WGT] / SumValue[SUM_WGT];
+  const Return_rt avg2_w = SumValue[SUM_ESQ_WGT] / SumValue[SUM_WGT];
+  const RealType H2_avg  = 1.0 / (avg_w * avg_w);
+  const RealType V_avg   = avg2_w - avg_w * avg_w;
+  const Return_rt wgtinv = 1.0 / SumValue[SUM_WGT];
+
+  diagH.assign(num_params + 1, 0.0);
+  diagS.assign(num_params + 1, 0.0);
+  Matrix<Return_rt> Dblock, HDblock;
+  for (int ib = 0; ib < deriv_records_.numBlocks(); ib++)
+  {
+    deriv_records_.loadBlock(ib, Dblock, HDblock);
+    const int first = deriv_records_.blockFirst(ib);
+    for (int iw = first; iw < deriv_records_.blockLast(ib); iw++)
+    {
+      const Return_rt* restrict saved = RecordsOnNode_[iw];
+      const Return_rt weight          = saved[REWEIGHT] * wgtinv;
+      const Return_rt eloc_new        = saved[ENERGY_NEW];
+      const Return_rt* Dsaved         = Dblock[iw - first];
+      const Return_rt* HDsaved        = HDblock[iw - first];
+      for (int pm = 0; pm < num_params; pm++)
+      {
+        const Return_rt d = Dsaved[pm] - D_avg[pm];
+        const Return_rt g = HDsaved[pm] - 2.0 * d * eloc_new;
+        diagH[pm + 1] += weight * ((1 - b2) * d * (HDsaved[pm] + d * eloc_new) + b2 * (g * g + V_avg * d * d));
+        diagS[pm + 1] += weight * (d * d + b1 * H2_avg * g * g);
+      }
+    }
+  }
+  myComm->allreduce(diagH);
+  myComm->allreduce(diagS);
+  diagH[0] = (1 - b2) * avg_w + b2 * V_avg;
+  diagS[0] = 1.0 + b1 * H2_avg * V_avg;
 }
 } // namespace qmcplusplus
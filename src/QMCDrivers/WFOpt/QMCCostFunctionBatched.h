@@ -18,6 +18,7 @@
 #include "QMCDrivers/WFOpt/QMCCostFunctionBase.h"
 #include "QMCDrivers/CloneManager.h"
 #include "QMCWaveFunctions/OrbitalSetTraits.h"
+#include "QMCDrivers/WFOpt/DerivRecordStore.h"
 
 namespace qmcplusplus
 {
@@ -60,8 +61,23 @@ public:
 
 
   void resetPsi(bool final_reset = false) override;
+  /** evaluate all the parameter sets in one pass over the samples.
+   *  Each batch of samples is loaded and its distance tables and parameter independent
+   *  wavefunction components are computed once, only the optimizable components and
+   *  the parameter dependent part of the Hamiltonian are evaluated for every set.
+   */
+  std::vector<Return_rt> Costs(const std::vector<std::vector<Return_t>>& param_sets, std::vector<bool>& valid) override;
   void GradCost(std::vector<Return_rt>& PGradient, const std::vector<Return_rt>& PM, Return_rt FiniteDiff = 0) override;
   Return_rt fillOverlapHamiltonianMatrices(Matrix<Return_rt>& Left, Matrix<Return_rt>& Right) override;
+  void computeDerivativeAverages(std::vector<Return_rt>& D_avg) const override;
+  void applyOverlapHamiltonian(const std::vector<Return_rt>& D_avg,
+                               const Matrix<Return_rt>& X,
+                               Matrix<Return_rt>& HX,
+                               Matrix<Return_rt>& SX) const override;
+  void getOverlapHamiltonianDiagonals(const std::vector<Return_rt>& D_avg,
+                                      std::vector<Return_rt>& diagH,
+                                      std::vector<Return_rt>& diagS) const override;
+  void releaseDerivRecords() override { deriv_records_.clear(); }
 
 protected:
   /// H components used in correlated sampling. It can be KE or KE+NLPP
@@ -71,11 +87,29 @@ protected:
 
   /** Temp derivative properties and Hderivative properties of all the walkers
   */
-  Matrix<Return_rt> DerivRecords_;
-  Matrix<Return_rt> HDerivRecords_;
+  DerivRecordStore deriv_records_;
 
   EffectiveWeight correlatedSampling(bool needGrad = true) override;
 
+  /** correlated sampling of several sets of the parameters of the wavefunction
+   * @param psi_sets the parameters of the wavefunction, one set per row of the outputs
+   * @param log_weights the log of the reweighting factor of each set and sample
+   * @param energies the local energy of each set and sample
+   */
+  void correlatedSamplingSets(const std::vector<opt_variables_type>& psi_sets,
+                              Matrix<Return_rt>& log_weights,
+                              Matrix<Return_rt>& energies);
+
+  /** normalize the REWEIGHT records and accumulate SumValue from RecordsOnNode_
+   * @param wgt_tot rank local sum of the log weights divided by the global number of samples
+   * @param wgt_tot2 rank local sum of the squared log weights divided by the global number of samples
+   * @return the effective number of samples
+   */
+  EffectiveWeight reduceCorrelatedSums(Return_rt wgt_tot, Return_rt wgt_tot2);
+
+  /// copy OptVariables into OptVariablesForPsi
+  void mapOptVariablesForPsi();
+
   SampleStack& samples_;
 
   // Number of samples local to each MPI rank
@@ -89,7 +123,7 @@ protected:
   NewTimer& check_config_timer_;
   NewTimer& corr_sampling_timer_;
   NewTimer& fill_timer_;
-
+  NewTimer& apply_timer_;
 
 #ifdef HAVE_LMY_ENGINE
   int total_samples();
@@ -86,6 +86,9 @@ QMCFixedSampleLinearOptimizeBatched::QMCFixedSampleLinearOptimizeBatched(
       do_output_matrices_hdf_(false),
       output_matrices_initialized_(false),
       freeze_parameters_(false),
+      use_davidson_solver_(false),
+      davidson_max_its_(200),
+      davidson_tol_(1e-6),
       generate_samples_timer_(
           *timer_manager.createTimer("QMCLinearOptimizeBatched::GenerateSamples", timer_level_medium)),
       initialize_timer_(*timer_manager.createTimer("QMCLinearOptimizeBatched::Initialize", timer_level_medium)),
@@ -110,6 +113,8 @@ QMCFixedSampleLinearOptimizeBatched::QMCFixedSampleLinearOptimizeBatched(
   m_param.add(param_tol, "alloweddifference");
   m_param.add(shift_i_input, "shift_i");
   m_param.add(shift_s_input, "shift_s");
+  m_param.add(davidson_max_its_, "davidson_max_its");
+  m_param.add(davidson_tol_, "davidson_tol");
   // options_LMY_
   m_param.add(options_LMY_.targetExcited, "options_LMY_.targetExcited");
   m_param.add(options_LMY_.block_lm, "options_LMY_.block_lm");
@@ -188,6 +193,21 @@ QMCFixedSampleLinearOptimizeBatched::RealType QMCFixedSampleLinearOptimizeBatche
   return c;
 }
 
+void QMCFixedSampleLinearOptimizeBatched::costFuncs(const std::vector<RealType>& dls,
+                                                    std::vector<RealType>& values,
+                                                    std::vector<bool>& valid)
+{
+  std::vector<std::vector<QMCCostFunctionBase::Return_t>> param_sets(dls.size());
+  for (int k = 0; k < dls.size(); k++)
+  {
+    param_sets[k].resize(optparam.size());
+    for (int i = 0; i < optparam.size(); i++)
+      param_sets[k][i] = optparam[i] + dls[k] * optdir[i];
+  }
+  values = optTarget->Costs(param_sets, valid);
+  objFuncWrapper_.validFuncVal = optTarget->IsValid;
+}
+
 void QMCFixedSampleLinearOptimizeBatched::start()
 {
   //close files automatically generated by QMCDriver
@@ -275,6 +295,7 @@ void QMCFixedSampleLinearOptimizeBatched::finish()
   if (optTarget->reportH5)
     optTarget->reportParametersH5();
   optTarget->reportParameters();
+  optTarget->releaseDerivRecords();
 
   app_log() << "</opt>" << std::endl;
   app_log() << "</optimization-report>" << std::endl;
@@ -579,6 +600,7 @@ void QMCFixedSampleLinearOptimizeBatched::process(xmlNodePtr q)
   std::string OutputMatrices("no");
   std::string OutputMatricesHDF("no");
   std::string FreezeParameters("no");
+  std::string LinearSolver("dense");
   OhmmsAttributeSet oAttrib;
   oAttrib.add(useGPU, "gpu");
   oAttrib.add(vmcMove, "move");
@@ -587,6 +609,7 @@ void QMCFixedSampleLinearOptimizeBatched::process(xmlNodePtr q)
   m_param.add(OutputMatrices, "output_matrices_csv", {"no", "yes"});
   m_param.add(OutputMatricesHDF, "output_matrices_hdf", {"no", "yes"});
   m_param.add(FreezeParameters, "freeze_parameters", {"no", "yes"});
+  m_param.add(LinearSolver, "linear_solver", {"dense", "davidson"});
 
   oAttrib.put(q);
   m_param.put(q);
@@ -594,6 +617,7 @@ void QMCFixedSampleLinearOptimizeBatched::process(xmlNodePtr q)
   do_output_matrices_csv_ = (OutputMatrices == "yes");
   do_output_matrices_hdf_ = (OutputMatricesHDF == "yes");
   freeze_parameters_      = (FreezeParameters == "yes");
+  use_davidson_solver_    = (LinearSolver == "davidson");
 
   // Use freeze_parameters with output_matrices to generate multiple lines in the output with
   // the same parameters so statistics can be computed in post-processing.
@@ -1606,86 +1630,113 @@ bool QMCFixedSampleLinearOptimizeBatched::one_shift_run()
   const RealType initCost = optTarget->computedCost();
 #endif
 
-  // say what we are doing
-  app_log() << std::endl
-            << "*****************************************" << std::endl
-            << "Building overlap and Hamiltonian matrices" << std::endl
-            << "*****************************************" << std::endl;
-
-  // allocate the matrices we will need
-  Matrix<RealType> ovlMat(N, N);
-  ovlMat = 0.0;
-  Matrix<RealType> hamMat(N, N);
-  hamMat = 0.0;
-  Matrix<RealType> invMat(N, N);
-  invMat = 0.0;
-  Matrix<RealType> prdMat(N, N);
-  prdMat = 0.0;
-
-  // build the overlap and hamiltonian matrices
-  optTarget->fillOverlapHamiltonianMatrices(hamMat, ovlMat);
-  invMat.copy(ovlMat);
-
-  if (do_output_matrices_csv_)
+  RealType lowestEV = 0.;
+  if (use_davidson_solver_)
   {
-    output_overlap_.output(ovlMat);
-    output_hamiltonian_.output(hamMat);
-  }
+    app_log() << std::endl
+              << "**********************************************" << std::endl
+              << "Solving the linear method with Davidson solver" << std::endl
+              << "**********************************************" << std::endl;
+
+    if (do_output_matrices_csv_ || do_output_matrices_hdf_)
+      app_warning() << "  The overlap and Hamiltonian matrices are not formed with linear_solver=davidson and will not be "
+                       "written."
+                    << std::endl;
+
+    // the derivative averages only depend on the samples, they are shared by all the matrix-vector products
+    std::vector<RealType> D_avg;
+    optTarget->computeDerivativeAverages(D_avg);
+    {
+      ScopedTimer local(eigenvalue_timer_);
+      lowestEV = getLowestEigenvectorDavidson(*optTarget, D_avg, bestShift_i, bestShift_s, parameterDirections,
+                                              davidson_max_its_, davidson_tol_);
+    }
 
-  hdf_archive hout;
-  if (do_output_matrices_hdf_)
-  {
-    std::string newh5 = get_root_name() + ".linear_matrices.h5";
-    hout.create(newh5, H5F_ACC_TRUNC);
-    hout.write(ovlMat, "overlap");
-    hout.write(hamMat, "Hamiltonian");
-    hout.write(bestShift_i, "bestShift_i");
-    hout.write(bestShift_s, "bestShift_s");
+    // compute the scaling constant to apply to the update
+    objFuncWrapper_.Lambda = getNonLinearRescale(parameterDirections, D_avg, *optTarget);
   }
-
-  // apply the identity shift
-  for (int i = 1; i < N; i++)
+  else
   {
-    hamMat(i, i) += bestShift_i;
-    if (invMat(i, i) == 0)
-      invMat(i, i) = bestShift_i * bestShift_s;
-  }
+    // say what we are doing
+    app_log() << std::endl
+              << "*****************************************" << std::endl
+              << "Building overlap and Hamiltonian matrices" << std::endl
+              << "*****************************************" << std::endl;
+
+    // allocate the matrices we will need
+    Matrix<RealType> ovlMat(N, N);
+    ovlMat = 0.0;
+    Matrix<RealType> hamMat(N, N);
+    hamMat = 0.0;
+    Matrix<RealType> invMat(N, N);
+    invMat = 0.0;
+    Matrix<RealType> prdMat(N, N);
+    prdMat = 0.0;
+
+    // build the overlap and hamiltonian matrices
+    optTarget->fillOverlapHamiltonianMatrices(hamMat, ovlMat);
+    invMat.copy(ovlMat);
+
+    if (do_output_matrices_csv_)
+    {
+      output_overlap_.output(ovlMat);
+      output_hamiltonian_.output(hamMat);
+    }
 
-  // compute the inverse of the overlap matrix
-  {
-    ScopedTimer local(involvmat_timer_);
-    invert_matrix(invMat, false);
-  }
+    hdf_archive hout;
+    if (do_output_matrices_hdf_)
+    {
+      std::string newh5 = get_root_name() + ".linear_matrices.h5";
+      hout.create(newh5, H5F_ACC_TRUNC);
+      hout.write(ovlMat, "overlap");
+      hout.write(hamMat, "Hamiltonian");
+      hout.write(bestShift_i, "bestShift_i");
+      hout.write(bestShift_s, "bestShift_s");
+    }
 
-  // apply the overlap shift
-  for (int i = 1; i < N; i++)
-    for (int j = 1; j < N; j++)
-      hamMat(i, j) += bestShift_s * ovlMat(i, j);
+    // apply the identity shift
+    for (int i = 1; i < N; i++)
+    {
+      hamMat(i, i) += bestShift_i;
+      if (invMat(i, i) == 0)
+        invMat(i, i) = bestShift_i * bestShift_s;
+    }
+
+    // compute the inverse of the overlap matrix
+    {
+      ScopedTimer local(involvmat_timer_);
+      invert_matrix(invMat, false);
+    }
+
+    // apply the overlap shift
+    for (int i = 1; i < N; i++)
+      for (int j = 1; j < N; j++)
+        hamMat(i, j) += bestShift_s * ovlMat(i, j);
 
-  // multiply the shifted hamiltonian matrix by the inverse of the overlap matrix
-  qmcplusplus::MatrixOperators::product(invMat, hamMat, prdMat);
+    // multiply the shifted hamiltonian matrix by the inverse of the overlap matrix
+    qmcplusplus::MatrixOperators::product(invMat, hamMat, prdMat);
 
-  // transpose the result (why?)
-  for (int i = 0; i < N; i++)
-    for (int j = i + 1; j < N; j++)
-      std::swap(prdMat(i, j), prdMat(j, i));
+    // transpose the result (why?)
+    for (int i = 0; i < N; i++)
+      for (int j = i + 1; j < N; j++)
+        std::swap(prdMat(i, j), prdMat(j, i));
 
-  // compute the lowest eigenvalue of the product matrix and the corresponding eigenvector
-  RealType lowestEV = 0.;
-  {
-    ScopedTimer local(eigenvalue_timer_);
-    lowestEV = getLowestEigenvector(prdMat, parameterDirections);
-  }
+    // compute the lowest eigenvalue of the product matrix and the corresponding eigenvector
+    {
+      ScopedTimer local(eigenvalue_timer_);
+      lowestEV = getLowestEigenvector(prdMat, parameterDirections);
+    }
 
-  // compute the scaling constant to apply to the update
-  objFuncWrapper_.Lambda = getNonLinearRescale(parameterDirections, ovlMat, *optTarget);
+    // compute the scaling constant to apply to the update
+    objFuncWrapper_.Lambda = getNonLinearRescale(parameterDirections, ovlMat, *optTarget);
 
-  if (do_output_matrices_hdf_)
-  {
-    hout.write(lowestEV, "lowest_eigenvalue");
-    hout.write(parameterDirections, "scaled_eigenvector");
-    hout.write(objFuncWrapper_.Lambda, "non_linear_rescale");
-    hout.close();
+    if (do_output_matrices_hdf_)
+    {
+      hout.write(lowestEV, "lowest_eigenvalue");
+      hout.write(parameterDirections, "scaled_eigenvector");
+      hout.write(objFuncWrapper_.Lambda, "non_linear_rescale");
+      hout.close();
+    }
   }
 
   // scale the update by the scaling constant
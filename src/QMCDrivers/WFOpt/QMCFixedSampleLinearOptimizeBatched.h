@@ -77,6 +77,8 @@ public:
   bool processOptXML(xmlNodePtr cur, const std::string& vmcMove, bool reportH5, bool useGPU);
 
   RealType costFunc(RealType dl);
+  ///cost function at several points of the line search, evaluated in one pass over the samples
+  void costFuncs(const std::vector<RealType>& dls, std::vector<RealType>& values, std::vector<bool>& valid);
 
   ///common operation to start optimization
   void start();
@@ -274,6 +276,13 @@ private:
   // Freeze variational parameters.  Do not update them during each step.
   bool freeze_parameters_;
 
+  // Solve the one-shift linear method with the matrix-free Davidson solver instead of dense matrices
+  bool use_davidson_solver_;
+  /// maximum number of matrix-vector products in the Davidson solver
+  int davidson_max_its_;
+  /// residual tolerance of the Davidson solver
+  RealType davidson_tol_;
+
   NewTimer& generate_samples_timer_;
   NewTimer& initialize_timer_;
   NewTimer& eigenvalue_timer_;
@@ -125,6 +125,13 @@ public:
     // Ask for 14 total walkers on 16 ranks (inconsistent input)
     // results in fatal exception on all ranks.
     CHECK_THROWS_AS(adjustGlobalWalkerCount(16, 0, 14, 0, 0, 0), UniformCommunicateError);
+
+    // Teams of 2 threads per walker leave 4 crowds on 8 threads
+    awc = adjustGlobalWalkerCount(1, 0, 8, 0, 1.0, 0, 2);
+    CHECK(awc.walkers_per_crowd.size() == 4);
+    CHECK(awc.walkers_per_crowd[3] == 2);
+    // 4 crowds of 4 threads do not fit on 8 threads
+    CHECK_THROWS_AS(adjustGlobalWalkerCount(1, 0, 8, 0, 1.0, 4, 4), UniformCommunicateError);
   }
 
   bool run() override { return false; }
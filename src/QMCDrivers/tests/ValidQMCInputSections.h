@@ -136,6 +136,36 @@ constexpr int valid_dmc_input_dmc_index             = 0;
 constexpr int valid_dmc_input_dmc_batch_index       = 1;
 constexpr int valid_dmc_batch_input_dmc_batch_index = 2;
 
+constexpr std::array<const char*, 2> valid_rmc_input_sections{
+    R"(
+  <qmc method="rmc" move="pbyp">
+    <parameter name="crowds">                 2 </parameter>
+    <estimator name="LocalEnergy" hdf5="no" />
+    <parameter name="total_walkers">          4 </parameter>
+    <parameter name="warmupSteps">            5 </parameter>
+    <parameter name="steps">                  1 </parameter>
+    <parameter name="blocks">                 2 </parameter>
+    <parameter name="timestep">             0.1 </parameter>
+    <parameter name="beads">                  8 </parameter>
+  </qmc>
+)",
+    R"(
+  <qmc method="rmc_batch" move="pbyp">
+    <parameter name="crowds">                 2 </parameter>
+    <estimator name="LocalEnergy" hdf5="no" />
+    <parameter name="total_walkers">          4 </parameter>
+    <parameter name="warmupSteps">            5 </parameter>
+    <parameter name="steps">                  1 </parameter>
+    <parameter name="blocks">                 2 </parameter>
+    <parameter name="timestep">           0.125 </parameter>
+    <parameter name="beta">                 1.0 </parameter>
+  </qmc>
+)"};
+
+// to avoid creating a situation where section test xml is in two places
+constexpr int valid_rmc_input_rmc_batch_index       = 0;
+constexpr int valid_rmc_batch_input_rmc_batch_index = 1;
+
 /** As far as I can tell these are no longer valid */
 constexpr std::array<const char*, 2> valid_opt_input_sections{
     R"(
@@ -0,0 +1,106 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "QMCDrivers/CrowdStepBuffers.hpp"
+
+namespace qmcplusplus
+{
+using RealType = QMCTraits::RealType;
+
+TEST_CASE("CrowdStepBuffers drift diffusion", "[drivers]")
+{
+  const int num_walkers   = 2;
+  const int num_particles = 3;
+  // tau = 0.25, mass = 1
+  TauParams<RealType, CoordsType::POS> taus(0.25, 1.0, 1.0);
+
+  CrowdStepBuffers<CoordsType::POS> buffers;
+  buffers.prepareStep(num_walkers, num_particles);
+  REQUIRE(buffers.walker_deltas.positions.size() == num_walkers * num_particles);
+  REQUIRE(buffers.ratios.size() == num_walkers);
+  const auto* walker_deltas_data = buffers.walker_deltas.positions.data();
+
+  // the deltas of particle 1 follow the ones of particle 0 for all walkers
+  buffers.walker_deltas.positions[2] = {1.0, 0.0, 0.0};
+  buffers.walker_deltas.positions[3] = {0.0, 2.0, 0.0};
+  buffers.loadDeltas(1, taus);
+  CHECK(buffers.deltas.positions[0][0] == Approx(0.5));
+  CHECK(buffers.deltas.positions[1][1] == Approx(1.0));
+  CHECK(buffers.rr[0] == Approx(0.25));
+  CHECK(buffers.rr[1] == Approx(1.0));
+
+  // no drift, only the ratios matter
+  buffers.ratios[0] = 0.5;
+  buffers.ratios[1] = 2.0;
+  buffers.computeAcceptance(taus, false);
+  CHECK(buffers.prob[0] == Approx(0.25));
+  CHECK(buffers.prob[1] == Approx(4.0));
+
+  // drift and diffusion
+  buffers.drifts                   = buffers.deltas;
+  buffers.drifts_reverse.positions = {{-0.5, 0.0, 0.0}, {0.0, 0.0, 0.0}};
+  buffers.drifts.positions[0][0] += 0.5;
+  buffers.computeAcceptance(taus, true);
+  // log_gf = -|delta|^2/(2 tau), log_gb = -|drift+drift_reverse|^2/(2 tau)
+  CHECK(buffers.log_gf[0] == Approx(-0.5));
+  CHECK(buffers.log_gb[0] == Approx(-0.5));
+  CHECK(buffers.log_gf[1] == Approx(-2.0));
+  CHECK(buffers.log_gb[1] == Approx(-2.0));
+  CHECK(buffers.prob[0] == Approx(0.25));
+  CHECK(buffers.prob[1] == Approx(4.0));
+
+  buffers.isAccepted[0] = true;
+  buffers.isAccepted[1] = false;
+  buffers.accumulateRR();
+  buffers.accumulateRR();
+  CHECK(buffers.rr_proposed[0] == Approx(0.5));
+  CHECK(buffers.rr_proposed[1] == Approx(2.0));
+  CHECK(buffers.rr_accepted[0] == Approx(0.5));
+  CHECK(buffers.rr_accepted[1] == Approx(0.0));
+
+  // a new step of the same crowd reuses the storage and resets the accumulators
+  buffers.prepareStep(num_walkers, num_particles);
+  CHECK(buffers.walker_deltas.positions.data() == walker_deltas_data);
+  CHECK(buffers.rr_proposed[0] == Approx(0.0));
+  CHECK(buffers.rr_accepted[0] == Approx(0.0));
+}
+
+TEST_CASE("CrowdStepBuffers drift diffusion with spin", "[drivers]")
+{
+  // tau = 0.5, mass = 1, spin_mass = 0.5
+  TauParams<RealType, CoordsType::POS_SPIN> taus(0.5, 1.0, 0.5);
+
+  CrowdStepBuffers<CoordsType::POS_SPIN> buffers;
+  buffers.prepareStep(1, 1);
+  REQUIRE(buffers.walker_deltas.spins.size() == 1);
+  REQUIRE(buffers.grads_new.grads_spins.size() == 1);
+
+  buffers.walker_deltas.positions[0] = {0.0, 0.0, 1.0};
+  buffers.walker_deltas.spins[0]     = 1.0;
+  buffers.loadDeltas(0, taus);
+  CHECK(buffers.deltas.positions[0][2] == Approx(std::sqrt(0.5)));
+  CHECK(buffers.deltas.spins[0] == Approx(1.0));
+  CHECK(buffers.rr[0] == Approx(0.5));
+
+  buffers.ratios[0]                = 1.0;
+  buffers.drifts                   = buffers.deltas;
+  buffers.drifts_reverse.positions = {{0.0, 0.0, 0.0}};
+  buffers.drifts_reverse.spins     = {1.0};
+  buffers.computeAcceptance(taus, true);
+  // spin tau is tau/spin_mass = 1, log_gf = -0.5/(2*0.5) - 1/(2*1), log_gb = -0.5/(2*0.5) - 4/(2*1)
+  CHECK(buffers.log_gf[0] == Approx(-1.0));
+  CHECK(buffers.log_gb[0] == Approx(-2.5));
+  CHECK(buffers.prob[0] == Approx(std::exp(-1.5)));
+}
+
+} // namespace qmcplusplus
@@ -14,11 +14,14 @@
 #include "Message/Communicate.h"
 #include "QMCDrivers/DMC/DMCDriverInput.h"
 #include "QMCDrivers/DMC/DMCBatched.h"
+#include "QMCDrivers/DMC/WalkerControl.h"
+#include "QMCDrivers/SFNBranch.h"
 #include "QMCDrivers/tests/ValidQMCInputSections.h"
 #include "QMCDrivers/tests/SetupDMCTest.h"
 #include "EstimatorInputDelegates.h"
 #include "Concurrency/Info.hpp"
 #include "Concurrency/UtilityFunctions.hpp"
+#include "Concurrency/ParallelExecutor.hpp"
 #include "Platforms/Host/OutputManager.h"
 
 namespace qmcplusplus
@@ -38,11 +41,123 @@ public:
 
   SetupDMCTest& get_dtest() { return *up_dtest_; }
 
+  /** run the initialization of DMCBatched::run and the autotuning,
+   *  production must see the same population and branch state as without autotuning.
+   */
+  static void testAutotuneKeepsProductionState(DMCBatched& dmc)
+  {
+    DMCBatched::StateForThread dmc_state(dmc.qmcdriver_input_, dmc.dmcdriver_input_, *dmc.drift_modifier_,
+                                         *dmc.branch_engine_, dmc.population_);
+    ParallelExecutor<> section_start_task;
+    section_start_task(dmc.crowds_.size(), DMCBatched::initialLogEvaluation, std::ref(dmc.crowds_),
+                       std::ref(dmc.step_contexts_), false);
+    QMCTraits::FullPrecRealType energy, variance;
+    dmc.population_.measureGlobalEnergyVariance(*dmc.myComm, energy, variance);
+    dmc.branch_engine_->initParam(dmc.population_, energy, variance, dmc.dmcdriver_input_.get_reconfiguration(), false);
+    dmc.walker_controller_->setTrialEnergy(dmc.branch_engine_->getEtrial());
+
+    std::vector<DMCBatched::MCPWalker> walkers_before;
+    for (const auto& walker : dmc.population_.get_walkers())
+      walkers_before.push_back(*walker);
+    const auto e_trial     = dmc.branch_engine_->getEtrial();
+    const auto e_ref       = dmc.branch_engine_->getEref();
+    const int warmup_to_do = dmc.branch_engine_->getWarmupToDoSteps();
+
+    dmc.autotuneCrowds(dmc_state);
+
+    CHECK(!dmc_state.is_autotuning);
+    CHECK(dmc.branch_engine_->getEtrial() == e_trial);
+    CHECK(dmc.branch_engine_->getEref() == e_ref);
+    CHECK(dmc.branch_engine_->getWarmupToDoSteps() == warmup_to_do);
+
+    auto& walkers = dmc.population_.get_walkers();
+    REQUIRE(walkers.size() == walkers_before.size());
+    REQUIRE(dmc.population_.get_num_local_walkers() == walkers_before.size());
+    for (int iw = 0; iw < walkers.size(); ++iw)
+    {
+      CHECK(walkers[iw]->ID == walkers_before[iw].ID);
+      CHECK(walkers[iw]->Weight == walkers_before[iw].Weight);
+      CHECK(walkers[iw]->Age == walkers_before[iw].Age);
+      CHECK(walkers[iw]->Properties(WalkerProperties::Indexes::LOCALENERGY) ==
+            walkers_before[iw].Properties(WalkerProperties::Indexes::LOCALENERGY));
+      for (int iat = 0; iat < walkers[iw]->R.size(); ++iat)
+        CHECK(walkers[iw]->R[iat] == walkers_before[iw].R[iat]);
+      // the particle sets and wavefunctions are left at the autotuning configurations
+      CHECK(walkers[iw]->wasTouched);
+    }
+
+    size_t walkers_in_crowds = 0;
+    for (const auto& crowd : dmc.crowds_)
+      walkers_in_crowds += crowd->size();
+    CHECK(walkers_in_crowds == walkers_before.size());
+  }
+
 private:
   UPtr<SetupDMCTest> up_dtest_;
 };
 } // namespace testing
 
+TEST_CASE("DMCBatched autotune crowd counts", "[drivers]")
+{
+  CHECK(DMCBatched::getAutotuneCrowdCounts(8) == std::vector<int>{8, 4, 2, 1});
+  CHECK(DMCBatched::getAutotuneCrowdCounts(6) == std::vector<int>{6, 3, 1});
+  CHECK(DMCBatched::getAutotuneCrowdCounts(1) == std::vector<int>{1});
+
+  auto read_xml = [](const char* xml) {
+    Libxml2Document doc;
+    bool okay = doc.parseFromString(xml);
+    REQUIRE(okay);
+    DMCDriverInput dmcdriver_input;
+    dmcdriver_input.readXML(doc.getRoot());
+    return dmcdriver_input;
+  };
+  CHECK(read_xml(R"(<qmc method="dmc"/>)").get_autotune_steps() == 0);
+  CHECK(read_xml(R"(<qmc method="dmc"><parameter name="autotune_steps">5</parameter></qmc>)").get_autotune_steps() ==
+        5);
+  CHECK_THROWS_AS(read_xml(R"(<qmc method="dmc"><parameter name="autotune_steps">-1</parameter></qmc>)"),
+                  std::runtime_error);
+}
+
+#ifdef _OPENMP
+TEST_CASE("DMCBatched autotuning leaves the population and branching", "[drivers]")
+{
+  using namespace testing;
+  Concurrency::OverrideMaxCapacity<> override(8);
+  Communicate* comm = OHMMS::Controller;
+  outputManager.pause();
+
+  std::string dmc_xml(valid_dmc_input_sections[valid_dmc_input_dmc_batch_index]);
+  const std::string crowds_param(R"(<parameter name="crowds">)");
+  dmc_xml.insert(dmc_xml.find(crowds_param), R"(<parameter name="autotune_steps"> 2 </parameter>
+    )");
+  Libxml2Document doc;
+  bool okay = doc.parseFromString(dmc_xml);
+  REQUIRE(okay);
+  xmlNodePtr node = doc.getRoot();
+  QMCDriverInput qmcdriver_input;
+  qmcdriver_input.readXML(node);
+  DMCDriverInput dmcdriver_input;
+  dmcdriver_input.readXML(node);
+  REQUIRE(dmcdriver_input.get_autotune_steps() == 2);
+  auto particle_pool     = MinimalParticlePool::make_diamondC_1x1x1(comm);
+  auto wavefunction_pool = MinimalWaveFunctionPool::make_diamondC_1x1x1(comm, particle_pool);
+  auto hamiltonian_pool  = MinimalHamiltonianPool::make_hamWithEE(comm, particle_pool, wavefunction_pool);
+  WalkerConfigurations walker_confs;
+  ProjectData test_project;
+  DMCBatched dmcdriver(test_project, std::move(qmcdriver_input), std::nullopt, std::move(dmcdriver_input), walker_confs,
+                       MCPopulation(comm->size(), comm->rank(), particle_pool.getParticleSet("e"),
+                                    wavefunction_pool.getPrimary(), hamiltonian_pool.getPrimary()),
+                       comm);
+  dmcdriver.setStatus("Test", "", false);
+  dmcdriver.process(node);
+  REQUIRE(dmcdriver.get_num_living_walkers() == 8);
+
+  DMCBatchedTest::testAutotuneKeepsProductionState(dmcdriver);
+  CHECK(dmcdriver.get_num_living_walkers() == 8);
+  outputManager.resume();
+}
+#endif
+
 /** Since we check the DMC only feature of reserve walkers perhaps this should be
  *  a DMC integration test.
  */
@@ -0,0 +1,109 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+#include "QMCDrivers/WFOpt/DerivRecordStore.h"
+
+
+namespace qmcplusplus
+{
+using Real = DerivRecordStore::Real;
+
+// fill the store with known values and read them back row by row and block by block
+void check_store(DerivRecordStore& store, int num_samples, int num_params, Real tol)
+{
+  store.resize(num_samples, num_params);
+  std::vector<Real> d(num_params), hd(num_params);
+  for (int is = 0; is < num_samples; is++)
+  {
+    for (int ip = 0; ip < num_params; ip++)
+    {
+      d[ip]  = 0.1 * is + 0.01 * ip + 1.0 / 3.0;
+      hd[ip] = -0.2 * is + 0.03 * ip;
+    }
+    store.writeRow(is, d.data(), hd.data());
+  }
+
+  for (int is = num_samples - 1; is >= 0; is--)
+  {
+    store.readRow(is, d.data(), hd.data());
+    for (int ip = 0; ip < num_params; ip++)
+    {
+      CHECK(d[ip] == Approx(0.1 * is + 0.01 * ip + 1.0 / 3.0).epsilon(tol));
+      CHECK(hd[ip] == Approx(-0.2 * is + 0.03 * ip).epsilon(tol).margin(tol));
+    }
+  }
+
+  Matrix<Real> dblock, hdblock;
+  int count = 0;
+  for (int ib = 0; ib < store.numBlocks(); ib++)
+  {
+    store.loadBlock(ib, dblock, hdblock);
+    CHECK(dblock.rows() == store.blockLast(ib) - store.blockFirst(ib));
+    for (int is = store.blockFirst(ib); is < store.blockLast(ib); is++, count++)
+      for (int ip = 0; ip < num_params; ip++)
+      {
+        CHECK(dblock(is - store.blockFirst(ib), ip) == Approx(0.1 * is + 0.01 * ip + 1.0 / 3.0).epsilon(tol));
+        CHECK(hdblock(is - store.blockFirst(ib), ip) == Approx(-0.2 * is + 0.03 * ip).epsilon(tol).margin(tol));
+      }
+  }
+  CHECK(count == num_samples);
+}
+
+TEST_CASE("DerivRecordStore in memory", "[drivers]")
+{
+  DerivRecordStore store;
+  DerivRecordStore::Options opts;
+  opts.block_size = 4;
+  store.setup(opts, "test_deriv_record_store.bin");
+  check_store(store, 10, 5, 1e-12);
+  CHECK(store.numBlocks() == 3);
+  CHECK(store.numResidentBlocks() == 3);
+}
+
+TEST_CASE("DerivRecordStore single precision", "[drivers]")
+{
+  DerivRecordStore store;
+  DerivRecordStore::Options opts;
+  opts.reduced_precision = true;
+  opts.block_size        = 4;
+  store.setup(opts, "test_deriv_record_store.bin");
+  check_store(store, 10, 5, 1e-6);
+}
+
+TEST_CASE("DerivRecordStore spill", "[drivers]")
+{
+  DerivRecordStore store;
+  DerivRecordStore::Options opts;
+  opts.block_size = 4;
+  // room for two blocks of 4 samples with 2*5 doubles
+  opts.max_memory_mb = (2 * 4 * 2 * 5 * sizeof(double) + 1) / (1024.0 * 1024.0);
+  store.setup(opts, "test_deriv_record_store.bin");
+  check_store(store, 13, 5, 1e-12);
+  CHECK(store.numBlocks() == 4);
+  CHECK(store.numResidentBlocks() == 2);
+
+  // the spill file only lives as long as the records
+  const std::string spill_path = store.spillPath();
+  CHECK(spill_path == "./test_deriv_record_store.bin");
+  CHECK(std::ifstream(spill_path).good());
+  store.clear();
+  CHECK(store.numSamples() == 0);
+  CHECK(store.numBlocks() == 0);
+  CHECK(store.spillPath().empty());
+  CHECK(!std::ifstream(spill_path).good());
+
+  opts.reduced_precision = true;
+  store.setup(opts, "test_deriv_record_store.bin");
+  check_store(store, 13, 5, 1e-6);
+}
+
+} // namespace qmcplusplus
@@ -95,6 +95,50 @@ TEST_CASE("MCPopulation::createWalkers_walker_ids", "[particle][population]")
 
 }
 
+TEST_CASE("MCPopulation::seedWalkerRandomStreams", "[particle][population]")
+{
+  using namespace testing;
+  Communicate* comm;
+  comm = OHMMS::Controller;
+
+  auto particle_pool     = MinimalParticlePool::make_diamondC_1x1x1(comm);
+  auto wavefunction_pool = MinimalWaveFunctionPool::make_diamondC_1x1x1(comm, particle_pool);
+  auto hamiltonian_pool  = MinimalHamiltonianPool::make_hamWithEE(comm, particle_pool, wavefunction_pool);
+  TrialWaveFunction twf;
+
+  // the first walker is restored with its random stream
+  WalkerConfigurations walker_confs;
+  walker_confs.createWalkers(1, particle_pool.getParticleSet("e")->getTotalNum());
+  walker_confs[0]->ID = 100;
+  walker_confs[0]->seedRandomStream(7);
+  walker_confs[0]->RandomStream();
+
+  MCPopulation population(comm->size(), comm->rank(), particle_pool.getParticleSet("e"), &twf,
+                          hamiltonian_pool.getPrimary());
+  population.createWalkers(4, walker_confs, 2.0);
+  CHECK(population.get_walker_stream_seed() == 0);
+  population.seedWalkerRandomStreams(7, *comm);
+  CHECK(population.get_walker_stream_seed() == 7);
+
+  auto& walkers = population.get_walkers();
+  CHECK(walkers[0]->ID == 100);
+  CHECK(walkers[0]->RandomStream.position() == 1);
+
+  auto spawned = population.spawnWalker();
+  CHECK(spawned.walker.hasRandomStream());
+
+  std::vector<long> streams;
+  for (auto& walker : walkers)
+  {
+    CHECK(walker->hasRandomStream());
+    CHECK(walker->RandomStream.stream() == walker->ID);
+    if (walker != walkers[0])
+      CHECK(walker->ID > 100);
+    streams.push_back(walker->RandomStream.stream());
+  }
+  std::sort(streams.begin(), streams.end());
+  CHECK(std::adjacent_find(streams.begin(), streams.end()) == streams.end());
+}
 
 // TEST_CASE("MCPopulation::createWalkers first touch", "[particle][population]")
 // {
@@ -0,0 +1,112 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+#include "Optimize/NRCOptimization.h"
+
+
+namespace qmcplusplus
+{
+// quartic along the line with its minimum at min_
+class QuarticLine : public NRCOptimization<double>
+{
+public:
+  QuarticLine(double min) : min_(min) {}
+
+  double Func(double dl) override
+  {
+    func_calls.push_back(dl);
+    const double d = dl - min_;
+    return 1.0 + d * d + 50.0 * d * d * d * d;
+  }
+
+  std::vector<double> func_calls;
+
+private:
+  const double min_;
+};
+
+// evaluates the points of a Funcs call together and fails the points beyond max_valid_
+class BatchedQuarticLine : public QuarticLine
+{
+public:
+  BatchedQuarticLine(double min, double max_valid) : QuarticLine(min), max_valid_(max_valid) {}
+
+  void Funcs(const std::vector<double>& dls, std::vector<double>& values, std::vector<bool>& valid) override
+  {
+    funcs_calls.push_back(dls);
+    values.resize(dls.size());
+    valid.resize(dls.size());
+    for (int i = 0; i < dls.size(); i++)
+    {
+      values[i] = Func(dls[i]);
+      valid[i]  = std::abs(dls[i]) <= max_valid_;
+    }
+  }
+
+  std::vector<std::vector<double>> funcs_calls;
+
+private:
+  const double max_valid_;
+};
+
+TEST_CASE("NRCOptimization lineoptimization3", "[drivers]")
+{
+  const int points = 7;
+  for (const double min : {0.025, -0.025})
+  {
+    QuarticLine line(min);
+    double zero_cost = line.Func(0.0);
+    line.func_calls.clear();
+    REQUIRE(line.lineoptimization3(points, zero_cost));
+    CHECK(line.Lambda == Approx(min));
+    CHECK(zero_cost == Approx(1.0));
+    // the fit points except zero and the final step
+    CHECK(line.func_calls.size() == points);
+
+    BatchedQuarticLine batched(min, 1.0);
+    double batched_zero_cost = batched.Func(0.0);
+    REQUIRE(batched.lineoptimization3(points, batched_zero_cost));
+    CHECK(batched.Lambda == Approx(line.Lambda));
+    CHECK(batched_zero_cost == Approx(zero_cost));
+
+    // the points next to zero first, then the remaining ones in the downhill direction
+    REQUIRE(batched.funcs_calls.size() == 2);
+    REQUIRE(batched.funcs_calls[0].size() == 2);
+    CHECK(batched.funcs_calls[0][0] == Approx(-batched.quadstep));
+    CHECK(batched.funcs_calls[0][1] == Approx(batched.quadstep));
+    REQUIRE(batched.funcs_calls[1].size() == points - 3);
+    const double direction = min > 0 ? 1.0 : -1.0;
+    for (int i = 0; i < points - 3; i++)
+      CHECK(batched.funcs_calls[1][i] == Approx(direction * (i + 2) * batched.quadstep));
+  }
+}
+
+TEST_CASE("NRCOptimization lineoptimization3 invalid points", "[drivers]")
+{
+  const double min = 0.025;
+  const int points = 8;
+
+  // the farthest point fails, the fit uses the remaining seven
+  BatchedQuarticLine batched(min, 0.055);
+  double zero_cost = batched.Func(0.0);
+  REQUIRE(batched.lineoptimization3(points, zero_cost));
+  CHECK(batched.validFuncVal);
+  CHECK(batched.Lambda == Approx(min));
+
+  // too few valid points for the quartic fit
+  BatchedQuarticLine failing(min, 0.015);
+  zero_cost = failing.Func(0.0);
+  CHECK_FALSE(failing.lineoptimization3(points, zero_cost));
+  CHECK_FALSE(failing.validFuncVal);
+}
+
+} // namespace qmcplusplus
@@ -11,6 +11,12 @@
 
 #include "catch.hpp"
 #include "QMCDrivers/WFOpt/QMCCostFunctionBatched.h"
+#include "QMCDrivers/WFOpt/LinearMethod.h"
+#include "QMCDrivers/WFOpt/EngineHandle.h"
+#include "OhmmsData/Libxml2Doc.h"
+#include "Particle/MCWalkerConfiguration.h"
+#include "QMCWaveFunctions/Jastrow/RadialJastrowBuilder.h"
+#include "QMCHamiltonians/BareKineticEnergy.h"
 #include "FillData.h"
 // Input data and gold data for fillFromText test
 #include "diamond_fill_data.h"
@@ -61,10 +67,32 @@ public:
 
   std::vector<QMCCostFunctionBase::Return_rt>& getSumValue() { return costFn.SumValue; }
   Matrix<QMCCostFunctionBase::Return_rt>& getRecordsOnNode() { return costFn.RecordsOnNode_; }
-  Matrix<QMCCostFunctionBase::Return_rt>& getDerivRecords() { return costFn.DerivRecords_; }
-  Matrix<QMCCostFunctionBase::Return_rt>& getHDerivRecords() { return costFn.HDerivRecords_; }
 
-  void set_samples_and_param(int nsamples, int nparam)
+  template<typename T>
+  void setDerivRecords(const Matrix<T>& deriv_records, const Matrix<T>& hderiv_records)
+  {
+    std::vector<QMCCostFunctionBase::Return_rt> dlogpsi(numParam), dhpsioverpsi(numParam);
+    for (int is = 0; is < numSamples; is++)
+    {
+      std::copy(deriv_records[is], deriv_records[is] + numParam, dlogpsi.begin());
+      std::copy(hderiv_records[is], hderiv_records[is] + numParam, dhpsioverpsi.begin());
+      costFn.deriv_records_.writeRow(is, dlogpsi.data(), dhpsioverpsi.data());
+    }
+  }
+
+  void setGEV(const std::string& gev_type, QMCCostFunctionBase::Return_rt beta)
+  {
+    costFn.GEVType = gev_type;
+    costFn.w_beta  = beta;
+  }
+
+  QMCCostFunctionBase::EffectiveWeight reduceCorrelatedSums(QMCCostFunctionBase::Return_rt wgt_tot,
+                                                            QMCCostFunctionBase::Return_rt wgt_tot2)
+  {
+    return costFn.reduceCorrelatedSums(wgt_tot, wgt_tot2);
+  }
+
+  void set_samples_and_param(int nsamples, int nparam, const DerivRecordStore::Options& opts = {})
   {
     numSamples = nsamples;
     numParam   = nparam;
@@ -80,8 +108,8 @@ public:
     costFn.NumOptimizables = numParam;
 
     getRecordsOnNode().resize(numSamples, QMCCostFunctionBase::SUM_INDEX_SIZE);
-    getDerivRecords().resize(numSamples, numParam);
-    getHDerivRecords().resize(numSamples, numParam);
+    costFn.deriv_records_.setup(opts, "test_deriv_records.bin");
+    costFn.deriv_records_.resize(numSamples, numParam);
   }
 };
 
@@ -110,11 +138,12 @@ TEST_CASE("fillOverlapAndHamiltonianMatrices", "[drivers]")
   RecordsOnNode(0, QMCCostFunctionBase::REWEIGHT)   = 1.0;
   RecordsOnNode(0, QMCCostFunctionBase::ENERGY_NEW) = -1.4;
 
-  auto& derivRecords = lin.getDerivRecords();
+  Matrix<Return_rt> derivRecords(numSamples, numParam);
   derivRecords(0, 0) = 1.1;
 
-  auto& HDerivRecords = lin.getHDerivRecords();
+  Matrix<Return_rt> HDerivRecords(numSamples, numParam);
   HDerivRecords(0, 0) = -1.2;
+  lin.setDerivRecords(derivRecords, HDerivRecords);
 
   int N = numParam + 1;
   Matrix<Return_rt> ham(N, N);
@@ -137,7 +166,7 @@ TEST_CASE("fillOverlapAndHamiltonianMatrices", "[drivers]")
 // Test QMCCostFunctionBatched::fillOverlapHamiltonianMatrices
 // Inputs are the number of crowds (threads) and
 // the input/gold data (from a file created by convert_hdf_to_cpp.py)
-void fill_from_text(int num_opt_crowds, FillData& fd)
+void fill_from_text(int num_opt_crowds, FillData& fd, const DerivRecordStore::Options& opts = {})
 {
   std::vector<int> walkers_per_crowd(num_opt_crowds, 1);
 
@@ -149,7 +178,7 @@ void fill_from_text(int num_opt_crowds, FillData& fd)
 
   int numSamples = fd.numSamples;
   int numParam   = fd.numParam;
-  lin.set_samples_and_param(numSamples, numParam);
+  lin.set_samples_and_param(numSamples, numParam, opts);
 
   std::vector<Return_rt>& SumValue           = lin.getSumValue();
   SumValue[QMCCostFunctionBase::SUM_WGT]     = fd.sum_wgt;
@@ -163,11 +192,7 @@ void fill_from_text(int num_opt_crowds, FillData& fd)
     RecordsOnNode(iw, QMCCostFunctionBase::ENERGY_NEW) = fd.energy_new[iw];
   }
 
-  auto& derivRecords = lin.getDerivRecords();
-  derivRecords       = fd.derivRecords;
-
-  auto& HDerivRecords = lin.getHDerivRecords();
-  HDerivRecords       = fd.HDerivRecords;
+  lin.setDerivRecords(fd.derivRecords, fd.HDerivRecords);
 
   int N = numParam + 1;
   Matrix<Return_rt> ham(N, N);
@@ -187,6 +212,139 @@ void fill_from_text(int num_opt_crowds, FillData& fd)
 }
 
 
+// Compare the matrix-free products and the Davidson solver against the dense matrices
+void apply_from_text(int num_opt_crowds, FillData& fd, const std::string& gev_type, double beta)
+{
+  std::vector<int> walkers_per_crowd(num_opt_crowds, 1);
+
+  using Return_rt = qmcplusplus::QMCTraits::RealType;
+
+  Communicate* comm = OHMMS::Controller;
+
+  testing::LinearMethodTestSupport lin(walkers_per_crowd, comm);
+  lin.set_samples_and_param(fd.numSamples, fd.numParam);
+  lin.setGEV(gev_type, beta);
+
+  std::vector<Return_rt>& SumValue           = lin.getSumValue();
+  SumValue[QMCCostFunctionBase::SUM_WGT]     = fd.sum_wgt;
+  SumValue[QMCCostFunctionBase::SUM_E_WGT]   = fd.sum_e_wgt;
+  SumValue[QMCCostFunctionBase::SUM_ESQ_WGT] = fd.sum_esq_wgt;
+
+  auto& RecordsOnNode = lin.getRecordsOnNode();
+  for (int iw = 0; iw < fd.numSamples; iw++)
+  {
+    RecordsOnNode(iw, QMCCostFunctionBase::REWEIGHT)   = fd.reweight[iw];
+    RecordsOnNode(iw, QMCCostFunctionBase::ENERGY_NEW) = fd.energy_new[iw];
+  }
+  lin.setDerivRecords(fd.derivRecords, fd.HDerivRecords);
+
+  const int N = fd.numParam + 1;
+  Matrix<Return_rt> ham(N, N);
+  Matrix<Return_rt> ovlp(N, N);
+  lin.costFn.fillOverlapHamiltonianMatrices(ham, ovlp);
+
+  const int num_vecs = 2;
+  Matrix<Return_rt> X(num_vecs, N), HX, SX;
+  for (int iv = 0; iv < num_vecs; iv++)
+    for (int i = 0; i < N; i++)
+      X(iv, i) = 0.1 * (i + 1) * (iv == 0 ? 1.0 : -1.0) + 0.05 * iv;
+  std::vector<Return_rt> D_avg;
+  lin.costFn.computeDerivativeAverages(D_avg);
+  lin.costFn.applyOverlapHamiltonian(D_avg, X, HX, SX);
+
+  for (int iv = 0; iv < num_vecs; iv++)
+    for (int i = 0; i < N; i++)
+    {
+      Return_rt hx(0), sx(0);
+      for (int j = 0; j < N; j++)
+      {
+        hx += ham(i, j) * X(iv, j);
+        sx += ovlp(i, j) * X(iv, j);
+      }
+      CHECK(HX(iv, i) == Approx(hx).margin(1e-8));
+      CHECK(SX(iv, i) == Approx(sx).margin(1e-8));
+    }
+
+  std::vector<Return_rt> diagH, diagS;
+  lin.costFn.getOverlapHamiltonianDiagonals(D_avg, diagH, diagS);
+  for (int i = 0; i < N; i++)
+  {
+    CHECK(diagH[i] == Approx(ham(i, i)).margin(1e-8));
+    CHECK(diagS[i] == Approx(ovlp(i, i)).margin(1e-8));
+  }
+
+  // the Davidson eigenvector must solve the shifted problem of the dense one-shift solver
+  const Return_rt shift_i = 0.01;
+  const Return_rt shift_s = 1.0;
+  LinearMethod lm;
+  std::vector<Return_rt> ev(N);
+  const Return_rt lowestEV = lm.getLowestEigenvectorDavidson(lin.costFn, D_avg, shift_i, shift_s, ev, 100, 1e-10);
+  CHECK(ev[0] == Approx(1.0));
+  for (int i = 0; i < N; i++)
+  {
+    Return_rt aev(0), bev(0);
+    for (int j = 0; j < N; j++)
+    {
+      Return_rt a = ham(i, j);
+      Return_rt b = ovlp(i, j);
+      if (i > 0 && j > 0)
+        a += shift_s * ovlp(i, j);
+      if (i > 0 && i == j)
+      {
+        a += shift_i;
+        if (b == 0)
+          b = shift_i * shift_s;
+      }
+      aev += a * ev[j];
+      bev += b * ev[j];
+    }
+    CHECK(aev == Approx(lowestEV * bev).margin(1e-6));
+  }
+}
+
+TEST_CASE("reduceCorrelatedSums", "[drivers]")
+{
+  using Return_rt   = qmcplusplus::QMCTraits::RealType;
+  Communicate* comm = OHMMS::Controller;
+
+  testing::LinearMethodTestSupport lin({1}, comm);
+  lin.set_samples_and_param(2, 1);
+  lin.samples.setMaxSamples(2);
+
+  // log weights of the two samples, the second one is three times more likely
+  auto& RecordsOnNode                               = lin.getRecordsOnNode();
+  RecordsOnNode(0, QMCCostFunctionBase::REWEIGHT)   = 0.0;
+  RecordsOnNode(1, QMCCostFunctionBase::REWEIGHT)   = std::log(3.0);
+  RecordsOnNode(0, QMCCostFunctionBase::ENERGY_NEW) = -1.0;
+  RecordsOnNode(1, QMCCostFunctionBase::ENERGY_NEW) = -2.0;
+
+  const Return_rt wgt_tot     = 0.5 * std::log(3.0);
+  const auto effective_weight = lin.reduceCorrelatedSums(wgt_tot, wgt_tot * std::log(3.0));
+
+  // the weights are normalized to average one
+  CHECK(RecordsOnNode(0, QMCCostFunctionBase::REWEIGHT) == Approx(0.5));
+  CHECK(RecordsOnNode(1, QMCCostFunctionBase::REWEIGHT) == Approx(1.5));
+  std::vector<Return_rt>& SumValue = lin.getSumValue();
+  CHECK(SumValue[QMCCostFunctionBase::SUM_WGT] == Approx(2.0));
+  CHECK(SumValue[QMCCostFunctionBase::SUM_WGTSQ] == Approx(2.5));
+  CHECK(SumValue[QMCCostFunctionBase::SUM_E_WGT] == Approx(-3.5));
+  CHECK(SumValue[QMCCostFunctionBase::SUM_E_BARE] == Approx(-3.0));
+  CHECK(effective_weight == Approx(0.8));
+}
+
+TEST_CASE("applyOverlapHamiltonian", "[drivers]")
+{
+  FillData fd;
+  get_diamond_fill_data(fd);
+
+  for (int num_opt_crowds = 1; num_opt_crowds < 3; num_opt_crowds++)
+  {
+    apply_from_text(num_opt_crowds, fd, "mixed", 0.0);
+    apply_from_text(num_opt_crowds, fd, "mixed", 0.5);
+    apply_from_text(num_opt_crowds, fd, "H2", 0.5);
+  }
+}
+
 // Test fillOverlapHamiltonianMatrices function using gold data
 // This can test the parallelization of that function using different numbers of crowds
 TEST_CASE("fillfromText", "[drivers]")
@@ -202,7 +360,115 @@ TEST_CASE("fillfromText", "[drivers]")
   {
     fill_from_text(num_opt_crowds, fd);
   }
+
+  // Records in blocks of 3 samples with a single block in memory and the rest spilled to a file
+  DerivRecordStore::Options spill_opts;
+  spill_opts.block_size    = 3;
+  spill_opts.max_memory_mb = (3 * 2 * fd.numParam * sizeof(double) + 1) / (1024.0 * 1024.0);
+  for (int num_opt_crowds = 1; num_opt_crowds < 3; num_opt_crowds++)
+  {
+    fill_from_text(num_opt_crowds, fd, spill_opts);
+  }
 }
 
+// Costs evaluates several parameter sets in one pass over the samples.
+// Each cost must match the one of Cost at that parameter set.
+TEST_CASE("Costs matches Cost", "[drivers]")
+{
+  using Return_rt   = QMCCostFunctionBase::Return_rt;
+  using Return_t    = QMCCostFunctionBase::Return_t;
+  Communicate* comm = OHMMS::Controller;
+
+  const SimulationCell simulation_cell;
+  MCWalkerConfiguration elec(simulation_cell);
+  elec.setName("e");
+  elec.create({1, 1});
+  SpeciesSet& tspecies         = elec.getSpeciesSet();
+  int upIdx                    = tspecies.addSpecies("u");
+  int downIdx                  = tspecies.addSpecies("d");
+  int chargeIdx                = tspecies.addAttribute("charge");
+  int massIdx                  = tspecies.addAttribute("mass");
+  tspecies(chargeIdx, upIdx)   = -1;
+  tspecies(chargeIdx, downIdx) = -1;
+  tspecies(massIdx, upIdx)     = 1.0;
+  tspecies(massIdx, downIdx)   = 1.0;
+  elec.resetGroups();
+
+  const char* jas_xml = R"(<tmp>
+<jastrow name="J2" type="Two-Body" function="Bspline">
+   <correlation rcut="5" size="4" speciesA="u" speciesB="d">
+      <coefficients id="ud" type="Array"> 0.4 0.2 0.1 0.05 </coefficients>
+    </correlation>
+</jastrow>
+</tmp>
+)";
+  Libxml2Document jas_doc;
+  REQUIRE(jas_doc.parseFromString(jas_xml));
+  RadialJastrowBuilder jastrow(comm, elec);
+  TrialWaveFunction psi;
+  psi.addComponent(jastrow.buildComponent(xmlFirstElementChild(jas_doc.getRoot())));
+
+  QMCHamiltonian h;
+  h.addOperator(std::make_unique<BareKineticEnergy>(elec, psi), "Kinetic");
+
+  // two crowds with different batch sizes so that the second one runs out of batches first
+  const int num_samples = 8;
+  SampleStack samples;
+  samples.setMaxSamples(num_samples);
+  for (int is = 0; is < num_samples; is++)
+  {
+    elec.R[0] = ParticleSet::PosType(0.1 * is, 0.2, -0.3);
+    elec.R[1] = ParticleSet::PosType(-0.5, 0.3 * is, 0.7 - 0.1 * is);
+    samples.appendSample(elec);
+  }
+
+  QMCCostFunctionBatched costFn(elec, psi, h, samples, {2, 4}, comm);
+
+  const char* opt_xml = R"(<qmc>
+  <cost name="energy">0.9</cost>
+  <cost name="unreweightedvariance">0.1</cost>
+</qmc>
+)";
+  Libxml2Document opt_doc;
+  REQUIRE(opt_doc.parseFromString(opt_xml));
+  costFn.put(opt_doc.getRoot());
+
+  RandomGenerator rng;
+  costFn.setRng({rng});
+  costFn.getConfigurations("");
+  NullEngineHandle handle;
+  costFn.checkConfigurations(handle);
+
+  const int num_params = costFn.getNumParams();
+  REQUIRE(num_params == 4);
+  std::vector<std::vector<Return_t>> param_sets(3, std::vector<Return_t>(num_params));
+  for (int i = 0; i < num_params; i++)
+  {
+    param_sets[0][i] = costFn.Params(i);
+    param_sets[1][i] = costFn.Params(i) + 0.05 * (i + 1);
+    param_sets[2][i] = costFn.Params(i) - 0.1;
+  }
+
+  std::vector<bool> valid;
+  const std::vector<Return_rt> costs = costFn.Costs(param_sets, valid);
+  REQUIRE(costs.size() == param_sets.size());
+  REQUIRE(valid.size() == param_sets.size());
+
+  // Costs leaves the parameters where they were
+  for (int i = 0; i < num_params; i++)
+    CHECK(costFn.Params(i) == Approx(param_sets[0][i]));
+
+  for (int k = 0; k < param_sets.size(); k++)
+  {
+    for (int i = 0; i < num_params; i++)
+      costFn.Params(i) = param_sets[k][i];
+    const Return_rt cost = costFn.Cost(false);
+    CHECK(valid[k] == costFn.IsValid);
+    CHECK(costs[k] == Approx(cost));
+  }
+  // the parameter sets differ enough to change the cost
+  CHECK(costs[1] != Approx(costs[0]));
+  CHECK(costs[2] != Approx(costs[0]));
+}
 
 } // namespace qmcplusplus
@@ -31,6 +31,7 @@
 #include "QMCDrivers/DMC/DMC.h"
 #include "QMCDrivers/VMC/VMCBatched.h"
 #include "QMCDrivers/DMC/DMCBatched.h"
+#include "QMCDrivers/RMC/RMCBatched.h"
 #include "EstimatorInputDelegates.h"
 
 namespace qmcplusplus
@@ -212,4 +213,47 @@ TEST_CASE("QMCDriverFactory create DMCBatched driver", "[qmcapp]")
   }
 }
 
+TEST_CASE("QMCDriverFactory create RMCBatched driver", "[qmcapp]")
+{
+  using namespace testing;
+  Communicate* comm;
+  comm = OHMMS::Controller;
+
+  SECTION("driver version behavior")
+  {
+    ProjectData test_project("test", ProjectData::DriverVersion::BATCH);
+    QMCDriverFactory driver_factory(test_project);
+
+    Libxml2Document doc;
+    bool okay = doc.parseFromString(valid_rmc_input_sections[valid_rmc_input_rmc_batch_index]);
+    REQUIRE(okay);
+    xmlNodePtr node                           = doc.getRoot();
+    QMCDriverFactory::DriverAssemblyState das = driver_factory.readSection(node);
+    REQUIRE(das.new_run_type == QMCRunType::RMC_BATCH);
+
+    auto qmc_driver = testing::createDriver(comm, driver_factory, node, das);
+    REQUIRE(qmc_driver != nullptr);
+    REQUIRE_NOTHROW(dynamic_cast<RMCBatched&>(*qmc_driver));
+    CHECK(qmc_driver->getEngineName() == "RMCBatched");
+  }
+  SECTION("Deprecated _batch behavior")
+  {
+    ProjectData test_project;
+    QMCDriverFactory driver_factory(test_project);
+
+    Libxml2Document doc;
+    bool okay = doc.parseFromString(valid_rmc_input_sections[valid_rmc_batch_input_rmc_batch_index]);
+    REQUIRE(okay);
+    xmlNodePtr node                           = doc.getRoot();
+    QMCDriverFactory::DriverAssemblyState das = driver_factory.readSection(node);
+    REQUIRE(das.new_run_type == QMCRunType::RMC_BATCH);
+
+    auto qmc_driver = testing::createDriver(comm, driver_factory, node, das);
+
+    REQUIRE(qmc_driver != nullptr);
+    REQUIRE_NOTHROW(dynamic_cast<RMCBatched&>(*qmc_driver));
+    CHECK(qmc_driver->getEngineName() == "RMCBatched");
+  }
+}
+
 } // namespace qmcplusplus
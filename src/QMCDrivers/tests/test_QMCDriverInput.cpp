@@ -39,4 +39,29 @@ TEST_CASE("QMCDriverInput readXML", "[drivers]")
   std::for_each(testing::valid_dmc_input_sections.begin() + testing::valid_dmc_input_dmc_batch_index,
                 testing::valid_dmc_input_sections.end(), xml_test);
 }
+
+TEST_CASE("QMCDriverInput reblocking", "[drivers]")
+{
+  Libxml2Document doc;
+  bool okay = doc.parseFromString(R"XML(
+<qmc method="vmc" move="pbyp">
+  <parameter name="blocks"> 100 </parameter>
+  <parameter name="target_error"> 0.001 </parameter>
+  <parameter name="reblock_scalars"> Kinetic LocalPotential </parameter>
+</qmc>
+)XML");
+  REQUIRE(okay);
+  QMCDriverInput qmcdriver_input;
+  qmcdriver_input.readXML(doc.getRoot());
+  CHECK(qmcdriver_input.get_reblock());
+  CHECK(qmcdriver_input.get_target_error() == Approx(0.001));
+  CHECK(qmcdriver_input.get_target_effective_samples() == 0);
+  CHECK(qmcdriver_input.get_reblock_scalars() == std::vector<std::string>{"Kinetic", "LocalPotential"});
+
+  okay = doc.parseFromString(R"XML(<qmc method="vmc" move="pbyp"/>)XML");
+  REQUIRE(okay);
+  QMCDriverInput default_input;
+  default_input.readXML(doc.getRoot());
+  CHECK_FALSE(default_input.get_reblock());
+}
 } // namespace qmcplusplus
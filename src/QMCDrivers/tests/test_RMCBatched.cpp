@@ -0,0 +1,303 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "Message/Communicate.h"
+#include "QMCDrivers/RMC/RMCDriverInput.h"
+#include "QMCDrivers/RMC/RMCBatched.h"
+#include "QMCDrivers/RMC/ReptileRing.h"
+#include "QMCDrivers/tests/ValidQMCInputSections.h"
+#include "EstimatorInputDelegates.h"
+#include "Particle/tests/MinimalParticlePool.h"
+#include "QMCWaveFunctions/tests/MinimalWaveFunctionPool.h"
+#include "QMCHamiltonians/tests/MinimalHamiltonianPool.h"
+#include "Concurrency/Info.hpp"
+#include "Concurrency/UtilityFunctions.hpp"
+#include "Concurrency/ParallelExecutor.hpp"
+#include "QMCDrivers/SFNBranch.h"
+#include "Platforms/Host/OutputManager.h"
+#include "ProjectData.h"
+
+namespace qmcplusplus
+{
+namespace testing
+{
+class RMCBatchedTest
+{
+public:
+  static RMCBatched::IndexType getNumBeads(const RMCBatched& rmc) { return rmc.num_beads_; }
+  static void initReptiles(RMCBatched& rmc) { rmc.initReptiles(); }
+  static const std::vector<std::vector<ReptileRing>>& getReptiles(const RMCBatched& rmc) { return rmc.reptiles_; }
+  static UPtrVector<Crowd>& getCrowds(RMCBatched& rmc) { return rmc.crowds_; }
+
+  /// the initialization of RMCBatched::run, the walkers are evaluated and the reptiles started from them
+  static RMCBatched::StateForThread initialize(RMCBatched& rmc)
+  {
+    RMCBatched::StateForThread rmc_state(rmc.qmcdriver_input_, rmc.rmcdriver_input_, *rmc.drift_modifier_,
+                                         *rmc.branch_engine_, rmc.population_);
+    ParallelExecutor<> section_start_task;
+    section_start_task(rmc.crowds_.size(), RMCBatched::initialLogEvaluation, std::ref(rmc.crowds_),
+                       std::ref(rmc.step_contexts_), false);
+    RMCBatched::FullPrecRealType energy, variance;
+    rmc.population_.measureGlobalEnergyVariance(*rmc.myComm, energy, variance);
+    rmc.branch_engine_->initParam(rmc.population_, energy, variance, true, false);
+    rmc.initReptiles();
+    return rmc_state;
+  }
+
+  static void runSteps(RMCBatched& rmc, const RMCBatched::StateForThread& rmc_state, int num_steps)
+  {
+    ParallelExecutor<> crowd_task;
+    for (int step = 0; step < num_steps; ++step)
+      crowd_task(rmc.crowds_.size(), RMCBatched::runRMCStep, rmc_state, std::ref(rmc.timers_),
+                 std::ref(rmc.step_contexts_), std::ref(rmc.crowds_), std::ref(rmc.reptiles_));
+  }
+};
+
+/** the head of every reptile is the walker and the ParticleSet of the walker holds it
+ */
+void checkHeadsAreWalkers(RMCBatched& rmc)
+{
+  using WP          = WalkerProperties::Indexes;
+  auto& crowds      = RMCBatchedTest::getCrowds(rmc);
+  const auto& reps  = RMCBatchedTest::getReptiles(rmc);
+  for (int crowd_id = 0; crowd_id < crowds.size(); ++crowd_id)
+  {
+    auto& walkers = crowds[crowd_id]->get_walkers();
+    auto& elecs   = crowds[crowd_id]->get_walker_elecs();
+    REQUIRE(reps[crowd_id].size() == walkers.size());
+    for (int iw = 0; iw < walkers.size(); ++iw)
+    {
+      const ReptileRing& reptile = reps[crowd_id][iw];
+      const auto& walker         = walkers[iw].get();
+      CHECK(reptile.getHeadProperties()[WP::LOCALENERGY] == Approx(walker.Properties(WP::LOCALENERGY)));
+      CHECK(reptile.getHeadAge() == walker.Age);
+      for (int iat = 0; iat < walker.R.size(); ++iat)
+      {
+        CHECK(reptile.getBeadPositions(0)[iat] == walker.R[iat]);
+        CHECK(elecs[iw].get().R[iat] == walker.R[iat]);
+      }
+    }
+  }
+}
+
+} // namespace testing
+
+TEST_CASE("ReptileRing grow and bounce", "[drivers]")
+{
+  using WP       = WalkerProperties::Indexes;
+  using Walker_t = ReptileRing::Walker_t;
+  const int nbeads = 4;
+
+  Walker_t walker(2);
+  walker.R[0]                        = {0.0, 0.0, 0.0};
+  walker.R[1]                        = {1.0, 0.0, 0.0};
+  walker.Properties(WP::LOCALENERGY) = -1.0;
+
+  ReptileRing reptile;
+  reptile.init(nbeads, walker);
+  CHECK(reptile.size() == nbeads);
+  CHECK(reptile.getTailProperties()[WP::LOCALENERGY] == Approx(-1.0));
+
+  // grow three new heads, bead i has energy -(i+1) counted from the tail
+  for (int step = 0; step < 3; step++)
+  {
+    walker.R[0][1]                     = step + 1;
+    walker.Properties(WP::LOCALENERGY) = -2.0 - step;
+    reptile.growHead(walker);
+  }
+  CHECK(reptile.getHeadProperties()[WP::LOCALENERGY] == Approx(-4.0));
+  CHECK(reptile.getNextProperties()[WP::LOCALENERGY] == Approx(-2.0));
+  CHECK(reptile.getTailProperties()[WP::LOCALENERGY] == Approx(-1.0));
+  CHECK(reptile.getBeadPositions(0)[0][1] == Approx(3.0));
+  CHECK(reptile.getBeadPositions(nbeads - 1)[0][1] == Approx(0.0));
+
+  // the new head overwrites the old tail
+  walker.Properties(WP::LOCALENERGY) = -5.0;
+  reptile.growHead(walker);
+  CHECK(reptile.getTailProperties()[WP::LOCALENERGY] == Approx(-2.0));
+
+  // a bounce makes the tail the head, without copying beads
+  reptile.incrementHeadAge();
+  reptile.flip();
+  CHECK(reptile.getDirection() == -1);
+  CHECK(reptile.getHeadProperties()[WP::LOCALENERGY] == Approx(-2.0));
+  CHECK(reptile.getTailProperties()[WP::LOCALENERGY] == Approx(-5.0));
+  CHECK(reptile.getTailAge() == 1);
+
+  Walker_t head(2);
+  reptile.loadHead(head);
+  CHECK(head.Properties(WP::LOCALENERGY) == Approx(-2.0));
+  CHECK(head.R[0][1] == Approx(1.0));
+  CHECK(head.R[1][0] == Approx(1.0));
+  CHECK(head.Age == 0);
+
+  // flipping twice restores the reptile
+  reptile.flip();
+  CHECK(reptile.getHeadProperties()[WP::LOCALENERGY] == Approx(-5.0));
+  CHECK(reptile.getCenterProperties()[WP::LOCALENERGY] == Approx(-4.0));
+}
+
+TEST_CASE("RMCDriverInput readXML", "[drivers]")
+{
+  auto read_xml = [](const char* driver_xml) {
+    Libxml2Document doc;
+    bool okay = doc.parseFromString(driver_xml);
+    REQUIRE(okay);
+    RMCDriverInput rmcdriver_input;
+    rmcdriver_input.readXML(doc.getRoot());
+    return rmcdriver_input;
+  };
+
+  RMCDriverInput with_beads = read_xml(testing::valid_rmc_input_sections[testing::valid_rmc_input_rmc_batch_index]);
+  CHECK(with_beads.get_num_beads(0.1) == 8);
+  CHECK(with_beads.get_vmc_presteps() == -1);
+  CHECK(with_beads.get_max_age() == 10);
+
+  RMCDriverInput with_beta =
+      read_xml(testing::valid_rmc_input_sections[testing::valid_rmc_batch_input_rmc_batch_index]);
+  CHECK(with_beta.get_num_beads(0.125) == 8);
+
+  CHECK_THROWS_AS(read_xml(R"(<qmc method="rmc"><parameter name="timestep">0.1</parameter></qmc>)"),
+                  std::runtime_error);
+}
+
+TEST_CASE("RMCBatched+QMCDriverNew integration", "[drivers]")
+{
+  using namespace testing;
+  Concurrency::OverrideMaxCapacity<> override(8);
+  Communicate* comm = OHMMS::Controller;
+  outputManager.pause();
+
+  Libxml2Document doc;
+  bool okay = doc.parseFromString(valid_rmc_input_sections[valid_rmc_input_rmc_batch_index]);
+  REQUIRE(okay);
+  xmlNodePtr node = doc.getRoot();
+  QMCDriverInput qmcdriver_input;
+  qmcdriver_input.readXML(node);
+  RMCDriverInput rmcdriver_input;
+  rmcdriver_input.readXML(node);
+  auto particle_pool     = MinimalParticlePool::make_diamondC_1x1x1(comm);
+  auto wavefunction_pool = MinimalWaveFunctionPool::make_diamondC_1x1x1(comm, particle_pool);
+  auto hamiltonian_pool  = MinimalHamiltonianPool::make_hamWithEE(comm, particle_pool, wavefunction_pool);
+
+  WalkerConfigurations walker_confs;
+  ProjectData test_project;
+  RMCBatched rmcdriver(test_project, std::move(qmcdriver_input), std::nullopt, std::move(rmcdriver_input), walker_confs,
+                       MCPopulation(comm->size(), comm->rank(), particle_pool.getParticleSet("e"),
+                                    wavefunction_pool.getPrimary(), hamiltonian_pool.getPrimary()),
+                       comm);
+
+  std::string root_name{"Test"};
+  std::string prev_config_file{""};
+  rmcdriver.setStatus(root_name, prev_config_file, false);
+  outputManager.resume();
+
+  rmcdriver.process(node);
+  CHECK(rmcdriver.get_num_living_walkers() == 4);
+  CHECK(RMCBatchedTest::getNumBeads(rmcdriver) == 8);
+
+  // one reptile per walker
+  RMCBatchedTest::initReptiles(rmcdriver);
+  int num_reptiles = 0;
+  for (auto& crowd_reptiles : RMCBatchedTest::getReptiles(rmcdriver))
+    for (auto& reptile : crowd_reptiles)
+    {
+      CHECK(reptile.size() == 8);
+      num_reptiles++;
+    }
+  CHECK(num_reptiles == 4);
+}
+
+TEST_CASE("RMCBatched advanceReptiles", "[drivers]")
+{
+  using namespace testing;
+  using WP = WalkerProperties::Indexes;
+  Concurrency::OverrideMaxCapacity<> override(8);
+  Communicate* comm = OHMMS::Controller;
+  outputManager.pause();
+
+  Libxml2Document doc;
+  bool okay = doc.parseFromString(valid_rmc_input_sections[valid_rmc_input_rmc_batch_index]);
+  REQUIRE(okay);
+  xmlNodePtr node = doc.getRoot();
+  QMCDriverInput qmcdriver_input;
+  qmcdriver_input.readXML(node);
+  RMCDriverInput rmcdriver_input;
+  rmcdriver_input.readXML(node);
+  auto particle_pool     = MinimalParticlePool::make_diamondC_1x1x1(comm);
+  auto wavefunction_pool = MinimalWaveFunctionPool::make_diamondC_1x1x1(comm, particle_pool);
+  auto hamiltonian_pool  = MinimalHamiltonianPool::make_hamWithEE(comm, particle_pool, wavefunction_pool);
+
+  WalkerConfigurations walker_confs;
+  ProjectData test_project;
+  RMCBatched rmcdriver(test_project, std::move(qmcdriver_input), std::nullopt, std::move(rmcdriver_input), walker_confs,
+                       MCPopulation(comm->size(), comm->rank(), particle_pool.getParticleSet("e"),
+                                    wavefunction_pool.getPrimary(), hamiltonian_pool.getPrimary()),
+                       comm);
+  rmcdriver.setStatus("Test", "", false);
+  rmcdriver.process(node);
+  const int num_beads = RMCBatchedTest::getNumBeads(rmcdriver);
+  const int num_elecs = particle_pool.getParticleSet("e")->getTotalNum();
+
+  auto rmc_state = RMCBatchedTest::initialize(rmcdriver);
+  checkHeadsAreWalkers(rmcdriver);
+
+  // growing never bounces, the heads that moved are stored over the tails
+  rmc_state.is_growing = true;
+  RMCBatchedTest::runSteps(rmcdriver, rmc_state, num_beads);
+  for (auto& crowd_reptiles : RMCBatchedTest::getReptiles(rmcdriver))
+    for (auto& reptile : crowd_reptiles)
+    {
+      CHECK(reptile.size() == num_beads);
+      CHECK(reptile.getDirection() == 1);
+    }
+  checkHeadsAreWalkers(rmcdriver);
+
+  // a step tested against the action either grows the reptile or makes its tail the head
+  rmc_state.is_growing = false;
+  std::vector<std::vector<ReptileRing>> before(RMCBatchedTest::getReptiles(rmcdriver));
+  RMCBatchedTest::runSteps(rmcdriver, rmc_state, 1);
+  const auto& after = RMCBatchedTest::getReptiles(rmcdriver);
+  int num_grown = 0, num_bounced = 0;
+  for (int crowd_id = 0; crowd_id < after.size(); ++crowd_id)
+    for (int ir = 0; ir < after[crowd_id].size(); ++ir)
+    {
+      const ReptileRing& old_reptile = before[crowd_id][ir];
+      const ReptileRing& reptile     = after[crowd_id][ir];
+      if (reptile.getDirection() == old_reptile.getDirection())
+      {
+        // the old head is the bead next to the new one
+        num_grown++;
+        CHECK(reptile.getBeadProperties(1)[WP::LOCALENERGY] ==
+              Approx(old_reptile.getHeadProperties()[WP::LOCALENERGY]));
+        CHECK(reptile.getTailProperties()[WP::LOCALENERGY] ==
+              Approx(old_reptile.getNextProperties()[WP::LOCALENERGY]));
+      }
+      else
+      {
+        num_bounced++;
+        CHECK(reptile.getHeadProperties()[WP::LOCALENERGY] ==
+              Approx(old_reptile.getTailProperties()[WP::LOCALENERGY]));
+        CHECK(reptile.getTailProperties()[WP::LOCALENERGY] ==
+              Approx(old_reptile.getHeadProperties()[WP::LOCALENERGY]));
+        CHECK(reptile.getTailAge() == old_reptile.getHeadAge() + 1);
+        for (int iat = 0; iat < num_elecs; ++iat)
+          CHECK(reptile.getBeadPositions(0)[iat] == old_reptile.getBeadPositions(num_beads - 1)[iat]);
+      }
+    }
+  CHECK(num_grown + num_bounced == 4);
+  checkHeadsAreWalkers(rmcdriver);
+  outputManager.resume();
+}
+
+} // namespace qmcplusplus
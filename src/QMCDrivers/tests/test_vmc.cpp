@@ -22,6 +22,8 @@
 #include "QMCWaveFunctions/WaveFunctionComponent.h"
 #include "QMCWaveFunctions/TrialWaveFunction.h"
 #include "QMCWaveFunctions/ConstantOrbital.h"
+#include "QMCWaveFunctions/Fermion/DiracDeterminant.h"
+#include "QMCWaveFunctions/ElectronGas/FreeOrbital.h"
 #include "QMCHamiltonians/BareKineticEnergy.h"
 #include "Estimators/EstimatorManagerBase.h"
 #include "Estimators/TraceManager.h"
@@ -112,4 +114,105 @@ TEST_CASE("VMC Particle-by-Particle advanceWalkers", "[drivers][vmc]")
   CHECK(elec.R[1][1] == Approx(-0.372329741105903));
   CHECK(elec.R[1][2] == Approx(1.0));
 }
+
+namespace
+{
+struct PbyPWalkerResult
+{
+  MCWalkerConfiguration::Walker_t walker;
+  size_t walker_bytes;
+  int num_accept;
+  int num_reject;
+};
+
+/** advance a walker of three electrons in a plane wave determinant twice with VMCUpdatePbyP
+ * @param keep_walker_buffer if the walker keeps the state of the determinant
+ */
+PbyPWalkerResult advanceDeterminantWalker(bool keep_walker_buffer)
+{
+  using PosType = QMCTraits::PosType;
+  const SimulationCell simulation_cell;
+  ParticleSet ions(simulation_cell);
+  MCWalkerConfiguration elec(simulation_cell);
+
+  ions.setName("ion");
+  ions.create({1});
+  ions.R[0] = {0.0, 0.0, 0.0};
+
+  elec.setName("elec");
+  elec.create({3});
+  elec.R[0] = {1.0, 0.0, 0.0};
+  elec.R[1] = {0.0, 0.0, 1.0};
+  elec.R[2] = {0.3, -0.7, 0.2};
+  elec.createWalkers(1);
+
+  SpeciesSet& tspecies       = elec.getSpeciesSet();
+  int upIdx                  = tspecies.addSpecies("u");
+  int chargeIdx              = tspecies.addAttribute("charge");
+  int massIdx                = tspecies.addAttribute("mass");
+  tspecies(chargeIdx, upIdx) = -1;
+  tspecies(massIdx, upIdx)   = 1.0;
+
+  elec.addTable(ions);
+  elec.update();
+
+#ifdef QMC_COMPLEX
+  // one plane wave per orbital
+  const std::vector<PosType> kpts{{0.0, 0.0, 0.0}, {0.5, 0.3, 0.2}, {-0.2, 0.4, 0.1}};
+#else
+  // the constant, the cosine and the sine of one wave vector
+  const std::vector<PosType> kpts{{0.0, 0.0, 0.0}, {0.5, 0.3, 0.2}};
+#endif
+  TrialWaveFunction psi;
+  psi.addComponent(std::make_unique<DiracDeterminant<>>(std::make_unique<FreeOrbital>("free", kpts), 0, 3));
+
+  FakeRandom rg;
+
+  QMCHamiltonian h;
+  h.addOperator(std::make_unique<BareKineticEnergy>(elec, psi), "Kinetic");
+  h.addObservables(elec);
+
+  elec.resetWalkerProperty();
+
+  VMCUpdatePbyP vmc(elec, psi, h, rg);
+  EstimatorManagerBase EM;
+  SimpleFixedNodeBranch branch(0.1, 1);
+  TraceManager TM;
+  DriftModifierUNR DM;
+  vmc.resetRun(&branch, &EM, &TM, &DM);
+  vmc.setKeepWalkerBuffer(keep_walker_buffer);
+  vmc.initWalkersForPbyP(elec.begin(), elec.end());
+
+  vmc.startBlock(2);
+  // the second step loads the walker moved by the first one
+  vmc.advanceWalkers(elec.begin(), elec.end(), true);
+  vmc.advanceWalkers(elec.begin(), elec.end(), true);
+
+  return {*elec.WalkerList[0], elec.WalkerList[0]->DataSet.byteSize(), vmc.nAccept, vmc.nReject};
+}
+} // namespace
+
+TEST_CASE("VMC Particle-by-Particle advanceWalkers without walker buffer", "[drivers][vmc]")
+{
+  using WP                    = WalkerProperties::Indexes;
+  const PbyPWalkerResult kept = advanceDeterminantWalker(true);
+  const PbyPWalkerResult lean = advanceDeterminantWalker(false);
+
+  // the lean walker only carries its own fields
+  MCWalkerConfiguration::Walker_t lean_walker(3);
+  lean_walker.registerData();
+  lean_walker.DataSet.allocate();
+  CHECK(lean.walker_bytes == lean_walker.DataSet.byteSize());
+  CHECK(kept.walker_bytes > lean.walker_bytes);
+
+  // recomputing the determinant when the walker is loaded gives the same moves and values as restoring it
+  REQUIRE(kept.num_accept + kept.num_reject == 6);
+  CHECK(lean.num_accept == kept.num_accept);
+  CHECK(lean.num_reject == kept.num_reject);
+  for (int iat = 0; iat < 3; iat++)
+    for (int idim = 0; idim < 3; idim++)
+      CHECK(lean.walker.R[iat][idim] == Approx(kept.walker.R[iat][idim]));
+  CHECK(lean.walker.Properties(WP::LOGPSI) == Approx(kept.walker.Properties(WP::LOGPSI)));
+  CHECK(lean.walker.Properties(WP::LOCALENERGY) == Approx(kept.walker.Properties(WP::LOCALENERGY)));
+}
 } // namespace qmcplusplus
@@ -117,6 +117,55 @@ ACForce::Return_t ACForce::evaluate(ParticleSet& P)
   return 0.0;
 };
 
+void ACForce::mw_evaluate(const RefVectorWithLeader<OperatorBase>& o_list,
+                          const RefVectorWithLeader<TrialWaveFunction>& wf_list,
+                          const RefVectorWithLeader<ParticleSet>& p_list) const
+{
+  if (!fastDerivatives_)
+  {
+    OperatorBase::mw_evaluate(o_list, wf_list, p_list);
+    return;
+  }
+
+  auto& force_leader = o_list.getCastedLeader<ACForce>();
+  RefVectorWithLeader<QMCHamiltonian> ham_list(force_leader.ham_);
+  RefVectorWithLeader<TWFFastDerivWrapper> wrapper_list(force_leader.psi_wrapper_);
+  RefVector<Forces> hf_force_list;
+  RefVector<Forces> wf_grad_list;
+  for (int iw = 0; iw < o_list.size(); iw++)
+  {
+    ACForce& force     = o_list.getCastedElement<ACForce>(iw);
+    force.hf_force_    = 0;
+    force.pulay_force_ = 0;
+    force.wf_grad_     = 0;
+    force.sw_pulay_    = 0;
+    force.sw_grad_     = 0;
+    ham_list.push_back(force.ham_);
+    wrapper_list.push_back(force.psi_wrapper_);
+    hf_force_list.push_back(force.hf_force_);
+    wf_grad_list.push_back(force.wf_grad_);
+  }
+
+  auto local_energies = QMCHamiltonian::mw_evaluateIonDerivsDeterministicFast(ham_list, p_list, force_leader.ions_,
+                                                                              wf_list, wrapper_list, hf_force_list,
+                                                                              wf_grad_list);
+  for (int iw = 0; iw < o_list.size(); iw++)
+  {
+    ACForce& force = o_list.getCastedElement<ACForce>(iw);
+    ParticleSet& P = p_list[iw];
+    force.value_   = local_energies[iw];
+    if (useSpaceWarp_)
+    {
+      Forces el_grad;
+      el_grad.resize(P.getTotalNum());
+      el_grad = 0;
+
+      force.ham_.evaluateElecGrad(P, force.psi_, el_grad, delta_);
+      force.swt_.computeSWT(P, force.ions_, el_grad, P.G, force.sw_pulay_, force.sw_grad_);
+    }
+  }
+}
+
 void ACForce::resetTargetParticleSet(ParticleSet& P) {}
 
 void ACForce::addObservables(PropertySetType& plist, BufferType& collectables)
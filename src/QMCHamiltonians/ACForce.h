@@ -65,6 +65,13 @@ public:
   /** Evaluate **/
   Return_t evaluate(ParticleSet& P) final;
 
+  /** Batched evaluate.  With fast derivatives the walkers share the ion derivative evaluation of the SPOs
+   *  and reuse the inverses of the determinants, otherwise it falls back to evaluate walker by walker.
+   */
+  void mw_evaluate(const RefVectorWithLeader<OperatorBase>& o_list,
+                   const RefVectorWithLeader<TrialWaveFunction>& wf_list,
+                   const RefVectorWithLeader<ParticleSet>& p_list) const final;
+
 private:
   ///Finite difference timestep
   RealType delta_;
@@ -69,4 +69,17 @@ std::vector<int> Hdispatcher::flex_makeNonLocalMoves(const RefVectorWithLeader<Q
   }
 }
 
+void Hdispatcher::flex_auxHevaluate(const RefVectorWithLeader<QMCHamiltonian>& ham_list,
+                                    const RefVectorWithLeader<TrialWaveFunction>& wf_list,
+                                    const RefVectorWithLeader<ParticleSet>& p_list,
+                                    const RefVector<QMCHamiltonian::Walker_t>& walkers) const
+{
+  assert(ham_list.size() == p_list.size());
+  if (use_batch_)
+    QMCHamiltonian::mw_auxHevaluate(ham_list, wf_list, p_list, walkers);
+  else
+    for (size_t iw = 0; iw < ham_list.size(); iw++)
+      ham_list[iw].auxHevaluate(p_list[iw], walkers[iw]);
+}
+
 } // namespace qmcplusplus
@@ -40,6 +40,11 @@ public:
                                           const RefVectorWithLeader<TrialWaveFunction>& wf_list,
                                           const RefVectorWithLeader<ParticleSet>& p_list) const;
 
+  void flex_auxHevaluate(const RefVectorWithLeader<QMCHamiltonian>& ham_list,
+                         const RefVectorWithLeader<TrialWaveFunction>& wf_list,
+                         const RefVectorWithLeader<ParticleSet>& p_list,
+                         const RefVector<QMCHamiltonian::Walker_t>& walkers) const;
+
 private:
   bool use_batch_;
 };
@@ -810,6 +810,34 @@ void QMCHamiltonian::auxHevaluate(ParticleSet& P, Walker_t& ThisWalker, bool do_
   }
 }
 
+void QMCHamiltonian::mw_auxHevaluate(const RefVectorWithLeader<QMCHamiltonian>& ham_list,
+                                     const RefVectorWithLeader<TrialWaveFunction>& wf_list,
+                                     const RefVectorWithLeader<ParticleSet>& p_list,
+                                     const RefVector<Walker_t>& walkers)
+{
+  auto& ham_leader = ham_list.getLeader();
+#if !defined(REMOVE_TRACEMANAGER)
+  for (int iw = 0; iw < ham_list.size(); ++iw)
+    ham_list[iw].collect_walker_traces(walkers[iw], p_list[iw].current_step);
+#endif
+  for (int i = 0; i < ham_leader.auxH.size(); ++i)
+  {
+    const auto aux_list(extract_auxH_list(ham_list, i));
+    for (int iw = 0; iw < ham_list.size(); ++iw)
+      aux_list[iw].setHistories(walkers[iw]);
+    ham_leader.auxH[i]->mw_evaluate(aux_list, wf_list, p_list);
+    for (int iw = 0; iw < ham_list.size(); ++iw)
+    {
+      QMCHamiltonian& ham = ham_list[iw];
+      aux_list[iw].setObservables(ham.Observables);
+#if !defined(REMOVE_TRACEMANAGER)
+      aux_list[iw].collectScalarTraces();
+#endif
+      aux_list[iw].setParticlePropertyList(p_list[iw].PropertyList, ham.myIndex);
+    }
+  }
+}
+
 /** Looks like a hack see DMCBatched.cpp and DMC.cpp weight is used like temporary flag
  *  from DMC.
  */
@@ -1077,6 +1105,8 @@ void QMCHamiltonian::createResource(ResourceCollection& collection) const
   auto resource_index = collection.addResource(std::make_unique<QMCHamiltonianMultiWalkerResource>());
   for (int i = 0; i < H.size(); ++i)
     H[i]->createResource(collection);
+  for (int i = 0; i < auxH.size(); ++i)
+    auxH[i]->createResource(collection);
 }
 
 void QMCHamiltonian::acquireResource(ResourceCollection& collection,
@@ -1092,6 +1122,11 @@ void QMCHamiltonian::acquireResource(ResourceCollection& collection,
     const auto HC_list(extract_HC_list(ham_list, i_ham_op));
     ham_leader.H[i_ham_op]->acquireResource(collection, HC_list);
   }
+  for (int i_aux_op = 0; i_aux_op < ham_leader.auxH.size(); ++i_aux_op)
+  {
+    const auto aux_list(extract_auxH_list(ham_list, i_aux_op));
+    ham_leader.auxH[i_aux_op]->acquireResource(collection, aux_list);
+  }
 }
 
 void QMCHamiltonian::releaseResource(ResourceCollection& collection,
@@ -1104,6 +1139,11 @@ void QMCHamiltonian::releaseResource(ResourceCollection& collection,
     const auto HC_list(extract_HC_list(ham_list, i_ham_op));
     ham_leader.H[i_ham_op]->releaseResource(collection, HC_list);
   }
+  for (int i_aux_op = 0; i_aux_op < ham_leader.auxH.size(); ++i_aux_op)
+  {
+    const auto aux_list(extract_auxH_list(ham_list, i_aux_op));
+    ham_leader.auxH[i_aux_op]->releaseResource(collection, aux_list);
+  }
 }
 
 std::unique_ptr<QMCHamiltonian> QMCHamiltonian::makeClone(ParticleSet& qp, TrialWaveFunction& psi) const
@@ -1216,6 +1256,16 @@ RefVectorWithLeader<OperatorBase> QMCHamiltonian::extract_HC_list(const RefVecto
   return HC_list;
 }
 
+RefVectorWithLeader<OperatorBase> QMCHamiltonian::extract_auxH_list(const RefVectorWithLeader<QMCHamiltonian>& ham_list,
+                                                                    int id)
+{
+  RefVectorWithLeader<OperatorBase> aux_list(*ham_list.getLeader().auxH[id]);
+  aux_list.reserve(ham_list.size());
+  for (QMCHamiltonian& H : ham_list)
+    aux_list.push_back(*(H.auxH[id]));
+  return aux_list;
+}
+
 QMCHamiltonian::FullPrecRealType QMCHamiltonian::evaluateIonDerivsDeterministicFast(ParticleSet& P,
                                                                                     ParticleSet& ions,
                                                                                     TrialWaveFunction& psi_in,
@@ -1314,10 +1364,13 @@ QMCHamiltonian::FullPrecRealType QMCHamiltonian::evaluateIonDerivsDeterministicF
   ParticleSet::ParticlePos hfdiag_(ions.getTotalNum());
   wfgradraw_           = 0.0;
   RealType localEnergy = 0.0;
+  // a multideterminant contracts the matrices on all the orbitals over its expansion instead
+  const bool multidet = psi_wrapper_in.hasMultiSlaterDet();
 
   {
     psi_wrapper_in.getM(P, M_);
   }
+  if (!multidet)
   {
     psi_wrapper_in.getGSMatrices(M_, M_gs_);
     psi_wrapper_in.invertMatrices(M_gs_, Minv_);
@@ -1338,14 +1391,20 @@ QMCHamiltonian::FullPrecRealType QMCHamiltonian::evaluateIonDerivsDeterministicF
   ValueType nondiag_cont   = 0.0;
   RealType nondiag_cont_re = 0.0;
 
-  psi_wrapper_in.getGSMatrices(B_, B_gs_);
-  nondiag_cont = psi_wrapper_in.trAB(Minv_, B_gs_);
-  convertToReal(nondiag_cont, nondiag_cont_re);
-  localEnergy += nondiag_cont_re;
-
+  if (multidet)
+  {
+    TWFFastDerivWrapper::GradType dlogpsi, dO;
+    nondiag_cont = psi_wrapper_in.computeMultiDetDerivative(M_, B_, {}, {}, dlogpsi, dO);
+  }
+  else
   {
+    psi_wrapper_in.getGSMatrices(B_, B_gs_);
+    nondiag_cont = psi_wrapper_in.trAB(Minv_, B_gs_);
     psi_wrapper_in.buildX(Minv_, B_gs_, X_);
   }
+  convertToReal(nondiag_cont, nondiag_cont_re);
+  localEnergy += nondiag_cont_re;
+
   //And now we compute the 3N force derivatives.  3 at a time for each atom.
   for (int iat = 0; iat < ions.getTotalNum(); iat++)
   {
@@ -1374,23 +1433,218 @@ QMCHamiltonian::FullPrecRealType QMCHamiltonian::evaluateIonDerivsDeterministicF
       }
     }
 
-    for (int idim = 0; idim < OHMMS_DIM; idim++)
+    if (multidet)
     {
-      psi_wrapper_in.getGSMatrices(dB_[idim], dB_gs_[idim]);
-      psi_wrapper_in.getGSMatrices(dM_[idim], dM_gs_[idim]);
+      TWFFastDerivWrapper::GradType dlogpsi, dO;
+      psi_wrapper_in.computeMultiDetDerivative(M_, B_, dM_, dB_, dlogpsi, dO);
+      dedr_complex[iat] = dO;
+      wfgradraw_[iat] += dlogpsi;
+    }
+    else
+      for (int idim = 0; idim < OHMMS_DIM; idim++)
+      {
+        psi_wrapper_in.getGSMatrices(dB_[idim], dB_gs_[idim]);
+        psi_wrapper_in.getGSMatrices(dM_[idim], dM_gs_[idim]);
 
-      ValueType fval          = 0.0;
-      fval                    = psi_wrapper_in.computeGSDerivative(Minv_, X_, dM_gs_[idim], dB_gs_[idim]);
-      dedr_complex[iat][idim] = fval;
+        ValueType fval          = 0.0;
+        fval                    = psi_wrapper_in.computeGSDerivative(Minv_, X_, dM_gs_[idim], dB_gs_[idim]);
+        dedr_complex[iat][idim] = fval;
 
-      ValueType wfcomp = 0.0;
-      wfcomp           = psi_wrapper_in.trAB(Minv_, dM_gs_[idim]);
-      wfgradraw_[iat][idim] += wfcomp; //The determinantal piece of the WF grad.
-    }
+        ValueType wfcomp = 0.0;
+        wfcomp           = psi_wrapper_in.trAB(Minv_, dM_gs_[idim]);
+        wfgradraw_[iat][idim] += wfcomp; //The determinantal piece of the WF grad.
+      }
     convertToReal(dedr_complex[iat], dEdR[iat]);
     convertToReal(wfgradraw_[iat], wf_grad[iat]);
   }
   dEdR += hfdiag_;
   return localEnergy;
 }
+
+namespace
+{
+/// per walker working matrices of mw_evaluateIonDerivsDeterministicFast
+struct IonDerivWorkspace
+{
+  using ValueMatrix = QMCHamiltonian::ValueMatrix;
+
+  std::vector<ValueMatrix> X;
+  std::vector<ValueMatrix> Minv;
+  std::vector<ValueMatrix> B;
+  std::vector<ValueMatrix> B_gs;
+  std::vector<ValueMatrix> M;
+  std::vector<ValueMatrix> M_gs;
+
+  std::vector<std::vector<ValueMatrix>> dM;
+  std::vector<std::vector<ValueMatrix>> dM_gs;
+  std::vector<std::vector<ValueMatrix>> dB;
+  std::vector<std::vector<ValueMatrix>> dB_gs;
+
+  ParticleSet::ParticlePos pulayterms;
+  ParticleSet::ParticlePos hfdiag;
+
+  IonDerivWorkspace(const TWFFastDerivWrapper& wrapper, const ParticleSet& P, const int nions)
+      : dM(OHMMS_DIM), dM_gs(OHMMS_DIM), dB(OHMMS_DIM), dB_gs(OHMMS_DIM), pulayterms(nions), hfdiag(nions)
+  {
+    const int ngroups = wrapper.numGroups();
+    for (auto* mats : {&X, &Minv, &B, &B_gs, &M, &M_gs})
+      mats->resize(ngroups);
+    for (int idim = 0; idim < OHMMS_DIM; idim++)
+      for (auto* mats : {&dM[idim], &dM_gs[idim], &dB[idim], &dB_gs[idim]})
+        mats->resize(ngroups);
+
+    for (int gid = 0; gid < ngroups; gid++)
+    {
+      const int sid    = wrapper.getTWFGroupIndex(gid);
+      const int norbs  = wrapper.numOrbitals(sid);
+      const int nptcls = P.last(gid) - P.first(gid);
+
+      M[sid].resize(nptcls, norbs);
+      B[sid].resize(nptcls, norbs);
+      M_gs[sid].resize(nptcls, nptcls);
+      Minv[sid].resize(nptcls, nptcls);
+      B_gs[sid].resize(nptcls, nptcls);
+      X[sid].resize(nptcls, nptcls);
+      for (int idim = 0; idim < OHMMS_DIM; idim++)
+      {
+        dM[idim][sid].resize(nptcls, norbs);
+        dB[idim][sid].resize(nptcls, norbs);
+        dM_gs[idim][sid].resize(nptcls, nptcls);
+        dB_gs[idim][sid].resize(nptcls, nptcls);
+      }
+    }
+    for (auto* mats : {&X, &Minv, &B, &B_gs, &M, &M_gs})
+      for (auto& mat : *mats)
+        mat = 0.0;
+    pulayterms = 0.0;
+    hfdiag     = 0.0;
+  }
+};
+} // namespace
+
+std::vector<QMCHamiltonian::FullPrecRealType> QMCHamiltonian::mw_evaluateIonDerivsDeterministicFast(
+    const RefVectorWithLeader<QMCHamiltonian>& ham_list,
+    const RefVectorWithLeader<ParticleSet>& p_list,
+    ParticleSet& ions,
+    const RefVectorWithLeader<TrialWaveFunction>& wf_list,
+    const RefVectorWithLeader<TWFFastDerivWrapper>& wrapper_list,
+    const RefVector<ParticleSet::ParticlePos>& dEdR_list,
+    const RefVector<ParticleSet::ParticlePos>& wf_grad_list)
+{
+  auto& ham_leader = ham_list.getLeader();
+  ScopedTimer local_timer(ham_leader.eval_ion_derivs_fast_timer_);
+  const int nw    = ham_list.size();
+  const int nions = ions.getTotalNum();
+  ParticleSet::mw_update(p_list);
+
+  std::vector<IonDerivWorkspace> work;
+  work.reserve(nw);
+  for (int iw = 0; iw < nw; iw++)
+    work.emplace_back(wrapper_list[iw], p_list[iw], nions);
+
+  std::vector<FullPrecRealType> local_energies(nw, 0.0);
+  for (int iw = 0; iw < nw; iw++)
+  {
+    // the determinants keep the inverse up to date, only invert when they did not register it.
+    // A multideterminant only needs the matrices on all the orbitals.
+    TWFFastDerivWrapper& wrapper = wrapper_list[iw];
+    IonDerivWorkspace& ws        = work[iw];
+    if (wrapper.hasMultiSlaterDet())
+      wrapper.getM(p_list[iw], ws.M);
+    else if (!wrapper.getGroupInverses(ws.Minv))
+    {
+      wrapper.getM(p_list[iw], ws.M);
+      wrapper.getGSMatrices(ws.M, ws.M_gs);
+      wrapper.invertMatrices(ws.M_gs, ws.Minv);
+    }
+  }
+
+  // B-matrices and the Hellmann-Feynman terms in a single pass over the operators
+  for (int i = 0; i < ham_leader.H.size(); ++i)
+    for (int iw = 0; iw < nw; iw++)
+    {
+      OperatorBase& op = *ham_list[iw].H[i];
+      if (op.dependsOnWaveFunction())
+        op.evaluateOneBodyOpMatrix(p_list[iw], wrapper_list[iw], work[iw].B);
+      else
+        local_energies[iw] +=
+            op.evaluateWithIonDerivsDeterministic(p_list[iw], ions, wf_list[iw], work[iw].hfdiag, work[iw].pulayterms);
+    }
+
+  for (int iw = 0; iw < nw; iw++)
+  {
+    TWFFastDerivWrapper& wrapper = wrapper_list[iw];
+    IonDerivWorkspace& ws        = work[iw];
+    RealType nondiag_cont_re     = 0.0;
+    if (wrapper.hasMultiSlaterDet())
+    {
+      TWFFastDerivWrapper::GradType dlogpsi, dO;
+      convertToReal(wrapper.computeMultiDetDerivative(ws.M, ws.B, {}, {}, dlogpsi, dO), nondiag_cont_re);
+    }
+    else
+    {
+      wrapper.getGSMatrices(ws.B, ws.B_gs);
+      convertToReal(wrapper.trAB(ws.Minv, ws.B_gs), nondiag_cont_re);
+      wrapper.buildX(ws.Minv, ws.B_gs, ws.X);
+    }
+    local_energies[iw] += nondiag_cont_re;
+  }
+
+  RefVector<std::vector<std::vector<ValueMatrix>>> dM_list;
+  dM_list.reserve(nw);
+  for (int iw = 0; iw < nw; iw++)
+    dM_list.push_back(work[iw].dM);
+
+  for (int iat = 0; iat < nions; iat++)
+  {
+    std::vector<TWFFastDerivWrapper::GradType> wfgradraw(nw);
+    for (int iw = 0; iw < nw; iw++)
+    {
+      TWFFastDerivWrapper& wrapper = wrapper_list[iw];
+      IonDerivWorkspace& ws        = work[iw];
+      wfgradraw[iw]                = wrapper.evaluateJastrowGradSource(p_list[iw], ions, iat);
+      for (int idim = 0; idim < OHMMS_DIM; idim++)
+      {
+        wrapper.wipeMatrices(ws.dM[idim]);
+        wrapper.wipeMatrices(ws.dM_gs[idim]);
+        wrapper.wipeMatrices(ws.dB[idim]);
+        wrapper.wipeMatrices(ws.dB_gs[idim]);
+      }
+    }
+
+    //ion derivative of the slater matrices of all the walkers at once
+    TWFFastDerivWrapper::mw_getIonGradM(wrapper_list, p_list, ions, iat, dM_list);
+
+    for (int iw = 0; iw < nw; iw++)
+    {
+      TWFFastDerivWrapper& wrapper = wrapper_list[iw];
+      IonDerivWorkspace& ws        = work[iw];
+      for (int i = 0; i < ham_leader.H.size(); ++i)
+        if (ham_list[iw].H[i]->dependsOnWaveFunction())
+          ham_list[iw].H[i]->evaluateOneBodyOpMatrixForceDeriv(p_list[iw], ions, wrapper, iat, ws.dB);
+
+      TWFFastDerivWrapper::GradType dedr_complex;
+      if (wrapper.hasMultiSlaterDet())
+      {
+        TWFFastDerivWrapper::GradType dlogpsi;
+        wrapper.computeMultiDetDerivative(ws.M, ws.B, ws.dM, ws.dB, dlogpsi, dedr_complex);
+        wfgradraw[iw] += dlogpsi;
+      }
+      else
+        for (int idim = 0; idim < OHMMS_DIM; idim++)
+        {
+          wrapper.getGSMatrices(ws.dB[idim], ws.dB_gs[idim]);
+          wrapper.getGSMatrices(ws.dM[idim], ws.dM_gs[idim]);
+          dedr_complex[idim] = wrapper.computeGSDerivative(ws.Minv, ws.X, ws.dM_gs[idim], ws.dB_gs[idim]);
+          wfgradraw[iw][idim] += wrapper.trAB(ws.Minv, ws.dM_gs[idim]);
+        }
+      convertToReal(dedr_complex, dEdR_list[iw].get()[iat]);
+      convertToReal(wfgradraw[iw], wf_grad_list[iw].get()[iat]);
+    }
+  }
+
+  for (int iw = 0; iw < nw; iw++)
+    dEdR_list[iw].get() += work[iw].hfdiag;
+  return local_energies;
+}
 } // namespace qmcplusplus
@@ -217,6 +217,14 @@ public:
   void auxHevaluate(ParticleSet& P);
   void auxHevaluate(ParticleSet& P, Walker_t& ThisWalker);
   void auxHevaluate(ParticleSet& P, Walker_t& ThisWalker, bool do_properties, bool do_collectables);
+  /** batched version of auxHevaluate(P, ThisWalker)
+   *
+   *  each auxiliary operator evaluates the walkers through its mw_evaluate
+   */
+  static void mw_auxHevaluate(const RefVectorWithLeader<QMCHamiltonian>& ham_list,
+                              const RefVectorWithLeader<TrialWaveFunction>& wf_list,
+                              const RefVectorWithLeader<ParticleSet>& p_list,
+                              const RefVector<Walker_t>& walkers);
   void rejectedMove(ParticleSet& P, Walker_t& ThisWalker);
 
   /** set PRIMARY bit of all the components
@@ -303,6 +311,24 @@ public:
                                                       ParticleSet::ParticlePos& dedr,
                                                       ParticleSet::ParticlePos& wf_grad);
 
+  /** batched version of evaluateIonDerivsDeterministicFast
+  *
+  *  The slater matrix inverses registered by the determinants are reused when available.
+  *  The ion derivatives of the slater matrices are evaluated for all the walkers at once, ion by ion.
+  * @param ions source particle set (ions)
+  * @param dEdR_list dedr of each walker
+  * @param wf_grad_list wf_grad of each walker
+  * @return Local energies.
+  */
+  static std::vector<FullPrecRealType> mw_evaluateIonDerivsDeterministicFast(
+      const RefVectorWithLeader<QMCHamiltonian>& ham_list,
+      const RefVectorWithLeader<ParticleSet>& p_list,
+      ParticleSet& ions,
+      const RefVectorWithLeader<TrialWaveFunction>& wf_list,
+      const RefVectorWithLeader<TWFFastDerivWrapper>& wrapper_list,
+      const RefVector<ParticleSet::ParticlePos>& dEdR_list,
+      const RefVector<ParticleSet::ParticlePos>& wf_grad_list);
+
   /** Evaluate the electron gradient of the local energy.
   * @param psi Trial Wave Function
   * @param P electron particle set
@@ -488,6 +514,7 @@ private:
   void reportToListeners();
   // helper function for extracting a list of Hamiltonian components from a list of QMCHamiltonian::H.
   static RefVectorWithLeader<OperatorBase> extract_HC_list(const RefVectorWithLeader<QMCHamiltonian>& ham_list, int id);
+  static RefVectorWithLeader<OperatorBase> extract_auxH_list(const RefVectorWithLeader<QMCHamiltonian>& ham_list, int id);
 
 #if !defined(REMOVE_TRACEMANAGER)
   ///traces variables
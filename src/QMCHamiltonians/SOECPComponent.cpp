@@ -24,8 +24,6 @@ SOECPComponent::SOECPComponent()
 
 SOECPComponent::~SOECPComponent()
 {
-  for (int i = 0; i < sopp_m_.size(); i++)
-    delete sopp_m_[i];
   if (VP_)
     delete VP_;
 }
@@ -50,14 +48,13 @@ void SOECPComponent::deleteVirtualParticle()
 void SOECPComponent::add(int l, RadialPotentialType* pp)
 {
   angpp_m_.push_back(l);
-  sopp_m_.push_back(pp);
+  sopp_m_.emplace_back(pp);
 }
 
 SOECPComponent* SOECPComponent::makeClone(const ParticleSet& qp)
 {
+  // the radial tables are shared, only the work arrays and the virtual particles are per clone
   SOECPComponent* myclone = new SOECPComponent(*this);
-  for (int i = 0; i < sopp_m_.size(); i++)
-    myclone->sopp_m_[i] = sopp_m_[i]->makeClone();
   if (VP_)
     myclone->VP_ = new VirtualParticleSet(qp, total_knots_);
   return myclone;
@@ -162,6 +159,11 @@ SOECPComponent::RealType SOECPComponent::evaluateOne(ParticleSet& W,
       Psi.resetPhaseDiff();
     }
 
+  return calculateProjector(dr, sold);
+}
+
+SOECPComponent::RealType SOECPComponent::calculateProjector(const PosType& dr, const RealType sold)
+{
   ComplexType pairpot;
   for (int iq = 0; iq < total_knots_; iq++)
   {
@@ -190,6 +192,80 @@ SOECPComponent::RealType SOECPComponent::evaluateOne(ParticleSet& W,
   return std::real(pairpot);
 }
 
+void SOECPComponent::mw_evaluateOne(const RefVectorWithLeader<SOECPComponent>& soecp_component_list,
+                                    const RefVectorWithLeader<ParticleSet>& p_list,
+                                    const RefVectorWithLeader<TrialWaveFunction>& psi_list,
+                                    const RefVector<const NLPPJob<RealType>>& joblist,
+                                    std::vector<RealType>& pairpots,
+                                    ResourceCollection& collection)
+{
+  auto& soecp_component_leader = soecp_component_list.getLeader();
+  for (size_t i = 0; i < soecp_component_list.size(); i++)
+  {
+    SOECPComponent& component(soecp_component_list[i]);
+    const NLPPJob<RealType>& job = joblist[i];
+    for (int ip = 0; ip < component.nchannel_; ip++)
+      component.vrad_[ip] = component.sopp_m_[ip]->splint(job.ion_elec_dist);
+    component.buildTotalQuadrature(job.ion_elec_dist, job.ion_elec_displ, p_list[i].spins[job.electron_id]);
+  }
+
+  if (soecp_component_leader.VP_)
+  {
+    // Compute ratios with VP
+    RefVectorWithLeader<VirtualParticleSet> vp_list(*soecp_component_leader.VP_);
+    RefVectorWithLeader<const VirtualParticleSet> const_vp_list(*soecp_component_leader.VP_);
+    RefVector<const std::vector<PosType>> deltaV_list;
+    RefVector<const std::vector<RealType>> deltaS_list;
+    RefVector<std::vector<ValueType>> psiratios_list;
+    vp_list.reserve(soecp_component_list.size());
+    const_vp_list.reserve(soecp_component_list.size());
+    deltaV_list.reserve(soecp_component_list.size());
+    deltaS_list.reserve(soecp_component_list.size());
+    psiratios_list.reserve(soecp_component_list.size());
+
+    for (size_t i = 0; i < soecp_component_list.size(); i++)
+    {
+      SOECPComponent& component(soecp_component_list[i]);
+      vp_list.push_back(*component.VP_);
+      const_vp_list.push_back(*component.VP_);
+      deltaV_list.push_back(component.deltaV_);
+      deltaS_list.push_back(component.deltaS_);
+      psiratios_list.push_back(component.psiratio_);
+    }
+
+    ResourceCollectionTeamLock<VirtualParticleSet> vp_res_lock(collection, vp_list);
+
+    VirtualParticleSet::mw_makeMovesWithSpin(vp_list, p_list, deltaV_list, deltaS_list, joblist, true);
+
+    TrialWaveFunction::mw_evaluateRatios(psi_list, const_vp_list, psiratios_list);
+  }
+  else
+  {
+    // Compute ratios without VP. This is working but very slow code path.
+    for (size_t i = 0; i < p_list.size(); i++)
+    {
+      SOECPComponent& component(soecp_component_list[i]);
+      ParticleSet& W(p_list[i]);
+      TrialWaveFunction& psi(psi_list[i]);
+      const NLPPJob<RealType>& job = joblist[i];
+      for (int iq = 0; iq < component.total_knots_; iq++)
+      {
+        W.makeMoveWithSpin(job.electron_id, component.deltaV_[iq], component.deltaS_[iq]);
+        component.psiratio_[iq] = psi.calcRatio(W, job.electron_id);
+        W.rejectMove(job.electron_id);
+        psi.resetPhaseDiff();
+      }
+    }
+  }
+
+  for (size_t i = 0; i < p_list.size(); i++)
+  {
+    SOECPComponent& component(soecp_component_list[i]);
+    const NLPPJob<RealType>& job = joblist[i];
+    pairpots[i] = component.calculateProjector(job.ion_elec_displ, p_list[i].spins[job.electron_id]);
+  }
+}
+
 SOECPComponent::RealType SOECPComponent::evaluateValueAndDerivatives(ParticleSet& W,
                                                                      int iat,
                                                                      TrialWaveFunction& Psi,
@@ -16,10 +16,12 @@
 #include "QMCHamiltonians/OperatorBase.h"
 #include "QMCHamiltonians/RandomRotationMatrix.h"
 #include "QMCWaveFunctions/TrialWaveFunction.h"
+#include <ResourceCollection.h>
 #include "Numerics/OneDimGridBase.h"
 #include "Numerics/OneDimGridFunctor.h"
 #include "Numerics/OneDimLinearSpline.h"
 #include "Numerics/OneDimCubicSpline.h"
+#include "NLPPJob.h"
 
 namespace qmcplusplus
 {
@@ -49,8 +51,8 @@ private:
   RealType Rmax_;
   ///Angular momentum map
   aligned_vector<int> angpp_m_;
-  ///Non-Local part of the pseudo-potential
-  std::vector<RadialPotentialType*> sopp_m_;
+  ///Non-Local part of the pseudo-potential, read only and shared by all the clones
+  std::vector<std::shared_ptr<const RadialPotentialType>> sopp_m_;
 
   ComplexType sMatrixElements(RealType s1, RealType s2, int dim);
   ComplexType lmMatrixElements(int l, int m1, int m2, int dim);
@@ -79,6 +81,11 @@ private:
   // s0q0, s0q1, ..., s0qM, s1q0, ..., sNq0, ..., sNqM for each of the deltaS_, deltaV_, and spin_quad_weights_
   void buildTotalQuadrature(const RealType r, const PosType& dr, const RealType sold);
 
+  /** sum the spin-orbit projector over the spin and spatial quadrature points
+   *  using psiratio_ and vrad_ of the current electron-ion pair
+   */
+  RealType calculateProjector(const PosType& dr, const RealType sold);
+
 public:
   SOECPComponent();
   ~SOECPComponent();
@@ -108,6 +115,26 @@ public:
    */
   RealType evaluateOne(ParticleSet& W, int iat, TrialWaveFunction& Psi, int iel, RealType r, const PosType& dr);
 
+  /** @brief Evaluate the spin orbit pp contribution of one electron-ion pair for a batch of walkers.
+   *
+   * The spin and spatial quadrature points of all the pairs are moved with a single
+   * multi walker virtual particle set move and the spinor ratios are computed in one
+   * multi walker call.
+   *
+   * @param soecp_component_list the components of the ions, one per walker
+   * @param p_list electron particle sets
+   * @param psi_list trial wave functions
+   * @param joblist electron-ion pairs, one per walker
+   * @param pairpots the contributions of the pairs
+   * @param collection resources of the virtual particle sets
+   */
+  static void mw_evaluateOne(const RefVectorWithLeader<SOECPComponent>& soecp_component_list,
+                             const RefVectorWithLeader<ParticleSet>& p_list,
+                             const RefVectorWithLeader<TrialWaveFunction>& psi_list,
+                             const RefVector<const NLPPJob<RealType>>& joblist,
+                             std::vector<RealType>& pairpots,
+                             ResourceCollection& collection);
+
   RealType evaluateValueAndDerivatives(ParticleSet& P,
                                        int iat,
                                        TrialWaveFunction& psi,
@@ -122,6 +149,7 @@ public:
 
   void initVirtualParticle(const ParticleSet& qp);
   void deleteVirtualParticle();
+  const VirtualParticleSet* getVP() const { return VP_; }
 
   inline void setRmax(RealType rmax) { Rmax_ = rmax; }
   inline RealType getRmax() const { return Rmax_; }
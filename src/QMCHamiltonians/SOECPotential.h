@@ -19,8 +19,11 @@ namespace qmcplusplus
 {
 class SOECPotential : public OperatorBase
 {
+  struct SOECPotentialMultiWalkerResource;
+
 public:
   SOECPotential(ParticleSet& ions, ParticleSet& els, TrialWaveFunction& psi);
+  ~SOECPotential() override;
 
   bool dependsOnWaveFunction() const override { return true; }
   std::string getClassName() const override { return "SOECPotential"; }
@@ -28,6 +31,10 @@ public:
 
   Return_t evaluate(ParticleSet& P) override;
 
+  void mw_evaluate(const RefVectorWithLeader<OperatorBase>& o_list,
+                   const RefVectorWithLeader<TrialWaveFunction>& wf_list,
+                   const RefVectorWithLeader<ParticleSet>& p_list) const override;
+
   Return_t evaluateValueAndDerivatives(ParticleSet& P,
                                        const opt_variables_type& optvars,
                                        const Vector<ValueType>& dlogpsi,
@@ -41,6 +48,18 @@ public:
     return true;
   }
 
+  /** initialize a shared resource and hand it to a collection
+   */
+  void createResource(ResourceCollection& collection) const override;
+
+  /** acquire a shared resource from a collection
+   */
+  void acquireResource(ResourceCollection& collection, const RefVectorWithLeader<OperatorBase>& o_list) const override;
+
+  /** return a shared resource to a collection
+   */
+  void releaseResource(ResourceCollection& collection, const RefVectorWithLeader<OperatorBase>& o_list) const override;
+
   std::unique_ptr<OperatorBase> makeClone(ParticleSet& qp, TrialWaveFunction& psi) final;
 
   void addComponent(int groupID, std::unique_ptr<SOECPComponent>&& pp);
@@ -65,6 +84,10 @@ private:
   NeighborLists ElecNeighborIons;
   ///neighborlist of ions
   NeighborLists IonNeighborElecs;
+  ///electron-ion pairs within the cutoff, per electron group
+  std::vector<std::vector<NLPPJob<RealType>>> sopp_jobs_;
+  ///multi walker shared resource
+  std::unique_ptr<SOECPotentialMultiWalkerResource> mw_res_;
 };
 } // namespace qmcplusplus
 
@@ -15,41 +15,50 @@ SpaceWarpTransformation::RealType SpaceWarpTransformation::f(RealType r) { retur
 SpaceWarpTransformation::RealType SpaceWarpTransformation::df(RealType r) { return -swpow * std::pow(r, -(swpow + 1)); }
 //Space warp functions have the form w_I(r_i) = F(|r_i-R_I)/Sum_J F(|r_i-R_J|).  Hence the intermediate we will
 //precompute is the matrix "warpval[i][J] = F(|r_i-R_J|) and gradval[i][J]=Grad(F(|r_i-R_J|)).
-//This allows the calculation of any space warp value or gradient by a matrix lookup, combined with a sum over columns.
+//The row sums over ions are then taken once per electron and both matrices are normalized in place,
+//so that warpval[i][J] = w_J(r_i) and gradval[i][J] = Grad_i(w_J(r_i)) for all the ions at once.
 void SpaceWarpTransformation::computeSWTIntermediates(ParticleSet& P, const ParticleSet& ions)
 {
   const auto& d_ab(P.getDistTableAB(myTableIndex));
   for (size_t iel = 0; iel < Nelec; ++iel)
   {
-    const auto& dist = d_ab.getDistRow(iel);
-    const auto& dr   = d_ab.getDisplRow(iel);
+    const auto& dist        = d_ab.getDistRow(iel);
+    const auto& dr          = d_ab.getDisplRow(iel);
+    RealType* restrict w    = warpval[iel];
+    PosType* restrict gradw = gradval[iel];
+    RealType warpdenom      = 0.0;
+    PosType denomgrad       = 0.0;
     for (size_t ionid = 0; ionid < Nions; ++ionid)
     {
-      warpval[iel][ionid] = f(dist[ionid]);
-      gradval[iel][ionid] = -dr[ionid] *
+      w[ionid]     = f(dist[ionid]);
+      gradw[ionid] = -dr[ionid] *
           (df(dist[ionid]) / dist[ionid]); //because there's a -1 in distance table displacement definition.  R-r :(.
+      warpdenom += w[ionid];
+      denomgrad += gradw[ionid];
+    }
+    const RealType invdenom = 1.0 / warpdenom;
+    denomgrad *= invdenom;
+    for (size_t ionid = 0; ionid < Nions; ++ionid)
+    {
+      w[ionid] *= invdenom;
+      gradw[ionid] = gradw[ionid] * invdenom - w[ionid] * denomgrad;
     }
   }
 }
 
-//This function handles parsing of the intermediate matrices and construction of the w_I(r_i) and Grad_i(w_I(r_i)) functions
-// that appear in the space warp transformation formulas.
+//This function extracts the w_I(r_i) and Grad_i(w_I(r_i)) functions that appear in the space warp transformation
+//formulas from the normalized intermediate matrices.
 void SpaceWarpTransformation::getSWT(int iat, ParticleScalar& w, Force_t& grad_w)
 {
   for (size_t iel = 0; iel < Nelec; iel++)
   {
-    RealType warpdenom = 0.0;
-    PosType denomgrad  = 0.0;
-    for (size_t ionid = 0; ionid < Nions; ionid++)
-    {
-      warpdenom += warpval[iel][ionid];
-      denomgrad += gradval[iel][ionid];
-    }
-    w[iel]      = warpval[iel][iat] / warpdenom;
-    grad_w[iel] = gradval[iel][iat] / warpdenom - w[iel] * denomgrad / warpdenom;
+    w[iel]      = warpval[iel][iat];
+    grad_w[iel] = gradval[iel][iat];
   }
 }
 //This function returns Sum_i w_I(r_i) Grad_i(E_L) (as el_contribution)  and Sum_i[ w_I(r_i)Grad_i(logpsi)+0.5*Grad_i(w_I(r_i)) (as psi_contribution).  See Eq (15) and (16) respectively.
+//Both are products of the transposed Nelec x Nion warp matrices with per electron vectors, accumulated row by row
+//so that the inner loop runs contiguously over the ions.
 void SpaceWarpTransformation::computeSWT(ParticleSet& P,
                                          const ParticleSet& ions,
                                          Force_t& dEl,
@@ -59,29 +68,23 @@ void SpaceWarpTransformation::computeSWT(ParticleSet& P,
 {
   el_contribution  = 0;
   psi_contribution = 0;
-  ParticleScalar w;
-  Force_t gradw;
-  w.resize(Nelec);
-  gradw.resize(Nelec);
 
   PosType gwfn = 0;
   computeSWTIntermediates(P, ions);
 
-  for (size_t iat = 0; iat < Nions; iat++)
+  for (size_t iel = 0; iel < Nelec; iel++)
   {
-    w     = 0;
-    gradw = 0;
-    getSWT(iat, w, gradw);
-    for (size_t iel = 0; iel < Nelec; iel++)
-    {
-      el_contribution[iat] += w[iel] * dEl[iel];
-
 #if defined(QMC_COMPLEX)
-      convertToReal(dlogpsi[iel], gwfn);
+    convertToReal(dlogpsi[iel], gwfn);
 #else
-      gwfn = dlogpsi[iel];
+    gwfn = dlogpsi[iel];
 #endif
-      psi_contribution[iat] += w[iel] * gwfn + 0.5 * gradw[iel];
+    const RealType* restrict w    = warpval[iel];
+    const PosType* restrict gradw = gradval[iel];
+    for (size_t iat = 0; iat < Nions; iat++)
+    {
+      el_contribution[iat] += w[iat] * dEl[iel];
+      psi_contribution[iat] += w[iat] * gwfn + 0.5 * gradw[iat];
     }
   }
   //REMOVE ME
@@ -52,8 +52,8 @@ public:
    */
   inline void setPow(RealType swpow_in) { swpow = swpow_in; };
 
-  /** Generates required space warp quantities to generate the actual "Space Warp" contribution to the
-   *  iat-th force component.
+  /** Extracts the space warp quantities of the iat-th force component from the intermediates
+   *  built by the last computeSWT call.
    *  \param[in] iat the ion index for the force.  
    *  \param[out] w, w_iat(r_i) for each i, where i is the electron index. 
    *  \param[out] grad_w,  grad_i w_iat(r_i) for each i, where i is the electron index.
@@ -79,7 +79,7 @@ public:
 
 private:
   /** Computes intermediate matrices required to build all space warp components and gradients.
-   *  The intermediates calculated are "warpval" and "gradval".
+   *  The intermediates calculated are "warpval" and "gradval", normalized over the ions.
    *
    * \param[in] P, the electron particle set.  
    * \param[in] ions, the ion particle set.  
@@ -94,9 +94,9 @@ private:
 
   /// Power of space warp transformation.  Right now, r^{-swpow}.
   RealType swpow;
-  /// Nelec x Nion matrix of F(|r_i-R_J|)
+  /// Nelec x Nion matrix of w_J(r_i) = F(|r_i-R_J|)/Sum_K F(|r_i-R_K|)
   Matrix<RealType> warpval;
-  /// Nelec x Nion matrix of \nabla_i F(|r_i-R_J|)
+  /// Nelec x Nion matrix of \nabla_i w_J(r_i)
   Matrix<PosType> gradval;
 };
 } // namespace qmcplusplus
@@ -578,6 +578,48 @@ TEST_CASE("Evaluate_soecp", "[hamiltonian]")
     test_evaluateOne();
   }
 
+  {
+    //test the batched evaluation against evaluateOne on a second walker
+    sopp->initVirtualParticle(elec);
+    ParticleSet elec2(elec);
+    elec2.R[0]  = {0.12, -0.2, 0.25};
+    elec2.spins = {0.35, 0.6};
+    elec2.update();
+    auto psi2 = psi.makeClone(elec2);
+    psi2->evaluateLog(elec2);
+    std::unique_ptr<SOECPComponent> sopp2(sopp->makeClone(elec2));
+
+    RefVectorWithLeader<ParticleSet> p_list(elec, {elec, elec2});
+    RefVectorWithLeader<TrialWaveFunction> psi_list(psi, {psi, *psi2});
+    RefVectorWithLeader<SOECPComponent> sopp_list(*sopp, {*sopp, *sopp2});
+
+    std::vector<RealType> values_ref(2, 0.0);
+    std::vector<RealType> values(2, 0.0);
+    std::vector<RealType> pairpots(2);
+    ResourceCollection vp_res("test_vp_res");
+    sopp->getVP()->createResource(vp_res);
+    for (int jel = 0; jel < elec.getTotalNum(); jel++)
+    {
+      std::vector<NLPPJob<RealType>> jobs;
+      for (int iw = 0; iw < 2; iw++)
+      {
+        const auto& table = p_list[iw].getDistTableAB(myTableIndex);
+        const auto& dist  = table.getDistRow(jel);
+        const auto& displ = table.getDisplRow(jel);
+        jobs.emplace_back(0, jel, dist[0], RealType(-1) * displ[0]);
+        values_ref[iw] += sopp_list[iw].evaluateOne(p_list[iw], 0, psi_list[iw], jel, dist[0], jobs[iw].ion_elec_displ);
+      }
+      RefVector<const NLPPJob<RealType>> job_list{jobs[0], jobs[1]};
+      SOECPComponent::mw_evaluateOne(sopp_list, p_list, psi_list, job_list, pairpots, vp_res);
+      for (int iw = 0; iw < 2; iw++)
+        values[iw] += pairpots[iw];
+    }
+    CHECK(values[0] == Approx(-3.530511241));
+    CHECK(values[0] == Approx(values_ref[0]));
+    CHECK(values[1] == Approx(values_ref[1]));
+    sopp->deleteVirtualParticle();
+  }
+
   //Check evaluateValueAndDerivatives
   opt_variables_type optvars;
   Vector<ValueType> dlogpsi;
@@ -532,56 +532,53 @@ TEST_CASE("Eloc_Derivatives:multislater_noj", "[hamiltonian]")
   convertToReal(wfgradraw[0], wf_grad[0]);
   convertToReal(wfgradraw[1], wf_grad[1]);
 
-  //This is not implemented yet.  Uncomment to perform check after implementation.
   //Reference from finite differences on this configuration.
-  /*  CHECK( wf_grad[0][0] == Approx(-1.7045200053189544));
-  CHECK( wf_grad[0][1] == Approx( 2.6980932676501368)); 
-  CHECK( wf_grad[0][2] == Approx( 6.5358393587011667)); 
-  CHECK( wf_grad[1][0] == Approx( 1.6322817486980055)); 
-  CHECK( wf_grad[1][1] == Approx( 0.0091648450606385));
-  CHECK( wf_grad[1][2] == Approx( 0.1031883398283639)); */
-
+  CHECK(wf_grad[0][0] == Approx(-1.7045200053189544));
+  CHECK(wf_grad[0][1] == Approx(2.6980932676501368));
+  CHECK(wf_grad[0][2] == Approx(6.5358393587011667));
+  CHECK(wf_grad[1][0] == Approx(1.6322817486980055));
+  CHECK(wf_grad[1][1] == Approx(0.0091648450606385));
+  CHECK(wf_grad[1][2] == Approx(0.1031883398283639));
 
-  //This is not implemented yet.  Uncomment to perform check after implementation.
   //Kinetic Force
-  /*  hf_term=0.0;
-  pulay_term=0.0;
+  hf_term    = 0.0;
+  pulay_term = 0.0;
   (ham.getHamiltonian(KINETIC))->evaluateWithIonDerivsDeterministic(elec, ions, *psi, hf_term, pulay_term);
-#if defined(MIXED_PRECISION) 
-  CHECK( hf_term[0][0]+pulay_term[0][0] == Approx( 7.4631825180304636).epsilon(1e-4));
-  CHECK( hf_term[0][1]+pulay_term[0][1] == Approx( 26.0975954772035799).epsilon(1e-4));
-  CHECK( hf_term[0][2]+pulay_term[0][2] == Approx( 90.1646424427582218).epsilon(1e-4));
-  CHECK( hf_term[1][0]+pulay_term[1][0] == Approx( 3.8414153131327562).epsilon(1e-4));
-  CHECK( hf_term[1][1]+pulay_term[1][1] == Approx(-2.3504392874684754).epsilon(1e-4));
-  CHECK( hf_term[1][2]+pulay_term[1][2] == Approx( 4.7454048248241065) .epsilon(1e-4));
+#if defined(MIXED_PRECISION)
+  CHECK(hf_term[0][0] + pulay_term[0][0] == Approx(7.4631825180304636).epsilon(1e-4));
+  CHECK(hf_term[0][1] + pulay_term[0][1] == Approx(26.0975954772035799).epsilon(1e-4));
+  CHECK(hf_term[0][2] + pulay_term[0][2] == Approx(90.1646424427582218).epsilon(1e-4));
+  CHECK(hf_term[1][0] + pulay_term[1][0] == Approx(3.8414153131327562).epsilon(1e-4));
+  CHECK(hf_term[1][1] + pulay_term[1][1] == Approx(-2.3504392874684754).epsilon(1e-4));
+  CHECK(hf_term[1][2] + pulay_term[1][2] == Approx(4.7454048248241065).epsilon(1e-4));
 #else
-  CHECK( hf_term[0][0]+pulay_term[0][0] == Approx( 7.4631825180304636));
-  CHECK( hf_term[0][1]+pulay_term[0][1] == Approx( 26.0975954772035799));
-  CHECK( hf_term[0][2]+pulay_term[0][2] == Approx( 90.1646424427582218));
-  CHECK( hf_term[1][0]+pulay_term[1][0] == Approx( 3.8414153131327562));
-  CHECK( hf_term[1][1]+pulay_term[1][1] == Approx(-2.3504392874684754));
-  CHECK( hf_term[1][2]+pulay_term[1][2] == Approx( 4.7454048248241065)); 
-#endif */
-  //This is not implemented yet.  Uncomment to perform check after implementation.
+  CHECK(hf_term[0][0] + pulay_term[0][0] == Approx(7.4631825180304636));
+  CHECK(hf_term[0][1] + pulay_term[0][1] == Approx(26.0975954772035799));
+  CHECK(hf_term[0][2] + pulay_term[0][2] == Approx(90.1646424427582218));
+  CHECK(hf_term[1][0] + pulay_term[1][0] == Approx(3.8414153131327562));
+  CHECK(hf_term[1][1] + pulay_term[1][1] == Approx(-2.3504392874684754));
+  CHECK(hf_term[1][2] + pulay_term[1][2] == Approx(4.7454048248241065));
+#endif
   //NLPP Force
-  /*  hf_term=0.0;
-  pulay_term=0.0;
-  double val=(ham.getHamiltonian(NONLOCALECP))->evaluateWithIonDerivsDeterministic(elec, ions, *psi, hf_term, pulay_term);
+  hf_term    = 0.0;
+  pulay_term = 0.0;
+  double val =
+      (ham.getHamiltonian(NONLOCALECP))->evaluateWithIonDerivsDeterministic(elec, ions, *psi, hf_term, pulay_term);
 #if defined(MIXED_PRECISION)
-  CHECK( hf_term[0][0]+pulay_term[0][0] == Approx( 18.9414437404167302).epsilon(2e-4));
-  CHECK( hf_term[0][1]+pulay_term[0][1] == Approx(-42.9017371899931277).epsilon(2e-4));
-  CHECK( hf_term[0][2]+pulay_term[0][2] == Approx(-78.3304792483008328).epsilon(2e-4));
-  CHECK( hf_term[1][0]+pulay_term[1][0] == Approx( 1.2122162598160457).epsilon(2e-4));
-  CHECK( hf_term[1][1]+pulay_term[1][1] == Approx(-0.6163169101291999).epsilon(2e-4));
-  CHECK( hf_term[1][2]+pulay_term[1][2] == Approx(-3.2996553033015625).epsilon(2e-4));
+  CHECK(hf_term[0][0] + pulay_term[0][0] == Approx(18.9414437404167302).epsilon(2e-4));
+  CHECK(hf_term[0][1] + pulay_term[0][1] == Approx(-42.9017371899931277).epsilon(2e-4));
+  CHECK(hf_term[0][2] + pulay_term[0][2] == Approx(-78.3304792483008328).epsilon(2e-4));
+  CHECK(hf_term[1][0] + pulay_term[1][0] == Approx(1.2122162598160457).epsilon(2e-4));
+  CHECK(hf_term[1][1] + pulay_term[1][1] == Approx(-0.6163169101291999).epsilon(2e-4));
+  CHECK(hf_term[1][2] + pulay_term[1][2] == Approx(-3.2996553033015625).epsilon(2e-4));
 #else
-  CHECK( hf_term[0][0]+pulay_term[0][0] == Approx( 18.9414437404167302));
-  CHECK( hf_term[0][1]+pulay_term[0][1] == Approx(-42.9017371899931277));
-  CHECK( hf_term[0][2]+pulay_term[0][2] == Approx(-78.3304792483008328));
-  CHECK( hf_term[1][0]+pulay_term[1][0] == Approx( 1.2122162598160457));
-  CHECK( hf_term[1][1]+pulay_term[1][1] == Approx(-0.6163169101291999));
-  CHECK( hf_term[1][2]+pulay_term[1][2] == Approx(-3.2996553033015625));
-#endif */
+  CHECK(hf_term[0][0] + pulay_term[0][0] == Approx(18.9414437404167302));
+  CHECK(hf_term[0][1] + pulay_term[0][1] == Approx(-42.9017371899931277));
+  CHECK(hf_term[0][2] + pulay_term[0][2] == Approx(-78.3304792483008328));
+  CHECK(hf_term[1][0] + pulay_term[1][0] == Approx(1.2122162598160457));
+  CHECK(hf_term[1][1] + pulay_term[1][1] == Approx(-0.6163169101291999));
+  CHECK(hf_term[1][2] + pulay_term[1][2] == Approx(-3.2996553033015625));
+#endif
 }
 
 TEST_CASE("Eloc_Derivatives:multislater_wj", "[hamiltonian]")
@@ -671,55 +668,121 @@ TEST_CASE("Eloc_Derivatives:multislater_wj", "[hamiltonian]")
   convertToReal(wfgradraw[0], wf_grad[0]);
   convertToReal(wfgradraw[1], wf_grad[1]);
 
-  //This is not implemented yet.  Uncomment to perform check after implementation.
   //Reference from finite differences on this configuration.
-  /*  CHECK( wf_grad[0][0] == Approx(-1.7052805961093040));
-  CHECK( wf_grad[0][1] == Approx( 2.8914116872336133)); 
-  CHECK( wf_grad[0][2] == Approx( 7.3963610874194776)); 
-  CHECK( wf_grad[1][0] == Approx( 2.0450537814298286)); 
-  CHECK( wf_grad[1][1] == Approx( 0.0742023428479399));
-  CHECK( wf_grad[1][2] == Approx(-1.6411356565271260)); */
+  CHECK(wf_grad[0][0] == Approx(-1.7052805961093040));
+  CHECK(wf_grad[0][1] == Approx(2.8914116872336133));
+  CHECK(wf_grad[0][2] == Approx(7.3963610874194776));
+  CHECK(wf_grad[1][0] == Approx(2.0450537814298286));
+  CHECK(wf_grad[1][1] == Approx(0.0742023428479399));
+  CHECK(wf_grad[1][2] == Approx(-1.6411356565271260));
 
-  //This is not implemented yet.  Uncomment to perform check after implementation.
   //Kinetic Force
-  /*  hf_term=0.0;
-  pulay_term=0.0;
+  hf_term    = 0.0;
+  pulay_term = 0.0;
   (ham.getHamiltonian(KINETIC))->evaluateWithIonDerivsDeterministic(elec, ions, *psi, hf_term, pulay_term);
 #if defined(MIXED_PRECISION)
-  CHECK( hf_term[0][0]+pulay_term[0][0] == Approx(  4.1783687883878429).epsilon(1e-4));
-  CHECK( hf_term[0][1]+pulay_term[0][1] == Approx( 32.2193450745800192).epsilon(1e-4));
-  CHECK( hf_term[0][2]+pulay_term[0][2] == Approx(102.0214857307521896).epsilon(1e-4));
-  CHECK( hf_term[1][0]+pulay_term[1][0] == Approx(  4.5063296809644271).epsilon(1e-4));
-  CHECK( hf_term[1][1]+pulay_term[1][1] == Approx( -2.3360060461996568).epsilon(1e-4));
-  CHECK( hf_term[1][2]+pulay_term[1][2] == Approx(  2.9502526588842666).epsilon(1e-4));
+  CHECK(hf_term[0][0] + pulay_term[0][0] == Approx(4.1783687883878429).epsilon(1e-4));
+  CHECK(hf_term[0][1] + pulay_term[0][1] == Approx(32.2193450745800192).epsilon(1e-4));
+  CHECK(hf_term[0][2] + pulay_term[0][2] == Approx(102.0214857307521896).epsilon(1e-4));
+  CHECK(hf_term[1][0] + pulay_term[1][0] == Approx(4.5063296809644271).epsilon(1e-4));
+  CHECK(hf_term[1][1] + pulay_term[1][1] == Approx(-2.3360060461996568).epsilon(1e-4));
+  CHECK(hf_term[1][2] + pulay_term[1][2] == Approx(2.9502526588842666).epsilon(1e-4));
 #else
-  CHECK( hf_term[0][0]+pulay_term[0][0] == Approx(  4.1783687883878429));
-  CHECK( hf_term[0][1]+pulay_term[0][1] == Approx( 32.2193450745800192));
-  CHECK( hf_term[0][2]+pulay_term[0][2] == Approx(102.0214857307521896));
-  CHECK( hf_term[1][0]+pulay_term[1][0] == Approx(  4.5063296809644271));
-  CHECK( hf_term[1][1]+pulay_term[1][1] == Approx( -2.3360060461996568));
-  CHECK( hf_term[1][2]+pulay_term[1][2] == Approx(  2.9502526588842666)); 
-#endif */
-  //This is not implemented yet.  Uncomment to perform check after implementation.
+  CHECK(hf_term[0][0] + pulay_term[0][0] == Approx(4.1783687883878429));
+  CHECK(hf_term[0][1] + pulay_term[0][1] == Approx(32.2193450745800192));
+  CHECK(hf_term[0][2] + pulay_term[0][2] == Approx(102.0214857307521896));
+  CHECK(hf_term[1][0] + pulay_term[1][0] == Approx(4.5063296809644271));
+  CHECK(hf_term[1][1] + pulay_term[1][1] == Approx(-2.3360060461996568));
+  CHECK(hf_term[1][2] + pulay_term[1][2] == Approx(2.9502526588842666));
+#endif
   //NLPP Force
-  /*  hf_term=0.0;
-  pulay_term=0.0;
-  double val=(ham.getHamiltonian(NONLOCALECP))->evaluateWithIonDerivsDeterministic(elec, ions, *psi, hf_term, pulay_term);
+  hf_term    = 0.0;
+  pulay_term = 0.0;
+  double val =
+      (ham.getHamiltonian(NONLOCALECP))->evaluateWithIonDerivsDeterministic(elec, ions, *psi, hf_term, pulay_term);
 #if defined(MIXED_PRECISION)
-  CHECK( hf_term[0][0]+pulay_term[0][0] == Approx( 21.6829856774403140).epsilon(2e-4));
-  CHECK( hf_term[0][1]+pulay_term[0][1] == Approx(-43.4432406419382673).epsilon(2e-4));
-  CHECK( hf_term[0][2]+pulay_term[0][2] == Approx(-80.1356331911584618).epsilon(2e-4));
-  CHECK( hf_term[1][0]+pulay_term[1][0] == Approx(  0.9915030925178313).epsilon(2e-4));
-  CHECK( hf_term[1][1]+pulay_term[1][1] == Approx( -0.6012127592214256).epsilon(2e-4));
-  CHECK( hf_term[1][2]+pulay_term[1][2] == Approx( -2.7937129314814508).epsilon(2e-4));
+  CHECK(hf_term[0][0] + pulay_term[0][0] == Approx(21.6829856774403140).epsilon(2e-4));
+  CHECK(hf_term[0][1] + pulay_term[0][1] == Approx(-43.4432406419382673).epsilon(2e-4));
+  CHECK(hf_term[0][2] + pulay_term[0][2] == Approx(-80.1356331911584618).epsilon(2e-4));
+  CHECK(hf_term[1][0] + pulay_term[1][0] == Approx(0.9915030925178313).epsilon(2e-4));
+  CHECK(hf_term[1][1] + pulay_term[1][1] == Approx(-0.6012127592214256).epsilon(2e-4));
+  CHECK(hf_term[1][2] + pulay_term[1][2] == Approx(-2.7937129314814508).epsilon(2e-4));
 #else
-  CHECK( hf_term[0][0]+pulay_term[0][0] == Approx( 21.6829856774403140));
-  CHECK( hf_term[0][1]+pulay_term[0][1] == Approx(-43.4432406419382673));
-  CHECK( hf_term[0][2]+pulay_term[0][2] == Approx(-80.1356331911584618));
-  CHECK( hf_term[1][0]+pulay_term[1][0] == Approx(  0.9915030925178313));
-  CHECK( hf_term[1][1]+pulay_term[1][1] == Approx( -0.6012127592214256));
-  CHECK( hf_term[1][2]+pulay_term[1][2] == Approx( -2.7937129314814508)); 
-#endif */
+  CHECK(hf_term[0][0] + pulay_term[0][0] == Approx(21.6829856774403140));
+  CHECK(hf_term[0][1] + pulay_term[0][1] == Approx(-43.4432406419382673));
+  CHECK(hf_term[0][2] + pulay_term[0][2] == Approx(-80.1356331911584618));
+  CHECK(hf_term[1][0] + pulay_term[1][0] == Approx(0.9915030925178313));
+  CHECK(hf_term[1][1] + pulay_term[1][1] == Approx(-0.6012127592214256));
+  CHECK(hf_term[1][2] + pulay_term[1][2] == Approx(-2.7937129314814508));
+#endif
+
+  //The fast force API contracts the multideterminant expansion by the table method.  Checked against the
+  //sum of the forces of all the operators and against the ion gradient of log(psi).
+  ParticleSet::ParticlePos force(Nions);
+  force = 0.0;
+  for (int i = 0; i < ham.size(); i++)
+  {
+    hf_term    = 0.0;
+    pulay_term = 0.0;
+    ham.getHamiltonian(i)->evaluateWithIonDerivsDeterministic(elec, ions, *psi, hf_term, pulay_term);
+    force += hf_term + pulay_term;
+  }
+  wfgradraw[0] = psi->evalGradSource(elec, ions, 0);
+  wfgradraw[1] = psi->evalGradSource(elec, ions, 1);
+  convertToReal(wfgradraw[0], wf_grad[0]);
+  convertToReal(wfgradraw[1], wf_grad[1]);
+
+  TWFFastDerivWrapper twf;
+  psi->initializeTWFFastDerivWrapper(elec, twf);
+  ParticleSet::ParticlePos dedr(Nions);
+  ParticleSet::ParticlePos dpsidr(Nions);
+  RealType eloc_fast = ham.evaluateIonDerivsDeterministicFast(elec, ions, *psi, twf, dedr, dpsidr);
+#if defined(MIXED_PRECISION)
+  const RealType eps = 2e-4;
+#else
+  const RealType eps = std::numeric_limits<float>::epsilon() * 100;
+#endif
+  CHECK(eloc_fast == Approx(eloc).epsilon(eps));
+  for (int iat = 0; iat < Nions; iat++)
+    for (int idim = 0; idim < OHMMS_DIM; idim++)
+    {
+      CHECK(dedr[iat][idim] == Approx(force[iat][idim]).epsilon(eps));
+      CHECK(dpsidr[iat][idim] == Approx(wf_grad[iat][idim]).epsilon(eps));
+    }
+
+  //Batched fast force API with a second walker on a displaced configuration.
+  ParticleSet elec2(elec);
+  elec2.R[0] += ParticleSet::SingleParticlePos(0.1, -0.2, 0.05);
+  elec2.update();
+  auto psi2 = psi->makeClone(elec2);
+  auto ham2 = ham.makeClone(elec2, *psi2);
+  psi2->evaluateLog(elec2);
+  TWFFastDerivWrapper twf2;
+  psi2->initializeTWFFastDerivWrapper(elec2, twf2);
+  ParticleSet::ParticlePos dedr2(Nions);
+  ParticleSet::ParticlePos dpsidr2(Nions);
+  RealType eloc2 = ham2->evaluateIonDerivsDeterministicFast(elec2, ions, *psi2, twf2, dedr2, dpsidr2);
+
+  RefVectorWithLeader<QMCHamiltonian> ham_list(ham, {ham, *ham2});
+  RefVectorWithLeader<ParticleSet> p_list(elec, {elec, elec2});
+  RefVectorWithLeader<TrialWaveFunction> wf_list(*psi, {*psi, *psi2});
+  RefVectorWithLeader<TWFFastDerivWrapper> twf_list(twf, {twf, twf2});
+  std::vector<ParticleSet::ParticlePos> mw_dedr(2, ParticleSet::ParticlePos(Nions));
+  std::vector<ParticleSet::ParticlePos> mw_dpsidr(2, ParticleSet::ParticlePos(Nions));
+  auto mw_eloc = QMCHamiltonian::mw_evaluateIonDerivsDeterministicFast(ham_list, p_list, ions, wf_list, twf_list,
+                                                                       makeRefVector<ParticleSet::ParticlePos>(mw_dedr),
+                                                                       makeRefVector<ParticleSet::ParticlePos>(
+                                                                           mw_dpsidr));
+  CHECK(mw_eloc[0] == Approx(eloc));
+  CHECK(mw_eloc[1] == Approx(eloc2));
+  for (int iat = 0; iat < Nions; iat++)
+    for (int idim = 0; idim < OHMMS_DIM; idim++)
+    {
+      CHECK(mw_dedr[0][iat][idim] == Approx(dedr[iat][idim]));
+      CHECK(mw_dpsidr[0][iat][idim] == Approx(dpsidr[iat][idim]));
+      CHECK(mw_dedr[1][iat][idim] == Approx(dedr2[iat][idim]));
+      CHECK(mw_dpsidr[1][iat][idim] == Approx(dpsidr2[iat][idim]));
+    }
 }
 
 TEST_CASE("Eloc_Derivatives:proto_sd_noj", "[hamiltonian]")
@@ -1241,7 +1304,40 @@ TEST_CASE("Eloc_Derivatives:proto_sd_wj", "[hamiltonian]")
   //This is to test the fast force API in QMCHamiltonian.
   ParticleSet::ParticlePos dedr(ions.getTotalNum());
   ParticleSet::ParticlePos dpsidr(ions.getTotalNum());
-  ham.evaluateIonDerivsDeterministicFast(elec,ions,*psi,twf,dedr,dpsidr);
+  RealType eloc = ham.evaluateIonDerivsDeterministicFast(elec,ions,*psi,twf,dedr,dpsidr);
+
+  //Batched fast force API.  The second walker has an electron displaced, checked against the single walker API.
+  ParticleSet elec2(elec);
+  elec2.R[0] += ParticleSet::SingleParticlePos(0.1, -0.2, 0.05);
+  elec2.update();
+  auto psi2 = psi->makeClone(elec2);
+  auto ham2 = ham.makeClone(elec2, *psi2);
+  TWFFastDerivWrapper twf2;
+  psi2->initializeTWFFastDerivWrapper(elec2, twf2);
+  ParticleSet::ParticlePos dedr2(ions.getTotalNum());
+  ParticleSet::ParticlePos dpsidr2(ions.getTotalNum());
+  RealType eloc2 = ham2->evaluateIonDerivsDeterministicFast(elec2, ions, *psi2, twf2, dedr2, dpsidr2);
+
+  RefVectorWithLeader<QMCHamiltonian> ham_list(ham, {ham, *ham2});
+  RefVectorWithLeader<ParticleSet> p_list(elec, {elec, elec2});
+  RefVectorWithLeader<TrialWaveFunction> wf_list(*psi, {*psi, *psi2});
+  RefVectorWithLeader<TWFFastDerivWrapper> twf_list(twf, {twf, twf2});
+  std::vector<ParticleSet::ParticlePos> mw_dedr(2, ParticleSet::ParticlePos(ions.getTotalNum()));
+  std::vector<ParticleSet::ParticlePos> mw_dpsidr(2, ParticleSet::ParticlePos(ions.getTotalNum()));
+  auto mw_eloc = QMCHamiltonian::mw_evaluateIonDerivsDeterministicFast(ham_list, p_list, ions, wf_list, twf_list,
+                                                                       makeRefVector<ParticleSet::ParticlePos>(mw_dedr),
+                                                                       makeRefVector<ParticleSet::ParticlePos>(
+                                                                           mw_dpsidr));
+  CHECK(mw_eloc[0] == Approx(eloc));
+  CHECK(mw_eloc[1] == Approx(eloc2));
+  for (int iat = 0; iat < ions.getTotalNum(); iat++)
+    for (int idim = 0; idim < OHMMS_DIM; idim++)
+    {
+      CHECK(mw_dedr[0][iat][idim] == Approx(dedr[iat][idim]));
+      CHECK(mw_dpsidr[0][iat][idim] == Approx(dpsidr[iat][idim]));
+      CHECK(mw_dedr[1][iat][idim] == Approx(dedr2[iat][idim]));
+      CHECK(mw_dpsidr[1][iat][idim] == Approx(dpsidr2[iat][idim]));
+    }
 }
 /*TEST_CASE("Eloc_Derivatives:slater_wj", "[hamiltonian]")
 {
@@ -164,6 +164,9 @@ struct SoaBasisSetBase
                                      int jion,
                                      vghgh_type& vghgh)                            = 0;
   virtual void evaluateV(const ParticleSet& P, int iat, value_type* restrict vals) = 0;
+  //Range [first, last) of the basis functions depending on the position of source particle "c".  Only these have
+  //    nonzero ionic gradients with respect to "c".  Basis sets not localized on the source particles return all of them.
+  virtual std::pair<int, int> getCenterBasisRange(int c) const { return {0, BasisSetSize}; }
   virtual bool is_S_orbital(int mo_idx, int ao_idx) { return false; }
 
   /// Determine which orbitals are S-type.  Used for cusp correction.
@@ -17,6 +17,7 @@
 #include "SplineR2R.h"
 #include "spline2/MultiBsplineEval.hpp"
 #include "QMCWaveFunctions/BsplineFactory/contraction_helper.hpp"
+#include "CPU/BLAS.hpp"
 
 namespace qmcplusplus
 {
@@ -88,43 +89,38 @@ void SplineR2R<ST>::applyRotation(const ValueMatrix& rot_mat, bool use_stored_co
   assert(OrbitalSetSize >= TrueNOrbs);
 
   // Fill top left corner of tmpU with rot_mat
-  ValueMatrix tmpU;
-  tmpU.resize(Nsplines, Nsplines);
+  Matrix<double> tmpU(Nsplines, Nsplines);
   std::fill(tmpU.begin(), tmpU.end(), 0.0);
   for (auto i = 0; i < rot_mat.size1(); i++)
   {
     for (auto j = 0; j < rot_mat.size2(); j++)
     {
-      tmpU[i][j] = rot_mat[i][j];
+      tmpU[i][j] = std::real(rot_mat[i][j]);
     }
   }
 
-  // Apply rotation the dumb way b/c I can't get BLAS::gemm to work...
-  std::vector<RealType> new_coefs(coefs_tot_size, 0);
-  for (auto i = 0; i < BasisSetSize; i++)
+  // Bound the double precision scratch of the product to about 8 MB per buffer
+  const size_t chunk_rows = std::max<size_t>(1, (size_t(1) << 20) / Nsplines);
+  rotateCoefs(spl_coefs, BasisSetSize, tmpU, chunk_rows);
+}
+
+template<typename ST>
+void SplineR2R<ST>::rotateCoefs(ST* coefs, size_t basis_set_size, const Matrix<double>& rot, size_t chunk_rows)
+{
+  const int Nsplines = rot.rows();
+  assert(chunk_rows > 0);
+  std::vector<double> old_coefs(std::min(chunk_rows, basis_set_size) * Nsplines);
+  std::vector<double> new_coefs(old_coefs.size());
+  for (size_t first = 0; first < basis_set_size; first += chunk_rows)
   {
-    for (auto j = 0; j < Nsplines; j++)
-    {
-      const auto cur_elem = Nsplines * i + j;
-      auto newval{0.};
-      for (auto k = 0; k < Nsplines; k++)
-      {
-        const auto index = i * Nsplines + k;
-        newval += *(spl_coefs + index) * tmpU[k][j];
-      }
-      new_coefs[cur_elem] = newval;
-    }
+    const size_t nrows = std::min(chunk_rows, basis_set_size - first);
+    ST* chunk          = coefs + first * Nsplines;
+    std::copy(chunk, chunk + nrows * Nsplines, old_coefs.begin());
+    // new_coefs = old_coefs rot in row-major, written out-of-place since gemm cannot work in place
+    BLAS::gemm('N', 'N', Nsplines, static_cast<int>(nrows), Nsplines, 1.0, rot.data(), Nsplines, old_coefs.data(),
+               Nsplines, 0.0, new_coefs.data(), Nsplines);
+    std::copy(new_coefs.begin(), new_coefs.begin() + nrows * Nsplines, chunk);
   }
-
-  // Update the coefs
-  std::copy(new_coefs.begin(), new_coefs.end(), spl_coefs);
-
-  /*
-    // Here is my attempt to use gemm but it doesn't work...
-    int smaller_BasisSetSize   = static_cast<int>(BasisSetSize);
-    int smaller_OrbitalSetSize = static_cast<int>(OrbitalSetSize);
-    BLAS::gemm('N', 'T', smaller_BasisSetSize, smaller_OrbitalSetSize, smaller_OrbitalSetSize, RealType(1.0), spl_coefs, smaller_BasisSetSize, tmpU.data(), smaller_OrbitalSetSize, RealType(0.0), spl_coefs, smaller_BasisSetSize);
-  */
 }
 
 
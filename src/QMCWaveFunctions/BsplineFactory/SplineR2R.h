@@ -98,6 +98,13 @@ public:
   */
   void applyRotation(const ValueMatrix& rot_mat, bool use_stored_copy) override;
 
+  /** coefs = coefs rot for the row-major basis_set_size x rot.rows() coefficients
+   *
+   * The product is accumulated in double precision also for single precision splines,
+   * converting at most chunk_rows basis rows at a time to bound the scratch memory.
+   */
+  static void rotateCoefs(ST* coefs, size_t basis_set_size, const Matrix<double>& rot, size_t chunk_rows);
+
   inline void resizeStorage(size_t n, size_t nvals)
   {
     init_base(n);
@@ -839,6 +839,40 @@ void DiracDeterminantBatched<DET_ENGINE>::evaluateRatiosAlltoOne(ParticleSet& P,
     ratios[FirstIndex + i] = simd::dot(psiMinv[i], psiV.data(), NumOrbitals);
 }
 
+template<typename DET_ENGINE>
+void DiracDeterminantBatched<DET_ENGINE>::mw_evaluateRatiosAlltoOne(
+    const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+    const RefVectorWithLeader<ParticleSet>& p_list,
+    std::vector<std::vector<Value>>& ratios) const
+{
+  assert(this == &wfc_list.getLeader());
+  const size_t nw = wfc_list.size();
+
+  RefVectorWithLeader<SPOSet> phi_list(*Phi);
+  RefVector<Vector<Value>> psiV_list;
+  phi_list.reserve(nw);
+  psiV_list.reserve(nw);
+  for (size_t iw = 0; iw < nw; iw++)
+  {
+    auto& det = wfc_list.getCastedElement<DiracDeterminantBatched<DET_ENGINE>>(iw);
+    phi_list.push_back(*det.Phi);
+    psiV_list.push_back(det.psiV_host_view);
+  }
+
+  {
+    ScopedTimer local_timer(SPOVTimer);
+    Phi->mw_evaluateValue(phi_list, p_list, -1, psiV_list);
+  }
+
+  for (size_t iw = 0; iw < nw; iw++)
+  {
+    auto& det     = wfc_list.getCastedElement<DiracDeterminantBatched<DET_ENGINE>>(iw);
+    auto& psiMinv = det.det_engine_.get_ref_psiMinv();
+    for (int i = 0; i < psiMinv.rows(); i++)
+      ratios[iw][FirstIndex + i] = simd::dot(psiMinv[i], det.psiV.data(), NumOrbitals);
+  }
+}
+
 template<typename DET_ENGINE>
 void DiracDeterminantBatched<DET_ENGINE>::resizeScratchObjectsForIonDerivs()
 {
@@ -1132,6 +1166,9 @@ void DiracDeterminantBatched<DET_ENGINE>::registerTWFFastDerivWrapper(const Part
                                                                       TWFFastDerivWrapper& twf) const
 {
   twf.addGroup(P, P.getGroupID(FirstIndex), Phi.get());
+  // the host copy of the inverse is current after mw_completeUpdates
+  const auto& psiMinv = det_engine_.get_psiMinv();
+  twf.addGroupInverse(P.getGroupID(FirstIndex), psiMinv.data(), psiMinv.cols());
 }
 
 template<typename DET_ENGINE>
@@ -260,6 +260,10 @@ public:
 
   void evaluateRatiosAlltoOne(ParticleSet& P, std::vector<Value>& ratios) override;
 
+  void mw_evaluateRatiosAlltoOne(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                                 const RefVectorWithLeader<ParticleSet>& p_list,
+                                 std::vector<std::vector<Value>>& ratios) const override;
+
   DET_ENGINE& get_det_engine() { return det_engine_; }
 
   /** @defgroup LegacySingleData
@@ -66,6 +66,29 @@ void DiracDeterminantWithBackflow::resize(int nel, int morb)
   psiMinv_temp.resize(NumPtcls, norb);
   psiV.resize(norb);
   psiM_temp.resize(NumPtcls, norb);
+  dpsiM_temp.resize(NumPtcls, norb);
+  grad_grad_psiM_temp.resize(NumPtcls, norb);
+  grad_gradV.resize(norb);
+  Fmatdiag_temp.resize(norb);
+  qp_slot_.assign(nel, -1);
+  qp_psiV_.resize(nel, norb);
+  qp_dpsiV_.resize(nel, norb);
+  qp_d2psiV_.resize(nel, norb);
+  qp_psiV_rows_.clear();
+  qp_dpsiV_rows_.clear();
+  qp_d2psiV_rows_.clear();
+  for (int p = 0; p < nel; p++)
+  {
+    qp_psiV_rows_.emplace_back(qp_psiV_[p], norb);
+    qp_dpsiV_rows_.emplace_back(qp_dpsiV_[p], norb);
+    qp_d2psiV_rows_.emplace_back(qp_d2psiV_[p], norb);
+  }
+  qp_Rinv_.resize(nel, nel);
+  qp_W_.resize(nel, nel);
+  qp_coef_.resize(nel, nel);
+  qp_invrows_.resize(nel, norb);
+  lowrank_move_       = false;
+  lowrank_coef_ready_ = false;
   // For forces
   /*  not used
   grad_source_psiM.resize(nel,norb);
@@ -189,31 +212,120 @@ void DiracDeterminantWithBackflow::copyFromBuffer(ParticleSet& P, WFBufferType&
  */
 DiracDeterminantWithBackflow::PsiValueType DiracDeterminantWithBackflow::ratio(ParticleSet& P, int iat)
 {
-  // FIX FIX FIX : code Woodbury formula
-  psiM_temp = psiM;
-  // either code Woodbury or do multiple single particle updates
-  UpdateMode                        = ORB_PBYP_RATIO;
-  std::vector<int>::iterator it     = BFTrans_.indexQP.begin();
-  std::vector<int>::iterator it_end = BFTrans_.indexQP.end();
-  while (it != it_end)
+  UpdateMode = ORB_PBYP_RATIO;
+  collectMovedQP();
+  evaluateMovedQP(false);
+  return computeMovedRatio();
+}
+
+void DiracDeterminantWithBackflow::collectMovedQP()
+{
+  for (const int jat : qp_moved_)
+    qp_slot_[jat] = -1;
+  qp_moved_.clear();
+  // indexQP is in ascending order
+  for (const int jat : BFTrans_.indexQP)
+    if (jat >= FirstIndex && jat < LastIndex)
+    {
+      qp_slot_[jat - FirstIndex] = qp_moved_.size();
+      qp_moved_.push_back(jat - FirstIndex);
+    }
+}
+
+void DiracDeterminantWithBackflow::evaluateMovedQP(bool with_grad)
+{
+  for (int p = 0; p < qp_moved_.size(); p++)
   {
-    if (*it < FirstIndex || *it >= LastIndex)
+    const int jat = FirstIndex + qp_moved_[p];
+    BFTrans_.QP.makeMove(jat, BFTrans_.newQP[jat] - BFTrans_.QP.R[jat]);
+    if (with_grad)
+      Phi->evaluateVGL(BFTrans_.QP, jat, qp_psiV_rows_[p], qp_dpsiV_rows_[p], qp_d2psiV_rows_[p]);
+    else
+      Phi->evaluateValue(BFTrans_.QP, jat, qp_psiV_rows_[p]);
+    BFTrans_.QP.rejectMove(jat);
+  }
+}
+
+void DiracDeterminantWithBackflow::mw_evaluateMovedQP(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                                                      bool with_grad)
+{
+  auto& wfc_leader = wfc_list.getCastedLeader<DiracDeterminantWithBackflow>();
+  const int nw     = wfc_list.size();
+  for (int iw = 0; iw < nw; iw++)
+    wfc_list.getCastedElement<DiracDeterminantWithBackflow>(iw).collectMovedQP();
+
+  RefVectorWithLeader<SPOSet> phi_list(*wfc_leader.Phi);
+  RefVectorWithLeader<ParticleSet> qp_list(wfc_leader.BFTrans_.QP);
+  RefVector<ValueVector> psi_v_list;
+  RefVector<GradVector> dpsi_v_list;
+  RefVector<ValueVector> d2psi_v_list;
+  phi_list.reserve(nw);
+  qp_list.reserve(nw);
+  psi_v_list.reserve(nw);
+  dpsi_v_list.reserve(nw);
+  d2psi_v_list.reserve(nw);
+
+  // walk the ascending qp_moved_ of all the walkers together and batch the walkers sharing a quasiparticle index
+  std::vector<int> next(nw, 0);
+  for (int jat = 0; jat < wfc_leader.NumPtcls; jat++)
+  {
+    const int qp_id = wfc_leader.FirstIndex + jat;
+    phi_list.clear();
+    qp_list.clear();
+    psi_v_list.clear();
+    dpsi_v_list.clear();
+    d2psi_v_list.clear();
+    for (int iw = 0; iw < nw; iw++)
     {
-      ++it;
-      continue;
+      auto& det = wfc_list.getCastedElement<DiracDeterminantWithBackflow>(iw);
+      int& p    = next[iw];
+      if (p == det.qp_moved_.size() || det.qp_moved_[p] != jat)
+        continue;
+      det.BFTrans_.QP.makeMove(qp_id, det.BFTrans_.newQP[qp_id] - det.BFTrans_.QP.R[qp_id]);
+      phi_list.push_back(*det.Phi);
+      qp_list.push_back(det.BFTrans_.QP);
+      psi_v_list.push_back(det.qp_psiV_rows_[p]);
+      dpsi_v_list.push_back(det.qp_dpsiV_rows_[p]);
+      d2psi_v_list.push_back(det.qp_d2psiV_rows_[p]);
+      p++;
     }
-    int jat    = *it - FirstIndex;
-    PosType dr = BFTrans_.newQP[*it] - BFTrans_.QP.R[*it];
-    BFTrans_.QP.makeMove(*it, dr);
-    Phi->evaluateValue(BFTrans_.QP, *it, psiV);
-    for (int orb = 0; orb < psiV.size(); orb++)
-      psiM_temp(orb, jat) = psiV[orb];
-    BFTrans_.QP.rejectMove(*it);
-    it++;
+    if (phi_list.empty())
+      continue;
+    if (with_grad)
+      wfc_leader.Phi->mw_evaluateVGL(phi_list, qp_list, qp_id, psi_v_list, dpsi_v_list, d2psi_v_list);
+    else
+      wfc_leader.Phi->mw_evaluateValue(phi_list, qp_list, qp_id, psi_v_list);
+    for (ParticleSet& qp : qp_list)
+      qp.rejectMove(qp_id);
   }
-  // FIX FIX FIX : code Woodbury formula
+}
+
+DiracDeterminantWithBackflow::PsiValueType DiracDeterminantWithBackflow::computeMovedRatio()
+{
+  const int nqp       = qp_moved_.size();
+  lowrank_coef_ready_ = false;
+  // the Woodbury update costs O(nqp N^2) against O(N^3) of a full inversion
+  lowrank_move_ = 2 * nqp <= NumPtcls;
+  if (lowrank_move_)
+  {
+    if (nqp == 0)
+      return curRatio = PsiValueType(1);
+    ValueType* restrict rinv = qp_Rinv_.data();
+    for (int p = 0; p < nqp; p++)
+      for (int q = 0; q < nqp; q++)
+        rinv[p * nqp + q] = simd::dot(psiMinv[qp_moved_[q]], qp_psiV_[p], NumOrbitals);
+    InverseTimer.start();
+    LogValueType ratio_log;
+    InvertWithLog(rinv, nqp, nqp, WorkSpace.data(), Pivot.data(), ratio_log);
+    InverseTimer.stop();
+    return curRatio = LogToValue<PsiValueType>::convert(ratio_log);
+  }
+
+  psiM_temp = psiM;
+  for (int p = 0; p < nqp; p++)
+    for (int orb = 0; orb < NumOrbitals; orb++)
+      psiM_temp(orb, qp_moved_[p]) = qp_psiV_(p, orb);
   psiMinv_temp = psiM_temp;
-  // FIX FIX FIX : code Woodbury formula
   InverseTimer.start();
   LogValueType NewLog;
   InvertWithLog(psiMinv_temp.data(), NumPtcls, NumOrbitals, WorkSpace.data(), Pivot.data(), NewLog);
@@ -221,6 +333,134 @@ DiracDeterminantWithBackflow::PsiValueType DiracDeterminantWithBackflow::ratio(P
   return curRatio = LogToValue<PsiValueType>::convert(NewLog - log_value_);
 }
 
+DiracDeterminantWithBackflow::PsiValueType DiracDeterminantWithBackflow::computeMovedRatioGrad(int iat,
+                                                                                               GradType& grad_iat)
+{
+  computeMovedRatio();
+  const int nqp = qp_moved_.size();
+  if (lowrank_move_)
+  {
+    if (nqp > 0)
+    {
+      computeLowRankCoefficients();
+      // Fmatdiag_temp[i] = psiMinv'[i] . dpsiM'[i] without forming psiMinv'
+      for (int i = 0; i < NumPtcls; i++)
+      {
+        const GradType* restrict dpsi_row = qp_slot_[i] < 0 ? dpsiM[i] : qp_dpsiV_[qp_slot_[i]];
+        GradType fii                      = simd::dot(psiMinv[i], dpsi_row, NumOrbitals);
+        for (int q = 0; q < nqp; q++)
+          fii -= qp_coef_(q, i) * simd::dot(psiMinv[qp_moved_[q]], dpsi_row, NumOrbitals);
+        Fmatdiag_temp[i] = fii;
+      }
+    }
+    else
+      Fmatdiag_temp = Fmatdiag;
+  }
+  else
+  {
+    dpsiM_temp = dpsiM;
+    for (int p = 0; p < nqp; p++)
+    {
+      std::copy_n(qp_dpsiV_[p], NumOrbitals, dpsiM_temp[qp_moved_[p]]);
+      std::copy(grad_gradV.begin(), grad_gradV.end(), grad_grad_psiM_temp.begin(qp_moved_[p]));
+    }
+    for (int j = 0; j < NumPtcls; j++)
+      Fmatdiag_temp[j] = simd::dot(psiMinv_temp[j], dpsiM_temp[j], NumOrbitals);
+  }
+  for (int j = 0; j < NumPtcls; j++)
+    grad_iat += dot(BFTrans_.Amat_temp(iat, FirstIndex + j), Fmatdiag_temp[j]);
+  return curRatio;
+}
+
+void DiracDeterminantWithBackflow::computeLowRankCoefficients()
+{
+  const int nqp = qp_moved_.size();
+  // column-major views: qp_W_^T = psiMinv qp_psiV_^T
+  BLAS::gemm('T', 'N', NumPtcls, nqp, NumOrbitals, ValueType(1), psiMinv.data(), NumOrbitals, qp_psiV_.data(),
+             NumOrbitals, ValueType(0), qp_W_.data(), NumPtcls);
+  for (int p = 0; p < nqp; p++)
+    qp_W_(p, qp_moved_[p]) -= ValueType(1);
+  // qp_coef_ = R^{-1} qp_W_
+  BLAS::gemm('N', 'N', NumPtcls, nqp, nqp, ValueType(1), qp_W_.data(), NumPtcls, qp_Rinv_.data(), nqp, ValueType(0),
+             qp_coef_.data(), NumPtcls);
+  lowrank_coef_ready_ = true;
+}
+
+void DiracDeterminantWithBackflow::acceptLowRankMove()
+{
+  const int nqp = qp_moved_.size();
+  if (nqp == 0)
+    return;
+  if (!lowrank_coef_ready_)
+    computeLowRankCoefficients();
+  for (int q = 0; q < nqp; q++)
+    std::copy_n(psiMinv[qp_moved_[q]], NumOrbitals, qp_invrows_[q]);
+  // psiMinv[i] -= sum_q qp_coef_(q,i) psiMinv[j_q]
+  BLAS::gemm('N', 'T', NumOrbitals, NumPtcls, nqp, ValueType(-1), qp_invrows_.data(), NumOrbitals, qp_coef_.data(),
+             NumPtcls, ValueType(1), psiMinv.data(), NumOrbitals);
+  for (int p = 0; p < nqp; p++)
+    for (int orb = 0; orb < NumOrbitals; orb++)
+      psiM(orb, qp_moved_[p]) = qp_psiV_(p, orb);
+  if (UpdateMode == ORB_PBYP_PARTIAL)
+    for (int p = 0; p < nqp; p++)
+      std::copy_n(qp_dpsiV_[p], NumOrbitals, dpsiM[qp_moved_[p]]);
+  lowrank_coef_ready_ = false;
+}
+
+void DiracDeterminantWithBackflow::mw_calcRatio(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                                                const RefVectorWithLeader<ParticleSet>& p_list,
+                                                int iat,
+                                                std::vector<PsiValueType>& ratios) const
+{
+  mw_evaluateMovedQP(wfc_list, false);
+  for (int iw = 0; iw < wfc_list.size(); iw++)
+  {
+    auto& det      = wfc_list.getCastedElement<DiracDeterminantWithBackflow>(iw);
+    det.UpdateMode = ORB_PBYP_RATIO;
+    ratios[iw]     = det.computeMovedRatio();
+  }
+}
+
+void DiracDeterminantWithBackflow::mw_ratioGrad(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                                                const RefVectorWithLeader<ParticleSet>& p_list,
+                                                int iat,
+                                                std::vector<PsiValueType>& ratios,
+                                                std::vector<GradType>& grad_new) const
+{
+  mw_evaluateMovedQP(wfc_list, true);
+  for (int iw = 0; iw < wfc_list.size(); iw++)
+  {
+    auto& det      = wfc_list.getCastedElement<DiracDeterminantWithBackflow>(iw);
+    det.UpdateMode = ORB_PBYP_PARTIAL;
+    ratios[iw]     = det.computeMovedRatioGrad(iat, grad_new[iw]);
+  }
+}
+
+void DiracDeterminantWithBackflow::createResource(ResourceCollection& collection) const
+{
+  Phi->createResource(collection);
+}
+
+void DiracDeterminantWithBackflow::acquireResource(ResourceCollection& collection,
+                                                   const RefVectorWithLeader<WaveFunctionComponent>& wfc_list) const
+{
+  auto& wfc_leader = wfc_list.getCastedLeader<DiracDeterminantWithBackflow>();
+  RefVectorWithLeader<SPOSet> phi_list(*wfc_leader.Phi);
+  for (WaveFunctionComponent& wfc : wfc_list)
+    phi_list.push_back(*static_cast<DiracDeterminantWithBackflow&>(wfc).Phi);
+  wfc_leader.Phi->acquireResource(collection, phi_list);
+}
+
+void DiracDeterminantWithBackflow::releaseResource(ResourceCollection& collection,
+                                                   const RefVectorWithLeader<WaveFunctionComponent>& wfc_list) const
+{
+  auto& wfc_leader = wfc_list.getCastedLeader<DiracDeterminantWithBackflow>();
+  RefVectorWithLeader<SPOSet> phi_list(*wfc_leader.Phi);
+  for (WaveFunctionComponent& wfc : wfc_list)
+    phi_list.push_back(*static_cast<DiracDeterminantWithBackflow&>(wfc).Phi);
+  wfc_leader.Phi->releaseResource(collection, phi_list);
+}
+
 void DiracDeterminantWithBackflow::evaluateRatiosAlltoOne(ParticleSet& P, std::vector<ValueType>& ratios)
 {
   APP_ABORT(" Need to implement DiracDeterminantWithBackflow::evaluateRatiosAlltoOne. \n");
@@ -260,45 +500,10 @@ DiracDeterminantWithBackflow::PsiValueType DiracDeterminantWithBackflow::ratioGr
                                                                                    int iat,
                                                                                    GradType& grad_iat)
 {
-  // FIX FIX FIX : code Woodbury formula
-  psiM_temp                         = psiM;
-  dpsiM_temp                        = dpsiM;
-  UpdateMode                        = ORB_PBYP_PARTIAL;
-  std::vector<int>::iterator it     = BFTrans_.indexQP.begin();
-  std::vector<int>::iterator it_end = BFTrans_.indexQP.end();
-  ParticleSet::ParticlePos dr;
-  while (it != it_end)
-  {
-    if (*it < FirstIndex || *it >= LastIndex)
-    {
-      ++it;
-      continue;
-    }
-    int jat    = *it - FirstIndex;
-    PosType dr = BFTrans_.newQP[*it] - BFTrans_.QP.R[*it];
-    BFTrans_.QP.makeMove(*it, dr);
-    Phi->evaluateVGL(BFTrans_.QP, *it, psiV, dpsiV, d2psiV);
-    for (int orb = 0; orb < psiV.size(); orb++)
-      psiM_temp(orb, jat) = psiV[orb];
-    std::copy(dpsiV.begin(), dpsiV.end(), dpsiM_temp.begin(jat));
-    std::copy(grad_gradV.begin(), grad_gradV.end(), grad_grad_psiM_temp.begin(jat));
-    BFTrans_.QP.rejectMove(*it);
-    it++;
-  }
-  // FIX FIX FIX : code Woodbury formula
-  psiMinv_temp = psiM_temp;
-  // FIX FIX FIX : code Woodbury formula
-  InverseTimer.start();
-  LogValueType NewLog;
-  InvertWithLog(psiMinv_temp.data(), NumPtcls, NumOrbitals, WorkSpace.data(), Pivot.data(), NewLog);
-  InverseTimer.stop();
-  // update Fmatdiag_temp
-  for (int j = 0; j < NumPtcls; j++)
-  {
-    Fmatdiag_temp[j] = simd::dot(psiMinv_temp[j], dpsiM_temp[j], NumOrbitals);
-    grad_iat += dot(BFTrans_.Amat_temp(iat, FirstIndex + j), Fmatdiag_temp[j]);
-  }
-  return curRatio = LogToValue<PsiValueType>::convert(NewLog - log_value_);
+  UpdateMode = ORB_PBYP_PARTIAL;
+  collectMovedQP();
+  evaluateMovedQP(true);
+  return computeMovedRatioGrad(iat, grad_iat);
 }
 
 void DiracDeterminantWithBackflow::testL(ParticleSet& P)
@@ -562,6 +767,16 @@ void DiracDeterminantWithBackflow::acceptMove(ParticleSet& P, int iat, bool safe
 {
   log_value_ += convertValueToLog(curRatio);
   UpdateTimer.start();
+  if (lowrank_move_)
+  {
+    acceptLowRankMove();
+    if (UpdateMode == ORB_PBYP_PARTIAL)
+      Fmatdiag = Fmatdiag_temp;
+    lowrank_move_ = false;
+    UpdateTimer.stop();
+    curRatio = 1.0;
+    return;
+  }
   switch (UpdateMode)
   {
   case ORB_PBYP_RATIO:
@@ -591,7 +806,11 @@ void DiracDeterminantWithBackflow::acceptMove(ParticleSet& P, int iat, bool safe
 
 /** move was rejected. Nothing to restore for now.
 */
-void DiracDeterminantWithBackflow::restore(int iat) { curRatio = 1.0; }
+void DiracDeterminantWithBackflow::restore(int iat)
+{
+  curRatio      = 1.0;
+  lowrank_move_ = false;
+}
 
 void DiracDeterminantWithBackflow::evaluateDerivatives(ParticleSet& P,
                                                        const opt_variables_type& active,
@@ -100,6 +100,31 @@ public:
 
   PsiValueType ratioGrad(ParticleSet& P, int iat, GradType& grad_iat) override;
   GradType evalGrad(ParticleSet& P, int iat) override;
+
+  /** compute the ratios of multiple walkers.
+   * The orbitals of the displaced quasiparticles are evaluated in batches over walkers.
+   */
+  void mw_calcRatio(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                    const RefVectorWithLeader<ParticleSet>& p_list,
+                    int iat,
+                    std::vector<PsiValueType>& ratios) const override;
+
+  /** compute the ratios and gradients of multiple walkers.
+   * The orbitals of the displaced quasiparticles are evaluated in batches over walkers.
+   */
+  void mw_ratioGrad(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                    const RefVectorWithLeader<ParticleSet>& p_list,
+                    int iat,
+                    std::vector<PsiValueType>& ratios,
+                    std::vector<GradType>& grad_new) const override;
+
+  void createResource(ResourceCollection& collection) const override;
+
+  void acquireResource(ResourceCollection& collection,
+                       const RefVectorWithLeader<WaveFunctionComponent>& wfc_list) const override;
+
+  void releaseResource(ResourceCollection& collection,
+                       const RefVectorWithLeader<WaveFunctionComponent>& wfc_list) const override;
   GradType evalGradSource(ParticleSet& P, ParticleSet& source, int iat) override;
 
   GradType evalGradSource(ParticleSet& P,
@@ -146,6 +171,21 @@ private:
   ///reset the size: with the number of particles and number of orbtials
   void resize(int nel, int morb);
 
+  ///collect the quasiparticles of this determinant displaced by the current move in qp_moved_
+  void collectMovedQP();
+  ///evaluate the orbitals of the displaced quasiparticles at their new positions
+  void evaluateMovedQP(bool with_grad);
+  ///evaluate the orbitals of the displaced quasiparticles of multiple walkers, one quasiparticle index at a time
+  static void mw_evaluateMovedQP(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list, bool with_grad);
+  ///compute the ratio from the orbitals of the displaced quasiparticles
+  PsiValueType computeMovedRatio();
+  ///compute the ratio and the gradient of particle iat from the orbitals of the displaced quasiparticles
+  PsiValueType computeMovedRatioGrad(int iat, GradType& grad_iat);
+  ///compute the Woodbury coefficients qp_coef_ of the current low-rank move
+  void computeLowRankCoefficients();
+  ///apply the accepted low-rank move to psiMinv, psiM and dpsiM
+  void acceptLowRankMove();
+
   inline ValueType rcdot(TinyVector<RealType, OHMMS_DIM>& lhs, TinyVector<ValueType, OHMMS_DIM>& rhs)
   {
     ValueType ret(0);
@@ -205,6 +245,39 @@ private:
   Vector<IndexType> Pivot;
 
   ValueMatrix psiMinv_temp;
+
+  /** low-rank update of the quasiparticle move
+   *
+   * A move of a particle displaces only the quasiparticles within the range of the backflow functions.
+   * When k of them belong to this determinant and k is small, the ratio is the determinant of the k x k matrix
+   * \f$R_{pq} = \sum_o {\rm psiMinv}(j_q,o) \psi_o({\bf x}'_{j_p})\f$ and the inverse is updated with the
+   * Woodbury formula, \f$O(kN^2)\f$, only when the move is accepted.
+   */
+  ///local indices of the displaced quasiparticles of this determinant, in ascending order
+  std::vector<int> qp_moved_;
+  ///slot of a quasiparticle in qp_moved_, -1 if not displaced
+  std::vector<int> qp_slot_;
+  ///true if the current move is handled by the low-rank update
+  bool lowrank_move_;
+  ///true if qp_coef_ is up-to-date with the current move
+  bool lowrank_coef_ready_;
+  ///orbital values, gradients and laplacians at the new quasiparticle positions, one row per displaced quasiparticle
+  ValueMatrix qp_psiV_;
+  GradMatrix qp_dpsiV_;
+  ValueMatrix qp_d2psiV_;
+  ///row views of qp_psiV_, qp_dpsiV_ and qp_d2psiV_
+  std::vector<ValueVector> qp_psiV_rows_;
+  std::vector<GradVector> qp_dpsiV_rows_;
+  std::vector<ValueVector> qp_d2psiV_rows_;
+  ///inverse of the k x k ratio matrix, stored contiguously with leading dimension k
+  ValueMatrix qp_Rinv_;
+  ///qp_W_(p,i) = psiMinv[i] . qp_psiV_[p] - delta(i,j_p)
+  ValueMatrix qp_W_;
+  ///Woodbury coefficients, psiMinv'[i] = psiMinv[i] - sum_q qp_coef_(q,i) psiMinv[j_q]
+  ValueMatrix qp_coef_;
+  ///copies of the psiMinv rows of the displaced quasiparticles
+  ValueMatrix qp_invrows_;
+
   ValueType* FirstAddressOfGGG;
   ValueType* LastAddressOfGGG;
   ValueType* FirstAddressOfFm;
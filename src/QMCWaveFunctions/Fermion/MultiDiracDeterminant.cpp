@@ -355,6 +355,352 @@ void MultiDiracDeterminant::evaluateForWalkerMoveWithSpin(const ParticleSet& P,
 }
 
 
+MultiDiracDeterminant::ValueType MultiDiracDeterminant::buildTableDerivative(const Matrix<ValueType>& minv,
+                                                                             const Matrix<ValueType>& table,
+                                                                             const Matrix<ValueType>& dpsi,
+                                                                             Matrix<ValueType>& dtable,
+                                                                             Matrix<ValueType>& dtable_ref) const
+{
+  const auto& occup = (*ciConfigList)[ReferenceDeterminant].occup;
+  // A dM, whose occupied columns A dM_0 also give the reference determinant derivative tr(A dM_0)
+  MatrixOperators::product(minv, dpsi, dtable);
+  ValueType dlog_ref(0);
+  for (size_t i = 0; i < NumPtcls; i++)
+  {
+    for (size_t k = 0; k < NumPtcls; k++)
+      dtable_ref(i, k) = dtable(i, occup[k]);
+    dlog_ref += dtable_ref(i, i);
+  }
+  // dT = A dM - (A dM_0) T
+  Matrix<ValueType> correction(NumPtcls, NumOrbitals);
+  MatrixOperators::product(dtable_ref, table, correction);
+  for (size_t i = 0; i < dtable.size(); i++)
+    dtable.data()[i] -= correction.data()[i];
+  return dlog_ref;
+}
+
+void MultiDiracDeterminant::evaluateTableRatios(const OffloadMatrix<ValueType>& table,
+                                                SmallMatrixDetCalculator<ValueType>& calculator,
+                                                Vector<ValueType>& ratios) const
+{
+  const auto& data    = *detData;
+  const auto& sign    = *DetSigns;
+  const size_t nitems = sign.size();
+  ratios.resize(nitems);
+
+  const int* it2 = data.data();
+  for (size_t count = 0; count < nitems; ++count)
+  {
+    const size_t n = *it2;
+    ratios[count]  = n == 0 ? ValueType(1) : sign[count] * evaluateBlockDet(table, it2 + 1, n, calculator);
+    it2 += 3 * n + 1;
+  }
+}
+
+void MultiDiracDeterminant::evaluateTableDerivRatios(const OffloadMatrix<ValueType>& table,
+                                                     size_t su,
+                                                     SmallMatrixDetCalculator<ValueType>& calculator,
+                                                     Vector<ValueType>& dratios) const
+{
+  const auto& data    = *detData;
+  const auto& sign    = *DetSigns;
+  const size_t nitems = sign.size();
+  dratios.resize(nitems);
+
+  std::vector<int> rows(2 * NumPtcls);
+  const int* it2 = data.data();
+  for (size_t count = 0; count < nitems; ++count)
+  {
+    const size_t n = *it2;
+    ValueType dratio(0);
+    for (size_t k = 0; k < n; k++)
+    {
+      std::copy_n(it2 + 1, 2 * n, rows.begin());
+      rows[k] += su;
+      dratio += evaluateBlockDet(table, rows.data(), n, calculator);
+    }
+    dratios[count] = sign[count] * dratio;
+    it2 += 3 * n + 1;
+  }
+}
+
+void MultiDiracDeterminant::evaluateTableMixedDerivRatios(const OffloadMatrix<ValueType>& table,
+                                                          size_t su,
+                                                          size_t sv,
+                                                          size_t suv,
+                                                          SmallMatrixDetCalculator<ValueType>& calculator,
+                                                          Vector<ValueType>& dratios) const
+{
+  const auto& data    = *detData;
+  const auto& sign    = *DetSigns;
+  const size_t nitems = sign.size();
+  dratios.resize(nitems);
+
+  std::vector<int> rows(2 * NumPtcls);
+  const int* it2 = data.data();
+  for (size_t count = 0; count < nitems; ++count)
+  {
+    const size_t n = *it2;
+    ValueType dratio(0);
+    for (size_t k = 0; k < n; k++)
+    {
+      std::copy_n(it2 + 1, 2 * n, rows.begin());
+      rows[k] += suv;
+      dratio += evaluateBlockDet(table, rows.data(), n, calculator);
+      for (size_t l = 0; l < n; l++)
+        if (l != k)
+        {
+          std::copy_n(it2 + 1, 2 * n, rows.begin());
+          rows[k] += su;
+          rows[l] += sv;
+          dratio += evaluateBlockDet(table, rows.data(), n, calculator);
+        }
+    }
+    dratios[count] = sign[count] * dratio;
+    it2 += 3 * n + 1;
+  }
+}
+
+void MultiDiracDeterminant::evaluateGradSource(const ParticleSet& P,
+                                               const ParticleSet& source,
+                                               int iat,
+                                               Vector<GradType>& dratios)
+{
+  GradMatrix grad_source_psiM(NumPtcls, NumOrbitals);
+  Phi->evaluateGradSource(P, FirstIndex, LastIndex, source, iat, grad_source_psiM);
+
+  const size_t nitems = DetSigns->size();
+  dratios.resize(nitems);
+
+  // T is stacked on top of dT such that the excitation block with its k-th row taken from dT
+  // is addressed by shifting the k-th row index by NumPtcls.
+  OffloadMatrix<ValueType> stacked_table(2 * NumPtcls, NumOrbitals);
+  Matrix<ValueType> table(stacked_table.data(), NumPtcls, NumOrbitals);
+  Matrix<ValueType> dtable(stacked_table[NumPtcls], NumPtcls, NumOrbitals);
+  Matrix<ValueType> psiM_host_view(psiM.data(), psiM.rows(), psiM.cols());
+  Matrix<ValueType> psiMinv_host_view(psiMinv.data(), psiMinv.rows(), psiMinv.cols());
+  MatrixOperators::product(psiMinv_host_view, psiM_host_view, table);
+
+  Matrix<ValueType> dM(NumPtcls, NumOrbitals);
+  Matrix<ValueType> dtable_ref(NumPtcls, NumPtcls);
+  Vector<ValueType> dtable_ratios;
+  for (int idim = 0; idim < OHMMS_DIM; idim++)
+  {
+    for (size_t i = 0; i < NumPtcls; i++)
+      for (size_t j = 0; j < NumOrbitals; j++)
+        dM(i, j) = grad_source_psiM(i, j)[idim];
+    const ValueType dlog_ref = buildTableDerivative(psiMinv_host_view, table, dM, dtable, dtable_ref);
+    evaluateTableDerivRatios(stacked_table, NumPtcls, det_calculator_, dtable_ratios);
+    for (size_t count = 0; count < nitems; ++count)
+      dratios[count][idim] = dtable_ratios[count] + ratios_to_ref_[count] * dlog_ref;
+  }
+}
+
+void MultiDiracDeterminant::evaluateGradSource(const ParticleSet& P,
+                                               const ParticleSet& source,
+                                               int iat,
+                                               const Vector<ValueType>& c,
+                                               const Vector<GradType>& dc,
+                                               Vector<GradType>& grad_psi,
+                                               Vector<ValueType>& lapl_psi,
+                                               Vector<HessType>& grad_grad_psi,
+                                               Vector<GradType>& lapl_grad_psi)
+{
+  GradMatrix grad_source_psiM(NumPtcls, NumOrbitals);
+  HessMatrix grad_grad_source_psiM(NumPtcls, NumOrbitals);
+  GradMatrix grad_lapl_source_psiM(NumPtcls, NumOrbitals);
+  Phi->evaluateGradSource(P, FirstIndex, LastIndex, source, iat, grad_source_psiM, grad_grad_source_psiM,
+                          grad_lapl_source_psiM);
+
+  const auto& occup   = (*ciConfigList)[ReferenceDeterminant].occup;
+  const size_t nitems = DetSigns->size();
+  grad_psi.resize(NumPtcls);
+  lapl_psi.resize(NumPtcls);
+  grad_grad_psi.resize(NumPtcls);
+  lapl_grad_psi.resize(NumPtcls);
+
+  // layers of the stacked table: T, T_U of an electron gradient or laplacian U,
+  // T_V of the ion derivative V of each direction and the mixed T_UV of each direction.
+  const size_t su = NumPtcls;
+  auto sv         = [this](int idim) { return (2 + idim) * NumPtcls; };
+  auto suv        = [this](int idim) { return (2 + OHMMS_DIM + idim) * NumPtcls; };
+  OffloadMatrix<ValueType> stacked_table((2 + 2 * OHMMS_DIM) * NumPtcls, NumOrbitals);
+  Matrix<ValueType> table(stacked_table.data(), NumPtcls, NumOrbitals);
+  Matrix<ValueType> psiM_host_view(psiM.data(), psiM.rows(), psiM.cols());
+  Matrix<ValueType> psiMinv_host_view(psiMinv.data(), psiMinv.rows(), psiMinv.cols());
+  MatrixOperators::product(psiMinv_host_view, psiM_host_view, table);
+
+  // the ion derivatives are full matrices, see evaluateGradSource
+  Matrix<ValueType> dM(NumPtcls, NumOrbitals);
+  std::vector<Matrix<ValueType>> vtable_ref(OHMMS_DIM, Matrix<ValueType>(NumPtcls, NumPtcls));
+  std::vector<Vector<ValueType>> tv(OHMMS_DIM);
+  GradType rv;
+  for (int idim = 0; idim < OHMMS_DIM; idim++)
+  {
+    for (size_t i = 0; i < NumPtcls; i++)
+      for (size_t j = 0; j < NumOrbitals; j++)
+        dM(i, j) = grad_source_psiM(i, j)[idim];
+    Matrix<ValueType> vtable(stacked_table[sv(idim)], NumPtcls, NumOrbitals);
+    rv[idim] = buildTableDerivative(psiMinv_host_view, table, dM, vtable, vtable_ref[idim]);
+    evaluateTableDerivRatios(stacked_table, sv(idim), det_calculator_, tv[idim]);
+  }
+
+  // U = e_i u and W = e_i w only have the row of electron i, with a_i the column i of A
+  //   T_U  = a_i (u - T^t u_0)
+  //   T_UV = a_i (w - T^t w_0 - T_V^t u_0) - (A V_0 a_i) (u - T^t u_0)
+  // and the derivatives of the reference determinant are r_U = a_i.u_0 and r_UV = a_i.w_0 + r_U r_V - u_0.(A V_0 a_i)
+  std::vector<ValueType> a(NumPtcls), u(NumOrbitals), z(NumOrbitals), w(NumOrbitals), y(NumOrbitals);
+  std::vector<std::vector<ValueType>> av(OHMMS_DIM, std::vector<ValueType>(NumPtcls));
+  Vector<ValueType> tu, tuv;
+  for (size_t i = 0; i < NumPtcls; i++)
+  {
+    for (size_t k = 0; k < NumPtcls; k++)
+      a[k] = psiMinv(k, i);
+    for (int idim = 0; idim < OHMMS_DIM; idim++)
+      for (size_t k = 0; k < NumPtcls; k++)
+        av[idim][k] = simd::dot(vtable_ref[idim][k], a.data(), NumPtcls);
+
+    // the electron gradient components followed by the laplacian
+    for (int jdim = 0; jdim <= OHMMS_DIM; jdim++)
+    {
+      const bool is_lapl = jdim == OHMMS_DIM;
+      for (size_t j = 0; j < NumOrbitals; j++)
+        u[j] = is_lapl ? d2psiM(i, j) : dpsiM(i, j)[jdim];
+
+      ValueType ru(0);
+      std::copy(u.begin(), u.end(), z.begin());
+      for (size_t k = 0; k < NumPtcls; k++)
+      {
+        const ValueType uk = u[occup[k]];
+        ru += a[k] * uk;
+        for (size_t j = 0; j < NumOrbitals; j++)
+          z[j] -= uk * table(k, j);
+      }
+      for (size_t k = 0; k < NumPtcls; k++)
+        for (size_t j = 0; j < NumOrbitals; j++)
+          stacked_table(su + k, j) = a[k] * z[j];
+      evaluateTableDerivRatios(stacked_table, su, det_calculator_, tu);
+
+      ValueType psi_u(0);
+      GradType dc_psi_u;
+      for (size_t count = 0; count < nitems; ++count)
+      {
+        const ValueType fu = ru * ratios_to_ref_[count] + tu[count];
+        psi_u += c[count] * fu;
+        dc_psi_u += dc[count] * fu;
+      }
+      if (is_lapl)
+        lapl_psi[i] = psi_u;
+      else
+        grad_psi[i][jdim] = psi_u;
+
+      for (int idim = 0; idim < OHMMS_DIM; idim++)
+      {
+        for (size_t j = 0; j < NumOrbitals; j++)
+          w[j] = is_lapl ? grad_lapl_source_psiM(i, j)[idim] : grad_grad_source_psiM(i, j)(idim, jdim);
+
+        ValueType ruv = ru * rv[idim];
+        std::copy(w.begin(), w.end(), y.begin());
+        for (size_t k = 0; k < NumPtcls; k++)
+        {
+          const ValueType uk = u[occup[k]];
+          const ValueType wk = w[occup[k]];
+          ruv += a[k] * wk - uk * av[idim][k];
+          for (size_t j = 0; j < NumOrbitals; j++)
+            y[j] -= wk * table(k, j) + uk * stacked_table(sv(idim) + k, j);
+        }
+        for (size_t k = 0; k < NumPtcls; k++)
+          for (size_t j = 0; j < NumOrbitals; j++)
+            stacked_table(suv(idim) + k, j) = a[k] * y[j] - av[idim][k] * z[j];
+        evaluateTableMixedDerivRatios(stacked_table, su, sv(idim), suv(idim), det_calculator_, tuv);
+
+        ValueType psi_uv = dc_psi_u[idim];
+        for (size_t count = 0; count < nitems; ++count)
+          psi_uv += c[count] *
+              (ruv * ratios_to_ref_[count] + ru * tv[idim][count] + rv[idim] * tu[count] + tuv[count]);
+        if (is_lapl)
+          lapl_grad_psi[i][idim] = psi_uv;
+        else
+          grad_grad_psi[i](idim, jdim) = psi_uv;
+      }
+    }
+  }
+}
+
+void MultiDiracDeterminant::evaluateOneBodyOpIonDerivs(const ValueMatrix& M,
+                                                       const ValueMatrix& B,
+                                                       const RefVector<const ValueMatrix>& dM,
+                                                       const RefVector<const ValueMatrix>& dB,
+                                                       Vector<ValueType>& ratios,
+                                                       Vector<ValueType>& oratios,
+                                                       Vector<GradType>& dratios,
+                                                       Vector<GradType>& doratios) const
+{
+  assert(M.rows() == NumPtcls && M.cols() == NumOrbitals);
+  const auto& occup   = (*ciConfigList)[ReferenceDeterminant].occup;
+  const size_t nitems = DetSigns->size();
+  SmallMatrixDetCalculator<ValueType> calculator;
+  calculator.resize(NumPtcls);
+
+  Matrix<ValueType> minv(NumPtcls, NumPtcls);
+  for (size_t i = 0; i < NumPtcls; i++)
+    for (size_t k = 0; k < NumPtcls; k++)
+      minv(i, k) = M(i, occup[k]);
+  invert_matrix(minv, false);
+
+  // stacked table [T; T_B; T_V; T_BV], O D_I is the derivative of D_I along M + e B
+  const size_t su  = NumPtcls;
+  const size_t sv  = 2 * NumPtcls;
+  const size_t suv = 3 * NumPtcls;
+  OffloadMatrix<ValueType> stacked_table((dM.empty() ? 2 : 4) * NumPtcls, NumOrbitals);
+  Matrix<ValueType> table(stacked_table.data(), NumPtcls, NumOrbitals);
+  Matrix<ValueType> utable(stacked_table[su], NumPtcls, NumOrbitals);
+  MatrixOperators::product(minv, M, table);
+  evaluateTableRatios(stacked_table, calculator, ratios);
+
+  Matrix<ValueType> utable_ref(NumPtcls, NumPtcls);
+  Vector<ValueType> tu;
+  const ValueType ru = buildTableDerivative(minv, table, B, utable, utable_ref);
+  evaluateTableDerivRatios(stacked_table, su, calculator, tu);
+  oratios.resize(nitems);
+  for (size_t count = 0; count < nitems; ++count)
+    oratios[count] = ru * ratios[count] + tu[count];
+
+  if (dM.empty())
+    return;
+  assert(dM.size() == OHMMS_DIM && dB.size() == OHMMS_DIM);
+  dratios.resize(nitems);
+  doratios.resize(nitems);
+  Matrix<ValueType> vtable(stacked_table[sv], NumPtcls, NumOrbitals);
+  Matrix<ValueType> uvtable(stacked_table[suv], NumPtcls, NumOrbitals);
+  Matrix<ValueType> vtable_ref(NumPtcls, NumPtcls), uvtable_ref(NumPtcls, NumPtcls);
+  Matrix<ValueType> correction(NumPtcls, NumOrbitals);
+  Vector<ValueType> tv, tuv;
+  for (int idim = 0; idim < OHMMS_DIM; idim++)
+  {
+    const ValueType rv = buildTableDerivative(minv, table, dM[idim], vtable, vtable_ref);
+    // T_BV = A (dB - dB_0 T) - (A B_0) T_V - (A V_0) T_B
+    ValueType ruv = buildTableDerivative(minv, table, dB[idim], uvtable, uvtable_ref) + ru * rv;
+    MatrixOperators::product(utable_ref, vtable, correction);
+    for (size_t i = 0; i < uvtable.size(); i++)
+      uvtable.data()[i] -= correction.data()[i];
+    MatrixOperators::product(vtable_ref, utable, correction);
+    for (size_t i = 0; i < uvtable.size(); i++)
+      uvtable.data()[i] -= correction.data()[i];
+    for (size_t k = 0; k < NumPtcls; k++)
+      for (size_t l = 0; l < NumPtcls; l++)
+        ruv -= utable_ref(k, l) * vtable_ref(l, k);
+
+    evaluateTableDerivRatios(stacked_table, sv, calculator, tv);
+    evaluateTableMixedDerivRatios(stacked_table, su, sv, suv, calculator, tuv);
+    for (size_t count = 0; count < nitems; ++count)
+    {
+      dratios[count][idim]  = rv * ratios[count] + tv[count];
+      doratios[count][idim] = ruv * ratios[count] + ru * tv[count] + rv * tu[count] + tuv[count];
+    }
+  }
+}
+
 MultiDiracDeterminant::LogValueType MultiDiracDeterminant::updateBuffer(ParticleSet& P,
                                                                         WFBufferType& buf,
                                                                         bool fromscratch)
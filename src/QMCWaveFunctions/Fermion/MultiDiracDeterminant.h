@@ -312,6 +312,64 @@ public:
   // full evaluation of all the structures from scratch, used in evaluateLog for example. Includes spin gradients for spin moves
   void evaluateForWalkerMoveWithSpin(const ParticleSet& P, bool fromScratch = true);
 
+  /** evaluate the gradients of all the unique determinants with respect to an ion position. Used by the table method
+   *
+   * With the table T = A M, where A is the inverse of the reference matrix M_0 and M spans all the orbitals,
+   * the ion derivative of the table is dT = A (dM - dM_0 T) and each excited ratio is differentiated
+   * by Jacobi's formula on its excitation block. See Filippi, Assaraf and Moroni, JCP 144, 194105 (2016).
+   * The reference state (psiM, psiMinv, ratios_to_ref_) must be up to date.
+   * @param P quantum particle set
+   * @param source ion particle set
+   * @param iat ion index
+   * @param dratios [out] the ion gradient of each unique determinant over the reference determinant
+   */
+  void evaluateGradSource(const ParticleSet& P, const ParticleSet& source, int iat, Vector<GradType>& dratios);
+
+  /** evaluate the ion gradients of the electron gradients and laplacians contracted over the unique determinants
+   *
+   * An electron gradient or laplacian U and its ion derivative W only change the row of the electron, so
+   * the table derivatives T_U and T_UV are rank-1 updates of the table and are stacked below T and dT
+   * as in evaluateGradSource. The reference state must be up to date.
+   * @param P quantum particle set
+   * @param source ion particle set
+   * @param iat ion index
+   * @param c expansion weights of the unique determinants, C_otherDs
+   * @param dc ion gradient of c through the other groups
+   * @param grad_psi [out] per electron, sum_I c_I grad_i D_I / D_0
+   * @param lapl_psi [out] per electron, sum_I c_I lapl_i D_I / D_0
+   * @param grad_grad_psi [out] per electron, the ion gradient of grad_psi. (ion dim, electron dim)
+   * @param lapl_grad_psi [out] per electron, the ion gradient of lapl_psi
+   */
+  void evaluateGradSource(const ParticleSet& P,
+                          const ParticleSet& source,
+                          int iat,
+                          const Vector<ValueType>& c,
+                          const Vector<GradType>& dc,
+                          Vector<GradType>& grad_psi,
+                          Vector<ValueType>& lapl_psi,
+                          Vector<HessType>& grad_grad_psi,
+                          Vector<GradType>& lapl_grad_psi);
+
+  /** evaluate a one-body operator and its ion gradient on the unique determinants with the table built from given matrices.
+   * Used by the fast force evaluation, which provides the matrices on all the orbitals of this group.
+   * @param M slater matrix
+   * @param B matrix of the one-body operator, B_ij = O_i phi_j(r_i)
+   * @param dM ion gradient of M by direction, the derivatives are skipped if empty
+   * @param dB ion gradient of B by direction
+   * @param ratios [out] D_I / D_0
+   * @param oratios [out] O D_I / D_0
+   * @param dratios [out] ion gradient of D_I over D_0
+   * @param doratios [out] ion gradient of O D_I over D_0
+   */
+  void evaluateOneBodyOpIonDerivs(const ValueMatrix& M,
+                                  const ValueMatrix& B,
+                                  const RefVector<const ValueMatrix>& dM,
+                                  const RefVector<const ValueMatrix>& dB,
+                                  Vector<ValueType>& ratios,
+                                  Vector<ValueType>& oratios,
+                                  Vector<GradType>& dratios,
+                                  Vector<GradType>& doratios) const;
+
   // accessors
   inline int getNumDets() const { return ciConfigList->size(); }
   inline int getNumPtcls() const { return NumPtcls; }
@@ -509,6 +567,59 @@ private:
       int iat,
       Matrix<ValueType>& ratios);
 
+  /** table derivative T_X = A (X - X_0 T) for a derivative X of the slater matrix
+   * @param minv A, the inverse of the reference matrix
+   * @param table T = A M
+   * @param dpsi X, spanning all the orbitals
+   * @param dtable [out] T_X
+   * @param dtable_ref [out] A X_0
+   * @return tr(A X_0), the derivative of the log of the reference determinant
+   */
+  ValueType buildTableDerivative(const Matrix<ValueType>& minv,
+                                 const Matrix<ValueType>& table,
+                                 const Matrix<ValueType>& dpsi,
+                                 Matrix<ValueType>& dtable,
+                                 Matrix<ValueType>& dtable_ref) const;
+
+  /// determinant of the n x n block of the table whose row and column indices are listed by it
+  static ValueType evaluateBlockDet(const OffloadMatrix<ValueType>& table,
+                                    const int* it,
+                                    size_t n,
+                                    SmallMatrixDetCalculator<ValueType>& calculator)
+  {
+    return n > MaxSmallDet ? calculator.evaluate(table, it, n)
+                           : calcSmallDeterminant(n, table.data(), it, table.cols());
+  }
+
+  /** table method on a stacked table [T; T_U; ...] whose first NumPtcls rows are T
+   * @param table stacked table
+   * @param calculator workspace for the excitations beyond MaxSmallDet
+   * @param ratios [out] sign * det of the excitation block of each unique determinant
+   */
+  void evaluateTableRatios(const OffloadMatrix<ValueType>& table,
+                           SmallMatrixDetCalculator<ValueType>& calculator,
+                           Vector<ValueType>& ratios) const;
+
+  /** first derivative of the excitation blocks by Jacobi's formula
+   * @param su row offset of T_U in the stacked table
+   * @param dratios [out] sign * sum_k det of the block with its k-th row taken from T_U
+   */
+  void evaluateTableDerivRatios(const OffloadMatrix<ValueType>& table,
+                                size_t su,
+                                SmallMatrixDetCalculator<ValueType>& calculator,
+                                Vector<ValueType>& dratios) const;
+
+  /** mixed second derivative of the excitation blocks
+   * @param su, sv, suv row offsets of T_U, T_V and T_UV in the stacked table
+   * @param dratios [out] sign * (sum_k det(row k from T_UV) + sum_{k!=l} det(row k from T_U, row l from T_V))
+   */
+  void evaluateTableMixedDerivRatios(const OffloadMatrix<ValueType>& table,
+                                     size_t su,
+                                     size_t sv,
+                                     size_t suv,
+                                     SmallMatrixDetCalculator<ValueType>& calculator,
+                                     Vector<ValueType>& dratios) const;
+
   ///reset the size: with the number of particles
   void resize();
 
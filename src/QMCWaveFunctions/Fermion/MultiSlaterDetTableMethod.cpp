@@ -15,14 +15,18 @@
 
 #include "MultiSlaterDetTableMethod.h"
 #include "QMCWaveFunctions/Fermion/MultiDiracDeterminant.h"
+#include "QMCWaveFunctions/TWFFastDerivWrapper.h"
 #include "ParticleBase/ParticleAttribOps.h"
 #include "Platforms/OMPTarget/ompReductionComplex.hpp"
+#include <array>
+#include <limits>
 
 namespace qmcplusplus
 {
 MultiSlaterDetTableMethod::MultiSlaterDetTableMethod(ParticleSet& targetPtcl,
                                                      std::vector<std::unique_ptr<MultiDiracDeterminant>>&& dets,
-                                                     bool use_pre_computing)
+                                                     bool use_pre_computing,
+                                                     bool use_lean_storage)
     : OptimizableObject("CI"),
       RatioTimer(*timer_manager.createTimer(getClassName() + "::ratio")),
       offload_timer(*timer_manager.createTimer(getClassName() + "::offload")),
@@ -33,10 +37,12 @@ MultiSlaterDetTableMethod::MultiSlaterDetTableMethod(ParticleSet& targetPtcl,
       AccRejTimer(*timer_manager.createTimer(getClassName() + "::Accept_Reject")),
       EvaluateTimer(*timer_manager.createTimer(getClassName() + "::evaluate")),
       CI_Optimizable(false),
-      use_pre_computing_(use_pre_computing)
+      use_pre_computing_(use_pre_computing),
+      lean_storage_(use_lean_storage),
+      lean_group_(-1)
 {
   Dets = std::move(dets);
-  C_otherDs.resize(Dets.size());
+  C_otherDs.resize(lean_storage_ ? 1 : Dets.size());
   int NP = targetPtcl.getTotalNum();
   myG.resize(NP);
   myL.resize(NP);
@@ -60,6 +66,26 @@ void MultiSlaterDetTableMethod::initialize(std::unique_ptr<std::vector<std::vect
   myVars         = std::move(myVars_in);
   csf_data_      = std::move(csf_data_in);
   CI_Optimizable = CI_optimizable;
+
+  if (lean_storage_)
+  {
+    const size_t ngroups = Dets.size();
+    const size_t nc      = C->size();
+    auto ci_index        = std::make_shared<std::vector<uint32_t>>(nc * ngroups);
+    for (size_t id = 0; id < ngroups; id++)
+    {
+      if (Dets[id]->getNumDets() > std::numeric_limits<uint32_t>::max())
+        throw std::runtime_error(
+            "MultiSlaterDetTableMethod::initialize too many unique determinants for 32-bit indices.");
+      for (size_t i = 0; i < nc; i++)
+        (*ci_index)[i * ngroups + id] = (*C2node)[id][i];
+    }
+    ci_index_ = std::move(ci_index);
+
+    // the full width map is only used by the parameter derivatives
+    if (!optimizable)
+      C2node.reset();
+  }
 }
 
 MultiSlaterDetTableMethod::~MultiSlaterDetTableMethod() = default;
@@ -70,10 +96,12 @@ std::unique_ptr<WaveFunctionComponent> MultiSlaterDetTableMethod::makeClone(Part
   for (auto& det : Dets)
     dets_clone.emplace_back(std::make_unique<MultiDiracDeterminant>(*det));
 
-  auto clone = std::make_unique<MultiSlaterDetTableMethod>(tqp, std::move(dets_clone), use_pre_computing_);
+  auto clone =
+      std::make_unique<MultiSlaterDetTableMethod>(tqp, std::move(dets_clone), use_pre_computing_, lean_storage_);
 
   clone->CI_Optimizable = CI_Optimizable;
   clone->C2node         = C2node;
+  clone->ci_index_      = ci_index_;
   clone->C              = C;
   clone->myVars         = myVars;
 
@@ -98,19 +126,23 @@ WaveFunctionComponent::LogValueType MultiSlaterDetTableMethod::evaluate_vgl_impl
   g_tmp                 = czero;
   l_tmp                 = czero;
 
-  for (size_t ig = 0; ig < Dets.size(); ig++)
-    precomputeC_otherDs(P, ig);
+  // groups are handled one at a time such that the lean storage mode only needs a single C_otherDs buffer
+  for (size_t id = 0; id < Dets.size(); id++)
+  {
+    precomputeC_otherDs(P, id);
+    const auto& c_other_ds = getC_otherDs(id);
 
-  for (size_t i = 0; i < Dets[0]->getNumDets(); ++i)
-    psi_ratio_to_ref_det_ += C_otherDs[0][i] * Dets[0]->getRatiosToRefDet()[i];
+    if (id == 0)
+      for (size_t i = 0; i < Dets[0]->getNumDets(); ++i)
+        psi_ratio_to_ref_det_ += c_other_ds[i] * Dets[0]->getRatiosToRefDet()[i];
 
-  for (size_t id = 0; id < Dets.size(); id++)
     for (size_t i = 0; i < Dets[id]->getNumDets(); ++i)
       for (int k = 0, n = Dets[id]->getFirstIndex(); k < Dets[id]->getNumPtcls(); k++, n++)
       {
-        g_tmp[n] += C_otherDs[id][i] * Dets[id]->getGrads()(i, k);
-        l_tmp[n] += C_otherDs[id][i] * Dets[id]->getLapls()(i, k);
+        g_tmp[n] += c_other_ds[i] * Dets[id]->getGrads()(i, k);
+        l_tmp[n] += c_other_ds[i] * Dets[id]->getLapls()(i, k);
       }
+  }
 
   ValueType psiinv = static_cast<ValueType>(PsiValueType(1.0) / psi_ratio_to_ref_det_);
   g_tmp *= psiinv;
@@ -167,15 +199,16 @@ WaveFunctionComponent::PsiValueType MultiSlaterDetTableMethod::evalGrad_impl(Par
   const auto& grads = (newpos) ? Dets[det_id]->getNewGrads() : Dets[det_id]->getGrads();
   const OffloadVector<ValueType>& detValues0 =
       (newpos) ? Dets[det_id]->getNewRatiosToRefDet() : Dets[det_id]->getRatiosToRefDet();
-  const size_t noffset = Dets[det_id]->getFirstIndex();
+  const size_t noffset                      = Dets[det_id]->getFirstIndex();
+  const OffloadVector<ValueType>& c_other_ds = getC_otherDs(det_id);
 
   PsiValueType psi(0);
   // enforce full precision reduction due to numerical sensitivity
   QTFull::GradType g_sum;
   for (size_t i = 0; i < Dets[det_id]->getNumDets(); i++)
   {
-    psi += detValues0[i] * C_otherDs[det_id][i];
-    g_sum += C_otherDs[det_id][i] * grads(i, iat - noffset);
+    psi += detValues0[i] * c_other_ds[i];
+    g_sum += c_other_ds[i] * grads(i, iat - noffset);
   }
 
   g_at = g_sum / psi;
@@ -200,13 +233,14 @@ WaveFunctionComponent::PsiValueType MultiSlaterDetTableMethod::evalGradWithSpin_
       (newpos) ? Dets[det_id]->getNewRatiosToRefDet() : Dets[det_id]->getRatiosToRefDet();
   const Matrix<ValueType>& spingrads = (newpos) ? Dets[det_id]->getNewSpinGrads() : Dets[det_id]->getSpinGrads();
   const size_t noffset               = Dets[det_id]->getFirstIndex();
+  const auto& c_other_ds             = getC_otherDs(det_id);
 
   PsiValueType psi(0);
   for (size_t i = 0; i < Dets[det_id]->getNumDets(); i++)
   {
-    psi += detValues0[i] * C_otherDs[det_id][i];
-    g_at += C_otherDs[det_id][i] * grads(i, iat - noffset);
-    sg_at += C_otherDs[det_id][i] * spingrads(i, iat - noffset);
+    psi += detValues0[i] * c_other_ds[i];
+    g_at += c_other_ds[i] * grads(i, iat - noffset);
+    sg_at += c_other_ds[i] * spingrads(i, iat - noffset);
   }
   g_at *= PsiValueType(1.0) / psi;
   sg_at *= PsiValueType(1.0) / psi;
@@ -306,18 +340,18 @@ WaveFunctionComponent::PsiValueType MultiSlaterDetTableMethod::evalGrad_impl_no_
 
   const auto& grads              = (newpos) ? Dets[det_id]->getNewGrads() : Dets[det_id]->getGrads();
   const auto& detValues0         = (newpos) ? Dets[det_id]->getNewRatiosToRefDet() : Dets[det_id]->getRatiosToRefDet();
-  const size_t* restrict det0    = (*C2node)[det_id].data();
   const ValueType* restrict cptr = C->data();
   const size_t nc                = C->size();
+  const size_t ngroups           = Dets.size();
   const size_t noffset           = Dets[det_id]->getFirstIndex();
   PsiValueType psi(0);
   for (size_t i = 0; i < nc; ++i)
   {
-    const size_t d0 = det0[i];
+    const size_t d0 = getUniqueDetID(i, det_id);
     ValueType t     = cptr[i];
-    for (size_t id = 0; id < Dets.size(); id++)
+    for (size_t id = 0; id < ngroups; id++)
       if (id != det_id)
-        t *= Dets[id]->getRatiosToRefDet()[(*C2node)[id][i]];
+        t *= Dets[id]->getRatiosToRefDet()[getUniqueDetID(i, id)];
     psi += t * detValues0[d0];
     g_at += t * grads(d0, iat - noffset);
   }
@@ -341,18 +375,18 @@ WaveFunctionComponent::PsiValueType MultiSlaterDetTableMethod::evalGradWithSpin_
   const auto& grads              = (newpos) ? Dets[det_id]->getNewGrads() : Dets[det_id]->getGrads();
   const auto& detValues0         = (newpos) ? Dets[det_id]->getNewRatiosToRefDet() : Dets[det_id]->getRatiosToRefDet();
   const auto& spingrads          = (newpos) ? Dets[det_id]->getNewSpinGrads() : Dets[det_id]->getSpinGrads();
-  const size_t* restrict det0    = (*C2node)[det_id].data();
   const ValueType* restrict cptr = C->data();
   const size_t nc                = C->size();
+  const size_t ngroups           = Dets.size();
   const size_t noffset           = Dets[det_id]->getFirstIndex();
   PsiValueType psi(0);
   for (size_t i = 0; i < nc; ++i)
   {
-    const size_t d0 = det0[i];
+    const size_t d0 = getUniqueDetID(i, det_id);
     ValueType t     = cptr[i];
-    for (size_t id = 0; id < Dets.size(); id++)
+    for (size_t id = 0; id < ngroups; id++)
       if (id != det_id)
-        t *= Dets[id]->getRatiosToRefDet()[(*C2node)[id][i]];
+        t *= Dets[id]->getRatiosToRefDet()[getUniqueDetID(i, id)];
     psi += t * detValues0[d0];
     g_at += t * grads(d0, iat - noffset);
     sg_at += t * spingrads(d0, iat - noffset);
@@ -494,22 +528,23 @@ WaveFunctionComponent::PsiValueType MultiSlaterDetTableMethod::computeRatio_NewM
     // psi=Det_Coeff[i]*Det_Value[unique_det_up]*Det_Value[unique_det_dn]*Det_Value[unique_det_AnyOtherType]
     // Since only one electron group is moved at the time, identified by det_id, We precompute:
     // C_otherDs[det_id][i]=Det_Coeff[i]*Det_Value[unique_det_dn]*Det_Value[unique_det_AnyOtherType]
+    const auto& c_other_ds = getC_otherDs(det_id);
     for (size_t i = 0; i < Dets[det_id]->getNumDets(); i++)
-      psi += detValues0[i] * C_otherDs[det_id][i];
+      psi += detValues0[i] * c_other_ds[i];
   }
   else
   {
-    const size_t* restrict det0    = (*C2node)[det_id].data();
     const ValueType* restrict cptr = C->data();
     const size_t nc                = C->size();
+    const size_t ngroups           = Dets.size();
 
     for (size_t i = 0; i < nc; ++i)
     {
       ValueType t = cptr[i];
-      for (size_t id = 0; id < Dets.size(); id++)
+      for (size_t id = 0; id < ngroups; id++)
         if (id != det_id)
-          t *= Dets[id]->getRatiosToRefDet()[(*C2node)[id][i]];
-      t *= detValues0[det0[i]];
+          t *= Dets[id]->getRatiosToRefDet()[getUniqueDetID(i, id)];
+      t *= detValues0[getUniqueDetID(i, det_id)];
       psi += t;
     }
   }
@@ -523,6 +558,8 @@ WaveFunctionComponent::PsiValueType MultiSlaterDetTableMethod::ratio(ParticleSet
   UpdateMode = ORB_PBYP_RATIO;
 
   const int det_id = getDetID(iat);
+  if (use_pre_computing_)
+    ensureC_otherDs(P, det_id);
   Dets[det_id]->evaluateDetsForPtclMove(P, iat);
 
   new_psi_ratio_to_new_ref_det_ = computeRatio_NewMultiDet_to_NewRefDet(det_id);
@@ -559,15 +596,21 @@ void MultiSlaterDetTableMethod::mw_calcRatio(const RefVectorWithLeader<WaveFunct
 
   det_leader.Dets[det_id]->mw_evaluateDetsForPtclMove(det_list, P_list, iat);
 
+  // calcRatio may be called for a group other than the prepared one, e.g. by NLPP or OBDM
   auto& det_value_ptr_list = det_leader.mw_res_->det_value_ptr_list;
+  auto& C_otherDs_ptr_list = det_leader.mw_res_->C_otherDs_ptr_list;
   det_value_ptr_list.resize(nw);
+  C_otherDs_ptr_list.resize(nw);
   for (size_t iw = 0; iw < nw; iw++)
   {
     auto& det      = WFC_list.getCastedElement<MultiSlaterDetTableMethod>(iw);
     det.UpdateMode = ORB_PBYP_RATIO;
+    det.ensureC_otherDs(P_list[iw], det_id);
 
     det_value_ptr_list[iw] = det.Dets[det_id]->getNewRatiosToRefDet().device_data();
+    C_otherDs_ptr_list[iw] = det.getC_otherDs(det_id).device_data();
   }
+  C_otherDs_ptr_list.updateTo();
 
   std::vector<PsiValueType> psi_list(nw, 0);
   auto* psi_list_ptr           = psi_list.data();
@@ -602,6 +645,8 @@ void MultiSlaterDetTableMethod::evaluateRatios(const VirtualParticleSet& VP, std
   ScopedTimer local_timer(RatioTimer);
 
   const int det_id = getDetID(VP.refPtcl);
+  if (use_pre_computing_)
+    ensureC_otherDs(VP, det_id);
 
   for (size_t iat = 0; iat < VP.getTotalNum(); ++iat)
   {
@@ -613,6 +658,201 @@ void MultiSlaterDetTableMethod::evaluateRatios(const VirtualParticleSet& VP, std
   }
 }
 
+template<typename VT>
+void MultiSlaterDetTableMethod::contractOtherGroups(int ig,
+                                                    const std::vector<const ValueType*>& values,
+                                                    int jg,
+                                                    const VT* dvalues,
+                                                    Vector<VT>& c) const
+{
+  c.resize(Dets[ig]->getNumDets());
+  std::fill(c.begin(), c.end(), VT());
+
+  const ValueType* restrict cptr = C->data();
+  const size_t nc                = C->size();
+  const int ngroups              = Dets.size();
+  for (size_t i = 0; i < nc; i++)
+  {
+    ValueType product = cptr[i];
+    for (int id = 0; id < ngroups; id++)
+      if (id != ig && id != jg)
+        product *= values[id][getUniqueDetID(i, id)];
+    if (jg < 0)
+      c[getUniqueDetID(i, ig)] += product;
+    else
+      c[getUniqueDetID(i, ig)] += product * dvalues[getUniqueDetID(i, jg)];
+  }
+}
+
+WaveFunctionComponent::GradType MultiSlaterDetTableMethod::evalGradSource(ParticleSet& P,
+                                                                          ParticleSet& source,
+                                                                          int iat)
+{
+  GradType grad_iat;
+  PsiValueType psi_ratio_to_ref_det(0);
+  Vector<GradType> dratios;
+  for (size_t id = 0; id < Dets.size(); id++)
+  {
+    Dets[id]->evaluateGradSource(P, source, iat, dratios);
+    precomputeC_otherDs(P, id);
+    const auto& c_other_ds = getC_otherDs(id);
+
+    if (id == 0)
+      for (size_t i = 0; i < Dets[0]->getNumDets(); ++i)
+        psi_ratio_to_ref_det += c_other_ds[i] * Dets[0]->getRatiosToRefDet()[i];
+
+    for (size_t i = 0; i < Dets[id]->getNumDets(); ++i)
+      grad_iat += c_other_ds[i] * dratios[i];
+  }
+  return grad_iat * static_cast<ValueType>(PsiValueType(1.0) / psi_ratio_to_ref_det);
+}
+
+WaveFunctionComponent::GradType MultiSlaterDetTableMethod::evalGradSource(
+    ParticleSet& P,
+    ParticleSet& source,
+    int iat,
+    TinyVector<ParticleSet::ParticleGradient, OHMMS_DIM>& grad_grad,
+    TinyVector<ParticleSet::ParticleLaplacian, OHMMS_DIM>& lapl_grad)
+{
+  const size_t ngroups = Dets.size();
+  std::vector<const ValueType*> ratios(ngroups);
+  std::vector<Vector<GradType>> dratios(ngroups);
+  for (size_t id = 0; id < ngroups; id++)
+  {
+    Dets[id]->evaluateGradSource(P, source, iat, dratios[id]);
+    ratios[id] = Dets[id]->getRatiosToRefDet().data();
+  }
+
+  // C_otherDs of each group and its ion gradient through the other groups
+  std::vector<Vector<ValueType>> c(ngroups);
+  std::vector<Vector<GradType>> dc(ngroups);
+  Vector<GradType> dc_other;
+  ValueType psi(0);
+  GradType dpsi;
+  for (size_t id = 0; id < ngroups; id++)
+  {
+    contractOtherGroups<ValueType>(id, ratios, -1, nullptr, c[id]);
+    dc[id].resize(Dets[id]->getNumDets());
+    std::fill(dc[id].begin(), dc[id].end(), GradType());
+    for (size_t jd = 0; jd < ngroups; jd++)
+      if (jd != id)
+      {
+        contractOtherGroups(id, ratios, jd, dratios[jd].data(), dc_other);
+        dc[id] += dc_other;
+      }
+
+    if (id == 0)
+      for (size_t i = 0; i < Dets[0]->getNumDets(); ++i)
+        psi += c[0][i] * ratios[0][i];
+    for (size_t i = 0; i < Dets[id]->getNumDets(); ++i)
+      dpsi += c[id][i] * dratios[id][i];
+  }
+
+  const ValueType psi_inv = ValueType(1) / psi;
+  Vector<GradType> grad_psi, lapl_grad_psi;
+  Vector<ValueType> lapl_psi;
+  Vector<HessType> grad_grad_psi;
+  for (size_t id = 0; id < ngroups; id++)
+  {
+    Dets[id]->evaluateGradSource(P, source, iat, c[id], dc[id], grad_psi, lapl_psi, grad_grad_psi, lapl_grad_psi);
+    for (size_t i = 0, iel = Dets[id]->getFirstIndex(); i < Dets[id]->getNumPtcls(); i++, iel++)
+    {
+      const GradType g  = grad_psi[i] * psi_inv;
+      const ValueType l = lapl_psi[i] * psi_inv;
+      for (int idim = 0; idim < OHMMS_DIM; idim++)
+      {
+        GradType dg;
+        for (int jdim = 0; jdim < OHMMS_DIM; jdim++)
+          dg[jdim] = (grad_grad_psi[i](idim, jdim) - g[jdim] * dpsi[idim]) * psi_inv;
+        grad_grad[idim][iel] += dg;
+        // lapl log(psi) = lapl psi / psi - (grad psi / psi)^2
+        lapl_grad[idim][iel] += (lapl_grad_psi[i][idim] - l * dpsi[idim]) * psi_inv - ValueType(2) * dot(g, dg);
+      }
+    }
+  }
+  return dpsi * psi_inv;
+}
+
+void MultiSlaterDetTableMethod::registerTWFFastDerivWrapper(const ParticleSet& P, TWFFastDerivWrapper& twf) const
+{
+  std::vector<TWFFastDerivWrapper::IndexType> groups;
+  for (auto& det : Dets)
+  {
+    groups.push_back(P.getGroupID(det->getFirstIndex()));
+    twf.addGroup(P, groups.back(), det->getPhi());
+  }
+  twf.addMultiSlaterDet(this, groups);
+}
+
+WaveFunctionComponent::ValueType MultiSlaterDetTableMethod::evaluateOneBodyOpIonDerivs(
+    const RefVector<const ValueMatrix>& M,
+    const RefVector<const ValueMatrix>& B,
+    const std::vector<RefVector<const ValueMatrix>>& dM,
+    const std::vector<RefVector<const ValueMatrix>>& dB,
+    GradType& dlogpsi,
+    GradType& dO) const
+{
+  const size_t ngroups   = Dets.size();
+  const bool with_derivs = !dM.empty();
+  std::vector<Vector<ValueType>> ratios(ngroups), oratios(ngroups);
+  std::vector<Vector<GradType>> dratios(ngroups), doratios(ngroups);
+  std::vector<const ValueType*> ratio_ptrs(ngroups);
+  RefVector<const ValueMatrix> dM_group, dB_group;
+  for (size_t id = 0; id < ngroups; id++)
+  {
+    dM_group.clear();
+    dB_group.clear();
+    if (with_derivs)
+      for (int idim = 0; idim < OHMMS_DIM; idim++)
+      {
+        dM_group.push_back(dM[idim][id]);
+        dB_group.push_back(dB[idim][id]);
+      }
+    Dets[id]->evaluateOneBodyOpIonDerivs(M[id], B[id], dM_group, dB_group, ratios[id], oratios[id], dratios[id],
+                                         doratios[id]);
+    ratio_ptrs[id] = ratios[id].data();
+  }
+
+  // O is a sum of one-body operators, O psi is the sum over the groups of the expansion with one group acted on
+  ValueType psi(0), opsi(0);
+  GradType dpsi, dopsi;
+  Vector<ValueType> c;
+  Vector<GradType> dc;
+  for (size_t id = 0; id < ngroups; id++)
+  {
+    contractOtherGroups<ValueType>(id, ratio_ptrs, -1, nullptr, c);
+    for (size_t i = 0; i < Dets[id]->getNumDets(); ++i)
+      opsi += c[i] * oratios[id][i];
+    if (id == 0)
+      for (size_t i = 0; i < Dets[0]->getNumDets(); ++i)
+        psi += c[i] * ratios[0][i];
+    if (!with_derivs)
+      continue;
+
+    for (size_t i = 0; i < Dets[id]->getNumDets(); ++i)
+    {
+      dpsi += c[i] * dratios[id][i];
+      dopsi += c[i] * doratios[id][i];
+    }
+    for (size_t jd = 0; jd < ngroups; jd++)
+      if (jd != id)
+      {
+        contractOtherGroups(id, ratio_ptrs, jd, dratios[jd].data(), dc);
+        for (size_t i = 0; i < Dets[id]->getNumDets(); ++i)
+          dopsi += dc[i] * oratios[id][i];
+      }
+  }
+
+  const ValueType psi_inv = ValueType(1) / psi;
+  const ValueType o       = opsi * psi_inv;
+  if (with_derivs)
+  {
+    dlogpsi = dpsi * psi_inv;
+    dO      = (dopsi - o * dpsi) * psi_inv;
+  }
+  return o;
+}
+
 void MultiSlaterDetTableMethod::acceptMove(ParticleSet& P, int iat, bool safe_to_delay)
 {
   // this should depend on the type of update, ratio / ratioGrad
@@ -623,7 +863,11 @@ void MultiSlaterDetTableMethod::acceptMove(ParticleSet& P, int iat, bool safe_to
   log_value_ += convertValueToLog(curRatio);
   curRatio = 1.0;
 
-  Dets[getDetID(iat)]->acceptMove(P, iat, safe_to_delay);
+  const int det_id = getDetID(iat);
+  // C_otherDs of the moving group doesn't depend on it, any other group becomes stale.
+  if (lean_group_ != det_id)
+    lean_group_ = -1;
+  Dets[det_id]->acceptMove(P, iat, safe_to_delay);
 }
 
 void MultiSlaterDetTableMethod::restore(int iat)
@@ -640,6 +884,7 @@ void MultiSlaterDetTableMethod::mw_accept_rejectMove(const RefVectorWithLeader<W
                                                      bool safe_to_delay) const
 {
   ScopedTimer local_timer(AccRejTimer);
+  const auto det_id = getDetID(iat);
   for (size_t iw = 0; iw < isAccepted.size(); iw++)
   {
     auto& det = wfc_list.getCastedElement<MultiSlaterDetTableMethod>(iw);
@@ -647,10 +892,11 @@ void MultiSlaterDetTableMethod::mw_accept_rejectMove(const RefVectorWithLeader<W
     {
       det.psi_ratio_to_ref_det_ = det.new_psi_ratio_to_new_ref_det_;
       det.log_value_ += convertValueToLog(det.curRatio);
+      if (det.lean_group_ != det_id)
+        det.lean_group_ = -1;
     }
     det.curRatio = 1.0;
   }
-  const auto det_id = getDetID(iat);
   const auto det_list(extract_DetRef_list(wfc_list, det_id));
   Dets[det_id]->mw_accept_rejectMove(det_list, p_list, iat, isAccepted);
 }
@@ -692,6 +938,7 @@ void MultiSlaterDetTableMethod::copyFromBuffer(ParticleSet& P, WFBufferType& buf
 
   buf.get(log_value_);
   buf.get(psi_ratio_to_ref_det_);
+  lean_group_ = -1;
 }
 
 void MultiSlaterDetTableMethod::extractOptimizableObjectRefs(UniqueOptObjRefs& opt_obj_refs)
@@ -803,14 +1050,18 @@ void MultiSlaterDetTableMethod::evaluateDerivatives(ParticleSet& P,
       ValueType lapl_sum = 0.0;
       myG_temp           = 0.0;
       for (size_t id = 0; id < Dets.size(); id++)
+      {
+        // assume C_otherDs prepared by evaluateLog already
+        ensureC_otherDs(P, id);
+        const auto& c_other_ds = getC_otherDs(id);
         for (size_t i = 0; i < Dets[id]->getNumDets(); i++)
         {
-          // assume C_otherDs prepared by evaluateLog already
-          ValueType tmp = C_otherDs[id][i] * psiinv;
+          ValueType tmp = c_other_ds[i] * psiinv;
           lapl_sum += tmp * laplSum[id][i];
           for (size_t k = 0, j = Dets[id]->getFirstIndex(); k < Dets[id]->getNumPtcls(); k++, j++)
             myG_temp[j] += tmp * Dets[id]->getGrads()(i, k);
         }
+      }
 
       ValueType gg = 0.0;
       for (size_t i = 0; i < P.getTotalNum(); i++)
@@ -1033,6 +1284,9 @@ void MultiSlaterDetTableMethod::evaluateDerivRatios(const VirtualParticleSet& VP
         recalculate = true;
     }
 
+  if (use_pre_computing_)
+    ensureC_otherDs(VP, det_id);
+
   // calculate derivatives based on the reference electron position
   Vector<ValueType> dlogpsi_ref, dlogpsi_vp;
   if (recalculate)
@@ -1098,7 +1352,8 @@ void MultiSlaterDetTableMethod::evaluateMultiDiracDeterminantDerivativesWF(Parti
 void MultiSlaterDetTableMethod::buildOptVariables()
 {
   for (size_t id = 0; id < Dets.size(); id++)
-    Dets[id]->buildOptVariables((*C2node)[id]);
+    if (Dets[id]->isOptimizable())
+      Dets[id]->buildOptVariables((*C2node)[id]);
 }
 
 void MultiSlaterDetTableMethod::prepareGroup(ParticleSet& P, int ig)
@@ -1125,7 +1380,7 @@ void MultiSlaterDetTableMethod::mw_prepareGroup(const RefVectorWithLeader<WaveFu
   {
     auto& det = wfc_list.getCastedElement<MultiSlaterDetTableMethod>(iw);
     det.prepareGroup(p_list[iw], ig);
-    C_otherDs_ptr_list[iw] = det.C_otherDs[ig].device_data();
+    C_otherDs_ptr_list[iw] = det.getC_otherDs(ig).device_data();
   }
   C_otherDs_ptr_list.updateTo();
 }
@@ -1146,20 +1401,38 @@ void MultiSlaterDetTableMethod::precomputeC_otherDs(const ParticleSet& P, int ig
   // C_otherDs(1, :) stores C x D_up x D_pos
   // C_otherDs(2, :) stores C x D_up x D_dn
 
+  // The expansion is streamed in blocks of CIBlockSize terms. The products of each block are gathered
+  // group by group into a buffer which stays in L1 and then scattered to the unique determinants of group ig.
+
   ScopedTimer local_timer(PrepareGroupTimer);
-  C_otherDs[ig].resize(Dets[ig]->getNumDets());
-  std::fill(C_otherDs[ig].begin(), C_otherDs[ig].end(), ValueType(0));
-  for (size_t i = 0; i < C->size(); i++)
+  auto& c_other_ds = C_otherDs[lean_storage_ ? 0 : ig];
+  c_other_ds.resize(Dets[ig]->getNumDets());
+  std::fill(c_other_ds.begin(), c_other_ds.end(), ValueType(0));
+
+  const ValueType* restrict cptr = C->data();
+  const size_t nc                = C->size();
+  const size_t ngroups           = Dets.size();
+  // enforce full precision reduction on C_otherDs due to numerical sensitivity
+  std::array<PsiValueType, CIBlockSize> products;
+  for (size_t first = 0; first < nc; first += CIBlockSize)
   {
-    // enforce full precision reduction on C_otherDs due to numerical sensitivity
-    PsiValueType product = (*C)[i];
-    for (size_t id = 0; id < Dets.size(); id++)
+    const size_t nb = std::min(CIBlockSize, nc - first);
+    for (size_t i = 0; i < nb; i++)
+      products[i] = cptr[first + i];
+    for (size_t id = 0; id < ngroups; id++)
       if (id != ig)
-        product *= Dets[id]->getRatiosToRefDet()[(*C2node)[id][i]];
-    C_otherDs[ig][(*C2node)[ig][i]] += product;
+      {
+        const ValueType* restrict ratios = Dets[id]->getRatiosToRefDet().data();
+        for (size_t i = 0; i < nb; i++)
+          products[i] *= ratios[getUniqueDetID(first + i, id)];
+      }
+    for (size_t i = 0; i < nb; i++)
+      c_other_ds[getUniqueDetID(first + i, ig)] += products[i];
   }
   //put C_otherDs in device
-  C_otherDs[ig].updateTo();
+  c_other_ds.updateTo();
+  if (lean_storage_)
+    lean_group_ = ig;
 }
 
 void MultiSlaterDetTableMethod::createResource(ResourceCollection& collection) const
@@ -87,10 +87,16 @@ public:
   using Walker_t    = ParticleSet::Walker_t;
 
 
-  ///constructor
+  /** constructor
+   * @param targetPtcl target particle set
+   * @param dets determinants of each particle group
+   * @param use_pre_computing use the precomputed table method
+   * @param use_lean_storage keep only the minimal per-walker CI state and recompute the rest on demand
+   */
   MultiSlaterDetTableMethod(ParticleSet& targetPtcl,
                             std::vector<std::unique_ptr<MultiDiracDeterminant>>&& dets,
-                            bool use_pre_computing);
+                            bool use_pre_computing,
+                            bool use_lean_storage = false);
 
   ///destructor
   ~MultiSlaterDetTableMethod() override;
@@ -151,6 +157,41 @@ public:
   PsiValueType ratioGradWithSpin(ParticleSet& P, int iat, GradType& grad_iat, ComplexType& spingrad_iat) override;
 
   void evaluateRatios(const VirtualParticleSet& VP, std::vector<ValueType>& ratios) override;
+  /** ion gradient of log(psi) from the ion gradients of the unique determinants of each group.
+   *  The CI contraction reuses C_otherDs as done for the electron gradients in evaluate_vgl_impl.
+   */
+  GradType evalGradSource(ParticleSet& P, ParticleSet& source, int iat) override;
+
+  /** ion gradient of log(psi) and the ion gradients of the electron gradients and laplacians of log(psi),
+   *  needed by the kinetic energy force. Each group contracts the table method derivatives of its unique
+   *  determinants with C_otherDs and with the ion gradient of C_otherDs through the other groups.
+   */
+  GradType evalGradSource(ParticleSet& P,
+                          ParticleSet& source,
+                          int iat,
+                          TinyVector<ParticleSet::ParticleGradient, OHMMS_DIM>& grad_grad,
+                          TinyVector<ParticleSet::ParticleLaplacian, OHMMS_DIM>& lapl_grad) override;
+
+  /** register the groups and their SPOSets, the fast force evaluation then contracts over the expansion
+   *  with evaluateOneBodyOpIonDerivs
+   */
+  void registerTWFFastDerivWrapper(const ParticleSet& P, TWFFastDerivWrapper& twf) const override;
+
+  /** one-body operator O and its ion gradient on the multideterminant by the table method.
+   * @param M slater matrices on all the orbitals, in the order of the groups
+   * @param B matrices of the operator, B_ij = O_i phi_j(r_i)
+   * @param dM ion gradients of M, [direction][group]. Only O psi / psi is computed if empty
+   * @param dB ion gradients of B, [direction][group]
+   * @param dlogpsi [out] ion gradient of log(psi)
+   * @param dO [out] ion gradient of O psi / psi
+   * @return O psi / psi
+   */
+  ValueType evaluateOneBodyOpIonDerivs(const RefVector<const ValueMatrix>& M,
+                                       const RefVector<const ValueMatrix>& B,
+                                       const std::vector<RefVector<const ValueMatrix>>& dM,
+                                       const std::vector<RefVector<const ValueMatrix>>& dB,
+                                       GradType& dlogpsi,
+                                       GradType& dO) const;
 
   void evaluateRatiosAlltoOne(ParticleSet& P, std::vector<ValueType>& ratios) override
   {
@@ -216,6 +257,26 @@ private:
     return id;
   }
 
+  /// unique det id of group id in the CI term i, read from ci_index_ in the lean storage mode and C2node otherwise
+  inline size_t getUniqueDetID(size_t i, size_t id) const
+  {
+    return lean_storage_ ? (*ci_index_)[i * Dets.size() + id] : (*C2node)[id][i];
+  }
+
+  /// C_otherDs of group ig. In the lean storage mode, only the last precomputed group is kept.
+  inline const OffloadVector<ValueType>& getC_otherDs(int ig) const
+  {
+    assert(!lean_storage_ || lean_group_ == ig);
+    return C_otherDs[lean_storage_ ? 0 : ig];
+  }
+
+  /// make C_otherDs of group ig available. Only recomputes in the lean storage mode if the buffer is stale.
+  inline void ensureC_otherDs(const ParticleSet& P, int ig)
+  {
+    if (lean_storage_ && lean_group_ != ig)
+      precomputeC_otherDs(P, ig);
+  }
+
   /** an implementation shared by evalGrad and ratioGrad. Use precomputed data
    * @param newpos to distinguish evalGrad(false) ratioGrad(true)
    */
@@ -245,6 +306,17 @@ private:
   // compute the new multi determinant to reference determinant ratio based on temporarycoordinates.
   PsiValueType computeRatio_NewMultiDet_to_NewRefDet(int det_id) const;
 
+  /** contract the CI coefficients over all the groups but ig for given values of the unique determinants
+   * c[I] = sum_{k, I_ig(k) = I} C_k prod_{id != ig} values[id][I_id(k)]
+   * @param jg if not negative, the values of this group are replaced by dvalues to get the derivative of c
+   */
+  template<typename VT>
+  void contractOtherGroups(int ig,
+                           const std::vector<const ValueType*>& values,
+                           int jg,
+                           const VT* dvalues,
+                           Vector<VT>& c) const;
+
   /** precompute C_otherDs for a given particle group
    * @param P a particle set
    * @param ig group id
@@ -274,8 +346,15 @@ private:
 
   /** map determinant in linear combination to unique det list
    * map global det id to unique det id. [spin, global det id] = unique det id
+   * Only needed by parameter derivatives. Released in the lean storage mode if nothing is optimizable.
    */
   std::shared_ptr<std::vector<std::vector<size_t>>> C2node;
+  /** compact copy of C2node shared by all the clones and used by the ratio and gradient contractions.
+   * Only built in the lean storage mode.
+   * unique det ids are interleaved as [global det id][spin] and stored in 32 bits
+   * so that each term of the expansion reads a single contiguous record.
+   */
+  std::shared_ptr<const std::vector<uint32_t>> ci_index_;
   /// CI coefficients
   std::shared_ptr<std::vector<ValueType>> C;
   /// if true, the CI coefficients are optimized
@@ -290,6 +369,12 @@ private:
   std::vector<int> Last;
   ///use pre-compute (fast) algorithm
   const bool use_pre_computing_;
+  ///keep C_otherDs of only one group per walker and drop C2node if it is not needed
+  const bool lean_storage_;
+  /// the group held by C_otherDs in the lean storage mode, -1 if stale
+  int lean_group_;
+  /// number of CI terms streamed per block in C_otherDs precomputation
+  static constexpr size_t CIBlockSize = 512;
 
   /// current psi over ref single det
   PsiValueType psi_ratio_to_ref_det_;
@@ -299,7 +384,9 @@ private:
   size_t ActiveSpin;
   PsiValueType curRatio;
 
-  /// C_n x D^1_n x D^2_n ... D^3_n with one D removed. Summed by group. [spin, unique det id]
+  /** C_n x D^1_n x D^2_n ... D^3_n with one D removed. Summed by group. [spin, unique det id]
+   * In the lean storage mode, a single buffer holds the group given by lean_group_.
+   */
   //std::vector<Vector<ValueType, OffloadPinnedAllocator<ValueType>>> C_otherDs;
   std::vector<OffloadVector<ValueType>> C_otherDs;
 
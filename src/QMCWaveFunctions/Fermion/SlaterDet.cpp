@@ -88,6 +88,14 @@ void SlaterDet::evaluateRatiosAlltoOne(ParticleSet& P, std::vector<ValueType>& r
     Dets[i]->evaluateRatiosAlltoOne(P, ratios);
 }
 
+void SlaterDet::mw_evaluateRatiosAlltoOne(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                                          const RefVectorWithLeader<ParticleSet>& p_list,
+                                          std::vector<std::vector<ValueType>>& ratios) const
+{
+  for (int i = 0; i < Dets.size(); ++i)
+    Dets[i]->mw_evaluateRatiosAlltoOne(extract_DetRef_list(wfc_list, i), p_list, ratios);
+}
+
 void SlaterDet::evaluateDerivRatios(const VirtualParticleSet& VP,
                                     const opt_variables_type& optvars,
                                     std::vector<ValueType>& ratios,
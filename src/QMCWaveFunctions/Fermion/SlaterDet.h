@@ -240,6 +240,10 @@ public:
 
   void evaluateRatiosAlltoOne(ParticleSet& P, std::vector<ValueType>& ratios) override;
 
+  void mw_evaluateRatiosAlltoOne(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                                 const RefVectorWithLeader<ParticleSet>& p_list,
+                                 std::vector<std::vector<ValueType>>& ratios) const override;
+
   void evaluateDerivatives(ParticleSet& P,
                            const opt_variables_type& active,
                            Vector<ValueType>& dlogpsi,
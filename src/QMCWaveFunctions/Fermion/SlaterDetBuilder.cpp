@@ -69,6 +69,7 @@ std::unique_ptr<WaveFunctionComponent> SlaterDetBuilder::buildComponent(xmlNodeP
   xmlNodePtr curRoot = cur;
   bool multiDet      = false;
   std::string msd_algorithm;
+  std::string msd_storage;
 
   std::unique_ptr<WaveFunctionComponent> built_singledet_or_multidets;
 
@@ -190,6 +191,7 @@ std::unique_ptr<WaveFunctionComponent> SlaterDetBuilder::buildComponent(xmlNodeP
       }
       spoAttrib.add(fastAlg, "Fast", {"", "yes", "no"}, TagStatus::DELETED);
       spoAttrib.add(msd_algorithm, "algorithm", {"precomputed_table_method", "table_method"});
+      spoAttrib.add(msd_storage, "storage", {"full", "lean"});
       spoAttrib.put(cur);
 
       //new format
@@ -216,9 +218,11 @@ std::unique_ptr<WaveFunctionComponent> SlaterDetBuilder::buildComponent(xmlNodeP
         app_summary() << "    Using the table method with precomputing. Faster" << std::endl;
       else
         app_summary() << "    Using the table method without precomputing. Slower." << std::endl;
+      if (msd_storage == "lean")
+        app_summary() << "    Using lean storage. Per-walker CI data is recomputed on demand." << std::endl;
 
       auto msd_fast = createMSDFast(cur, targetPtcl, std::move(spo_clones), targetPtcl.isSpinor(),
-                                    msd_algorithm == "precomputed_table_method");
+                                    msd_algorithm == "precomputed_table_method", msd_storage == "lean");
 
       // The primary purpose of this function is to create all the optimizable orbital rotation parameters.
       // But if orbital rotation parameters were supplied by the user it will also apply a unitary transformation
@@ -473,7 +477,8 @@ std::unique_ptr<MultiSlaterDetTableMethod> SlaterDetBuilder::createMSDFast(
     ParticleSet& target_ptcl,
     std::vector<std::unique_ptr<SPOSet>>&& spo_clones,
     const bool spinor,
-    const bool use_precompute) const
+    const bool use_precompute,
+    const bool use_lean_storage) const
 {
   const size_t nGroups = targetPtcl.groups();
 
@@ -620,7 +625,8 @@ std::unique_ptr<MultiSlaterDetTableMethod> SlaterDetBuilder::createMSDFast(
     Optimizable = true;
   }
 
-  auto msd_fast = std::make_unique<MultiSlaterDetTableMethod>(targetPtcl, std::move(dets), use_precompute);
+  auto msd_fast =
+      std::make_unique<MultiSlaterDetTableMethod>(targetPtcl, std::move(dets), use_precompute, use_lean_storage);
   msd_fast->initialize(std::move(C2nodes_sorted_ptr), std::move(C_ptr), std::move(myVars_ptr), std::move(csf_data_ptr),
                        Optimizable, CI_Optimizable);
 
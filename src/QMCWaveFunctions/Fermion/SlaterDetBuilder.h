@@ -81,7 +81,8 @@ private:
                                                            ParticleSet& target_ptcl,
                                                            std::vector<std::unique_ptr<SPOSet>>&& spo_clones,
                                                            const bool spinor,
-                                                           const bool use_precompute) const;
+                                                           const bool use_precompute,
+                                                           const bool use_lean_storage) const;
 
 
   bool readDetList(xmlNodePtr cur,
@@ -86,6 +86,114 @@ void SlaterDetWithBackflow::copyFromBuffer(ParticleSet& P, WFBufferType& buf)
     Dets[i]->copyFromBuffer(P, buf);
 }
 
+RefVectorWithLeader<WaveFunctionComponent> SlaterDetWithBackflow::extract_DetRef_list(
+    const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+    int det_id) const
+{
+  RefVectorWithLeader<WaveFunctionComponent> Det_list(*wfc_list.getCastedLeader<SlaterDetWithBackflow>().Dets[det_id]);
+  Det_list.reserve(wfc_list.size());
+  for (WaveFunctionComponent& wfc : wfc_list)
+    Det_list.push_back(*static_cast<SlaterDetWithBackflow&>(wfc).Dets[det_id]);
+  return Det_list;
+}
+
+RefVectorWithLeader<ParticleSet> SlaterDetWithBackflow::extract_QP_list(
+    const RefVectorWithLeader<WaveFunctionComponent>& wfc_list) const
+{
+  RefVectorWithLeader<ParticleSet> qp_list(wfc_list.getCastedLeader<SlaterDetWithBackflow>().BFTrans->QP);
+  qp_list.reserve(wfc_list.size());
+  for (WaveFunctionComponent& wfc : wfc_list)
+    qp_list.push_back(static_cast<SlaterDetWithBackflow&>(wfc).BFTrans->QP);
+  return qp_list;
+}
+
+void SlaterDetWithBackflow::mw_ratioGrad(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                                         const RefVectorWithLeader<ParticleSet>& p_list,
+                                         int iat,
+                                         std::vector<PsiValueType>& ratios,
+                                         std::vector<GradType>& grad_new) const
+{
+  const int nw = wfc_list.size();
+  for (int iw = 0; iw < nw; iw++)
+    wfc_list.getCastedElement<SlaterDetWithBackflow>(iw).BFTrans->evaluatePbyPWithGrad(p_list[iw], iat);
+  std::fill_n(ratios.begin(), nw, PsiValueType(1));
+  std::vector<PsiValueType> det_ratios(nw);
+  for (int i = 0; i < Dets.size(); ++i)
+  {
+    Dets[i]->mw_ratioGrad(extract_DetRef_list(wfc_list, i), p_list, iat, det_ratios, grad_new);
+    for (int iw = 0; iw < nw; iw++)
+      ratios[iw] *= det_ratios[iw];
+  }
+}
+
+void SlaterDetWithBackflow::mw_calcRatio(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                                         const RefVectorWithLeader<ParticleSet>& p_list,
+                                         int iat,
+                                         std::vector<PsiValueType>& ratios) const
+{
+  const int nw = wfc_list.size();
+  for (int iw = 0; iw < nw; iw++)
+    wfc_list.getCastedElement<SlaterDetWithBackflow>(iw).BFTrans->evaluatePbyP(p_list[iw], iat);
+  std::fill_n(ratios.begin(), nw, PsiValueType(1));
+  std::vector<PsiValueType> det_ratios(nw);
+  for (int i = 0; i < Dets.size(); ++i)
+  {
+    Dets[i]->mw_calcRatio(extract_DetRef_list(wfc_list, i), p_list, iat, det_ratios);
+    for (int iw = 0; iw < nw; iw++)
+      ratios[iw] *= det_ratios[iw];
+  }
+}
+
+void SlaterDetWithBackflow::mw_accept_rejectMove(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                                                 const RefVectorWithLeader<ParticleSet>& p_list,
+                                                 int iat,
+                                                 const std::vector<bool>& isAccepted,
+                                                 bool safe_to_delay) const
+{
+  for (int iw = 0; iw < wfc_list.size(); iw++)
+  {
+    auto& bf = *wfc_list.getCastedElement<SlaterDetWithBackflow>(iw).BFTrans;
+    if (isAccepted[iw])
+      bf.acceptMove(p_list[iw], iat);
+    else
+      bf.restore(iat);
+  }
+  for (int i = 0; i < Dets.size(); ++i)
+    Dets[i]->mw_accept_rejectMove(extract_DetRef_list(wfc_list, i), p_list, iat, isAccepted, safe_to_delay);
+
+  for (int iw = 0; iw < wfc_list.size(); iw++)
+    if (isAccepted[iw])
+    {
+      auto& wfc      = wfc_list.getCastedElement<SlaterDetWithBackflow>(iw);
+      wfc.log_value_ = 0.0;
+      for (int i = 0; i < wfc.Dets.size(); ++i)
+        wfc.log_value_ += wfc.Dets[i]->get_log_value();
+    }
+}
+
+void SlaterDetWithBackflow::createResource(ResourceCollection& collection) const
+{
+  BFTrans->QP.createResource(collection);
+  for (int i = 0; i < Dets.size(); ++i)
+    Dets[i]->createResource(collection);
+}
+
+void SlaterDetWithBackflow::acquireResource(ResourceCollection& collection,
+                                            const RefVectorWithLeader<WaveFunctionComponent>& wfc_list) const
+{
+  ParticleSet::acquireResource(collection, extract_QP_list(wfc_list));
+  for (int i = 0; i < Dets.size(); ++i)
+    Dets[i]->acquireResource(collection, extract_DetRef_list(wfc_list, i));
+}
+
+void SlaterDetWithBackflow::releaseResource(ResourceCollection& collection,
+                                            const RefVectorWithLeader<WaveFunctionComponent>& wfc_list) const
+{
+  ParticleSet::releaseResource(collection, extract_QP_list(wfc_list));
+  for (int i = 0; i < Dets.size(); ++i)
+    Dets[i]->releaseResource(collection, extract_DetRef_list(wfc_list, i));
+}
+
 std::unique_ptr<WaveFunctionComponent> SlaterDetWithBackflow::makeClone(ParticleSet& tqp) const
 {
   auto bf = BFTrans->makeClone(tqp);
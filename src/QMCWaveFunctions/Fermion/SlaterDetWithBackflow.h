@@ -72,6 +72,12 @@ public:
     return psi;
   }
 
+  void mw_ratioGrad(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                    const RefVectorWithLeader<ParticleSet>& p_list,
+                    int iat,
+                    std::vector<PsiValueType>& ratios,
+                    std::vector<GradType>& grad_new) const override;
+
   GradType evalGrad(ParticleSet& P, int iat) override
   {
     QMCTraits::GradType g;
@@ -101,6 +107,10 @@ public:
     BFTrans->acceptMove(P, iat);
     for (int i = 0; i < Dets.size(); i++)
       Dets[i]->acceptMove(P, iat);
+
+    log_value_ = 0.0;
+    for (int i = 0; i < Dets.size(); ++i)
+      log_value_ += Dets[i]->get_log_value();
   }
 
   inline void restore(int iat) override
@@ -121,6 +131,25 @@ public:
     return ratio;
   }
 
+  void mw_calcRatio(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                    const RefVectorWithLeader<ParticleSet>& p_list,
+                    int iat,
+                    std::vector<PsiValueType>& ratios) const override;
+
+  void mw_accept_rejectMove(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                            const RefVectorWithLeader<ParticleSet>& p_list,
+                            int iat,
+                            const std::vector<bool>& isAccepted,
+                            bool safe_to_delay = false) const override;
+
+  void createResource(ResourceCollection& collection) const override;
+
+  void acquireResource(ResourceCollection& collection,
+                       const RefVectorWithLeader<WaveFunctionComponent>& wfc_list) const override;
+
+  void releaseResource(ResourceCollection& collection,
+                       const RefVectorWithLeader<WaveFunctionComponent>& wfc_list) const override;
+
   std::unique_ptr<WaveFunctionComponent> makeClone(ParticleSet& tqp) const override;
 
   SPOSetPtr getPhi(int i = 0) const { return Dets[i]->getPhi(); }
@@ -135,6 +164,13 @@ public:
   void testDerivGL(ParticleSet& P);
 
 private:
+  // helper function for extracting the list of the det_id-th determinants from a list of SlaterDetWithBackflow
+  RefVectorWithLeader<WaveFunctionComponent> extract_DetRef_list(
+      const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+      int det_id) const;
+  // helper function for extracting the list of quasiparticle sets from a list of SlaterDetWithBackflow
+  RefVectorWithLeader<ParticleSet> extract_QP_list(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list) const;
+
   ///container for the DiracDeterminants
   const std::vector<std::unique_ptr<Determinant_t>> Dets;
   /// backflow transformation
@@ -18,6 +18,8 @@
 #include "SoaDistanceTableABOMPTarget.h"
 #include "ResourceCollection.h"
 #include "ParticleBase/ParticleAttribOps.h"
+#include "Utilities/FairDivide.h"
+#include "Concurrency/OpenMP.h"
 
 namespace qmcplusplus
 {
@@ -404,7 +406,8 @@ std::unique_ptr<WaveFunctionComponent> TwoBodyJastrow<FT>::makeClone(ParticleSet
         j2copy->addFunc(ig, jg, std::move(fc));
       }
     }
-  j2copy->KEcorr = KEcorr;
+  j2copy->KEcorr                     = KEcorr;
+  j2copy->nested_threading_min_size_ = nested_threading_min_size_;
 
   j2copy->myVars.clear();
   j2copy->myVars.insertFrom(myVars);
@@ -431,23 +434,49 @@ void TwoBodyJastrow<FT>::computeU3(const ParticleSet& P,
                                    bool triangle)
 {
   const int jelmax = triangle ? iat : N;
+  if (jelmax >= nested_threading_min_size_)
+  {
+#pragma omp parallel
+    {
+      // the alignment of int also keeps the scratch DistIndice aligned
+      int first, last;
+      FairDivideAligned(jelmax, getAlignment<int>(), omp_get_num_threads(), omp_get_thread_num(), first, last);
+      computeU3Range(P, iat, dist, u, du, d2u, first, last);
+    }
+  }
+  else
+    computeU3Range(P, iat, dist, u, du, d2u, 0, jelmax);
+  //u[iat]=czero;
+  //du[iat]=czero;
+  //d2u[iat]=czero;
+}
+
+template<typename FT>
+void TwoBodyJastrow<FT>::computeU3Range(const ParticleSet& P,
+                                        int iat,
+                                        const DistRow& dist,
+                                        RealType* restrict u,
+                                        RealType* restrict du,
+                                        RealType* restrict d2u,
+                                        int first,
+                                        int last)
+{
   constexpr valT czero(0);
-  std::fill_n(u, jelmax, czero);
-  std::fill_n(du, jelmax, czero);
-  std::fill_n(d2u, jelmax, czero);
+  std::fill(u + first, u + last, czero);
+  std::fill(du + first, du + last, czero);
+  std::fill(d2u + first, d2u + last, czero);
 
   const int igt = P.GroupID[iat] * NumGroups;
   for (int jg = 0; jg < NumGroups; ++jg)
     if (F[igt + jg])
     {
       const FuncType& f2(*F[igt + jg]);
-      int iStart = P.first(jg);
-      int iEnd   = std::min(jelmax, P.last(jg));
-      f2.evaluateVGL(iat, iStart, iEnd, dist.data(), u, du, d2u, DistCompressed.data(), DistIndice.data());
+      int iStart = std::max(first, P.first(jg));
+      int iEnd   = std::min(last, P.last(jg));
+      if (iStart < iEnd)
+        f2.evaluateVGL(iat, iStart, iEnd, dist.data(), u, du, d2u, DistCompressed.data() + first,
+                       DistIndice.data() + first);
     }
-  //u[iat]=czero;
-  //du[iat]=czero;
-  //d2u[iat]=czero;
 }
 
 template<typename FT>
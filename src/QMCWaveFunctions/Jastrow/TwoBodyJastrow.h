@@ -104,6 +104,8 @@ private:
   aligned_vector<valT> old_u, old_du, old_d2u;
   aligned_vector<valT> DistCompressed;
   aligned_vector<int> DistIndice;
+  /// number of particles from which computeU3 splits the pairs among the nested threads
+  int nested_threading_min_size_ = 1024;
   ///Uniquue J2 set for cleanup
   std::map<std::string, std::unique_ptr<FT>> J2Unique;
   ///Container for \f$F[ig*NumGroups+jg]\f$. treat every pointer as a reference.
@@ -143,6 +145,16 @@ private:
                  RealType* restrict d2u,
                  bool triangle = false);
 
+  /// computeU3 over the particles [first, last) using the same range of DistCompressed and DistIndice
+  void computeU3Range(const ParticleSet& P,
+                      int iat,
+                      const DistRow& dist,
+                      RealType* restrict u,
+                      RealType* restrict du,
+                      RealType* restrict d2u,
+                      int first,
+                      int last);
+
   /** compute gradient
    */
   posT accumulateG(const valT* restrict du, const DisplRow& displ) const;
@@ -248,6 +260,9 @@ public:
 
   const std::vector<FT*>& getPairFunctions() const { return F; }
 
+  /// set the number of particles from which computeU3 splits the pairs among the nested threads
+  void setNestedThreadingMinSize(int min_size) { nested_threading_min_size_ = min_size; }
+
   // Accessors for unit testing
   std::pair<int, int> getComponentOffset(int index) { return OffSet.at(index); }
 
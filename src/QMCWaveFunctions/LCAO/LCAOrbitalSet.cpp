@@ -114,6 +114,22 @@ inline void Product_ABt(const VectorSoaContainer<T, D>& A, const Matrix<T>& B, V
              C.capacity());
 }
 
+/** Product_ABt restricted to the columns [first, last) of A and B, the other columns of A are zero */
+template<typename T, unsigned D>
+inline void Product_ABt(const VectorSoaContainer<T, D>& A,
+                        const Matrix<T>& B,
+                        const std::pair<int, int>& range,
+                        VectorSoaContainer<T, D>& C)
+{
+  constexpr char transa = 't';
+  constexpr char transb = 'n';
+  constexpr T zone(1);
+  constexpr T zero(0);
+  const auto [first, last] = range;
+  BLAS::gemm(transa, transb, B.rows(), D, last - first, zone, B.data() + first, B.cols(), A.data() + first,
+             A.capacity(), zero, C.data(), C.capacity());
+}
+
 inline void LCAOrbitalSet::evaluate_vgl_impl(const vgl_type& temp,
                                              ValueVector& psi,
                                              GradVector& dpsi,
@@ -714,10 +730,12 @@ void LCAOrbitalSet::evaluateGradSource(const ParticleSet& P,
   }
   else
   {
+    // only the basis functions centered on iat_src depend on its position
+    const auto center_range = myBasisSet->getCenterBasisRange(iat_src);
     for (size_t i = 0, iat = first; iat < last; i++, iat++)
     {
       myBasisSet->evaluateGradSourceV(P, iat, source, iat_src, Temp);
-      Product_ABt(Temp, *C, Tempv);
+      Product_ABt(Temp, *C, center_range, Tempv);
       evaluate_ionderiv_v_impl(Tempv, i, gradphi);
     }
   }
@@ -742,16 +760,81 @@ void LCAOrbitalSet::evaluateGradSource(const ParticleSet& P,
   }
   else
   {
+    const auto center_range = myBasisSet->getCenterBasisRange(iat_src);
     for (size_t i = 0, iat = first; iat < last; i++, iat++)
     {
       myBasisSet->evaluateGradSourceVGL(P, iat, source, iat_src, Tempgh);
-      Product_ABt(Tempgh, *C, Tempghv);
+      Product_ABt(Tempgh, *C, center_range, Tempghv);
       evaluate_ionderiv_vgl_impl(Tempghv, i, grad_phi, grad_grad_phi, grad_lapl_phi);
       //  evaluate_vghgh_impl(Tempghv, i, logdet, dlogdet, grad_grad_logdet, grad_grad_grad_logdet);
     }
   }
 }
 
+void LCAOrbitalSet::mw_evaluateGradSource(const RefVectorWithLeader<SPOSet>& spo_list,
+                                          const RefVectorWithLeader<ParticleSet>& P_list,
+                                          int first,
+                                          int last,
+                                          const ParticleSet& source,
+                                          int iat_src,
+                                          const RefVector<GradMatrix>& grad_phi_list) const
+{
+  assert(this == &spo_list.getLeader());
+  const size_t nw                       = spo_list.size();
+  const size_t nptcls                   = last - first;
+  const size_t requested_orb_size       = grad_phi_list[0].get().cols();
+  const auto [first_basis, last_basis]  = myBasisSet->getCenterBasisRange(iat_src);
+  const size_t center_size              = last_basis - first_basis;
+
+  // the ion gradients of the basis functions of the center, [walker][particle][dim] x [center basis functions]
+  ValueMatrix basis_grads(nw * nptcls * OHMMS_DIM, center_size);
+  for (size_t iw = 0; iw < nw; iw++)
+  {
+    auto& spo = spo_list.getCastedElement<LCAOrbitalSet>(iw);
+    for (size_t i = 0; i < nptcls; i++)
+    {
+      spo.myBasisSet->evaluateGradSourceV(P_list[iw], first + i, source, iat_src, spo.Temp);
+      for (size_t idim = 0; idim < OHMMS_DIM; idim++)
+      {
+        // the ion gradient is minus the electron gradient
+        const ValueType* restrict grad = spo.Temp.data(idim + 1) + first_basis;
+        ValueType* restrict row        = basis_grads[(iw * nptcls + i) * OHMMS_DIM + idim];
+        for (size_t ib = 0; ib < center_size; ib++)
+          row[ib] = -grad[ib];
+      }
+    }
+  }
+
+  ValueMatrix orb_grads(nw * nptcls * OHMMS_DIM, requested_orb_size);
+  if (Identity)
+  {
+    orb_grads = 0.0;
+    for (size_t row = 0; row < orb_grads.rows(); row++)
+      for (size_t ib = first_basis; ib < std::min<size_t>(last_basis, requested_orb_size); ib++)
+        orb_grads[row][ib] = basis_grads[row][ib - first_basis];
+  }
+  else if (center_size > 0)
+  {
+    // one gemm for all the walkers and particles
+    BLAS::gemm('T', 'N', requested_orb_size, orb_grads.rows(), center_size, ValueType(1.0), C->data() + first_basis,
+               BasisSetSize, basis_grads.data(), center_size, ValueType(0.0), orb_grads.data(), requested_orb_size);
+  }
+  else
+    orb_grads = 0.0;
+
+  for (size_t iw = 0; iw < nw; iw++)
+  {
+    GradMatrix& grad_phi = grad_phi_list[iw];
+    for (size_t i = 0; i < nptcls; i++)
+      for (size_t idim = 0; idim < OHMMS_DIM; idim++)
+      {
+        const ValueType* restrict row = orb_grads[(iw * nptcls + i) * OHMMS_DIM + idim];
+        for (size_t j = 0; j < requested_orb_size; j++)
+          grad_phi[i][j][idim] = row[j];
+      }
+  }
+}
+
 void LCAOrbitalSet::evaluateGradSourceRow(const ParticleSet& P,
                                           int iel,
                                           const ParticleSet& source,
@@ -766,7 +849,7 @@ void LCAOrbitalSet::evaluateGradSourceRow(const ParticleSet& P,
   else
   {
     myBasisSet->evaluateGradSourceV(P, iel, source, iat_src, Temp);
-    Product_ABt(Temp, *C, Tempv);
+    Product_ABt(Temp, *C, myBasisSet->getCenterBasisRange(iat_src), Tempv);
     evaluate_ionderiv_v_row_impl(Tempv, gradphi);
   }
 }
@@ -798,4 +881,29 @@ void LCAOrbitalSet::applyRotation(const ValueMatrix& rot_mat, bool use_stored_co
   */
 }
 
+void LCAOrbitalSet::applyLowRankRotation(const ValueMatrix& Z, const ValueMatrix& G, bool use_stored_copy)
+{
+  const int k = Z.cols();
+  // beyond this rank, forming the rotation matrix and a single gemm is cheaper
+  if (4 * k >= OrbitalSetSize)
+  {
+    SPOSet::applyLowRankRotation(Z, G, use_stored_copy);
+    return;
+  }
+  if (use_stored_copy)
+    *C = C_copy;
+  else
+    C_copy = *C;
+  if (k == 0)
+    return;
+  // C += (C Z) G Z^T in the column-major view of the coefficients used by applyRotation
+  ValueMatrix CZ(k, BasisSetSize), CZG(k, BasisSetSize);
+  BLAS::gemm('N', 'T', BasisSetSize, k, OrbitalSetSize, RealType(1.0), C_copy.data(), BasisSetSize, Z.data(), k,
+             RealType(0.0), CZ.data(), BasisSetSize);
+  BLAS::gemm('N', 'T', BasisSetSize, k, k, RealType(1.0), CZ.data(), BasisSetSize, G.data(), k, RealType(0.0),
+             CZG.data(), BasisSetSize);
+  BLAS::gemm('N', 'N', BasisSetSize, OrbitalSetSize, k, RealType(1.0), CZG.data(), BasisSetSize, Z.data(), k,
+             RealType(1.0), C->data(), BasisSetSize);
+}
+
 } // namespace qmcplusplus
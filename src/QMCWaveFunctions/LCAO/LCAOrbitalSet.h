@@ -59,6 +59,8 @@ public:
 
   void applyRotation(const ValueMatrix& rot_mat, bool use_stored_copy) override;
 
+  void applyLowRankRotation(const ValueMatrix& Z, const ValueMatrix& G, bool use_stored_copy) override;
+
   /** set the OrbitalSetSize and Identity=false and initialize internal storages
     */
   void setOrbitalSetSize(int norbs) override;
@@ -199,6 +201,17 @@ public:
                           HessMatrix& grad_grad_phi,
                           GradMatrix& grad_lapl_phi) override;
 
+  /** the basis functions of the source particle for all walkers and particles, contracted with the
+   *  coefficients of the requested orbitals in a single gemm
+   */
+  void mw_evaluateGradSource(const RefVectorWithLeader<SPOSet>& spo_list,
+                             const RefVectorWithLeader<ParticleSet>& P_list,
+                             int first,
+                             int last,
+                             const ParticleSet& source,
+                             int iat_src,
+                             const RefVector<GradMatrix>& grad_phi_list) const override;
+
   void evaluateGradSourceRow(const ParticleSet& P,
                              int iel,
                              const ParticleSet& source,
@@ -139,6 +139,14 @@ public:
    */
   void evaluateV(const ParticleSet& P, int iat, ORBT* restrict vals) override;
 
+  /** the basis functions of center c, BasisOffset can be in any order so the size comes from its atomic basis set
+   */
+  std::pair<int, int> getCenterBasisRange(int c) const override
+  {
+    const int first = BasisOffset[c];
+    return {first, first + LOBasisSet[ions_.GroupID[c]]->getBasisSetSize()};
+  }
+
   void evaluateGradSourceV(const ParticleSet& P, int iat, const ParticleSet& ions, int jion, vgl_type& vgl) override;
 
   void evaluateGradSourceVGL(const ParticleSet& P,
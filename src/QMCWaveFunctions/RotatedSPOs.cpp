@@ -157,21 +157,103 @@ void RotatedSPOs::apply_rotation(const std::vector<RealType>& param, bool use_st
 {
   assert(param.size() == m_act_rot_inds.size());
 
+  // repeated probes of the same parameters, e.g. during correlated sampling, need no work
+  if (use_stored_copy && param == applied_params_)
+    return;
+
   const size_t nmo = Phi->getOrbitalSetSize();
-  ValueMatrix rot_mat(nmo, nmo);
-  rot_mat = ValueType(0);
-
-  constructAntiSymmetricMatrix(m_act_rot_inds, param, rot_mat);
-
-  /*
-    rot_mat is now an anti-hermitian matrix. Now we convert
-    it into a unitary matrix via rot_mat = exp(-rot_mat). 
-    Finally, apply unitary matrix to orbs.
-  */
-  exponentiate_antisym_matrix(rot_mat);
-  Phi->applyRotation(rot_mat, use_stored_copy);
+
+  // occupied-virtual rotations only touch the connected orbitals through a low-rank correction
+  ValueMatrix rot_Z, rot_G;
+  if (constructLowRankRotation(m_act_rot_inds, param, nmo, rot_Z, rot_G))
+    Phi->applyLowRankRotation(rot_Z, rot_G, use_stored_copy);
+  else
+  {
+    ValueMatrix rot_mat(nmo, nmo);
+    rot_mat = ValueType(0);
+
+    constructAntiSymmetricMatrix(m_act_rot_inds, param, rot_mat);
+
+    /*
+      rot_mat is now an anti-hermitian matrix. Now we convert
+      it into a unitary matrix via rot_mat = exp(-rot_mat).
+      Finally, apply unitary matrix to orbs.
+    */
+    exponentiate_antisym_matrix(rot_mat);
+    Phi->applyRotation(rot_mat, use_stored_copy);
+  }
+  applied_params_ = param;
 }
 
+bool RotatedSPOs::constructLowRankRotation(const RotationIndices& rot_indices,
+                                           const std::vector<RealType>& param,
+                                           size_t nmo,
+                                           ValueMatrix& Z,
+                                           ValueMatrix& G)
+{
+  assert(rot_indices.size() == param.size());
+  // position of each orbital within the first (p) and the second (q) set of the rotation indices
+  std::vector<int> p_pos(nmo, -1), q_pos(nmo, -1);
+  std::vector<int> p_orbs, q_orbs;
+  for (const auto& [p, q] : rot_indices)
+  {
+    if (p_pos[p] < 0)
+    {
+      p_pos[p] = p_orbs.size();
+      p_orbs.push_back(p);
+    }
+    if (q_pos[q] < 0)
+    {
+      q_pos[q] = q_orbs.size();
+      q_orbs.push_back(q);
+    }
+  }
+  for (const int p : p_orbs)
+    if (q_pos[p] >= 0)
+      return false;
+
+  const int m = p_orbs.size();
+  const int n = q_orbs.size();
+  const int r = std::min(m, n);
+  Z.resize(nmo, 2 * r);
+  G.resize(2 * r, 2 * r);
+  Z = ValueType(0);
+  G = ValueType(0);
+  if (r == 0)
+    return true;
+
+  // column-major n x m block X(q,p) = K[q][p]
+  std::vector<RealType> X(n * m, 0);
+  for (int i = 0; i < rot_indices.size(); i++)
+    X[q_pos[rot_indices[i].second] + n * p_pos[rot_indices[i].first]] = param[i];
+
+  std::vector<RealType> sv(r), U(n * r), VT(r * m);
+  const int lwork = std::max(3 * r + std::max(m, n), 5 * r);
+  std::vector<RealType> work(lwork);
+  int info = 0;
+  LAPACK::gesvd('S', 'S', n, m, X.data(), n, sv.data(), U.data(), n, VT.data(), r, work.data(), lwork, info);
+  if (info != 0)
+  {
+    std::ostringstream msg;
+    msg << "gesvd failed with info = " << info << " in RotatedSPOs::constructLowRankRotation";
+    throw std::runtime_error(msg.str());
+  }
+
+  for (int k = 0; k < r; k++)
+  {
+    for (int a = 0; a < m; a++)
+      Z(p_orbs[a], k) = VT[k + r * a];
+    for (int b = 0; b < n; b++)
+      Z(q_orbs[b], r + k) = U[b + n * k];
+    const RealType cos_s = std::cos(sv[k]);
+    const RealType sin_s = std::sin(sv[k]);
+    G(k, k)              = cos_s - RealType(1);
+    G(r + k, r + k)      = cos_s - RealType(1);
+    G(r + k, k)          = sin_s;
+    G(k, r + k)          = -sin_s;
+  }
+  return true;
+}
 
 // compute exponential of a real, antisymmetric matrix by diagonalizing and exponentiating eigenvalues
 void RotatedSPOs::exponentiate_antisym_matrix(ValueMatrix& mat)
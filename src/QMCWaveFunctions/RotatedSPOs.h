@@ -61,6 +61,17 @@ public:
   // Compute matrix exponential of an antisymmetric matrix (result is rotation matrix)
   static void exponentiate_antisym_matrix(ValueMatrix& mat);
 
+  // Compute the rotation matrix exp(K) = I + Z G Z^T from the rotation parameters when the rotations connect
+  // two disjoint orbital sets, e.g. occupied and virtual orbitals. With X the block of K between the two sets,
+  // the singular value decomposition X = U S V^T gives Z = [V 0; 0 U] and G = [cos S - 1, -sin S; sin S, cos S - 1].
+  // The rank of the correction is at most twice the size of the smaller set.
+  // Returns false, leaving Z and G untouched, if an orbital appears on both sides of the rotation indices.
+  static bool constructLowRankRotation(const RotationIndices& rot_indices,
+                                       const std::vector<RealType>& param,
+                                       size_t nmo,
+                                       ValueMatrix& Z,
+                                       ValueMatrix& G);
+
   // Compute matrix log of rotation matrix to produce antisymmetric matrix
   static void log_antisym_matrix(ValueMatrix& mat);
 
@@ -210,6 +221,8 @@ public:
     if (myVars.size())
       active.insertFrom(myVars);
     Phi->storeParamsBeforeRotation();
+    // the stored copy is the current rotated set
+    applied_params_.assign(myVars.size(), 0.0);
   }
 
   void checkOutVariables(const opt_variables_type& active) override { myVars.getIndex(active); }
@@ -345,6 +358,8 @@ private:
   bool params_supplied;
   /// list of supplied orbital rotation parameters
   std::vector<RealType> params;
+  /// rotation parameters currently applied to the stored copy of the orbitals, used to skip repeated rotations
+  std::vector<RealType> applied_params_;
 };
 
 } //namespace qmcplusplus
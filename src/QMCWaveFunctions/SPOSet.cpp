@@ -20,6 +20,7 @@
 #include "Numerics/MatrixOperators.h"
 #include "OhmmsData/AttributeSet.h"
 #include "CPU/SIMD/simd.hpp"
+#include "CPU/BLAS.hpp"
 #include "Utilities/ProgressReportEngine.h"
 #include "hdf/hdf_archive.h"
 #include <limits>
@@ -251,6 +252,24 @@ void SPOSet::applyRotation(const ValueMatrix& rot_mat, bool use_stored_copy)
                            "must be overloaded when the SPOSet supports rotation.");
 }
 
+void SPOSet::applyLowRankRotation(const ValueMatrix& Z, const ValueMatrix& G, bool use_stored_copy)
+{
+  const int nmo = Z.rows();
+  const int k   = Z.cols();
+  ValueMatrix rot_mat(nmo, nmo);
+  rot_mat = ValueType(0);
+  for (int i = 0; i < nmo; i++)
+    rot_mat(i, i) = ValueType(1);
+  if (k > 0)
+  {
+    // row-major ZG = Z G, rot_mat += ZG Z^T
+    ValueMatrix ZG(nmo, k);
+    BLAS::gemm('N', 'N', k, nmo, k, ValueType(1), G.data(), k, Z.data(), k, ValueType(0), ZG.data(), k);
+    BLAS::gemm('T', 'N', nmo, nmo, k, ValueType(1), Z.data(), k, ZG.data(), k, ValueType(1), rot_mat.data(), nmo);
+  }
+  applyRotation(rot_mat, use_stored_copy);
+}
+
 void SPOSet::evaluateDerivatives(ParticleSet& P,
                                  const opt_variables_type& optvars,
                                  Vector<ValueType>& dlogpsi,
@@ -385,6 +404,19 @@ void SPOSet::evaluateGradSource(const ParticleSet& P,
                            "must be overloaded when the SPOSet has ion derivatives.");
 }
 
+void SPOSet::mw_evaluateGradSource(const RefVectorWithLeader<SPOSet>& spo_list,
+                                   const RefVectorWithLeader<ParticleSet>& P_list,
+                                   int first,
+                                   int last,
+                                   const ParticleSet& source,
+                                   int iat_src,
+                                   const RefVector<GradMatrix>& grad_phi_list) const
+{
+  assert(this == &spo_list.getLeader());
+  for (int iw = 0; iw < spo_list.size(); iw++)
+    spo_list[iw].evaluateGradSource(P_list[iw], first, last, source, iat_src, grad_phi_list[iw]);
+}
+
 void SPOSet::evaluateGradSourceRow(const ParticleSet& P,
                                    int iel,
                                    const ParticleSet& source,
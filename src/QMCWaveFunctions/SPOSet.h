@@ -124,6 +124,13 @@ public:
   virtual void storeParamsBeforeRotation() {}
   /// apply rotation to all the orbitals
   virtual void applyRotation(const ValueMatrix& rot_mat, bool use_stored_copy = false);
+  /** apply a rotation given as a low-rank correction to the identity, rot_mat = I + Z G Z^T
+   * @param Z orbital components of the correction, OrbitalSetSize x k
+   * @param G k x k core of the correction
+   *
+   * The default implementation forms the full rotation matrix and calls applyRotation.
+   */
+  virtual void applyLowRankRotation(const ValueMatrix& Z, const ValueMatrix& G, bool use_stored_copy = false);
 
   /// Parameter derivatives of the wavefunction and the Laplacian of the wavefunction
   virtual void evaluateDerivatives(ParticleSet& P,
@@ -500,6 +507,23 @@ public:
                                   HessMatrix& grad_grad_phi,
                                   GradMatrix& grad_lapl_phi);
 
+  /** evaluate the gradients of this single-particle orbital for a batch of walkers
+   *  for [first,last) target particles with respect to the given source particle
+   * @param spo_list the list of SPOSet pointers in a walker batch
+   * @param P_list the list of ParticleSet pointers in a walker batch
+   * @param first starting index of the particles
+   * @param last ending index of the particles
+   * @param iat_src source particle index
+   * @param grad_phi_list gradients of each walker
+   */
+  virtual void mw_evaluateGradSource(const RefVectorWithLeader<SPOSet>& spo_list,
+                                     const RefVectorWithLeader<ParticleSet>& P_list,
+                                     int first,
+                                     int last,
+                                     const ParticleSet& source,
+                                     int iat_src,
+                                     const RefVector<GradMatrix>& grad_phi_list) const;
+
   /** @brief Returns a row of d/dR_iat phi_j(r) evaluated at position r.  
    *
    *  @param[in] P particle set.
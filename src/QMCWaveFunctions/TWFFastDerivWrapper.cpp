@@ -10,7 +10,9 @@
 //////////////////////////////////////////////////////////////////////////////////////
 
 #include "QMCWaveFunctions/TWFFastDerivWrapper.h"
+#include "QMCWaveFunctions/Fermion/MultiSlaterDetTableMethod.h"
 #include "Numerics/DeterminantOperators.h"
+#include "Numerics/MatrixOperators.h"
 #include "type_traits/ConvertToReal.h"
 #include <iostream>
 namespace qmcplusplus
@@ -33,9 +35,42 @@ void TWFFastDerivWrapper::addGroup(const ParticleSet& P, const IndexType gid, SP
   {
     groups_.push_back(gid);
     spos_.push_back(spo);
+    group_minv_.push_back(nullptr);
+    group_minv_stride_.push_back(0);
   }
 }
 
+void TWFFastDerivWrapper::addGroupInverse(const IndexType gid, const ValueType* minv, const IndexType stride)
+{
+  const IndexType sid     = getTWFGroupIndex(gid);
+  group_minv_[sid]        = minv;
+  group_minv_stride_[sid] = stride;
+}
+
+void TWFFastDerivWrapper::addMultiSlaterDet(const MultiSlaterDetTableMethod* msd, const std::vector<IndexType>& groupids)
+{
+  multislater_ = msd;
+  multislater_groups_.clear();
+  for (const IndexType gid : groupids)
+    multislater_groups_.push_back(getTWFGroupIndex(gid));
+}
+
+bool TWFFastDerivWrapper::getGroupInverses(std::vector<ValueMatrix>& minv) const
+{
+  if (std::find(group_minv_.begin(), group_minv_.end(), nullptr) != group_minv_.end())
+    return false;
+  for (IndexType sid = 0; sid < group_minv_.size(); sid++)
+  {
+    const IndexType nptcls    = minv[sid].rows();
+    const ValueType* det_minv = group_minv_[sid];
+    const IndexType stride    = group_minv_stride_[sid];
+    for (IndexType i = 0; i < nptcls; i++)
+      for (IndexType j = 0; j < nptcls; j++)
+        minv[sid][i][j] = det_minv[j * stride + i];
+  }
+  return true;
+}
+
 void TWFFastDerivWrapper::getM(const ParticleSet& P, std::vector<ValueMatrix>& mvec) const
 {
   IndexType ngroups = spos_.size();
@@ -174,6 +209,45 @@ void TWFFastDerivWrapper::getIonGradM(const ParticleSet& P,
   }
 }
 
+void TWFFastDerivWrapper::mw_getIonGradM(const RefVectorWithLeader<TWFFastDerivWrapper>& wrapper_list,
+                                         const RefVectorWithLeader<ParticleSet>& p_list,
+                                         const ParticleSet& source,
+                                         const int iat,
+                                         const RefVector<std::vector<std::vector<ValueMatrix>>>& dmvec_list)
+{
+  const TWFFastDerivWrapper& wrapper_leader = wrapper_list.getLeader();
+  const ParticleSet& p_leader               = p_list.getLeader();
+  const IndexType nw                        = wrapper_list.size();
+  const IndexType ngroups                   = dmvec_list[0].get()[0].size();
+  for (IndexType i = 0; i < ngroups; i++)
+  {
+    const IndexType first  = p_leader.first(i);
+    const IndexType last   = p_leader.last(i);
+    const IndexType nptcls = last - first;
+    const IndexType norbs  = wrapper_leader.spos_[i]->getOrbitalSetSize();
+
+    RefVectorWithLeader<SPOSet> spo_list(*wrapper_leader.spos_[i]);
+    std::vector<GradMatrix> grad_phi(nw);
+    for (IndexType iw = 0; iw < nw; iw++)
+    {
+      spo_list.push_back(*wrapper_list[iw].spos_[i]);
+      grad_phi[iw].resize(nptcls, norbs);
+    }
+
+    wrapper_leader.spos_[i]->mw_evaluateGradSource(spo_list, p_list, first, last, source, iat,
+                                                   makeRefVector<GradMatrix>(grad_phi));
+
+    for (IndexType iw = 0; iw < nw; iw++)
+    {
+      auto& dmvec = dmvec_list[iw].get();
+      for (IndexType idim = 0; idim < OHMMS_DIM; idim++)
+        for (IndexType iptcl = 0; iptcl < nptcls; iptcl++)
+          for (IndexType iorb = 0; iorb < norbs; iorb++)
+            dmvec[idim][i][iptcl][iorb] += grad_phi[iw][iptcl][iorb][idim];
+    }
+  }
+}
+
 void TWFFastDerivWrapper::getIonGradIonGradELaplM(const ParticleSet& P,
                                                   const ParticleSet& source,
                                                   int iat,
@@ -234,6 +308,31 @@ TWFFastDerivWrapper::ValueType TWFFastDerivWrapper::computeGSDerivative(const st
   return dval;
 }
 
+TWFFastDerivWrapper::ValueType TWFFastDerivWrapper::computeMultiDetDerivative(
+    const std::vector<ValueMatrix>& M,
+    const std::vector<ValueMatrix>& B,
+    const std::vector<std::vector<ValueMatrix>>& dM,
+    const std::vector<std::vector<ValueMatrix>>& dB,
+    GradType& dlogpsi,
+    GradType& dO) const
+{
+  assert(multislater_ != nullptr);
+  // the multideterminant takes its groups in its own order
+  RefVector<const ValueMatrix> M_list, B_list;
+  std::vector<RefVector<const ValueMatrix>> dM_list(dM.size()), dB_list(dB.size());
+  for (const IndexType sid : multislater_groups_)
+  {
+    M_list.push_back(M[sid]);
+    B_list.push_back(B[sid]);
+    for (IndexType idim = 0; idim < dM.size(); idim++)
+    {
+      dM_list[idim].push_back(dM[idim][sid]);
+      dB_list[idim].push_back(dB[idim][sid]);
+    }
+  }
+  return multislater_->evaluateOneBodyOpIonDerivs(M_list, B_list, dM_list, dB_list, dlogpsi, dO);
+}
+
 void TWFFastDerivWrapper::invertMatrices(const std::vector<ValueMatrix>& M, std::vector<ValueMatrix>& Minv)
 {
   IndexType nspecies = M.size();
@@ -259,19 +358,9 @@ void TWFFastDerivWrapper::buildX(const std::vector<ValueMatrix>& Minv,
     X[id].resize(ptclnum, ptclnum);
     tmpmat.resize(ptclnum, ptclnum);
     //(B*A^-1)
-    for (int i = 0; i < ptclnum; i++)
-      for (int j = 0; j < ptclnum; j++)
-        for (int k = 0; k < ptclnum; k++)
-        {
-          tmpmat[i][j] += B[id][i][k] * Minv[id][k][j];
-        }
+    MatrixOperators::product(B[id], Minv[id], tmpmat);
     //A^{-1}*B*A^{-1}
-    for (int i = 0; i < ptclnum; i++)
-      for (int j = 0; j < ptclnum; j++)
-        for (int k = 0; k < ptclnum; k++)
-        {
-          X[id][i][j] += Minv[id][i][k] * tmpmat[k][j];
-        }
+    MatrixOperators::product(Minv[id], tmpmat, X[id]);
   }
 }
 
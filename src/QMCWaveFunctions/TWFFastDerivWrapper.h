@@ -19,11 +19,13 @@
 #include "Particle/ParticleSet.h"
 namespace qmcplusplus
 {
+class MultiSlaterDetTableMethod;
+
 /**
  *  TWFFastDerivWrapper is a wrapper class for TrialWavefunction that provides separate and low level access to the Jastrow and 
  *  SPOSet objects.  This is so that observables can be recast in matrix form and their derivatives taken efficiently. 
- *  Currently this is hard coded for ground state slater jastrow wave functions, but generalization to
- *  arbitrary occupations and multideterminants are straightforward and will come online as the code is tested and validated. 
+ *  Slater determinants are taken on their ground state occupation, while a multideterminant registered with
+ *  addMultiSlaterDet is contracted over its expansion by the table method.
  *
  *  Please see : J. Chem. Phys. 144, 194105 (2016) https://doi.org/10.1063/1.4948778 for implementation details and formalism.
  */
@@ -57,6 +59,31 @@ public:
   void addGroup(const ParticleSet& P, const IndexType groupid, SPOSet* spo);
   inline void addJastrow(WaveFunctionComponent* j) { jastrow_list_.push_back(j); };
 
+  /** @brief Register the inverse slater matrix a determinant keeps for a particle group.
+   *
+   *  The batched force evaluation copies it instead of building and inverting the slater matrix again.
+   *  The storage is the transposed inverse kept by the determinants, minv[i*stride+j] = [M^{-1}]_{ji},
+   *  and must stay valid as long as the wrapper is used.  The group must be added first.
+   *
+   *  @param[in] groupid.  ParticleSet groupid of the determinant.
+   *  @param[in] minv.  Transposed inverse of the ground state slater matrix.
+   *  @param[in] stride.  Leading dimension of minv.
+   *  @return void.
+   */
+  void addGroupInverse(const IndexType groupid, const ValueType* minv, const IndexType stride);
+
+  /** @brief Register a multideterminant.
+   *
+   *  The observables are then contracted over its CI expansion with computeMultiDetDerivative instead of
+   *  being taken on the ground state occupation.  The groups must be added first.
+   *
+   *  @param[in] msd.  The multideterminant, which must outlive the wrapper.
+   *  @param[in] groupids.  ParticleSet groupids of its determinants, in its own order.
+   *  @return void.
+   */
+  void addMultiSlaterDet(const MultiSlaterDetTableMethod* msd, const std::vector<IndexType>& groupids);
+  inline bool hasMultiSlaterDet() const { return multislater_ != nullptr; }
+
   /** @brief Takes particle set groupID and returns the TWF internal index for it.  
    *
    *  ParticleSet groups can be registered in whichever order.  However, the internal indexing 
@@ -109,6 +136,15 @@ public:
   IndexType getRowM(const ParticleSet& P, const IndexType iel, ValueVector& val) const;
 
 
+  /** @brief Returns the inverses of the ground state slater matrices registered by the determinants.
+   *
+   *  Only valid while the determinants are up to date with P, as after a completed QMC step.
+   *
+   *  @param[in,out] minv. Inverse of the ground state slater matrix for each species group.
+   *  @return false if a group has no registered inverse, minv is then left untouched.
+   */
+  bool getGroupInverses(std::vector<ValueMatrix>& minv) const;
+
   /** @brief Returns value, gradient, and laplacian matrices for all orbitals and all particles, species by species. 
    *
    *  @param[in] P particle set.
@@ -135,6 +171,21 @@ public:
                    const int iat,
                    std::vector<std::vector<ValueMatrix>>& dmvec) const;
 
+  /** @brief Batched getIonGradM.  The SPOSets of a group evaluate the walkers together.
+   *
+   *  @param[in] wrapper_list wrappers of the walkers.
+   *  @param[in] p_list particle sets of the walkers.
+   *  @param[in] source ion particle set.
+   *  @param[in] iat ion ID w.r.t. which to take derivative.
+   *  @param[in,out] dmvec_list getIonGradM output of each walker.
+   *  @return Void
+   */
+  static void mw_getIonGradM(const RefVectorWithLeader<TWFFastDerivWrapper>& wrapper_list,
+                             const RefVectorWithLeader<ParticleSet>& p_list,
+                             const ParticleSet& source,
+                             const int iat,
+                             const RefVector<std::vector<std::vector<ValueMatrix>>>& dmvec_list);
+
   /** @brief Returns x,y,z components of ion gradient of slater matrices and their laplacians..
    *
    *  @param[in] P particle set.
@@ -229,6 +280,23 @@ public:
                                 const std::vector<ValueMatrix>& dM,
                                 const std::vector<ValueMatrix>& dB) const;
 
+  /** @brief Multideterminant counterpart of trAB and computeGSDerivative by the table method.
+   *
+   *  @param[in] M. slater matrices on all the orbitals for each species group.
+   *  @param[in] B. observable matrices on all the orbitals.
+   *  @param[in] dM. Target derivative of M, [direction][group].  Only O psi/psi is computed if empty.
+   *  @param[in] dB. Target derivative of B, [direction][group].
+   *  @param[in,out] dlogpsi. Target derivative of log(psi) of the multideterminant.
+   *  @param[in,out] dO. Target derivative of O psi/psi.
+   *  @return O psi/psi
+   */
+  ValueType computeMultiDetDerivative(const std::vector<ValueMatrix>& M,
+                                      const std::vector<ValueMatrix>& B,
+                                      const std::vector<std::vector<ValueMatrix>>& dM,
+                                      const std::vector<std::vector<ValueMatrix>>& dB,
+                                      GradType& dlogpsi,
+                                      GradType& dO) const;
+
   //////////////////////////////////////////////////////////////////////////////////////////////
   //And now we just have some helper functions for doing useful math on our lists of matrices.//
   //////////////////////////////////////////////////////////////////////////////////////////////
@@ -273,6 +341,13 @@ private:
   std::vector<ValueMatrix> psi_M_;
   std::vector<ValueMatrix> psi_M_inv_;
   std::vector<WaveFunctionComponent*> jastrow_list_;
+  ///transposed inverses registered by the determinants, by internal group index, nullptr if none
+  std::vector<const ValueType*> group_minv_;
+  std::vector<IndexType> group_minv_stride_;
+  ///registered multideterminant, nullptr if none
+  const MultiSlaterDetTableMethod* multislater_ = nullptr;
+  ///internal group index of each determinant of the multideterminant
+  std::vector<IndexType> multislater_groups_;
 };
 
 /**@}*/
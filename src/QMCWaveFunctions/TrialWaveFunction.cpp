@@ -1146,6 +1146,35 @@ void TrialWaveFunction::evaluateRatiosAlltoOne(ParticleSet& P, std::vector<Value
   }
 }
 
+void TrialWaveFunction::mw_evaluateRatiosAlltoOne(const RefVectorWithLeader<TrialWaveFunction>& wf_list,
+                                                  const RefVectorWithLeader<ParticleSet>& p_list,
+                                                  const RefVector<std::vector<ValueType>>& ratios_list)
+{
+  auto& wf_leader = wf_list.getLeader();
+  ScopedTimer local_timer(wf_leader.TWF_timers_[V_TIMER]);
+  auto& wavefunction_components = wf_leader.Z;
+  std::vector<std::vector<ValueType>> t(ratios_list.size());
+  for (int iw = 0; iw < wf_list.size(); iw++)
+  {
+    std::vector<ValueType>& ratios = ratios_list[iw];
+    std::fill(ratios.begin(), ratios.end(), 1.0);
+    t[iw].resize(ratios.size());
+  }
+
+  for (int i = 0; i < wavefunction_components.size(); i++)
+  {
+    ScopedTimer z_timer(wf_leader.WFC_timers_[V_TIMER + TIMER_SKIP * i]);
+    const auto wfc_list(extractWFCRefList(wf_list, i));
+    wavefunction_components[i]->mw_evaluateRatiosAlltoOne(wfc_list, p_list, t);
+    for (int iw = 0; iw < wf_list.size(); iw++)
+    {
+      std::vector<ValueType>& ratios = ratios_list[iw];
+      for (int j = 0; j < ratios.size(); ++j)
+        ratios[j] *= t[iw][j];
+    }
+  }
+}
+
 void TrialWaveFunction::createResource(ResourceCollection& collection) const
 {
   for (int i = 0; i < Z.size(); ++i)
@@ -477,6 +477,13 @@ public:
 
   void evaluateRatiosAlltoOne(ParticleSet& P, std::vector<ValueType>& ratios);
 
+  /** batched version of evaluateRatiosAlltoOne
+   *  the virtual move is the one already made on each ParticleSet of p_list.
+   */
+  static void mw_evaluateRatiosAlltoOne(const RefVectorWithLeader<TrialWaveFunction>& wf_list,
+                                        const RefVectorWithLeader<ParticleSet>& p_list,
+                                        const RefVector<std::vector<ValueType>>& ratios_list);
+
   void setTwist(std::vector<RealType> t) { myTwist = t; }
   const std::vector<RealType> twist() { return myTwist; }
 
@@ -247,6 +247,15 @@ void WaveFunctionComponent::mw_evaluateRatios(const RefVectorWithLeader<WaveFunc
     wfc_list[iw].evaluateRatios(vp_list[iw], ratios[iw]);
 }
 
+void WaveFunctionComponent::mw_evaluateRatiosAlltoOne(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                                                      const RefVectorWithLeader<ParticleSet>& p_list,
+                                                      std::vector<std::vector<ValueType>>& ratios) const
+{
+  assert(this == &wfc_list.getLeader());
+  for (int iw = 0; iw < wfc_list.size(); iw++)
+    wfc_list[iw].evaluateRatiosAlltoOne(p_list[iw], ratios[iw]);
+}
+
 void WaveFunctionComponent::evaluateDerivRatios(const VirtualParticleSet& VP,
                                                 const opt_variables_type& optvars,
                                                 std::vector<ValueType>& ratios,
@@ -515,6 +515,15 @@ public:
    */
   virtual void evaluateRatiosAlltoOne(ParticleSet& P, std::vector<ValueType>& ratios);
 
+  /** evaluate the ratios of one virtual move with respect to all the particles of multiple walkers
+   * @param wfc_list the list of WaveFunctionComponent references of the same component in a walker batch
+   * @param p_list the list of ParticleSet references in a walker batch
+   * @param ratios of all the particles of all the walkers
+   */
+  virtual void mw_evaluateRatiosAlltoOne(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                                         const RefVectorWithLeader<ParticleSet>& p_list,
+                                         std::vector<std::vector<ValueType>>& ratios) const;
+
   /** evaluate ratios to evaluate the non-local PP
    * @param VP VirtualParticleSet
    * @param ratios ratios with new positions VP.R[k] the VP.refPtcl
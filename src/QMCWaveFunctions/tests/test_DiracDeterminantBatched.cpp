@@ -20,6 +20,7 @@
 #include "QMCWaveFunctions/tests/FakeSPO.h"
 #include "QMCWaveFunctions/SpinorSet.h"
 #include "QMCWaveFunctions/ElectronGas/FreeOrbital.h"
+#include "QMCWaveFunctions/TWFFastDerivWrapper.h"
 #include "checkMatrix.hpp"
 #include <ResourceCollection.h>
 
@@ -68,6 +69,24 @@ void test_DiracDeterminantBatched_first()
 
   checkMatrix(ddb.get_det_engine().get_ref_psiMinv(), b);
 
+  // the fast derivative wrapper reuses the inverse of the determinant instead of inverting the slater matrix
+  using ValueMatrix = TWFFastDerivWrapper::ValueMatrix;
+  TWFFastDerivWrapper twf;
+  ddb.registerTWFFastDerivWrapper(elec, twf);
+  std::vector<ValueMatrix> mvec(1, ValueMatrix(norb, norb));
+  std::vector<ValueMatrix> minv(1, ValueMatrix(norb, norb));
+  std::vector<ValueMatrix> minv_reused(1, ValueMatrix(norb, norb));
+  twf.getM(elec, mvec);
+  twf.invertMatrices(mvec, minv);
+  REQUIRE(twf.getGroupInverses(minv_reused));
+  checkMatrix(minv_reused[0], minv[0]);
+
+  // without a registered inverse the wrapper reports it and leaves minv untouched
+  TWFFastDerivWrapper twf_noinv;
+  twf_noinv.addGroup(elec, 0, ddb.getPhi());
+  CHECK_FALSE(twf_noinv.getGroupInverses(minv_reused));
+  checkMatrix(minv_reused[0], minv[0]);
+
   ParticleSet::GradType grad;
   PsiValueType det_ratio  = ddb.ratioGrad(elec, 0, grad);
   PsiValueType det_ratio1 = 0.178276269185;
@@ -98,6 +117,15 @@ void test_DiracDeterminantBatched_first()
   CHECK(std::real(ratios[1]) == Approx(0.2498726439));
   CHECK(std::real(ratios[2]) == Approx(-1.3145695364));
 
+  // the multi-walker version gives the same ratios for every walker
+  std::vector<std::vector<ValueType>> mw_ratios(2, std::vector<ValueType>(elec.getTotalNum()));
+  RefVectorWithLeader<WaveFunctionComponent> ddb_list(ddb, {ddb, ddb});
+  RefVectorWithLeader<ParticleSet> p_list(elec, {elec, elec});
+  ddb.mw_evaluateRatiosAlltoOne(ddb_list, p_list, mw_ratios);
+  for (int iw = 0; iw < mw_ratios.size(); iw++)
+    for (int i = 0; i < ratios.size(); i++)
+      CHECK(mw_ratios[iw][i] == ValueApprox(ratios[i]));
+
   elec.makeMove(0, newpos - elec.R[0]);
   PsiValueType ratio_0 = ddb.ratio(elec, 0);
   elec.rejectMove(0);
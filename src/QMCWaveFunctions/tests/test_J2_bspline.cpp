@@ -20,6 +20,7 @@
 #include "QMCWaveFunctions/Jastrow/RadialJastrowBuilder.h"
 #include "ParticleBase/ParticleAttribOps.h"
 #include "QMCWaveFunctions/Jastrow/TwoBodyJastrow.h"
+#include "Concurrency/OpenMP.h"
 
 #include <cstdio>
 #include <string>
@@ -254,4 +255,89 @@ TEST_CASE("BSpline builder Jastrow J2", "[wavefunction]")
   CHECK(std::real(ratio_1) == Approx(0.9871985577));
   CHECK(std::real(j2->get_log_value()) == Approx(0.0883791773));
 }
+
+// The pair evaluation split among a team of threads must agree with the serial one
+TEST_CASE("BSpline builder Jastrow J2 nested threads", "[wavefunction]")
+{
+  Communicate* c = OHMMS::Controller;
+
+  const SimulationCell simulation_cell;
+  ParticleSet elec_(simulation_cell);
+
+  elec_.setName("elec");
+  elec_.create({20, 20});
+  for (int iat = 0; iat < elec_.getTotalNum(); iat++)
+    elec_.R[iat] = {std::sin(1.1 * iat), std::cos(0.7 * iat), 0.05 * iat};
+
+  SpeciesSet& tspecies         = elec_.getSpeciesSet();
+  int upIdx                    = tspecies.addSpecies("u");
+  int downIdx                  = tspecies.addSpecies("d");
+  int chargeIdx                = tspecies.addAttribute("charge");
+  tspecies(chargeIdx, upIdx)   = -1;
+  tspecies(chargeIdx, downIdx) = -1;
+  elec_.resetGroups();
+
+  const char* particles = R"(<tmp>
+<jastrow name="J2" type="Two-Body" function="Bspline" print="yes" gpu="no">
+   <correlation rcut="3" size="4" speciesA="u" speciesB="u">
+      <coefficients id="uu" type="Array"> 0.2 0.1 0.05 0.02</coefficients>
+    </correlation>
+   <correlation rcut="3" size="4" speciesA="u" speciesB="d">
+      <coefficients id="ud" type="Array"> 0.4 0.2 0.1 0.05</coefficients>
+    </correlation>
+</jastrow>
+</tmp>
+)";
+  Libxml2Document doc;
+  bool okay = doc.parseFromString(particles);
+  REQUIRE(okay);
+
+  xmlNodePtr jas1 = xmlFirstElementChild(doc.getRoot());
+
+  RadialJastrowBuilder jastrow(c, elec_);
+
+  using J2Type        = TwoBodyJastrow<BsplineFunctor<RealType>>;
+  auto j2_serial_uptr = jastrow.buildComponent(jas1);
+  auto j2_split_uptr  = jastrow.buildComponent(jas1);
+  J2Type* j2_serial   = dynamic_cast<J2Type*>(j2_serial_uptr.get());
+  J2Type* j2_split    = dynamic_cast<J2Type*>(j2_split_uptr.get());
+  REQUIRE(j2_serial);
+  REQUIRE(j2_split);
+  // split the pairs even for this small system
+  j2_split->setNestedThreadingMinSize(1);
+
+  elec_.update();
+
+  // a team of threads at the top level stands in for the nested team of a crowd
+  const int saved_num_threads = omp_get_max_threads();
+  omp_set_num_threads(3);
+
+  ParticleSet::ParticleGradient G_serial(elec_.getTotalNum()), G_split(elec_.getTotalNum());
+  ParticleSet::ParticleLaplacian L_serial(elec_.getTotalNum()), L_split(elec_.getTotalNum());
+  G_serial = 0.0;
+  G_split  = 0.0;
+  L_serial = 0.0;
+  L_split  = 0.0;
+  const auto log_serial = j2_serial->evaluateLog(elec_, G_serial, L_serial);
+  const auto log_split  = j2_split->evaluateLog(elec_, G_split, L_split);
+  CHECK(std::real(log_split) == Approx(std::real(log_serial)));
+  for (int iat = 0; iat < elec_.getTotalNum(); iat++)
+  {
+    CHECK(std::real(L_split[iat]) == Approx(std::real(L_serial[iat])));
+    for (int idim = 0; idim < OHMMS_DIM; idim++)
+      CHECK(std::real(G_split[iat][idim]) == Approx(std::real(G_serial[iat][idim])));
+  }
+
+  // a move evaluates all the pairs of the moved particle
+  const int iat = 7;
+  elec_.makeMove(iat, ParticleSet::PosType(0.3, -0.2, 0.1));
+  J2Type::GradType grad_serial, grad_split;
+  const auto ratio_serial = j2_serial->ratioGrad(elec_, iat, grad_serial);
+  const auto ratio_split  = j2_split->ratioGrad(elec_, iat, grad_split);
+  CHECK(std::real(ratio_split) == Approx(std::real(ratio_serial)));
+  for (int idim = 0; idim < OHMMS_DIM; idim++)
+    CHECK(std::real(grad_split[idim]) == Approx(std::real(grad_serial[idim])));
+
+  omp_set_num_threads(saved_num_threads);
+}
 } // namespace qmcplusplus
@@ -1013,6 +1013,33 @@ void test_HCN(bool transform)
     CHECK(dionpsivec[4][2] == Approx(-7.300043903e-05));
     CHECK(dionpsivec[5][2] == Approx(2.910525987e-06));
     CHECK(dionpsivec[6][2] == Approx(-1.56074936e-05));
+
+    //Batched evaluateGradSource over two walkers, against the single walker values.
+    ParticleSet elec_2(elec);
+    elec_2.R[1] = ParticleSet::SingleParticlePos(0.3, -0.2, 0.4);
+    elec_2.update();
+    std::unique_ptr<SPOSet> sposet_2(sposet->makeClone());
+    RefVectorWithLeader<SPOSet> spo_list(*sposet, {*sposet, *sposet_2});
+    RefVectorWithLeader<ParticleSet> P_list(elec, {elec, elec_2});
+
+    const int nel   = elec.R.size();
+    const int norbs = sposet->getOrbitalSetSize();
+    std::vector<SPOSet::GradMatrix> mw_dionpsi(2, SPOSet::GradMatrix(nel, norbs));
+    SPOSet::GradMatrix dionpsi_2(nel, norbs);
+    for (int iat = 0; iat < ions.getTotalNum(); iat++)
+    {
+      sposet->mw_evaluateGradSource(spo_list, P_list, 0, nel, ions, iat,
+                                    makeRefVector<SPOSet::GradMatrix>(mw_dionpsi));
+      sposet->evaluateGradSource(elec, 0, nel, ions, iat, dionpsi);
+      sposet_2->evaluateGradSource(elec_2, 0, nel, ions, iat, dionpsi_2);
+      for (int i = 0; i < nel; i++)
+        for (int j = 0; j < norbs; j++)
+          for (int idim = 0; idim < OHMMS_DIM; idim++)
+          {
+            CHECK(mw_dionpsi[0][i][j][idim] == ValueApprox(dionpsi[i][j][idim]));
+            CHECK(mw_dionpsi[1][i][j][idim] == ValueApprox(dionpsi_2[i][j][idim]));
+          }
+    }
   }
 }
 
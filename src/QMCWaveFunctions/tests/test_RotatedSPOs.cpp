@@ -400,6 +400,51 @@ TEST_CASE("RotatedSPOs exponentiate matrix", "[wavefunction]")
   CHECKED_ELSE(check_matrix_result3.result) { FAIL(check_matrix_result3.result_message); }
 }
 
+// The low-rank form of the rotation must agree with the full matrix exponential
+TEST_CASE("RotatedSPOs low-rank rotation", "[wavefunction]")
+{
+  using ValueType   = SPOSet::ValueType;
+  using ValueMatrix = SPOSet::ValueMatrix;
+  using RealType    = SPOSet::RealType;
+
+  RotatedSPOs::RotationIndices rot_ind;
+  int nel = 2;
+  int nmo = 5;
+  RotatedSPOs::createRotationIndices(nel, nmo, rot_ind);
+
+  std::vector<RealType> params = {-1.1, 1.5, 0.2, -0.15, 0.3, 0.05};
+  std::vector<ValueType> vparams(params.begin(), params.end());
+
+  ValueMatrix rot_full(nmo, nmo);
+  rot_full = ValueType(0);
+  RotatedSPOs::constructAntiSymmetricMatrix(rot_ind, vparams, rot_full);
+  RotatedSPOs::exponentiate_antisym_matrix(rot_full);
+
+  ValueMatrix Z, G;
+  REQUIRE(RotatedSPOs::constructLowRankRotation(rot_ind, params, nmo, Z, G));
+  // rank is at most twice the number of occupied orbitals
+  CHECK(Z.cols() == 2 * nel);
+
+  ValueMatrix rot_lowrank(nmo, nmo);
+  for (int i = 0; i < nmo; i++)
+    for (int j = 0; j < nmo; j++)
+    {
+      ValueType val = (i == j) ? 1.0 : 0.0;
+      for (int a = 0; a < Z.cols(); a++)
+        for (int b = 0; b < Z.cols(); b++)
+          val += Z(i, a) * G(a, b) * Z(j, b);
+      rot_lowrank(i, j) = val;
+    }
+
+  CheckMatrixResult check_matrix_result = checkMatrix(rot_lowrank, rot_full, true);
+  CHECKED_ELSE(check_matrix_result.result) { FAIL(check_matrix_result.result_message); }
+
+  // rotations within a set of orbitals are not handled by the low-rank form
+  RotatedSPOs::RotationIndices rot_ind_chain = {{0, 1}, {1, 2}};
+  std::vector<RealType> params_chain         = {0.1, 0.2};
+  CHECK(!RotatedSPOs::constructLowRankRotation(rot_ind_chain, params_chain, 3, Z, G));
+}
+
 TEST_CASE("RotatedSPOs log matrix", "[wavefunction]")
 {
   using ValueType   = SPOSet::ValueType;
@@ -17,6 +17,10 @@
 #include "OhmmsData/Libxml2Doc.h"
 #include "Particle/ParticleSetPool.h"
 #include "QMCWaveFunctions/WaveFunctionPool.h"
+#include "QMCWaveFunctions/SPOSetBuilderFactory.h"
+#include "QMCWaveFunctions/LCAO/LCAOrbitalSet.h"
+#include "QMCWaveFunctions/RotatedSPOs.h"
+#include "Utilities/for_testing/checkMatrix.hpp"
 
 
 #include <stdio.h>
@@ -515,4 +519,97 @@ TEST_CASE("Rotated LCAO WF1 MO coeff rotated, half angle", "[qmcapp]")
   CHECK(dhpsioverpsi[0] == ValueApprox(2.59551625714144));
   CHECK(dhpsioverpsi[1] == ValueApprox(1.70071425070404));
 }
+
+// A few rotated pairs in a large orbital set take the low-rank update of the MO coefficients.
+// It must agree with the rotation by the full matrix exponential.
+TEST_CASE("Rotated LCAO low-rank rotation of the MO coefficients", "[wavefunction]")
+{
+  using ValueType   = SPOSet::ValueType;
+  using ValueMatrix = SPOSet::ValueMatrix;
+  using RealType    = SPOSet::RealType;
+
+  Communicate* c = OHMMS::Controller;
+
+  const SimulationCell simulation_cell;
+  auto elec_ptr = std::make_unique<ParticleSet>(simulation_cell);
+  auto& elec(*elec_ptr);
+  elec.setName("e");
+  elec.create({1, 1});
+  elec.R[0] = 0.0;
+
+  SpeciesSet& tspecies       = elec.getSpeciesSet();
+  int upIdx                  = tspecies.addSpecies("u");
+  int downIdx                = tspecies.addSpecies("d");
+  int massIdx                = tspecies.addAttribute("mass");
+  tspecies(massIdx, upIdx)   = 1.0;
+  tspecies(massIdx, downIdx) = 1.0;
+
+  auto ions_ptr = std::make_unique<ParticleSet>(simulation_cell);
+  auto& ions(*ions_ptr);
+  ions.setName("ion0");
+  ions.create({1});
+  ions.R[0] = 0.0;
+  ions.getSpeciesSet().addSpecies("Ne");
+  ions.update();
+
+  elec.addTable(ions);
+  elec.update();
+
+  Libxml2Document doc;
+  REQUIRE(doc.parse("ne_def2_svp.wfnoj.xml"));
+
+  WaveFunctionComponentBuilder::PSetMap particle_set_map;
+  particle_set_map.emplace(elec_ptr->getName(), std::move(elec_ptr));
+  particle_set_map.emplace(ions_ptr->getName(), std::move(ions_ptr));
+
+  SPOSetBuilderFactory bf(c, elec, particle_set_map);
+
+  OhmmsXPathObject MO_base("//determinantset", doc.getXPathContext());
+  REQUIRE(MO_base.size() == 1);
+  xmlSetProp(MO_base[0], castCharToXMLChar("transform"), castCharToXMLChar("no"));
+  xmlSetProp(MO_base[0], castCharToXMLChar("key"), castCharToXMLChar("GTO"));
+  const auto bb_ptr = bf.createSPOSetBuilder(MO_base[0]);
+
+  // all 14 molecular orbitals
+  const int nmo = 14;
+  OhmmsXPathObject slater_base("//determinant", doc.getXPathContext());
+  xmlSetProp(slater_base[0], castCharToXMLChar("size"), castCharToXMLChar(std::to_string(nmo).c_str()));
+  auto sposet = bb_ptr->createSPOSet(slater_base[0]);
+  auto& lcao  = dynamic_cast<LCAOrbitalSet&>(*sposet);
+  REQUIRE(lcao.getOrbitalSetSize() == nmo);
+
+  // one occupied orbital rotated with all the virtual ones, a rank two correction
+  const int nel = 1;
+  RotatedSPOs::RotationIndices rot_ind;
+  RotatedSPOs::createRotationIndices(nel, nmo, rot_ind);
+  std::vector<RealType> params(rot_ind.size());
+  for (int i = 0; i < params.size(); i++)
+    params[i] = 0.1 * (i + 1) * ((i % 2) ? -1.0 : 1.0);
+
+  ValueMatrix Z, G;
+  REQUIRE(RotatedSPOs::constructLowRankRotation(rot_ind, params, nmo, Z, G));
+  REQUIRE(Z.cols() == 2 * nel);
+  // small enough to take the low-rank update instead of forming the rotation matrix
+  REQUIRE(4 * Z.cols() < nmo);
+
+  ValueMatrix rot_full(nmo, nmo);
+  rot_full = ValueType(0);
+  std::vector<ValueType> vparams(params.begin(), params.end());
+  RotatedSPOs::constructAntiSymmetricMatrix(rot_ind, vparams, rot_full);
+  RotatedSPOs::exponentiate_antisym_matrix(rot_full);
+
+  const ValueMatrix C_orig = *lcao.C;
+  lcao.applyLowRankRotation(Z, G, false);
+  const ValueMatrix C_lowrank = *lcao.C;
+
+  *lcao.C = C_orig;
+  lcao.applyRotation(rot_full, false);
+  CheckMatrixResult check_matrix_result = checkMatrix(C_lowrank, *lcao.C, true);
+  CHECKED_ELSE(check_matrix_result.result) { FAIL(check_matrix_result.result_message); }
+
+  // starting again from the stored copy does not compound the rotations
+  lcao.applyLowRankRotation(Z, G, true);
+  CheckMatrixResult check_matrix_result2 = checkMatrix(C_lowrank, *lcao.C, true);
+  CHECKED_ELSE(check_matrix_result2.result) { FAIL(check_matrix_result2.result_message); }
+}
 } // namespace qmcplusplus
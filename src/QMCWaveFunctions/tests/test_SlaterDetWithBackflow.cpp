@@ -0,0 +1,297 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2023 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "catch.hpp"
+
+#include "OhmmsData/Libxml2Doc.h"
+#include "Particle/ParticleSet.h"
+#include "ParticleIO/LatticeIO.h"
+#include "QMCWaveFunctions/WaveFunctionFactory.h"
+#include "QMCWaveFunctions/TWFGrads.hpp"
+#include "QMCWaveFunctions/OrbitalSetTraits.h"
+#include <ResourceCollection.h>
+
+namespace qmcplusplus
+{
+using RealType     = QMCTraits::RealType;
+using PosType      = QMCTraits::PosType;
+using GradType     = QMCTraits::GradType;
+using LogValueType = WaveFunctionComponent::LogValueType;
+using PsiValueType = WaveFunctionComponent::PsiValueType;
+
+namespace
+{
+struct BackflowMove
+{
+  int iat;
+  PosType displ;
+  bool accept;
+};
+
+/** compute the reference ratio and gradients of a move by evaluating the wavefunction from scratch
+ * @param twf_ref wavefunction evaluated with a full inversion
+ * @param elec_ref particle set of twf_ref, its G holds the gradients at the new configuration on return
+ * @return log value at the new configuration
+ */
+LogValueType evaluateReference(TrialWaveFunction& twf_ref,
+                               ParticleSet& elec_ref,
+                               const ParticleSet& elec,
+                               int iat,
+                               const PosType& displ)
+{
+  elec_ref.R = elec.R;
+  elec_ref.R[iat] += displ;
+  elec_ref.update();
+  twf_ref.evaluateLog(elec_ref);
+  return {twf_ref.getLogPsi(), twf_ref.getPhase()};
+}
+
+PsiValueType referenceRatio(const LogValueType& log_new, const TrialWaveFunction& twf)
+{
+  return LogToValue<PsiValueType>::convert(log_new - LogValueType(twf.getLogPsi(), twf.getPhase()));
+}
+
+/** 7+7 electron gas with the e-e backflow of cutoff radius rcut.
+ *  A short cutoff displaces only a few quasiparticles per move and exercises the low-rank update,
+ *  a long cutoff falls back to the full inversion.
+ */
+void test_backflow_pbyp(const std::string& rcut)
+{
+  Communicate* c = OHMMS::Controller;
+
+  const char* cell_xml = R"(<simulationcell>
+     <parameter name="lattice" units="bohr">
+              6.00000000        0.00000000        0.00000000
+              0.00000000        6.00000000        0.00000000
+              0.00000000        0.00000000        6.00000000
+     </parameter>
+     <parameter name="bconds">
+        p p p
+     </parameter>
+     <parameter name="LR_dim_cutoff"> 15 </parameter>
+  </simulationcell>)";
+  Libxml2Document cell_doc;
+  REQUIRE(cell_doc.parseFromString(cell_xml));
+  ParticleSet::ParticleLayout lattice;
+  LatticeParser lp(lattice);
+  lp.put(cell_doc.getRoot());
+  const SimulationCell simulation_cell(lattice);
+
+  ParticleSet elec(simulation_cell);
+  elec.setName("e");
+  elec.create({7, 7});
+  elec.R[0]  = {0.5, 0.8, 1.2};
+  elec.R[1]  = {2.3, 0.4, 4.9};
+  elec.R[2]  = {4.1, 2.2, 0.7};
+  elec.R[3]  = {1.6, 3.9, 3.1};
+  elec.R[4]  = {5.2, 5.0, 2.4};
+  elec.R[5]  = {3.3, 4.6, 5.5};
+  elec.R[6]  = {0.9, 2.7, 5.1};
+  elec.R[7]  = {1.1, 1.4, 1.9};
+  elec.R[8]  = {3.0, 0.9, 3.6};
+  elec.R[9]  = {4.8, 3.1, 1.5};
+  elec.R[10] = {2.2, 4.4, 0.4};
+  elec.R[11] = {5.5, 1.7, 4.7};
+  elec.R[12] = {0.3, 5.3, 3.8};
+  elec.R[13] = {3.9, 3.2, 3.3};
+
+  SpeciesSet& tspecies         = elec.getSpeciesSet();
+  int upIdx                    = tspecies.addSpecies("u");
+  int downIdx                  = tspecies.addSpecies("d");
+  int chargeIdx                = tspecies.addAttribute("charge");
+  int massIdx                  = tspecies.addAttribute("mass");
+  tspecies(chargeIdx, upIdx)   = -1;
+  tspecies(chargeIdx, downIdx) = -1;
+  tspecies(massIdx, upIdx)     = 1.0;
+  tspecies(massIdx, downIdx)   = 1.0;
+  elec.resetGroups();
+
+  const std::string wf_xml = R"(<wavefunction name="psi0" target="e">
+  <sposet_builder type="free">
+    <sposet name="spo-ud" size="7"/>
+  </sposet_builder>
+  <determinantset>
+    <slaterdeterminant>
+      <determinant id="updet" sposet="spo-ud"/>
+      <determinant id="dndet" sposet="spo-ud"/>
+    </slaterdeterminant>
+    <backflow>
+      <transformation name="eeB" type="e-e" function="Bspline">
+        <correlation speciesA="u" speciesB="u" size="5" rcut=")" +
+      rcut + R"(">
+          <coefficients id="eeuu" type="Array"> 0.0106 0.0617 0.0825 0.0199 0.0284 </coefficients>
+        </correlation>
+        <correlation speciesA="u" speciesB="d" size="5" rcut=")" +
+      rcut + R"(">
+          <coefficients id="eeud" type="Array"> 0.5825 0.2722 0.1645 0.0751 0.0389 </coefficients>
+        </correlation>
+      </transformation>
+    </backflow>
+  </determinantset>
+</wavefunction>)";
+  Libxml2Document wf_doc;
+  REQUIRE(wf_doc.parseFromString(wf_xml));
+
+  WaveFunctionFactory::PSetMap particle_set_map;
+  WaveFunctionFactory wf_factory(elec, particle_set_map, c);
+  auto twf_ptr = wf_factory.buildTWF(wf_doc.getRoot());
+  auto& twf(*twf_ptr);
+
+  // reference wavefunction always evaluated from scratch
+  ParticleSet elec_ref(elec);
+  auto twf_ref_ptr = twf.makeClone(elec_ref);
+  auto& twf_ref(*twf_ref_ptr);
+
+  elec.update();
+  twf.evaluateLog(elec);
+  WaveFunctionComponent::WFBufferType buffer;
+  twf.registerData(elec, buffer);
+
+  // single walker, ratio and gradient then accept or reject
+  const std::vector<BackflowMove> drift_moves{{0, {0.2, -0.1, 0.3}, true},    {8, {-0.3, 0.2, 0.1}, false},
+                                              {3, {0.1, 0.4, -0.2}, true},    {12, {0.25, -0.3, 0.15}, true},
+                                              {5, {-0.2, -0.2, 0.3}, false},  {9, {0.3, 0.1, -0.25}, true},
+                                              {7, {-0.15, 0.25, -0.2}, true}, {0, {0.1, 0.2, -0.1}, true}};
+  for (const auto& move : drift_moves)
+  {
+    const LogValueType log_new   = evaluateReference(twf_ref, elec_ref, elec, move.iat, move.displ);
+    const PsiValueType ratio_ref = referenceRatio(log_new, twf);
+
+    elec.makeMove(move.iat, move.displ);
+    CHECK(twf.calcRatio(elec, move.iat) == ValueApprox(ratio_ref));
+    twf.rejectMove(move.iat);
+    elec.rejectMove(move.iat);
+
+    elec.makeMove(move.iat, move.displ);
+    GradType grad_new;
+    CHECK(twf.calcRatioGrad(elec, move.iat, grad_new) == ValueApprox(ratio_ref));
+    CHECK(grad_new[0] == ValueApprox(elec_ref.G[move.iat][0]));
+    CHECK(grad_new[1] == ValueApprox(elec_ref.G[move.iat][1]));
+    CHECK(grad_new[2] == ValueApprox(elec_ref.G[move.iat][2]));
+
+    if (move.accept)
+    {
+      twf.acceptMove(elec, move.iat);
+      elec.acceptMove(move.iat);
+      CHECK(twf.getLogPsi() == Approx(std::real(log_new)));
+      // the gradients of all the particles use the updated inverse
+      for (int iel = 0; iel < elec.getTotalNum(); iel++)
+      {
+        const GradType grad = twf.evalGrad(elec, iel);
+        CHECK(grad[0] == ValueApprox(elec_ref.G[iel][0]));
+        CHECK(grad[1] == ValueApprox(elec_ref.G[iel][1]));
+        CHECK(grad[2] == ValueApprox(elec_ref.G[iel][2]));
+      }
+    }
+    else
+    {
+      twf.rejectMove(move.iat);
+      elec.rejectMove(move.iat);
+    }
+  }
+
+  // single walker, ratio only then accept or reject
+  const std::vector<BackflowMove> ratio_moves{{1, {-0.2, 0.3, 0.1}, true},
+                                              {10, {0.1, 0.1, 0.3}, false},
+                                              {13, {-0.3, 0.2, -0.1}, true},
+                                              {1, {0.15, -0.1, 0.2}, true}};
+  for (const auto& move : ratio_moves)
+  {
+    const LogValueType log_new = evaluateReference(twf_ref, elec_ref, elec, move.iat, move.displ);
+    elec.makeMove(move.iat, move.displ);
+    CHECK(twf.calcRatio(elec, move.iat) == ValueApprox(referenceRatio(log_new, twf)));
+    if (move.accept)
+    {
+      twf.acceptMove(elec, move.iat);
+      elec.acceptMove(move.iat);
+      CHECK(twf.getLogPsi() == Approx(std::real(log_new)));
+    }
+    else
+    {
+      twf.rejectMove(move.iat);
+      elec.rejectMove(move.iat);
+    }
+  }
+  // the driver recomputes the wavefunction after ratio-only moves
+  twf.evaluateLog(elec);
+
+  // multiple walkers
+  ParticleSet elec_clone(elec);
+  elec_clone.R[4] = {5.0, 4.7, 2.1};
+  elec_clone.update();
+  auto twf_clone = twf.makeClone(elec_clone);
+  twf_clone->evaluateLog(elec_clone);
+  WaveFunctionComponent::WFBufferType buffer_clone;
+  twf_clone->registerData(elec_clone, buffer_clone);
+
+  ResourceCollection pset_res("test_pset_res");
+  ResourceCollection twf_res("test_twf_res");
+  elec.createResource(pset_res);
+  twf.createResource(twf_res);
+
+  RefVectorWithLeader<ParticleSet> p_list(elec, {elec, elec_clone});
+  RefVectorWithLeader<TrialWaveFunction> wf_list(twf, {twf, *twf_clone});
+  ResourceCollectionTeamLock<ParticleSet> mw_pset_lock(pset_res, p_list);
+  ResourceCollectionTeamLock<TrialWaveFunction> mw_twf_lock(twf_res, wf_list);
+
+  const std::vector<int> mw_moved{2, 11, 4, 6};
+  const std::vector<PosType> displs{{0.2, -0.25, 0.1}, {-0.1, 0.3, 0.2}};
+  std::vector<PsiValueType> ratios(2);
+  TWFGrads<CoordsType::POS> grads_new(2);
+  for (int imove = 0; imove < mw_moved.size(); imove++)
+  {
+    const int iat = mw_moved[imove];
+    std::vector<LogValueType> logs_new(2);
+    std::vector<PsiValueType> ratios_ref(2);
+    std::vector<GradType> grads_ref(2);
+    for (int iw = 0; iw < 2; iw++)
+    {
+      logs_new[iw]   = evaluateReference(twf_ref, elec_ref, p_list[iw], iat, displs[iw]);
+      ratios_ref[iw] = referenceRatio(logs_new[iw], wf_list[iw]);
+      grads_ref[iw]  = elec_ref.G[iat];
+    }
+
+    ParticleSet::mw_makeMove(p_list, iat, displs);
+    TrialWaveFunction::mw_calcRatio(wf_list, p_list, iat, ratios);
+    CHECK(ratios[0] == ValueApprox(ratios_ref[0]));
+    CHECK(ratios[1] == ValueApprox(ratios_ref[1]));
+
+    TrialWaveFunction::mw_calcRatioGrad(wf_list, p_list, iat, ratios, grads_new);
+    for (int iw = 0; iw < 2; iw++)
+    {
+      CHECK(ratios[iw] == ValueApprox(ratios_ref[iw]));
+      CHECK(grads_new.grads_positions[iw][0] == ValueApprox(grads_ref[iw][0]));
+      CHECK(grads_new.grads_positions[iw][1] == ValueApprox(grads_ref[iw][1]));
+      CHECK(grads_new.grads_positions[iw][2] == ValueApprox(grads_ref[iw][2]));
+    }
+
+    // accept alternating walkers
+    std::vector<bool> isAccepted{imove % 2 == 0, imove % 2 == 1};
+    std::vector<RealType> logs_old{wf_list[0].getLogPsi(), wf_list[1].getLogPsi()};
+    TrialWaveFunction::mw_accept_rejectMove(wf_list, p_list, iat, isAccepted);
+    ParticleSet::mw_accept_rejectMove(p_list, iat, isAccepted);
+    for (int iw = 0; iw < 2; iw++)
+      CHECK(wf_list[iw].getLogPsi() == Approx(isAccepted[iw] ? std::real(logs_new[iw]) : logs_old[iw]));
+  }
+}
+} // namespace
+
+TEST_CASE("SlaterDetWithBackflow low-rank update", "[wavefunction][fermion]")
+{
+  test_backflow_pbyp("2.0");
+}
+
+TEST_CASE("SlaterDetWithBackflow full inversion update", "[wavefunction][fermion]")
+{
+  test_backflow_pbyp("2.9");
+}
+} // namespace qmcplusplus
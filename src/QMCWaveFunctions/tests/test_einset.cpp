@@ -19,6 +19,7 @@
 #include "QMCWaveFunctions/WaveFunctionComponent.h"
 #include "QMCWaveFunctions/EinsplineSetBuilder.h"
 #include "QMCWaveFunctions/EinsplineSpinorSetBuilder.h"
+#include "QMCWaveFunctions/BsplineFactory/SplineR2R.h"
 
 #include <stdio.h>
 #include <string>
@@ -605,6 +606,45 @@ TEST_CASE("Einspline SPO from HDF diamond_2x1x1 5 electrons", "[wavefunction]")
 #endif
 }
 
+#if !defined(QMC_COMPLEX)
+template<typename ST>
+void test_SplineR2R_rotateCoefs()
+{
+  const size_t basis_set_size = 23;
+  const int nsplines          = 5;
+  std::vector<ST> coefs(basis_set_size * nsplines);
+  for (size_t i = 0; i < coefs.size(); i++)
+    coefs[i] = std::sin(0.37 * i);
+  Matrix<double> rot(nsplines, nsplines);
+  for (int i = 0; i < nsplines; i++)
+    for (int j = 0; j < nsplines; j++)
+      rot[i][j] = std::cos(0.5 * i + 0.3 * j);
+
+  // one chunk holding all the rows
+  std::vector<ST> coefs_whole(coefs);
+  SplineR2R<ST>::rotateCoefs(coefs_whole.data(), basis_set_size, rot, basis_set_size);
+  // chunks not dividing the rows
+  std::vector<ST> coefs_chunked(coefs);
+  SplineR2R<ST>::rotateCoefs(coefs_chunked.data(), basis_set_size, rot, 4);
+
+  for (size_t ib = 0; ib < basis_set_size; ib++)
+    for (int j = 0; j < nsplines; j++)
+    {
+      double expected = 0.0;
+      for (int k = 0; k < nsplines; k++)
+        expected += double(coefs[ib * nsplines + k]) * rot[k][j];
+      CHECK(coefs_whole[ib * nsplines + j] == Approx(expected));
+      CHECK(coefs_chunked[ib * nsplines + j] == coefs_whole[ib * nsplines + j]);
+    }
+}
+
+TEST_CASE("SplineR2R rotateCoefs in chunks", "[wavefunction]")
+{
+  test_SplineR2R_rotateCoefs<float>();
+  test_SplineR2R_rotateCoefs<double>();
+}
+#endif
+
 TEST_CASE("EinsplineSetBuilder CheckLattice", "[wavefunction]")
 {
   Communicate* c = OHMMS::Controller;
@@ -326,6 +326,124 @@ void test_LiH_msd(const std::string& spo_xml_string,
   }
 }
 
+/** lean storage keeps C_otherDs of one group only.
+ *  Ratios requested for a group other than the prepared one must not read the stale buffer.
+ */
+void test_LiH_msd_lean_group_switch(const std::string& full_xml_string, const std::string& lean_xml_string)
+{
+  Communicate* c = OHMMS::Controller;
+
+  ParticleSetPool ptcl = ParticleSetPool(c);
+  auto ions_uptr       = std::make_unique<ParticleSet>(ptcl.getSimulationCell());
+  auto elec_uptr       = std::make_unique<ParticleSet>(ptcl.getSimulationCell());
+  ParticleSet& ions_(*ions_uptr);
+  ParticleSet& elec_(*elec_uptr);
+
+  ions_.setName("ion0");
+  ptcl.addParticleSet(std::move(ions_uptr));
+  ions_.create({1, 1});
+  ions_.R[0]           = {0.0, 0.0, 0.0};
+  ions_.R[1]           = {0.0, 0.0, 3.0139239693};
+  SpeciesSet& ispecies = ions_.getSpeciesSet();
+  ispecies.addSpecies("Li");
+  ispecies.addSpecies("H");
+
+  elec_.setName("elec");
+  ptcl.addParticleSet(std::move(elec_uptr));
+  elec_.create({2, 2});
+  elec_.R[0] = {0.5, 0.5, 0.5};
+  elec_.R[1] = {0.1, 0.1, 1.1};
+  elec_.R[2] = {-0.5, -0.5, -0.5};
+  elec_.R[3] = {-0.1, -0.1, 1.5};
+
+  SpeciesSet& tspecies       = elec_.getSpeciesSet();
+  int upIdx                  = tspecies.addSpecies("u");
+  int downIdx                = tspecies.addSpecies("d");
+  int massIdx                = tspecies.addAttribute("mass");
+  tspecies(massIdx, upIdx)   = 1.0;
+  tspecies(massIdx, downIdx) = 1.0;
+  elec_.resetGroups();
+
+  Libxml2Document doc_full, doc_lean;
+  REQUIRE(doc_full.parseFromString(full_xml_string));
+  REQUIRE(doc_lean.parseFromString(lean_xml_string));
+
+  WaveFunctionFactory wf_factory_full(elec_, ptcl.getPool(), c);
+  auto twf_full_ptr = wf_factory_full.buildTWF(doc_full.getRoot());
+  WaveFunctionFactory wf_factory_lean(elec_, ptcl.getPool(), c);
+  auto twf_lean_ptr = wf_factory_lean.buildTWF(doc_lean.getRoot());
+  auto& twf_full(*twf_full_ptr);
+  auto& twf_lean(*twf_lean_ptr);
+
+  ions_.update();
+  elec_.update();
+
+  twf_full.evaluateLog(elec_);
+  twf_lean.evaluateLog(elec_);
+
+  // alternate groups without calling prepareGroup for the group of the moved electron
+  const std::vector<int> moved_elecs{1, 2, 0, 3};
+  const PosType delta(0.1, 0.1, 0.2);
+  std::vector<PsiValueType> ratios_full(elec_.getTotalNum());
+  for (int ig = 0; ig < 2; ig++)
+  {
+    twf_full.prepareGroup(elec_, ig);
+    twf_lean.prepareGroup(elec_, ig);
+    for (const int iel : moved_elecs)
+    {
+      elec_.makeMove(iel, delta);
+      ratios_full[iel]      = twf_full.calcRatio(elec_, iel);
+      const auto ratio_lean = twf_lean.calcRatio(elec_, iel);
+      CHECK(ratio_lean == ValueApprox(ratios_full[iel]));
+      twf_full.rejectMove(iel);
+      twf_lean.rejectMove(iel);
+      elec_.rejectMove(iel);
+    }
+  }
+
+  // the first electron in group 0 with group 1 prepared, the reference value is from test_LiH_msd
+  twf_lean.prepareGroup(elec_, 1);
+  elec_.makeMove(1, delta);
+  CHECK(twf_lean.calcRatio(elec_, 1) == ValueApprox(1.374307585));
+  twf_lean.rejectMove(1);
+  elec_.rejectMove(1);
+
+  // batched ratios with the other group prepared
+  ParticleSet elec_clone(elec_);
+  elec_clone.update();
+  std::unique_ptr<TrialWaveFunction> twf_lean_clone(twf_lean.makeClone(elec_clone));
+
+  ResourceCollection pset_res("test_pset_res");
+  ResourceCollection twf_res("test_twf_res");
+  elec_.createResource(pset_res);
+  twf_lean.createResource(twf_res);
+
+  RefVectorWithLeader<ParticleSet> p_ref_list(elec_, {elec_, elec_clone});
+  RefVectorWithLeader<TrialWaveFunction> wf_ref_list(twf_lean, {twf_lean, *twf_lean_clone});
+  ResourceCollectionTeamLock<ParticleSet> mw_pset_lock(pset_res, p_ref_list);
+  ResourceCollectionTeamLock<TrialWaveFunction> mw_twf_lock(twf_res, wf_ref_list);
+
+  ParticleSet::mw_update(p_ref_list);
+  TrialWaveFunction::mw_evaluateLog(wf_ref_list, p_ref_list);
+
+  std::vector<PosType> displ(2, delta);
+  std::vector<PsiValueType> ratios(2);
+  for (int ig = 0; ig < 2; ig++)
+  {
+    TrialWaveFunction::mw_prepareGroup(wf_ref_list, p_ref_list, ig);
+    for (const int iel : moved_elecs)
+    {
+      ParticleSet::mw_makeMove(p_ref_list, iel, displ);
+      TrialWaveFunction::mw_calcRatio(wf_ref_list, p_ref_list, iel, ratios);
+      CHECK(ratios[0] == ValueApprox(ratios_full[iel]));
+      CHECK(ratios[1] == ValueApprox(ratios_full[iel]));
+      std::vector<bool> isAccepted(2, false);
+      TrialWaveFunction::mw_accept_rejectMove(wf_ref_list, p_ref_list, iel, isAccepted);
+      ParticleSet::mw_accept_rejectMove(p_ref_list, iel, isAccepted);
+    }
+  }
+}
+
 TEST_CASE("LiH multi Slater dets table_method", "[wavefunction]")
 {
   app_log() << "-----------------------------------------------------------------" << std::endl;
@@ -384,6 +502,40 @@ TEST_CASE("LiH multi Slater dets precomputed_table_method", "[wavefunction]")
   test_LiH_msd(spo_xml_string1_new, "spo-up", 85, 105, true, true);
 }
 
+TEST_CASE("LiH multi Slater dets precomputed_table_method lean storage", "[wavefunction]")
+{
+  app_log() << "-----------------------------------------------------------------" << std::endl;
+  app_log() << "LiH_msd using the table method with precomputation and lean storage" << std::endl;
+  app_log() << "-----------------------------------------------------------------" << std::endl;
+  const char* spo_xml_string1_lean = R"(<wavefunction name="psi0" target="e">
+    <sposet_collection type="MolecularOrbital" name="LCAOBSet" source="ion0" cuspCorrection="no" href="LiH.orbs.h5">
+      <basisset name="LCAOBSet" key="GTO" transform="yes">
+        <grid type="log" ri="1.e-6" rf="1.e2" npts="1001"/>
+      </basisset>
+      <sposet basisset="LCAOBSet" name="spo-up" size="85">
+        <occupation mode="ground"/>
+        <coefficient size="85" spindataset="0"/>
+      </sposet>
+      <sposet basisset="LCAOBSet" name="spo-dn" size="85">
+        <occupation mode="ground"/>
+        <coefficient size="85" spindataset="0"/>
+      </sposet>
+    </sposet_collection>
+    <determinantset>
+      <multideterminant optimize="yes" spo_up="spo-up" spo_dn="spo-dn" algorithm="precomputed_table_method" storage="lean">
+        <detlist size="1487" type="DETS" cutoff="1e-20" href="LiH.orbs.h5"/>
+      </multideterminant>
+    </determinantset>
+</wavefunction>
+)";
+  test_LiH_msd(spo_xml_string1_lean, "spo-up", 85, 105, true, true);
+
+  std::string spo_xml_string1_full(spo_xml_string1_lean);
+  const std::string lean_attr(" storage=\"lean\"");
+  spo_xml_string1_full.erase(spo_xml_string1_full.find(lean_attr), lean_attr.size());
+  test_LiH_msd_lean_group_switch(spo_xml_string1_full, spo_xml_string1_lean);
+}
+
 #ifdef QMC_COMPLEX
 void test_Bi_msd(const std::string& spo_xml_string,
                  const std::string& check_sponame,
@@ -0,0 +1,240 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+/** @file PhiloxRandom.h
+ * @brief Counter-based random number generator, Philox4x32-10
+ *
+ * J. K. Salmon, M. A. Moraes, R. O. Dror and D. E. Shaw,
+ * "Parallel random numbers: as easy as 1, 2, 3", SC11 (2011).
+ */
+#ifndef QMCPLUSPLUS_PHILOXRANDOM_H
+#define QMCPLUSPLUS_PHILOXRANDOM_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace qmcplusplus
+{
+/** Philox4x32-10 engine with the StdRandom interface.
+ *
+ * The stream is a pure function of a 64 bit key (the seed and a stream index) and a 64 bit position which counts the
+ * uniform numbers already drawn. Each block of four numbers is produced independently from its counter,
+ * so the whole state is 16 bytes, skipping ahead is O(1) with discard() and the bulk fills
+ * generate_uniform/generate_normal compute many blocks in one vectorizable loop.
+ * Each uniform number carries 32 random bits as the mt19937 based StdRandom does.
+ */
+template<typename T>
+class PhiloxRandom
+{
+public:
+  using result_type = T;
+  using uint_type   = uint32_t;
+
+  PhiloxRandom(uint_type iseed = 911) { seed(iseed); }
+
+  void init(int iseed_in) { seed(static_cast<uint_type>(iseed_in)); }
+
+  void seed(uint_type aseed) { seed(aseed, 0u); }
+
+  /** select the independent stream of seed aseed, O(1) since a stream is the second word of the key.
+   * seed(aseed) is stream 0.
+   */
+  void seed(uint_type aseed, uint_type stream)
+  {
+    key_      = {aseed, stream};
+    position_ = 0;
+    invalidateCache();
+  }
+
+  /// stream index set by seed
+  uint_type stream() const { return key_[1]; }
+
+  /// skip the next n numbers of the stream
+  void discard(uint64_t n)
+  {
+    position_ += n;
+    invalidateCache();
+  }
+
+  /// number of uniform numbers drawn since seeding
+  uint64_t position() const { return position_; }
+
+  result_type operator()()
+  {
+    const uint64_t block = position_ >> 2;
+    if (block != cached_block_)
+    {
+      generateBlock(block, key_, cache_.data());
+      cached_block_ = block;
+    }
+    return toUniform<T>(cache_[position_++ & 3]);
+  }
+
+  /** fill a with n uniform numbers in [0,1), identical to n calls of operator()
+   */
+  template<typename U>
+  void generate_uniform(U* restrict a, size_t n)
+  {
+    size_t i = 0;
+    // finish the block in use
+    for (; i < n && (position_ & 3); i++)
+      a[i] = static_cast<U>(operator()());
+    const size_t nblocks = (n - i) >> 2;
+    const uint64_t first = position_ >> 2;
+    const key_type key   = key_;
+    U* restrict out      = a + i;
+#pragma omp simd
+    for (size_t ib = 0; ib < nblocks; ib++)
+    {
+      uint32_t r[4];
+      generateBlock(first + ib, key, r);
+      out[4 * ib]     = toUniform<U>(r[0]);
+      out[4 * ib + 1] = toUniform<U>(r[1]);
+      out[4 * ib + 2] = toUniform<U>(r[2]);
+      out[4 * ib + 3] = toUniform<U>(r[3]);
+    }
+    position_ += 4 * nblocks;
+    for (i += 4 * nblocks; i < n; i++)
+      a[i] = static_cast<U>(operator()());
+  }
+
+  /** fill a with n standard normal numbers using Box-Muller on pairs of uniform numbers.
+   * The sequence is identical to assignGaussRand driven by operator(), an odd n consumes one extra uniform number.
+   */
+  template<typename U>
+  void generate_normal(U* restrict a, size_t n)
+  {
+    constexpr size_t chunk = 256;
+    T u[chunk];
+    const T slightly_less_than_one = T(1) - std::numeric_limits<T>::epsilon();
+    const T two_pi                 = T(2) * T(M_PI);
+    for (size_t first = 0; first < n; first += chunk)
+    {
+      const size_t m      = std::min(chunk, n - first);
+      const size_t npairs = (m + 1) / 2;
+      generate_uniform(u, 2 * npairs);
+      U* restrict out = a + first;
+#pragma omp simd
+      for (size_t ip = 0; ip < m / 2; ip++)
+      {
+        const T r       = std::sqrt(T(-2) * std::log(T(1) - slightly_less_than_one * u[2 * ip]));
+        const T theta   = two_pi * u[2 * ip + 1];
+        out[2 * ip]     = static_cast<U>(r * std::cos(theta));
+        out[2 * ip + 1] = static_cast<U>(r * std::sin(theta));
+      }
+      if (m % 2 == 1)
+      {
+        const T r  = std::sqrt(T(-2) * std::log(T(1) - slightly_less_than_one * u[m - 1]));
+        out[m - 1] = static_cast<U>(r * std::cos(two_pi * u[m]));
+      }
+    }
+  }
+
+  void write(std::ostream& rout) const
+  {
+    std::vector<uint_type> state;
+    save(state);
+    for (auto s : state)
+      rout << s << " ";
+  }
+
+  void read(std::istream& rin)
+  {
+    std::vector<uint_type> state(state_size());
+    for (auto& s : state)
+      rin >> s;
+    load(state);
+  }
+
+  size_t state_size() const { return 4; }
+
+  void load(const std::vector<uint_type>& newstate)
+  {
+    key_      = {newstate[0], newstate[1]};
+    position_ = static_cast<uint64_t>(newstate[2]) | (static_cast<uint64_t>(newstate[3]) << 32);
+    invalidateCache();
+  }
+
+  void save(std::vector<uint_type>& curstate) const
+  {
+    curstate = {key_[0], key_[1], static_cast<uint_type>(position_), static_cast<uint_type>(position_ >> 32)};
+  }
+
+  /// raw Philox4x32-10 bijection, exposed for known-answer testing
+  static void philox4x32_10(std::array<uint32_t, 4>& ctr, std::array<uint32_t, 2> key)
+  {
+    for (int round = 0; round < 10; round++)
+    {
+      if (round > 0)
+      {
+        key[0] += W0;
+        key[1] += W1;
+      }
+      const uint64_t p0 = static_cast<uint64_t>(M0) * ctr[0];
+      const uint64_t p1 = static_cast<uint64_t>(M1) * ctr[2];
+      ctr = {static_cast<uint32_t>(p1 >> 32) ^ ctr[1] ^ key[0], static_cast<uint32_t>(p1),
+             static_cast<uint32_t>(p0 >> 32) ^ ctr[3] ^ key[1], static_cast<uint32_t>(p0)};
+    }
+  }
+
+public:
+  // Non const allows use of default copy constructor
+  std::string ClassName{"PhiloxRand"};
+  std::string EngineName{"philox4x32_10"};
+
+private:
+  using key_type = std::array<uint32_t, 2>;
+
+  static constexpr uint32_t M0 = 0xD2511F53u;
+  static constexpr uint32_t M1 = 0xCD9E8D57u;
+  static constexpr uint32_t W0 = 0x9E3779B9u;
+  static constexpr uint32_t W1 = 0xBB67AE85u;
+
+  /// the seed
+  key_type key_;
+  /// number of uniform numbers drawn, block position_/4 and lane position_%4
+  uint64_t position_;
+
+  /// the last generated block, not part of the state
+  std::array<uint32_t, 4> cache_;
+  uint64_t cached_block_;
+
+  void invalidateCache() { cached_block_ = std::numeric_limits<uint64_t>::max(); }
+
+  /// the four numbers of a block, the counter is {low and high words of block, 0, 0}
+  static inline void generateBlock(uint64_t block, const key_type& key, uint32_t* restrict r)
+  {
+    std::array<uint32_t, 4> ctr{static_cast<uint32_t>(block), static_cast<uint32_t>(block >> 32), 0u, 0u};
+    philox4x32_10(ctr, key);
+    r[0] = ctr[0];
+    r[1] = ctr[1];
+    r[2] = ctr[2];
+    r[3] = ctr[3];
+  }
+
+  /// map 32 random bits to [0,1) in the same way as uniform_real_distribution_as_boost on mt19937
+  template<typename U>
+  static inline U toUniform(uint32_t x)
+  {
+    return static_cast<U>(static_cast<T>(x) / (static_cast<T>(std::numeric_limits<uint32_t>::max()) + 1));
+  }
+};
+
+} // namespace qmcplusplus
+
+#endif
@@ -31,7 +31,8 @@ typename RNG::result_type RNGThreadSafe<RNG>::operator()()
 }
 
 template class RNGThreadSafe<FakeRandom>;
-template class RNGThreadSafe<RandomGenerator>;
+template class RNGThreadSafe<StdRandom<double>>;
+template class RNGThreadSafe<PhiloxRandom<double>>;
 
 RNGThreadSafe<FakeRandom> fake_random_global;
 RNGThreadSafe<RandomGenerator> random_global;
@@ -18,7 +18,8 @@
  * @brief Declare a global Random Number Generator
  *
  * Selected among
- * - std::mt19937
+ * - std::mt19937, default
+ * - Philox4x32-10 counter-based generator, when QMC_RNG_PHILOX is defined
  * qmcplusplus::Random() returns a random number [0,1)
  * For OpenMP is enabled, it is important to use thread-safe boost::random. Each
  * thread uses its own random number generator with a distinct seed. This prevents
@@ -30,9 +31,11 @@
 #include "config.h"
 #endif
 #include <cstdint>
+#include <utility>
 // The definition of the fake RNG should always be available for unit testing
 #include "FakeRandom.h"
 #include "StdRandom.h"
+#include "PhiloxRandom.h"
 
 uint32_t make_seed(int i, int n);
 
@@ -47,10 +50,29 @@ public:
   /** return a random number [0,1)
    */
   result_type operator()();
+
+  /** bulk uniform fill under the same lock, only available if RNG provides it
+   */
+  template<typename U, class R = RNG>
+  auto generate_uniform(U* a, size_t n) -> decltype(std::declval<R&>().generate_uniform(a, n))
+  {
+#pragma omp critical
+    R::generate_uniform(a, n);
+  }
+
+  /** bulk Gaussian fill under the same lock, only available if RNG provides it
+   */
+  template<typename U, class R = RNG>
+  auto generate_normal(U* a, size_t n) -> decltype(std::declval<R&>().generate_normal(a, n))
+  {
+#pragma omp critical
+    R::generate_normal(a, n);
+  }
 };
 
 extern template class RNGThreadSafe<FakeRandom>;
 extern template class RNGThreadSafe<StdRandom<double>>;
+extern template class RNGThreadSafe<PhiloxRandom<double>>;
 
 #if defined(USE_FAKE_RNG)
 // fake RNG redirection
@@ -59,7 +81,11 @@ extern RNGThreadSafe<RandomGenerator> fake_random_global;
 #define Random fake_random_global
 #else
 // real RNG redirection
+#if defined(QMC_RNG_PHILOX)
+using RandomGenerator = PhiloxRandom<OHMMS_PRECISION_FULL>;
+#else
 using RandomGenerator = StdRandom<OHMMS_PRECISION_FULL>;
+#endif
 extern RNGThreadSafe<RandomGenerator> random_global;
 #define Random random_global
 #endif
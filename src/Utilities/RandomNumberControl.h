@@ -53,6 +53,12 @@ public:
   static void make_seeds();
   static void make_children();
 
+  /** seed of the per walker random streams, identical on all the ranks and threads
+   *
+   * It is derived from the seed offset and is never 0, which marks walker streams as unused.
+   */
+  static uint32_t getWalkerStreamSeed() { return static_cast<uint32_t>(Offset) + 1u; }
+
   xmlNodePtr initialize(xmlXPathContextPtr);
 
   /** read in parallel or serial
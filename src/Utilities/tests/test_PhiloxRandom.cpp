@@ -0,0 +1,135 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "catch.hpp"
+
+#include "Utilities/PhiloxRandom.h"
+
+#include <cmath>
+#include <sstream>
+#include <vector>
+
+namespace qmcplusplus
+{
+
+TEST_CASE("PhiloxRandom known answers", "[utilities]")
+{
+  // reference values of Philox4x32-10 from the Random123 distribution
+  using RNG = PhiloxRandom<double>;
+  std::array<uint32_t, 4> ctr{0u, 0u, 0u, 0u};
+  RNG::philox4x32_10(ctr, {0u, 0u});
+  CHECK(ctr == std::array<uint32_t, 4>{0x6627e8d5u, 0xe169c58du, 0xbc57ac4cu, 0x9b00dbd8u});
+
+  ctr = {0xffffffffu, 0xffffffffu, 0xffffffffu, 0xffffffffu};
+  RNG::philox4x32_10(ctr, {0xffffffffu, 0xffffffffu});
+  CHECK(ctr == std::array<uint32_t, 4>{0x408f276du, 0x41c83b0eu, 0xa20bc7c6u, 0x6d5451fdu});
+
+  ctr = {0x243f6a88u, 0x85a308d3u, 0x13198a2eu, 0x03707344u};
+  RNG::philox4x32_10(ctr, {0xa4093822u, 0x299f31d0u});
+  CHECK(ctr == std::array<uint32_t, 4>{0xd16cfe09u, 0x94fdccebu, 0x5001e420u, 0x24126ea1u});
+}
+
+TEST_CASE("PhiloxRandom save, load and discard", "[utilities]")
+{
+  using DoubleRNG = PhiloxRandom<double>;
+  DoubleRNG rng;
+  rng.init(111);
+
+  std::vector<double> rng_doubles(103);
+  for (auto& elem : rng_doubles)
+    elem = rng();
+  for (auto elem : rng_doubles)
+  {
+    CHECK(elem >= 0.0);
+    CHECK(elem < 1.0);
+  }
+
+  std::vector<DoubleRNG::uint_type> state;
+  rng.save(state);
+  CHECK(state.size() == rng.state_size());
+  CHECK(state.size() * sizeof(DoubleRNG::uint_type) == 16);
+
+  DoubleRNG rng2;
+  rng2.init(110);
+  rng2.load(state);
+  CHECK(rng2() == rng());
+
+  std::stringstream sstr;
+  rng.write(sstr);
+  DoubleRNG rng3;
+  rng3.read(sstr);
+  CHECK(rng3() == rng());
+
+  // skip-ahead lands on the same number as drawing
+  DoubleRNG rng_skip;
+  rng_skip.init(111);
+  rng_skip.discard(57);
+  DoubleRNG rng_draw;
+  rng_draw.init(111);
+  for (int i = 0; i < 57; i++)
+    rng_draw();
+  CHECK(rng_skip.position() == 57);
+  CHECK(rng_skip() == rng_draw());
+  CHECK(rng_skip() == rng_doubles[58]);
+
+  // different seeds give different streams
+  DoubleRNG rng_other;
+  rng_other.init(112);
+  CHECK(rng_other() != rng_doubles[0]);
+}
+
+TEST_CASE("PhiloxRandom bulk fill", "[utilities]")
+{
+  using DoubleRNG = PhiloxRandom<double>;
+  DoubleRNG rng_bulk;
+  DoubleRNG rng_scalar;
+  rng_bulk.init(13);
+  rng_scalar.init(13);
+
+  // misalign the position so that the bulk fill starts and ends in the middle of a block
+  rng_bulk();
+  rng_scalar();
+
+  std::vector<double> uniform(42);
+  rng_bulk.generate_uniform(uniform.data(), uniform.size());
+  for (auto elem : uniform)
+    CHECK(elem == rng_scalar());
+
+  // Box-Mueller on consecutive pairs, an odd length uses one more number
+  const double slightly_less_than_one = 1.0 - std::numeric_limits<double>::epsilon();
+  std::vector<float> normal(301);
+  rng_bulk.generate_normal(normal.data(), normal.size());
+  for (int i = 0; i < normal.size(); i += 2)
+  {
+    const double r     = std::sqrt(-2.0 * std::log(1.0 - slightly_less_than_one * rng_scalar()));
+    const double theta = 2.0 * M_PI * rng_scalar();
+    CHECK(normal[i] == Approx(r * std::cos(theta)));
+    if (i + 1 < normal.size())
+      CHECK(normal[i + 1] == Approx(r * std::sin(theta)));
+  }
+  CHECK(rng_bulk.position() == rng_scalar.position());
+
+  // moments of a large sample
+  std::vector<double> gauss(100000);
+  rng_bulk.generate_normal(gauss.data(), gauss.size());
+  double mean = 0.0, var = 0.0;
+  for (auto g : gauss)
+    mean += g;
+  mean /= gauss.size();
+  for (auto g : gauss)
+    var += (g - mean) * (g - mean);
+  var /= gauss.size();
+  CHECK(mean == Approx(0.0).margin(0.02));
+  CHECK(var == Approx(1.0).epsilon(0.02));
+}
+
+} // namespace qmcplusplus